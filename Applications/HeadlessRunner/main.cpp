@@ -0,0 +1,228 @@
+/* Headless runner : initializes the engine, loads plugins and files, then steps a fixed
+number of frames with a fixed time step through the task queue, without any window nor
+OpenGL context. The timings of the systems and of their tasks, the throughput and the memory
+usage are written as JSON, so that it can be used as a performance regression harness on
+machines without GPU. */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QPluginLoader>
+
+#include <Core/Log/Log.hpp>
+#include <Core/String/StringUtils.hpp>
+#include <Core/Tasks/TaskProfiler.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Time/Timer.hpp>
+#include <Core/Utils/MemoryUsage.hpp>
+
+#include <Engine/RadiumEngine.hpp>
+#include <Engine/Managers/EntityManager/EntityManager.hpp>
+#include <PluginBase/RadiumPluginInterface.hpp>
+
+#ifdef IO_USE_TINYPLY
+    #include <IO/TinyPlyLoader/TinyPlyFileLoader.hpp>
+#endif
+#ifdef IO_USE_ASSIMP
+    #include <IO/AssimpLoader/AssimpFileLoader.hpp>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+    using namespace Ra;
+
+    // Same rules as BaseApplication::loadPlugins, without the UI and OpenGL parts of the plugins.
+    uint loadPlugins( Engine::RadiumEngine* engine, const std::string& pluginsPath,
+                      const QStringList& loadList, const QStringList& ignoreList )
+    {
+        QDir pluginsDir( qApp->applicationDirPath() );
+        if ( !pluginsDir.cd( pluginsPath.c_str() ) )
+        {
+            LOG( logINFO ) << "Cannot open plugins directory " << pluginsPath;
+            return 0;
+        }
+
+#if defined( OS_WINDOWS )
+        const std::string sysDllExt = "dll";
+#elif defined( OS_LINUX )
+        const std::string sysDllExt = "so";
+#elif defined( OS_MACOS )
+        const std::string sysDllExt = "dylib";
+#else
+        static_assert( false, "System configuration not handled" );
+#endif
+
+        PluginContext context;
+        context.m_engine = engine;
+        context.m_selectionManager = nullptr;
+        context.m_pickingManager = nullptr;
+
+        uint pluginCpt = 0;
+        for ( const auto& filename : pluginsDir.entryList( QDir::Files ) )
+        {
+            if ( Core::StringUtils::getFileExt( filename.toStdString() ) != sysDllExt )
+            {
+                continue;
+            }
+            const QString basename = QString::fromStdString( Core::StringUtils::getBaseName( filename.toStdString(), false ) );
+            if ( ( !loadList.empty() && !loadList.contains( basename ) ) || ignoreList.contains( basename ) )
+            {
+                continue;
+            }
+
+            QPluginLoader pluginLoader( pluginsDir.absoluteFilePath( filename ) );
+            pluginLoader.setLoadHints( QLibrary::ResolveAllSymbolsHint );
+            QObject* plugin = pluginLoader.instance();
+            auto loadedPlugin = plugin ? qobject_cast<Plugins::RadiumPluginInterface*>( plugin ) : nullptr;
+            if ( loadedPlugin == nullptr )
+            {
+                LOG( logERROR ) << "Something went wrong while trying to load plugin " << filename.toStdString()
+                                << " : " << pluginLoader.errorString().toStdString();
+                continue;
+            }
+
+            LOG( logINFO ) << "Loaded plugin " << filename.toStdString();
+            ++pluginCpt;
+            loadedPlugin->registerPlugin( context );
+            if ( loadedPlugin->doAddFileLoader() )
+            {
+                std::vector<std::shared_ptr<Asset::FileLoaderInterface>> loaders;
+                loadedPlugin->addFileLoaders( &loaders );
+                for ( const auto& l : loaders )
+                {
+                    engine->registerFileLoader( l );
+                }
+            }
+        }
+        return pluginCpt;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    using namespace Ra;
+
+    QCoreApplication app( argc, argv );
+    QCoreApplication::setOrganizationName( "STORM-IRIT" );
+    QCoreApplication::setApplicationName( "RadiumHeadlessRunner" );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Run the Radium engine systems without rendering, and report their timings as JSON." );
+    parser.addHelpOption();
+
+    QCommandLineOption numFramesOpt( QStringList{"n", "numframes"}, "Number of profiled frames.", "number", "100" );
+    QCommandLineOption warmupOpt( QStringList{"w", "warmup"}, "Number of frames run before profiling.", "number", "10" );
+    QCommandLineOption dtOpt( QStringList{"dt"}, "Time step of each frame, in seconds.", "seconds", "0.0166667" );
+    QCommandLineOption maxThreadsOpt( QStringList{"m", "maxthreads", "max-threads"}, "Number of task threads, 0 for the number of cores.", "number", "0" );
+    QCommandLineOption pluginOpt( QStringList{"p", "plugins", "pluginsPath"}, "Set the path to the plugin dlls.", "folder", "Plugins" );
+    QCommandLineOption pluginLoadOpt( QStringList{"l", "load", "loadPlugin"}, "Only load plugin with the given name.", "name" );
+    QCommandLineOption pluginIgnoreOpt( QStringList{"i", "ignore", "ignorePlugin"}, "Ignore plugins with the given name.", "name" );
+    QCommandLineOption fileOpt( QStringList{"f", "file", "scene"}, "Load a file before running (can be repeated).", "file name" );
+    QCommandLineOption outputOpt( QStringList{"o", "output"}, "Write the report to this file instead of the standard output.", "file name" );
+
+    parser.addOptions( {numFramesOpt, warmupOpt, dtOpt, maxThreadsOpt, pluginOpt, pluginLoadOpt, pluginIgnoreOpt, fileOpt, outputOpt} );
+    parser.process( app );
+
+    const uint numFrames = parser.value( numFramesOpt ).toUInt();
+    const uint warmupFrames = parser.value( warmupOpt ).toUInt();
+    const Scalar dt = Scalar( parser.value( dtOpt ).toDouble() );
+    const uint maxThreads = parser.value( maxThreadsOpt ).toUInt();
+    const uint numThreads = std::max( maxThreads == 0 ? RA_MAX_THREAD : std::min( maxThreads, RA_MAX_THREAD ), 1u );
+
+    const std::size_t initialMemory = Core::MemoryUsage::getCurrentResidentMemory();
+
+    // Initialize the engine, its systems and the scene.
+    const auto loadStart = Core::Timer::Clock::now();
+    Engine::RadiumEngine* engine = Engine::RadiumEngine::createInstance();
+    engine->initialize();
+
+    const uint pluginCount = loadPlugins( engine, parser.value( pluginOpt ).toStdString(),
+                                          parser.values( pluginLoadOpt ), parser.values( pluginIgnoreOpt ) );
+#ifdef IO_USE_TINYPLY
+    engine->registerFileLoader( std::shared_ptr<Asset::FileLoaderInterface>( new IO::TinyPlyFileLoader() ) );
+#endif
+#ifdef IO_USE_ASSIMP
+    engine->registerFileLoader( std::shared_ptr<Asset::FileLoaderInterface>( new IO::AssimpFileLoader() ) );
+#endif
+
+    uint fileCount = 0;
+    for ( const auto& file : parser.values( fileOpt ) )
+    {
+        if ( engine->loadFile( file.toLocal8Bit().data() ) )
+        {
+            ++fileCount;
+            engine->releaseFile();
+        }
+        else
+        {
+            LOG( logERROR ) << "Cannot load file " << file.toStdString();
+        }
+    }
+    const double loadSeconds = Core::Timer::getIntervalSeconds( loadStart, Core::Timer::Clock::now() );
+    const std::size_t loadedMemory = Core::MemoryUsage::getCurrentResidentMemory();
+
+    // Step the frames as BaseApplication::radiumFrame does, without rendering.
+    Core::TaskQueue taskQueue( numThreads );
+    Core::TaskProfiler profiler;
+    std::vector<std::string> taskSystems;
+    uint taskCount = 0;
+    Core::Timer::TimePoint runStart = Core::Timer::Clock::now();
+    for ( uint frame = 0; frame < warmupFrames + numFrames; ++frame )
+    {
+        if ( frame == warmupFrames )
+        {
+            runStart = Core::Timer::Clock::now();
+        }
+        const auto frameStart = Core::Timer::Clock::now();
+
+        taskSystems.clear();
+        engine->getTasks( &taskQueue, dt, &taskSystems );
+        taskQueue.startTasks();
+        taskQueue.waitForTasks();
+        engine->endFrameSync();
+
+        const auto frameEnd = Core::Timer::Clock::now();
+        if ( frame >= warmupFrames )
+        {
+            profiler.addFrame( taskQueue.getTimerData(), taskSystems, Core::Timer::getIntervalSeconds( frameStart, frameEnd ) );
+            taskCount += uint( taskQueue.getTimerData().size() );
+        }
+        taskQueue.flushTaskQueue();
+    }
+    const double runSeconds = Core::Timer::getIntervalSeconds( runStart, Core::Timer::Clock::now() );
+
+    std::map<std::string, double> metrics;
+    metrics["dt"] = dt;
+    metrics["threads"] = numThreads;
+    metrics["plugins"] = pluginCount;
+    metrics["files"] = fileCount;
+    metrics["entities"] = engine->getEntityManager()->getEntities().size();
+    metrics["warmup_frames"] = warmupFrames;
+    metrics["load_seconds"] = loadSeconds;
+    metrics["run_seconds"] = runSeconds;
+    metrics["throughput_fps"] = runSeconds > 0 ? numFrames / runSeconds : 0;
+    metrics["tasks_per_second"] = runSeconds > 0 ? taskCount / runSeconds : 0;
+    metrics["initial_memory_bytes"] = initialMemory;
+    metrics["loaded_memory_bytes"] = loadedMemory;
+    metrics["final_memory_bytes"] = Core::MemoryUsage::getCurrentResidentMemory();
+    metrics["peak_memory_bytes"] = Core::MemoryUsage::getPeakResidentMemory();
+
+    if ( parser.isSet( outputOpt ) )
+    {
+        std::ofstream out( parser.value( outputOpt ).toStdString() );
+        profiler.writeJson( out, metrics, "systems" );
+    }
+    else
+    {
+        profiler.writeJson( std::cout, metrics, "systems" );
+    }
+
+    engine->cleanup();
+    Engine::RadiumEngine::destroyInstance();
+    return 0;
+}
@@ -145,6 +145,7 @@ namespace Gui
 
         connect(m_printGraph,       &QCheckBox::stateChanged, mainApp,  &Ra::GuiBase::BaseApplication::setRecordGraph);
         connect(m_printTimings,     &QCheckBox::stateChanged, mainApp,  &Ra::GuiBase::BaseApplication::setRecordTimings);
+        connect(m_pipelinedFrames,  &QCheckBox::stateChanged, mainApp,  &Ra::GuiBase::BaseApplication::setPipelinedFrames);
 
         // Connect engine signals to the appropriate callbacks
         std::function<void(const Engine::ItemEntry&)> add = std::bind(&MainWindow::onItemAdded, this, std::placeholders::_1);
@@ -220,6 +221,7 @@ namespace Gui
         long sumTasks = 0;
         long sumFrame = 0;
         long sumInterFrame = 0;
+        long sumOverlap = 0;
 
         for (uint i = 0; i < stats.size(); ++i)
         {
@@ -227,6 +229,7 @@ namespace Gui
             sumRender += Core::Timer::getIntervalMicro(stats[i].renderData.renderStart, stats[i].renderData.renderEnd);
             sumTasks += Core::Timer::getIntervalMicro(stats[i].tasksStart, stats[i].tasksEnd);
             sumFrame += Core::Timer::getIntervalMicro(stats[i].frameStart, stats[i].frameEnd);
+            sumOverlap += stats[i].getOverlapMicro();
 
             if (i > 0)
             {
@@ -246,6 +249,8 @@ namespace Gui
         m_frameTime->setNum(int(sumFrame / N));
         m_frameUpdates->setNum(int(T / Scalar(sumFrame)));
         m_avgFramerate->setNum(int((N - 1) * Scalar(1000000.0 / sumInterFrame)));
+        m_avgOverlap->setText(QString("%1 us (%2 %)").arg(sumOverlap / N)
+                              .arg(int(100 * sumOverlap / std::max(sumRender, 1l))));
     }
 
     Viewer* MainWindow::getViewer()
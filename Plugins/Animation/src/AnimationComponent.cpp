@@ -98,12 +98,14 @@ namespace AnimationPlugin
     {
         m_renderObjects.clear();
         m_boneDrawables.clear();
+        // One material per skeleton.
+        auto technique = SkeletonBoneRenderObject::makeBoneTechnique();
         for( uint i = 0; i < m_skel.size(); ++i ) {
             if( !m_skel.m_graph.isLeaf( i ) )
             {
                 std::string name = m_skel.getLabel(i);
                 Ra::Core::StringUtils::appendPrintf( name, " (%d)", i);
-                m_boneDrawables.emplace_back( new SkeletonBoneRenderObject( name, this, i, getRoMgr()));
+                m_boneDrawables.emplace_back( new SkeletonBoneRenderObject( name, this, i, getRoMgr(), technique));
                 m_renderObjects.push_back(m_boneDrawables.back()->getRenderObjectIndex() );
             } else {
                 LOG( logDEBUG ) << "Bone " << m_skel.getLabel( i ) << " not displayed.";
@@ -230,18 +232,27 @@ namespace AnimationPlugin
                                                 const std::map< uint, uint >& indexTable,
                                                 const std::vector<Ra::Core::Index> &duplicateTable,
                                                 uint nbMeshVertices ) {
-        m_weights.resize( nbMeshVertices, data->getComponentDataSize() );
-
-        for( const auto& it : indexTable ) {
-            const uint idx = it.first;
-            const uint col = it.second;
-            const uint size = data->getComponent( idx ).m_weight.size();
-            for( uint i = 0; i < size; ++i ) {
-                const uint   row = duplicateTable.at( data->getComponent( idx ).m_weight[i].first );
-                const Scalar w   = data->getComponent( idx ).m_weight[i].second;
-                m_weights.coeffRef( row, col ) = w;
+        // The weights of each handle are written in parallel, at their rank in the handle order,
+        // so that a vertex duplicated in a handle keeps its last weight.
+        const std::vector< std::pair< uint, uint > > handles( indexTable.begin(), indexTable.end() );
+        std::vector< uint > offset( handles.size() + 1, 0 );
+        for( uint h = 0; h < handles.size(); ++h ) {
+            offset[h + 1] = offset[h] + data->getComponent( handles[h].first ).m_weight.size();
+        }
+
+        std::vector< Ra::Core::Animation::WeightTriplet > triplets( offset.back() );
+        #pragma omp parallel for
+        for( int h = 0; h < int( handles.size() ); ++h ) {
+            const auto& weight = data->getComponent( handles[h].first ).m_weight;
+            const uint col = handles[h].second;
+            for( uint i = 0; i < weight.size(); ++i ) {
+                CORE_ASSERT( weight[i].first < duplicateTable.size(), "Invalid vertex index" );
+                const uint row = duplicateTable[weight[i].first];
+                triplets[offset[h] + i] = Ra::Core::Animation::WeightTriplet( row, col, weight[i].second );
             }
         }
+        m_weights = Ra::Core::Animation::createWeightMatrix( triplets, nbMeshVertices,
+                                                             data->getComponentDataSize() );
         Ra::Core::Animation::checkWeightMatrix( m_weights, false, true );
 
         if (Ra::Core::Animation::normalizeWeights ( m_weights, true ))
@@ -257,17 +268,11 @@ namespace AnimationPlugin
 
     void AnimationComponent::setupIO(const std::string &id)
     {
-        ComponentMessenger::CallbackTypes<Skeleton>::Getter skelOut = std::bind( &AnimationComponent::getSkeletonOutput, this );
-        ComponentMessenger::getInstance()->registerOutput<Skeleton>( getEntity(), this, id, skelOut);
-
-        ComponentMessenger::CallbackTypes<RefPose>::Getter refpOut = std::bind( &AnimationComponent::getRefPoseOutput, this );
-        ComponentMessenger::getInstance()->registerOutput<Ra::Core::Animation::Pose>( getEntity(), this, id, refpOut);
-
-        ComponentMessenger::CallbackTypes<WeightMatrix>::Getter wOut = std::bind( &AnimationComponent::getWeightsOutput, this );
-        ComponentMessenger::getInstance()->registerOutput<Ra::Core::Animation::WeightMatrix>( getEntity(), this, id, wOut);
-
-        ComponentMessenger::CallbackTypes<bool>::Getter resetOut = std::bind( &AnimationComponent::getWasReset, this );
-        ComponentMessenger::getInstance()->registerOutput<bool>( getEntity(), this, id, resetOut);
+        // These members live as long as the component : readers access them directly.
+        ComponentMessenger::getInstance()->registerOutput<Skeleton>( getEntity(), this, id, getSkeletonOutput() );
+        ComponentMessenger::getInstance()->registerOutput<Ra::Core::Animation::Pose>( getEntity(), this, id, getRefPoseOutput() );
+        ComponentMessenger::getInstance()->registerOutput<Ra::Core::Animation::WeightMatrix>( getEntity(), this, id, getWeightsOutput() );
+        ComponentMessenger::getInstance()->registerOutput<bool>( getEntity(), this, id, getWasReset() );
 
         ComponentMessenger::CallbackTypes<Animation>::Getter animOut = std::bind( &AnimationComponent::getAnimation, this );
         ComponentMessenger::getInstance()->registerOutput<Animation>(getEntity(), this, id, animOut);
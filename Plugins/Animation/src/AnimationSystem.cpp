@@ -28,14 +28,12 @@ namespace AnimationPlugin
 
         Scalar currentDelta = playFrame ? frameInfo.m_dt : 0;
 
-        for (auto compEntry : this->m_components)
-        {
-            AnimationComponent* component = static_cast<AnimationComponent*>(compEntry.second);
-            Ra::Core::FunctionTask* task = new Ra::Core::FunctionTask(
-                    std::bind(&AnimationComponent::update, component, currentDelta),
-                    "AnimatorTask");
-            taskQueue->registerTask( task );
-        }
+        // Skeletons are small : update a few of them in each task.
+        registerChunkedTasks( taskQueue, "AnimatorTask",
+                              [currentDelta]( Ra::Engine::Component* component )
+                              {
+                                  static_cast<AnimationComponent*>( component )->update( currentDelta );
+                              }, 8 );
 
         m_oneStep = false;
     }
@@ -149,25 +147,20 @@ namespace AnimationPlugin
         {
             // If entry is an existing animation component, we return this one's time
             // if not, look for other components in this entity to see if some are animation
-            std::vector<const AnimationComponent*> comps;
-            for (const auto& ec : m_components)
+            const auto comps = getEntityComponents( entry.m_entity );
+            for (const auto& c : comps)
             {
-                if (ec.first == entry.m_entity)
+                // Entry match, return that one
+                if (c == entry.m_component)
                 {
-                    const AnimationComponent* c = static_cast< AnimationComponent*>(ec.second);
-                    // Entry match, return that one
-                    if (ec.second == c)
-                    {
-                        return c->getTime();
-                    }
-                    comps.push_back(c);
+                    return static_cast<const AnimationComponent*>(c)->getTime();
                 }
             }
             // If comps is not empty, it means that we have a component in current entity
-            // We just pick the first one
+            // We just pick the first one registered
             if (!comps.empty())
             {
-                return comps[0]->getTime();
+                return static_cast<const AnimationComponent*>(comps[0])->getTime();
             }
         }
         return 0.f;
@@ -10,33 +10,46 @@
 
 namespace AnimationPlugin
 {
+    namespace
+    {
+        // All the bones share their mesh, so that the render queues draw the bones of a skeleton,
+        // which also share their technique, with instanced draw calls. It is released with the last bone.
+        std::weak_ptr<Ra::Engine::Mesh> s_boneMesh;
+    }
 
-    SkeletonBoneRenderObject::SkeletonBoneRenderObject(const std::string& name, AnimationComponent* comp, uint id, Ra::Engine::RenderObjectManager* roMgr)
-    : m_roIdx(Ra::Core::Index::Invalid()) , m_id( id ), m_skel( comp->getSkeleton() ), m_roMgr( roMgr )
+    std::shared_ptr<Ra::Engine::RenderTechnique> SkeletonBoneRenderObject::makeBoneTechnique()
     {
-        // TODO ( Val) common material / shader config...
+        Ra::Engine::ShaderConfiguration shader = Ra::Engine::ShaderConfigurationFactory::getConfiguration("BlinnPhong");
+        auto bpMaterial = new Ra::Engine::BlinnPhongMaterial("Bone Material");
+        std::shared_ptr<Ra::Engine::Material> material( bpMaterial );
+        bpMaterial->m_kd = Ra::Core::Color(0.4f, 0.4f, 0.4f, 0.5f);
+        bpMaterial->m_ks = Ra::Core::Color(0.0f, 0.0f, 0.0f, 1.0f);
+        material->setMaterialType(Ra::Engine::Material::MaterialType::MAT_OPAQUE);
+
+        std::shared_ptr<Ra::Engine::RenderTechnique> technique( new Ra::Engine::RenderTechnique() );
+        technique->setConfiguration(shader);
+        technique->setMaterial( material );
+        return technique;
+    }
 
+    SkeletonBoneRenderObject::SkeletonBoneRenderObject(const std::string& name, AnimationComponent* comp, uint id, Ra::Engine::RenderObjectManager* roMgr,
+                                                       const std::shared_ptr<Ra::Engine::RenderTechnique>& technique)
+    : m_roIdx(Ra::Core::Index::Invalid()) , m_id( id ), m_skel( comp->getSkeleton() ), m_renderParams( technique ), m_roMgr( roMgr )
+    {
         // FIXME(Charly): Debug or fancy ?
         Ra::Engine::RenderObject* renderObject = new Ra::Engine::RenderObject( name, comp, Ra::Engine::RenderObjectType::Fancy);
         renderObject->setXRay( false );
 
-        Ra::Engine::ShaderConfiguration shader = Ra::Engine::ShaderConfigurationFactory::getConfiguration("BlinnPhong");
-        auto bpMaterial = new Ra::Engine::BlinnPhongMaterial("Bone Material");
-        m_material.reset(bpMaterial);
-        bpMaterial->m_kd = Ra::Core::Color(0.4f, 0.4f, 0.4f, 0.5f);
-        bpMaterial->m_ks = Ra::Core::Color(0.0f, 0.0f, 0.0f, 1.0f);
-        m_material->setMaterialType(Ra::Engine::Material::MaterialType::MAT_OPAQUE);
+        m_material = m_renderParams->getMaterial();
+        renderObject->setRenderTechnique(m_renderParams);
 
-        m_renderParams.reset(new Ra::Engine::RenderTechnique());
+        std::shared_ptr<Ra::Engine::Mesh> displayMesh = s_boneMesh.lock();
+        if ( !displayMesh )
         {
-            m_renderParams->setConfiguration(shader);
-            m_renderParams->setMaterial( m_material );
+            displayMesh.reset( new Ra::Engine::Mesh( "Bone" ) );
+            displayMesh->loadGeometry( makeBoneShape() );
+            s_boneMesh = displayMesh;
         }
-        renderObject->setRenderTechnique(m_renderParams);
-
-        std::shared_ptr<Ra::Engine::Mesh> displayMesh( new Ra::Engine::Mesh( name ) );
-
-        displayMesh->loadGeometry( makeBoneShape() );
         renderObject->setMesh( displayMesh );
 
         m_roIdx  = m_roMgr->addRenderObject(renderObject);
@@ -19,12 +19,18 @@ namespace AnimationPlugin
 class SkeletonBoneRenderObject
 {
 public:
-    SkeletonBoneRenderObject(const std::string& name, AnimationComponent* comp, uint id, Ra::Engine::RenderObjectManager* roMgr);
+    /// technique is shared by the bones of a skeleton, so that they have the same material and are
+    /// drawn with instancing : editing the material of a bone changes the whole skeleton.
+    SkeletonBoneRenderObject(const std::string& name, AnimationComponent* comp, uint id, Ra::Engine::RenderObjectManager* roMgr,
+                             const std::shared_ptr<Ra::Engine::RenderTechnique>& technique);
 
     void update(); // Update local transform of the associated render object
 
     static Ra::Core::TriangleMesh makeBoneShape();
 
+    /// Create the technique and material of the bones of a skeleton.
+    static std::shared_ptr<Ra::Engine::RenderTechnique> makeBoneTechnique();
+
     uint getBoneIndex() const { return m_id; }
 
     Ra::Core::Index getRenderObjectIndex() const { return m_roIdx;}
@@ -59,7 +59,7 @@ namespace FancyMeshPlugin
         addRenderObject(renderObject);
     }
 
-    void FancyMeshComponent::handleMeshLoading( const Ra::Asset::GeometryData* data )
+    void FancyMeshComponent::handleMeshLoading( Ra::Asset::GeometryData* data )
     {
         std::string name( m_name );
         name.append( "_" + data->getName() );
@@ -84,31 +84,60 @@ namespace FancyMeshPlugin
         Ra::Core::Transform N;
         N.matrix() = (T.matrix()).inverse().transpose();
 
-        mesh.m_vertices.resize( data->getVerticesSize(), Ra::Core::Vector3::Zero() );
+        // When the file data is transferable, its arrays are moved and transformed in place,
+        // so that only the display mesh holds the geometry.
+        const bool transfer = data->isTransferable();
+        const bool hasNormals = data->hasNormals();
+        if ( transfer )
+        {
+            mesh.m_vertices = data->takeVertices();
+            if ( hasNormals )
+            {
+                mesh.m_normals = data->takeNormals();
+            }
+        }
+        else
+        {
+            mesh.m_vertices = data->getVertices();
+            if ( hasNormals )
+            {
+                mesh.m_normals = data->getNormals();
+            }
+        }
+
+        const int vertexCount = int( mesh.m_vertices.size() );
         #pragma omp parallel for
-        for (uint i = 0; i < data->getVerticesSize(); ++i)
+        for ( int i = 0; i < vertexCount; ++i )
         {
-            mesh.m_vertices[i] = T * data->getVertices()[i];
+            mesh.m_vertices[i] = T * mesh.m_vertices[i];
         }
 
-        if (data->hasNormals())
+        if ( hasNormals )
         {
-            mesh.m_normals.resize( data->getVerticesSize(), Ra::Core::Vector3::Zero() );
             #pragma omp parallel for
-            for (uint i = 0; i < data->getVerticesSize(); ++i)
+            for ( int i = 0; i < vertexCount; ++i )
             {
-                mesh.m_normals[i] = (N * data->getNormals()[i]).normalized();
+                mesh.m_normals[i] = ( N * mesh.m_normals[i] ).normalized();
             }
         }
 
-        mesh.m_triangles.resize( data->getFaces().size(), Ra::Core::Triangle::Zero() );
-        #pragma omp parallel for
-        for (uint i = 0; i < data->getFaces().size(); ++i)
         {
-            mesh.m_triangles[i] = data->getFaces()[i].head<3>();
+            Ra::Asset::GeometryData::VectorNuArray faces;
+            if ( transfer )
+            {
+                faces = data->takeFaces();
+            }
+            const Ra::Asset::GeometryData::VectorNuArray& source = transfer ? faces : data->getFaces();
+            const int faceCount = int( source.size() );
+            mesh.m_triangles.resize( faceCount, Ra::Core::Triangle::Zero() );
+            #pragma omp parallel for
+            for ( int i = 0; i < faceCount; ++i )
+            {
+                mesh.m_triangles[i] = source[i].head<3>();
+            }
         }
 
-        displayMesh->loadGeometry(mesh);
+        displayMesh->loadGeometry( std::move( mesh ) );
 
         // get the actual duplicate table according to the mesh, not to the file data.
         if (!data->isLoadingDuplicates())
@@ -118,27 +147,55 @@ namespace FancyMeshPlugin
         }
         else
         {
-            Ra::Core::MeshUtils::findDuplicates( mesh, m_duplicateTable );
+            Ra::Core::MeshUtils::findDuplicates( displayMesh->getGeometry(), m_duplicateTable );
         }
 
         if (data->hasTangents())
         {
-            displayMesh->addData( Ra::Engine::Mesh::VERTEX_TANGENT, data->getTangents() );
+            if ( transfer )
+            {
+                displayMesh->addData( Ra::Engine::Mesh::VERTEX_TANGENT, data->takeTangents() );
+            }
+            else
+            {
+                displayMesh->addData( Ra::Engine::Mesh::VERTEX_TANGENT, data->getTangents() );
+            }
         }
 
         if (data->hasBiTangents())
         {
-            displayMesh->addData( Ra::Engine::Mesh::VERTEX_BITANGENT, data->getBiTangents() );
+            if ( transfer )
+            {
+                displayMesh->addData( Ra::Engine::Mesh::VERTEX_BITANGENT, data->takeBiTangents() );
+            }
+            else
+            {
+                displayMesh->addData( Ra::Engine::Mesh::VERTEX_BITANGENT, data->getBiTangents() );
+            }
         }
 
         if (data->hasTextureCoordinates())
         {
-            displayMesh->addData( Ra::Engine::Mesh::VERTEX_TEXCOORD, data->getTexCoords() );
+            if ( transfer )
+            {
+                displayMesh->addData( Ra::Engine::Mesh::VERTEX_TEXCOORD, data->takeTexCoords() );
+            }
+            else
+            {
+                displayMesh->addData( Ra::Engine::Mesh::VERTEX_TEXCOORD, data->getTexCoords() );
+            }
         }
 
         if (data->hasColors())
         {
-            displayMesh->addData( Ra::Engine::Mesh::VERTEX_COLOR, data->getColors() );
+            if ( transfer )
+            {
+                displayMesh->addData( Ra::Engine::Mesh::VERTEX_COLOR, data->takeColors() );
+            }
+            else
+            {
+                displayMesh->addData( Ra::Engine::Mesh::VERTEX_COLOR, data->getColors() );
+            }
         }
 
         // FIXME(Charly): Should not weights be part of the geometry ?
@@ -42,7 +42,7 @@ namespace FancyMeshPlugin
         void initialize() override;
 
         void addMeshRenderObject(const Ra::Core::TriangleMesh& mesh, const std::string& name);
-        void handleMeshLoading(const Ra::Asset::GeometryData* data);
+        void handleMeshLoading(Ra::Asset::GeometryData* data);
 
         /// Returns the index of the associated RO (the display mesh)
         Ra::Core::Index getRenderObjectIndex() const;
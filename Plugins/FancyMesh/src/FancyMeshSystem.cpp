@@ -37,6 +37,9 @@ namespace FancyMeshPlugin
             std::string componentName = "FMC_" + entity->getName() + std::to_string( id++ );
             FancyMeshComponent * comp = new FancyMeshComponent( componentName, fileData->hasHandle() );
             entity->addComponent( comp );
+            // The other systems only read the names, vertex counts and duplicate tables of the
+            // geometries : the display meshes take their attributes instead of copying them.
+            data->setTransferable( true );
             comp->handleMeshLoading( data );
             registerComponent( entity, comp );
         }
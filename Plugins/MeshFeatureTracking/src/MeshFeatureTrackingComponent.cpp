@@ -419,9 +419,21 @@ namespace MeshFeatureTrackingPlugin
             return;
         }
         const auto &t = ro->getMesh()->getGeometry().m_triangles;
+        if (rm == MeshRenderMode::RM_TRIANGLE_FAN)
+        {
+            m_data.m_data[1] = ( idx == 0 ? t[0](1) : 0 );
+            return;
+        }
+        // Only look at the elements containing the vertex, in index order.
+        const auto incidence = ro->getMesh()->getGeometry().getIncidence();
+        if ( idx < 0 || uint(idx) >= incidence->getVertexCount() )
+        {
+            return;
+        }
+        const auto elements = incidence->getVertexTriangles( idx );
         if (rm == MeshRenderMode::RM_LINES)
         {
-            for (uint i=0; i<t.size(); ++i)
+            for (uint i : elements)
             {
                 const auto &T = t[i];
                 if (T(0) == idx)
@@ -443,7 +455,7 @@ namespace MeshFeatureTrackingPlugin
         }
         if (rm == MeshRenderMode::RM_LINE_LOOP || rm == MeshRenderMode::RM_LINE_STRIP)
         {
-            for (uint i=0; i<t.size(); ++i)
+            for (uint i : elements)
             {
                 const auto &T = t[i];
                 if (T(0) == idx)
@@ -465,7 +477,7 @@ namespace MeshFeatureTrackingPlugin
         }
         if (rm == MeshRenderMode::RM_LINES_ADJACENCY)
         {
-            for (uint i=0; i<t.size(); ++i)
+            for (uint i : elements)
             {
                 const auto &T = t[i];
                 if (T(0) == idx && i%4 > 1 )
@@ -487,7 +499,7 @@ namespace MeshFeatureTrackingPlugin
         }
         if (rm == MeshRenderMode::RM_LINE_STRIP_ADJACENCY)
         {
-            for (uint i=0; i<t.size(); ++i)
+            for (uint i : elements)
             {
                 const auto &T = t[i];
                 if (T(0) == idx && i != 0)
@@ -509,7 +521,7 @@ namespace MeshFeatureTrackingPlugin
         }
         if (rm == MeshRenderMode::RM_TRIANGLES || rm == MeshRenderMode::RM_TRIANGLE_STRIP)
         {
-            for (uint i=0; i<t.size(); ++i)
+            for (uint i : elements)
             {
                 const auto &T = t[i];
                 if (T(0) == idx)
@@ -524,11 +536,6 @@ namespace MeshFeatureTrackingPlugin
                 }
             }
         }
-        if (rm == MeshRenderMode::RM_TRIANGLE_FAN)
-        {
-            m_data.m_data[1] = ( idx == 0 ? t[0](1) : 0 );
-            return;
-        }
     }
 
     void MeshFeatureTrackingComponent::setTriangleIdx( int idx )
@@ -24,6 +24,31 @@ using Ra::Engine::ComponentMessenger;
 namespace SkinningPlugin
 {
 
+    SkinningComponent::~SkinningComponent()
+    {
+       // The messenger may already be destroyed when the engine is torn down.
+       if ( m_listenerId >= 0 && ComponentMessenger::getInstance() )
+       {
+           ComponentMessenger::getInstance()->removeChangeListener( getEntity(), m_listenerId );
+       }
+    }
+
+    void SkinningComponent::resolveHandles()
+    {
+       auto compMsg = ComponentMessenger::getInstance();
+       m_skeletonGetter = compMsg->getOutputHandle<Skeleton>( getEntity(), m_contentsName );
+       m_resetGetter    = compMsg->getOutputHandle<bool>( getEntity(), m_contentsName );
+       m_verticesWriter = compMsg->getRwHandle<Ra::Core::Vector3Array>( getEntity(), m_contentsName+"v" );
+       m_normalsWriter  = compMsg->getRwHandle<Ra::Core::Vector3Array>( getEntity(), m_contentsName+"n" );
+       m_duplicateTableGetter = compMsg->getOutputHandle<std::vector<Ra::Core::Index>>( getEntity(), m_contentsName );
+    }
+
+    bool SkinningComponent::hasValidHandles() const
+    {
+       return m_skeletonGetter.isValid() && m_resetGetter.isValid() && m_verticesWriter.isValid()
+           && m_normalsWriter.isValid() && m_duplicateTableGetter.isValid();
+    }
+
     void SkinningComponent::setupSkinning()
     {
        auto compMsg = ComponentMessenger::getInstance();
@@ -36,10 +61,19 @@ namespace SkinningPlugin
 
        if ( hasSkel && hasWeights && hasMesh && hasRefPose )
        {
-           m_skeletonGetter = compMsg->getterCallback<Skeleton>( getEntity(), m_contentsName );
-           m_verticesWriter = compMsg->rwCallback<Ra::Core::Vector3Array>( getEntity(), m_contentsName+"v" );
-           m_normalsWriter  = compMsg->rwCallback<Ra::Core::Vector3Array>( getEntity(), m_contentsName+"n" );
-           m_duplicateTableGetter = compMsg->getterCallback<std::vector<Ra::Core::Index>>( getEntity(), m_contentsName );
+           resolveHandles();
+           if ( m_listenerId < 0 )
+           {
+               // The mesh or the skeleton may be registered again by another component.
+               m_listenerId = compMsg->addChangeListener( getEntity(),
+                   [this]( const Ra::Engine::Entity*, const std::string& id )
+                   {
+                       if ( id == m_contentsName || id == m_contentsName+"v" || id == m_contentsName+"n" )
+                       {
+                           resolveHandles();
+                       }
+                   } );
+           }
 
            m_refData.m_skeleton      = compMsg->get<Skeleton>( getEntity(), m_contentsName );
            m_refData.m_referenceMesh = compMsg->get<TriangleMesh>( getEntity(), m_contentsName );
@@ -70,10 +104,15 @@ namespace SkinningPlugin
     void SkinningComponent::skin()
     {
        CORE_ASSERT( m_isReady, "Skinning is not setup");
+       if ( !hasValidHandles() )
+       {
+           // An entry was unregistered and is not available again yet.
+           return;
+       }
 
-       const Skeleton* skel = m_skeletonGetter();
+       const Skeleton* skel = &m_skeletonGetter.get();
 
-       bool reset = ComponentMessenger::getInstance()->get<bool>(getEntity(), m_contentsName);
+       bool reset = m_resetGetter.get();
 
        // Reset the skin if it wasn't done before
        if (reset && !m_frameData.m_doReset )
@@ -119,14 +158,19 @@ namespace SkinningPlugin
 
     void SkinningComponent::endSkinning()
     {
+       if ( !hasValidHandles() )
+       {
+           return;
+       }
+
        if (m_frameData.m_doSkinning)
        {
-           Ra::Core::Vector3Array& vertices = *(m_verticesWriter());
-           Ra::Core::Vector3Array& normals = *(m_normalsWriter());
+           Ra::Core::Vector3Array& vertices = *(m_verticesWriter.rw());
+           Ra::Core::Vector3Array& normals = *(m_normalsWriter.rw());
 
            vertices = m_frameData.m_currentPos;
 
-           Ra::Core::Geometry::uniformNormal( vertices, m_refData.m_referenceMesh.m_triangles, *(m_duplicateTableGetter()), normals );
+           Ra::Core::Geometry::uniformNormal( vertices, m_refData.m_referenceMesh.m_triangles, m_duplicateTableGetter.get(), normals );
 
            std::swap( m_frameData.m_previousPose, m_frameData.m_currentPose );
            std::swap( m_frameData.m_previousPos, m_frameData.m_currentPos );
@@ -137,8 +181,8 @@ namespace SkinningPlugin
        else if (m_frameData.m_doReset)
        {
            // Reset mesh to its initial state.
-           Ra::Core::Vector3Array& vertices = *(m_verticesWriter());
-           Ra::Core::Vector3Array& normals =  *(m_normalsWriter());
+           Ra::Core::Vector3Array& vertices = *(m_verticesWriter.rw());
+           Ra::Core::Vector3Array& normals =  *(m_normalsWriter.rw());
 
            vertices = m_refData.m_referenceMesh.m_vertices;
            normals = m_refData.m_referenceMesh.m_normals;
@@ -205,7 +249,7 @@ namespace SkinningPlugin
        {
            if ( m_refData.m_CoR.empty() )
            {
-               Ra::Core::Animation::computeCoR( m_refData );
+               Ra::Core::Animation::loadOrComputeCoR( m_refData, m_corCacheDirectory );
     /*
                for ( const auto& v :m_refData.m_CoR )
                {
@@ -29,8 +29,9 @@ namespace SkinningPlugin
         SkinningComponent( const std::string& name, SkinningType type = DQS)
             : Component(name),
             m_skinningType( type ),
-            m_isReady(false) {}
-        virtual ~SkinningComponent() {}
+            m_isReady(false),
+            m_listenerId(-1) {}
+        virtual ~SkinningComponent();
 
         virtual void initialize() override { setupSkinning();}
 
@@ -53,23 +54,38 @@ namespace SkinningPlugin
         void setupSkinningType( SkinningType type);
         void setContentsName (const std::string name);
 
+        /// Folder of the cache files of the centers of rotation, which must exist.
+        /// No cache if empty.
+        void setCoRCacheDirectory( const std::string& directory ) { m_corCacheDirectory = directory; }
+
+    private:
+        /// Resolve the messenger handles again, called when the entity entries change.
+        void resolveHandles();
+
+        /// False if one of the entries read or written by the skinning is not registered.
+        bool hasValidHandles() const;
+
     private:
         std::string m_contentsName;
+        std::string m_corCacheDirectory;
 
         // Skinning data
         Ra::Core::Skinning::RefData m_refData;
         Ra::Core::Skinning::FrameData m_frameData;
 
-        Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Animation::Skeleton>::Getter m_skeletonGetter;
-        Ra::Engine::ComponentMessenger::CallbackTypes<std::vector<Ra::Core::Index>>::Getter m_duplicateTableGetter;
+        // Messenger handles, resolved in setupSkinning() and when the entity entries change.
+        Ra::Engine::ComponentMessenger::OutputHandle<Ra::Core::Animation::Skeleton> m_skeletonGetter;
+        Ra::Engine::ComponentMessenger::OutputHandle<std::vector<Ra::Core::Index>> m_duplicateTableGetter;
+        Ra::Engine::ComponentMessenger::OutputHandle<bool> m_resetGetter;
 
-        Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Vector3Array>::ReadWrite m_verticesWriter;
-        Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Vector3Array>::ReadWrite m_normalsWriter;
+        Ra::Engine::ComponentMessenger::RwHandle<Ra::Core::Vector3Array> m_verticesWriter;
+        Ra::Engine::ComponentMessenger::RwHandle<Ra::Core::Vector3Array> m_normalsWriter;
 
         Ra::Core::AlignedStdVector< Ra::Core::DualQuaternion > m_DQ;
 
         SkinningType m_skinningType;
         bool m_isReady;
+        int m_listenerId; /// Messenger change listener, -1 if none.
     };
 }
 
@@ -1,5 +1,9 @@
 #include <SkinningPlugin.hpp>
 
+#include <QDir>
+#include <QStandardPaths>
+
+#include <Core/Log/Log.hpp>
 #include <Engine/RadiumEngine.hpp>
 
 #include <SkinningSystem.hpp>
@@ -15,6 +19,18 @@ namespace SkinningPlugin
     void SkinningPluginC::registerPlugin( const Ra::PluginContext& context )
     {
         m_system = new SkinningSystem;
+
+        // Centers of rotation are cached between runs.
+        const QString corCache = QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + "/cor";
+        if ( QDir().mkpath( corCache ) )
+        {
+            m_system->setCoRCacheDirectory( corCache.toStdString() );
+        }
+        else
+        {
+            LOG( logWARNING ) << "Could not create the CoR cache directory " << corCache.toStdString()
+                              << ", centers of rotation will be computed at each run.";
+        }
         m_selectionManager = context.m_selectionManager;
         context.m_engine->registerSystem( "SkinningSystem", m_system );
         m_widget = new SkinningWidget;
@@ -22,26 +22,26 @@ namespace SkinningPlugin
     {
     public:
         SkinningSystem(){}
+
+        /// Folder of the cache files of the centers of rotation, given to the new components.
+        void setCoRCacheDirectory( const std::string& directory ) { m_corCacheDirectory = directory; }
+
         virtual void generateTasks( Ra::Core::TaskQueue* taskQueue,
                                     const Ra::Engine::FrameInfo& frameInfo ) override
         {
-            for (const auto& compEntry : m_components)
+            // Both calls make the same chunks : each end task waits for the skinning of its chunk.
+            const uint chunkSize = 4;
+            const auto skinTasks = registerChunkedTasks( taskQueue, "SkinnerTask",
+                    []( Ra::Engine::Component* comp ) { static_cast<SkinningComponent*>( comp )->skin(); },
+                    chunkSize );
+            const auto endTasks = registerChunkedTasks( taskQueue, "SkinnerEndTask",
+                    []( Ra::Engine::Component* comp ) { static_cast<SkinningComponent*>( comp )->endSkinning(); },
+                    chunkSize );
+
+            for ( uint i = 0; i < skinTasks.size(); ++i )
             {
-                SkinningComponent* comp = static_cast<SkinningComponent*>( compEntry.second );
-                Ra::Core::FunctionTask* skinTask = new Ra::Core::FunctionTask(
-                        std::bind(&SkinningComponent::skin, comp),
-                        "SkinnerTask"
-                );
-
-                Ra::Core::FunctionTask* endTask = new Ra::Core::FunctionTask(
-                        std::bind(&SkinningComponent::endSkinning, comp),
-                        "SkinnerEndTask"
-                );
-
-                Ra::Core::TaskQueue::TaskId skinTaskId = taskQueue->registerTask( skinTask );
-                Ra::Core::TaskQueue::TaskId endTaskId = taskQueue->registerTask( endTask );
-                taskQueue->addPendingDependency( "AnimatorTask", skinTaskId );
-                taskQueue->addDependency( skinTaskId, endTaskId);
+                taskQueue->addPendingDependency( "AnimatorTask", skinTasks[i] );
+                taskQueue->addDependency( skinTasks[i], endTasks[i] );
             }
 
         }
@@ -57,6 +57,7 @@ namespace SkinningPlugin
                 for (const auto& skel : skelData)
                 {
                     SkinningComponent* component = new SkinningComponent( "SkC_" + skel->getName() );
+                    component->setCoRCacheDirectory( m_corCacheDirectory );
                     entity->addComponent( component );
                     component->handleWeightsLoading( skel );
                     registerComponent( entity, component );
@@ -68,6 +69,8 @@ namespace SkinningPlugin
             }
         }
 
+    private:
+        std::string m_corCacheDirectory;
     };
 }
 
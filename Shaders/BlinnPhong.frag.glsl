@@ -1,7 +1,7 @@
 #include "Structs.glsl"
+#include "LightBlock.glsl"
 
 uniform Material material;
-uniform Light light;
 uniform sampler2D uShadowMap;
 
 out vec4 fragColor;
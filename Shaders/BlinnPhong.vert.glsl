@@ -1,4 +1,6 @@
 #include "Structs.glsl"
+#include "CameraBlock.glsl"
+#include "VertexPacking.glsl"
 
 layout (location = 0) in vec3 in_position;
 layout (location = 1) in vec3 in_normal;
@@ -10,6 +12,8 @@ layout (location = 4) in vec3 in_texcoord;
 uniform Transform transform;
 uniform Material material;
 
+#include "Instancing.glsl"
+
 uniform mat4 uLightSpace;
 
 layout (location = 0) out vec3 out_position;
@@ -20,19 +24,22 @@ layout (location = 4) out vec3 out_tangent;
 
 void main()
 {
-    mat4 mvp = transform.proj * transform.view * transform.model;
-    gl_Position = mvp * vec4(in_position, 1.0);
+    vec3 position = unpackPosition(in_position);
+    mat4 model = getModelMatrix();
+
+    mat4 mvp = camera.proj * camera.view * model;
+    gl_Position = mvp * vec4(position, 1.0);
 
-    vec4 pos = transform.model * vec4(in_position, 1.0);
+    vec4 pos = model * vec4(position, 1.0);
     pos /= pos.w;
-    vec3 normal = mat3(transform.worldNormal) * in_normal;
+    vec3 normal = mat3(getNormalMatrix()) * unpackDirection(in_normal);
 
-    vec3 eye = -transform.view[3].xyz * mat3(transform.view);
+    vec3 eye = -camera.view[3].xyz * mat3(camera.view);
 
     out_position = vec3(pos);
     out_normal   = normal;
     out_eye      = vec3(eye);
-    out_tangent  = in_tangent;
+    out_tangent  = unpackDirection(in_tangent);
 
     out_texcoord = in_texcoord;
 
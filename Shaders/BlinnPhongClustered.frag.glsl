@@ -0,0 +1,21 @@
+#include "Structs.glsl"
+#include "CameraBlock.glsl"
+
+uniform Material material;
+
+out vec4 fragColor;
+
+layout (location = 0) in vec3 in_position;
+layout (location = 1) in vec3 in_normal;
+layout (location = 2) in vec3 in_texcoord;
+layout (location = 3) in vec3 in_eye;
+layout (location = 4) in vec3 in_tangent;
+
+#include "ClusteredLighting.glsl"
+
+void main()
+{
+    if (toDiscard()) discard;
+
+    fragColor = vec4(computeClusteredLighting(), 1.0);
+}
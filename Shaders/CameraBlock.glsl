@@ -0,0 +1,8 @@
+// Camera uniform block shared by all programs, filled once per frame by the renderer.
+// Layout must match CameraBlock in Engine/Renderer/RenderTechnique/UniformBlocks.hpp.
+
+layout (std140) uniform CameraBlock
+{
+    mat4 view;
+    mat4 proj;
+} camera;
@@ -0,0 +1,73 @@
+// Single pass lighting with the lights culled on the CPU per view cluster
+// (see Engine/Renderer/Light/ClusteredLighting.hpp).
+// Requires Structs.glsl, CameraBlock.glsl, the material uniform and the fragment
+// inputs used by LightingFunctions.glsl to be declared first.
+
+// Lights packed as LightBlock structures, 9 texels each.
+uniform samplerBuffer uClusterLights;
+// ( offset, count ) of the light list of each cluster.
+uniform usamplerBuffer uClusterGrid;
+// Light indices of all clusters.
+uniform usamplerBuffer uClusterLightIndices;
+
+uniform int   uClusterTilesX;
+uniform int   uClusterTilesY;
+uniform int   uClusterSlices;
+uniform vec2  uClusterTileSize;
+uniform float uClusterNear;
+uniform float uClusterSliceScale;
+
+// The light currently shaded by LightingFunctions.glsl.
+Light light;
+
+#include "LightingFunctions.glsl"
+
+Light fetchLight(int index)
+{
+    int base = 9 * index;
+    Light l;
+
+    l.type  = floatBitsToInt(texelFetch(uClusterLights, base).x);
+    l.color = texelFetch(uClusterLights, base + 1);
+
+    l.directional.direction = texelFetch(uClusterLights, base + 2).xyz;
+
+    l.point.position = texelFetch(uClusterLights, base + 3).xyz;
+    vec3 att = texelFetch(uClusterLights, base + 4).xyz;
+    l.point.attenuation = Attenuation(att.x, att.y, att.z);
+
+    l.spot.position  = texelFetch(uClusterLights, base + 5).xyz;
+    l.spot.direction = texelFetch(uClusterLights, base + 6).xyz;
+    att = texelFetch(uClusterLights, base + 7).xyz;
+    l.spot.attenuation = Attenuation(att.x, att.y, att.z);
+    vec2 angles = texelFetch(uClusterLights, base + 8).xy;
+    l.spot.innerAngle = angles.x;
+    l.spot.outerAngle = angles.y;
+
+    return l;
+}
+
+int getCluster()
+{
+    float depth = -(camera.view * vec4(in_position, 1.0)).z;
+    int slice = int(log(max(depth / uClusterNear, 1.0)) * uClusterSliceScale);
+    ivec2 tile = ivec2(gl_FragCoord.xy / uClusterTileSize);
+
+    slice = clamp(slice, 0, uClusterSlices - 1);
+    tile  = clamp(tile, ivec2(0), ivec2(uClusterTilesX - 1, uClusterTilesY - 1));
+
+    return tile.x + uClusterTilesX * (tile.y + uClusterTilesY * slice);
+}
+
+vec3 computeClusteredLighting()
+{
+    uvec2 range = texelFetch(uClusterGrid, getCluster()).xy;
+
+    vec3 color = vec3(0.0);
+    for (uint i = 0u; i < range.y; ++i)
+    {
+        light = fetchLight(int(texelFetch(uClusterLightIndices, int(range.x + i)).x));
+        color += computeLighting();
+    }
+    return color;
+}
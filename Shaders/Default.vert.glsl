@@ -1,4 +1,5 @@
 #include "Structs.glsl"
+#include "VertexPacking.glsl"
 
 
 layout (location = 0) in vec3 pos;
@@ -7,5 +8,5 @@ uniform Transform transform;
 
 void main()
 {
-    gl_Position = transform.proj * transform.view * transform.model * vec4(pos, 1.0);
+    gl_Position = transform.proj * transform.view * transform.model * vec4(unpackPosition(pos), 1.0);
 }
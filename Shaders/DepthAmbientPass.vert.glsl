@@ -5,6 +5,8 @@ layout (location = 3) in vec3 in_bitangent;
 layout (location = 4) in vec3 in_texcoord;
 
 #include "Structs.glsl"
+#include "CameraBlock.glsl"
+#include "VertexPacking.glsl"
 
 uniform Transform transform;
 uniform Material material;
@@ -17,20 +19,23 @@ layout (location = 4) out mat3 out_TBN;
 
 void main()
 {
-    mat4 mvp = transform.proj * transform.view * transform.model;
-    gl_Position = mvp * vec4(in_position, 1.0);
+    vec3 position = unpackPosition(in_position);
+    vec3 normal = unpackDirection(in_normal);
 
-    vec4 pos = transform.model * vec4(in_position, 1.0);
+    mat4 mvp = camera.proj * camera.view * transform.model;
+    gl_Position = mvp * vec4(position, 1.0);
+
+    vec4 pos = transform.model * vec4(position, 1.0);
     out_position = pos.xyz / pos.w;
-    out_normal = vec3(transform.worldNormal * vec4(in_normal, 0.0));
+    out_normal = vec3(transform.worldNormal * vec4(normal, 0.0));
 
     out_texcoord = in_texcoord;
 
     if (material.tex.hasNormal == 1)
     {
-        vec3 t = normalize(vec3(transform.model * vec4(in_tangent,   0.0)));
-        vec3 b = normalize(vec3(transform.model * vec4(in_bitangent, 0.0)));
-        vec3 n = normalize(vec3(transform.model * vec4(in_normal,    0.0)));
+        vec3 t = normalize(vec3(transform.model * vec4(unpackDirection(in_tangent),   0.0)));
+        vec3 b = normalize(vec3(transform.model * vec4(unpackDirection(in_bitangent), 0.0)));
+        vec3 n = normalize(vec3(transform.model * vec4(normal,                        0.0)));
 
         out_TBN = mat3(t, b, n);
     }
@@ -0,0 +1,19 @@
+// Transforms of instanced draws (see Engine::RenderQueue) : when instanced is not 0, the model
+// and normal matrices are per instance attributes instead of the transform uniforms.
+// Must be included after the declaration of the transform uniform.
+// Locations follow the vertex data attributes (Engine::Mesh::INSTANCE_ATTRIB).
+
+layout (location = 8) in mat4 in_instanceModel;
+layout (location = 12) in mat4 in_instanceNormal;
+
+uniform int instanced;
+
+mat4 getModelMatrix()
+{
+    return instanced != 0 ? in_instanceModel : transform.model;
+}
+
+mat4 getNormalMatrix()
+{
+    return instanced != 0 ? in_instanceNormal : transform.worldNormal;
+}
@@ -0,0 +1,8 @@
+// Light uniform block shared by all programs, filled once per light by the renderer.
+// Layout must match LightBlock in Engine/Renderer/RenderTechnique/UniformBlocks.hpp.
+// Requires Structs.glsl to be included first.
+
+layout (std140) uniform LightBlock
+{
+    Light light;
+};
@@ -2,9 +2,9 @@ layout (location = 0) out vec4 f_Accumulation;
 layout (location = 1) out vec4 f_Revealage;
 
 #include "Structs.glsl"
+#include "LightBlock.glsl"
 
 uniform Material material;
-uniform Light light;
 
 layout (location = 0) in vec3 in_position;
 layout (location = 1) in vec3 in_normal;
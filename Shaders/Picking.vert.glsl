@@ -1,4 +1,5 @@
 #include "Structs.glsl"
+#include "VertexPacking.glsl"
 
 layout (location = 0) in vec3 in_position;
 layout (location = 1) in vec3 in_normal;
@@ -28,11 +29,12 @@ void main()
         mvp = transform.proj * transform.view * transform.model;
     }
 
-    gl_Position = mvp * vec4(in_position, 1.0);
+    vec3 position = unpackPosition(in_position);
+    gl_Position = mvp * vec4(position, 1.0);
 
-    vec4 pos = transform.model * vec4(in_position, 1.0);
+    vec4 pos = transform.model * vec4(position, 1.0);
     pos /= pos.w;
-    vec3 normal = mat3(transform.worldNormal) * in_normal;
+    vec3 normal = mat3(transform.worldNormal) * unpackDirection(in_normal);
     vec3 eye = -transform.view[3].xyz * mat3(transform.view);
 
     out_position = vec3(pos);
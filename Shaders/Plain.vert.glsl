@@ -1,4 +1,5 @@
 #include "Structs.glsl"
+#include "VertexPacking.glsl"
 
 layout (location = 0) in vec3 in_position;
 layout (location = 4) in vec3 in_texcoord;
@@ -29,11 +30,12 @@ void main()
         mvp = transform.proj * transform.view * transform.model;
     }
 
-    gl_Position = mvp * vec4(in_position.xyz, 1.0);
+    vec3 position = unpackPosition(in_position);
+    gl_Position = mvp * vec4(position, 1.0);
     out_color = in_color.xyz;
     out_texcoord = in_texcoord;
 
-    vec4 pos = transform.model * vec4(in_position, 1.0);
+    vec4 pos = transform.model * vec4(position, 1.0);
     pos /= pos.w;
     out_position = vec3(pos);
 }
@@ -0,0 +1,30 @@
+// Decoding of the packed vertex attributes of meshes (see Core/Mesh/VertexPacking.hpp).
+// The uniforms are set by Engine::Mesh::bindVertexFormat() : when packedVertices is 0,
+// the attributes are full floats and are returned unchanged.
+
+uniform int packedVertices;
+uniform vec3 packedPositionMin;
+uniform vec3 packedPositionExtent;
+
+// Positions are normalized to [0,1] in the bounding box of the mesh.
+vec3 unpackPosition(vec3 p)
+{
+    return packedVertices != 0 ? packedPositionMin + p * packedPositionExtent : p;
+}
+
+// Normals, tangents and bitangents are octahedral coordinates in xy.
+vec3 unpackDirection(vec3 d)
+{
+    if (packedVertices == 0)
+    {
+        return d;
+    }
+
+    vec3 n = vec3(d.xy, 1.0 - abs(d.x) - abs(d.y));
+    if (n.z < 0.0)
+    {
+        vec2 s = vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+        n.xy = (1.0 - abs(n.yx)) * s;
+    }
+    return normalize(n);
+}
@@ -0,0 +1,265 @@
+#include <Core/Algorithm/LightCulling/LightClusterGrid.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace Algorithm
+        {
+            namespace
+            {
+                // Tile containing a normalized device coordinate, clamped to [0, n-1].
+                inline uint ndcToTile( Scalar ndc, uint n )
+                {
+                    const int t = int( std::floor( ( ndc + 1 ) * Scalar( 0.5 ) * Scalar( n ) ) );
+                    return uint( std::min( std::max( t, 0 ), int( n ) - 1 ) );
+                }
+            }
+
+            LightClusterGrid::LightClusterGrid( uint tilesX, uint tilesY, uint slices )
+                : m_tilesX( tilesX )
+                , m_tilesY( tilesY )
+                , m_slices( slices )
+                , m_proj( Matrix4::Identity() )
+                , m_invProj( Matrix4::Identity() )
+                , m_zNear( 1 )
+                , m_zFar( 2 )
+                , m_logDepthRatio( 1 )
+            {
+            }
+
+            void LightClusterGrid::setGridSize( uint tilesX, uint tilesY, uint slices )
+            {
+                CORE_ASSERT( tilesX > 0 && tilesY > 0 && slices > 0, "Empty cluster grid" );
+                m_tilesX = tilesX;
+                m_tilesY = tilesY;
+                m_slices = slices;
+                m_clusterAabbs.clear();
+                m_offsets.clear();
+                m_lightIndices.clear();
+            }
+
+            void LightClusterGrid::setProjection( const Matrix4& proj )
+            {
+                m_proj = proj;
+                m_invProj = proj.inverse();
+                if ( proj( 3, 3 ) == 0 )
+                {
+                    m_zNear = proj( 2, 3 ) / ( proj( 2, 2 ) - 1 );
+                    m_zFar = proj( 2, 3 ) / ( proj( 2, 2 ) + 1 );
+                }
+                else
+                {
+                    m_zNear = ( proj( 2, 3 ) + 1 ) / proj( 2, 2 );
+                    m_zFar = ( proj( 2, 3 ) - 1 ) / proj( 2, 2 );
+                }
+                CORE_ASSERT( m_zNear > 0 && m_zFar > m_zNear, "Invalid clipping planes" );
+                m_logDepthRatio = Scalar( m_slices ) / std::log( m_zFar / m_zNear );
+
+                const uint count = getClusterCount();
+                m_clusterAabbs.resize( count );
+
+                // The view space bounds of a cluster are given by the four rays through the corners
+                // of its tile, cut at the depths of its slice.
+#pragma omp parallel for
+                for ( int c = 0; c < int( count ); ++c )
+                {
+                    const uint x = uint( c ) % m_tilesX;
+                    const uint y = ( uint( c ) / m_tilesX ) % m_tilesY;
+                    const uint z = uint( c ) / ( m_tilesX * m_tilesY );
+
+                    const Scalar x0 = -1 + Scalar( 2 * x ) / Scalar( m_tilesX );
+                    const Scalar x1 = -1 + Scalar( 2 * ( x + 1 ) ) / Scalar( m_tilesX );
+                    const Scalar y0 = -1 + Scalar( 2 * y ) / Scalar( m_tilesY );
+                    const Scalar y1 = -1 + Scalar( 2 * ( y + 1 ) ) / Scalar( m_tilesY );
+                    const Scalar depths[2] = { getSliceDepth( z ), getSliceDepth( z + 1 ) };
+
+                    Aabb& aabb = m_clusterAabbs[c];
+                    aabb.setEmpty();
+                    for ( const Scalar d : depths )
+                    {
+                        aabb.extend( unproject( x0, y0, d ) );
+                        aabb.extend( unproject( x1, y0, d ) );
+                        aabb.extend( unproject( x0, y1, d ) );
+                        aabb.extend( unproject( x1, y1, d ) );
+                    }
+                }
+
+                m_offsets.assign( count + 1, 0 );
+                m_lightIndices.clear();
+            }
+
+            void LightClusterGrid::assignLights( const AlignedStdVector<LightSphere>& lights )
+            {
+                CORE_ASSERT( m_clusterAabbs.size() == getClusterCount(), "setProjection() was not called" );
+
+                const uint count = getClusterCount();
+                m_lightClusters.resize( lights.size() );
+
+#pragma omp parallel for
+                for ( int i = 0; i < int( lights.size() ); ++i )
+                {
+                    const LightSphere& light = lights[i];
+                    std::vector<uint>& clusters = m_lightClusters[i];
+                    clusters.clear();
+
+                    if ( light.m_radius < 0 )
+                    {
+                        clusters.resize( count );
+                        std::iota( clusters.begin(), clusters.end(), 0 );
+                        continue;
+                    }
+
+                    uint range[6];
+                    if ( !getLightRange( light, range ) )
+                    {
+                        continue;
+                    }
+
+                    const Scalar r2 = light.m_radius * light.m_radius;
+                    for ( uint z = range[4]; z <= range[5]; ++z )
+                    {
+                        for ( uint y = range[2]; y <= range[3]; ++y )
+                        {
+                            for ( uint x = range[0]; x <= range[1]; ++x )
+                            {
+                                const uint c = getClusterIndex( x, y, z );
+                                if ( m_clusterAabbs[c].squaredExteriorDistance( light.m_center ) <= r2 )
+                                {
+                                    clusters.push_back( c );
+                                }
+                            }
+                        }
+                    }
+                }
+
+                // Counting sort of the ( light, cluster ) pairs by cluster. Lights are visited
+                // in order, which keeps the lights of a cluster sorted.
+                m_offsets.assign( count + 1, 0 );
+                for ( const auto& clusters : m_lightClusters )
+                {
+                    for ( const uint c : clusters )
+                    {
+                        ++m_offsets[c + 1];
+                    }
+                }
+                std::partial_sum( m_offsets.begin(), m_offsets.end(), m_offsets.begin() );
+
+                m_lightIndices.resize( m_offsets.back() );
+                std::vector<uint> cursor( m_offsets.begin(), m_offsets.end() - 1 );
+                for ( uint i = 0; i < m_lightClusters.size(); ++i )
+                {
+                    for ( const uint c : m_lightClusters[i] )
+                    {
+                        m_lightIndices[cursor[c]++] = i;
+                    }
+                }
+            }
+
+            uint LightClusterGrid::getSlice( Scalar depth ) const
+            {
+                if ( depth <= m_zNear )
+                {
+                    return 0;
+                }
+                const uint s = uint( std::log( depth / m_zNear ) * m_logDepthRatio );
+                return std::min( s, m_slices - 1 );
+            }
+
+            Scalar LightClusterGrid::getSliceDepth( uint slice ) const
+            {
+                return m_zNear * std::exp( Scalar( slice ) / m_logDepthRatio );
+            }
+
+            uint LightClusterGrid::getClusterIndex( const Vector3& viewPoint ) const
+            {
+                const Vector4 h = m_proj * Vector4( viewPoint.x(), viewPoint.y(), viewPoint.z(), 1 );
+                return getClusterIndex( ndcToTile( h.x() / h.w(), m_tilesX ),
+                                        ndcToTile( h.y() / h.w(), m_tilesY ),
+                                        getSlice( -viewPoint.z() ) );
+            }
+
+            uint LightClusterGrid::getMaxLightCount() const
+            {
+                uint maxCount = 0;
+                for ( uint c = 0; c + 1 < m_offsets.size(); ++c )
+                {
+                    maxCount = std::max( maxCount, getLightCount( c ) );
+                }
+                return maxCount;
+            }
+
+            bool LightClusterGrid::getLightRange( const LightSphere& light, uint range[6] ) const
+            {
+                const Vector3& c = light.m_center;
+                const Scalar r = light.m_radius;
+
+                const Scalar dmin = -c.z() - r;
+                const Scalar dmax = -c.z() + r;
+                if ( dmax < m_zNear || dmin > m_zFar )
+                {
+                    return false;
+                }
+                range[4] = getSlice( dmin );
+                range[5] = getSlice( dmax );
+
+                // Bounding box of the sphere in normalized device coordinates. The projection of the
+                // box corners only bounds the sphere when it lies entirely in front of the camera,
+                // otherwise all tiles are kept.
+                if ( dmin > m_zNear )
+                {
+                    Scalar minX = std::numeric_limits<Scalar>::max();
+                    Scalar minY = std::numeric_limits<Scalar>::max();
+                    Scalar maxX = std::numeric_limits<Scalar>::lowest();
+                    Scalar maxY = std::numeric_limits<Scalar>::lowest();
+                    for ( uint i = 0; i < 8; ++i )
+                    {
+                        const Vector4 p( c.x() + ( i & 1 ? r : -r ),
+                                         c.y() + ( i & 2 ? r : -r ),
+                                         c.z() + ( i & 4 ? r : -r ), 1 );
+                        const Vector4 h = m_proj * p;
+                        minX = std::min( minX, h.x() / h.w() );
+                        maxX = std::max( maxX, h.x() / h.w() );
+                        minY = std::min( minY, h.y() / h.w() );
+                        maxY = std::max( maxY, h.y() / h.w() );
+                    }
+
+                    if ( maxX < -1 || minX > 1 || maxY < -1 || minY > 1 )
+                    {
+                        return false;
+                    }
+
+                    range[0] = ndcToTile( minX, m_tilesX );
+                    range[1] = ndcToTile( maxX, m_tilesX );
+                    range[2] = ndcToTile( minY, m_tilesY );
+                    range[3] = ndcToTile( maxY, m_tilesY );
+                }
+                else
+                {
+                    range[0] = 0;
+                    range[1] = m_tilesX - 1;
+                    range[2] = 0;
+                    range[3] = m_tilesY - 1;
+                }
+                return true;
+            }
+
+            Vector3 LightClusterGrid::unproject( Scalar ndcX, Scalar ndcY, Scalar depth ) const
+            {
+                const Vector4 hn = m_invProj * Vector4( ndcX, ndcY, -1, 1 );
+                const Vector4 hf = m_invProj * Vector4( ndcX, ndcY, 1, 1 );
+                const Vector3 pn = hn.head<3>() / hn.w();
+                const Vector3 pf = hf.head<3>() / hf.w();
+
+                // Point of the line ( pn, pf ) on the plane z = -depth.
+                const Scalar t = ( -depth - pn.z() ) / ( pf.z() - pn.z() );
+                return pn + t * ( pf - pn );
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef RADIUMENGINE_LIGHT_CLUSTER_GRID_HPP_
+#define RADIUMENGINE_LIGHT_CLUSTER_GRID_HPP_
+
+#include <Core/RaCore.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Containers/AlignedStdVector.hpp>
+
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace Algorithm
+        {
+            /// Bounding sphere of a light, expressed in view space (the camera looks down -Z).
+            /// A negative radius marks a light without range (e.g. a directional light),
+            /// which is assigned to every cluster.
+            struct LightSphere
+            {
+                RA_CORE_ALIGNED_NEW
+                Vector3 m_center;
+                Scalar m_radius;
+            };
+
+            /// Clustered light culling on the CPU.
+            /// The view frustum is split in tilesX x tilesY screen tiles and in depth slices
+            /// distributed exponentially between the near and far planes. Each light is assigned
+            /// to the clusters its bounding sphere overlaps, so that a fragment only has to
+            /// shade the lights of the cluster it falls in.
+            /// The assignment is stored in compressed rows : the lights of cluster c are
+            /// getLightIndices()[ getOffsets()[c] ] to getLightIndices()[ getOffsets()[c+1] - 1 ],
+            /// sorted by increasing light index.
+            /// Clusters are indexed by x + tilesX * ( y + tilesY * slice ), tile (0,0) being
+            /// the bottom-left corner of the screen, as gl_FragCoord.
+            class RA_CORE_API LightClusterGrid
+            {
+            public:
+                RA_CORE_ALIGNED_NEW
+
+                LightClusterGrid( uint tilesX = 16, uint tilesY = 9, uint slices = 24 );
+
+                /// Change the grid resolution. setProjection() must be called again.
+                void setGridSize( uint tilesX, uint tilesY, uint slices );
+
+                /// Set the projection matrix (perspective or orthographic, OpenGL conventions)
+                /// and compute the view space bounds of every cluster. The clipping plane
+                /// distances are read from the matrix.
+                void setProjection( const Matrix4& proj );
+
+                /// Assign each light to the clusters its bounding sphere overlaps.
+                /// Lights are referred to by their index in the given vector.
+                void assignLights( const AlignedStdVector<LightSphere>& lights );
+
+                inline uint getTilesX() const { return m_tilesX; }
+                inline uint getTilesY() const { return m_tilesY; }
+                inline uint getSlices() const { return m_slices; }
+                inline uint getClusterCount() const { return m_tilesX * m_tilesY * m_slices; }
+
+                inline Scalar getNear() const { return m_zNear; }
+                inline Scalar getFar() const { return m_zFar; }
+
+                /// Scale such that slice = log( depth / near ) * getSliceScale().
+                inline Scalar getSliceScale() const { return m_logDepthRatio; }
+
+                inline uint getClusterIndex( uint x, uint y, uint slice ) const
+                {
+                    return x + m_tilesX * ( y + m_tilesY * slice );
+                }
+
+                /// Return the depth slice containing the given (positive) view depth,
+                /// clamped to the grid.
+                uint getSlice( Scalar depth ) const;
+
+                /// Return the view depth of the near side of the given slice.
+                /// getSliceDepth( getSlices() ) is the far plane distance.
+                Scalar getSliceDepth( uint slice ) const;
+
+                /// Return the index of the cluster containing a view space point,
+                /// clamped to the grid. This is the lookup done by the shaders.
+                uint getClusterIndex( const Vector3& viewPoint ) const;
+
+                /// View space bounding box of a cluster.
+                inline const Aabb& getClusterAabb( uint cluster ) const { return m_clusterAabbs[cluster]; }
+
+                inline const std::vector<uint>& getOffsets() const { return m_offsets; }
+                inline const std::vector<uint>& getLightIndices() const { return m_lightIndices; }
+
+                inline uint getLightCount( uint cluster ) const
+                {
+                    return m_offsets[cluster + 1] - m_offsets[cluster];
+                }
+
+                /// Largest number of lights assigned to a single cluster.
+                uint getMaxLightCount() const;
+
+            private:
+                /// Compute the range of tiles and slices overlapped by the bounding box of a light,
+                /// as [xmin, xmax] [ymin, ymax] [zmin, zmax]. Return false if the light is
+                /// outside the frustum.
+                bool getLightRange( const LightSphere& light, uint range[6] ) const;
+
+                /// Return the view space point of the screen position ndc at the given depth.
+                Vector3 unproject( Scalar ndcX, Scalar ndcY, Scalar depth ) const;
+
+            private:
+                uint m_tilesX;
+                uint m_tilesY;
+                uint m_slices;
+
+                Matrix4 m_proj;
+                Matrix4 m_invProj;
+                Scalar m_zNear;
+                Scalar m_zFar;
+                Scalar m_logDepthRatio;
+
+                AlignedStdVector<Aabb> m_clusterAabbs;
+
+                /// Clusters overlapped by each light, filled in parallel before compression.
+                std::vector<std::vector<uint>> m_lightClusters;
+
+                std::vector<uint> m_offsets;
+                std::vector<uint> m_lightIndices;
+            };
+        }
+    }
+}
+
+#endif //RADIUMENGINE_LIGHT_CLUSTER_GRID_HPP_
@@ -1,5 +1,7 @@
 #include <Core/Animation/Handle/HandleWeightOperation.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 #include <Core/Log/Log.hpp>
 
@@ -8,33 +10,78 @@ namespace Core {
 namespace Animation {
 
 
+namespace {
+
+typedef Eigen::SparseMatrix< Scalar, Eigen::RowMajor > RowWeightMatrix;
+
+inline bool isValidWeight( Scalar w ) {
+    return std::isfinite( w ) && w > 0;
+}
+
+// Heaviest weights first, then by handle.
+inline bool isHeavier( const WeightTriplet& a, const WeightTriplet& b ) {
+    return a.value() > b.value() || ( a.value() == b.value() && a.col() < b.col() );
+}
+
+} // namespace
+
+
+
+WeightMatrix createWeightMatrix( const std::vector< WeightTriplet >& triplets,
+                                 const uint vertexCount,
+                                 const uint handleCount )
+{
+    WeightMatrix W( vertexCount, handleCount );
+    W.setFromTriplets( triplets.begin(), triplets.end(),
+                       []( const Scalar&, const Scalar& last ) { return last; } );
+    return W;
+}
+
+
+
 WeightMatrix extractWeightMatrix(const MeshWeight &weight,
-                                 const uint weight_size)
+                                 const uint weight_size,
+                                 const bool MT)
 {
-    WeightMatrix W(weight.size(), weight_size);
-    W.setZero();
-    for (uint i = 0; i < weight.size(); ++i)
+    CORE_UNUSED(MT);
+
+    const int size = int( weight.size() );
+    std::vector< uint > offset( size + 1, 0 );
+    for (int i = 0; i < size; ++i)
     {
+        offset[i + 1] = offset[i] + uint( weight[i].size() );
+    }
+
+    std::vector< WeightTriplet > triplets( offset[size] );
+    #pragma omp parallel for if(MT)
+    for (int i = 0; i < size; ++i)
+    {
+        uint t = offset[i];
         for (const auto& w : weight[i])
         {
-            W.coeffRef(i, w.first) = w.second;
+            triplets[t++] = WeightTriplet( i, int( w.first ), w.second );
         }
     }
-    return W;
+    return createWeightMatrix( triplets, size, weight_size );
 }
 
 
-MeshWeight extractMeshWeight(Eigen::Ref<const WeightMatrix> matrix)
+MeshWeight extractMeshWeight(Eigen::Ref<const WeightMatrix> matrix, const bool MT)
 {
-    MeshWeight W(matrix.rows());
-    for (int i = 0; i < matrix.rows(); ++i)
+    CORE_UNUSED(MT);
+
+    // Rows of the column major matrix are only reachable by binary searches : transpose it once.
+    const RowWeightMatrix rows( matrix );
+    MeshWeight W(rows.rows());
+    #pragma omp parallel for if(MT)
+    for (int i = 0; i < int( rows.rows() ); ++i)
     {
-        for (int j = 0; j < matrix.cols(); ++j)
+        W[i].reserve( rows.outerIndexPtr()[i + 1] - rows.outerIndexPtr()[i] );
+        for (RowWeightMatrix::InnerIterator it( rows, i ); it; ++it)
         {
-            if (matrix.coeff(i, j) != 0.0)
+            if (it.value() != 0.0)
             {
-                std::pair<uint, Scalar> w(uint(j), matrix.coeff(i, j));
-                W[i].push_back(w);
+                W[i].push_back( SingleWeight( uint( it.col() ), it.value() ) );
             }
         }
     }
@@ -52,9 +99,26 @@ WeightMatrix partitionOfUnity( Eigen::Ref<const WeightMatrix> weights ) {
 
 uint getMaxWeightIndex(Eigen::Ref<const WeightMatrix> weights,
                        const uint vertexID ) {
-    uint maxId = uint( -1 );
-    VectorN row = weights.row( vertexID );
-    row.maxCoeff(&maxId);
+    // A row major copy would read all the weights : search the row in the sorted
+    // inner indices of each column instead.
+    const int*    outer = weights.outerIndexPtr();
+    const int*    nnz   = weights.innerNonZeroPtr();
+    const int*    inner = weights.innerIndexPtr();
+    const Scalar* value = weights.valuePtr();
+    uint maxId = 0;
+    Scalar maxWeight = 0;
+    for( int j = 0; j < weights.outerSize(); ++j ) {
+        const int* begin = inner + outer[j];
+        const int* end   = nnz ? begin + nnz[j] : inner + outer[j + 1];
+        const int* it    = std::lower_bound( begin, end, int( vertexID ) );
+        if( it != end && *it == int( vertexID ) ) {
+            const Scalar w = value[it - inner];
+            if( w > maxWeight ) {
+                maxWeight = w;
+                maxId = j;
+            }
+        }
+    }
     return maxId;
 }
 
@@ -62,9 +126,16 @@ uint getMaxWeightIndex(Eigen::Ref<const WeightMatrix> weights,
 
 void getMaxWeightIndex( Eigen::Ref<const WeightMatrix> weights,
                         std::vector< uint >& handleID ) {
-    handleID.resize( weights.rows() );
-    for( int i = 0; i < weights.rows(); ++i ) {
-        handleID[i] = getMaxWeightIndex( weights, i );
+    // Columns are scanned in order, so that the first handle wins ties.
+    handleID.assign( weights.rows(), 0 );
+    std::vector< Scalar > maxWeight( weights.rows(), 0 );
+    for( int j = 0; j < weights.outerSize(); ++j ) {
+        for( Eigen::Ref<const WeightMatrix>::InnerIterator it( weights, j ); it; ++it ) {
+            if( it.value() > maxWeight[it.row()] ) {
+                maxWeight[it.row()] = it.value();
+                handleID[it.row()] = j;
+            }
+        }
     }
 }
 
@@ -87,15 +158,17 @@ bool checkNoWeightVertex( Eigen::Ref<const WeightMatrix> matrix,
                           const bool FAIL_ON_ASSERT, const bool MT ) {
     int status = 1;
     LOG( logDEBUG ) << "Searching for empty rows in the matrix...";
-    if( MT ) {
-        #pragma omp parallel for
-        for( int i = 0; i < matrix.rows(); ++i ) {
-            Sparse row = matrix.row( i );
-            const int check = ( row.nonZeros() > 0 ) ? 1 : 0;
-            #pragma omp atomic
-            status &= check;
+
+    std::vector< uint > rowSize( matrix.rows(), 0 );
+    for( int j = 0; j < matrix.outerSize(); ++j ) {
+        for( Eigen::Ref<const WeightMatrix>::InnerIterator it( matrix, j ); it; ++it ) {
+            ++rowSize[it.row()];
         }
-        if( status == 0 ) {
+    }
+
+    if( MT ) {
+        if( std::find( rowSize.begin(), rowSize.end(), 0 ) != rowSize.end() ) {
+            status = 0;
             if( FAIL_ON_ASSERT ) {
                 CORE_ASSERT( false, "At least a vertex as no weights" );
             } else {
@@ -104,8 +177,7 @@ bool checkNoWeightVertex( Eigen::Ref<const WeightMatrix> matrix,
         }
     } else {
         for( int i = 0; i < matrix.rows(); ++i ) {
-            Sparse row = matrix.row( i );
-            if( row.nonZeros() == 0 ) {
+            if( rowSize[i] == 0 ) {
                 status = 0;
 
                 const std::string text = "Vertex " + std::to_string( i ) + " has no weights.";
@@ -124,16 +196,41 @@ bool normalizeWeights(Eigen::Ref<WeightMatrix> matrix, const bool MT)
 {
     CORE_UNUSED(MT);
 
+    // Sum of each row, then scale of the rows which need it (0 if they don't).
+    std::vector< Scalar > scale( matrix.rows(), 0 );
+    for (int j = 0; j < matrix.outerSize(); ++j)
+    {
+        for (Eigen::Ref<WeightMatrix>::InnerIterator it( matrix, j ); it; ++it)
+        {
+            scale[it.row()] += it.value();
+        }
+    }
+
     bool skinningWeightOk = true;
+    for (auto& s : scale)
+    {
+        if (! Ra::Core::Math::areApproxEqual(s, Scalar(0)) && ! Ra::Core::Math::areApproxEqual(s, Scalar(1)))
+        {
+            skinningWeightOk = false;
+            s = Scalar(1) / s;
+        }
+        else
+        {
+            s = 0;
+        }
+    }
 
-    #pragma omp parallel for if(MT)
-    for (int k = 0; k < matrix.innerSize(); ++k)
+    if (! skinningWeightOk)
     {
-        const Scalar sum = matrix.row( k ).sum();
-        if(! Ra::Core::Math::areApproxEqual(sum, Scalar(0))){
-            if (! Ra::Core::Math::areApproxEqual(sum, Scalar(1))){
-                skinningWeightOk = false ;
-                matrix.row( k ) /= sum;
+        #pragma omp parallel for if(MT)
+        for (int j = 0; j < matrix.outerSize(); ++j)
+        {
+            for (Eigen::Ref<WeightMatrix>::InnerIterator it( matrix, j ); it; ++it)
+            {
+                if (scale[it.row()] != 0)
+                {
+                    it.valueRef() *= scale[it.row()];
+                }
             }
         }
     }
@@ -141,6 +238,97 @@ bool normalizeWeights(Eigen::Ref<WeightMatrix> matrix, const bool MT)
 }
 
 
+
+WeightMatrix normalizeAndPruneWeights( Eigen::Ref<const WeightMatrix> weights,
+                                       const uint maxInfluences,
+                                       WeightStatistics* stats,
+                                       const bool MT )
+{
+    CORE_UNUSED(MT);
+
+    struct VertexStatistics {
+        uint   m_weights;
+        uint   m_invalid;
+        uint   m_kept;
+        Scalar m_maxPruned;
+        bool   m_normalized;
+    };
+
+    const RowWeightMatrix rows( weights );
+    const int vertexCount = int( rows.rows() );
+    const int* outer = rows.outerIndexPtr();
+
+    // Each vertex sorts and normalizes its weights in place, in its own range of candidates.
+    std::vector< WeightTriplet > candidates( rows.nonZeros() );
+    std::vector< VertexStatistics > vertexStats( vertexCount );
+    #pragma omp parallel for if(MT)
+    for( int i = 0; i < vertexCount; ++i ) {
+        VertexStatistics& vs = vertexStats[i];
+        vs.m_invalid = 0;
+        vs.m_maxPruned = 0;
+
+        WeightTriplet* begin = candidates.data() + outer[i];
+        WeightTriplet* end = begin;
+        Scalar total = 0;
+        for( RowWeightMatrix::InnerIterator it( rows, i ); it; ++it ) {
+            if( isValidWeight( it.value() ) ) {
+                *end++ = WeightTriplet( i, int( it.col() ), it.value() );
+                total += it.value();
+            } else if( it.value() != 0 ) {
+                ++vs.m_invalid;
+            }
+        }
+        vs.m_weights = uint( end - begin );
+
+        WeightTriplet* keptEnd = end;
+        if( maxInfluences != 0 && vs.m_weights > maxInfluences ) {
+            keptEnd = begin + maxInfluences;
+            std::nth_element( begin, keptEnd, end, isHeavier );
+            for( WeightTriplet* t = keptEnd; t != end; ++t ) {
+                vs.m_maxPruned = std::max( vs.m_maxPruned, t->value() / total );
+            }
+        }
+        vs.m_kept = uint( keptEnd - begin );
+
+        Scalar sum = 0;
+        for( WeightTriplet* t = begin; t != keptEnd; ++t ) {
+            sum += t->value();
+        }
+        vs.m_normalized = vs.m_kept > 0 && ! Ra::Core::Math::areApproxEqual( sum, Scalar( 1 ) );
+        for( WeightTriplet* t = begin; t != keptEnd; ++t ) {
+            *t = WeightTriplet( t->row(), t->col(), t->value() / sum );
+        }
+    }
+
+    // Gather the statistics and the offsets of the kept weights.
+    WeightStatistics result;
+    result.m_vertexCount = vertexCount;
+    std::vector< uint > offset( vertexCount + 1, 0 );
+    for( int i = 0; i < vertexCount; ++i ) {
+        const VertexStatistics& vs = vertexStats[i];
+        offset[i + 1] = offset[i] + vs.m_kept;
+        result.m_weightCount += vs.m_weights;
+        result.m_maxInfluences = std::max( result.m_maxInfluences, vs.m_weights );
+        result.m_emptyVertexCount += ( vs.m_weights == 0 ) ? 1 : 0;
+        result.m_invalidWeightCount += vs.m_invalid;
+        result.m_prunedWeightCount += vs.m_weights - vs.m_kept;
+        result.m_maxPrunedWeight = std::max( result.m_maxPrunedWeight, vs.m_maxPruned );
+        result.m_normalizedVertexCount += vs.m_normalized ? 1 : 0;
+    }
+    if( stats != nullptr ) {
+        *stats = result;
+    }
+
+    std::vector< WeightTriplet > triplets( offset[vertexCount] );
+    #pragma omp parallel for if(MT)
+    for( int i = 0; i < vertexCount; ++i ) {
+        std::copy( candidates.begin() + outer[i], candidates.begin() + outer[i] + vertexStats[i].m_kept,
+                   triplets.begin() + offset[i] );
+    }
+    return createWeightMatrix( triplets, vertexCount, uint( weights.cols() ) );
+}
+
+
 } // namespace Animation
 } // Namespace Core
 } // Namespace Ra
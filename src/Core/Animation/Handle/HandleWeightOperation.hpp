@@ -3,22 +3,61 @@
 
 #include <Core/Animation/Handle/HandleWeight.hpp>
 
+#include <vector>
+
 namespace Ra {
 namespace Core {
 namespace Animation {
 
+/*
+* Weight of a vertex ( row ) for a handle ( col ), used to build a WeightMatrix in one go.
+*/
+typedef Eigen::Triplet< Scalar > WeightTriplet;
+
+
+
+/*
+* Statistics of the weights gathered by normalizeAndPruneWeights.
+*/
+struct WeightStatistics {
+    uint   m_vertexCount           = 0;
+    uint   m_weightCount           = 0; // Valid weights of the input.
+    uint   m_maxInfluences         = 0; // Largest number of valid weights of a vertex in the input.
+    uint   m_emptyVertexCount      = 0; // Vertices without any valid weight.
+    uint   m_invalidWeightCount    = 0; // Negative, infinite or NaN weights, which are dropped.
+    uint   m_prunedWeightCount     = 0; // Valid weights dropped to respect the influence limit.
+    Scalar m_maxPrunedWeight       = 0; // Largest dropped weight, relative to the total of its vertex.
+    uint   m_normalizedVertexCount = 0; // Vertices whose kept weights did not sum to 1.
+};
+
+
+
+/*
+* Return the WeightMatrix of vertexCount vertices and handleCount handles holding the triplets.
+* When a ( vertex, handle ) pair appears several times, the last weight is kept, as when
+* assigning the coefficients one after the other.
+*/
+WeightMatrix RA_CORE_API createWeightMatrix( const std::vector< WeightTriplet >& triplets,
+                                             const uint vertexCount,
+                                             const uint handleCount );
+
+
+
 /*
 * Return the WeightMatrix extracted from the MeshWeight vector, for a handle with handle_size transforms
 */
 WeightMatrix RA_CORE_API extractWeightMatrix( const MeshWeight& weight,
-                                              const uint handle_size );
+                                              const uint handle_size,
+                                              const bool MT = false );
 
 
 
 /*
 * Return the MeshWeight from the given WeightMatrix.
+* The weights of each vertex are sorted by handle.
 */
-MeshWeight RA_CORE_API extractMeshWeight( Eigen::Ref<const WeightMatrix> matrix );
+MeshWeight RA_CORE_API extractMeshWeight( Eigen::Ref<const WeightMatrix> matrix,
+                                          const bool MT = false );
 
 
 
@@ -34,6 +73,7 @@ WeightMatrix RA_CORE_API partitionOfUnity( Eigen::Ref<const WeightMatrix> weight
 
 /*
 * Return the index of the weight that influence the most the position of vertex at vertexId.
+* Weights are assumed non negative, and the first handle wins ties.
 */
 uint RA_CORE_API getMaxWeightIndex( Eigen::Ref<const WeightMatrix> weights,
                                     const uint vertexID );
@@ -68,6 +108,19 @@ bool RA_CORE_API normalizeWeights( Eigen::Ref<WeightMatrix> matrix,
 
 
 
+/*
+* Return the weights where each vertex keeps its maxInfluences largest weights ( all of them
+* if maxInfluences is 0 ), normalized to sum to 1. Invalid ( negative, infinite, NaN ) and
+* zero weights are dropped. If stats is not null, it receives the statistics of the weights,
+* gathered in the same pass.
+*/
+WeightMatrix RA_CORE_API normalizeAndPruneWeights( Eigen::Ref<const WeightMatrix> weights,
+                                                   const uint maxInfluences,
+                                                   WeightStatistics* stats = nullptr,
+                                                   const bool MT = false );
+
+
+
 } // namespace Animation
 } // Namespace Core
 } // Namespace Ra
@@ -1,11 +1,301 @@
 #include <Core/Animation/Skinning/RotationCenterSkinning.hpp>
 
+#include <Core/Containers/SpatialHash.hpp>
+#include <Core/String/StringUtils.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
 namespace Ra
 {
     namespace Core
     {
         namespace Animation
         {
+            namespace
+            {
+                const char CACHE_MAGIC[8] = {'R', 'A', 'C', 'O', 'R', 'C', 'A', '2'};
+
+                /// Bumped when the computation changes, so that older cache files are not used.
+                const uint64_t CACHE_VERSION = 2;
+
+                /// Seed of the second hash of the input, stored to check the cache files.
+                const uint64_t CACHE_CHECK_SEED = 0x9e3779b97f4a7c15ull;
+
+                /// Layout of the cache files : this header, then the centers of rotation.
+                struct CacheHeader
+                {
+                    char m_magic[8];
+                    uint64_t m_inputHash;
+                    uint64_t m_inputCheck;    /// Hash of the input with CACHE_CHECK_SEED.
+                    uint32_t m_vertexCount;
+                    uint32_t m_triangleCount;
+                    uint32_t m_weightCount;   /// Non zero weights.
+                    uint32_t m_boneCount;
+                    uint32_t m_scalarSize;
+                    uint32_t m_padding;
+                };
+
+                /// Header of the cache file of the given input.
+                CacheHeader makeCacheHeader(const Skinning::RefData& data, uint64_t inputHash,
+                                            Scalar sigma, Scalar weightEpsilon)
+                {
+                    CacheHeader header;
+                    std::memset(&header, 0, sizeof(header));
+                    std::memcpy(header.m_magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+                    header.m_inputHash = inputHash;
+                    header.m_inputCheck = hashCoRInput(data.m_referenceMesh, data.m_weights, sigma, weightEpsilon,
+                                                       CACHE_CHECK_SEED);
+                    header.m_vertexCount = uint32_t(data.m_referenceMesh.m_vertices.size());
+                    header.m_triangleCount = uint32_t(data.m_referenceMesh.m_triangles.size());
+                    header.m_weightCount = uint32_t(data.m_weights.nonZeros());
+                    header.m_boneCount = uint32_t(data.m_weights.cols());
+                    header.m_scalarSize = sizeof(Scalar);
+                    return header;
+                }
+
+                /// Sparse weights of a set of vertices or triangles : element i has the
+                /// weights m_weights[k] of the bones m_bones[k], k in [m_start[i], m_start[i+1]),
+                /// sorted by bone. Elements are appended one after the other.
+                struct SparseWeights
+                {
+                    std::vector<uint> m_start;
+                    std::vector<uint> m_bones;
+                    std::vector<Scalar> m_weights;
+
+                    SparseWeights() : m_start(1, 0) {}
+
+                    inline uint size() const { return uint(m_start.size()) - 1; }
+                    inline uint begin(uint i) const { return m_start[i]; }
+                    inline uint end(uint i) const { return m_start[i + 1]; }
+
+                    /// Appends the element made of the entries in [first, last).
+                    template <typename It>
+                    void append(It first, It last)
+                    {
+                        for (; first != last; ++first)
+                        {
+                            m_bones.push_back(first->first);
+                            m_weights.push_back(first->second);
+                        }
+                        m_start.push_back(uint(m_bones.size()));
+                    }
+
+                    /// Removes the last element.
+                    void removeLast()
+                    {
+                        m_start.pop_back();
+                        m_bones.resize(m_start.back());
+                        m_weights.resize(m_start.back());
+                    }
+                };
+
+                typedef std::vector<std::pair<uint, Scalar>> WeightEntries;
+
+                /// Appends the average of the given elements of in, with its entries above minWeight, to out.
+                /// in and out may be the same. scratch is reused between calls to avoid allocations.
+                void appendAverage(const SparseWeights& in, const uint* elements, uint count, Scalar minWeight,
+                                   SparseWeights& out, WeightEntries& scratch)
+                {
+                    scratch.clear();
+                    for (uint e = 0; e < count; ++e)
+                    {
+                        for (uint k = in.begin(elements[e]); k < in.end(elements[e]); ++k)
+                        {
+                            scratch.emplace_back(in.m_bones[k], in.m_weights[k]);
+                        }
+                    }
+                    std::sort(scratch.begin(), scratch.end(),
+                              [](const std::pair<uint, Scalar>& x, const std::pair<uint, Scalar>& y)
+                              { return x.first < y.first; });
+
+                    // Merge the entries of the same bone.
+                    uint n = 0;
+                    for (uint k = 0; k < scratch.size(); ++k)
+                    {
+                        if (n > 0 && scratch[n - 1].first == scratch[k].first)
+                        {
+                            scratch[n - 1].second += scratch[k].second;
+                        }
+                        else
+                        {
+                            scratch[n++] = scratch[k];
+                        }
+                    }
+                    scratch.resize(n);
+
+                    const Scalar factor = Scalar(1) / Scalar(count);
+                    auto last = scratch.begin();
+                    for (auto it = scratch.begin(); it != scratch.end(); ++it)
+                    {
+                        it->second *= factor;
+                        if (it->second > minWeight)
+                        {
+                            *last++ = *it;
+                        }
+                    }
+                    out.append(scratch.begin(), last);
+                }
+
+                /// Norm of the difference of the weights of vertices i and j.
+                Scalar weightDistance(const SparseWeights& w, uint i, uint j)
+                {
+                    Scalar result = 0;
+                    uint ki = w.begin(i);
+                    uint kj = w.begin(j);
+                    while (ki < w.end(i) || kj < w.end(j))
+                    {
+                        Scalar d;
+                        if (kj == w.end(j) || (ki < w.end(i) && w.m_bones[ki] < w.m_bones[kj]))
+                        {
+                            d = w.m_weights[ki++];
+                        }
+                        else if (ki == w.end(i) || w.m_bones[kj] < w.m_bones[ki])
+                        {
+                            d = w.m_weights[kj++];
+                        }
+                        else
+                        {
+                            d = w.m_weights[ki++] - w.m_weights[kj++];
+                        }
+                        result += d * d;
+                    }
+                    return std::sqrt(result);
+                }
+
+                /// Same as weightSimilarity(), on the positive weights of vertex i of v and triangle t of tris.
+                /// shared is reused between calls to avoid allocations.
+                Scalar sparseSimilarity(const SparseWeights& v, uint i, const SparseWeights& tris, uint t,
+                                        Scalar sigmaSq, std::vector<std::pair<Scalar, Scalar>>& shared)
+                {
+                    // Only the bones of both weights contribute.
+                    shared.clear();
+                    uint ki = v.begin(i);
+                    uint kt = tris.begin(t);
+                    while (ki < v.end(i) && kt < tris.end(t))
+                    {
+                        if (v.m_bones[ki] < tris.m_bones[kt])
+                        {
+                            ++ki;
+                        }
+                        else if (tris.m_bones[kt] < v.m_bones[ki])
+                        {
+                            ++kt;
+                        }
+                        else
+                        {
+                            shared.emplace_back(v.m_weights[ki++], tris.m_weights[kt++]);
+                        }
+                    }
+
+                    // The terms of (j, k) and (k, j) are equal.
+                    Scalar result = 0;
+                    for (uint j = 0; j < shared.size(); ++j)
+                    {
+                        for (uint k = j + 1; k < shared.size(); ++k)
+                        {
+                            const Scalar W1j = shared[j].first, W2j = shared[j].second;
+                            const Scalar W1k = shared[k].first, W2k = shared[k].second;
+                            const Scalar diff = std::exp(-Math::ipow<2>((W1j * W2k) - (W1k * W2j)) / sigmaSq);
+                            result += W1j * W1k * W2j * W2k * diff;
+                        }
+                    }
+                    return 2 * result;
+                }
+
+                /// Split the edges of the mesh until the weights of adjacent vertices are closer than
+                /// weightEpsilon. New vertices are appended to the vertices and weights, and the triangles
+                /// with split edges are replaced by the triangles of the split.
+                void subdivide(Vector3Array& vertices, VectorArray<Triangle>& triangles, SparseWeights& weights,
+                               Scalar weightEpsilon)
+                {
+                    WeightEntries scratch;
+                    Scalar maxWeightDistance;
+                    do
+                    {
+                        maxWeightDistance = 0;
+
+                        // Vertex created in the middle of each split edge, -1 for the other edges.
+                        std::unordered_map<uint64_t, int> middles;
+                        middles.reserve(triangles.size() * 2);
+                        auto middle = [&](uint v1, uint v2)
+                        {
+                            const uint64_t key = (uint64_t(std::min(v1, v2)) << 32) | std::max(v1, v2);
+                            auto it = middles.find(key);
+                            if (it != middles.end())
+                            {
+                                return it->second;
+                            }
+                            int m = -1;
+                            const Scalar weightDistance = Animation::weightDistance(weights, v1, v2);
+                            maxWeightDistance = std::max(maxWeightDistance, weightDistance);
+                            if (weightDistance > weightEpsilon)
+                            {
+                                m = int(vertices.size());
+                                vertices.push_back(Scalar(0.5) * (vertices[v1] + vertices[v2]));
+                                const uint ends[2] = {v1, v2};
+                                appendAverage(weights, ends, 2, -std::numeric_limits<Scalar>::max(), weights, scratch);
+                            }
+                            middles.emplace(key, m);
+                            return m;
+                        };
+
+                        VectorArray<Triangle> split;
+                        split.reserve(triangles.size());
+                        for (const Triangle& tri : triangles)
+                        {
+                            int v[3] = {int(tri[0]), int(tri[1]), int(tri[2])};
+                            int m[3];
+                            uint count = 0;
+                            for (uint e = 0; e < 3; ++e)
+                            {
+                                m[e] = middle(uint(v[e]), uint(v[(e + 1) % 3]));
+                                count += m[e] >= 0 ? 1 : 0;
+                            }
+
+                            // Rotate the triangle so that the split edges come first.
+                            while ((count == 1 && m[0] < 0) || (count == 2 && m[2] >= 0))
+                            {
+                                std::rotate(v, v + 1, v + 3);
+                                std::rotate(m, m + 1, m + 3);
+                            }
+
+                            switch (count)
+                            {
+                            case 0:
+                                split.push_back(tri);
+                                break;
+                            case 1:
+                                split.emplace_back(v[0], m[0], v[2]);
+                                split.emplace_back(m[0], v[1], v[2]);
+                                break;
+                            case 2:
+                                split.emplace_back(m[0], v[1], m[1]);
+                                split.emplace_back(v[0], m[0], m[1]);
+                                split.emplace_back(v[0], m[1], v[2]);
+                                break;
+                            default:
+                                split.emplace_back(v[0], m[0], m[2]);
+                                split.emplace_back(m[0], v[1], m[1]);
+                                split.emplace_back(m[2], m[1], v[2]);
+                                split.emplace_back(m[0], m[1], m[2]);
+                                break;
+                            }
+                        }
+                        triangles.swap(split);
+
+                        LOG(logDEBUG) << "Max weight distance is " << maxWeightDistance << ", "
+                                      << vertices.size() << " vertices";
+                    } while (maxWeightDistance > weightEpsilon);
+                }
+            }
+
 
             Scalar weightSimilarity(const Eigen::SparseVector<Scalar>& v1w,
                                     const Eigen::SparseVector<Scalar>& v2w, Scalar sigma)
@@ -44,141 +334,304 @@ namespace Ra
             {
                 LOG(logDEBUG) << "Precomputing CoRs";
 
-                // First step : subdivide the original mesh until weights are sufficiently close enough.
-                Scalar maxWeightDistance = 0.f;
-                TriangleMesh subdividedMesh = dataInOut.m_referenceMesh;
+                const TriangleMesh& mesh = dataInOut.m_referenceMesh;
+                const uint nVerts = mesh.m_vertices.size();
+                CORE_ASSERT(dataInOut.m_weights.rows() == int(nVerts), "Weights and vertices don't match");
 
                 // Store the weights as row major here because we are going to query the per-vertex weights.
-                Eigen::SparseMatrix<Scalar, Eigen::RowMajor> subdividedWeights = dataInOut.m_weights;
-
-                // Convert the mesh to DCEL for easy processing.
-                Dcel dcel;
-                convert(subdividedMesh, dcel);
-
-                // The mesh will be subdivided by repeated edge-split, so that adjacent vertices
-                // weights are distant of at most `weightEpsilon`.
-                // New vertices created by the edge splitting and their new weights are computed
-                // and appended to the existing vertices.
-                do
+                const Eigen::SparseMatrix<Scalar, Eigen::RowMajor> rowWeights = dataInOut.m_weights;
+                SparseWeights vertexWeights;
+                for (uint i = 0; i < nVerts; ++i)
                 {
-                    maxWeightDistance = 0;
-
-                    // Stores the edges to split
-                    std::vector<Index> edgesToSplit;
-
-                    // Compute all weights distances for all edges.
-                    for (const auto& edge : dcel.m_fulledge)
+                    WeightEntries entries;
+                    for (Eigen::SparseMatrix<Scalar, Eigen::RowMajor>::InnerIterator it(rowWeights, i); it; ++it)
                     {
-                        Vertex_ptr v1 = edge->V(0);
-                        Vertex_ptr v2 = edge->V(1);
-
-                        Scalar weightDistance = (subdividedWeights.row(v1->idx)
-                                                 - subdividedWeights.row(v2->idx)).norm();
+                        entries.emplace_back(uint(it.index()), it.value());
+                    }
+                    vertexWeights.append(entries.begin(), entries.end());
+                }
 
-                        maxWeightDistance = std::max(maxWeightDistance, weightDistance);
-                        if (weightDistance > weightEpsilon)
+                // First step : subdivide the original mesh until weights are sufficiently close enough.
+                // The original vertices are the first vertices of the subdivided mesh.
+                Vector3Array vertices = mesh.m_vertices;
+                VectorArray<Triangle> triangles = mesh.m_triangles;
+                subdivide(vertices, triangles, vertexWeights, weightEpsilon);
+
+                // Second step : precompute the area, centroid and positive average weights of the triangles.
+                // Triangles with less than two bones have a zero similarity with all the vertices.
+                const uint nBones = uint(dataInOut.m_weights.cols());
+                SparseWeights triWeights;
+                std::vector<Scalar> areas;
+                Vector3Array centroids;
+                {
+                    WeightEntries scratch;
+                    for (const Triangle& tri : triangles)
+                    {
+                        const uint corners[3] = {tri[0], tri[1], tri[2]};
+                        appendAverage(vertexWeights, corners, 3, 0, triWeights, scratch);
+                        const Vector3& p0 = vertices[tri[0]];
+                        const Vector3& p1 = vertices[tri[1]];
+                        const Vector3& p2 = vertices[tri[2]];
+                        const Scalar area = Scalar(0.5) * (p1 - p0).cross(p2 - p0).norm();
+                        const uint last = triWeights.size() - 1;
+                        if (triWeights.end(last) - triWeights.begin(last) < 2 || area == 0)
                         {
-                            edgesToSplit.push_back(edge->idx);
+                            triWeights.removeLast();
+                            continue;
                         }
+                        areas.push_back(area);
+                        centroids.push_back((p0 + p1 + p2) / Scalar(3));
                     }
+                }
+                const uint nTris = triWeights.size();
 
-                    LOG(logDEBUG) << "Max weight distance is " << maxWeightDistance;
-
-                    // We found some edges over the limit, so we split them.
-                    if (!edgesToSplit.empty())
+                // Triangles of each bone : tris[k] for k in [boneStart[b], boneStart[b+1]).
+                std::vector<uint> boneStart(nBones + 1, 0);
+                for (uint k = 0; k < triWeights.m_bones.size(); ++k)
+                {
+                    ++boneStart[triWeights.m_bones[k] + 1];
+                }
+                for (uint b = 0; b < nBones; ++b)
+                {
+                    boneStart[b + 1] += boneStart[b];
+                }
+                std::vector<uint> boneTris(triWeights.m_bones.size());
+                {
+                    std::vector<uint> next(boneStart.begin(), boneStart.end() - 1);
+                    for (uint t = 0; t < nTris; ++t)
                     {
-                        LOG(logDEBUG) << "Splitting " << edgesToSplit.size() << " edges";
-                        int startIndex = subdividedWeights.rows();
-                        int numCols = subdividedWeights.cols();
-
-                        Eigen::SparseMatrix<Scalar, Eigen::RowMajor> newWeights(startIndex + edgesToSplit.size(),
-                                                                                numCols);
-
-                        newWeights.topRows(startIndex) = subdividedWeights;
-                        subdividedWeights = newWeights;
-
-                        int i = 0;
-
-                        // Split ALL the edges !
-                        for (const auto& edge : edgesToSplit)
+                        for (uint k = triWeights.begin(t); k < triWeights.end(t); ++k)
                         {
-                            int V1Idx = dcel.m_fulledge[edge]->V(0)->idx;
-                            int V2Idx = dcel.m_fulledge[edge]->V(1)->idx;
-
-                            DcelOperations::splitEdge(dcel, edge, 0.5f);
-                            subdividedWeights.row(startIndex + i) =
-                                    0.5f * (subdividedWeights.row(V1Idx) + subdividedWeights.row(V2Idx));
-                            ++i;
+                            boneTris[next[triWeights.m_bones[k]]++] = t;
                         }
+                    }
+                }
 
+                // Cluster the vertices by their bones : the vertices of a cluster visit the same triangles.
+                // Vertices with less than two bones have a zero similarity with all the triangles.
+                SparseWeights positiveWeights;
+                std::map<std::vector<uint>, uint> clusterOf;
+                std::vector<std::vector<uint>> clusters;
+                for (uint i = 0; i < nVerts; ++i)
+                {
+                    WeightEntries entries;
+                    std::vector<uint> bones;
+                    for (uint k = vertexWeights.begin(i); k < vertexWeights.end(i); ++k)
+                    {
+                        if (vertexWeights.m_weights[k] > 0)
+                        {
+                            entries.emplace_back(vertexWeights.m_bones[k], vertexWeights.m_weights[k]);
+                            bones.push_back(vertexWeights.m_bones[k]);
+                        }
+                    }
+                    positiveWeights.append(entries.begin(), entries.end());
+                    if (bones.size() >= 2)
+                    {
+                        auto it = clusterOf.emplace(bones, uint(clusters.size())).first;
+                        if (it->second == clusters.size())
+                        {
+                            clusters.emplace_back();
+                        }
+                        clusters[it->second].push_back(i);
                     }
-                    edgesToSplit.clear();
+                }
 
-                } while (maxWeightDistance > weightEpsilon);
+                // Work items are chunks of the vertices of a cluster, so that large clusters are shared
+                // between threads. Each item finds the triangles of its cluster again.
+                const uint chunkSize = 64;
+                std::vector<std::pair<uint, uint>> items; // (cluster, first vertex in the cluster)
+                for (uint c = 0; c < clusters.size(); ++c)
+                {
+                    for (uint first = 0; first < clusters[c].size(); first += chunkSize)
+                    {
+                        items.emplace_back(c, first);
+                    }
+                }
+                LOG(logDEBUG) << nTris << " triangles, " << clusters.size() << " vertex clusters";
 
-                // get the subdivided mesh back into mesh form.
-                convert(dcel, subdividedMesh);
+                dataInOut.m_CoR.assign(nVerts, Vector3::Zero());
+                const Scalar sigmaSq = sigma * sigma;
+                #pragma omp parallel
+                {
+                    std::vector<uchar> boneCount(nTris, 0);
+                    std::vector<uint> touched;
+                    std::vector<uint> candidates;
+                    std::vector<std::pair<Scalar, Scalar>> shared;
 
-                // Second step : evaluate the integrals over all triangles for all vertices.
-                CORE_ASSERT(subdividedMesh.m_vertices.size() == subdividedWeights.rows(),
-                            "Weights and vertices don't match");
+                    #pragma omp for schedule(dynamic)
+                    for (int item = 0; item < int(items.size()); ++item)
+                    {
+                        const std::vector<uint>& cluster = clusters[items[item].first];
+                        const uint first = items[item].second;
+                        const uint last = std::min(first + chunkSize, uint(cluster.size()));
+
+                        // Triangles sharing at least two bones with the cluster.
+                        touched.clear();
+                        candidates.clear();
+                        const uint v0 = cluster[first];
+                        for (uint k = positiveWeights.begin(v0); k < positiveWeights.end(v0); ++k)
+                        {
+                            const uint b = positiveWeights.m_bones[k];
+                            for (uint j = boneStart[b]; j < boneStart[b + 1]; ++j)
+                            {
+                                const uint t = boneTris[j];
+                                if (boneCount[t] == 0)
+                                {
+                                    touched.push_back(t);
+                                }
+                                if (boneCount[t] < 2 && ++boneCount[t] == 2)
+                                {
+                                    candidates.push_back(t);
+                                }
+                            }
+                        }
+                        for (uint t : touched)
+                        {
+                            boneCount[t] = 0;
+                        }
+                        // Same summation order as visiting all the triangles.
+                        std::sort(candidates.begin(), candidates.end());
 
-                dataInOut.m_CoR.clear();
-                dataInOut.m_CoR.reserve(dataInOut.m_referenceMesh.m_vertices.size());
+                        for (uint v = first; v < last; ++v)
+                        {
+                            const uint i = cluster[v];
+                            Vector3 cor(0, 0, 0);
+                            Scalar sumweight = 0;
+                            for (uint t : candidates)
+                            {
+                                const Scalar s = sparseSimilarity(positiveWeights, i, triWeights, t, sigmaSq, shared);
+                                cor += s * areas[t] * centroids[t];
+                                sumweight += s * areas[t];
+                            }
 
+                            // Avoid division by 0
+                            if (sumweight > 0)
+                            {
+                                dataInOut.m_CoR[i] = (1.f / sumweight) * cor;
+                            }
+                        }
+                    }
+                }
+            }
 
+            bool loadOrComputeCoR(Skinning::RefData& dataInOut, const std::string& cacheDirectory,
+                                  Scalar sigma, Scalar weightEpsilon)
+            {
                 const uint nVerts = dataInOut.m_referenceMesh.m_vertices.size();
-                // naive implementation : iterate over all the triangles (of the subdivided mesh)
-                // for all vertices (of the original mesh).
-                for (uint i = 0; i < nVerts; ++i)
-                {
-
-                    // Check that the first vertices of the subdivided mesh have not changed.
-                    ON_ASSERT(const Vector3& p = dataInOut.m_referenceMesh.m_vertices[i]);
-                    CORE_ASSERT(subdividedMesh.m_vertices[i] == p, "Inconsistency in the meshes");
+                const uint64_t inputHash = cacheDirectory.empty() ? 0 :
+                        hashCoRInput(dataInOut.m_referenceMesh, dataInOut.m_weights, sigma, weightEpsilon);
+                const std::string filename = cacheDirectory.empty() ? "" : getCoRCacheFilename(cacheDirectory, inputHash);
 
-                    Vector3 cor(0, 0, 0);
-                    Scalar sumweight = 0;
-                    const Eigen::SparseVector<Scalar> Wi = subdividedWeights.row(i);
-
-                    // Sum the cor and weights over all triangles of the subdivided mesh.
-                    for (uint t = 0; t < subdividedMesh.m_triangles.size(); ++t)
+                CacheHeader expected = CacheHeader();
+                if (!filename.empty())
+                {
+                    expected = makeCacheHeader(dataInOut, inputHash, sigma, weightEpsilon);
+                    FILE* file = fopen(filename.c_str(), "rb");
+                    if (file != nullptr)
                     {
-                        const Triangle& tri = subdividedMesh.m_triangles[t];
-                        std::array<Vector3, 3> triVerts;
-                        MeshUtils::getTriangleVertices(subdividedMesh, t, triVerts);
-
-                        const Scalar area = MeshUtils::getTriangleArea(subdividedMesh, t);
-                        const Eigen::SparseVector<Scalar> triWeight = 
-                           (1/3.f)*
-                            (  subdividedWeights.row( tri[0] )
-                             + subdividedWeights.row( tri[1] )
-                             + subdividedWeights.row( tri[2] ));
-                        const Vector3 centroid = (triVerts[0] + triVerts[1] + triVerts[2]) / 3.f;
+                        CacheHeader header;
+                        Vector3Array cor(nVerts);
+                        bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+                                  std::memcmp(header.m_magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                                  header.m_inputHash == inputHash && header.m_inputCheck == expected.m_inputCheck &&
+                                  header.m_vertexCount == expected.m_vertexCount &&
+                                  header.m_triangleCount == expected.m_triangleCount &&
+                                  header.m_weightCount == expected.m_weightCount &&
+                                  header.m_boneCount == expected.m_boneCount &&
+                                  header.m_scalarSize == sizeof(Scalar);
+                        for (uint i = 0; ok && i < nVerts; ++i)
+                        {
+                            ok = fread(cor[i].data(), sizeof(Scalar), 3, file) == 3;
+                        }
+                        fclose(file);
+                        if (ok)
+                        {
+                            dataInOut.m_CoR.swap(cor);
+                            return true;
+                        }
+                        // Usually the file of another input sharing the same name, which is replaced.
+                        LOG(logDEBUG) << "CoR cache file " << filename << " is not for this mesh";
+                    }
+                }
 
-                        const Scalar s = weightSimilarity(Wi, triWeight, sigma);
+                computeCoR(dataInOut, sigma, weightEpsilon);
+                if (filename.empty())
+                {
+                    return false;
+                }
 
-                        cor += s * area * centroid;
-                        sumweight += s * area;
+                // Write a temporary file first, so that other readers never see a partial file.
+                std::string tmpFilename;
+                Core::StringUtils::stringPrintf(tmpFilename, "%s.%zx.tmp", filename.c_str(),
+                                                std::hash<std::thread::id>()(std::this_thread::get_id()));
+                FILE* file = fopen(tmpFilename.c_str(), "wb");
+                bool ok = file != nullptr;
+                if (ok)
+                {
+                    ok = fwrite(&expected, sizeof(expected), 1, file) == 1;
+                    for (uint i = 0; ok && i < nVerts; ++i)
+                    {
+                        ok = fwrite(dataInOut.m_CoR[i].data(), sizeof(Scalar), 3, file) == 3;
                     }
-
-                    // Avoid division by 0
-                    if (sumweight > 0)
+                    ok = (fclose(file) == 0) && ok;
+                    if (ok && std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
                     {
-                        dataInOut.m_CoR.push_back((1.f / sumweight) * cor);
+                        // rename does not replace files on Windows : replace the file of another input,
+                        // or give up if someone else is writing it.
+                        std::remove(filename.c_str());
+                        if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+                        {
+                            std::remove(tmpFilename.c_str());
+                        }
                     }
-                    else
+                    else if (!ok)
                     {
-                        dataInOut.m_CoR.push_back(Vector3::Zero());
+                        std::remove(tmpFilename.c_str());
                     }
+                }
+                if (!ok)
+                {
+                    LOG(logWARNING) << "Cannot write CoR cache file " << filename;
+                }
+                return false;
+            }
 
-#if defined CORE_DEBUG
-                    if (i % 100 == 0)
+            uint64_t hashCoRInput(const TriangleMesh& mesh, const Animation::WeightMatrix& weight,
+                                  Scalar sigma, Scalar weightEpsilon, uint64_t seed)
+            {
+                uint64_t h = SpatialHash::combine(SpatialHash::combine(seed, CACHE_VERSION), mesh.m_vertices.size());
+                for (const auto& v : mesh.m_vertices)
+                {
+                    for (uint k = 0; k < 3; ++k)
                     {
-                        LOG(logDEBUG) << "CoR:" << i << " / " << nVerts;
+                        h = SpatialHash::combine(h, SpatialHash::scalarBits(v[k]));
                     }
-#endif // CORE_DEBUG
                 }
+                h = SpatialHash::combine(h, mesh.m_triangles.size());
+                for (const auto& t : mesh.m_triangles)
+                {
+                    h = SpatialHash::combine(h, (uint64_t(t[0]) << 32) | t[1]);
+                    h = SpatialHash::combine(h, t[2]);
+                }
+                h = SpatialHash::combine(h, (uint64_t(weight.rows()) << 32) | uint64_t(weight.cols()));
+                for (int k = 0; k < weight.outerSize(); ++k)
+                {
+                    for (Animation::WeightMatrix::InnerIterator it(weight, k); it; ++it)
+                    {
+                        h = SpatialHash::combine(h, (uint64_t(it.row()) << 32) | uint64_t(it.col()));
+                        h = SpatialHash::combine(h, SpatialHash::scalarBits(it.value()));
+                    }
+                }
+                h = SpatialHash::combine(h, SpatialHash::scalarBits(sigma));
+                return SpatialHash::combine(h, SpatialHash::scalarBits(weightEpsilon));
+            }
+
+            std::string getCoRCacheFilename(const std::string& cacheDirectory, uint64_t inputHash)
+            {
+                std::string filename;
+                Core::StringUtils::stringPrintf(filename, "%s/cor%02u.rcor", cacheDirectory.c_str(),
+                                                uint(inputHash % CoRCacheFileCount));
+                return filename;
             }
 
             void corSkinning(const Vector3Array& input, const Animation::Pose& pose, const Animation::WeightMatrix& weight,
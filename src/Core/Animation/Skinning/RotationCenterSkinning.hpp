@@ -4,14 +4,11 @@
 #include <Core/RaCore.hpp>
 
 #include <array>
+#include <cstdint>
+#include <string>
 
-#include <Core/Index/IndexMap.hpp>
 #include <Core/Log/Log.hpp>
 #include <Core/Mesh/MeshUtils.hpp>
-#include <Core/Mesh/Wrapper/Convert.hpp>
-#include <Core/Mesh/DCEL/Dcel.hpp>
-#include <Core/Mesh/DCEL/Operations/EdgeSplit.hpp>
-#include <Core/Mesh/DCEL/FullEdge.hpp>
 
 #include <Core/Animation/Handle/HandleWeight.hpp>
 #include <Core/Animation/Pose/Pose.hpp>
@@ -33,8 +30,33 @@ namespace Ra {
                                     Scalar sigma = 0.1f);
 
             /// Compute the optimal center of rotations (1 per vertex) based on weight similarity.
+            /// The mesh is first subdivided until the weights of adjacent vertices are closer than
+            /// weightEpsilon. The area, centroid and average weights of the triangles are computed once,
+            /// and each vertex only visits the triangles sharing at least two bones with it, since the
+            /// similarity is zero for the others. Vertices are processed in parallel.
             void RA_CORE_API computeCoR(Skinning::RefData& dataInOut, Scalar sigma = 0.1f, Scalar weightEpsilon = 0.1f);
 
+            /// Maximum number of cache files of the centers of rotation in a cache directory.
+            constexpr uint CoRCacheFileCount = 64;
+
+            /// Same as computeCoR(), but the centers of rotation are read from the cache file of the mesh
+            /// and weights in cacheDirectory if it exists, and written to it otherwise.
+            /// Inputs share CoRCacheFileCount files, so a file may hold the centers of another input :
+            /// it is then replaced. Files store two independent hashes of their input and its sizes,
+            /// which are checked before reading them.
+            /// No cache is used if cacheDirectory is empty. Returns true if the cache file was read.
+            bool RA_CORE_API loadOrComputeCoR(Skinning::RefData& dataInOut, const std::string& cacheDirectory,
+                                              Scalar sigma = 0.1f, Scalar weightEpsilon = 0.1f);
+
+            /// Hash of the reference mesh, weights and parameters, which names the cache file.
+            /// Other seeds give independent hashes.
+            uint64_t RA_CORE_API hashCoRInput(const TriangleMesh& mesh, const Animation::WeightMatrix& weight,
+                                              Scalar sigma, Scalar weightEpsilon, uint64_t seed = 0);
+
+            /// Name of the cache file of the centers of rotation with the given input hash,
+            /// one of CoRCacheFileCount files.
+            std::string RA_CORE_API getCoRCacheFilename(const std::string& cacheDirectory, uint64_t inputHash);
+
             /// Skin the vertices with the optimal centers of rotation.
             void RA_CORE_API corSkinning(const Vector3Array& input, const Animation::Pose& pose,
                                          const Animation::WeightMatrix& weight, const Vector3Array& CoR, Vector3Array& output);
@@ -0,0 +1,66 @@
+#ifndef RADIUMENGINE_DRAWKEY_HPP
+#define RADIUMENGINE_DRAWKEY_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <cstdint>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// 64 bits keys used to sort draw calls, made of, from the most significant bits :
+        ///     pass (4 bits) | shader (12 bits) | material (16 bits) | depth bucket (16 bits) | mesh (16 bits)
+        /// Sorting the keys groups the draws by pass, then shader and material to minimize
+        /// state changes, and orders the draws sharing them front to back.
+        namespace DrawKey
+        {
+            /// Number of bits of each field.
+            enum Bits : uint
+            {
+                PASS_BITS = 4,
+                SHADER_BITS = 12,
+                MATERIAL_BITS = 16,
+                DEPTH_BITS = 16,
+                MESH_BITS = 16
+            };
+
+            /// Position of the lowest bit of each field.
+            enum Shift : uint
+            {
+                MESH_SHIFT = 0,
+                DEPTH_SHIFT = MESH_SHIFT + MESH_BITS,
+                MATERIAL_SHIFT = DEPTH_SHIFT + DEPTH_BITS,
+                SHADER_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS,
+                PASS_SHIFT = SHADER_SHIFT + SHADER_BITS
+            };
+
+            static_assert( PASS_SHIFT + PASS_BITS == 64, "Draw key fields must fill 64 bits" );
+
+            /// Bits of a field in a key.
+            constexpr uint64_t fieldMask( uint bits, uint shift )
+            {
+                return ( ( uint64_t( 1 ) << bits ) - 1 ) << shift;
+            }
+
+            /// Bits of the depth bucket.
+            constexpr uint64_t DEPTH_MASK = fieldMask( DEPTH_BITS, DEPTH_SHIFT );
+
+            /// Pack the fields of a key. Each field is truncated to its number of bits.
+            inline uint64_t makeKey( uint pass, uint shader, uint material, uint depth, uint mesh );
+
+            /// Value of a field of a key.
+            inline uint getField( uint64_t key, uint bits, uint shift );
+
+            /// Replace the depth bucket of a key.
+            inline uint64_t setDepth( uint64_t key, uint depth );
+
+            /// Quantize a view depth, preserving its order. Objects behind the camera get bucket 0.
+            inline uint getDepthBucket( Scalar depth );
+        }
+    }
+}
+
+#include <Core/Containers/DrawKey.inl>
+
+#endif // RADIUMENGINE_DRAWKEY_HPP
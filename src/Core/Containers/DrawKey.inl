@@ -0,0 +1,46 @@
+#include <Core/Containers/DrawKey.hpp>
+
+#include <cstring>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace DrawKey
+        {
+            inline uint64_t makeKey( uint pass, uint shader, uint material, uint depth, uint mesh )
+            {
+                return ( ( uint64_t( pass ) << PASS_SHIFT ) & fieldMask( PASS_BITS, PASS_SHIFT ) ) |
+                       ( ( uint64_t( shader ) << SHADER_SHIFT ) & fieldMask( SHADER_BITS, SHADER_SHIFT ) ) |
+                       ( ( uint64_t( material ) << MATERIAL_SHIFT ) & fieldMask( MATERIAL_BITS, MATERIAL_SHIFT ) ) |
+                       ( ( uint64_t( depth ) << DEPTH_SHIFT ) & DEPTH_MASK ) |
+                       ( ( uint64_t( mesh ) << MESH_SHIFT ) & fieldMask( MESH_BITS, MESH_SHIFT ) );
+            }
+
+            inline uint getField( uint64_t key, uint bits, uint shift )
+            {
+                return uint( ( key & fieldMask( bits, shift ) ) >> shift );
+            }
+
+            inline uint64_t setDepth( uint64_t key, uint depth )
+            {
+                return ( key & ~DEPTH_MASK ) | ( ( uint64_t( depth ) << DEPTH_SHIFT ) & DEPTH_MASK );
+            }
+
+            inline uint getDepthBucket( Scalar depth )
+            {
+                if ( !( depth > 0 ) )
+                {
+                    return 0;
+                }
+
+                // The bits of a positive float are ordered as the float itself :
+                // keeping the exponent and the high bits of the mantissa gives a logarithmic bucket.
+                const float f = float( depth );
+                uint32_t bits;
+                std::memcpy( &bits, &f, sizeof( bits ) );
+                return bits >> ( 32 - DEPTH_BITS );
+            }
+        }
+    }
+}
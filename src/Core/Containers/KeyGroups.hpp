@@ -0,0 +1,53 @@
+#ifndef RADIUMENGINE_KEYGROUPS_HPP
+#define RADIUMENGINE_KEYGROUPS_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Partition of the indices of an array of keys into groups of equal keys, stored in
+        /// compressed rows : the indices of group g are m_indices[m_offsets[g] .. m_offsets[g+1][.
+        /// Used to batch the elements which can be processed together, e.g. render objects
+        /// drawn with a single instanced draw call.
+        struct KeyGroups
+        {
+            /// Indices of the keys, group after group.
+            std::vector<uint> m_indices;
+
+            /// Start of each group in m_indices, followed by the total number of indices.
+            std::vector<uint> m_offsets;
+
+            inline uint getGroupCount() const;
+            inline uint getGroupSize( uint g ) const;
+
+            /// Group of each index, i.e. the inverse of m_indices.
+            inline void getIndexGroups( std::vector<uint>& groups ) const;
+
+            //
+            // Statistics
+            //
+
+            inline uint getMaxGroupSize() const;
+
+            /// Number of groups of at least minSize indices.
+            inline uint getGroupCount( uint minSize ) const;
+
+            /// Number of indices in the groups of at least minSize indices.
+            inline uint getGroupedIndexCount( uint minSize ) const;
+        };
+
+        /// Group the indices of the keys which are equal on the bits of mask. Groups are ordered
+        /// by increasing masked key, and the indices of a group keep their order in keys.
+        /// Key must be an unsigned integer type.
+        template <typename Key>
+        inline void groupKeys( const std::vector<Key>& keys, Key mask, KeyGroups& groups );
+    }
+}
+
+#include <Core/Containers/KeyGroups.inl>
+
+#endif // RADIUMENGINE_KEYGROUPS_HPP
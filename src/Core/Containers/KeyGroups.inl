@@ -0,0 +1,87 @@
+#include <Core/Containers/KeyGroups.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+#include <Core/Containers/RadixSort.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        inline uint KeyGroups::getGroupCount() const
+        {
+            return m_offsets.empty() ? 0 : uint( m_offsets.size() ) - 1;
+        }
+
+        inline uint KeyGroups::getGroupSize( uint g ) const
+        {
+            CORE_ASSERT( g < getGroupCount(), "Invalid group" );
+            return m_offsets[g + 1] - m_offsets[g];
+        }
+
+        inline void KeyGroups::getIndexGroups( std::vector<uint>& groups ) const
+        {
+            groups.resize( m_indices.size() );
+            for ( uint g = 0; g < getGroupCount(); ++g )
+            {
+                for ( uint k = m_offsets[g]; k < m_offsets[g + 1]; ++k )
+                {
+                    groups[m_indices[k]] = g;
+                }
+            }
+        }
+
+        inline uint KeyGroups::getMaxGroupSize() const
+        {
+            uint result = 0;
+            for ( uint g = 0; g < getGroupCount(); ++g )
+            {
+                result = std::max( result, getGroupSize( g ) );
+            }
+            return result;
+        }
+
+        inline uint KeyGroups::getGroupCount( uint minSize ) const
+        {
+            uint result = 0;
+            for ( uint g = 0; g < getGroupCount(); ++g )
+            {
+                result += getGroupSize( g ) >= minSize ? 1 : 0;
+            }
+            return result;
+        }
+
+        inline uint KeyGroups::getGroupedIndexCount( uint minSize ) const
+        {
+            uint result = 0;
+            for ( uint g = 0; g < getGroupCount(); ++g )
+            {
+                const uint size = getGroupSize( g );
+                result += size >= minSize ? size : 0;
+            }
+            return result;
+        }
+
+        template <typename Key>
+        inline void groupKeys( const std::vector<Key>& keys, Key mask, KeyGroups& groups )
+        {
+            // A stable sort of the masked keys puts the groups one after the other.
+            std::vector<Key> masked( keys.size() );
+            std::transform( keys.begin(), keys.end(), masked.begin(), [mask]( Key k ) { return Key( k & mask ); } );
+            groups.m_indices.resize( keys.size() );
+            std::iota( groups.m_indices.begin(), groups.m_indices.end(), 0 );
+            radixSort( masked, groups.m_indices );
+
+            groups.m_offsets.clear();
+            for ( uint i = 0; i < masked.size(); ++i )
+            {
+                if ( i == 0 || masked[i] != masked[i - 1] )
+                {
+                    groups.m_offsets.push_back( i );
+                }
+            }
+            groups.m_offsets.push_back( uint( masked.size() ) );
+        }
+    }
+}
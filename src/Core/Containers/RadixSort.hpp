@@ -0,0 +1,25 @@
+#ifndef RADIUMENGINE_RADIXSORT_HPP
+#define RADIUMENGINE_RADIXSORT_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Sort keys in increasing order with a least significant digit radix sort
+        /// (one pass per byte of Key), applying the same permutation to values.
+        /// The sort is stable. Passes on bytes which are the same for all keys are skipped,
+        /// which makes keys made of a few varying bit fields cheap to sort.
+        /// Large arrays are counted and scattered by blocks in parallel.
+        /// Key must be an unsigned integer type.
+        template <typename Key, typename Value>
+        inline void radixSort( std::vector<Key>& keys, std::vector<Value>& values );
+    }
+}
+
+#include <Core/Containers/RadixSort.inl>
+
+#endif // RADIUMENGINE_RADIXSORT_HPP
@@ -0,0 +1,117 @@
+#include <Core/Containers/RadixSort.hpp>
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+namespace Ra
+{
+    namespace Core
+    {
+        template <typename Key, typename Value>
+        inline void radixSort( std::vector<Key>& keys, std::vector<Value>& values )
+        {
+            static_assert( std::is_unsigned<Key>::value, "Radix sort requires unsigned integer keys" );
+            CORE_ASSERT( keys.size() == values.size(), "Keys and values size mismatch" );
+
+            constexpr uint digits = sizeof( Key );
+            const std::size_t size = keys.size();
+            if ( size < 2 )
+            {
+                return;
+            }
+
+            // Keys are split in contiguous blocks, processed in parallel. Each block scatters
+            // its keys in order, after the ones of the previous blocks, so the sort stays stable.
+            const std::size_t blockSize = std::max<std::size_t>( 1 << 16, ( size + 63 ) / 64 );
+            const int blockCount = int( ( size + blockSize - 1 ) / blockSize );
+            typedef std::array<std::size_t, 256> Histogram;
+
+            // Histograms of all digits, computed in a single pass.
+            std::vector<std::array<Histogram, digits>> blockCounts( blockCount );
+#pragma omp parallel for if ( blockCount > 1 )
+            for ( int b = 0; b < blockCount; ++b )
+            {
+                auto& counts = blockCounts[b];
+                for ( auto& c : counts )
+                {
+                    c.fill( 0 );
+                }
+                const std::size_t end = std::min( size, ( b + 1 ) * blockSize );
+                for ( std::size_t i = b * blockSize; i < end; ++i )
+                {
+                    const Key k = keys[i];
+                    for ( uint d = 0; d < digits; ++d )
+                    {
+                        ++counts[d][( k >> ( 8 * d ) ) & 0xff];
+                    }
+                }
+            }
+
+            std::vector<Key> keysTmp( size );
+            std::vector<Value> valuesTmp( size );
+            std::vector<Histogram> offsets( blockCount );
+
+            for ( uint d = 0; d < digits; ++d )
+            {
+                // All keys share this digit : the pass would not move anything.
+                const uint first = ( keys[0] >> ( 8 * d ) ) & 0xff;
+                std::size_t firstCount = 0;
+                for ( const auto& counts : blockCounts )
+                {
+                    firstCount += counts[d][first];
+                }
+                if ( firstCount == size )
+                {
+                    continue;
+                }
+
+                // Blocks are reordered by the previous passes : count their digits again.
+                if ( blockCount == 1 )
+                {
+                    offsets[0] = blockCounts[0][d];
+                }
+                else
+                {
+#pragma omp parallel for
+                    for ( int b = 0; b < blockCount; ++b )
+                    {
+                        Histogram& c = offsets[b];
+                        c.fill( 0 );
+                        const std::size_t end = std::min( size, ( b + 1 ) * blockSize );
+                        for ( std::size_t i = b * blockSize; i < end; ++i )
+                        {
+                            ++c[( keys[i] >> ( 8 * d ) ) & 0xff];
+                        }
+                    }
+                }
+
+                std::size_t offset = 0;
+                for ( uint v = 0; v < 256; ++v )
+                {
+                    for ( auto& c : offsets )
+                    {
+                        const std::size_t n = c[v];
+                        c[v] = offset;
+                        offset += n;
+                    }
+                }
+
+#pragma omp parallel for if ( blockCount > 1 )
+                for ( int b = 0; b < blockCount; ++b )
+                {
+                    Histogram& c = offsets[b];
+                    const std::size_t end = std::min( size, ( b + 1 ) * blockSize );
+                    for ( std::size_t i = b * blockSize; i < end; ++i )
+                    {
+                        const std::size_t dst = c[( keys[i] >> ( 8 * d ) ) & 0xff]++;
+                        keysTmp[dst] = keys[i];
+                        valuesTmp[dst] = std::move( values[i] );
+                    }
+                }
+                keys.swap( keysTmp );
+                values.swap( valuesTmp );
+            }
+        }
+    }
+}
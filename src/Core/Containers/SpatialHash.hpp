@@ -0,0 +1,65 @@
+#ifndef RADIUMENGINE_SPATIALHASH_HPP
+#define RADIUMENGINE_SPATIALHASH_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Hashing of vectors of scalars, used to merge equal (or close) vertices.
+        namespace SpatialHash
+        {
+            /// Bit pattern of a scalar, with +0 and -0 mapped to the same value.
+            inline uint64_t scalarBits( Scalar s );
+
+            /// Snap a scalar to the index of its cell, for cells of size 1 / invCellSize.
+            inline int64_t cellIndex( Scalar s, Scalar invCellSize );
+
+            /// Mix the bits of h (splitmix64 finalizer), so that close inputs get unrelated hashes.
+            inline uint64_t mix( uint64_t h );
+
+            /// Combine a value into a running hash.
+            inline uint64_t combine( uint64_t seed, uint64_t value );
+
+            /// Hashable key made of N scalars. With a zero tolerance the key holds
+            /// the exact bits of the scalars, otherwise the index of the cell of size
+            /// tolerance they fall in : values closer than tolerance usually share the same key,
+            /// but two values on each side of a cell boundary never do.
+            template <uint N>
+            struct Key
+            {
+                std::array<uint64_t, N> m_bits;
+
+                inline bool operator==( const Key& other ) const { return m_bits == other.m_bits; }
+                inline bool operator!=( const Key& other ) const { return m_bits != other.m_bits; }
+
+                inline uint64_t hash() const;
+            };
+
+            /// Write the N coefficients of v in key starting at offset.
+            template <uint N, typename Derived>
+            inline void setKey( Key<N>& key, uint offset, const Eigen::MatrixBase<Derived>& v, Scalar tolerance );
+
+            /// Key of a single vector.
+            template <typename Derived>
+            inline Key<Derived::SizeAtCompileTime> makeKey( const Eigen::MatrixBase<Derived>& v, Scalar tolerance );
+
+            /// Find the equal keys. For each key, representatives[i] is set to the index of the
+            /// first key equal to keys[i] (i itself for the first occurrence).
+            /// Keys are grouped by hash with a radix sort, collisions are resolved within each group,
+            /// and groups are processed in parallel. Returns the number of distinct keys.
+            template <uint N>
+            inline uint findRepresentatives( const std::vector<Key<N>>& keys, std::vector<uint>& representatives );
+        }
+    }
+}
+
+#include <Core/Containers/SpatialHash.inl>
+
+#endif // RADIUMENGINE_SPATIALHASH_HPP
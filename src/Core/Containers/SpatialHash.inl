@@ -0,0 +1,151 @@
+#include <Core/Containers/SpatialHash.hpp>
+
+#include <Core/Containers/RadixSort.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace SpatialHash
+        {
+            inline uint64_t scalarBits( Scalar s )
+            {
+                if ( s == Scalar( 0 ) )
+                {
+                    return 0;
+                }
+                typename std::conditional<sizeof( Scalar ) == 4, uint32_t, uint64_t>::type bits;
+                static_assert( sizeof( bits ) == sizeof( Scalar ), "Unsupported scalar type" );
+                std::memcpy( &bits, &s, sizeof( bits ) );
+                return uint64_t( bits );
+            }
+
+            inline int64_t cellIndex( Scalar s, Scalar invCellSize )
+            {
+                return int64_t( std::floor( s * invCellSize ) );
+            }
+
+            inline uint64_t mix( uint64_t h )
+            {
+                h ^= h >> 30;
+                h *= 0xbf58476d1ce4e5b9ull;
+                h ^= h >> 27;
+                h *= 0x94d049bb133111ebull;
+                h ^= h >> 31;
+                return h;
+            }
+
+            inline uint64_t combine( uint64_t seed, uint64_t value )
+            {
+                return mix( seed + 0x9e3779b97f4a7c15ull + value );
+            }
+
+            template <uint N>
+            inline uint64_t Key<N>::hash() const
+            {
+                uint64_t h = N;
+                for ( const uint64_t b : m_bits )
+                {
+                    h = combine( h, b );
+                }
+                return h;
+            }
+
+            template <uint N, typename Derived>
+            inline void setKey( Key<N>& key, uint offset, const Eigen::MatrixBase<Derived>& v, Scalar tolerance )
+            {
+                CORE_ASSERT( offset + v.size() <= N, "Key is too small" );
+                if ( tolerance > 0 )
+                {
+                    const Scalar invCellSize = Scalar( 1 ) / tolerance;
+                    for ( uint i = 0; i < uint( v.size() ); ++i )
+                    {
+                        key.m_bits[offset + i] = uint64_t( cellIndex( v( i ), invCellSize ) );
+                    }
+                }
+                else
+                {
+                    for ( uint i = 0; i < uint( v.size() ); ++i )
+                    {
+                        key.m_bits[offset + i] = scalarBits( v( i ) );
+                    }
+                }
+            }
+
+            template <typename Derived>
+            inline Key<Derived::SizeAtCompileTime> makeKey( const Eigen::MatrixBase<Derived>& v, Scalar tolerance )
+            {
+                static_assert( Derived::SizeAtCompileTime > 0, "Keys need a fixed size vector" );
+                Key<Derived::SizeAtCompileTime> key;
+                setKey( key, 0, v, tolerance );
+                return key;
+            }
+
+            template <uint N>
+            inline uint findRepresentatives( const std::vector<Key<N>>& keys, std::vector<uint>& representatives )
+            {
+                const int size = int( keys.size() );
+                representatives.resize( keys.size() );
+
+                // Grouping only needs the high 32 bits of the hashes, which halves the sort passes.
+                std::vector<uint32_t> hashes( keys.size() );
+                std::vector<uint> order( keys.size() );
+
+#pragma omp parallel for
+                for ( int i = 0; i < size; ++i )
+                {
+                    hashes[i] = uint32_t( keys[i].hash() >> 32 );
+                    order[i] = uint( i );
+                }
+
+                // The sort is stable : in each group of equal hashes, indices are increasing
+                // so the first key of a group is its first occurrence.
+                radixSort( hashes, order );
+
+                std::vector<uint> groups;
+                for ( int k = 0; k < size; ++k )
+                {
+                    if ( k == 0 || hashes[k] != hashes[k - 1] )
+                    {
+                        groups.push_back( uint( k ) );
+                    }
+                }
+                groups.push_back( uint( size ) );
+
+                const int groupCount = int( groups.size() ) - 1;
+                int distinct = 0;
+
+#pragma omp parallel for schedule( dynamic, 1024 ) reduction( + : distinct )
+                for ( int g = 0; g < groupCount; ++g )
+                {
+                    const uint begin = groups[g];
+                    const uint end = groups[g + 1];
+
+                    // Hash collisions are rare : compare each key with the distinct keys of its group.
+                    for ( uint k = begin; k < end; ++k )
+                    {
+                        const uint i = order[k];
+                        uint rep = i;
+                        for ( uint j = begin; j < k; ++j )
+                        {
+                            const uint other = order[j];
+                            if ( representatives[other] == other && keys[other] == keys[i] )
+                            {
+                                rep = other;
+                                break;
+                            }
+                        }
+                        representatives[i] = rep;
+                        distinct += ( rep == i ) ? 1 : 0;
+                    }
+                }
+
+                return uint( distinct );
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef RADIUMENGINE_THREADBUFFERS_HPP
+#define RADIUMENGINE_THREADBUFFERS_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// One instance of T per thread, for data produced concurrently without locks (e.g.
+        /// debug geometry appended from tasks) and merged by a single thread afterwards.
+        /// Each thread gets its buffer with local(), whose only synchronization is on the first
+        /// call of the thread. Buffers are kept until the ThreadBuffers is destroyed, so that
+        /// their memory is reused from one frame to the next.
+        template <typename T>
+        class ThreadBuffers
+        {
+        public:
+            inline ThreadBuffers();
+
+            ThreadBuffers( const ThreadBuffers& ) = delete;
+            ThreadBuffers& operator=( const ThreadBuffers& ) = delete;
+
+            /// Buffer of the calling thread, created on its first call.
+            inline T& local();
+
+            /// Number of buffers, i.e. of threads which called local().
+            inline uint getBufferCount() const;
+
+            /// Call f( T& ) on each buffer, in the order of their creation. The buffers must not
+            /// be modified by other threads meanwhile (e.g. merge them at the end of a frame,
+            /// once the tasks are done).
+            template <typename F>
+            inline void forEach( F f );
+
+        private:
+            /// Last buffer used by a thread. The id tells instances created at the same address apart.
+            struct Cache
+            {
+                const ThreadBuffers* m_owner;
+                uint64_t m_id;
+                T* m_buffer;
+            };
+
+            inline static uint64_t newId();
+
+        private:
+            const uint64_t m_id;
+
+            mutable std::mutex m_mutex;
+            std::vector<std::pair<std::thread::id, std::unique_ptr<T>>> m_buffers;
+        };
+    }
+}
+
+#include <Core/Containers/ThreadBuffers.inl>
+
+#endif // RADIUMENGINE_THREADBUFFERS_HPP
@@ -0,0 +1,70 @@
+#include <Core/Containers/ThreadBuffers.hpp>
+
+#include <atomic>
+
+namespace Ra
+{
+    namespace Core
+    {
+        template <typename T>
+        inline ThreadBuffers<T>::ThreadBuffers()
+            : m_id( newId() )
+        {
+        }
+
+        template <typename T>
+        inline uint64_t ThreadBuffers<T>::newId()
+        {
+            static std::atomic<uint64_t> s_nextId( 1 );
+            return s_nextId.fetch_add( 1, std::memory_order_relaxed );
+        }
+
+        template <typename T>
+        inline T& ThreadBuffers<T>::local()
+        {
+            static thread_local Cache t_cache = { nullptr, 0, nullptr };
+            if ( t_cache.m_owner == this && t_cache.m_id == m_id )
+            {
+                return *t_cache.m_buffer;
+            }
+
+            // The thread may use several instances alternately : look for its buffer first.
+            std::lock_guard<std::mutex> lock( m_mutex );
+            const std::thread::id thread = std::this_thread::get_id();
+            T* buffer = nullptr;
+            for ( const auto& b : m_buffers )
+            {
+                if ( b.first == thread )
+                {
+                    buffer = b.second.get();
+                    break;
+                }
+            }
+            if ( buffer == nullptr )
+            {
+                m_buffers.emplace_back( thread, std::unique_ptr<T>( new T() ) );
+                buffer = m_buffers.back().second.get();
+            }
+            t_cache = { this, m_id, buffer };
+            return *buffer;
+        }
+
+        template <typename T>
+        inline uint ThreadBuffers<T>::getBufferCount() const
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            return uint( m_buffers.size() );
+        }
+
+        template <typename T>
+        template <typename F>
+        inline void ThreadBuffers<T>::forEach( F f )
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            for ( auto& b : m_buffers )
+            {
+                f( *b.second );
+            }
+        }
+    }
+}
@@ -20,7 +20,10 @@ namespace Ra {
         m_color(),
         m_material(),
         m_hasMaterial( false ),
-        m_loadDuplicates( false ) { }
+        m_loadDuplicates( false ),
+        m_transferable( false ),
+        m_takenVertexCount( 0 ),
+        m_taken( 0 ) { }
         
         /// DESTRUCTOR
         GeometryData::~GeometryData() { }
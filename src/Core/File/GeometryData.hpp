@@ -72,6 +72,7 @@ namespace Ra {
             inline void setFrame(const Core::Transform &frame);
 
             /// DATA
+            // Number of vertices, which is kept after takeVertices().
             inline uint getVerticesSize() const;
 
             inline Vector3Array &getVertices();
@@ -142,6 +143,21 @@ namespace Ra {
             inline void setDuplicateTable(const DuplicateTable &table);
             inline void setLoadDuplicates(const bool status);
 
+            /// TRANSFER
+            // A geometry is made transferable by the system consuming it, when nothing reads its
+            // vertex attributes afterwards : its components may then move them out instead of copying them.
+            // Taken attributes are empty afterwards (has*() is false, get*() asserts until they are set
+            // again), but getVerticesSize() still gives the number of vertices.
+            inline bool isTransferable() const;
+            inline void setTransferable(const bool status);
+            inline Vector3Array takeVertices();
+            inline VectorNuArray takeFaces();
+            inline Vector3Array takeNormals();
+            inline Vector3Array takeTangents();
+            inline Vector3Array takeBiTangents();
+            inline Vector3Array takeTexCoords();
+            inline ColorArray takeColors();
+
             /// QUERY
             inline bool isPointCloud() const;
             inline bool isLineMesh() const;
@@ -190,6 +206,22 @@ namespace Ra {
             // Note: if loading duplicates this table is a 1-1 correspondance, i.e. m_duplicateTable[i] == i .
             DuplicateTable m_duplicateTable;
             bool m_loadDuplicates;
+
+            bool m_transferable;
+            uint m_takenVertexCount; // number of vertices before takeVertices()
+
+            // Attributes moved out by take*().
+            enum TakenAttrib
+            {
+                TAKEN_VERTEX    = 1 << 0,
+                TAKEN_FACE      = 1 << 1,
+                TAKEN_NORMAL    = 1 << 2,
+                TAKEN_TANGENT   = 1 << 3,
+                TAKEN_BITANGENT = 1 << 4,
+                TAKEN_TEXCOORD  = 1 << 5,
+                TAKEN_COLOR     = 1 << 6
+            };
+            uint m_taken;
         };
 
     } // namespace Asset
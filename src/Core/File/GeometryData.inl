@@ -43,22 +43,25 @@ namespace Ra {
         /// DATA
         inline uint GeometryData::getVerticesSize() const
         {
-            return m_vertex.size();
+            return ( m_taken & TAKEN_VERTEX ) ? m_takenVertexCount : m_vertex.size();
         }
 
         inline const GeometryData::Vector3Array& GeometryData::getVertices() const
         {
+            CORE_ASSERT( !( m_taken & TAKEN_VERTEX ), "Vertices were taken" );
             return m_vertex;
         }
 
         inline GeometryData::Vector3Array& GeometryData::getVertices()
         {
+            CORE_ASSERT( !( m_taken & TAKEN_VERTEX ), "Vertices were taken" );
             return m_vertex;
         }
 
         template < typename Container >
         inline void GeometryData::setVertices( const Container &vertexList )
         {
+            m_taken &= ~TAKEN_VERTEX;
             const uint size = vertexList.size();
             m_vertex.resize( size );
             #pragma omp parallel for
@@ -92,17 +95,20 @@ namespace Ra {
 
         inline const GeometryData::VectorNuArray& GeometryData::getFaces() const
         {
+            CORE_ASSERT( !( m_taken & TAKEN_FACE ), "Faces were taken" );
             return m_faces;
         }
 
         inline GeometryData::VectorNuArray& GeometryData::getFaces()
         {
+            CORE_ASSERT( !( m_taken & TAKEN_FACE ), "Faces were taken" );
             return m_faces;
         }
 
         template < typename Container >
         inline void GeometryData::setFaces( const Container& faceList )
         {
+            m_taken &= ~TAKEN_FACE;
             const uint size = faceList.size();
             m_faces.resize( size );
             #pragma omp parallel for
@@ -136,17 +142,20 @@ namespace Ra {
 
         inline GeometryData::Vector3Array& GeometryData::getNormals()
         {
+            CORE_ASSERT( !( m_taken & TAKEN_NORMAL ), "Normals were taken" );
             return m_normal;
         }
 
         inline const GeometryData::Vector3Array& GeometryData::getNormals() const
         {
+            CORE_ASSERT( !( m_taken & TAKEN_NORMAL ), "Normals were taken" );
             return m_normal;
         }
 
         template < typename Container >
         inline void GeometryData::setNormals( const Container& normalList )
         {
+            m_taken &= ~TAKEN_NORMAL;
             const uint size = normalList.size();
             m_normal.resize( size );
         #pragma omp parallel for
@@ -158,17 +167,20 @@ namespace Ra {
 
         inline GeometryData::Vector3Array& GeometryData::getTangents()
         {
+            CORE_ASSERT( !( m_taken & TAKEN_TANGENT ), "Tangents were taken" );
             return m_tangent;
         }
 
         inline const GeometryData::Vector3Array& GeometryData::getTangents() const
         {
+            CORE_ASSERT( !( m_taken & TAKEN_TANGENT ), "Tangents were taken" );
             return m_tangent;
         }
 
         template < typename Container >
         inline void GeometryData::setTangents( const Container& tangentList )
         {
+            m_taken &= ~TAKEN_TANGENT;
             const uint size = tangentList.size();
             m_tangent.resize( size );
             #pragma omp parallel for
@@ -180,17 +192,20 @@ namespace Ra {
 
         inline GeometryData::Vector3Array& GeometryData::getBiTangents()
         {
+            CORE_ASSERT( !( m_taken & TAKEN_BITANGENT ), "Bitangents were taken" );
             return m_bitangent;
         }
 
         inline const GeometryData::Vector3Array& GeometryData::getBiTangents() const
         {
+            CORE_ASSERT( !( m_taken & TAKEN_BITANGENT ), "Bitangents were taken" );
             return m_bitangent;
         }
 
         template < typename Container >
         inline void GeometryData::setBitangents( const Container& bitangentList )
         {
+            m_taken &= ~TAKEN_BITANGENT;
             const uint size = bitangentList.size();
             m_bitangent.resize( size );
             #pragma omp parallel for
@@ -202,17 +217,20 @@ namespace Ra {
 
         inline GeometryData::Vector3Array& GeometryData::getTexCoords()
         {
+            CORE_ASSERT( !( m_taken & TAKEN_TEXCOORD ), "Texture coordinates were taken" );
             return m_texCoord;
         }
 
         inline const GeometryData::Vector3Array& GeometryData::getTexCoords() const
         {
+            CORE_ASSERT( !( m_taken & TAKEN_TEXCOORD ), "Texture coordinates were taken" );
             return m_texCoord;
         }
 
         template < typename Container >
         inline void GeometryData::setTextureCoordinates( const Container& texCoordList )
         {
+            m_taken &= ~TAKEN_TEXCOORD;
             const uint size = texCoordList.size();
             m_texCoord.resize(size);
 #pragma omp parallel for
@@ -225,17 +243,20 @@ namespace Ra {
 
         inline GeometryData::ColorArray& GeometryData::getColors()
         {
+            CORE_ASSERT( !( m_taken & TAKEN_COLOR ), "Colors were taken" );
             return m_color;
         }
 
         inline const GeometryData::ColorArray& GeometryData::getColors() const
         {
+            CORE_ASSERT( !( m_taken & TAKEN_COLOR ), "Colors were taken" );
             return m_color;
         }
 
         template < typename Container >
         inline void GeometryData::setColors( const Container& colorList )
         {
+            m_taken &= ~TAKEN_COLOR;
             const uint size = colorList.size();
             m_color.resize( size );
             #pragma omp parallel for
@@ -291,6 +312,81 @@ namespace Ra {
             m_loadDuplicates = status;
         }
 
+        /// TRANSFER
+        inline bool GeometryData::isTransferable() const
+        {
+            return m_transferable;
+        }
+
+        inline void GeometryData::setTransferable( const bool status )
+        {
+            m_transferable = status;
+        }
+
+        inline GeometryData::Vector3Array GeometryData::takeVertices()
+        {
+            CORE_ASSERT( m_transferable, "Geometry data is not transferable" );
+            m_takenVertexCount = getVerticesSize();
+            m_taken |= TAKEN_VERTEX;
+            Vector3Array result;
+            result.swap( m_vertex );
+            return result;
+        }
+
+        inline GeometryData::VectorNuArray GeometryData::takeFaces()
+        {
+            CORE_ASSERT( m_transferable, "Geometry data is not transferable" );
+            m_taken |= TAKEN_FACE;
+            VectorNuArray result;
+            result.swap( m_faces );
+            return result;
+        }
+
+        inline GeometryData::Vector3Array GeometryData::takeNormals()
+        {
+            CORE_ASSERT( m_transferable, "Geometry data is not transferable" );
+            m_taken |= TAKEN_NORMAL;
+            Vector3Array result;
+            result.swap( m_normal );
+            return result;
+        }
+
+        inline GeometryData::Vector3Array GeometryData::takeTangents()
+        {
+            CORE_ASSERT( m_transferable, "Geometry data is not transferable" );
+            m_taken |= TAKEN_TANGENT;
+            Vector3Array result;
+            result.swap( m_tangent );
+            return result;
+        }
+
+        inline GeometryData::Vector3Array GeometryData::takeBiTangents()
+        {
+            CORE_ASSERT( m_transferable, "Geometry data is not transferable" );
+            m_taken |= TAKEN_BITANGENT;
+            Vector3Array result;
+            result.swap( m_bitangent );
+            return result;
+        }
+
+        inline GeometryData::Vector3Array GeometryData::takeTexCoords()
+        {
+            CORE_ASSERT( m_transferable, "Geometry data is not transferable" );
+            m_taken |= TAKEN_TEXCOORD;
+            Vector3Array result;
+            result.swap( m_texCoord );
+            return result;
+        }
+
+        inline GeometryData::ColorArray GeometryData::takeColors()
+        {
+            CORE_ASSERT( m_transferable, "Geometry data is not transferable" );
+            m_taken |= TAKEN_COLOR;
+            ColorArray result;
+            result.swap( m_color );
+            return result;
+        }
+
         /// QUERY
         inline bool GeometryData::isPointCloud() const
         {
@@ -404,7 +500,7 @@ namespace Ra {
             LOG( logINFO ) << "======== MESH INFO ========";
             LOG( logINFO ) << " Name           : " << m_name;
             LOG( logINFO ) << " Type           : " << type;
-            LOG( logINFO ) << " Vertex #       : " << m_vertex.size();
+            LOG( logINFO ) << " Vertex #       : " << getVerticesSize();
             LOG( logINFO ) << " Edge #         : " << m_edge.size();
             LOG( logINFO ) << " Face #         : " << m_faces.size();
             LOG( logINFO ) << " Normal ?       : " << ( ( m_normal.empty()    ) ? "NO" : "YES" );
@@ -413,7 +509,7 @@ namespace Ra {
             LOG( logINFO ) << " Tex.Coord. ?   : " << ( ( m_texCoord.empty()  ) ? "NO" : "YES" );
             LOG( logINFO ) << " Color ?        : " << ( ( m_color.empty()     ) ? "NO" : "YES" );
             LOG( logINFO ) << " Material ?     : " << ( ( !m_hasMaterial      ) ? "NO" : "YES" );
-            LOG( logINFO ) << " Has Dup. Vert. : " << ( ( m_duplicateTable.size() == m_vertex.size() ) ? "NO" : "YES" );
+            LOG( logINFO ) << " Has Dup. Vert. : " << ( ( m_duplicateTable.size() == getVerticesSize() ) ? "NO" : "YES" );
 
            if (m_hasMaterial)
             {
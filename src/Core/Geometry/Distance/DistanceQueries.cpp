@@ -0,0 +1,187 @@
+#include <Core/Geometry/Distance/DistanceQueries.hpp>
+
+#include <algorithm>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace DistanceQueries
+        {
+            namespace
+            {
+                const int s_blockSize = 256;
+
+                /// A block of points, one array per coordinate, so that the loops
+                /// over the points of a block are vectorized by the compiler.
+                struct BlockPoints
+                {
+                    Scalar x[s_blockSize];
+                    Scalar y[s_blockSize];
+                    Scalar z[s_blockSize];
+
+                    inline void set( int i, const Vector3& p )
+                    {
+                        x[i] = p.x();
+                        y[i] = p.y();
+                        z[i] = p.z();
+                    }
+                };
+
+                /// Returns a if mask is 1 and b if mask is 0. Unlike a conditional, both values are
+                /// always computed, which lets the compiler vectorize the loops using it.
+                inline Scalar select( Scalar mask, Scalar a, Scalar b )
+                {
+                    return mask * a + ( 1 - mask ) * b;
+                }
+
+                /// Branchless version of pointToTriSq() : the barycentric coordinates of the closest point
+                /// are those of the face, replaced by those of the zones 6 to 1 where they apply, so that
+                /// zones are prioritized in the same order as the scalar version.
+                /// Denominators are squared edge lengths and areas, which are not zero for the
+                /// non-degenerate triangles accepted by pointToTriSq().
+                void pointToTriBlock( int n, const BlockPoints& q, const BlockPoints& a, const BlockPoints& b,
+                                      const BlockPoints& c, Scalar* distanceSquared, BlockPoints& meshPoints )
+                {
+                    for ( int i = 0; i < n; ++i )
+                    {
+                        const Scalar ax = a.x[i], ay = a.y[i], az = a.z[i];
+                        const Scalar bx = b.x[i], by = b.y[i], bz = b.z[i];
+                        const Scalar cx = c.x[i], cy = c.y[i], cz = c.z[i];
+                        const Scalar abx = bx - ax, aby = by - ay, abz = bz - az;
+                        const Scalar acx = cx - ax, acy = cy - ay, acz = cz - az;
+                        const Scalar qax = q.x[i] - ax, qay = q.y[i] - ay, qaz = q.z[i] - az;
+                        const Scalar qbx = q.x[i] - bx, qby = q.y[i] - by, qbz = q.z[i] - bz;
+                        const Scalar qcx = q.x[i] - cx, qcy = q.y[i] - cy, qcz = q.z[i] - cz;
+
+                        const Scalar d1 = abx * qax + aby * qay + abz * qaz;
+                        const Scalar d2 = acx * qax + acy * qay + acz * qaz;
+                        const Scalar d3 = abx * qbx + aby * qby + abz * qbz;
+                        const Scalar d4 = acx * qbx + acy * qby + acz * qbz;
+                        const Scalar d5 = abx * qcx + aby * qcy + abz * qcz;
+                        const Scalar d6 = acx * qcx + acy * qcy + acz * qcz;
+
+                        const Scalar va = d3 * d6 - d5 * d4;
+                        const Scalar vb = d5 * d2 - d1 * d6;
+                        const Scalar vc = d1 * d4 - d3 * d2;
+
+                        // Closest point on the face.
+                        const Scalar d = 1 / ( va + vb + vc );
+                        Scalar v = vb * d;
+                        Scalar w = vc * d;
+
+                        // On BC (zone 6), AC (zone 5) and AB (zone 4).
+                        const Scalar m6 = ( va <= 0 ) & ( d4 - d3 >= 0 ) & ( d5 - d6 >= 0 );
+                        const Scalar w6 = ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) );
+                        v = select( m6, 1 - w6, v );
+                        w = select( m6, w6, w );
+
+                        const Scalar m5 = ( vb <= 0 ) & ( d2 >= 0 ) & ( d6 <= 0 );
+                        v = select( m5, 0, v );
+                        w = select( m5, d2 / ( d2 - d6 ), w );
+
+                        const Scalar m4 = ( vc <= 0 ) & ( d1 >= 0 ) & ( d3 <= 0 );
+                        v = select( m4, d1 / ( d1 - d3 ), v );
+                        w = select( m4, 0, w );
+
+                        // C (zone 3), B (zone 2) and A (zone 1).
+                        const Scalar m3 = ( d6 >= 0 ) & ( d5 <= d6 );
+                        v = select( m3, 0, v );
+                        w = select( m3, 1, w );
+
+                        const Scalar m2 = ( d3 >= 0 ) & ( d4 <= d3 );
+                        v = select( m2, 1, v );
+                        w = select( m2, 0, w );
+
+                        const Scalar m1 = ( d1 <= 0 ) & ( d2 <= 0 );
+                        v = select( m1, 0, v );
+                        w = select( m1, 0, w );
+
+                        const Scalar px = ax + v * abx + w * acx;
+                        const Scalar py = ay + v * aby + w * acy;
+                        const Scalar pz = az + v * abz + w * acz;
+                        distanceSquared[i] = ( px - q.x[i] ) * ( px - q.x[i] ) + ( py - q.y[i] ) * ( py - q.y[i] ) +
+                                             ( pz - q.z[i] ) * ( pz - q.z[i] );
+                        meshPoints.x[i] = px;
+                        meshPoints.y[i] = py;
+                        meshPoints.z[i] = pz;
+                    }
+                }
+            }
+
+            void pointsToTriSq( const Vector3Array& q, const Vector3& a, const Vector3& b, const Vector3& c,
+                                std::vector<Scalar>& distanceSquared, Vector3Array* meshPoints )
+            {
+                CORE_ASSERT( ( b - a ).cross( c - a ).squaredNorm() > 0, "Triangle ABC is degenerate" );
+                const int size = int( q.size() );
+                distanceSquared.resize( size );
+                if ( meshPoints )
+                {
+                    meshPoints->resize( size );
+                }
+
+                const int blockCount = ( size + s_blockSize - 1 ) / s_blockSize;
+                #pragma omp parallel for
+                for ( int k = 0; k < blockCount; ++k )
+                {
+                    const int begin = k * s_blockSize;
+                    const int n = std::min( s_blockSize, size - begin );
+                    BlockPoints qb, ab, bb, cb, pb;
+                    for ( int i = 0; i < n; ++i )
+                    {
+                        qb.set( i, q[begin + i] );
+                        ab.set( i, a );
+                        bb.set( i, b );
+                        cb.set( i, c );
+                    }
+                    pointToTriBlock( n, qb, ab, bb, cb, distanceSquared.data() + begin, pb );
+                    if ( meshPoints )
+                    {
+                        for ( int i = 0; i < n; ++i )
+                        {
+                            ( *meshPoints )[begin + i] = Vector3( pb.x[i], pb.y[i], pb.z[i] );
+                        }
+                    }
+                }
+            }
+
+            void pointsToTriSq( const Vector3Array& q, const TriangleMesh& mesh,
+                                const std::vector<TriangleIdx>& triangles,
+                                std::vector<Scalar>& distanceSquared, Vector3Array* meshPoints )
+            {
+                CORE_ASSERT( triangles.size() == q.size(), "One triangle is needed per point" );
+                const int size = int( q.size() );
+                distanceSquared.resize( size );
+                if ( meshPoints )
+                {
+                    meshPoints->resize( size );
+                }
+
+                const int blockCount = ( size + s_blockSize - 1 ) / s_blockSize;
+                #pragma omp parallel for
+                for ( int k = 0; k < blockCount; ++k )
+                {
+                    const int begin = k * s_blockSize;
+                    const int n = std::min( s_blockSize, size - begin );
+                    BlockPoints qb, ab, bb, cb, pb;
+                    for ( int i = 0; i < n; ++i )
+                    {
+                        const Triangle& t = mesh.m_triangles[triangles[begin + i]];
+                        qb.set( i, q[begin + i] );
+                        ab.set( i, mesh.m_vertices[t[0]] );
+                        bb.set( i, mesh.m_vertices[t[1]] );
+                        cb.set( i, mesh.m_vertices[t[2]] );
+                    }
+                    pointToTriBlock( n, qb, ab, bb, cb, distanceSquared.data() + begin, pb );
+                    if ( meshPoints )
+                    {
+                        for ( int i = 0; i < n; ++i )
+                        {
+                            ( *meshPoints )[begin + i] = Vector3( pb.x[i], pb.y[i], pb.z[i] );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -60,6 +60,25 @@ namespace Ra
             inline RA_CORE_API PointToTriangleOutput
             pointToTriSq(const Vector3& q, const Vector3& a, const Vector3& b, const Vector3& c);
 
+            //
+            // Batched point-to-triangle distance
+            //
+
+            // These functions evaluate the zones of pointToTriSq() without branches on blocks of
+            // points stored as separate x, y and z arrays, which the compiler vectorizes. Blocks are
+            // processed in parallel. They do not return the hit flags.
+
+            /// Computes the squared distances from each point of q to the triangle ABC.
+            /// If meshPoints is not null, it receives the closest point on the triangle of each point.
+            RA_CORE_API void pointsToTriSq(const Vector3Array& q, const Vector3& a, const Vector3& b, const Vector3& c,
+                                           std::vector<Scalar>& distanceSquared, Vector3Array* meshPoints = nullptr);
+
+            /// Computes the squared distance from each point q[i] to the triangle triangles[i] of the mesh.
+            /// If meshPoints is not null, it receives the closest point on the triangle of each point.
+            RA_CORE_API void pointsToTriSq(const Vector3Array& q, const TriangleMesh& mesh,
+                                           const std::vector<TriangleIdx>& triangles,
+                                           std::vector<Scalar>& distanceSquared, Vector3Array* meshPoints = nullptr);
+
             //
             // Line-to-segment distance
             //
@@ -1,27 +1,83 @@
 #include <Core/Geometry/Distance/VertexDistance.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace Ra {
 namespace Core {
 namespace Geometry {
 
 
 
+namespace {
+
+const int s_blockSize = 1024;
+
+typedef Eigen::Map< const Eigen::Array< Scalar, Eigen::Dynamic, 1 > > ConstCoordinates;
+typedef Eigen::Array< Scalar, Eigen::Dynamic, 1, 0, 3 * s_blockSize, 1 > BlockCoordinates;
+
+// Squared distances of the k-th block of vertices. Coordinates are processed as flat arrays, which Eigen vectorizes,
+// then summed by vertex.
+inline void blockDistance( const VectorArray< Vector3 >& v0,
+                           const VectorArray< Vector3 >& v1,
+                           int                           k,
+                           Scalar*                       sqrDist ) {
+    const int begin = k * s_blockSize;
+    const int n     = std::min( s_blockSize, int( v0.size() ) - begin );
+    const BlockCoordinates d = ( ConstCoordinates( v0[begin].data(), 3 * n ) -
+                                 ConstCoordinates( v1[begin].data(), 3 * n ) ).square();
+    Eigen::Map< Eigen::Array< Scalar, 1, Eigen::Dynamic > >( sqrDist, n ) =
+        Eigen::Map< const Eigen::Array< Scalar, 3, Eigen::Dynamic > >( d.data(), 3, n ).colwise().sum();
+}
+
+// Minimum, maximum and sum of the squared distances, computed by blocks in parallel.
+// The distances are written in sqrDist if it is not null.
+void distanceStatistics( const VectorArray< Vector3 >& v0,
+                         const VectorArray< Vector3 >& v1,
+                         Scalar*                       sqrDist,
+                         Scalar&                       sqrMin,
+                         Scalar&                       sqrMax,
+                         Scalar&                       sqrSum ) {
+    CORE_ASSERT( v0.size() == v1.size(), "Vertex arrays must have the same size" );
+    const int blockCount = ( int( v0.size() ) + s_blockSize - 1 ) / s_blockSize;
+    std::vector< Scalar > blockMin( blockCount );
+    std::vector< Scalar > blockMax( blockCount );
+    std::vector< Scalar > blockSum( blockCount );
+    #pragma omp parallel for
+    for( int k = 0; k < blockCount; ++k ) {
+        Scalar buffer[s_blockSize];
+        Scalar* d = sqrDist ? sqrDist + k * s_blockSize : buffer;
+        blockDistance( v0, v1, k, d );
+        const int n = std::min( s_blockSize, int( v0.size() ) - k * s_blockSize );
+        const Eigen::Map< const Eigen::Array< Scalar, Eigen::Dynamic, 1 > > dist( d, n );
+        blockMin[k] = dist.minCoeff();
+        blockMax[k] = dist.maxCoeff();
+        blockSum[k] = dist.sum();
+    }
+
+    sqrMin = std::numeric_limits< Scalar >::max();
+    sqrMax = 0.0;
+    sqrSum = 0.0;
+    for( int k = 0; k < blockCount; ++k ) {
+        sqrMin = std::min( sqrMin, blockMin[k] );
+        sqrMax = std::max( sqrMax, blockMax[k] );
+        sqrSum += blockSum[k];
+    }
+}
+
+} // namespace
+
+
+
 void vertexDistance( const VectorArray< Vector3 >& v0,
                      const VectorArray< Vector3 >& v1,
                      std::vector< Scalar >&        sqrDist,
                      Scalar&                       sqrMin,
                      Scalar&                       sqrMax,
                      Scalar&                       sqrAvg ) {
-    const uint n = v0.size();
-    sqrMin = std::numeric_limits< Scalar >::max();
-    sqrMax = 0.0;
-    sqrAvg = 0.0;
-    sqrDist.resize( n );
-    for( uint i = 0; i < n; ++i ) {
-        sqrDist[i] = ( v0[i] - v1[i] ).squaredNorm();
-        sqrMax = ( sqrDist[i] > sqrMax ) ? sqrDist[i] : sqrMax;
-        sqrMin = ( sqrDist[i] < sqrMin ) ? sqrDist[i] : sqrMin;
-    }
+    Scalar sqrSum;
+    sqrDist.resize( v0.size() );
+    distanceStatistics( v0, v1, sqrDist.data(), sqrMin, sqrMax, sqrSum );
     sqrAvg = ( sqrMax + sqrMin ) * 0.5;
 }
 
@@ -32,14 +88,8 @@ void vertexDistance(const VectorArray< Vector3 >& v0,
                     Scalar&                       sqrMin,
                     Scalar&                       sqrMax,
                     Scalar&                       sqrAvg ) {
-    const uint n = v0.size();
-    sqrMax = 0.0;
-    sqrMin = std::numeric_limits< Scalar >::max();
-    for( uint i = 0; i < n; ++i ) {
-        Scalar sqrDist = ( v0[i] - v1[i] ).squaredNorm();
-        sqrMax = ( sqrDist > sqrMax ) ? sqrDist : sqrMax;
-        sqrMin = ( sqrDist < sqrMin ) ? sqrDist : sqrMin;
-    }
+    Scalar sqrSum;
+    distanceStatistics( v0, v1, nullptr, sqrMin, sqrMax, sqrSum );
     sqrAvg = ( sqrMax + sqrMin ) * 0.5;
 }
 
@@ -47,12 +97,9 @@ void vertexDistance(const VectorArray< Vector3 >& v0,
 
 Scalar vertexDistance( const VectorArray< Vector3 >& v0,
                        const VectorArray< Vector3 >& v1 ) {
-    const uint n = v0.size();
-    Scalar sqrAvg = 0.0;
-    for( uint i = 0; i < n; ++i ) {
-        sqrAvg += ( v0[i] - v1[i] ).squaredNorm();
-    }
-    return ( sqrAvg / ( Scalar )n );
+    Scalar sqrMin, sqrMax, sqrSum;
+    distanceStatistics( v0, v1, nullptr, sqrMin, sqrMax, sqrSum );
+    return ( sqrSum / ( Scalar )v0.size() );
 }
 
 
@@ -88,6 +88,14 @@ Vector3 localUniformNormal( const uint i, const VectorArray< Vector3 >& p, const
     return normal;//.normalized();
 }
 
+Vector3 localUniformNormal( const uint i, const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, const MeshIncidence& incidence ) {
+    Vector3 normal = Vector3::Zero();
+    for( const uint t : incidence.getVertexTriangles( i ) ) {
+        normal += triangleNormal( p[T[t]( 0 )], p[T[t]( 1 )], p[T[t]( 2 )] );
+    }
+    return normal;
+}
+
 
 
 void angleWeightedNormal( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, VectorArray< Vector3 >& normal ) {
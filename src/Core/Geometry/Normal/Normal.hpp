@@ -4,6 +4,7 @@
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Containers/VectorArray.hpp>
 #include <Core/Mesh/MeshTypes.hpp>
+#include <Core/Mesh/MeshIncidence.hpp>
 #include <Core/Geometry/Adjacency/Adjacency.hpp>
 
 namespace Ra {
@@ -43,6 +44,12 @@ void RA_CORE_API uniformNormal(const VectorArray< Vector3 >& p, const VectorArra
 */
 Vector3 RA_CORE_API localUniformNormal( const uint i, const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, const TVAdj& adj );
 
+/*
+* Same as above, with the triangles of the one-ring given by the incidence of the mesh
+* (see TriangleMesh::getIncidence()) instead of a sparse matrix.
+*/
+Vector3 RA_CORE_API localUniformNormal( const uint i, const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, const MeshIncidence& incidence );
+
 
 
 /*
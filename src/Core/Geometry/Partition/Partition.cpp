@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 
 
 namespace Ra {
@@ -13,17 +14,19 @@ namespace Geometry {
 VertexSegment extractVertexSegment( const Animation::MeshWeight& weights, const Index& id, const bool use_max ) {
     VertexSegment v;
     for( uint i = 0; i < weights.size(); ++i ) {
-        Scalar max = std::numeric_limits< Scalar >::min();
-        uint j( -1 );
+        Scalar max = std::numeric_limits< Scalar >::lowest();
+        Scalar w_id = 0.0;
+        bool found = false;
         for( const auto& w : weights[i] ) {
             if( max < w.second ) {
                 max = w.second;
             }
             if( w.first == id ) {
-                j = id;
+                w_id = w.second;
+                found = true;
             }
         }
-        if( ( j != uint( -1 ) ) && ( ( weights[i][j].second == max ) || !use_max ) ) {
+        if( found && ( ( w_id == max ) || !use_max ) ) {
             v.push_back( i );
         }
     }
@@ -33,12 +36,22 @@ VertexSegment extractVertexSegment( const Animation::MeshWeight& weights, const
 
 
 VertexSegment extractVertexSegment( const Animation::WeightMatrix& weights, const Index& id, const bool use_max ) {
+    // Largest weight of each vertex, as in partition() : the weights are stored by handle,
+    // so this needs a traversal of all the weights.
+    std::vector< Scalar > maxWeight;
+    if( use_max ) {
+        maxWeight.assign( weights.rows(), 0.0 );
+        for( int k = 0; k < weights.outerSize(); ++k ) {
+            for( Animation::WeightMatrix::InnerIterator it( weights, k ); it; ++it ) {
+                maxWeight[it.row()] = std::max( maxWeight[it.row()], it.value() );
+            }
+        }
+    }
+
     VertexSegment v;
-    const VectorN col = weights.col( id );
-    const Scalar  max = col.maxCoeff();
-    for( int i = 0; i < col.size(); ++i ) {
-        if( ( col.coeff( i ) != 0.0 ) && ( ( col.coeff( i ) == max ) || !use_max ) ) {
-            v.push_back( i );
+    for( Animation::WeightMatrix::InnerIterator it( weights, id ); it; ++it ) {
+        if( ( it.value() != 0.0 ) && ( !use_max || ( it.value() == maxWeight[it.row()] ) ) ) {
+            v.push_back( it.row() );
         }
     }
     return v;
@@ -72,24 +85,112 @@ TriangleSegment extractTriangleSegment( const BitSet& bit, const VectorArray< Tr
 MeshPartition partition( const TriangleMesh& mesh, const Animation::WeightMatrix& weight, const bool use_max ) {
     const uint size   = weight.cols();
     const uint v_size = mesh.m_vertices.size();
-    MeshPartition part( size );
-    #pragma omp parallel for
-    for( uint n = 0; n < size; ++n ) {
-        const VertexSegment   v = extractVertexSegment( weight, n, use_max );
-        const BitSet          b = extractBitSet( v, v_size );
-        const TriangleSegment t = extractTriangleSegment( b, mesh.m_triangles );
-        part[n].m_vertices.resize( v.size() );
-        part[n].m_normals.resize( v.size() );
-        part[n].m_triangles.resize( t.size() );
-        std::map< uint, uint > id;
-        for( uint i = 0; i < v.size(); ++i ) {
-            id[v[i]] = i;
-            part[n].m_vertices[i] = mesh.m_vertices[v[i]];
-            part[n].m_normals[i]  = mesh.m_normals[v[i]];
+    const uint t_size = mesh.m_triangles.size();
+    CORE_ASSERT( uint( weight.rows() ) == v_size, "Weights do not match the mesh" );
+
+    // Largest weight of each vertex.
+    std::vector< Scalar > maxWeight( v_size, 0.0 );
+    if( use_max ) {
+        for( int k = 0; k < weight.outerSize(); ++k ) {
+            for( Animation::WeightMatrix::InnerIterator it( weight, k ); it; ++it ) {
+                maxWeight[it.row()] = std::max( maxWeight[it.row()], it.value() );
+            }
+        }
+    }
+
+    // Segments, bucketed by handle : vertices of handle n are in [v_start[n], v_start[n+1]).
+    // Each vertex also stores its handles : handles of vertex i are in [h_start[i], h_start[i+1]).
+    std::vector< uint > v_start( size + 1, 0 );
+    std::vector< uint > h_start( v_size + 1, 0 );
+    for( int k = 0; k < weight.outerSize(); ++k ) {
+        for( Animation::WeightMatrix::InnerIterator it( weight, k ); it; ++it ) {
+            if( ( it.value() != 0.0 ) && ( !use_max || ( it.value() == maxWeight[it.row()] ) ) ) {
+                ++v_start[it.col() + 1];
+                ++h_start[it.row() + 1];
+            }
+        }
+    }
+    std::partial_sum( v_start.begin(), v_start.end(), v_start.begin() );
+    std::partial_sum( h_start.begin(), h_start.end(), h_start.begin() );
+
+    VertexSegment      vertex( v_start[size] );
+    std::vector< uint > handle( h_start[v_size] );
+    {
+        std::vector< uint > v_next( v_start.begin(), v_start.end() - 1 );
+        std::vector< uint > h_next( h_start.begin(), h_start.end() - 1 );
+        for( int k = 0; k < weight.outerSize(); ++k ) {
+            for( Animation::WeightMatrix::InnerIterator it( weight, k ); it; ++it ) {
+                if( ( it.value() != 0.0 ) && ( !use_max || ( it.value() == maxWeight[it.row()] ) ) ) {
+                    vertex[v_next[it.col()]++] = it.row();
+                    handle[h_next[it.row()]++] = it.col();
+                }
+            }
         }
-        for( uint i = 0; i < t.size(); ++i ) {
-            const Triangle& T = mesh.m_triangles[t[i]];
-            part[n].m_triangles[i] = Triangle( id[T[0]], id[T[1]], id[T[2]] );
+    }
+
+    // Triangles, bucketed by handle in the same way, each triangle once per handle of its vertices.
+    auto forEachHandle = [&]( const Triangle& T, auto f ) {
+        for( uint j = 0; j < 3; ++j ) {
+            for( uint h = h_start[T[j]]; h < h_start[T[j] + 1]; ++h ) {
+                const uint n = handle[h];
+                bool first = true;
+                for( uint l = 0; l < j; ++l ) {
+                    first = first && !std::binary_search( handle.begin() + h_start[T[l]], handle.begin() + h_start[T[l] + 1], n );
+                }
+                if( first ) {
+                    f( n );
+                }
+            }
+        }
+    };
+    std::vector< uint > t_start( size + 1, 0 );
+    for( uint i = 0; i < t_size; ++i ) {
+        forEachHandle( mesh.m_triangles[i], [&]( uint n ) { ++t_start[n + 1]; } );
+    }
+    std::partial_sum( t_start.begin(), t_start.end(), t_start.begin() );
+    TriangleSegment triangle( t_start[size] );
+    {
+        std::vector< uint > t_next( t_start.begin(), t_start.end() - 1 );
+        for( uint i = 0; i < t_size; ++i ) {
+            forEachHandle( mesh.m_triangles[i], [&]( uint n ) { triangle[t_next[n]++] = i; } );
+        }
+    }
+
+    // Build the meshes, remapping the vertices with a dense array per thread.
+    const bool hasNormals = ( mesh.m_normals.size() == v_size );
+    MeshPartition part( size );
+    #pragma omp parallel
+    {
+        std::vector< int > id( v_size, -1 );
+        #pragma omp for schedule( dynamic )
+        for( int n = 0; n < int( size ); ++n ) {
+            TriangleMesh& m = part[n];
+            VertexSegment v( vertex.begin() + v_start[n], vertex.begin() + v_start[n + 1] );
+            for( uint i = 0; i < v.size(); ++i ) {
+                id[v[i]] = i;
+            }
+            m.m_triangles.resize( t_start[n + 1] - t_start[n] );
+            for( uint i = t_start[n]; i < t_start[n + 1]; ++i ) {
+                const Triangle& T = mesh.m_triangles[triangle[i]];
+                for( uint j = 0; j < 3; ++j ) {
+                    if( id[T[j]] < 0 ) {
+                        // Vertex of the boundary, in the segment of another handle.
+                        id[T[j]] = v.size();
+                        v.push_back( T[j] );
+                    }
+                }
+                m.m_triangles[i - t_start[n]] = Triangle( id[T[0]], id[T[1]], id[T[2]] );
+            }
+
+            m.m_vertices.resize( v.size() );
+            m.m_normals.resize( v.size() );
+            for( uint i = 0; i < v.size(); ++i ) {
+                m.m_vertices[i] = mesh.m_vertices[v[i]];
+                if( hasNormals ) {
+                    m.m_normals[i] = mesh.m_normals[v[i]];
+                }
+                id[v[i]] = -1;
+            }
         }
     }
     return part;
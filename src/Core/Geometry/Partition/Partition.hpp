@@ -41,7 +41,8 @@ VertexSegment extractVertexSegment( const Animation::MeshWeight& weights, const
 
 /*
 * Return the VertexSegment from the given set of weight, for the given id.
-* If is_max is true, only the vertices where id is the most influent one will be returned.
+* If is_max is true, only the vertices where id is the most influent one will be returned,
+* which reads all the weights : use partition() to get the segments of all the handles.
 */
 VertexSegment extractVertexSegment( const Animation::WeightMatrix& weights, const Index& id, const bool use_max = true );
 
@@ -61,6 +62,15 @@ TriangleSegment extractTriangleSegment( const BitSet& bit, const VectorArray< Tr
 
 
 
+/*
+* Return the partition of the mesh into one mesh per handle of the weight matrix.
+* The segment of a handle holds the vertices it influences. If use_max is true, only the vertices where
+* it is the most influent handle are part of its segment (all of them in case of tie).
+* A triangle is part of the mesh of a handle if one of its vertices is in its segment, and its other vertices
+* are then added to this mesh, so that neighbouring meshes share their boundary.
+* Vertices and triangles are bucketed by handle in one traversal of the weights and of the triangles,
+* then the meshes are built in parallel.
+*/
 MeshPartition partition( const TriangleMesh& mesh, const Animation::WeightMatrix& weight, const bool use_max = true );
 
 
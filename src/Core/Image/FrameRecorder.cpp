@@ -0,0 +1,344 @@
+#include <Core/Image/FrameRecorder.hpp>
+
+#include <Core/Image/stb_image_write.h>
+#include <Core/Log/Log.hpp>
+#include <Core/String/StringUtils.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            const char RAW_MAGIC[8] = { 'R', 'A', 'F', 'R', 'A', 'M', 'E', 'S' };
+
+            bool seek( FILE* file, uint64_t offset )
+            {
+#if defined( OS_WINDOWS )
+                return _fseeki64( file, int64_t( offset ), SEEK_SET ) == 0;
+#else
+                return fseeko( file, off_t( offset ), SEEK_SET ) == 0;
+#endif
+            }
+
+            // OpenGL images start with the bottom row.
+            void flipRows( uint8_t* pixels, uint width, uint height )
+            {
+                const size_t rowSize = size_t( width ) * 4;
+                std::vector<uint8_t> row( rowSize );
+                for ( uint j = 0; j < height / 2; ++j )
+                {
+                    uint8_t* top = pixels + j * rowSize;
+                    uint8_t* bottom = pixels + ( height - 1 - j ) * rowSize;
+                    std::memcpy( row.data(), top, rowSize );
+                    std::memcpy( top, bottom, rowSize );
+                    std::memcpy( bottom, row.data(), rowSize );
+                }
+            }
+        }
+
+        FrameRecorder::FrameRecorder()
+            : m_encoding( 0 )
+            , m_stopping( false )
+            , m_hasFirstIndex( false )
+            , m_firstIndex( 0 )
+            , m_rawFile( nullptr )
+            , m_rawWidth( 0 )
+            , m_rawHeight( 0 )
+            , m_rawFrameCount( 0 )
+        {
+        }
+
+        FrameRecorder::~FrameRecorder()
+        {
+            stop();
+        }
+
+        bool FrameRecorder::start( const Parameters& params )
+        {
+            CORE_ASSERT( !isRunning(), "Recorder already started." );
+
+            m_params = params;
+            m_params.m_workerCount = std::max( m_params.m_workerCount, 1u );
+            m_params.m_queueSize = std::max( m_params.m_queueSize, 1u );
+
+            if ( m_params.m_format == RAW )
+            {
+                // Do not truncate the file of a previous recording.
+                FILE* existing = fopen( m_params.m_path.c_str(), "rb" );
+                if ( existing != nullptr )
+                {
+                    fclose( existing );
+                    LOG( logERROR ) << "Raw frame file " << m_params.m_path << " already exists.";
+                    return false;
+                }
+                m_rawFile = fopen( m_params.m_path.c_str(), "wb" );
+                if ( m_rawFile == nullptr )
+                {
+                    LOG( logERROR ) << "Cannot create raw frame file " << m_params.m_path;
+                    return false;
+                }
+                m_rawWidth = 0;
+                m_rawHeight = 0;
+                m_rawFrameCount = 0;
+            }
+
+            // One buffer per queued frame and per frame being encoded.
+            m_frames.clear();
+            m_frames.resize( m_params.m_queueSize + m_params.m_workerCount );
+            m_freeFrames.clear();
+            for ( auto& f : m_frames )
+            {
+                m_freeFrames.push_back( &f );
+            }
+            m_queue.clear();
+            m_encoding = 0;
+            m_stopping = false;
+            m_hasFirstIndex = false;
+            m_firstIndex = 0;
+            m_stats = Statistics();
+            m_startTime = Timer::Clock::now();
+
+            for ( uint i = 0; i < m_params.m_workerCount; ++i )
+            {
+                m_workers.emplace_back( &FrameRecorder::workerLoop, this );
+            }
+            return true;
+        }
+
+        void FrameRecorder::stop()
+        {
+            if ( !isRunning() )
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_stopping = true;
+            }
+            m_frameQueued.notify_all();
+            for ( auto& w : m_workers )
+            {
+                w.join();
+            }
+            m_workers.clear();
+            m_stats.m_elapsedSeconds = Timer::getIntervalSeconds( m_startTime, Timer::Clock::now() );
+
+            if ( m_rawFile != nullptr )
+            {
+                // Frames may have been written past the preallocated capacity.
+                if ( m_rawWidth > 0 )
+                {
+                    RawHeader header;
+                    std::memcpy( header.m_magic, RAW_MAGIC, sizeof( RAW_MAGIC ) );
+                    header.m_width = m_rawWidth;
+                    header.m_height = m_rawHeight;
+                    header.m_channels = 4;
+                    header.m_frameCount = std::max( m_rawFrameCount, m_params.m_rawFrameCapacity );
+                    seek( m_rawFile, 0 );
+                    fwrite( &header, sizeof( header ), 1, m_rawFile );
+                }
+                fclose( m_rawFile );
+                m_rawFile = nullptr;
+            }
+
+            // Release the buffers.
+            m_freeFrames.clear();
+            m_frames.clear();
+        }
+
+        bool FrameRecorder::submit( const uint8_t* pixels, uint width, uint height, uint frameIndex )
+        {
+            CORE_ASSERT( isRunning(), "Recorder is not started." );
+            const auto start = Timer::Clock::now();
+
+            Frame* frame = nullptr;
+            uint slot = 0;
+            {
+                std::unique_lock<std::mutex> lock( m_mutex );
+                ++m_stats.m_submitted;
+                if ( !m_hasFirstIndex )
+                {
+                    m_hasFirstIndex = true;
+                    m_firstIndex = frameIndex;
+                }
+                if ( frameIndex < m_firstIndex )
+                {
+                    LOG( logWARNING ) << "Frame " << frameIndex << " precedes the recording, skipped.";
+                    ++m_stats.m_dropped;
+                    m_stats.m_submitSeconds += Timer::getIntervalSeconds( start, Timer::Clock::now() );
+                    return false;
+                }
+                slot = frameIndex - m_firstIndex;
+                if ( m_freeFrames.empty() && !m_params.m_blockWhenFull )
+                {
+                    ++m_stats.m_dropped;
+                    m_stats.m_submitSeconds += Timer::getIntervalSeconds( start, Timer::Clock::now() );
+                    return false;
+                }
+                m_frameDone.wait( lock, [this]() { return !m_freeFrames.empty(); } );
+                frame = m_freeFrames.back();
+                m_freeFrames.pop_back();
+            }
+
+            // Buffers keep their capacity from one frame to the next.
+            frame->m_pixels.resize( size_t( width ) * height * 4 );
+            std::memcpy( frame->m_pixels.data(), pixels, frame->m_pixels.size() );
+            frame->m_width = width;
+            frame->m_height = height;
+            frame->m_index = frameIndex;
+            frame->m_slot = slot;
+
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_queue.push_back( frame );
+                m_stats.m_submitSeconds += Timer::getIntervalSeconds( start, Timer::Clock::now() );
+            }
+            m_frameQueued.notify_one();
+            return true;
+        }
+
+        void FrameRecorder::flush()
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_frameDone.wait( lock, [this]() { return m_queue.empty() && m_encoding == 0; } );
+        }
+
+        FrameRecorder::Statistics FrameRecorder::getStatistics() const
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            Statistics stats = m_stats;
+            if ( isRunning() )
+            {
+                stats.m_elapsedSeconds = Timer::getIntervalSeconds( m_startTime, Timer::Clock::now() );
+            }
+            return stats;
+        }
+
+        void FrameRecorder::workerLoop()
+        {
+            while ( true )
+            {
+                Frame* frame = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock( m_mutex );
+                    m_frameQueued.wait( lock, [this]() { return m_stopping || !m_queue.empty(); } );
+                    if ( m_queue.empty() )
+                    {
+                        // Stopping, and all the frames are written.
+                        return;
+                    }
+                    frame = m_queue.front();
+                    m_queue.pop_front();
+                    ++m_encoding;
+                }
+
+                const auto start = Timer::Clock::now();
+                const bool written = writeFrame( *frame );
+                const double seconds = Timer::getIntervalSeconds( start, Timer::Clock::now() );
+
+                {
+                    std::lock_guard<std::mutex> lock( m_mutex );
+                    --m_encoding;
+                    m_stats.m_encodeSeconds += seconds;
+                    if ( written )
+                    {
+                        ++m_stats.m_written;
+                        m_stats.m_bytes += frame->m_pixels.size();
+                    }
+                    else
+                    {
+                        ++m_stats.m_dropped;
+                    }
+                    m_freeFrames.push_back( frame );
+                }
+                m_frameDone.notify_all();
+            }
+        }
+
+        bool FrameRecorder::writeFrame( Frame& frame )
+        {
+            flipRows( frame.m_pixels.data(), frame.m_width, frame.m_height );
+            if ( m_params.m_opaque )
+            {
+                for ( size_t i = 3; i < frame.m_pixels.size(); i += 4 )
+                {
+                    frame.m_pixels[i] = 0xff;
+                }
+            }
+
+            if ( m_params.m_format == RAW )
+            {
+                std::lock_guard<std::mutex> lock( m_rawMutex );
+                if ( m_rawWidth == 0 )
+                {
+                    // The first frame gives the size of the slots : allocate the whole file now,
+                    // so that it does not grow while recording.
+                    m_rawWidth = frame.m_width;
+                    m_rawHeight = frame.m_height;
+                    RawHeader header;
+                    std::memcpy( header.m_magic, RAW_MAGIC, sizeof( RAW_MAGIC ) );
+                    header.m_width = m_rawWidth;
+                    header.m_height = m_rawHeight;
+                    header.m_channels = 4;
+                    header.m_frameCount = m_params.m_rawFrameCapacity;
+                    fwrite( &header, sizeof( header ), 1, m_rawFile );
+                    if ( m_params.m_rawFrameCapacity > 0 )
+                    {
+                        const uint64_t end = sizeof( RawHeader ) + uint64_t( m_params.m_rawFrameCapacity ) * frame.m_pixels.size();
+                        seek( m_rawFile, end - 1 );
+                        fputc( 0, m_rawFile );
+                    }
+                }
+                if ( frame.m_width != m_rawWidth || frame.m_height != m_rawHeight )
+                {
+                    LOG( logWARNING ) << "Frame " << frame.m_index << " does not have the size of the raw file, skipped.";
+                    return false;
+                }
+                const uint64_t offset = sizeof( RawHeader ) + uint64_t( frame.m_slot ) * frame.m_pixels.size();
+                m_rawFrameCount = std::max( m_rawFrameCount, frame.m_slot + 1 );
+                return seek( m_rawFile, offset ) &&
+                       fwrite( frame.m_pixels.data(), 1, frame.m_pixels.size(), m_rawFile ) == frame.m_pixels.size();
+            }
+
+            std::string filename;
+            Core::StringUtils::stringPrintf( filename, "%s/%s%06u.%s", m_params.m_path.c_str(), m_params.m_prefix.c_str(),
+                                             frame.m_index, m_params.m_format == PNG ? "png" : "bmp" );
+            const int w = int( frame.m_width );
+            const int h = int( frame.m_height );
+            const int ok = ( m_params.m_format == PNG ) ?
+                           stbi_write_png( filename.c_str(), w, h, 4, frame.m_pixels.data(), w * 4 ) :
+                           stbi_write_bmp( filename.c_str(), w, h, 4, frame.m_pixels.data() );
+            if ( !ok )
+            {
+                LOG( logWARNING ) << "Cannot write frame to " << filename;
+            }
+            return ok != 0;
+        }
+
+        bool FrameRecorder::readRawFrame( const std::string& filename, uint frameIndex, RawHeader& header,
+                                          std::vector<uint8_t>& pixels )
+        {
+            FILE* file = fopen( filename.c_str(), "rb" );
+            if ( file == nullptr )
+            {
+                return false;
+            }
+            bool ok = fread( &header, sizeof( header ), 1, file ) == 1 &&
+                      std::memcmp( header.m_magic, RAW_MAGIC, sizeof( RAW_MAGIC ) ) == 0 &&
+                      frameIndex < header.m_frameCount;
+            if ( ok )
+            {
+                pixels.resize( size_t( header.m_width ) * header.m_height * header.m_channels );
+                ok = seek( file, sizeof( RawHeader ) + uint64_t( frameIndex ) * pixels.size() ) &&
+                     fread( pixels.data(), 1, pixels.size(), file ) == pixels.size();
+            }
+            fclose( file );
+            return ok;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#ifndef RADIUMENGINE_FRAMERECORDER_HPP
+#define RADIUMENGINE_FRAMERECORDER_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Time/Timer.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Writes captured frames to disk on worker threads.
+        /// Frames are submitted as RGBA8 pixels in OpenGL order (bottom row first). They are
+        /// copied in a pool of preallocated buffers and put in a bounded queue, then flipped and
+        /// encoded by the workers, so that the rendering thread only pays for one copy.
+        /// Images are written either as one PNG or BMP file per frame, or as raw pixels in a
+        /// single file, to be encoded later (see RawHeader for its layout).
+        class RA_CORE_API FrameRecorder
+        {
+        public:
+            enum Format
+            {
+                PNG,
+                BMP,
+                RAW,
+            };
+
+            struct Parameters
+            {
+                Format m_format = PNG;
+
+                /// Folder of the PNG / BMP files, or name of the raw file.
+                /// An existing raw file is never overwritten : start() fails instead.
+                std::string m_path = ".";
+
+                /// Image files are named <m_path>/<m_prefix><frame index on 6 digits>.<ext>
+                std::string m_prefix = "radiumframe_";
+
+                /// Number of encoding threads.
+                uint m_workerCount = 2;
+
+                /// Maximum number of frames waiting to be encoded.
+                uint m_queueSize = 8;
+
+                /// When the queue is full, submit() waits for a worker if true, else drops the frame.
+                bool m_blockWhenFull = true;
+
+                /// Number of frames the raw file is sized for when it is created.
+                uint m_rawFrameCapacity = 0;
+
+                /// Set the alpha channel to opaque.
+                bool m_opaque = true;
+            };
+
+            /// Layout of the raw files : this header, then each frame at
+            /// sizeof(RawHeader) + index * width * height * 4, top row first.
+            /// The index of a frame in the file counts from the first frame submitted since start().
+            struct RawHeader
+            {
+                char m_magic[8]; ///< "RAFRAMES"
+                uint32_t m_width;
+                uint32_t m_height;
+                uint32_t m_channels;
+                uint32_t m_frameCount; ///< Number of frame slots in the file.
+            };
+
+            struct Statistics
+            {
+                uint m_submitted = 0;
+                uint m_written = 0;
+                uint m_dropped = 0;
+                uint64_t m_bytes = 0;           ///< Size of the written pixels.
+                double m_encodeSeconds = 0;     ///< Time spent by the workers on each frame.
+                double m_submitSeconds = 0;     ///< Time spent in submit().
+                double m_elapsedSeconds = 0;    ///< Time since start().
+
+                /// Frames written per second since start().
+                double getThroughput() const { return m_elapsedSeconds > 0 ? m_written / m_elapsedSeconds : 0; }
+            };
+
+            FrameRecorder();
+            ~FrameRecorder();
+
+            /// Start the workers. Returns false if the output can not be created.
+            bool start( const Parameters& params );
+
+            /// Write the pending frames and stop the workers.
+            void stop();
+
+            inline bool isRunning() const { return !m_workers.empty(); }
+
+            /// Queue a frame. pixels are width * height RGBA8 values, bottom row first.
+            /// frameIndex names the image files. Raw files store frameIndex - the index of the
+            /// first frame submitted since start(), so a recording always starts at slot 0.
+            /// Returns false if the frame was dropped.
+            bool submit( const uint8_t* pixels, uint width, uint height, uint frameIndex );
+
+            /// Block until all the submitted frames are written.
+            void flush();
+
+            Statistics getStatistics() const;
+
+            /// Read frame frameIndex of a raw file in pixels (top row first).
+            static bool readRawFrame( const std::string& filename, uint frameIndex, RawHeader& header,
+                                      std::vector<uint8_t>& pixels );
+
+        private:
+            struct Frame
+            {
+                std::vector<uint8_t> m_pixels;
+                uint m_width;
+                uint m_height;
+                uint m_index;
+                uint m_slot; ///< Index of the frame in the raw file.
+            };
+
+            FrameRecorder( const FrameRecorder& ) = delete;
+            void operator=( const FrameRecorder& ) = delete;
+
+            void workerLoop();
+            bool writeFrame( Frame& frame );
+
+        private:
+            Parameters m_params;
+            std::vector<std::thread> m_workers;
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_frameQueued;
+            std::condition_variable m_frameDone;
+            std::deque<Frame*> m_queue;
+            std::vector<Frame*> m_freeFrames;
+            std::vector<Frame> m_frames;
+            uint m_encoding;
+            bool m_stopping;
+            bool m_hasFirstIndex;
+            uint m_firstIndex;
+
+            FILE* m_rawFile;
+            std::mutex m_rawMutex;
+            uint m_rawWidth;
+            uint m_rawHeight;
+            uint m_rawFrameCount;
+
+            Statistics m_stats;
+            Timer::TimePoint m_startTime;
+        };
+    }
+}
+
+#endif // RADIUMENGINE_FRAMERECORDER_HPP
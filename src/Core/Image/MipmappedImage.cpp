@@ -0,0 +1,85 @@
+#include <Core/Image/MipmappedImage.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Ra
+{
+    namespace Core
+    {
+        uint MipmappedImage::getFullLevelCount() const
+        {
+            uint count = 1;
+            for ( uint size = std::max( m_width, m_height ); size > 1; size >>= 1 )
+            {
+                ++count;
+            }
+            return count;
+        }
+
+        std::size_t MipmappedImage::getByteSize() const
+        {
+            std::size_t size = 0;
+            for ( const auto& level : m_levels )
+            {
+                size += level.size();
+            }
+            return size;
+        }
+
+        void MipmappedImage::buildMipmaps()
+        {
+            CORE_ASSERT( !m_levels.empty(), "No image to build mipmaps from." );
+            CORE_ASSERT( m_levels[0].size() == std::size_t( m_width ) * m_height * m_channels, "Wrong image size." );
+
+            const uint levelCount = getFullLevelCount();
+            m_levels.resize( levelCount );
+            const uint c = m_channels;
+
+            for ( uint l = 1; l < levelCount; ++l )
+            {
+                const uint srcWidth = getLevelWidth( l - 1 );
+                const uint srcHeight = getLevelHeight( l - 1 );
+                const uint width = getLevelWidth( l );
+                const int height = int( getLevelHeight( l ) );
+                const uint8_t* src = m_levels[l - 1].data();
+                m_levels[l].resize( std::size_t( width ) * height * c );
+                uint8_t* dst = m_levels[l].data();
+
+#pragma omp parallel for if ( height >= 64 )
+                for ( int j = 0; j < height; ++j )
+                {
+                    const uint8_t* row0 = src + std::size_t( 2 * j ) * srcWidth * c;
+                    const uint8_t* row1 = src + std::size_t( std::min( 2 * uint( j ) + 1, srcHeight - 1 ) ) * srcWidth * c;
+                    uint8_t* out = dst + std::size_t( j ) * width * c;
+                    for ( uint i = 0; i < width; ++i )
+                    {
+                        const uint x0 = 2 * i * c;
+                        const uint x1 = std::min( 2 * i + 1, srcWidth - 1 ) * c;
+                        for ( uint k = 0; k < c; ++k )
+                        {
+                            // Rounded average.
+                            out[i * c + k] = uint8_t( ( uint( row0[x0 + k] ) + row0[x1 + k] + row1[x0 + k] + row1[x1 + k] + 2 ) / 4 );
+                        }
+                    }
+                }
+            }
+        }
+
+        void MipmappedImage::flipVertically()
+        {
+            CORE_ASSERT( !m_levels.empty(), "No image." );
+            const std::size_t rowSize = std::size_t( m_width ) * m_channels;
+            std::vector<uint8_t> row( rowSize );
+            uint8_t* data = m_levels[0].data();
+            for ( uint j = 0; j < m_height / 2; ++j )
+            {
+                uint8_t* top = data + j * rowSize;
+                uint8_t* bottom = data + ( m_height - 1 - j ) * rowSize;
+                std::memcpy( row.data(), top, rowSize );
+                std::memcpy( top, bottom, rowSize );
+                std::memcpy( bottom, row.data(), rowSize );
+            }
+        }
+    }
+}
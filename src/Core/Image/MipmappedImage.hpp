@@ -0,0 +1,47 @@
+#ifndef RADIUMENGINE_MIPMAPPEDIMAGE_HPP
+#define RADIUMENGINE_MIPMAPPEDIMAGE_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// An 8 bits per channel image (1 to 4 channels, rows stored bottom first as OpenGL
+        /// expects them) with its mipmap levels.
+        struct RA_CORE_API MipmappedImage
+        {
+            uint m_width = 0;
+            uint m_height = 0;
+            uint m_channels = 0;
+
+            /// m_levels[0] is the full resolution image, each level has half the size
+            /// (rounded down, at least 1) of the previous one.
+            std::vector<std::vector<uint8_t>> m_levels;
+
+            inline uint getLevelWidth( uint level ) const { return std::max( m_width >> level, 1u ); }
+            inline uint getLevelHeight( uint level ) const { return std::max( m_height >> level, 1u ); }
+
+            /// Number of levels of a full chain, down to 1x1.
+            uint getFullLevelCount() const;
+
+            /// Size of all the levels, in bytes.
+            std::size_t getByteSize() const;
+
+            /// Replace the levels after the first one by the full chain of mipmaps.
+            /// Each texel is the average of the 2x2 texels above it (edge texels are repeated
+            /// for odd sizes). Rows of the large levels are filtered in parallel.
+            void buildMipmaps();
+
+            /// Reverse the order of the rows of the first level.
+            void flipVertically();
+        };
+    }
+}
+
+#endif // RADIUMENGINE_MIPMAPPEDIMAGE_HPP
@@ -0,0 +1,460 @@
+#include <Core/Image/TextureLoader.hpp>
+
+#include <Core/Containers/SpatialHash.hpp>
+#include <Core/Image/stb_image.h>
+#include <Core/Log/Log.hpp>
+#include <Core/String/StringUtils.hpp>
+#include <Core/Time/Timer.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            // Smallest number of contents before expired ones are released.
+            const std::size_t MIN_CONTENT_SWEEP_SIZE = 64;
+
+            // Seed of the second content hash.
+            const uint64_t CONTENT_CHECK_SEED = 0x9e3779b97f4a7c15ull;
+
+            const char CACHE_MAGIC[8] = { 'R', 'A', 'M', 'I', 'P', 'M', 'A', '2' };
+
+            bool readFile( const std::string& filename, std::vector<uint8_t>& content )
+            {
+                FILE* file = fopen( filename.c_str(), "rb" );
+                if ( file == nullptr )
+                {
+                    return false;
+                }
+                bool ok = fseek( file, 0, SEEK_END ) == 0;
+                const long size = ok ? ftell( file ) : -1;
+                ok = size > 0 && fseek( file, 0, SEEK_SET ) == 0;
+                if ( ok )
+                {
+                    content.resize( std::size_t( size ) );
+                    ok = fread( content.data(), 1, content.size(), file ) == content.size();
+                }
+                fclose( file );
+                return ok;
+            }
+        }
+
+        TextureLoader::TextureLoader()
+            : m_contentSweepSize( MIN_CONTENT_SWEEP_SIZE )
+            , m_stopping( false )
+        {
+        }
+
+        TextureLoader::~TextureLoader()
+        {
+            stop();
+        }
+
+        void TextureLoader::start()
+        {
+            start( Parameters() );
+        }
+
+        void TextureLoader::start( const Parameters& params )
+        {
+            CORE_ASSERT( !isRunning(), "Loader already started." );
+
+            m_params = params;
+            m_params.m_workerCount = std::max( m_params.m_workerCount, 1u );
+            m_stopping = false;
+            m_stats = Statistics();
+
+            for ( uint i = 0; i < m_params.m_workerCount; ++i )
+            {
+                m_workers.emplace_back( &TextureLoader::workerLoop, this );
+            }
+        }
+
+        void TextureLoader::stop()
+        {
+            if ( !isRunning() )
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_stopping = true;
+            }
+            m_requestQueued.notify_all();
+            for ( auto& w : m_workers )
+            {
+                w.join();
+            }
+            m_workers.clear();
+        }
+
+        void TextureLoader::request( const std::string& filename )
+        {
+            CORE_ASSERT( isRunning(), "Loader is not started." );
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                if ( !m_pending.insert( filename ).second )
+                {
+                    return;
+                }
+                ++m_stats.m_requested;
+                m_queue.push_back( filename );
+            }
+            m_requestQueued.notify_one();
+        }
+
+        uint TextureLoader::takeLoaded( std::size_t byteBudget, std::vector<LoadedImage>& out )
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            uint taken = 0;
+            std::size_t bytes = 0;
+            while ( !m_loaded.empty() )
+            {
+                LoadedImage& loaded = m_loaded.front();
+                const std::size_t size = loaded.m_image ? loaded.m_image->getByteSize() : 0;
+                if ( taken > 0 && bytes + size > byteBudget )
+                {
+                    break;
+                }
+                bytes += size;
+                m_pending.erase( loaded.m_filename );
+                out.push_back( std::move( loaded ) );
+                m_loaded.pop_front();
+                ++taken;
+            }
+            return taken;
+        }
+
+        uint TextureLoader::getPendingCount() const
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            return uint( m_pending.size() );
+        }
+
+        void TextureLoader::waitLoaded()
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_imageLoaded.wait( lock, [this]() { return m_loaded.size() == m_pending.size(); } );
+        }
+
+        TextureLoader::Statistics TextureLoader::getStatistics() const
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            return m_stats;
+        }
+
+        uint TextureLoader::getContentCount() const
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            return uint( m_contents.size() );
+        }
+
+        void TextureLoader::releaseExpiredContents()
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            for ( auto it = m_contents.begin(); it != m_contents.end(); )
+            {
+                if ( !it->second.m_loading && it->second.m_image.expired() )
+                {
+                    it = m_contents.erase( it );
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            m_contentSweepSize = std::max( MIN_CONTENT_SWEEP_SIZE, 2 * m_contents.size() );
+        }
+
+        void TextureLoader::workerLoop()
+        {
+            while ( true )
+            {
+                std::string filename;
+                {
+                    std::unique_lock<std::mutex> lock( m_mutex );
+                    m_requestQueued.wait( lock, [this]() { return m_stopping || !m_queue.empty(); } );
+                    if ( m_queue.empty() )
+                    {
+                        // Stopping, and all the requests are loaded.
+                        return;
+                    }
+                    filename = std::move( m_queue.front() );
+                    m_queue.pop_front();
+                }
+                loadFile( filename );
+                m_imageLoaded.notify_all();
+            }
+        }
+
+        void TextureLoader::loadFile( const std::string& filename )
+        {
+            auto start = Timer::Clock::now();
+            std::vector<uint8_t> content;
+            const bool read = readFile( filename, content );
+            const ContentKey key = read ? getContentKey( content.data(), content.size() ) : ContentKey();
+            const double readSeconds = Timer::getIntervalSeconds( start, Timer::Clock::now() );
+
+            bool sweep;
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_stats.m_readSeconds += readSeconds;
+                if ( !read )
+                {
+                    LOG( logERROR ) << "Cannot read image \"" << filename << "\".";
+                    ++m_stats.m_failed;
+                    deliver( filename, nullptr );
+                    return;
+                }
+
+                // Another file with the same content may be loaded, or being loaded.
+                ContentEntry& entry = m_contents[key];
+                ImagePtr image = entry.m_image.lock();
+                if ( image )
+                {
+                    ++m_stats.m_deduplicated;
+                    deliver( filename, image );
+                    return;
+                }
+                if ( entry.m_loading )
+                {
+                    ++m_stats.m_deduplicated;
+                    entry.m_waiting.push_back( filename );
+                    return;
+                }
+                entry.m_loading = true;
+                sweep = m_contents.size() >= m_contentSweepSize;
+            }
+
+            // Keep the number of contents proportional to the number of images in use.
+            if ( sweep )
+            {
+                releaseExpiredContents();
+            }
+
+            Statistics stats;
+            ImagePtr image = buildImage( content, key, m_params, stats );
+
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_stats.m_decoded += stats.m_decoded;
+            m_stats.m_cacheHits += stats.m_cacheHits;
+            m_stats.m_decodeSeconds += stats.m_decodeSeconds;
+            m_stats.m_mipmapSeconds += stats.m_mipmapSeconds;
+            m_stats.m_cacheSeconds += stats.m_cacheSeconds;
+
+            ContentEntry& entry = m_contents[key];
+            std::vector<std::string> waiting;
+            std::swap( waiting, entry.m_waiting );
+            waiting.insert( waiting.begin(), filename );
+            if ( image )
+            {
+                entry.m_image = image;
+                entry.m_loading = false;
+            }
+            else
+            {
+                LOG( logERROR ) << "Cannot decode image \"" << filename << "\".";
+                m_stats.m_failed += uint( waiting.size() );
+                m_contents.erase( key );
+            }
+            for ( const auto& f : waiting )
+            {
+                deliver( f, image );
+            }
+        }
+
+        void TextureLoader::deliver( const std::string& filename, const ImagePtr& image )
+        {
+            LoadedImage loaded;
+            loaded.m_filename = filename;
+            loaded.m_image = image;
+            m_loaded.push_back( std::move( loaded ) );
+        }
+
+        TextureLoader::ImagePtr TextureLoader::buildImage( const std::vector<uint8_t>& content, const ContentKey& contentKey,
+                                                           const Parameters& params, Statistics& stats )
+        {
+            auto image = std::make_shared<MipmappedImage>();
+            const bool useCache = !params.m_cacheDirectory.empty();
+            const std::string cacheFilename = useCache ? getCacheFilename( params.m_cacheDirectory, contentKey.m_hash ) : "";
+
+            auto start = Timer::Clock::now();
+            if ( useCache && readCache( cacheFilename, contentKey, *image ) )
+            {
+                stats.m_cacheSeconds += Timer::getIntervalSeconds( start, Timer::Clock::now() );
+                ++stats.m_cacheHits;
+                if ( params.m_buildMipmaps && image->m_levels.size() < image->getFullLevelCount() )
+                {
+                    start = Timer::Clock::now();
+                    image->buildMipmaps();
+                    stats.m_mipmapSeconds += Timer::getIntervalSeconds( start, Timer::Clock::now() );
+                }
+                return image;
+            }
+
+            // stbi_set_flip_vertically_on_load() is global to all the threads, rows are flipped here instead.
+            start = Timer::Clock::now();
+            int w, h, n;
+            uint8_t* data = stbi_load_from_memory( content.data(), int( content.size() ), &w, &h, &n, 0 );
+            if ( data == nullptr )
+            {
+                return nullptr;
+            }
+            image->m_width = uint( w );
+            image->m_height = uint( h );
+            image->m_channels = uint( n );
+            image->m_levels.resize( 1 );
+            image->m_levels[0].assign( data, data + std::size_t( w ) * h * n );
+            stbi_image_free( data );
+            image->flipVertically();
+            stats.m_decodeSeconds += Timer::getIntervalSeconds( start, Timer::Clock::now() );
+            ++stats.m_decoded;
+
+            if ( params.m_buildMipmaps )
+            {
+                start = Timer::Clock::now();
+                image->buildMipmaps();
+                stats.m_mipmapSeconds += Timer::getIntervalSeconds( start, Timer::Clock::now() );
+            }
+
+            if ( useCache )
+            {
+                start = Timer::Clock::now();
+                if ( !writeCache( cacheFilename, contentKey, *image ) )
+                {
+                    LOG( logWARNING ) << "Cannot write texture cache file " << cacheFilename;
+                }
+                stats.m_cacheSeconds += Timer::getIntervalSeconds( start, Timer::Clock::now() );
+            }
+            return image;
+        }
+
+        TextureLoader::ImagePtr TextureLoader::loadImage( const std::string& filename, const Parameters& params )
+        {
+            std::vector<uint8_t> content;
+            if ( !readFile( filename, content ) )
+            {
+                return nullptr;
+            }
+            Statistics stats;
+            return buildImage( content, getContentKey( content.data(), content.size() ), params, stats );
+        }
+
+        uint64_t TextureLoader::hashContent( const uint8_t* data, std::size_t size, uint64_t seed )
+        {
+            uint64_t h = SpatialHash::combine( seed, size );
+            std::size_t i = 0;
+            for ( ; i + 8 <= size; i += 8 )
+            {
+                uint64_t word;
+                std::memcpy( &word, data + i, 8 );
+                h = SpatialHash::combine( h, word );
+            }
+            if ( i < size )
+            {
+                uint64_t word = 0;
+                std::memcpy( &word, data + i, size - i );
+                h = SpatialHash::combine( h, word );
+            }
+            return h;
+        }
+
+        TextureLoader::ContentKey TextureLoader::getContentKey( const uint8_t* data, std::size_t size )
+        {
+            ContentKey key;
+            key.m_hash = hashContent( data, size );
+            key.m_check = hashContent( data, size, CONTENT_CHECK_SEED );
+            key.m_size = size;
+            return key;
+        }
+
+        std::string TextureLoader::getCacheFilename( const std::string& cacheDirectory, uint64_t contentHash )
+        {
+            std::string filename;
+            Core::StringUtils::stringPrintf( filename, "%s/%016llx.rmip", cacheDirectory.c_str(),
+                                             (unsigned long long) contentHash );
+            return filename;
+        }
+
+        bool TextureLoader::readCache( const std::string& filename, const ContentKey& content, MipmappedImage& image )
+        {
+            FILE* file = fopen( filename.c_str(), "rb" );
+            if ( file == nullptr )
+            {
+                return false;
+            }
+            CacheHeader header;
+            bool ok = fread( &header, sizeof( header ), 1, file ) == 1 &&
+                      std::memcmp( header.m_magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) ) == 0 &&
+                      header.m_contentHash == content.m_hash && header.m_contentCheck == content.m_check &&
+                      header.m_contentSize == content.m_size &&
+                      header.m_width > 0 && header.m_height > 0 &&
+                      header.m_channels > 0 && header.m_channels <= 4;
+            if ( ok )
+            {
+                image.m_width = header.m_width;
+                image.m_height = header.m_height;
+                image.m_channels = header.m_channels;
+                ok = header.m_levelCount > 0 && header.m_levelCount <= image.getFullLevelCount();
+            }
+            if ( ok )
+            {
+                image.m_levels.resize( header.m_levelCount );
+                for ( uint l = 0; ok && l < header.m_levelCount; ++l )
+                {
+                    auto& level = image.m_levels[l];
+                    level.resize( std::size_t( image.getLevelWidth( l ) ) * image.getLevelHeight( l ) * image.m_channels );
+                    ok = fread( level.data(), 1, level.size(), file ) == level.size();
+                }
+            }
+            fclose( file );
+            return ok;
+        }
+
+        bool TextureLoader::writeCache( const std::string& filename, const ContentKey& content, const MipmappedImage& image )
+        {
+            // Write a temporary file first, so that other readers never see a partial file.
+            std::string tmpFilename;
+            Core::StringUtils::stringPrintf( tmpFilename, "%s.%zx.tmp", filename.c_str(),
+                                             std::hash<std::thread::id>()( std::this_thread::get_id() ) );
+            FILE* file = fopen( tmpFilename.c_str(), "wb" );
+            if ( file == nullptr )
+            {
+                return false;
+            }
+            CacheHeader header;
+            std::memcpy( header.m_magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) );
+            header.m_contentHash = content.m_hash;
+            header.m_contentCheck = content.m_check;
+            header.m_contentSize = content.m_size;
+            header.m_width = image.m_width;
+            header.m_height = image.m_height;
+            header.m_channels = image.m_channels;
+            header.m_levelCount = uint32_t( image.m_levels.size() );
+            bool ok = fwrite( &header, sizeof( header ), 1, file ) == 1;
+            for ( const auto& level : image.m_levels )
+            {
+                ok = ok && fwrite( level.data(), 1, level.size(), file ) == level.size();
+            }
+            ok = ( fclose( file ) == 0 ) && ok;
+            if ( ok && std::rename( tmpFilename.c_str(), filename.c_str() ) != 0 )
+            {
+                // Already written by someone else (rename does not replace files on Windows) :
+                // the content is the same.
+                std::remove( tmpFilename.c_str() );
+                return true;
+            }
+            if ( !ok )
+            {
+                std::remove( tmpFilename.c_str() );
+            }
+            return ok;
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#ifndef RADIUMENGINE_TEXTURELOADER_HPP
+#define RADIUMENGINE_TEXTURELOADER_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Image/MipmappedImage.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Loads image files on worker threads, ready to be uploaded as textures.
+        /// Each file is read and hashed, then decoded and its mipmaps built on the CPU, unless
+        /// an image with the same content is already in memory or in the disk cache.
+        /// Contents are identified by their size and two independent 64 bits hashes (see ContentKey).
+        /// The cache holds one file per content hash, <cache directory>/<hash>.rmip, with all
+        /// the levels of the image (see CacheHeader for its layout), so that loading the same
+        /// texture again only costs reading the file.
+        /// Nothing here needs an OpenGL context : the renderer takes the loaded images with
+        /// takeLoaded() and uploads them within its own budget.
+        class RA_CORE_API TextureLoader
+        {
+        public:
+            typedef std::shared_ptr<const MipmappedImage> ImagePtr;
+
+            struct Parameters
+            {
+                /// Number of loading threads.
+                uint m_workerCount = 2;
+
+                /// Folder of the cache files, which must exist. No disk cache if empty.
+                std::string m_cacheDirectory;
+
+                /// Build the mipmaps of the decoded images.
+                bool m_buildMipmaps = true;
+            };
+
+            struct LoadedImage
+            {
+                std::string m_filename;
+                ImagePtr m_image; ///< nullptr if the file could not be loaded.
+            };
+
+            /// Identifier of the content of a file. Files are considered equal if their keys are,
+            /// the second hash makes it unlikely for different files of the same size to collide.
+            struct ContentKey
+            {
+                uint64_t m_hash;  ///< Names the cache file.
+                uint64_t m_check; ///< Hash with another seed.
+                uint64_t m_size;
+
+                inline bool operator==( const ContentKey& other ) const
+                {
+                    return m_hash == other.m_hash && m_check == other.m_check && m_size == other.m_size;
+                }
+                inline bool operator<( const ContentKey& other ) const
+                {
+                    return m_hash != other.m_hash ? m_hash < other.m_hash
+                         : m_check != other.m_check ? m_check < other.m_check : m_size < other.m_size;
+                }
+            };
+
+            /// Layout of the cache files : this header, then the levels one after the other.
+            struct CacheHeader
+            {
+                char m_magic[8]; ///< "RAMIPMA2"
+                uint64_t m_contentHash;
+                uint64_t m_contentCheck;
+                uint64_t m_contentSize;
+                uint32_t m_width;
+                uint32_t m_height;
+                uint32_t m_channels;
+                uint32_t m_levelCount;
+            };
+
+            struct Statistics
+            {
+                uint m_requested = 0;    ///< Calls to request() for a file not already queued.
+                uint m_decoded = 0;      ///< Files decoded from their content.
+                uint m_cacheHits = 0;    ///< Files loaded from the disk cache.
+                uint m_deduplicated = 0; ///< Files sharing the image of a file with the same content.
+                uint m_failed = 0;
+                double m_readSeconds = 0;   ///< Time spent reading and hashing the files.
+                double m_decodeSeconds = 0; ///< Time spent decoding images.
+                double m_mipmapSeconds = 0; ///< Time spent building mipmaps.
+                double m_cacheSeconds = 0;  ///< Time spent reading and writing the cache.
+            };
+
+            TextureLoader();
+            ~TextureLoader();
+
+            /// Start the workers.
+            void start( const Parameters& params );
+            void start();
+
+            /// Finish the pending requests and stop the workers.
+            void stop();
+
+            inline bool isRunning() const { return !m_workers.empty(); }
+
+            /// Queue the loading of a file. Does nothing if the file is already queued, being
+            /// loaded or waiting to be taken.
+            void request( const std::string& filename );
+
+            /// Move loaded images to out, in loading order, until their size reaches byteBudget.
+            /// At least one image is taken if there is any, whatever its size.
+            /// Returns the number of images taken.
+            uint takeLoaded( std::size_t byteBudget, std::vector<LoadedImage>& out );
+
+            /// Number of requests not taken yet.
+            uint getPendingCount() const;
+
+            /// Block until all the requests are loaded.
+            void waitLoaded();
+
+            Statistics getStatistics() const;
+
+            /// Number of contents remembered to share the images of files with the same content.
+            uint getContentCount() const;
+
+            /// Forget the contents whose images are no longer used. Also done as loads add contents.
+            void releaseExpiredContents();
+
+            /// Load a file on the calling thread, using the same cache.
+            static ImagePtr loadImage( const std::string& filename, const Parameters& params );
+
+            /// Hash of the content of a file.
+            static uint64_t hashContent( const uint8_t* data, std::size_t size, uint64_t seed = 0 );
+
+            static ContentKey getContentKey( const uint8_t* data, std::size_t size );
+
+            /// Name of the cache file of an image with the given content hash.
+            static std::string getCacheFilename( const std::string& cacheDirectory, uint64_t contentHash );
+
+            /// Read a cache file, which fails if it was written for another content.
+            static bool readCache( const std::string& filename, const ContentKey& content, MipmappedImage& image );
+            static bool writeCache( const std::string& filename, const ContentKey& content, const MipmappedImage& image );
+
+        private:
+            /// Images decoded from the same content.
+            struct ContentEntry
+            {
+                std::weak_ptr<const MipmappedImage> m_image;
+                bool m_loading = false;
+                std::vector<std::string> m_waiting; ///< Other files with this content.
+            };
+
+            TextureLoader( const TextureLoader& ) = delete;
+            void operator=( const TextureLoader& ) = delete;
+
+            void workerLoop();
+            void loadFile( const std::string& filename );
+            void deliver( const std::string& filename, const ImagePtr& image );
+
+            /// Build an image from the content of a file, from the cache or by decoding it.
+            /// Adds the time spent in each stage to stats, and returns nullptr on failure.
+            static ImagePtr buildImage( const std::vector<uint8_t>& content, const ContentKey& contentKey,
+                                        const Parameters& params, Statistics& stats );
+
+        private:
+            Parameters m_params;
+            std::vector<std::thread> m_workers;
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_requestQueued;
+            std::condition_variable m_imageLoaded;
+            std::deque<std::string> m_queue;
+            std::deque<LoadedImage> m_loaded;
+            std::set<std::string> m_pending; ///< Files queued, being loaded or not taken yet.
+            std::map<ContentKey, ContentEntry> m_contents;
+            std::size_t m_contentSweepSize; ///< Number of contents triggering releaseExpiredContents().
+            bool m_stopping;
+
+            Statistics m_stats;
+        };
+    }
+}
+
+#endif // RADIUMENGINE_TEXTURELOADER_HPP
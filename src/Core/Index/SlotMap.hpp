@@ -0,0 +1,139 @@
+#ifndef RADIUMENGINE_SLOTMAP_HPP
+#define RADIUMENGINE_SLOTMAP_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <vector>
+
+#include <Core/Index/Index.hpp>
+
+namespace Ra {
+namespace Core {
+
+/*!
+* The class SlotMap stores objects coupled with an index, like IndexMap, with constant time
+* insertion, removal and lookup.
+* Objects are stored contiguously, and a table of slots gives the position of the object of each index.
+* An index holds the slot of its object and the generation of this slot, which is incremented when
+* the object is removed : an index kept after the removal of its object is never valid again, even if
+* the slot is reused (up to the wrap around of the generation counter, after 2048 reuses of a slot).
+* Iteration visits the objects in their storage order. Removing an object moves the last one in its place,
+* so this order is the insertion order until the first removal. Insertions and removals invalidate
+* iterators and references to the objects.
+*/
+template <typename T>
+class SlotMap {
+public:
+    // ===============================================================================
+    // TYPEDEF
+    // ===============================================================================
+    typedef typename std::vector<T>                 Container;      /// Where the objects are stored
+    typedef typename std::vector<Index>             IndexContainer; /// Index of each stored object
+
+    typedef typename IndexContainer::const_iterator ConstIndexIterator; /// Const iterator to the list of indices of the SlotMap.
+    typedef typename Container::iterator            Iterator;           /// Iterator to the list of objects of the SlotMap.
+    typedef typename Container::const_iterator      ConstIterator;      /// Const iterator to the list of objects of the SlotMap.
+
+    // ===============================================================================
+    // CONSTRUCTOR
+    // ===============================================================================
+    inline SlotMap();                                       /// Default constructor.
+
+    // ===============================================================================
+    // INSERT
+    // ===============================================================================
+    /// Insert a object in the SlotMap. Return an invalid index if the object is not inserted.
+    inline Index insert( const T& obj );
+    inline Index insert( T&& obj );
+
+    /// Construct an object in place in the SlotMap. Return an invalid index if the object is not inserted.
+    template<typename... Args>
+    inline Index emplace( Args&&... args );
+
+    // ===============================================================================
+    // REMOVE
+    // ===============================================================================
+    /// Remove the object with the given index. Return false if the index is not in the map.
+    inline bool  remove( const Index& idx );
+
+    // ===============================================================================
+    // ACCESS
+    // ===============================================================================
+    /// Return a read-only ref to object with the given index. Asserts if index does not exist.
+    inline const T&  at( const Index& idx ) const;
+
+    /// Return a reference to the object with the given index. Asserts if index does not exist.
+    inline T& access( const Index& idx );
+
+    // ===============================================================================
+    // SIZE
+    // ===============================================================================
+    inline size_t size() const;   /// Return the size of the SlotMap ( number of object contained ).
+    inline void  clear();         /// Remove all the objects. Their indices stay invalid.
+    inline void  reserve( size_t n ); /// Reserve storage for n objects.
+
+    // ===============================================================================
+    // QUERY
+    // ===============================================================================
+    inline bool  empty() const;                      /// Return true if the SlotMap is empty.
+    inline bool  full()  const;                      /// Return true if the SlotMap cannot contain more objects.
+    inline bool  contains( const Index& idx ) const; /// Return true if the SlotMap contains a object with the given index.
+    inline Index index( const uint i ) const;        /// Return the index of the i-th object. Return an invalid index if i is out of bound.
+
+    // ===============================================================================
+    // OPERATOR
+    // ===============================================================================
+    inline T&         operator[]( const Index& idx );       /// Return a reference to the object with given index.
+    inline const T&   operator[]( const Index& idx ) const; /// Return a const reference to the object with given index.
+
+    // ===============================================================================
+    // INDEX ITERATOR
+    // ===============================================================================
+    inline ConstIndexIterator cbegin_index() const; /// Return a const iterator to the index of the first object.
+    inline ConstIndexIterator   cend_index() const; /// Return a const iterator to the end of the indices.
+
+    // ===============================================================================
+    // DATA ITERATOR
+    // ===============================================================================
+    inline      Iterator  begin();       /// Return a iterator to the first object in the SlotMap.
+    inline      Iterator    end();       /// Return a iterator to the end of the object list in the SlotMap.
+    inline ConstIterator  begin() const; /// Return a iterator to the first object in the SlotMap.
+    inline ConstIterator    end() const; /// Return a iterator to the end of the object list in the SlotMap.
+    inline ConstIterator cbegin() const; /// Return a const iterator to the first object in the SlotMap.
+    inline ConstIterator   cend() const; /// Return a const iterator to the end of the object list in the SlotMap.
+
+private:
+    // ===============================================================================
+    // SLOT MANAGEMENT
+    // ===============================================================================
+    inline Index allocate();                        /// Take a slot for a new object stored at the end.
+    inline uint  position( const Index& idx ) const; /// Storage position of the object with the given index.
+
+    static inline uint slotOf( const Index& idx );   /// Slot part of an index.
+
+private:
+    /// An index is made of the slot in its low bits and the generation in the others.
+    static const uint s_slotBits = 20;
+    static const uint s_maxSlots = 1u << s_slotBits;
+    static const uint s_generationMask = ( 1u << ( 31 - s_slotBits ) ) - 1;
+    static const uint s_noSlot = uint( -1 );
+
+    struct Slot
+    {
+        uint m_position;   /// Position of the object, or next free slot if the slot is free.
+        uint m_generation; /// Generation of the current (or next) object of the slot.
+    };
+
+    // Member variables
+    Container            m_data;     /// Objects in the SlotMap
+    IndexContainer       m_index;    /// Index of each object
+    std::vector< Slot >  m_slots;    /// Slot table
+    uint                 m_freeHead; /// First free slot of the free list
+};
+
+} // namespace Core
+} // namespace Ra
+
+#include <Core/Index/SlotMap.inl>
+
+#endif // RADIUMENGINE_SLOTMAP_HPP
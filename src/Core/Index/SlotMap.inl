@@ -0,0 +1,283 @@
+#include <Core/Index/SlotMap.hpp>
+
+#include <utility>
+
+namespace Ra {
+namespace Core {
+
+
+// ===============================================================================
+// CONSTRUCTOR
+// ===============================================================================
+template < typename T >
+SlotMap< T >::SlotMap() :
+    m_data(),
+    m_index(),
+    m_slots(),
+    m_freeHead( s_noSlot ) { }
+
+// ===============================================================================
+// INSERT
+// ===============================================================================
+template < typename T >
+inline Index SlotMap< T >::insert( const T& obj )
+{
+    Index idx = allocate();
+    if( idx.isValid() )
+    {
+        m_data.push_back( obj );
+    }
+    return idx;
+}
+
+template < typename T >
+inline Index SlotMap< T >::insert( T&& obj )
+{
+    Index idx = allocate();
+    if( idx.isValid() )
+    {
+        m_data.push_back( std::move( obj ) );
+    }
+    return idx;
+}
+
+template < typename T >
+template < typename... Args >
+inline Index SlotMap< T >::emplace( Args&&... args )
+{
+    Index idx = allocate();
+    if( idx.isValid() )
+    {
+        m_data.emplace_back( std::forward< Args >( args )... );
+    }
+    return idx;
+}
+
+// ===============================================================================
+// REMOVE
+// ===============================================================================
+template < typename T >
+inline bool SlotMap< T >::remove( const Index& idx )
+{
+    if( !contains( idx ) )
+    {
+        return false;
+    }
+
+    const uint slot = slotOf( idx );
+    const uint pos  = m_slots[slot].m_position;
+    const uint last = uint( m_data.size() ) - 1;
+
+    // Move the last object in the hole.
+    if( pos != last )
+    {
+        m_data[pos]  = std::move( m_data[last] );
+        m_index[pos] = m_index[last];
+        m_slots[slotOf( m_index[pos] )].m_position = pos;
+    }
+    m_data.pop_back();
+    m_index.pop_back();
+
+    // A new generation makes the indices of the removed object invalid.
+    m_slots[slot].m_generation = ( m_slots[slot].m_generation + 1 ) & s_generationMask;
+    m_slots[slot].m_position   = m_freeHead;
+    m_freeHead = slot;
+    return true;
+}
+
+// ===============================================================================
+// ACCESS
+// ===============================================================================
+template < typename T >
+inline const T& SlotMap< T >::at( const Index& idx ) const
+{
+    CORE_ASSERT( contains( idx ), "Index not found" );
+    return m_data[position( idx )];
+}
+
+template < typename T >
+inline T& SlotMap< T >::access( const Index& idx )
+{
+    CORE_ASSERT( contains( idx ), "Index not found" );
+    return m_data[position( idx )];
+}
+
+// ===============================================================================
+// SIZE
+// ===============================================================================
+template < typename T >
+inline size_t SlotMap< T >::size() const
+{
+    return m_data.size();
+}
+
+template < typename T >
+inline void SlotMap< T >::clear()
+{
+    while( !m_index.empty() )
+    {
+        remove( m_index.back() );
+    }
+}
+
+template < typename T >
+inline void SlotMap< T >::reserve( size_t n )
+{
+    m_data.reserve( n );
+    m_index.reserve( n );
+    m_slots.reserve( n );
+}
+
+// ===============================================================================
+// QUERY
+// ===============================================================================
+template < typename T >
+inline bool SlotMap< T >::empty() const
+{
+    return m_data.empty();
+}
+
+template < typename T >
+inline bool SlotMap< T >::full() const
+{
+    return m_freeHead == s_noSlot && m_slots.size() == s_maxSlots;
+}
+
+template < typename T >
+inline bool SlotMap< T >::contains( const Index& idx ) const
+{
+    if( idx.isInvalid() )
+    {
+        return false;
+    }
+    const uint slot = slotOf( idx );
+    if( slot >= m_slots.size() )
+    {
+        return false;
+    }
+    // Free slots link to other free slots, which are never equal to an index of a stored object.
+    const uint pos = m_slots[slot].m_position;
+    return pos < m_index.size() && m_index[pos].getValue() == idx.getValue();
+}
+
+template < typename T >
+inline Index SlotMap< T >::index( const uint i ) const
+{
+    if( i >= m_index.size() )
+    {
+        return Index::Invalid();
+    }
+    return m_index[i];
+}
+
+// ===============================================================================
+// OPERATOR
+// ===============================================================================
+template < typename T >
+inline T& SlotMap< T >::operator[]( const Index& idx )
+{
+    return access( idx );
+}
+
+template < typename T >
+inline const T& SlotMap< T >::operator[]( const Index& idx ) const
+{
+    return at( idx );
+}
+
+// ===============================================================================
+// INDEX ITERATOR
+// ===============================================================================
+template < typename T >
+inline typename SlotMap< T >::ConstIndexIterator SlotMap< T >::cbegin_index() const
+{
+    return m_index.cbegin();
+}
+
+template < typename T >
+inline typename SlotMap< T >::ConstIndexIterator SlotMap< T >::cend_index() const
+{
+    return m_index.cend();
+}
+
+// ===============================================================================
+// DATA ITERATOR
+// ===============================================================================
+template < typename T >
+inline typename SlotMap< T >::Iterator SlotMap< T >::begin()
+{
+    return m_data.begin();
+}
+
+template < typename T >
+inline typename SlotMap< T >::Iterator SlotMap< T >::end()
+{
+    return m_data.end();
+}
+
+template < typename T >
+inline typename SlotMap< T >::ConstIterator SlotMap< T >::begin() const
+{
+    return m_data.begin();
+}
+
+template < typename T >
+inline typename SlotMap< T >::ConstIterator SlotMap< T >::end() const
+{
+    return m_data.end();
+}
+
+template < typename T >
+inline typename SlotMap< T >::ConstIterator SlotMap< T >::cbegin() const
+{
+    return m_data.cbegin();
+}
+
+template < typename T >
+inline typename SlotMap< T >::ConstIterator SlotMap< T >::cend() const
+{
+    return m_data.cend();
+}
+
+// ===============================================================================
+// SLOT MANAGEMENT
+// ===============================================================================
+template < typename T >
+inline Index SlotMap< T >::allocate()
+{
+    uint slot;
+    if( m_freeHead != s_noSlot )
+    {
+        slot = m_freeHead;
+        m_freeHead = m_slots[slot].m_position;
+    }
+    else if( m_slots.size() < s_maxSlots )
+    {
+        slot = uint( m_slots.size() );
+        m_slots.push_back( Slot{ 0, 0 } );
+    }
+    else
+    {
+        return Index::Invalid();
+    }
+
+    m_slots[slot].m_position = uint( m_data.size() );
+    const Index idx( int( ( m_slots[slot].m_generation << s_slotBits ) | slot ) );
+    m_index.push_back( idx );
+    return idx;
+}
+
+template < typename T >
+inline uint SlotMap< T >::position( const Index& idx ) const
+{
+    return m_slots[slotOf( idx )].m_position;
+}
+
+template < typename T >
+inline uint SlotMap< T >::slotOf( const Index& idx )
+{
+    return uint( idx.getValue() ) & ( s_maxSlots - 1 );
+}
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,589 @@
+#include <Core/Log/AsyncLog.hpp>
+
+#include <Core/Log/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            typedef std::chrono::system_clock LogClock;
+
+            // Records are 256 bytes.
+            const uint RECORD_TEXT_SIZE = 256 - 2 * sizeof( int64_t );
+        }
+
+        namespace AsyncLogInternal
+        {
+            struct Record
+            {
+                int64_t m_time;      // Ticks of LogClock.
+                int32_t m_level;
+                uint16_t m_length;   // Bytes of m_text used.
+                uint16_t m_continued;// The message goes on in the next record.
+                char m_text[RECORD_TEXT_SIZE];
+            };
+
+            // Single producer (the logging thread), single consumer (the writer thread) ring.
+            // Indices grow forever and are wrapped with m_mask.
+            struct Ring
+            {
+                explicit Ring( uint size ) : m_records( size ), m_mask( size - 1 ), m_closed( false ), m_head( 0 ), m_tail( 0 ) {}
+
+                std::vector<Record> m_records;
+                uint64_t m_mask;
+
+                // Set when the producer thread exits : the ring is released once it is empty.
+                std::atomic<bool> m_closed;
+
+                // Written by the producer. Padding keeps head and tail in distinct cache lines.
+                char m_pad0[64];
+                std::atomic<uint64_t> m_head;
+                char m_pad1[64];
+                // Written by the consumer.
+                std::atomic<uint64_t> m_tail;
+                char m_pad2[64];
+            };
+
+            struct State
+            {
+                AsyncLog::Parameters m_params;
+                std::thread m_writer;
+                std::atomic<bool> m_stopping{false};
+
+                std::mutex m_ringsMutex;
+                std::vector<std::unique_ptr<Ring>> m_rings;
+
+                // Wakes up the writer (new data, flush request, stop).
+                std::mutex m_wakeMutex;
+                std::condition_variable m_wakeWriter;
+                // Signaled by the writer after each batch.
+                std::condition_variable m_batchDone;
+                // Batches done, and whether the writer is waiting for the next one (under m_wakeMutex).
+                uint64_t m_batchCount = 0;
+                bool m_writerIdle = false;
+
+                std::atomic<uint64_t> m_written{0};
+                std::atomic<uint64_t> m_dropped{0};
+                std::atomic<uint64_t> m_batches{0};
+
+                // Dropped messages already reported in the log (writer thread only).
+                uint64_t m_reportedDropped = 0;
+            };
+        }
+
+        namespace
+        {
+            using AsyncLogInternal::Record;
+            using AsyncLogInternal::Ring;
+            typedef AsyncLogInternal::State AsyncLogState;
+
+            struct PendingMessage
+            {
+                int64_t m_time;
+                int m_level;
+                std::string m_text;
+            };
+
+            std::atomic<AsyncLogState*> g_state{nullptr};
+
+            // Incremented at each start(), so that threads drop the rings of a previous run.
+            std::atomic<uint> g_generation{0};
+
+            // Number of threads using the state. stop() waits for them before deleting it, so that
+            // a thread which loaded g_state just before stop() cleared it never uses a deleted state.
+            std::atomic<uint> g_users{0};
+
+            // Scoped use of the state, which is null if the log is not running.
+            class StateUse
+            {
+            public:
+                // Both operations are sequentially consistent with those of stop() : either the state
+                // is loaded before it is cleared and stop() sees the user, or it is loaded as null.
+                StateUse() : m_state( ( g_users.fetch_add( 1 ), g_state.load() ) ) {}
+                ~StateUse() { g_users.fetch_sub( 1, std::memory_order_release ); }
+
+                StateUse( const StateUse& ) = delete;
+                StateUse& operator=( const StateUse& ) = delete;
+
+                inline AsyncLogState* get() const { return m_state; }
+
+            private:
+                AsyncLogState* m_state;
+            };
+
+            struct ThreadRing
+            {
+                Ring* m_ring = nullptr;
+                uint m_generation = 0;
+
+                // Set while a MessageBuffer of the thread fills records which are not published yet.
+                bool m_writing = false;
+
+                // Let the writer release the ring when the thread exits.
+                ~ThreadRing()
+                {
+                    StateUse use;
+                    if ( m_ring != nullptr && use.get() != nullptr &&
+                         m_generation == g_generation.load( std::memory_order_acquire ) )
+                    {
+                        m_ring->m_closed.store( true, std::memory_order_release );
+                    }
+                    m_ring = nullptr;
+                }
+            };
+
+            thread_local ThreadRing t_ring;
+
+            Ring* getThreadRing( AsyncLogState* state )
+            {
+                const uint generation = g_generation.load( std::memory_order_acquire );
+                if ( t_ring.m_ring == nullptr || t_ring.m_generation != generation )
+                {
+                    std::lock_guard<std::mutex> lock( state->m_ringsMutex );
+                    state->m_rings.emplace_back( new Ring( state->m_params.m_ringSize ) );
+                    t_ring.m_ring = state->m_rings.back().get();
+                    t_ring.m_generation = generation;
+                }
+                return t_ring.m_ring;
+            }
+
+            void wakeWriter( AsyncLogState* state )
+            {
+                std::lock_guard<std::mutex> lock( state->m_wakeMutex );
+                state->m_wakeWriter.notify_one();
+            }
+
+            std::vector<Ring*> getRings( AsyncLogState* state )
+            {
+                std::lock_guard<std::mutex> lock( state->m_ringsMutex );
+                std::vector<Ring*> rings( state->m_rings.size() );
+                std::transform( state->m_rings.begin(), state->m_rings.end(), rings.begin(),
+                                []( const std::unique_ptr<Ring>& r ) { return r.get(); } );
+                return rings;
+            }
+
+            // Delete the rings of the exited threads once all their messages are written.
+            void releaseClosedRings( AsyncLogState* state )
+            {
+                std::lock_guard<std::mutex> lock( state->m_ringsMutex );
+                auto end = std::remove_if( state->m_rings.begin(), state->m_rings.end(), []( const std::unique_ptr<Ring>& r )
+                {
+                    // The flag is read first : the head cannot move once the ring is closed.
+                    return r->m_closed.load( std::memory_order_acquire ) &&
+                           r->m_head.load( std::memory_order_acquire ) == r->m_tail.load( std::memory_order_relaxed );
+                } );
+                state->m_rings.erase( end, state->m_rings.end() );
+            }
+
+            // Copy all the messages of the rings to messages. tails receives the new tail of each
+            // ring, to be stored once the messages are written (see AsyncLog::flush()).
+            void collect( const std::vector<Ring*>& rings, std::vector<PendingMessage>& messages,
+                          std::vector<uint64_t>& tails )
+            {
+                tails.resize( rings.size() );
+                for ( uint i = 0; i < rings.size(); ++i )
+                {
+                    const Ring* ring = rings[i];
+                    const uint64_t head = ring->m_head.load( std::memory_order_acquire );
+                    uint64_t tail = ring->m_tail.load( std::memory_order_relaxed );
+                    while ( tail != head )
+                    {
+                        const Record& first = ring->m_records[tail & ring->m_mask];
+                        PendingMessage message;
+                        message.m_time = first.m_time;
+                        message.m_level = first.m_level;
+                        // Producers publish whole messages, so the continuation records are there.
+                        for ( bool continued = true; continued; ++tail )
+                        {
+                            const Record& r = ring->m_records[tail & ring->m_mask];
+                            message.m_text.append( r.m_text, r.m_length );
+                            continued = r.m_continued != 0;
+                        }
+                        messages.push_back( std::move( message ) );
+                    }
+                    tails[i] = tail;
+                }
+            }
+
+            void write( AsyncLogState* state, std::vector<PendingMessage>& messages )
+            {
+                // Each thread queue is in order : interleave them by time.
+                std::stable_sort( messages.begin(), messages.end(),
+                                  []( const PendingMessage& a, const PendingMessage& b ) { return a.m_time < b.m_time; } );
+
+                std::string buffer;
+                std::time_t lastSecond = 0;
+                std::string lastTime;
+                for ( const auto& m : messages )
+                {
+                    const std::time_t t = LogClock::to_time_t( LogClock::time_point( LogClock::duration( m.m_time ) ) );
+                    if ( lastTime.empty() || t != lastSecond )
+                    {
+                        lastSecond = t;
+                        lastTime = FormatTime( t );
+                    }
+                    const TLogLevel level = TLogLevel( m.m_level );
+                    buffer += "- ";
+                    buffer += lastTime;
+                    buffer += " ";
+                    buffer += FILELog::ToString( level );
+                    buffer += ": ";
+                    buffer.append( level > logDEBUG ? level - logDEBUG : 0, '\t' );
+                    buffer += m.m_text;
+                    buffer += "\n";
+                }
+
+                const uint64_t dropped = state->m_dropped.load( std::memory_order_relaxed );
+                if ( dropped != state->m_reportedDropped )
+                {
+                    buffer += "- " + NowTime() + " WARNING: " + std::to_string( dropped - state->m_reportedDropped ) +
+                              " log messages dropped.\n";
+                    state->m_reportedDropped = dropped;
+                }
+
+                FILE* stream = Output2FILE::Stream();
+                if ( stream && !buffer.empty() )
+                {
+                    fwrite( buffer.data(), 1, buffer.size(), stream );
+                    fflush( stream );
+                    state->m_batches.fetch_add( 1, std::memory_order_relaxed );
+                }
+                state->m_written.fetch_add( messages.size(), std::memory_order_relaxed );
+                messages.clear();
+            }
+
+            void writerLoop( AsyncLogState* state )
+            {
+                std::vector<PendingMessage> messages;
+                std::vector<uint64_t> tails;
+                const auto interval = std::chrono::milliseconds( state->m_params.m_flushIntervalMs );
+                bool stopping = false;
+                while ( !stopping )
+                {
+                    // Read the flag before collecting, so that nothing pushed before stop() is missed.
+                    stopping = state->m_stopping.load( std::memory_order_acquire );
+
+                    const std::vector<Ring*> rings = getRings( state );
+                    collect( rings, messages, tails );
+                    if ( !messages.empty() || state->m_dropped.load( std::memory_order_relaxed ) != state->m_reportedDropped )
+                    {
+                        write( state, messages );
+                    }
+                    for ( uint i = 0; i < rings.size(); ++i )
+                    {
+                        rings[i]->m_tail.store( tails[i], std::memory_order_release );
+                    }
+                    releaseClosedRings( state );
+
+                    std::unique_lock<std::mutex> lock( state->m_wakeMutex );
+                    ++state->m_batchCount;
+                    state->m_batchDone.notify_all();
+                    if ( !stopping )
+                    {
+                        state->m_writerIdle = true;
+                        state->m_wakeWriter.wait_for( lock, interval );
+                        state->m_writerIdle = false;
+                    }
+                }
+            }
+
+            uint roundUpPowerOfTwo( uint n )
+            {
+                uint p = 2;
+                while ( p < n )
+                {
+                    p <<= 1;
+                }
+                return p;
+            }
+        }
+
+        void AsyncLog::start( const Parameters& params )
+        {
+            CORE_ASSERT( !isRunning(), "Asynchronous log already started." );
+
+            AsyncLogState* state = new AsyncLogState;
+            state->m_params = params;
+            state->m_params.m_ringSize = roundUpPowerOfTwo( std::max( params.m_ringSize, 2u ) );
+            state->m_writer = std::thread( writerLoop, state );
+
+            g_generation.fetch_add( 1, std::memory_order_release );
+            g_state.store( state, std::memory_order_release );
+
+            // Write the pending messages when the program exits, e.g. from CORE_ERROR.
+            static const bool stopAtExit = ( std::atexit( []() { AsyncLog::stop(); } ) == 0 );
+            CORE_UNUSED( stopAtExit );
+        }
+
+        void AsyncLog::start()
+        {
+            start( Parameters() );
+        }
+
+        void AsyncLog::stop()
+        {
+            AsyncLogState* state = g_state.exchange( nullptr );
+            if ( state == nullptr )
+            {
+                return;
+            }
+
+            // The writer keeps running, so that blocked producers and flushes can complete.
+            while ( g_users.load() != 0 )
+            {
+                std::this_thread::yield();
+            }
+
+            state->m_stopping.store( true, std::memory_order_release );
+            wakeWriter( state );
+            state->m_writer.join();
+            delete state;
+        }
+
+        bool AsyncLog::isRunning()
+        {
+            return g_state.load( std::memory_order_acquire ) != nullptr;
+        }
+
+        bool AsyncLog::push( int level, const std::string& message )
+        {
+            StateUse use;
+            AsyncLogState* state = use.get();
+            if ( state == nullptr || t_ring.m_writing )
+            {
+                return false;
+            }
+
+            const int64_t time = LogClock::now().time_since_epoch().count();
+            Ring* ring = getThreadRing( state );
+            const uint64_t capacity = ring->m_records.size();
+
+            // Very long messages are cut to fit in the ring.
+            const uint64_t needed = std::min<uint64_t>( std::max<size_t>( 1, ( message.size() + RECORD_TEXT_SIZE - 1 ) / RECORD_TEXT_SIZE ), capacity );
+            const size_t length = std::min<size_t>( message.size(), needed * RECORD_TEXT_SIZE );
+
+            const uint64_t head = ring->m_head.load( std::memory_order_relaxed );
+            uint64_t tail = ring->m_tail.load( std::memory_order_acquire );
+            while ( head + needed - tail > capacity )
+            {
+                if ( state->m_params.m_policy == DROP_MESSAGES )
+                {
+                    state->m_dropped.fetch_add( 1, std::memory_order_relaxed );
+                    return true;
+                }
+                wakeWriter( state );
+                std::this_thread::yield();
+                tail = ring->m_tail.load( std::memory_order_acquire );
+            }
+
+            for ( uint64_t i = 0; i < needed; ++i )
+            {
+                Record& r = ring->m_records[( head + i ) & ring->m_mask];
+                const size_t offset = i * RECORD_TEXT_SIZE;
+                r.m_time = time;
+                r.m_level = level;
+                r.m_length = uint16_t( std::min<size_t>( RECORD_TEXT_SIZE, length - offset ) );
+                r.m_continued = ( i + 1 < needed ) ? 1 : 0;
+                std::memcpy( r.m_text, message.data() + offset, r.m_length );
+            }
+            ring->m_head.store( head + needed, std::memory_order_release );
+
+            // Do not let the ring fill up while the writer sleeps.
+            if ( head + needed - tail > capacity / 2 )
+            {
+                wakeWriter( state );
+            }
+            return true;
+        }
+
+        void AsyncLog::flush()
+        {
+            StateUse use;
+            AsyncLogState* state = use.get();
+            if ( state == nullptr )
+            {
+                return;
+            }
+
+            // Wait for a batch collected after the call : the next one if the writer is idle,
+            // otherwise the batch in progress may have collected the rings before the call.
+            std::unique_lock<std::mutex> lock( state->m_wakeMutex );
+            const uint64_t target = state->m_batchCount + ( state->m_writerIdle ? 1 : 2 );
+            while ( state->m_batchCount < target )
+            {
+                state->m_wakeWriter.notify_one();
+                state->m_batchDone.wait_for( lock, std::chrono::milliseconds( 1 ) );
+            }
+        }
+
+        AsyncLog::Statistics AsyncLog::getStatistics()
+        {
+            Statistics stats;
+            StateUse use;
+            AsyncLogState* state = use.get();
+            if ( state != nullptr )
+            {
+                stats.m_written = state->m_written.load( std::memory_order_relaxed );
+                stats.m_dropped = state->m_dropped.load( std::memory_order_relaxed );
+                stats.m_batches = state->m_batches.load( std::memory_order_relaxed );
+                std::lock_guard<std::mutex> lock( state->m_ringsMutex );
+                stats.m_rings = uint( state->m_rings.size() );
+            }
+            return stats;
+        }
+
+        // -----------------------------------------------------------------------------
+
+        AsyncLog::MessageBuffer::MessageBuffer()
+            : m_state( nullptr )
+            , m_ring( nullptr )
+            , m_time( 0 )
+            , m_level( 0 )
+            , m_head( 0 )
+            , m_count( 0 )
+            , m_dropped( false )
+        {
+        }
+
+        AsyncLog::MessageBuffer::~MessageBuffer()
+        {
+            if ( m_state != nullptr )
+            {
+                commit();
+            }
+        }
+
+        bool AsyncLog::MessageBuffer::begin( int level )
+        {
+            CORE_ASSERT( m_state == nullptr, "Message already started." );
+            if ( !isRunning() || t_ring.m_writing )
+            {
+                return false;
+            }
+
+            // Same as StateUse, until commit().
+            g_users.fetch_add( 1 );
+            m_state = g_state.load();
+            if ( m_state == nullptr )
+            {
+                g_users.fetch_sub( 1, std::memory_order_release );
+                return false;
+            }
+
+            m_ring = getThreadRing( m_state );
+            m_time = LogClock::now().time_since_epoch().count();
+            m_level = level;
+            m_head = m_ring->m_head.load( std::memory_order_relaxed );
+            m_count = 0;
+            m_dropped = false;
+            t_ring.m_writing = true;
+
+            // Messages take at least one record, even when empty.
+            nextRecord();
+            return true;
+        }
+
+        void AsyncLog::MessageBuffer::commit()
+        {
+            CORE_ASSERT( m_state != nullptr, "No message started." );
+            closeRecord();
+
+            if ( m_dropped )
+            {
+                m_state->m_dropped.fetch_add( 1, std::memory_order_relaxed );
+            }
+            else
+            {
+                m_ring->m_head.store( m_head + m_count, std::memory_order_release );
+
+                // Do not let the ring fill up while the writer sleeps.
+                const uint64_t tail = m_ring->m_tail.load( std::memory_order_acquire );
+                if ( m_head + m_count - tail > m_ring->m_records.size() / 2 )
+                {
+                    wakeWriter( m_state );
+                }
+            }
+
+            t_ring.m_writing = false;
+            m_state = nullptr;
+            m_ring = nullptr;
+            g_users.fetch_sub( 1, std::memory_order_release );
+        }
+
+        AsyncLog::MessageBuffer::int_type AsyncLog::MessageBuffer::overflow( int_type c )
+        {
+            if ( traits_type::eq_int_type( c, traits_type::eof() ) )
+            {
+                return traits_type::not_eof( c );
+            }
+            // Characters which do not fit are discarded.
+            if ( m_state != nullptr && nextRecord() )
+            {
+                *pptr() = traits_type::to_char_type( c );
+                pbump( 1 );
+            }
+            return c;
+        }
+
+        bool AsyncLog::MessageBuffer::nextRecord()
+        {
+            closeRecord();
+
+            // Very long messages are cut to fit in the ring.
+            const uint64_t capacity = m_ring->m_records.size();
+            if ( m_dropped || m_count == capacity )
+            {
+                return false;
+            }
+
+            // The records of the message are not published yet : the writer frees those before them.
+            uint64_t tail = m_ring->m_tail.load( std::memory_order_acquire );
+            while ( m_head + m_count + 1 - tail > capacity )
+            {
+                if ( m_state->m_params.m_policy == DROP_MESSAGES )
+                {
+                    m_dropped = true;
+                    return false;
+                }
+                wakeWriter( m_state );
+                std::this_thread::yield();
+                tail = m_ring->m_tail.load( std::memory_order_acquire );
+            }
+
+            if ( m_count > 0 )
+            {
+                m_ring->m_records[( m_head + m_count - 1 ) & m_ring->m_mask].m_continued = 1;
+            }
+            Record& r = m_ring->m_records[( m_head + m_count ) & m_ring->m_mask];
+            r.m_time = m_time;
+            r.m_level = m_level;
+            r.m_length = 0;
+            r.m_continued = 0;
+            ++m_count;
+            setp( r.m_text, r.m_text + RECORD_TEXT_SIZE );
+            return true;
+        }
+
+        void AsyncLog::MessageBuffer::closeRecord()
+        {
+            if ( pbase() != nullptr )
+            {
+                m_ring->m_records[( m_head + m_count - 1 ) & m_ring->m_mask].m_length = uint16_t( pptr() - pbase() );
+                setp( nullptr, nullptr );
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef RADIUMENGINE_ASYNCLOG_HPP
+#define RADIUMENGINE_ASYNCLOG_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <cstdint>
+#include <streambuf>
+#include <string>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace AsyncLogInternal
+        {
+            struct Ring;
+            struct State;
+        }
+
+        /// Asynchronous backend of the LOG macro.
+        /// When it is running, each logging thread writes its messages in its own lock-free ring
+        /// of preallocated records, with a raw timestamp. A background thread collects the rings,
+        /// formats the messages and writes them in batches to Output2FILE::Stream(), so the
+        /// logging threads never format dates nor wait for the file.
+        /// Error messages are flushed before the LOG statement returns, and the log is stopped
+        /// (so its pending messages are written) when the program exits, but messages still
+        /// queued when the program aborts or crashes are lost.
+        /// The ring of a thread is released once the thread exited and its messages are written.
+        /// stop() may be called while other threads are logging : it waits for the calls to
+        /// push() and flush() in progress. start() must not be called concurrently with stop().
+        class RA_CORE_API AsyncLog
+        {
+        public:
+            /// What producers do when their ring is full.
+            enum OverflowPolicy
+            {
+                DROP_MESSAGES,  ///< Discard the message (counted in Statistics::m_dropped).
+                BLOCK_PRODUCER, ///< Wait for the writer thread to make room.
+            };
+
+            struct Parameters
+            {
+                /// Number of records in each thread ring, rounded up to a power of two.
+                /// Messages longer than a record take several consecutive records.
+                uint m_ringSize = 1024;
+
+                OverflowPolicy m_policy = BLOCK_PRODUCER;
+
+                /// Maximum delay between a message and its output, in milliseconds.
+                uint m_flushIntervalMs = 5;
+            };
+
+            struct Statistics
+            {
+                uint64_t m_written = 0; ///< Messages written to the stream.
+                uint64_t m_dropped = 0; ///< Messages discarded by the DROP_MESSAGES policy.
+                uint64_t m_batches = 0; ///< Number of writes to the stream.
+                uint m_rings = 0;       ///< Thread rings currently allocated.
+            };
+
+            /// Start the writer thread. Messages logged from now on are asynchronous.
+            static void start( const Parameters& params );
+            static void start();
+
+            /// Write all the pending messages, stop the writer thread and release the rings.
+            static void stop();
+
+            static bool isRunning();
+
+            /// Queue a message (without prefix nor end of line) from the calling thread.
+            /// Returns false if the log is not running.
+            static bool push( int level, const std::string& message );
+
+            /// Block until all the messages queued before the call are written.
+            static void flush();
+
+            /// Counters since the last call to start().
+            static Statistics getStatistics();
+
+            /// Stream buffer formatting a message directly in the records of the calling thread
+            /// ring, used by the LOG macro : there is no intermediate string to copy. The records
+            /// are published at once by commit(), or dropped as a whole if the ring is full with
+            /// DROP_MESSAGES. The log is not stopped until then.
+            class RA_CORE_API MessageBuffer : public std::streambuf
+            {
+            public:
+                MessageBuffer();
+                ~MessageBuffer();
+
+                /// Start a message from the calling thread. Returns false if the log is not
+                /// running, or if the thread is already writing a message (e.g. a LOG statement
+                /// in an operator<< used by another one) : nothing must be written then.
+                bool begin( int level );
+
+                /// Publish the message started by begin().
+                void commit();
+
+            protected:
+                int_type overflow( int_type c ) override;
+
+            private:
+                /// Make the next record of the message the put area. Returns false if the
+                /// message does not fit in the ring, or is dropped.
+                bool nextRecord();
+
+                /// Store the length of the put area in its record.
+                void closeRecord();
+
+                AsyncLogInternal::State* m_state; ///< Null when no message is started.
+                AsyncLogInternal::Ring* m_ring;
+                int64_t m_time;
+                int m_level;
+                uint64_t m_head;  ///< First record of the message.
+                uint64_t m_count; ///< Records of the message.
+                bool m_dropped;
+            };
+        };
+    }
+}
+
+#endif // RADIUMENGINE_ASYNCLOG_HPP
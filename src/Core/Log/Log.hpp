@@ -7,8 +7,12 @@
 #include <stdio.h>
 
 #include <Core/String/StringUtils.hpp>
+#include <Core/Log/AsyncLog.hpp>
+
+#include <ctime>
 
 inline std::string NowTime();
+inline std::string FormatTime( std::time_t t );
 
 enum TLogLevel { logERROR, logWARNING, logINFO, logDEBUG, logDEBUG1, logDEBUG2, logDEBUG3, logDEBUG4 };
 
@@ -18,37 +22,70 @@ class Log
 public:
     Log();
     virtual ~Log();
-    std::ostringstream& Get( TLogLevel level = logINFO );
+    std::ostream& Get( TLogLevel level = logINFO );
 public:
     static TLogLevel& ReportingLevel();
     static std::string ToString( TLogLevel level );
     static TLogLevel FromString( const std::string& level );
 protected:
-    std::ostringstream os;
+    // The message is formatted directly in the records of the asynchronous log when it is
+    // running (see Ra::Core::AsyncLog), and in m_string otherwise.
+    Ra::Core::AsyncLog::MessageBuffer m_asyncBuffer;
+    std::stringbuf m_string;
+    std::ostream os;
+    TLogLevel m_level;
+    bool m_async;
 private:
+    static std::string Prefix( TLogLevel level );
     Log( const Log& );
     Log& operator = ( const Log& );
 };
 
 template <typename T>
 Log<T>::Log()
+    : os( &m_string ), m_level( logINFO ), m_async( false )
 {
 }
 
 template <typename T>
-std::ostringstream& Log<T>::Get( TLogLevel level )
+std::string Log<T>::Prefix( TLogLevel level )
 {
-    os << "- " << NowTime();
-    os << " " << ToString( level ) << ": ";
-    os << std::string( level > logDEBUG ? level - logDEBUG : 0, '\t' );
+    return "- " + NowTime() + " " + ToString( level ) + ": " +
+           std::string( level > logDEBUG ? level - logDEBUG : 0, '\t' );
+}
+
+template <typename T>
+std::ostream& Log<T>::Get( TLogLevel level )
+{
+    m_level = level;
+    // The asynchronous log formats the prefix in its writer thread.
+    m_async = m_asyncBuffer.begin( level );
+    if ( m_async )
+    {
+        os.rdbuf( &m_asyncBuffer );
+    }
+    else
+    {
+        os << Prefix( level );
+    }
     return os;
 }
 
 template <typename T>
 Log<T>::~Log()
 {
+    if ( m_async )
+    {
+        // The log cannot be stopped before the message is published.
+        m_asyncBuffer.commit();
+        if ( m_level == logERROR )
+        {
+            Ra::Core::AsyncLog::flush();
+        }
+        return;
+    }
     os << std::endl;
-    T::Output( os.str() );
+    T::Output( m_string.str() );
 }
 
 template <typename T>
@@ -146,12 +183,14 @@ class FILELog : public Log<Output2FILE> {};
 
 #define LOG(level) FILE_LOG(level)
 
-#include <ctime>
-
 inline std::string NowTime()
+{
+    return FormatTime( std::time( nullptr ) );
+}
+
+inline std::string FormatTime( std::time_t t )
 {
     char buffer[100];
-    std::time_t t = std::time( nullptr );
     ON_ASSERT(int ok =) std::strftime( buffer, 100, "%X", std::localtime( &t ) );
     CORE_ASSERT (ok, "Increase buffer size.");
     std::string result(buffer);
@@ -98,8 +98,7 @@ namespace Ra
             Ra::Core::Spline<2, 3> spline;
             spline.setCtrlPoints(m_points);
 
-            grad = spline.df(u);
-            return spline.f(u);
+            return spline.fdf(u, grad);
         }
 
         /*--------------------------------------------------*/
@@ -132,8 +131,7 @@ namespace Ra
             Ra::Core::Spline<2, 2> spline;
             spline.setCtrlPoints(m_points);
 
-            grad = spline.df(u);
-            return spline.f(u);
+            return spline.fdf(u, grad);
         }
 
 
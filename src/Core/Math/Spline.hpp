@@ -13,8 +13,9 @@ namespace Ra
          * @class Spline
          *
          * @brief Handling spline curves of arbitrary dimensions
-         * @note This class use the efficient blossom algorithm to compute a position on
-         * the curve.
+         * @note This class use the de Boor algorithm to compute a position on the curve :
+         * the knot span is found by binary search and the evaluation runs on the stack,
+         * with a fixed number of points known from K, so it never allocates.
          * @tparam D : dimension of the curve.
          * @tparam K  :order of the curve (min 2)
          */
@@ -53,6 +54,20 @@ namespace Ra
             /// Evaluate speed of the spline
             inline Vector df( Scalar u ) const;
 
+            /// Evaluate position and speed of the spline, sharing the knot span search.
+            inline Vector fdf( Scalar u, Vector& speed ) const;
+
+            /// Evaluate positions of the spline at each parameter of us, and their speeds
+            /// if speeds is not null. Outputs are resized to the size of us.
+            /// Large batches are evaluated in parallel.
+            inline void evaluate( const std::vector<Scalar>& us, Core::VectorArray<Vector>& points,
+                                  Core::VectorArray<Vector>* speeds = nullptr ) const;
+
+            /// Reference evaluation of f() and df() with the blossom recursion, which allocates
+            /// at each level. Kept to validate and benchmark the de Boor evaluation.
+            inline Vector fRecursive( Scalar u ) const;
+            inline Vector dfRecursive( Scalar u ) const;
+
         private:
             // -------------------------------------------------------------------------
             /// @name Class tools
@@ -70,6 +85,19 @@ namespace Ra
             /// Set values of the nodal vector to be open uniform
             inline void setNodeToOpenUniform();
 
+            /// Index of the first control point of the knot span of u, for a spline of order k
+            /// with n control points. Knots are read with the offset off (see eval()).
+            static inline uint findSpan( Scalar u, const std::vector<Scalar>& node, uint k, uint n, int off );
+
+            /// De Boor evaluation of the spline of order Order at u, whose span starts at
+            /// the control point dec. Same arguments as eval().
+            template <uint Order>
+            static inline Vector deBoor( Scalar u,
+                                         const Core::VectorArray<Vector>& points,
+                                         const std::vector<Scalar>& node,
+                                         uint dec,
+                                         int off );
+
             /// Evaluate the equation of a splines using the blossom algorithm
             /// @param u : the curve parameter which range from the values
             /// [node[k-1]; node[point.size()]]
@@ -2,6 +2,8 @@
 
 #include <Core/Math/Math.hpp>
 
+#include <algorithm>
+
 namespace Ra
 {
     namespace Core
@@ -62,13 +64,71 @@ namespace Ra
         inline typename Spline<D, K>::Vector Spline<D, K>::f( Scalar u ) const
         {
             u = Core::Math::clamp( u, Scalar(0), Scalar(1) );
-            return eval( u, m_points, m_node, K );
+            return deBoor<K>( u, m_points, m_node, findSpan( u, m_node, K, m_points.size(), 0 ), 0 );
         }
 
         // -----------------------------------------------------------------------------
 
         template <uint D, uint K>
         inline typename Spline<D, K>::Vector Spline<D, K>::df( Scalar u ) const
+        {
+            u = Core::Math::clamp( u, Scalar(0), Scalar(1) );
+            return deBoor<K - 1>( u, m_vecs, m_node, findSpan( u, m_node, K - 1, m_vecs.size(), 1 ), 1 ) *
+                   Scalar( K - 1 );
+        }
+
+        // -----------------------------------------------------------------------------
+
+        template <uint D, uint K>
+        inline typename Spline<D, K>::Vector Spline<D, K>::fdf( Scalar u, Vector& speed ) const
+        {
+            u = Core::Math::clamp( u, Scalar(0), Scalar(1) );
+            // The span of the derivative (order K-1, knots shifted by one) starts at the same index.
+            const uint dec = findSpan( u, m_node, K, m_points.size(), 0 );
+            speed = deBoor<K - 1>( u, m_vecs, m_node, dec, 1 ) * Scalar( K - 1 );
+            return deBoor<K>( u, m_points, m_node, dec, 0 );
+        }
+
+        // -----------------------------------------------------------------------------
+
+        template <uint D, uint K>
+        inline void Spline<D, K>::evaluate( const std::vector<Scalar>& us, Core::VectorArray<Vector>& points,
+                                            Core::VectorArray<Vector>* speeds ) const
+        {
+            const int size = int( us.size() );
+            points.resize( size );
+            if ( speeds != nullptr )
+            {
+                speeds->resize( size );
+                #pragma omp parallel for if( size > 1024 )
+                for ( int i = 0; i < size; ++i )
+                {
+                    points[i] = fdf( us[i], ( *speeds )[i] );
+                }
+            }
+            else
+            {
+                #pragma omp parallel for if( size > 1024 )
+                for ( int i = 0; i < size; ++i )
+                {
+                    points[i] = f( us[i] );
+                }
+            }
+        }
+
+        // -----------------------------------------------------------------------------
+
+        template <uint D, uint K>
+        inline typename Spline<D, K>::Vector Spline<D, K>::fRecursive( Scalar u ) const
+        {
+            u = Core::Math::clamp( u, Scalar(0), Scalar(1) );
+            return eval( u, m_points, m_node, K );
+        }
+
+        // -----------------------------------------------------------------------------
+
+        template <uint D, uint K>
+        inline typename Spline<D, K>::Vector Spline<D, K>::dfRecursive( Scalar u ) const
         {
             u = Core::Math::clamp( u, Scalar(0), Scalar(1) );
             return eval( u, m_vecs, m_node, K - 1, 1 ) * Scalar( K - 1 );
@@ -143,6 +203,51 @@ namespace Ra
 
         // -----------------------------------------------------------------------------
 
+        template <uint D, uint K>
+        inline uint Spline<D, K>::findSpan( Scalar u, const std::vector<Scalar>& node, uint k, uint n, int off )
+        {
+            CORE_ASSERT( n >= k, "Not enough points" );
+            // First knot of node[k+off..] which is not below u, as the linear search of eval().
+            // Parameters beyond the last knot use the last span.
+            const auto first = node.begin() + ( k + off );
+            const uint dec = uint( std::lower_bound( first, node.end(), u ) - first );
+            return std::min( dec, n - k );
+        }
+
+        // -----------------------------------------------------------------------------
+
+        template <uint D, uint K>
+        template <uint Order>
+        inline typename Spline<D, K>::Vector Spline<D, K>::deBoor(
+            Scalar u,
+            const Core::VectorArray<Vector>& points,
+            const std::vector<Scalar>& node,
+            uint dec, int off )
+        {
+            // Same steps as evalRec(), in place : at each level the points are blended
+            // pairwise and the local knots lose their first and last values.
+            Vector d[Order];
+            for ( uint j = 0; j < Order; ++j )
+            {
+                d[j] = points[dec + j];
+            }
+
+            const Scalar* knots = node.data() + dec + 1 + off;
+            for ( uint k = Order, level = 0; k > 1; --k, ++level )
+            {
+                for ( uint i = 0; i < k - 1; ++i )
+                {
+                    const Scalar n0 = knots[level + i + k - 1];
+                    const Scalar n1 = knots[level + i];
+                    const Scalar inv = Scalar( 1 ) / ( n0 - n1 );
+
+                    d[i] = d[i] * ( ( n0 - u ) * inv ) + d[i + 1] * ( ( u - n1 ) * inv );
+                }
+            }
+            return d[0];
+        }
+
+        // -----------------------------------------------------------------------------
 
         template <uint D, uint K>
         inline typename Spline<D, K>::Vector Spline<D, K>::eval(
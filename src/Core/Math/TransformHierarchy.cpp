@@ -0,0 +1,288 @@
+#include <Core/Math/TransformHierarchy.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace Ra
+{
+    namespace Core
+    {
+        TransformHierarchy::Snapshot::Snapshot( const TransformHierarchy& hierarchy )
+            : m_hierarchy( hierarchy )
+        {
+            // Pin the published buffer, and check it was not replaced meanwhile :
+            // update() does not write a buffer pinned before it is published again.
+            for ( ;; )
+            {
+                m_buffer = m_hierarchy.m_front.load();
+                m_hierarchy.m_readers[m_buffer].fetch_add( 1 );
+                if ( m_hierarchy.m_front.load() == m_buffer )
+                {
+                    break;
+                }
+                m_hierarchy.m_readers[m_buffer].fetch_sub( 1 );
+            }
+        }
+
+        TransformHierarchy::Snapshot::~Snapshot()
+        {
+            m_hierarchy.m_readers[m_buffer].fetch_sub( 1 );
+        }
+
+        TransformHierarchy::TransformHierarchy()
+            : m_levelsChanged( false )
+            , m_front( 0 )
+            , m_size( 0 )
+        {
+            m_bufferEpoch[0] = 0;
+            m_bufferEpoch[1] = 0;
+            m_readers[0] = 0;
+            m_readers[1] = 0;
+        }
+
+        Index TransformHierarchy::addNode( const Index& parent, const Transform& local )
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            CORE_ASSERT( parent.isInvalid() || contains( parent ), "Invalid parent" );
+
+            uint node;
+            if ( !m_free.empty() )
+            {
+                node = m_free.back();
+                m_free.pop_back();
+            }
+            else
+            {
+                node = uint( m_local.size() );
+                m_local.emplace_back();
+                m_parent.push_back( -1 );
+                m_firstChild.push_back( -1 );
+                m_nextSibling.push_back( -1 );
+                m_prevSibling.push_back( -1 );
+                m_used.push_back( false );
+                m_dirty.push_back( false );
+                m_changed.push_back( false );
+            }
+
+            m_local[node] = local;
+            m_parent[node] = parent.isValid() ? parent.getValue() : -1;
+            m_firstChild[node] = -1;
+            linkChild( int( node ), m_parent[node] );
+            m_used[node] = true;
+            m_dirty[node] = true;
+            m_levelsChanged = true;
+            ++m_size;
+            return Index( node );
+        }
+
+        void TransformHierarchy::removeNode( const Index& node )
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            CORE_ASSERT( contains( node ), "Invalid node" );
+
+            const int n = node.getValue();
+            unlinkChild( n );
+            for ( int child = m_firstChild[n]; child >= 0; )
+            {
+                const int next = m_nextSibling[child];
+                m_parent[child] = m_parent[n];
+                linkChild( child, m_parent[n] );
+                m_dirty[child] = true;
+                child = next;
+            }
+
+            m_firstChild[n] = -1;
+            m_used[n] = false;
+            m_dirty[n] = false;
+            m_free.push_back( uint( n ) );
+            m_levelsChanged = true;
+            --m_size;
+        }
+
+        void TransformHierarchy::setParent( const Index& node, const Index& parent )
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            CORE_ASSERT( contains( node ), "Invalid node" );
+            CORE_ASSERT( parent.isInvalid() || contains( parent ), "Invalid parent" );
+#if defined CORE_DEBUG
+            for ( int p = parent.isValid() ? parent.getValue() : -1; p >= 0; p = m_parent[p] )
+            {
+                CORE_ASSERT( p != node.getValue(), "Cycle in the transform hierarchy" );
+            }
+#endif
+
+            unlinkChild( node.getValue() );
+            m_parent[node.getValue()] = parent.isValid() ? parent.getValue() : -1;
+            linkChild( node.getValue(), m_parent[node.getValue()] );
+            m_dirty[node.getValue()] = true;
+            m_levelsChanged = true;
+        }
+
+        void TransformHierarchy::setLocal( const Index& node, const Transform& local )
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            CORE_ASSERT( contains( node ), "Invalid node" );
+            m_local[node.getValue()] = local;
+            m_dirty[node.getValue()] = true;
+        }
+
+        uint TransformHierarchy::update()
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            if ( m_levelsChanged )
+            {
+                updateLevels();
+                m_levelsChanged = false;
+            }
+
+            const uint front = m_front.load();
+            const uint back = 1 - front;
+
+            // Wait for the snapshots of the back buffer, taken before the last update.
+            while ( m_readers[back].load() != 0 )
+            {
+                std::this_thread::yield();
+            }
+
+            const auto& previous = m_world[front];
+            auto& world = m_world[back];
+            world.resize( m_local.size(), Transform::Identity() );
+
+            // Parents are in the previous levels, so the nodes of a level are independent.
+            uint updated = 0;
+            for ( uint l = 0; l + 1 < m_levels.size(); ++l )
+            {
+                const int begin = int( m_levels[l] );
+                const int end = int( m_levels[l + 1] );
+                #pragma omp parallel for if( end - begin > 1024 ) reduction( + : updated )
+                for ( int k = begin; k < end; ++k )
+                {
+                    const uint node = m_order[k];
+                    const int parent = m_parent[node];
+                    const bool dirty = m_dirty[node] || ( parent >= 0 && m_changed[parent] );
+                    m_changed[node] = dirty;
+                    if ( dirty )
+                    {
+                        world[node] = parent >= 0 ? Transform( world[parent] * m_local[node] ) : m_local[node];
+                        m_dirty[node] = false;
+                        ++updated;
+                    }
+                    else
+                    {
+                        world[node] = previous[node];
+                    }
+                }
+            }
+
+            if ( updated > 0 )
+            {
+                m_bufferEpoch[back] = m_bufferEpoch[front] + 1;
+                m_front.store( back );
+            }
+            return updated;
+        }
+
+        Transform TransformHierarchy::getWorld( const Index& node ) const
+        {
+            Snapshot snapshot( *this );
+            return snapshot.getWorld( node );
+        }
+
+        void TransformHierarchy::linkChild( int node, int parent )
+        {
+            m_prevSibling[node] = -1;
+            m_nextSibling[node] = -1;
+            if ( parent < 0 )
+            {
+                return;
+            }
+            const int first = m_firstChild[parent];
+            if ( first >= 0 )
+            {
+                m_prevSibling[first] = node;
+                m_nextSibling[node] = first;
+            }
+            m_firstChild[parent] = node;
+        }
+
+        void TransformHierarchy::unlinkChild( int node )
+        {
+            const int prev = m_prevSibling[node];
+            const int next = m_nextSibling[node];
+            if ( prev >= 0 )
+            {
+                m_nextSibling[prev] = next;
+            }
+            else if ( m_parent[node] >= 0 )
+            {
+                m_firstChild[m_parent[node]] = next;
+            }
+            if ( next >= 0 )
+            {
+                m_prevSibling[next] = prev;
+            }
+            m_prevSibling[node] = -1;
+            m_nextSibling[node] = -1;
+        }
+
+        void TransformHierarchy::updateLevels()
+        {
+            const uint capacity = uint( m_parent.size() );
+            std::vector<int> depth( capacity, -1 );
+            std::vector<uint> stack;
+            uint levelCount = 0;
+            for ( uint i = 0; i < capacity; ++i )
+            {
+                if ( !m_used[i] )
+                {
+                    continue;
+                }
+
+                // Go up until a node of known depth, then set the depth of the path.
+                int n = int( i );
+                while ( n >= 0 && depth[n] < 0 )
+                {
+                    stack.push_back( uint( n ) );
+                    n = m_parent[n];
+                }
+                int d = n >= 0 ? depth[n] : -1;
+                while ( !stack.empty() )
+                {
+                    depth[stack.back()] = ++d;
+                    stack.pop_back();
+                }
+                levelCount = std::max( levelCount, uint( depth[i] ) + 1 );
+            }
+
+            // Counting sort of the nodes by depth.
+            m_levels.assign( levelCount + 1, 0 );
+            for ( uint i = 0; i < capacity; ++i )
+            {
+                if ( m_used[i] )
+                {
+                    ++m_levels[depth[i] + 1];
+                }
+            }
+            for ( uint l = 0; l < levelCount; ++l )
+            {
+                m_levels[l + 1] += m_levels[l];
+            }
+
+            std::vector<uint> next( m_levels.begin(), m_levels.end() - 1 );
+            m_order.resize( m_size );
+            for ( uint i = 0; i < capacity; ++i )
+            {
+                if ( m_used[i] )
+                {
+                    m_order[next[depth[i]]++] = i;
+                }
+            }
+
+            // Nodes which changed of level may have a new parent : recompute everything.
+            for ( uint i = 0; i < capacity; ++i )
+            {
+                m_dirty[i] = m_used[i];
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#ifndef RADIUMENGINE_TRANSFORM_HIERARCHY_HPP_
+#define RADIUMENGINE_TRANSFORM_HIERARCHY_HPP_
+
+#include <Core/RaCore.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Index/Index.hpp>
+#include <Core/Containers/AlignedStdVector.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// A hierarchy of transforms, in which the world transform of each node is the
+        /// world transform of its parent times its local transform.
+        /// Local transforms, parents and dirty flags are stored in arrays indexed by node,
+        /// and update() visits the nodes level by level (parents before children), computing
+        /// the world transforms of each level in parallel.
+        /// World transforms are double buffered : update() writes the buffer which is not
+        /// published, then publishes it with a new epoch. Readers take a Snapshot, which
+        /// pins the published buffer without locking, so that they see the world transforms
+        /// of a single update even if another update is done meanwhile.
+        /// Adding, removing and editing nodes and update() may be called from any thread :
+        /// they are serialized by a lock. Edits are seen by readers after the next update().
+        /// The other accessors (getParent(), getLocal(), contains(), size()) are not locked,
+        /// and must not race with the edits.
+        class RA_CORE_API TransformHierarchy
+        {
+        public:
+            /// Consistent read-only view of the world transforms published by an update.
+            /// Snapshots should be short lived : update() waits until the snapshots
+            /// of the buffer it writes are destroyed.
+            class RA_CORE_API Snapshot
+            {
+            public:
+                explicit Snapshot( const TransformHierarchy& hierarchy );
+                ~Snapshot();
+
+                Snapshot( const Snapshot& ) = delete;
+                Snapshot& operator=( const Snapshot& ) = delete;
+
+                /// World transform of a node. Nodes added after the update of the
+                /// snapshot have the identity transform.
+                inline const Transform& getWorld( const Index& node ) const;
+
+                /// Epoch of the update of the snapshot, 0 before the first update.
+                inline uint64_t getEpoch() const;
+
+            private:
+                const TransformHierarchy& m_hierarchy;
+                uint m_buffer;
+            };
+
+        public:
+            TransformHierarchy();
+
+            TransformHierarchy( const TransformHierarchy& ) = delete;
+            TransformHierarchy& operator=( const TransformHierarchy& ) = delete;
+
+            /// Add a node with the given parent, or a root if parent is invalid.
+            Index addNode( const Index& parent = Index::Invalid(),
+                           const Transform& local = Transform::Identity() );
+
+            /// Remove a node. Its children are attached to its parent.
+            void removeNode( const Index& node );
+
+            /// Change the parent of a node. parent must not be a descendant of node.
+            void setParent( const Index& node, const Index& parent );
+            inline Index getParent( const Index& node ) const;
+
+            void setLocal( const Index& node, const Transform& local );
+            inline const Transform& getLocal( const Index& node ) const;
+
+            inline bool contains( const Index& node ) const;
+
+            /// Number of nodes.
+            inline uint size() const;
+
+            /// Compute the world transforms of the nodes whose local transform or
+            /// one of their ancestors changed, and publish them with a new epoch.
+            /// Returns the number of updated nodes (nothing is published if it is 0).
+            uint update();
+
+            /// Epoch of the last published update.
+            inline uint64_t getEpoch() const;
+
+            /// World transform of a node in the last published update.
+            /// Use a Snapshot to read several consistent transforms.
+            Transform getWorld( const Index& node ) const;
+
+        private:
+            /// Sort the nodes by depth after a change of the hierarchy.
+            void updateLevels();
+
+            /// Add node at the front of the children of parent, if valid.
+            void linkChild( int node, int parent );
+
+            /// Remove node from the children of its parent.
+            void unlinkChild( int node );
+
+        private:
+            // Per node arrays, indexed by node.
+            AlignedStdVector<Transform> m_local;   /// Local transforms.
+            std::vector<int>            m_parent;  /// Parent of each node, -1 for roots.
+            std::vector<int>            m_firstChild;  /// First child of each node, -1 for leaves.
+            std::vector<int>            m_nextSibling; /// Next child of the parent, or -1.
+            std::vector<int>            m_prevSibling; /// Previous child of the parent, or -1.
+            std::vector<uchar>          m_used;    /// True for the nodes in the hierarchy.
+            std::vector<uchar>          m_dirty;   /// True if the local transform or the parent changed.
+            std::vector<uchar>          m_changed; /// True if the world transform changed in the last update.
+            std::vector<uint>           m_free;    /// Removed nodes, reused first.
+
+            // Nodes sorted by depth : nodes of level l are in [m_levels[l], m_levels[l+1]).
+            std::vector<uint> m_order;
+            std::vector<uint> m_levels;
+            bool m_levelsChanged;
+
+            // Double buffered world transforms, indexed by node.
+            AlignedStdVector<Transform> m_world[2];
+            uint64_t m_bufferEpoch[2];
+            std::atomic<uint> m_front;             /// Published buffer.
+            mutable std::atomic<int> m_readers[2]; /// Number of snapshots of each buffer.
+
+            uint m_size;
+
+            /// Serializes the edits and update().
+            std::mutex m_mutex;
+        };
+    }
+}
+
+#include <Core/Math/TransformHierarchy.inl>
+
+#endif // RADIUMENGINE_TRANSFORM_HIERARCHY_HPP_
@@ -0,0 +1,46 @@
+#include <Core/Math/TransformHierarchy.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        inline const Transform& TransformHierarchy::Snapshot::getWorld( const Index& node ) const
+        {
+            static const Transform identity = Transform::Identity();
+            const auto& world = m_hierarchy.m_world[m_buffer];
+            return uint( node.getValue() ) < world.size() ? world[node.getValue()] : identity;
+        }
+
+        inline uint64_t TransformHierarchy::Snapshot::getEpoch() const
+        {
+            return m_hierarchy.m_bufferEpoch[m_buffer];
+        }
+
+        inline Index TransformHierarchy::getParent( const Index& node ) const
+        {
+            CORE_ASSERT( contains( node ), "Invalid node" );
+            return m_parent[node.getValue()] < 0 ? Index::Invalid() : Index( m_parent[node.getValue()] );
+        }
+
+        inline const Transform& TransformHierarchy::getLocal( const Index& node ) const
+        {
+            CORE_ASSERT( contains( node ), "Invalid node" );
+            return m_local[node.getValue()];
+        }
+
+        inline bool TransformHierarchy::contains( const Index& node ) const
+        {
+            return node.isValid() && uint( node.getValue() ) < m_used.size() && m_used[node.getValue()];
+        }
+
+        inline uint TransformHierarchy::size() const
+        {
+            return m_size;
+        }
+
+        inline uint64_t TransformHierarchy::getEpoch() const
+        {
+            return m_bufferEpoch[m_front.load()];
+        }
+    }
+}
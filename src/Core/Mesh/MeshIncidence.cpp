@@ -0,0 +1,182 @@
+#include <Core/Mesh/MeshIncidence.hpp>
+
+#include <algorithm>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            // offsets holds one count per element followed by a free slot : replace the counts
+            // by their exclusive prefix sum, and put the total in the last slot.
+            void countsToOffsets( std::vector<uint>& offsets )
+            {
+                uint sum = 0;
+                for ( uint i = 0; i + 1 < offsets.size(); ++i )
+                {
+                    const uint count = offsets[i];
+                    offsets[i] = sum;
+                    sum += count;
+                }
+                offsets.back() = sum;
+            }
+
+            // Sorted set of the triangles sharing an edge with triangle t, in neighbors.
+            void collectTriangleNeighbors( const MeshIncidence& incidence, uint t, const Triangle& tri,
+                                           std::vector<uint>& neighbors )
+            {
+                neighbors.clear();
+                for ( uint e = 0; e < 3; ++e )
+                {
+                    const uint a = tri[e];
+                    const uint b = tri[( e + 1 ) % 3];
+                    if ( a == b )
+                    {
+                        continue;
+                    }
+                    // Both lists are sorted : merge them.
+                    const MeshIncidence::Range ta = incidence.getVertexTriangles( a );
+                    const MeshIncidence::Range tb = incidence.getVertexTriangles( b );
+                    const uint* ia = ta.begin();
+                    const uint* ib = tb.begin();
+                    while ( ia != ta.end() && ib != tb.end() )
+                    {
+                        if ( *ia < *ib )
+                        {
+                            ++ia;
+                        }
+                        else if ( *ib < *ia )
+                        {
+                            ++ib;
+                        }
+                        else
+                        {
+                            if ( *ia != t )
+                            {
+                                neighbors.push_back( *ia );
+                            }
+                            ++ia;
+                            ++ib;
+                        }
+                    }
+                }
+                std::sort( neighbors.begin(), neighbors.end() );
+                neighbors.erase( std::unique( neighbors.begin(), neighbors.end() ), neighbors.end() );
+            }
+        }
+
+        MeshIncidence::MeshIncidence()
+            : m_vtOffsets( 1, 0 )
+            , m_vvOffsets( 1, 0 )
+            , m_ttOffsets( 1, 0 )
+        {
+        }
+
+        MeshIncidence::MeshIncidence( uint vertexCount, const VectorArray<Triangle>& triangles )
+        {
+            build( vertexCount, triangles );
+        }
+
+        void MeshIncidence::build( uint vertexCount, const VectorArray<Triangle>& triangles )
+        {
+            const int vCount = int( vertexCount );
+            const int tCount = int( triangles.size() );
+
+            // Vertex -> triangles : count, prefix sum, scatter, then sort each (short) list,
+            // since the scatter order depends on the threads.
+            m_vtOffsets.assign( vertexCount + 1, 0 );
+#pragma omp parallel for
+            for ( int t = 0; t < tCount; ++t )
+            {
+                for ( uint i = 0; i < 3; ++i )
+                {
+                    const uint v = triangles[t][i];
+                    CORE_ASSERT( v < vertexCount, "Invalid vertex index in triangle." );
+#pragma omp atomic
+                    ++m_vtOffsets[v];
+                }
+            }
+            countsToOffsets( m_vtOffsets );
+
+            m_vtIndices.resize( m_vtOffsets.back() );
+            std::vector<uint> cursors( m_vtOffsets.begin(), m_vtOffsets.end() - 1 );
+#pragma omp parallel for
+            for ( int t = 0; t < tCount; ++t )
+            {
+                for ( uint i = 0; i < 3; ++i )
+                {
+                    const uint v = triangles[t][i];
+                    uint slot;
+#pragma omp atomic capture
+                    slot = cursors[v]++;
+                    m_vtIndices[slot] = uint( t );
+                }
+            }
+#pragma omp parallel for
+            for ( int v = 0; v < vCount; ++v )
+            {
+                std::sort( m_vtIndices.begin() + m_vtOffsets[v], m_vtIndices.begin() + m_vtOffsets[v + 1] );
+            }
+
+            // Vertex -> vertices : the other vertices of the incident triangles, gathered in a
+            // scratch buffer with two slots per incidence, then sorted, made unique and compacted.
+            std::vector<uint> scratch( 2 * m_vtIndices.size() );
+            m_vvOffsets.assign( vertexCount + 1, 0 );
+#pragma omp parallel for
+            for ( int v = 0; v < vCount; ++v )
+            {
+                const auto begin = scratch.begin() + 2 * m_vtOffsets[v];
+                auto end = begin;
+                for ( uint t : getVertexTriangles( uint( v ) ) )
+                {
+                    for ( uint i = 0; i < 3; ++i )
+                    {
+                        const uint w = triangles[t][i];
+                        // At most two other vertices per incident triangle.
+                        if ( w != uint( v ) )
+                        {
+                            *end++ = w;
+                        }
+                    }
+                }
+                std::sort( begin, end );
+                m_vvOffsets[v] = uint( std::unique( begin, end ) - begin );
+            }
+            countsToOffsets( m_vvOffsets );
+            m_vvIndices.resize( m_vvOffsets.back() );
+#pragma omp parallel for
+            for ( int v = 0; v < vCount; ++v )
+            {
+                const auto begin = scratch.begin() + 2 * m_vtOffsets[v];
+                std::copy( begin, begin + ( m_vvOffsets[v + 1] - m_vvOffsets[v] ), m_vvIndices.begin() + m_vvOffsets[v] );
+            }
+
+            // Triangle -> triangles : intersection of the lists of the vertices of each edge,
+            // computed once to count and once to fill.
+            m_ttOffsets.assign( triangles.size() + 1, 0 );
+#pragma omp parallel
+            {
+                std::vector<uint> neighbors;
+#pragma omp for
+                for ( int t = 0; t < tCount; ++t )
+                {
+                    collectTriangleNeighbors( *this, uint( t ), triangles[t], neighbors );
+                    m_ttOffsets[t] = uint( neighbors.size() );
+                }
+            }
+            countsToOffsets( m_ttOffsets );
+            m_ttIndices.resize( m_ttOffsets.back() );
+#pragma omp parallel
+            {
+                std::vector<uint> neighbors;
+#pragma omp for
+                for ( int t = 0; t < tCount; ++t )
+                {
+                    collectTriangleNeighbors( *this, uint( t ), triangles[t], neighbors );
+                    std::copy( neighbors.begin(), neighbors.end(), m_ttIndices.begin() + m_ttOffsets[t] );
+                }
+            }
+        }
+    }
+}
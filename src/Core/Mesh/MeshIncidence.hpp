@@ -0,0 +1,74 @@
+#ifndef RADIUMENGINE_MESHINCIDENCE_HPP
+#define RADIUMENGINE_MESHINCIDENCE_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Mesh/MeshTypes.hpp>
+
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Incidence relations of the vertices and triangles of a triangle mesh, stored in
+        /// compressed rows (an offset array and one array of indices per relation) :
+        /// - the triangles containing each vertex,
+        /// - the vertices sharing an edge with each vertex,
+        /// - the triangles sharing an edge with each triangle.
+        /// All the lists are sorted by increasing index. The build is parallel, in O(V + T)
+        /// for meshes of bounded valence.
+        /// See TriangleMesh::getIncidence() to get the one of a mesh.
+        class RA_CORE_API MeshIncidence
+        {
+        public:
+            /// Read-only view of a list of indices.
+            class Range
+            {
+            public:
+                inline Range( const uint* begin, const uint* end ) : m_begin( begin ), m_end( end ) {}
+                inline const uint* begin() const { return m_begin; }
+                inline const uint* end() const { return m_end; }
+                inline uint size() const { return uint( m_end - m_begin ); }
+                inline bool empty() const { return m_begin == m_end; }
+                inline uint operator[]( uint i ) const { return m_begin[i]; }
+
+            private:
+                const uint* m_begin;
+                const uint* m_end;
+            };
+
+            /// Create an empty incidence.
+            MeshIncidence();
+
+            /// Build the incidence of vertexCount vertices and the given triangles.
+            MeshIncidence( uint vertexCount, const VectorArray<Triangle>& triangles );
+
+            void build( uint vertexCount, const VectorArray<Triangle>& triangles );
+
+            inline uint getVertexCount() const { return uint( m_vtOffsets.size() ) - 1; }
+            inline uint getTriangleCount() const { return uint( m_ttOffsets.size() ) - 1; }
+
+            /// Triangles containing vertex v.
+            inline Range getVertexTriangles( uint v ) const;
+
+            /// Vertices linked to vertex v by an edge.
+            inline Range getVertexNeighbors( uint v ) const;
+
+            /// Triangles sharing an edge with triangle t.
+            inline Range getTriangleNeighbors( uint t ) const;
+
+        private:
+            std::vector<uint> m_vtOffsets;
+            std::vector<uint> m_vtIndices;
+            std::vector<uint> m_vvOffsets;
+            std::vector<uint> m_vvIndices;
+            std::vector<uint> m_ttOffsets;
+            std::vector<uint> m_ttIndices;
+        };
+    }
+}
+
+#include <Core/Mesh/MeshIncidence.inl>
+
+#endif // RADIUMENGINE_MESHINCIDENCE_HPP
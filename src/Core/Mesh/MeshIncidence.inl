@@ -0,0 +1,25 @@
+#include <Core/Mesh/MeshIncidence.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        inline MeshIncidence::Range MeshIncidence::getVertexTriangles( uint v ) const
+        {
+            CORE_ASSERT( v < getVertexCount(), "Invalid vertex index." );
+            return Range( m_vtIndices.data() + m_vtOffsets[v], m_vtIndices.data() + m_vtOffsets[v + 1] );
+        }
+
+        inline MeshIncidence::Range MeshIncidence::getVertexNeighbors( uint v ) const
+        {
+            CORE_ASSERT( v < getVertexCount(), "Invalid vertex index." );
+            return Range( m_vvIndices.data() + m_vvOffsets[v], m_vvIndices.data() + m_vvOffsets[v + 1] );
+        }
+
+        inline MeshIncidence::Range MeshIncidence::getTriangleNeighbors( uint t ) const
+        {
+            CORE_ASSERT( t < getTriangleCount(), "Invalid triangle index." );
+            return Range( m_ttIndices.data() + m_ttOffsets[t], m_ttIndices.data() + m_ttOffsets[t + 1] );
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Containers/SpatialHash.hpp>
 #include <Core/Math/Math.hpp>
 #include <Core/Math/RayCast.hpp>
 #include <Core/String/StringUtils.hpp>
@@ -41,89 +42,111 @@ namespace Ra
             }
 
 
-            bool findDuplicates( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap )
+            bool findDuplicates( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap, Scalar tolerance )
             {
-                bool hasDuplicates = false;
-                duplicatesMap.clear();
-                const uint numVerts = mesh.m_vertices.size();
-                duplicatesMap.resize( numVerts,VertexIdx(-1) );
-
-                VectorArray<Vector3>::const_iterator vertPos;
-                VectorArray<Vector3>::const_iterator duplicatePos;
-                std::vector<std::pair<Vector3, VertexIdx>> vertices;
-                
-                for ( uint i = 0; i < numVerts; ++i )
+                const int numVerts = int( mesh.m_vertices.size() );
+                std::vector<SpatialHash::Key<3>> keys( mesh.m_vertices.size() );
+
+#pragma omp parallel for
+                for ( int i = 0; i < numVerts; ++i )
                 {
-                    vertices.push_back(std::make_pair(mesh.m_vertices[i], VertexIdx(i)));
+                    keys[i] = SpatialHash::makeKey( mesh.m_vertices[i], tolerance );
                 }
-                
-                std::sort(vertices.begin(), vertices.end(),
-                          [](std::pair<Vector3, int>a , std::pair<Vector3, int>b){
-                              if(a.first.x() == b.first.x())
-                              {
-                                  if(a.first.y() == b.first.y())
-                                      if(a.first.z() == b.first.z())
-                                          return a.second < b.second;
-                                      else
-                                          return a.first.z() < b.first.z();                                         
-                                  else
-                                      return a.first.y() < b.first.y();
-                              }
-                              return a.first.x() < b.first.x();
-                          }
-                    );
-                // Here vertices contains vertex pos and idx, with equal
-                // vertices contiguous, sorted by idx, so checking if current
-                // vertex equals the previous one state if its a duplicated
-                // vertex position.
-                duplicatesMap[vertices[0].second] = vertices[0].second;
-                for ( uint i = 1; i < numVerts; ++i )                    
+
+                // Representatives are the first occurrence of each position.
+                std::vector<uint> representatives;
+                const uint distinct = SpatialHash::findRepresentatives( keys, representatives );
+
+                duplicatesMap.resize( mesh.m_vertices.size() );
+#pragma omp parallel for
+                for ( int i = 0; i < numVerts; ++i )
                 {
-                    if(vertices[i].first == vertices[i-1].first)
-                    {
-                        duplicatesMap[vertices[i].second] = duplicatesMap[vertices[i-1].second];
-                        hasDuplicates = true;
-                    }
-                    else{
-                        duplicatesMap[vertices[i].second] = vertices[i].second;
-                    }
+                    duplicatesMap[i] = VertexIdx( representatives[i] );
                 }
-              
-                return hasDuplicates;
+
+                return distinct < uint( numVerts );
             }
 
-            void removeDuplicates(TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap)
+            void removeDuplicates( TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap, Scalar tolerance )
             {
                 std::vector<VertexIdx> duplicatesMap;
-                findDuplicates(mesh, duplicatesMap);
+                findDuplicates( mesh, duplicatesMap, tolerance );
 
-                std::vector<VertexIdx> newIndices(mesh.m_vertices.size(), VertexIdx(-1));
-                Vector3Array uniqueVertices;
-                for (uint i = 0; i < mesh.m_vertices.size(); i++)
+                const int numVerts = int( mesh.m_vertices.size() );
+                const int numTriangles = int( mesh.m_triangles.size() );
+                const bool hasNormals = mesh.m_normals.size() == mesh.m_vertices.size();
+
+                // Number the kept vertices in index order : count them per block, then
+                // number each block from the sum of the counts of the previous ones.
+                const int blockSize = 1 << 14;
+                const int blockCount = ( numVerts + blockSize - 1 ) / blockSize;
+                std::vector<uint> blockOffsets( blockCount + 1, 0 );
+
+#pragma omp parallel for
+                for ( int b = 0; b < blockCount; ++b )
                 {
-                    if (duplicatesMap[i] == i)
+                    const int end = std::min( numVerts, ( b + 1 ) * blockSize );
+                    uint count = 0;
+                    for ( int i = b * blockSize; i < end; ++i )
                     {
-                        newIndices[i] = uniqueVertices.size();
-                        uniqueVertices.push_back(mesh.m_vertices[i]);
+                        count += ( duplicatesMap[i] == i ) ? 1 : 0;
+                    }
+                    blockOffsets[b + 1] = count;
+                }
+                for ( int b = 0; b < blockCount; ++b )
+                {
+                    blockOffsets[b + 1] += blockOffsets[b];
+                }
 
+                std::vector<uint> newIndices( mesh.m_vertices.size() );
+#pragma omp parallel for
+                for ( int b = 0; b < blockCount; ++b )
+                {
+                    const int end = std::min( numVerts, ( b + 1 ) * blockSize );
+                    uint next = blockOffsets[b];
+                    for ( int i = b * blockSize; i < end; ++i )
+                    {
+                        if ( duplicatesMap[i] == i )
+                        {
+                            newIndices[i] = next++;
+                        }
                     }
                 }
 
-                for (uint i = 0; i < mesh.m_triangles.size(); i++)
+                VectorArray<Vector3> uniqueVertices( blockOffsets[blockCount] );
+                VectorArray<Vector3> uniqueNormals( hasNormals ? blockOffsets[blockCount] : 0 );
+                vertexMap.resize( mesh.m_vertices.size() );
+
+#pragma omp parallel for
+                for ( int i = 0; i < numVerts; ++i )
                 {
-                    for (uint j = 0; j < 3; j++)
+                    const uint newIdx = newIndices[duplicatesMap[i]];
+                    vertexMap[i] = VertexIdx( newIdx );
+                    if ( duplicatesMap[i] == i )
                     {
-                        int oldIdx = mesh.m_triangles[i](j);
-                        int newIdx = newIndices[duplicatesMap[oldIdx]];
-                        mesh.m_triangles[i](j) = newIdx;
+                        uniqueVertices[newIdx] = mesh.m_vertices[i];
+                        if ( hasNormals )
+                        {
+                            uniqueNormals[newIdx] = mesh.m_normals[i];
+                        }
                     }
                 }
 
-                vertexMap.resize(mesh.m_vertices.size());
-                for (uint i = 0; i < mesh.m_vertices.size(); i++)
-                    vertexMap[i] = newIndices[duplicatesMap[i]];
+#pragma omp parallel for
+                for ( int t = 0; t < numTriangles; ++t )
+                {
+                    for ( uint j = 0; j < 3; ++j )
+                    {
+                        mesh.m_triangles[t]( j ) = vertexMap[mesh.m_triangles[t]( j )];
+                    }
+                }
 
-                mesh.m_vertices = uniqueVertices;
+                mesh.m_vertices.swap( uniqueVertices );
+                if ( hasNormals )
+                {
+                    mesh.m_normals.swap( uniqueNormals );
+                }
+                mesh.invalidateTopology();
             }
 
             RayCastResult castRay(const TriangleMesh &mesh, const Ray &ray)
@@ -42,10 +42,19 @@ namespace Ra
             RA_CORE_API void getAutoNormals( TriangleMesh& mesh, VectorArray<Vector3>& normalsOut );
 
             /// Finds the duplicate vertices in a mesh, returning an array indicating for each vertex where to find the
-            /// first occurrence.
-            RA_CORE_API bool findDuplicates( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap );
-
-            RA_CORE_API void removeDuplicates(TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap);
+            /// first occurrence. Returns true if there is any duplicate.
+            /// With a zero tolerance, only vertices with the same position are duplicates. Otherwise positions
+            /// are snapped to a grid of cells of size tolerance, and vertices in the same cell are duplicates
+            /// (see SpatialHash::Key) : close vertices on each side of a cell boundary are not merged.
+            /// Positions are hashed and radix sorted in parallel.
+            RA_CORE_API bool findDuplicates( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap,
+                                             Scalar tolerance = 0 );
+
+            /// Merges the duplicate vertices of a mesh (see findDuplicates()), keeping the first occurrence
+            /// of each one. Vertices keep their relative order, and vertexMap gives the new index of each
+            /// old vertex. Normals are compacted along with the vertices if the mesh has one per vertex.
+            RA_CORE_API void removeDuplicates( TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap,
+                                               Scalar tolerance = 0 );
 
 
             /// Returns a list of edges from a given triangle mesh
@@ -0,0 +1,182 @@
+#include <Core/Mesh/ProgressiveMesh.hpp>
+
+#include <Core/Mesh/MeshUtils.hpp>
+
+#include <algorithm>
+
+namespace Ra
+{
+    namespace Core
+    {
+        ProgressiveMesh::ProgressiveMesh()
+            : m_faceCounts( 1, 0 )
+            , m_level( 0 )
+        {
+        }
+
+        ProgressiveMesh::ProgressiveMesh( const TriangleMesh& mesh )
+            : m_positions( mesh.m_vertices )
+            , m_triangles( mesh.m_triangles )
+            , m_faceActive( mesh.m_triangles.size(), 1 )
+            , m_faceCounts( 1, uint( mesh.m_triangles.size() ) )
+            , m_level( 0 )
+        {
+        }
+
+        void ProgressiveMesh::addCollapse( uint vertex, uint target, const Vector3& newPosition, Scalar error,
+                                           const std::vector<uint>& removedFaces,
+                                           const std::vector<uint>& incidentFaces )
+        {
+            CORE_ASSERT( m_level == getCollapseCount(), "Collapses must be added at the coarsest level" );
+            CORE_ASSERT( vertex != target, "Invalid collapse" );
+
+            Collapse c;
+            c.m_vertex = vertex;
+            c.m_target = target;
+            c.m_vertexPosition = m_positions[vertex];
+            c.m_targetPosition = m_positions[target];
+            c.m_newPosition = newPosition;
+            c.m_error = error;
+
+            c.m_facesBegin = uint( m_removedFaces.size() );
+            m_removedFaces.insert( m_removedFaces.end(), removedFaces.begin(), removedFaces.end() );
+            c.m_facesEnd = uint( m_removedFaces.size() );
+
+            c.m_cornersBegin = uint( m_movedCorners.size() );
+            for ( const uint f : incidentFaces )
+            {
+                const Triangle& t = m_triangles[f];
+                const uint i = ( t[0] == vertex ) ? 0 : ( ( t[1] == vertex ) ? 1 : 2 );
+                CORE_ASSERT( t[i] == vertex, "Face is not incident to the collapsed vertex" );
+                m_movedCorners.push_back( 3 * f + i );
+            }
+            c.m_cornersEnd = uint( m_movedCorners.size() );
+
+            m_collapses.push_back( c );
+            m_faceCounts.push_back( m_faceCounts.back() - uint( removedFaces.size() ) );
+
+            applyCollapse( c );
+            ++m_level;
+        }
+
+        void ProgressiveMesh::setLevel( uint level )
+        {
+            level = std::min( level, getCollapseCount() );
+            if ( level > m_level )
+            {
+                coarsen( level - m_level );
+            }
+            else
+            {
+                refine( m_level - level );
+            }
+        }
+
+        void ProgressiveMesh::setFaceCount( uint faceCount )
+        {
+            // Face counts decrease with the level.
+            auto it = std::lower_bound( m_faceCounts.begin(), m_faceCounts.end(), faceCount,
+                                        []( uint count, uint value ) { return count > value; } );
+            if ( it == m_faceCounts.end() )
+            {
+                --it;
+            }
+            setLevel( uint( it - m_faceCounts.begin() ) );
+        }
+
+        void ProgressiveMesh::coarsen( uint count )
+        {
+            const uint end = std::min( m_level + count, getCollapseCount() );
+            for ( ; m_level < end; ++m_level )
+            {
+                applyCollapse( m_collapses[m_level] );
+            }
+        }
+
+        void ProgressiveMesh::refine( uint count )
+        {
+            const uint end = m_level - std::min( count, m_level );
+            for ( ; m_level > end; --m_level )
+            {
+                undoCollapse( m_collapses[m_level - 1] );
+            }
+        }
+
+        void ProgressiveMesh::getMesh( TriangleMesh& out, std::vector<uint>* vertexMap ) const
+        {
+            out.clear();
+
+            std::vector<int> newIndex( m_positions.size(), -1 );
+            for ( uint f = 0; f < m_triangles.size(); ++f )
+            {
+                if ( m_faceActive[f] )
+                {
+                    for ( uint i = 0; i < 3; ++i )
+                    {
+                        newIndex[m_triangles[f][i]] = 0;
+                    }
+                }
+            }
+
+            if ( vertexMap )
+            {
+                vertexMap->clear();
+            }
+
+            // Keep the vertices in the order of the full resolution mesh.
+            for ( uint v = 0; v < m_positions.size(); ++v )
+            {
+                if ( newIndex[v] == 0 )
+                {
+                    newIndex[v] = int( out.m_vertices.size() );
+                    out.m_vertices.push_back( m_positions[v] );
+                    if ( vertexMap )
+                    {
+                        vertexMap->push_back( v );
+                    }
+                }
+            }
+
+            out.m_triangles.reserve( getFaceCount() );
+            for ( uint f = 0; f < m_triangles.size(); ++f )
+            {
+                if ( m_faceActive[f] )
+                {
+                    const Triangle& t = m_triangles[f];
+                    out.m_triangles.push_back( Triangle( newIndex[t[0]], newIndex[t[1]], newIndex[t[2]] ) );
+                }
+            }
+
+            MeshUtils::getAutoNormals( out, out.m_normals );
+        }
+
+        void ProgressiveMesh::applyCollapse( const Collapse& c )
+        {
+            for ( uint i = c.m_facesBegin; i < c.m_facesEnd; ++i )
+            {
+                m_faceActive[m_removedFaces[i]] = 0;
+            }
+            for ( uint i = c.m_cornersBegin; i < c.m_cornersEnd; ++i )
+            {
+                const uint corner = m_movedCorners[i];
+                m_triangles[corner / 3][corner % 3] = c.m_target;
+            }
+            m_positions[c.m_target] = c.m_newPosition;
+        }
+
+        void ProgressiveMesh::undoCollapse( const Collapse& c )
+        {
+            for ( uint i = c.m_facesBegin; i < c.m_facesEnd; ++i )
+            {
+                m_faceActive[m_removedFaces[i]] = 1;
+            }
+            for ( uint i = c.m_cornersBegin; i < c.m_cornersEnd; ++i )
+            {
+                const uint corner = m_movedCorners[i];
+                m_triangles[corner / 3][corner % 3] = c.m_vertex;
+            }
+            m_positions[c.m_target] = c.m_targetPosition;
+            m_positions[c.m_vertex] = c.m_vertexPosition;
+        }
+    }
+}
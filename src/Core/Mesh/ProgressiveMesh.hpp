@@ -0,0 +1,115 @@
+#ifndef RADIUMENGINE_PROGRESSIVEMESH_HPP
+#define RADIUMENGINE_PROGRESSIVEMESH_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// A progressive mesh (Hoppe 96) : a full resolution mesh and the sequence of
+        /// edge collapses simplifying it, as produced by TMOperations::simplify().
+        /// The mesh can be moved at any level of the sequence at runtime, applying collapses
+        /// to coarsen it or undoing them (vertex splits) to refine it. Each step only touches
+        /// the faces around the collapsed edge.
+        /// Vertex and face indices are the ones of the full resolution mesh.
+        class RA_CORE_API ProgressiveMesh
+        {
+        public:
+            RA_CORE_ALIGNED_NEW
+
+            /// Record of the collapse of m_vertex into m_target.
+            struct Collapse
+            {
+                uint m_vertex;            ///< Vertex removed by the collapse.
+                uint m_target;            ///< Vertex m_vertex is merged into.
+                Vector3 m_vertexPosition; ///< Position of m_vertex before the collapse.
+                Vector3 m_targetPosition; ///< Position of m_target before the collapse.
+                Vector3 m_newPosition;    ///< Position of m_target after the collapse.
+                Scalar m_error;           ///< Quadric error of the collapse.
+                uint m_facesBegin;        ///< Range of the faces removed in getRemovedFaces().
+                uint m_facesEnd;
+                uint m_cornersBegin;      ///< Range of the corners (3 * face + i) moved from m_vertex
+                uint m_cornersEnd;        ///< to m_target in getMovedCorners().
+            };
+
+            /// Create an empty progressive mesh.
+            ProgressiveMesh();
+
+            /// Start a progressive mesh at the full resolution mesh.
+            explicit ProgressiveMesh( const TriangleMesh& mesh );
+
+            /// Record the collapse of vertex into target, moving it to newPosition, and apply it.
+            /// removedFaces are the faces of the collapsed edge, incidentFaces the other faces
+            /// around vertex. The mesh must be at its coarsest level.
+            void addCollapse( uint vertex, uint target, const Vector3& newPosition, Scalar error,
+                              const std::vector<uint>& removedFaces, const std::vector<uint>& incidentFaces );
+
+            /// Number of recorded collapses.
+            inline uint getCollapseCount() const { return uint( m_collapses.size() ); }
+
+            /// Number of collapses currently applied : 0 is the full resolution mesh,
+            /// getCollapseCount() the coarsest one.
+            inline uint getLevel() const { return m_level; }
+
+            /// Apply or undo collapses to reach the given level.
+            void setLevel( uint level );
+
+            /// Move to the finest level with at most faceCount faces (or the coarsest level).
+            void setFaceCount( uint faceCount );
+
+            /// Apply the next count collapses.
+            void coarsen( uint count = 1 );
+
+            /// Undo the last count collapses.
+            void refine( uint count = 1 );
+
+            /// Number of faces of the mesh at the current level.
+            inline uint getFaceCount() const { return m_faceCounts[m_level]; }
+
+            /// Number of faces of the mesh at a given level.
+            inline uint getFaceCount( uint level ) const { return m_faceCounts[level]; }
+
+            /// Number of vertices not removed by the collapses applied at the current level.
+            inline uint getVertexCount() const { return uint( m_positions.size() ) - m_level; }
+
+            /// Extract the mesh at the current level, with unused vertices removed and normals
+            /// recomputed. If vertexMap is not null, it is filled with the index of each
+            /// output vertex in the full resolution mesh.
+            void getMesh( TriangleMesh& out, std::vector<uint>* vertexMap = nullptr ) const;
+
+            /// Current state, indexed as the full resolution mesh.
+            inline const VectorArray<Vector3>& getPositions() const { return m_positions; }
+            inline const VectorArray<Triangle>& getTriangles() const { return m_triangles; }
+            inline bool isFaceActive( uint face ) const { return m_faceActive[face] != 0; }
+
+            inline const AlignedStdVector<Collapse>& getCollapses() const { return m_collapses; }
+            inline const std::vector<uint>& getRemovedFaces() const { return m_removedFaces; }
+            inline const std::vector<uint>& getMovedCorners() const { return m_movedCorners; }
+
+        private:
+            void applyCollapse( const Collapse& c );
+            void undoCollapse( const Collapse& c );
+
+        private:
+            VectorArray<Vector3> m_positions;
+            VectorArray<Triangle> m_triangles;
+            std::vector<char> m_faceActive;
+
+            AlignedStdVector<Collapse> m_collapses;
+            std::vector<uint> m_removedFaces;
+            std::vector<uint> m_movedCorners;
+
+            /// Face count at each level.
+            std::vector<uint> m_faceCounts;
+            uint m_level;
+        };
+    }
+}
+
+#endif // RADIUMENGINE_PROGRESSIVEMESH_HPP
@@ -0,0 +1,565 @@
+#include <Core/Mesh/TopologicalTriMesh/Operations/Simplification.hpp>
+
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Containers/RadixSort.hpp>
+#include <Core/Log/Log.hpp>
+#include <Core/Math/Quadric.hpp>
+#include <Core/Mesh/TopologicalTriMesh/TopologicalMesh.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <thread>
+
+namespace Ra {
+namespace Core {
+namespace TMOperations {
+
+    namespace
+    {
+        typedef Quadric<3> Quadric3;
+        typedef AlignedStdVector<Quadric3> QuadricArray;
+
+        // Partitions smaller than this are not worth simplifying separately.
+        const uint MIN_PARTITION_FACES = 10000;
+
+        // Collapses found by the simplification of a set of faces, in order.
+        struct CollapseRecord
+        {
+            uint m_vertex;
+            uint m_target;
+            Vector3 m_position;
+            Scalar m_error;
+            uint m_removedBegin;
+            uint m_removedEnd;
+            uint m_incidentBegin;
+            uint m_incidentEnd;
+        };
+
+        struct CollapseRecords
+        {
+            std::vector<CollapseRecord> m_collapses;
+            std::vector<uint> m_removedFaces;
+            std::vector<uint> m_incidentFaces;
+        };
+
+        struct EdgeCandidate
+        {
+            Scalar m_cost;
+            uint m_edge;
+            uint m_stamp;
+
+            bool operator>( const EdgeCandidate& other ) const { return m_cost > other.m_cost; }
+        };
+
+        inline Scalar quadricError( const Quadric3& q, const Vector3& x )
+        {
+            return x.dot( q.getA() * x ) + 2 * q.getB().dot( x ) + Scalar( q.getC() );
+        }
+
+        // Position minimizing the quadric, falling back to the best of the edge end points
+        // and middle when the quadric is degenerate. Returns the error at this position.
+        Scalar optimalPosition( const Quadric3& q, const Vector3& a, const Vector3& b, Vector3& x )
+        {
+            const Matrix3& A = q.getA();
+            const Scalar trace = A.trace();
+
+            x = a;
+            Scalar best = quadricError( q, a );
+
+            const Vector3 candidates[2] = { b, ( a + b ) / 2 };
+            for ( const Vector3& c : candidates )
+            {
+                const Scalar error = quadricError( q, c );
+                if ( error < best )
+                {
+                    best = error;
+                    x = c;
+                }
+            }
+
+            if ( trace > 0 && std::abs( A.determinant() ) > Scalar( 1e-6 ) * trace * trace * trace )
+            {
+                const Vector3 c = -( A.inverse() * q.getB() );
+                const Scalar error = quadricError( q, c );
+                if ( error < best )
+                {
+                    best = error;
+                    x = c;
+                }
+            }
+
+            return std::max( best, Scalar( 0 ) );
+        }
+
+        // Area weighted quadrics of the face planes, plus planes orthogonal to the faces along
+        // boundary edges.
+        void computeQuadrics( const TriangleMesh& mesh, const SimplificationParameters& params,
+                              QuadricArray& quadrics )
+        {
+            const int numFaces = int( mesh.m_triangles.size() );
+            QuadricArray faceQuadrics( mesh.m_triangles.size() );
+            VectorArray<Vector3> faceNormals( mesh.m_triangles.size() );
+
+#pragma omp parallel for
+            for ( int f = 0; f < numFaces; ++f )
+            {
+                const Triangle& t = mesh.m_triangles[f];
+                const Vector3& p0 = mesh.m_vertices[t[0]];
+                Vector3 n = ( mesh.m_vertices[t[1]] - p0 ).cross( mesh.m_vertices[t[2]] - p0 );
+                const Scalar doubleArea = n.norm();
+                if ( doubleArea > 0 )
+                {
+                    n /= doubleArea;
+                    faceQuadrics[f] = Quadric3( n, -n.dot( p0 ) );
+                    faceQuadrics[f] *= doubleArea / 2;
+                }
+                faceNormals[f] = n;
+            }
+
+            quadrics.clear();
+            quadrics.resize( mesh.m_vertices.size() );
+            for ( int f = 0; f < numFaces; ++f )
+            {
+                for ( uint i = 0; i < 3; ++i )
+                {
+                    quadrics[mesh.m_triangles[f][i]] += faceQuadrics[f];
+                }
+            }
+
+            // Boundary edges are used by a single face : group the corners by edge.
+            std::vector<uint64_t> edges( 3 * mesh.m_triangles.size() );
+            std::vector<uint> corners( edges.size() );
+
+#pragma omp parallel for
+            for ( int f = 0; f < numFaces; ++f )
+            {
+                const Triangle& t = mesh.m_triangles[f];
+                for ( uint i = 0; i < 3; ++i )
+                {
+                    const uint64_t a = t[i];
+                    const uint64_t b = t[( i + 1 ) % 3];
+                    edges[3 * f + i] = ( std::min( a, b ) << 32 ) | std::max( a, b );
+                    corners[3 * f + i] = 3 * f + i;
+                }
+            }
+
+            radixSort( edges, corners );
+
+            for ( std::size_t i = 0; i < edges.size(); ++i )
+            {
+                if ( ( i > 0 && edges[i - 1] == edges[i] ) || ( i + 1 < edges.size() && edges[i + 1] == edges[i] ) )
+                {
+                    continue;
+                }
+
+                const uint f = corners[i] / 3;
+                const uint a = mesh.m_triangles[f][corners[i] % 3];
+                const uint b = mesh.m_triangles[f][( corners[i] + 1 ) % 3];
+                const Vector3& pa = mesh.m_vertices[a];
+                const Vector3 e = mesh.m_vertices[b] - pa;
+
+                Vector3 n = e.cross( faceNormals[f] );
+                const Scalar norm = n.norm();
+                if ( norm > 0 )
+                {
+                    n /= norm;
+                    Quadric3 q( n, -n.dot( pa ) );
+                    q *= params.m_boundaryWeight * e.squaredNorm();
+                    quadrics[a] += q;
+                    quadrics[b] += q;
+                }
+            }
+        }
+
+        // True if moving the end points of the edge of heh to x flips or degenerates one of
+        // the faces which are not removed by the collapse.
+        bool flipsFaces( TopologicalMesh& mesh, const VectorArray<Vector3>& positions,
+                         TopologicalMesh::HalfedgeHandle heh, const Vector3& x, Scalar minNormalDot )
+        {
+            const TopologicalMesh::VertexHandle from = mesh.from_vertex_handle( heh );
+            const TopologicalMesh::VertexHandle to = mesh.to_vertex_handle( heh );
+            const TopologicalMesh::FaceHandle left = mesh.face_handle( heh );
+            const TopologicalMesh::FaceHandle right = mesh.face_handle( mesh.opposite_halfedge_handle( heh ) );
+
+            for ( const TopologicalMesh::VertexHandle vh : { from, to } )
+            {
+                for ( TopologicalMesh::VertexFaceIter vf_it = mesh.vf_iter( vh ); vf_it.is_valid(); ++vf_it )
+                {
+                    const TopologicalMesh::FaceHandle fh = *vf_it;
+                    if ( fh == left || fh == right )
+                    {
+                        continue;
+                    }
+
+                    Vector3 p[3];
+                    Vector3 q[3];
+                    int i = 0;
+                    for ( TopologicalMesh::FaceVertexIter fv_it = mesh.fv_iter( fh ); fv_it.is_valid() && i < 3; ++fv_it, ++i )
+                    {
+                        const TopologicalMesh::VertexHandle v = *fv_it;
+                        p[i] = positions[v.idx()];
+                        q[i] = ( v == from || v == to ) ? x : p[i];
+                    }
+
+                    const Vector3 n0 = ( p[1] - p[0] ).cross( p[2] - p[0] );
+                    const Vector3 n1 = ( q[1] - q[0] ).cross( q[2] - q[0] );
+                    const Scalar norm0 = n0.norm();
+                    const Scalar norm1 = n1.norm();
+                    // Already degenerate faces have no orientation to preserve.
+                    if ( norm0 > 0 && ( !( norm1 > 0 ) || n0.dot( n1 ) < minNormalDot * norm0 * norm1 ) )
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // Simplify the given faces of the current level of pm until they are at most
+        // targetFaceCount, without collapsing edges with a locked vertex.
+        // The quadrics of the vertices which are not locked are updated.
+        void simplifyFaces( const ProgressiveMesh& pm, const std::vector<uint>& faces,
+                            const std::vector<char>& locked, QuadricArray& quadrics,
+                            uint targetFaceCount, const SimplificationParameters& params,
+                            CollapseRecords& records )
+        {
+            const VectorArray<Triangle>& triangles = pm.getTriangles();
+
+            // Local numbering of the vertices.
+            std::vector<uint> vertices;
+            vertices.reserve( 3 * faces.size() );
+            for ( const uint f : faces )
+            {
+                vertices.push_back( triangles[f][0] );
+                vertices.push_back( triangles[f][1] );
+                vertices.push_back( triangles[f][2] );
+            }
+            std::sort( vertices.begin(), vertices.end() );
+            vertices.erase( std::unique( vertices.begin(), vertices.end() ), vertices.end() );
+
+            const auto localIndex = [&vertices]( uint v ) {
+                return uint( std::lower_bound( vertices.begin(), vertices.end(), v ) - vertices.begin() );
+            };
+
+            TopologicalMesh mesh;
+            mesh.reserve( vertices.size(), vertices.size() + faces.size(), faces.size() );
+
+            VectorArray<Vector3> positions( vertices.size() );
+            QuadricArray localQuadrics( vertices.size() );
+            std::vector<char> localLocked( vertices.size() );
+            std::vector<TopologicalMesh::VertexHandle> handles( vertices.size() );
+
+            for ( uint v = 0; v < vertices.size(); ++v )
+            {
+                const Vector3& p = pm.getPositions()[vertices[v]];
+                positions[v] = p;
+                localQuadrics[v] = quadrics[vertices[v]];
+                localLocked[v] = locked[vertices[v]];
+                handles[v] = mesh.add_vertex( TopologicalMesh::Point( p[0], p[1], p[2] ) );
+            }
+
+            // Faces OpenMesh can not represent (non manifold) are kept as they are.
+            std::vector<uint> faceIndices;
+            faceIndices.reserve( faces.size() );
+            for ( const uint f : faces )
+            {
+                const uint a = localIndex( triangles[f][0] );
+                const uint b = localIndex( triangles[f][1] );
+                const uint c = localIndex( triangles[f][2] );
+                const TopologicalMesh::FaceHandle fh = mesh.add_face( handles[a], handles[b], handles[c] );
+                if ( fh.is_valid() )
+                {
+                    CORE_ASSERT( uint( fh.idx() ) == faceIndices.size(), "Unexpected face numbering" );
+                    faceIndices.push_back( f );
+                }
+                else
+                {
+                    localLocked[a] = localLocked[b] = localLocked[c] = 1;
+                }
+            }
+
+            // Collapse queue. Edges are updated by pushing them again with a new stamp.
+            std::priority_queue<EdgeCandidate, std::vector<EdgeCandidate>, std::greater<EdgeCandidate>> queue;
+            std::vector<uint> stamps( mesh.n_edges(), 0 );
+            VectorArray<Vector3> edgePositions( mesh.n_edges() );
+
+            const auto evaluate = [&]( TopologicalMesh::EdgeHandle eh ) {
+                const uint e = eh.idx();
+                ++stamps[e];
+
+                const TopologicalMesh::HalfedgeHandle heh = mesh.halfedge_handle( eh, 0 );
+                const uint a = mesh.from_vertex_handle( heh ).idx();
+                const uint b = mesh.to_vertex_handle( heh ).idx();
+                if ( localLocked[a] || localLocked[b] )
+                {
+                    return;
+                }
+
+                const Scalar cost = optimalPosition( localQuadrics[a] + localQuadrics[b],
+                                                     positions[a], positions[b], edgePositions[e] );
+                queue.push( EdgeCandidate{ cost, e, stamps[e] } );
+            };
+
+            for ( TopologicalMesh::EdgeIter e_it = mesh.edges_begin(); e_it != mesh.edges_end(); ++e_it )
+            {
+                evaluate( *e_it );
+            }
+
+            uint faceCount = uint( faces.size() );
+            while ( faceCount > targetFaceCount && !queue.empty() )
+            {
+                const EdgeCandidate candidate = queue.top();
+                queue.pop();
+
+                const TopologicalMesh::EdgeHandle eh = mesh.edge_handle( candidate.m_edge );
+                if ( candidate.m_stamp != stamps[candidate.m_edge] || mesh.status( eh ).deleted() )
+                {
+                    continue;
+                }
+                if ( candidate.m_cost > params.m_maxError )
+                {
+                    break;
+                }
+
+                // Try both directions. An edge which can not be collapsed is evaluated again
+                // when its neighborhood changes.
+                const Vector3& x = edgePositions[candidate.m_edge];
+                TopologicalMesh::HalfedgeHandle heh = mesh.halfedge_handle( eh, 0 );
+                if ( !mesh.is_collapse_ok( heh ) || flipsFaces( mesh, positions, heh, x, params.m_minNormalDot ) )
+                {
+                    heh = mesh.halfedge_handle( eh, 1 );
+                    if ( !mesh.is_collapse_ok( heh ) || flipsFaces( mesh, positions, heh, x, params.m_minNormalDot ) )
+                    {
+                        continue;
+                    }
+                }
+
+                const TopologicalMesh::VertexHandle from = mesh.from_vertex_handle( heh );
+                const TopologicalMesh::VertexHandle to = mesh.to_vertex_handle( heh );
+                const TopologicalMesh::FaceHandle left = mesh.face_handle( heh );
+                const TopologicalMesh::FaceHandle right = mesh.face_handle( mesh.opposite_halfedge_handle( heh ) );
+
+                CollapseRecord record;
+                record.m_vertex = vertices[from.idx()];
+                record.m_target = vertices[to.idx()];
+                record.m_position = x;
+                record.m_error = candidate.m_cost;
+
+                record.m_removedBegin = uint( records.m_removedFaces.size() );
+                for ( const TopologicalMesh::FaceHandle fh : { left, right } )
+                {
+                    if ( fh.is_valid() )
+                    {
+                        records.m_removedFaces.push_back( faceIndices[fh.idx()] );
+                    }
+                }
+                record.m_removedEnd = uint( records.m_removedFaces.size() );
+
+                record.m_incidentBegin = uint( records.m_incidentFaces.size() );
+                for ( TopologicalMesh::VertexFaceIter vf_it = mesh.vf_iter( from ); vf_it.is_valid(); ++vf_it )
+                {
+                    if ( *vf_it != left && *vf_it != right )
+                    {
+                        records.m_incidentFaces.push_back( faceIndices[( *vf_it ).idx()] );
+                    }
+                }
+                record.m_incidentEnd = uint( records.m_incidentFaces.size() );
+
+                records.m_collapses.push_back( record );
+                faceCount -= record.m_removedEnd - record.m_removedBegin;
+
+                mesh.collapse( heh );
+                positions[to.idx()] = x;
+                localQuadrics[to.idx()] += localQuadrics[from.idx()];
+
+                for ( TopologicalMesh::VertexEdgeIter ve_it = mesh.ve_iter( to ); ve_it.is_valid(); ++ve_it )
+                {
+                    evaluate( *ve_it );
+                }
+            }
+
+            for ( uint v = 0; v < vertices.size(); ++v )
+            {
+                if ( !localLocked[v] )
+                {
+                    quadrics[vertices[v]] = localQuadrics[v];
+                }
+            }
+        }
+
+        void addRecord( const CollapseRecords& records, const CollapseRecord& r, ProgressiveMesh& pm,
+                        std::vector<uint>& removed, std::vector<uint>& incident )
+        {
+            removed.assign( records.m_removedFaces.begin() + r.m_removedBegin,
+                            records.m_removedFaces.begin() + r.m_removedEnd );
+            incident.assign( records.m_incidentFaces.begin() + r.m_incidentBegin,
+                             records.m_incidentFaces.begin() + r.m_incidentEnd );
+            pm.addCollapse( r.m_vertex, r.m_target, r.m_position, r.m_error, removed, incident );
+        }
+
+        // Merge the collapses of independent partitions by increasing error, keeping the order
+        // of the collapses of each partition.
+        void mergeRecords( const std::vector<CollapseRecords>& records, ProgressiveMesh& pm )
+        {
+            typedef std::pair<Scalar, uint> Head;
+            std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+            std::vector<uint> next( records.size(), 0 );
+
+            for ( uint p = 0; p < records.size(); ++p )
+            {
+                if ( !records[p].m_collapses.empty() )
+                {
+                    heads.push( Head( records[p].m_collapses[0].m_error, p ) );
+                }
+            }
+
+            std::vector<uint> removed;
+            std::vector<uint> incident;
+            while ( !heads.empty() )
+            {
+                const uint p = heads.top().second;
+                heads.pop();
+
+                addRecord( records[p], records[p].m_collapses[next[p]], pm, removed, incident );
+                if ( ++next[p] < records[p].m_collapses.size() )
+                {
+                    heads.push( Head( records[p].m_collapses[next[p]].m_error, p ) );
+                }
+            }
+        }
+    }
+
+    void simplify( const TriangleMesh& mesh, ProgressiveMesh& out, const SimplificationParameters& params )
+    {
+        out = ProgressiveMesh( mesh );
+
+        const uint numFaces = uint( mesh.m_triangles.size() );
+        const uint numVertices = uint( mesh.m_vertices.size() );
+
+        QuadricArray quadrics;
+        computeQuadrics( mesh, params, quadrics );
+
+        uint partitionCount = params.m_partitionCount;
+        if ( partitionCount == 0 )
+        {
+            partitionCount = std::max( 1u, std::thread::hardware_concurrency() );
+        }
+        partitionCount = std::min( partitionCount, std::max( 1u, numFaces / MIN_PARTITION_FACES ) );
+
+        if ( partitionCount > 1 )
+        {
+            // Split the faces in slabs along the largest axis of the mesh.
+            Aabb aabb;
+            for ( const auto& v : mesh.m_vertices )
+            {
+                aabb.extend( v );
+            }
+            int axis;
+            aabb.sizes().maxCoeff( &axis );
+
+            std::vector<Scalar> centers( numFaces );
+#pragma omp parallel for
+            for ( int f = 0; f < int( numFaces ); ++f )
+            {
+                const Triangle& t = mesh.m_triangles[f];
+                centers[f] = mesh.m_vertices[t[0]][axis] + mesh.m_vertices[t[1]][axis] + mesh.m_vertices[t[2]][axis];
+            }
+
+            std::vector<uint> order( numFaces );
+            std::iota( order.begin(), order.end(), 0 );
+            std::sort( order.begin(), order.end(), [&centers]( uint a, uint b ) { return centers[a] < centers[b]; } );
+
+            std::vector<std::vector<uint>> partitions( partitionCount );
+            std::vector<uint> facePartition( numFaces );
+            for ( uint p = 0; p < partitionCount; ++p )
+            {
+                const uint begin = uint( uint64_t( numFaces ) * p / partitionCount );
+                const uint end = uint( uint64_t( numFaces ) * ( p + 1 ) / partitionCount );
+                partitions[p].assign( order.begin() + begin, order.begin() + end );
+                for ( uint i = begin; i < end; ++i )
+                {
+                    facePartition[order[i]] = p;
+                }
+            }
+
+            // Vertices shared by several partitions are locked.
+            std::vector<int> vertexPartition( numVertices, -1 );
+            std::vector<char> locked( numVertices, 0 );
+            for ( uint f = 0; f < numFaces; ++f )
+            {
+                for ( uint i = 0; i < 3; ++i )
+                {
+                    const uint v = mesh.m_triangles[f][i];
+                    if ( vertexPartition[v] < 0 )
+                    {
+                        vertexPartition[v] = int( facePartition[f] );
+                    }
+                    else if ( vertexPartition[v] != int( facePartition[f] ) )
+                    {
+                        locked[v] = 1;
+                    }
+                }
+            }
+
+            std::vector<CollapseRecords> records( partitionCount );
+
+#pragma omp parallel for schedule( dynamic, 1 )
+            for ( int p = 0; p < int( partitionCount ); ++p )
+            {
+                const uint target = uint( uint64_t( params.m_targetFaceCount ) * partitions[p].size() / numFaces );
+                simplifyFaces( out, partitions[p], locked, quadrics, target, params, records[p] );
+            }
+
+            mergeRecords( records, out );
+        }
+
+        // Simplify the whole mesh, including the vertices on the partitions boundaries.
+        if ( out.getFaceCount() > params.m_targetFaceCount )
+        {
+            std::vector<uint> faces;
+            faces.reserve( out.getFaceCount() );
+            for ( uint f = 0; f < numFaces; ++f )
+            {
+                if ( out.isFaceActive( f ) )
+                {
+                    faces.push_back( f );
+                }
+            }
+
+            CollapseRecords records;
+            const std::vector<char> locked( numVertices, 0 );
+            simplifyFaces( out, faces, locked, quadrics, params.m_targetFaceCount, params, records );
+
+            std::vector<uint> removed;
+            std::vector<uint> incident;
+            for ( const CollapseRecord& r : records.m_collapses )
+            {
+                addRecord( records, r, out, removed, incident );
+            }
+        }
+    }
+
+    void makeLods( const TriangleMesh& mesh, const std::vector<uint>& faceCounts,
+                   std::vector<TriangleMesh>& lods, ProgressiveMesh* pm, SimplificationParameters params )
+    {
+        if ( !faceCounts.empty() )
+        {
+            params.m_targetFaceCount = *std::min_element( faceCounts.begin(), faceCounts.end() );
+        }
+
+        ProgressiveMesh localPm;
+        ProgressiveMesh& progressiveMesh = pm ? *pm : localPm;
+        simplify( mesh, progressiveMesh, params );
+
+        lods.resize( faceCounts.size() );
+        for ( uint i = 0; i < faceCounts.size(); ++i )
+        {
+            progressiveMesh.setFaceCount( faceCounts[i] );
+            progressiveMesh.getMesh( lods[i] );
+        }
+    }
+}
+}
+}
@@ -0,0 +1,55 @@
+#ifndef SIMPLIFICATION_H
+#define SIMPLIFICATION_H
+
+#include <Core/RaCore.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Mesh/ProgressiveMesh.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace TMOperations {
+
+    /// Parameters of the quadric error metric simplification.
+    struct SimplificationParameters
+    {
+        /// Stop when the mesh has at most this number of faces.
+        uint m_targetFaceCount = 0;
+
+        /// Stop when the cheapest collapse has a larger error.
+        Scalar m_maxError = std::numeric_limits<Scalar>::max();
+
+        /// Number of partitions simplified in parallel before the whole mesh is simplified.
+        /// 0 uses one partition per hardware thread, 1 disables the parallel step.
+        uint m_partitionCount = 0;
+
+        /// Weight of the planes orthogonal to boundary edges, which keep boundaries in place.
+        Scalar m_boundaryWeight = 1000;
+
+        /// Collapses rotating a face normal by more than acos(m_minNormalDot) are rejected.
+        Scalar m_minNormalDot = 0.2;
+    };
+
+    /// Simplify mesh by quadric error metric edge collapses (Garland & Heckbert 97),
+    /// recording the collapses in out, which is left at its coarsest level.
+    /// The collapses are ordered by error with a heap, and collapsed vertices are moved to the
+    /// position minimizing the sum of the quadrics of the planes of their faces.
+    /// The faces are first split in slabs simplified in parallel, vertices shared by slabs
+    /// being locked. The whole mesh is then simplified up to the target.
+    /// mesh must have shared vertices (see MeshConverter or MeshUtils::removeDuplicates).
+    RA_CORE_API void simplify( const TriangleMesh& mesh, ProgressiveMesh& out,
+                               const SimplificationParameters& params = SimplificationParameters() );
+
+    /// Build levels of details of mesh at the given face counts, from a single simplification.
+    /// lods[i] has at most faceCounts[i] faces, unless the simplification stopped earlier.
+    /// If pm is not null, it is filled with the progressive mesh used to extract the levels.
+    RA_CORE_API void makeLods( const TriangleMesh& mesh, const std::vector<uint>& faceCounts,
+                               std::vector<TriangleMesh>& lods, ProgressiveMesh* pm = nullptr,
+                               SimplificationParameters params = SimplificationParameters() );
+}
+}
+}
+
+#endif // SIMPLIFICATION_H
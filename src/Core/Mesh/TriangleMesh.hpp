@@ -5,6 +5,9 @@
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Containers/VectorArray.hpp>
 #include <Core/Mesh/MeshTypes.hpp>
+#include <Core/Mesh/MeshIncidence.hpp>
+
+#include <memory>
 
 namespace Ra
 {
@@ -19,6 +22,9 @@ namespace Ra
             /// Copy constructor and assignment operator
             TriangleMesh( const TriangleMesh& ) = default;
             TriangleMesh& operator= ( const TriangleMesh& ) = default;
+            /// Move constructor and assignment operator
+            TriangleMesh( TriangleMesh&& ) = default;
+            TriangleMesh& operator= ( TriangleMesh&& ) = default;
 
             /// Erases all data, making the mesh empty.
             inline void clear();
@@ -26,10 +32,23 @@ namespace Ra
             /// Appends another mesh to this one.
             inline void append( const TriangleMesh& other );
 
+            /// Incidence of the vertices and triangles, built on the first call after a change
+            /// of topology. Copies of the mesh share it until their topology changes.
+            /// The returned pointer keeps it alive even if the mesh changes in the meantime.
+            inline std::shared_ptr<const MeshIncidence> getIncidence() const;
+
+            /// Must be called after modifying m_triangles (or the number of vertices)
+            /// outside of the methods of the mesh, e.g. when writing triangles in place :
+            /// getIncidence() only detects the changes of the number of vertices or triangles.
+            inline void invalidateTopology();
+
             VectorArray<Vector3>  m_vertices;
             VectorArray<Vector3>  m_normals;
             VectorArray<Triangle> m_triangles;
 
+        private:
+            mutable std::shared_ptr<const MeshIncidence> m_incidence;
+
         public:
             EIGEN_MAKE_ALIGNED_OPERATOR_NEW
         };
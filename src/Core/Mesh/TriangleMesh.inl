@@ -9,6 +9,7 @@ namespace Ra
             m_vertices.clear();
             m_normals.clear();
             m_triangles.clear();
+            invalidateTopology();
         }
 
         inline void TriangleMesh::append( const TriangleMesh& other )
@@ -28,6 +29,31 @@ namespace Ra
                     m_triangles[t][i] += verticesBefore;
                 }
             }
+            invalidateTopology();
+        }
+
+        inline std::shared_ptr<const MeshIncidence> TriangleMesh::getIncidence() const
+        {
+            std::shared_ptr<const MeshIncidence> incidence = std::atomic_load( &m_incidence );
+            // The sizes catch most of the forgotten invalidations.
+            if ( !incidence || incidence->getVertexCount() != m_vertices.size() ||
+                 incidence->getTriangleCount() != m_triangles.size() )
+            {
+                // Threads asking for it at the same time may all build it, the first one stored
+                // is returned to all of them.
+                std::shared_ptr<const MeshIncidence> built =
+                    std::make_shared<const MeshIncidence>( uint( m_vertices.size() ), m_triangles );
+                if ( std::atomic_compare_exchange_strong( &m_incidence, &incidence, built ) )
+                {
+                    incidence = built;
+                }
+            }
+            return incidence;
+        }
+
+        inline void TriangleMesh::invalidateTopology()
+        {
+            std::atomic_store( &m_incidence, std::shared_ptr<const MeshIncidence>() );
         }
     }
 }
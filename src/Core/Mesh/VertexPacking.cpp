@@ -0,0 +1,231 @@
+#include <Core/Mesh/VertexPacking.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace VertexPacking
+        {
+            namespace
+            {
+                const Scalar s_maxUShort = 65535;
+                const Scalar s_maxShort = 32767;
+
+                inline Scalar signNotZero( Scalar x )
+                {
+                    return x >= 0 ? Scalar( 1 ) : Scalar( -1 );
+                }
+
+                // Same conversion as OpenGL for normalized signed shorts.
+                inline int16_t toSnorm16( Scalar x )
+                {
+                    return int16_t( std::lround( std::min( std::max( x, Scalar( -1 ) ), Scalar( 1 ) ) * s_maxShort ) );
+                }
+
+                inline Scalar fromSnorm16( int16_t x )
+                {
+                    return std::max( Scalar( x ) / s_maxShort, Scalar( -1 ) );
+                }
+
+                inline uint16_t toUnorm16( Scalar x )
+                {
+                    return uint16_t( std::lround( std::min( std::max( x, Scalar( 0 ) ), Scalar( 1 ) ) * s_maxUShort ) );
+                }
+
+                inline uint8_t toUnorm8( Scalar x )
+                {
+                    return uint8_t( std::lround( std::min( std::max( x, Scalar( 0 ) ), Scalar( 1 ) ) * 255 ) );
+                }
+            }
+
+            Position16 packPosition( const Vector3& p, const Aabb& box )
+            {
+                const Vector3 extent = box.sizes();
+                Position16 result;
+                uint16_t* q = &result.x;
+                for ( uint i = 0; i < 3; ++i )
+                {
+                    q[i] = extent[i] > 0 ? toUnorm16( ( p[i] - box.min()[i] ) / extent[i] ) : 0;
+                }
+                result.w = 0;
+                return result;
+            }
+
+            Vector3 unpackPosition( const Position16& p, const Aabb& box )
+            {
+                const Vector3 t( p.x / s_maxUShort, p.y / s_maxUShort, p.z / s_maxUShort );
+                return box.min() + t.cwiseProduct( box.sizes() );
+            }
+
+            Scalar getPositionError( const Aabb& box )
+            {
+                return Scalar( 0.5 ) * box.sizes().norm() / s_maxUShort;
+            }
+
+            Direction16 packDirection( const Vector3& n )
+            {
+                // Project on the octahedron |x| + |y| + |z| = 1, then unfold its lower half.
+                const Scalar l1 = std::abs( n.x() ) + std::abs( n.y() ) + std::abs( n.z() );
+                if ( l1 == 0 )
+                {
+                    return Direction16{ 0, 0 };
+                }
+                Scalar u = n.x() / l1;
+                Scalar v = n.y() / l1;
+                if ( n.z() < 0 )
+                {
+                    const Scalar pu = u;
+                    u = ( 1 - std::abs( v ) ) * signNotZero( pu );
+                    v = ( 1 - std::abs( pu ) ) * signNotZero( v );
+                }
+                return Direction16{ toSnorm16( u ), toSnorm16( v ) };
+            }
+
+            Vector3 unpackDirection( const Direction16& d )
+            {
+                Vector3 n( fromSnorm16( d.x ), fromSnorm16( d.y ), 0 );
+                n.z() = 1 - std::abs( n.x() ) - std::abs( n.y() );
+                if ( n.z() < 0 )
+                {
+                    const Scalar u = n.x();
+                    n.x() = ( 1 - std::abs( n.y() ) ) * signNotZero( u );
+                    n.y() = ( 1 - std::abs( u ) ) * signNotZero( n.y() );
+                }
+                return n.normalized();
+            }
+
+            uint16_t floatToHalf( float x )
+            {
+                uint32_t f;
+                std::memcpy( &f, &x, sizeof( f ) );
+                const uint16_t sign = uint16_t( ( f >> 16 ) & 0x8000 );
+                f &= 0x7fffffff;
+
+                if ( f >= 0x7f800000 )
+                {
+                    // Infinity, or NaN (kept quiet).
+                    return sign | 0x7c00 | ( f > 0x7f800000 ? 0x200 : 0 );
+                }
+                if ( f >= 0x477ff000 )
+                {
+                    // 65520 and above round to infinity.
+                    return sign | 0x7c00;
+                }
+                if ( f < 0x38800000 )
+                {
+                    // Below 2^-14 : subnormal half, in units of 2^-24. Rounds to nearest even.
+                    float a;
+                    std::memcpy( &a, &f, sizeof( a ) );
+                    return sign | uint16_t( std::nearbyint( a * 16777216.f ) );
+                }
+
+                // Rebias the exponent and round the mantissa to nearest even.
+                const uint32_t odd = ( f >> 13 ) & 1;
+                f += 0xc8000fff + odd;
+                return sign | uint16_t( f >> 13 );
+            }
+
+            float halfToFloat( uint16_t h )
+            {
+                const uint32_t sign = uint32_t( h & 0x8000 ) << 16;
+                const uint32_t exponent = ( h >> 10 ) & 0x1f;
+                const uint32_t mantissa = h & 0x3ff;
+
+                if ( exponent == 0 )
+                {
+                    const float value = float( mantissa ) / 16777216.f;
+                    return sign ? -value : value;
+                }
+
+                const uint32_t f = exponent == 0x1f ? sign | 0x7f800000 | ( mantissa << 13 )
+                                                    : sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+                float result;
+                std::memcpy( &result, &f, sizeof( result ) );
+                return result;
+            }
+
+            TexCoord16 packTexCoord( const Vector3& uv )
+            {
+                return TexCoord16{ floatToHalf( float( uv.x() ) ), floatToHalf( float( uv.y() ) ) };
+            }
+
+            Vector3 unpackTexCoord( const TexCoord16& t )
+            {
+                return Vector3( halfToFloat( t.u ), halfToFloat( t.v ), 0 );
+            }
+
+            Color8 packColor( const Color& c )
+            {
+                return Color8{ toUnorm8( c.x() ), toUnorm8( c.y() ), toUnorm8( c.z() ), toUnorm8( c.w() ) };
+            }
+
+            Color unpackColor( const Color8& c )
+            {
+                return Color( c.r, c.g, c.b, c.a ) / 255;
+            }
+
+            void packPositions( const Vector3Array& positions, const Aabb& box, std::vector<Position16>& out )
+            {
+                const int size = int( positions.size() );
+                out.resize( size );
+                #pragma omp parallel for if( size > 4096 )
+                for ( int i = 0; i < size; ++i )
+                {
+                    out[i] = packPosition( positions[i], box );
+                }
+            }
+
+            void packDirections( const Vector3Array& directions, std::vector<Direction16>& out )
+            {
+                const int size = int( directions.size() );
+                out.resize( size );
+                #pragma omp parallel for if( size > 4096 )
+                for ( int i = 0; i < size; ++i )
+                {
+                    out[i] = packDirection( directions[i] );
+                }
+            }
+
+            void packTexCoords( const Vector3Array& texCoords, std::vector<TexCoord16>& out )
+            {
+                const int size = int( texCoords.size() );
+                out.resize( size );
+                #pragma omp parallel for if( size > 4096 )
+                for ( int i = 0; i < size; ++i )
+                {
+                    out[i] = packTexCoord( texCoords[i] );
+                }
+            }
+
+            void packColors( const Vector4Array& colors, std::vector<Color8>& out )
+            {
+                const int size = int( colors.size() );
+                out.resize( size );
+                #pragma omp parallel for if( size > 4096 )
+                for ( int i = 0; i < size; ++i )
+                {
+                    out[i] = packColor( colors[i] );
+                }
+            }
+
+            void packIndices( const VectorArray<Triangle>& triangles, std::vector<uint16_t>& out )
+            {
+                const int size = int( triangles.size() );
+                out.resize( 3 * size );
+                #pragma omp parallel for if( size > 4096 )
+                for ( int i = 0; i < size; ++i )
+                {
+                    for ( uint k = 0; k < 3; ++k )
+                    {
+                        CORE_ASSERT( triangles[i][k] < 0x10000, "Index does not fit in 16 bits" );
+                        out[3 * i + k] = uint16_t( triangles[i][k] );
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef RADIUMENGINE_VERTEXPACKING_HPP
+#define RADIUMENGINE_VERTEXPACKING_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Mesh/MeshTypes.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Compact encodings of vertex attributes, used to upload meshes to the GPU
+        /// with less memory and bandwidth than full float vectors.
+        /// Each encoding matches a normalized OpenGL vertex format, and comes with the
+        /// bound of its reconstruction error :
+        /// - positions : 16 bit unsigned integers relative to a bounding box (GL_UNSIGNED_SHORT),
+        /// - unit vectors : 16 bit octahedral coordinates (GL_SHORT),
+        /// - texture coordinates : half floats (GL_HALF_FLOAT),
+        /// - colors : 8 bits per channel (GL_UNSIGNED_BYTE),
+        /// - indices : 16 bit unsigned integers when the vertex count allows it.
+        namespace VertexPacking
+        {
+            /// Position quantized in a box. The last coordinate only pads the struct to 8 bytes.
+            struct Position16
+            {
+                uint16_t x, y, z, w;
+            };
+
+            /// Unit vector in octahedral coordinates.
+            struct Direction16
+            {
+                int16_t x, y;
+            };
+
+            /// Texture coordinates (u,v) as half floats.
+            struct TexCoord16
+            {
+                uint16_t u, v;
+            };
+
+            /// RGBA color, 8 bits per channel.
+            struct Color8
+            {
+                uint8_t r, g, b, a;
+            };
+
+            //
+            // Positions
+            //
+
+            /// Quantize p in the given box. Points outside of the box are clamped to it.
+            RA_CORE_API Position16 packPosition( const Vector3& p, const Aabb& box );
+
+            /// Position of a quantized point of the box.
+            RA_CORE_API Vector3 unpackPosition( const Position16& p, const Aabb& box );
+
+            /// Largest distance between a point of the box and its quantized position.
+            RA_CORE_API Scalar getPositionError( const Aabb& box );
+
+            //
+            // Unit vectors
+            //
+
+            /// Octahedral encoding of the unit vector n (which does not need to be normalized).
+            RA_CORE_API Direction16 packDirection( const Vector3& n );
+
+            /// Unit vector of an octahedral encoding.
+            RA_CORE_API Vector3 unpackDirection( const Direction16& d );
+
+            /// Bound of the distance between a unit vector and its decoded value (measured
+            /// maximum : 6.5e-5, i.e. less than 0.004 degree).
+            constexpr Scalar getDirectionError() { return Scalar( 1e-4 ); }
+
+            //
+            // Half floats
+            //
+
+            /// IEEE 754 half float of x, rounded to nearest even. Values too large are infinite.
+            RA_CORE_API uint16_t floatToHalf( float x );
+
+            /// Float value of an IEEE 754 half float.
+            RA_CORE_API float halfToFloat( uint16_t h );
+
+            /// Relative error of the conversion to half floats, for values in the normal range
+            /// [6.1e-5, 65504]. Below it, the absolute error is half of the smallest subnormal.
+            constexpr Scalar getHalfRelativeError() { return Scalar( 1.0 / 2048 ); }
+            constexpr Scalar getHalfAbsoluteError() { return Scalar( 1.0 / ( 1 << 25 ) ); }
+
+            /// Texture coordinates (u,v) of uv, whose third coordinate is dropped.
+            RA_CORE_API TexCoord16 packTexCoord( const Vector3& uv );
+
+            /// Texture coordinates (u,v,0).
+            RA_CORE_API Vector3 unpackTexCoord( const TexCoord16& t );
+
+            //
+            // Colors
+            //
+
+            /// 8 bit color of c, whose channels are clamped to [0,1].
+            RA_CORE_API Color8 packColor( const Color& c );
+
+            RA_CORE_API Color unpackColor( const Color8& c );
+
+            /// Largest error on a channel in [0,1].
+            constexpr Scalar getColorError() { return Scalar( 0.5 / 255 ); }
+
+            //
+            // Arrays
+            //
+
+            /// Encode arrays of attributes. The output arrays are resized to the size of the input.
+            RA_CORE_API void packPositions( const Vector3Array& positions, const Aabb& box,
+                                            std::vector<Position16>& out );
+            RA_CORE_API void packDirections( const Vector3Array& directions, std::vector<Direction16>& out );
+            RA_CORE_API void packTexCoords( const Vector3Array& texCoords, std::vector<TexCoord16>& out );
+            RA_CORE_API void packColors( const Vector4Array& colors, std::vector<Color8>& out );
+
+            /// True if the indices of vertexCount vertices fit in 16 bits.
+            inline bool fitsShortIndices( std::size_t vertexCount ) { return vertexCount <= 0x10000; }
+
+            /// Triangle indices as 16 bit integers, which must fit (see fitsShortIndices()).
+            RA_CORE_API void packIndices( const VectorArray<Triangle>& triangles, std::vector<uint16_t>& out );
+        }
+    }
+}
+
+#endif // RADIUMENGINE_VERTEXPACKING_HPP
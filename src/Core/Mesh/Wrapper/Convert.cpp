@@ -146,6 +146,7 @@ void convert( const Dcel& dcel, TriangleMesh& mesh )
         T[2] = v_table[ f->HE()->Prev()->V()->idx ];
         mesh.m_triangles[i] = T;
     }
+    mesh.invalidateTopology();
 }
 
 } // namespace Core
@@ -1,140 +1,168 @@
 #include <Core/Mesh/Wrapper/TopologicalMeshConvert.hpp>
+#include <Core/Containers/SpatialHash.hpp>
 #include <Core/Log/Log.hpp>
 
-#include <unordered_map>
-
 namespace Ra
 {
     namespace Core
     {
 
-        void MeshConverter::convert( TopologicalMesh& in, TriangleMesh& out )
+        namespace
         {
+            typedef SpatialHash::Key<3> PositionKey;
 
-            struct vertexData
+            // Number the classes of equal positions in order of first appearance in the corners.
+            // newIndex maps a class representative to its output index, sources gives
+            // the first corner index of each class.
+            void numberClasses( const std::vector<uint>& corners, const std::vector<uint>& representatives,
+                                uint classCount, std::vector<int>& newIndex, std::vector<uint>& sources )
             {
-                Vector3 _vertex;
-                Vector3 _normal;
-            };
+                newIndex.assign( representatives.size(), -1 );
+                sources.clear();
+                sources.reserve( classCount );
 
-            struct comp_vec
-            {
-                bool operator()( const vertexData& lhv, const vertexData& rhv ) const
+                for ( const uint c : corners )
                 {
-                    if ( lhv._vertex[0] < rhv._vertex[0] || ( lhv._vertex[0] == rhv._vertex[0] &&
-                                                              lhv._vertex[1] < rhv._vertex[1] ) || ( lhv._vertex[0] == rhv._vertex[0] &&
-                                                                                                     lhv._vertex[1] == rhv._vertex[1] && lhv._vertex[2] < rhv._vertex[2] ) )
+                    const uint rep = representatives[c];
+                    if ( newIndex[rep] < 0 )
                     {
-                        return true;
+                        newIndex[rep] = int( sources.size() );
+                        sources.push_back( c );
                     }
-                    return false;
                 }
-            };
+            }
+        }
 
+        void MeshConverter::convert( TopologicalMesh& in, TriangleMesh& out, Scalar tolerance )
+        {
             out.clear();
-            typedef std::map<vertexData, int, comp_vec> vMap;
-
-            vMap vertexHandles;
 
             in.request_face_normals();
             in.request_vertex_normals();
             in.update_vertex_normals();
 
-            // iterator over all faces
-            unsigned int vertexIndex = 0;
-
-            // out will have at least least n_vertices and n_normals.
-            out.m_vertices.reserve( in.n_vertices() );
-            out.m_normals.reserve( in.n_vertices() );
-            out.m_triangles.reserve( in.n_faces() );
-            
+            // Gather the vertex of each corner of the (non deleted) faces.
+            std::vector<TopologicalMesh::FaceHandle> faces;
+            faces.reserve( in.n_faces() );
             for ( TopologicalMesh::FaceIter f_it = in.faces_sbegin(); f_it != in.faces_end(); ++f_it )
             {
-                vertexData v;
-                int indices[3];
+                faces.push_back( *f_it );
+            }
+
+            const int numFaces = int( faces.size() );
+            std::vector<uint> corners( 3 * faces.size() );
+
+#pragma omp parallel for
+            for ( int f = 0; f < numFaces; ++f )
+            {
                 int i = 0;
                 // iterator over vertex (thru halfedge to get access to halfedge normals)
-                for ( TopologicalMesh::FaceHalfedgeIter fv_it = in.fh_iter( *f_it ); fv_it.is_valid(); ++fv_it )
+                for ( TopologicalMesh::FaceHalfedgeIter fv_it = in.fh_iter( faces[f] ); fv_it.is_valid(); ++fv_it )
                 {
-                    assert( i < 3 );
-                    TopologicalMesh::Point p = in.point( in.to_vertex_handle( *fv_it ) );
-                    TopologicalMesh::Normal n = in.normal( in.to_vertex_handle( *fv_it ) );
-                    v._vertex = Core::Vector3( p[0], p[1], p[2] );
-                    v._normal = Core::Vector3( n[0], n[1], n[2] );
-
-                    int vi;
-                    vMap::iterator vtr = vertexHandles.find( v );
-                    if ( vtr == vertexHandles.end() )
-                    {
-                        vi = vertexIndex++;
-                        vertexHandles.insert( vtr, vMap::value_type( v, vi ) );
-                        out.m_vertices.push_back( v._vertex );
-                        out.m_normals.push_back( v._normal );
-                    }
-                    else
-                    {
-                        vi = vtr->second;
-                    }
-                    indices[i] = vi;
-                    i ++;
+                    CORE_ASSERT( i < 3, "Topological mesh is not a triangle mesh" );
+                    corners[3 * f + i] = uint( in.to_vertex_handle( *fv_it ).idx() );
+                    ++i;
                 }
-                out.m_triangles.emplace_back( indices[0], indices[1], indices[2] );
             }
-            assert( vertexIndex == out.m_vertices.size() );
 
-        }
+            // Merge the vertices sharing the same position.
+            const int numVertices = int( in.n_vertices() );
+            std::vector<PositionKey> keys( in.n_vertices() );
 
-        void MeshConverter::convert( const TriangleMesh& in, TopologicalMesh& out )
-        {
+#pragma omp parallel for
+            for ( int v = 0; v < numVertices; ++v )
+            {
+                keys[v] = SpatialHash::makeKey( convertVec3OpenMeshToEigen( in.point( in.vertex_handle( v ) ) ),
+                                                tolerance );
+            }
+
+            std::vector<uint> representatives;
+            const uint classCount = SpatialHash::findRepresentatives( keys, representatives );
+
+            std::vector<int> newIndex;
+            std::vector<uint> sources;
+            numberClasses( corners, representatives, classCount, newIndex, sources );
+
+            const int numOutVertices = int( sources.size() );
+            out.m_vertices.resize( sources.size() );
+            out.m_normals.resize( sources.size() );
+            out.m_triangles.resize( faces.size() );
 
-            struct hash_vec
+#pragma omp parallel for
+            for ( int v = 0; v < numOutVertices; ++v )
             {
-                size_t operator()( const Vector3& lvalue ) const
-                {
-                    return lvalue[0] + lvalue[1] + lvalue[2] +
-                           floor( lvalue[0] ) * 1000.f +
-                           floor( lvalue[1] ) * 1000.f +
-                           floor( lvalue[2] ) * 1000.f;
-                }
-            };
+                const TopologicalMesh::VertexHandle vh = in.vertex_handle( sources[v] );
+                const TopologicalMesh::Point& p = in.point( vh );
+                const TopologicalMesh::Normal& n = in.normal( vh );
+                out.m_vertices[v] = Core::Vector3( p[0], p[1], p[2] );
+                out.m_normals[v] = Core::Vector3( n[0], n[1], n[2] );
+            }
 
+#pragma omp parallel for
+            for ( int f = 0; f < numFaces; ++f )
+            {
+                out.m_triangles[f] = Triangle( newIndex[representatives[corners[3 * f]]],
+                                               newIndex[representatives[corners[3 * f + 1]]],
+                                               newIndex[representatives[corners[3 * f + 2]]] );
+            }
+            out.invalidateTopology();
+        }
+
+        void MeshConverter::convert( const TriangleMesh& in, TopologicalMesh& out, Scalar tolerance )
+        {
             //Delete old data in out mesh
             out = TopologicalMesh();
             out.garbage_collection();
             out.request_vertex_normals();
-            typedef std::unordered_map<Vector3, TopologicalMesh::VertexHandle, hash_vec> vMap;
-            vMap vertexHandles;
 
-            std::vector<TopologicalMesh::VertexHandle> face_vhandles;
+            // Merge the vertices sharing the same position.
+            const int numVertices = int( in.m_vertices.size() );
+            std::vector<PositionKey> keys( in.m_vertices.size() );
 
-            uint num_halfedge = in.m_triangles.size() * 3;
-            for ( unsigned int i = 0; i < num_halfedge; i++ )
+#pragma omp parallel for
+            for ( int v = 0; v < numVertices; ++v )
             {
-                Vector3 p = in.m_vertices[in.m_triangles[i / 3][i % 3]];
-                Vector3 n = in.m_normals[in.m_triangles[i / 3][i % 3]];
+                keys[v] = SpatialHash::makeKey( in.m_vertices[v], tolerance );
+            }
 
-                vMap::iterator vtr = vertexHandles.find( p );
-                TopologicalMesh::VertexHandle vh;
-                if ( vtr == vertexHandles.end() )
-                {
-                    vh = out.add_vertex( TopologicalMesh::Point( p[0], p[1], p[2] ) );
-                    vertexHandles.insert( vtr, vMap::value_type( p, vh ) );
-                    out.set_normal( vh, TopologicalMesh::Normal( n[0], n[1], n[2] ) );
-                }
-                else
-                {
-                    vh = vtr->second;
-                }
-                face_vhandles.push_back( vh );
+            std::vector<uint> representatives;
+            const uint classCount = SpatialHash::findRepresentatives( keys, representatives );
+
+            std::vector<uint> corners( 3 * in.m_triangles.size() );
+            for ( uint t = 0; t < in.m_triangles.size(); ++t )
+            {
+                corners[3 * t] = in.m_triangles[t][0];
+                corners[3 * t + 1] = in.m_triangles[t][1];
+                corners[3 * t + 2] = in.m_triangles[t][2];
+            }
 
-                if ( ( ( i + 1 ) % 3 ) == 0 )
+            std::vector<int> newIndex;
+            std::vector<uint> sources;
+            numberClasses( corners, representatives, classCount, newIndex, sources );
+
+            // Closed meshes have about as many edges as vertices and faces together.
+            out.reserve( sources.size(), sources.size() + in.m_triangles.size(), in.m_triangles.size() );
+
+            const bool hasNormals = in.m_normals.size() == in.m_vertices.size();
+            std::vector<TopologicalMesh::VertexHandle> vertexHandles( sources.size() );
+            for ( uint v = 0; v < sources.size(); ++v )
+            {
+                const Vector3& p = in.m_vertices[sources[v]];
+                vertexHandles[v] = out.add_vertex( TopologicalMesh::Point( p[0], p[1], p[2] ) );
+                if ( hasNormals )
                 {
-                    out.add_face( face_vhandles );
-                    face_vhandles.clear();
+                    const Vector3& n = in.m_normals[sources[v]];
+                    out.set_normal( vertexHandles[v], TopologicalMesh::Normal( n[0], n[1], n[2] ) );
                 }
+            }
 
+            for ( uint i = 0; i < corners.size(); i += 3 )
+            {
+                out.add_face( vertexHandles[newIndex[representatives[corners[i]]]],
+                              vertexHandles[newIndex[representatives[corners[i + 1]]]],
+                              vertexHandles[newIndex[representatives[corners[i + 2]]]] );
             }
-            assert( out.n_faces() == num_halfedge / 3 );
+            CORE_ASSERT( out.n_faces() == in.m_triangles.size(), "Some faces could not be added" );
         }
 
     }
@@ -11,8 +11,16 @@ namespace Core {
     //! \todo take into account texture coordinates and normals more robustly.
     class RA_CORE_API MeshConverter{
     public:
-        static void convert(TopologicalMesh& in, TriangleMesh& out);
-        static void convert(const TriangleMesh& in, TopologicalMesh& out);
+        //! Vertices sharing the same position are merged, and take the normal of their first occurrence.
+        //! With a positive tolerance, positions are snapped to a grid of that cell size before
+        //! comparison (see SpatialHash::Key).
+        static void convert(TopologicalMesh& in, TriangleMesh& out, Scalar tolerance = 0);
+
+        //! Vertices sharing the same position are merged into a single topological vertex,
+        //! which takes the normal of its first occurrence.
+        //! With a positive tolerance, positions are snapped to a grid of that cell size before
+        //! comparison (see SpatialHash::Key).
+        static void convert(const TriangleMesh& in, TopologicalMesh& out, Scalar tolerance = 0);
     };
 }
 }
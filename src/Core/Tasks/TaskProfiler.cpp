@@ -0,0 +1,167 @@
+#include <Core/Tasks/TaskProfiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            void writeString( std::ostream& out, const std::string& str )
+            {
+                out << '"';
+                for ( const char c : str )
+                {
+                    switch ( c )
+                    {
+                        case '"': out << "\\\""; break;
+                        case '\\': out << "\\\\"; break;
+                        case '\n': out << "\\n"; break;
+                        case '\t': out << "\\t"; break;
+                        default:
+                        {
+                            if ( static_cast<unsigned char>( c ) < 0x20 )
+                            {
+                                char escaped[8];
+                                snprintf( escaped, sizeof( escaped ), "\\u%04x", c );
+                                out << escaped;
+                            }
+                            else
+                            {
+                                out << c;
+                            }
+                        }
+                    }
+                }
+                out << '"';
+            }
+
+            void writeNumber( std::ostream& out, double value )
+            {
+                // JSON has no infinity nor NaN.
+                if ( std::isfinite( value ) )
+                {
+                    char number[32];
+                    snprintf( number, sizeof( number ), "%.6g", value );
+                    out << number;
+                }
+                else
+                {
+                    out << "null";
+                }
+            }
+
+            void writeEntry( std::ostream& out, const TaskProfiler::Entry& entry )
+            {
+                out << "{ \"count\": " << entry.m_count;
+                out << ", \"total_ms\": ";
+                writeNumber( out, 1e3 * entry.m_total );
+                out << ", \"mean_ms\": ";
+                writeNumber( out, 1e3 * entry.getMean() );
+                out << ", \"min_ms\": ";
+                writeNumber( out, 1e3 * entry.m_min );
+                out << ", \"max_ms\": ";
+                writeNumber( out, 1e3 * entry.m_max );
+                out << " }";
+            }
+
+            void writeEntries( std::ostream& out, const std::map<std::string, TaskProfiler::Entry>& entries )
+            {
+                out << "{";
+                bool first = true;
+                for ( const auto& e : entries )
+                {
+                    out << ( first ? "\n    " : ",\n    " );
+                    writeString( out, e.first );
+                    out << ": ";
+                    writeEntry( out, e.second );
+                    first = false;
+                }
+                out << ( first ? "}" : "\n  }" );
+            }
+        }
+
+        void TaskProfiler::Entry::add( double seconds )
+        {
+            m_min = ( m_count == 0 ) ? seconds : std::min( m_min, seconds );
+            m_max = ( m_count == 0 ) ? seconds : std::max( m_max, seconds );
+            m_total += seconds;
+            ++m_count;
+        }
+
+        void TaskProfiler::addFrame( const std::vector<TaskQueue::TimerData>& timerData,
+                                     const std::vector<std::string>& groups, double frameSeconds )
+        {
+            CORE_ASSERT( groups.empty() || groups.size() == timerData.size(), "One group per task expected." );
+
+            m_frames.add( frameSeconds );
+            m_frameTimes.push_back( frameSeconds );
+
+            std::map<std::string, double> groupTimes;
+            for ( uint i = 0; i < timerData.size(); ++i )
+            {
+                const auto& t = timerData[i];
+                const double seconds = Timer::getIntervalSeconds( t.start, t.end );
+                m_tasks[t.taskName].add( seconds );
+                if ( !groups.empty() )
+                {
+                    groupTimes[groups[i]] += seconds;
+                }
+            }
+            for ( const auto& g : groupTimes )
+            {
+                m_groups[g.first].add( g.second );
+            }
+        }
+
+        void TaskProfiler::clear()
+        {
+            m_frames = Entry();
+            m_frameTimes.clear();
+            m_tasks.clear();
+            m_groups.clear();
+        }
+
+        double TaskProfiler::getFramePercentile( double fraction ) const
+        {
+            if ( m_frameTimes.empty() )
+            {
+                return 0;
+            }
+            std::vector<double> times = m_frameTimes;
+            const std::size_t n = std::min( std::size_t( fraction * ( times.size() - 1 ) + 0.5 ), times.size() - 1 );
+            std::nth_element( times.begin(), times.begin() + n, times.end() );
+            return times[n];
+        }
+
+        void TaskProfiler::writeJson( std::ostream& out, const std::map<std::string, double>& metrics,
+                                      const std::string& groupsName ) const
+        {
+            out << "{\n";
+            for ( const auto& m : metrics )
+            {
+                out << "  ";
+                writeString( out, m.first );
+                out << ": ";
+                writeNumber( out, m.second );
+                out << ",\n";
+            }
+            out << "  \"frames\": ";
+            writeEntry( out, m_frames );
+            out << ",\n  \"frame_p50_ms\": ";
+            writeNumber( out, 1e3 * getFramePercentile( 0.5 ) );
+            out << ",\n  \"frame_p95_ms\": ";
+            writeNumber( out, 1e3 * getFramePercentile( 0.95 ) );
+            out << ",\n  ";
+            writeString( out, groupsName );
+            out << ": ";
+            writeEntries( out, m_groups );
+            out << ",\n  \"tasks\": ";
+            writeEntries( out, m_tasks );
+            out << "\n}\n";
+        }
+    }
+}
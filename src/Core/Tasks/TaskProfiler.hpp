@@ -0,0 +1,65 @@
+#ifndef RADIUMENGINE_TASK_PROFILER_HPP_
+#define RADIUMENGINE_TASK_PROFILER_HPP_
+
+#include <Core/RaCore.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Accumulates the timings of the tasks run by a TaskQueue over many frames.
+        /// Tasks are aggregated by name, and by group (e.g. the system which generated them),
+        /// and the whole profile can be written as JSON for regression tracking.
+        class RA_CORE_API TaskProfiler
+        {
+        public:
+            /// Statistics of a set of durations, in seconds.
+            struct Entry
+            {
+                uint m_count = 0;
+                double m_total = 0;
+                double m_min = 0;
+                double m_max = 0;
+
+                void add( double seconds );
+                inline double getMean() const { return m_count > 0 ? m_total / m_count : 0; }
+            };
+
+            /// Add the tasks of one frame.
+            /// groups gives the group of each task of timerData, it may be empty if tasks are not grouped.
+            /// The time of a group is the sum of the time of its tasks in the frame (its CPU time),
+            /// frameSeconds is the wall-clock time of the whole frame.
+            void addFrame( const std::vector<TaskQueue::TimerData>& timerData, const std::vector<std::string>& groups,
+                           double frameSeconds );
+
+            void clear();
+
+            inline uint getFrameCount() const { return m_frames.m_count; }
+            inline const Entry& getFrames() const { return m_frames; }
+            inline const std::map<std::string, Entry>& getTasks() const { return m_tasks; }
+            inline const std::map<std::string, Entry>& getGroups() const { return m_groups; }
+
+            /// Frame time below which the given fraction (in [0,1]) of the frames ran.
+            double getFramePercentile( double fraction ) const;
+
+            /// Write the profile as a JSON object. Durations are in milliseconds.
+            /// metrics are additional numeric values written as members of the object.
+            void writeJson( std::ostream& out, const std::map<std::string, double>& metrics,
+                            const std::string& groupsName = "groups" ) const;
+
+        private:
+            Entry m_frames;
+            std::vector<double> m_frameTimes;
+            std::map<std::string, Entry> m_tasks;
+            std::map<std::string, Entry> m_groups;
+        };
+    }
+}
+
+#endif // RADIUMENGINE_TASK_PROFILER_HPP_
@@ -0,0 +1,77 @@
+#include <Core/Utils/MemoryUsage.hpp>
+
+#if defined( OS_WINDOWS )
+#include <windows.h>
+#include <psapi.h>
+#elif defined( OS_MACOS )
+#include <sys/resource.h>
+#include <mach/mach.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace MemoryUsage
+        {
+            std::size_t getPeakResidentMemory()
+            {
+#if defined( OS_WINDOWS )
+                PROCESS_MEMORY_COUNTERS counters;
+                if ( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+                {
+                    return counters.PeakWorkingSetSize;
+                }
+                return 0;
+#else
+                struct rusage usage;
+                if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+                {
+                    return 0;
+                }
+#if defined( OS_MACOS )
+                return std::size_t( usage.ru_maxrss );        // bytes
+#else
+                return std::size_t( usage.ru_maxrss ) * 1024; // kilobytes
+#endif
+#endif
+            }
+
+            std::size_t getCurrentResidentMemory()
+            {
+#if defined( OS_WINDOWS )
+                PROCESS_MEMORY_COUNTERS counters;
+                if ( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+                {
+                    return counters.WorkingSetSize;
+                }
+                return 0;
+#elif defined( OS_MACOS )
+                mach_task_basic_info info;
+                mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+                if ( task_info( mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count ) == KERN_SUCCESS )
+                {
+                    return std::size_t( info.resident_size );
+                }
+                return 0;
+#else
+                // Second field of statm is the number of resident pages.
+                FILE* file = fopen( "/proc/self/statm", "r" );
+                if ( file == nullptr )
+                {
+                    return 0;
+                }
+                unsigned long size = 0;
+                unsigned long resident = 0;
+                const int read = fscanf( file, "%lu %lu", &size, &resident );
+                fclose( file );
+                return read == 2 ? std::size_t( resident ) * std::size_t( sysconf( _SC_PAGESIZE ) ) : 0;
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef RADIUMENGINE_MEMORYUSAGE_HPP
+#define RADIUMENGINE_MEMORYUSAGE_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <cstddef>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace MemoryUsage
+        {
+            /// Largest resident memory of the process since it started, in bytes (0 if unknown).
+            RA_CORE_API std::size_t getPeakResidentMemory();
+
+            /// Current resident memory of the process, in bytes (0 if unknown).
+            RA_CORE_API std::size_t getCurrentResidentMemory();
+        }
+    }
+}
+
+#endif // RADIUMENGINE_MEMORYUSAGE_HPP
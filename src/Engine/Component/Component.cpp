@@ -6,6 +6,7 @@
 #include <Engine/Entity/Entity.hpp>
 #include <Engine/System/System.hpp>
 #include <Engine/Managers/SignalManager/SignalManager.hpp>
+#include <Engine/Managers/ComponentMessenger/ComponentMessenger.hpp>
 #include <Engine/Renderer/RenderObject/RenderObject.hpp>
 #include <Engine/Renderer/RenderObject/RenderObjectManager.hpp>
 #include <Engine/Renderer/Mesh/Mesh.hpp>
@@ -18,6 +19,7 @@ namespace Ra
                 : m_name( name )
                 , m_entity( nullptr )
                 , m_system( nullptr )
+                , m_systemPosition( 0 )
         {
         }
 
@@ -31,6 +33,11 @@ namespace Ra
             {
                 m_system->unregisterComponent(getEntity(), this);
             }
+            // Handles on the data of this component become invalid.
+            if (ComponentMessenger::getInstance())
+            {
+                ComponentMessenger::getInstance()->unregisterAll(getEntity(), this);
+            }
             RadiumEngine::getInstance()->getSignalManager()->fireComponentRemoved( ItemEntry(getEntity(),this));
         }
 
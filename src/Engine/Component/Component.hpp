@@ -102,6 +102,12 @@ namespace Ra
             Entity* m_entity;
             System* m_system;
 
+        private:
+            friend class System;
+
+            /// Position of the component in the list of its system (see System::m_components).
+            uint m_systemPosition;
+
         };
 
     } // namespace Engine
@@ -1,6 +1,7 @@
 #include <Engine/Entity/Entity.hpp>
 
 #include <Core/String/StringUtils.hpp>
+#include <Core/Math/TransformHierarchy.hpp>
 
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Managers/SignalManager/SignalManager.hpp>
@@ -14,11 +15,12 @@ namespace Ra
 
         Entity::Entity( const std::string& name )
                 : Core::IndexedObject()
-                , m_transform( Core::Transform::Identity())
                 , m_doubleBufferedTransform( Core::Transform::Identity() )
                 , m_name( name )
                 , m_transformChanged( false )
+                , m_transformPublished( false )
         {
+            m_transformNode = RadiumEngine::getInstance()->getTransformHierarchy()->addNode();
         }
 
         Entity::~Entity()
@@ -26,6 +28,7 @@ namespace Ra
             // Ensure components are deleted before the entity for consistent
             // ordering of signals.
             m_components.clear();
+            RadiumEngine::getInstance()->getTransformHierarchy()->removeNode( m_transformNode );
             RadiumEngine::getInstance()->getSignalManager()->fireEntityDestroyed( ItemEntry(this) );
         }
 
@@ -79,15 +82,31 @@ namespace Ra
         {
             if ( m_transformChanged )
             {
-                m_transform = m_doubleBufferedTransform;
+                RadiumEngine::getInstance()->getTransformHierarchy()->setLocal( m_transformNode, m_doubleBufferedTransform );
                 m_transformChanged = false;
             }
+            // The node is published by the update following this call.
+            m_transformPublished = true;
+        }
+
+        Core::Transform Entity::getTransform() const
+        {
+            if ( !m_transformPublished )
+            {
+                return Core::Transform::Identity();
+            }
+            return RadiumEngine::getInstance()->getTransformHierarchy()->getWorld( m_transformNode );
+        }
+
+        Core::Matrix4 Entity::getTransformAsMatrix() const
+        {
+            return getTransform().matrix();
         }
 
         void Entity::rayCastQuery(const Core::Ray& r) const
         {
             // put ray in local frame.
-            Core::Ray transformedRay = Ra::Core::transformRay(r, m_transform.inverse());
+            Core::Ray transformedRay = Ra::Core::transformRay(r, getTransform().inverse());
             for (const auto& c : m_components)
             {
                 c->rayCastQuery(transformedRay);
@@ -3,11 +3,13 @@
 
 #include <Engine/RaEngine.hpp>
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <mutex>
 #include <thread>
 
+#include <Core/Index/Index.hpp>
 #include <Core/Index/IndexedObject.hpp>
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Math/Ray.hpp>
@@ -44,11 +46,17 @@ namespace Ra
             inline void rename( const std::string& name );
 
             // Transform
+            /// The transform is set in the transform hierarchy at the end of the frame.
             inline void setTransform( const Core::Transform& transform );
             inline void setTransform( const Core::Matrix4& transform );
+
+            /// Transform published by the last frame, read without lock.
             Core::Transform getTransform() const;
             Core::Matrix4 getTransformAsMatrix() const;
 
+            /// Node of the entity in the transform hierarchy of the engine.
+            inline Core::Index getTransformNode() const;
+
             void swapTransformBuffers();
 
             // Components
@@ -73,7 +81,7 @@ namespace Ra
             virtual void rayCastQuery(const Core::Ray& r) const;
 
         private:
-            Core::Transform m_transform;
+            Core::Index m_transformNode;
             Core::Transform m_doubleBufferedTransform;
 
             std::string m_name;
@@ -81,7 +89,8 @@ namespace Ra
             std::vector<std::unique_ptr<Component>> m_components;
 
             bool m_transformChanged;
-            mutable std::mutex m_transformMutex;
+            /// True once the node was updated by the hierarchy. Set at the end of the frame, read by tasks.
+            std::atomic<bool> m_transformPublished;
         };
 
     } // namespace Engine
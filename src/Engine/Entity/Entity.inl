@@ -26,16 +26,9 @@ namespace Ra
             setTransform( Core::Transform( transform ));
         }
 
-        inline Core::Transform Entity::getTransform() const
+        inline Core::Index Entity::getTransformNode() const
         {
-            std::lock_guard<std::mutex> lock( m_transformMutex );
-            return m_transform;
-        }
-
-        inline Core::Matrix4 Entity::getTransformAsMatrix() const
-        {
-            std::lock_guard<std::mutex> lock( m_transformMutex );
-            return m_transform.matrix();
+            return m_transformNode;
         }
 
         inline uint Entity::getNumComponents() const
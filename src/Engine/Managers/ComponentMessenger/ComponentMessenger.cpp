@@ -1,8 +1,104 @@
 #include <Engine/Managers/ComponentMessenger/ComponentMessenger.hpp>
 
+#include <algorithm>
+
 namespace Ra {
 namespace Engine
 {
     RA_SINGLETON_IMPLEMENTATION( ComponentMessenger );
+
+    void ComponentMessenger::addCallback( std::unordered_map<const Entity*, CallbackMap>& lists, const Entity* entity,
+                                          Component* comp, const Key& key, CallbackBase* callback )
+    {
+        CORE_ASSERT( entity && comp->getEntity() == entity, "Component not added to entity" );
+        // Will insert a new entity entry if it doesn't exist.
+        CallbackMap& entityList = lists[entity];
+        CORE_ASSERT( entityList.find( key ) == entityList.end(), "Function already registered" );
+
+        callback->m_component = comp;
+        entityList[key].reset( callback );
+        notifyChange( entity, key.first );
+    }
+
+    void ComponentMessenger::unregisterAll( const Entity* entity, const Component* comp )
+    {
+        std::vector<std::string> removed;
+        for ( auto lists : { &m_entityGetLists, &m_entitySetLists, &m_entityRwLists } )
+        {
+            auto entityListPos = lists->find( entity );
+            if ( entityListPos == lists->end() )
+            {
+                continue;
+            }
+
+            CallbackMap& entityList = entityListPos->second;
+            for ( auto it = entityList.begin(); it != entityList.end(); )
+            {
+                if ( it->second->m_component == comp )
+                {
+                    // Handles still hold the entry, and will see it is not registered anymore.
+                    it->second->m_registered.store( false );
+                    removed.push_back( it->first.first );
+                    it = entityList.erase( it );
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            if ( entityList.empty() )
+            {
+                lists->erase( entityListPos );
+            }
+        }
+
+        for ( const auto& id : removed )
+        {
+            notifyChange( entity, id );
+        }
+    }
+
+    int ComponentMessenger::addChangeListener( const Entity* entity, const ChangeCallback& cb )
+    {
+        const int listenerId = m_nextListenerId++;
+        m_listeners[entity].push_back( std::make_pair( listenerId, cb ) );
+        return listenerId;
+    }
+
+    void ComponentMessenger::removeChangeListener( const Entity* entity, int listenerId )
+    {
+        auto listenersPos = m_listeners.find( entity );
+        if ( listenersPos == m_listeners.end() )
+        {
+            return;
+        }
+
+        auto& listeners = listenersPos->second;
+        listeners.erase( std::remove_if( listeners.begin(), listeners.end(),
+                                         [listenerId]( const std::pair<int, ChangeCallback>& l )
+                                         { return l.first == listenerId; } ),
+                         listeners.end() );
+        if ( listeners.empty() )
+        {
+            m_listeners.erase( listenersPos );
+        }
+    }
+
+    void ComponentMessenger::notifyChange( const Entity* entity, const std::string& id )
+    {
+        auto listenersPos = m_listeners.find( entity );
+        if ( listenersPos == m_listeners.end() )
+        {
+            return;
+        }
+
+        // Copy the listeners, which may add or remove listeners when called.
+        const auto listeners = listenersPos->second;
+        for ( const auto& l : listeners )
+        {
+            l.second( entity, id );
+        }
+    }
 }
 }
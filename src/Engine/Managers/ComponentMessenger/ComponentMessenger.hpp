@@ -3,6 +3,7 @@
 
 #include <Engine/RaEngine.hpp>
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 #include <typeindex>
@@ -37,6 +38,13 @@ namespace Ra
         /// and rw() functions.
         /// For more efficiency the underlying function pointers are directly accessible
         /// as well and can be queried with the same identifiers.
+        /// Components reading data every frame should rather resolve a handle once (see
+        /// getOutputHandle()) : reading through a handle does not look up the messenger.
+        /// Handles stay valid until the component providing the data is destroyed (see
+        /// unregisterAll()), and change listeners are told when entries of an entity are
+        /// registered or unregistered, so that handles can be resolved again.
+        /// Outputs and read/write data can also be registered as a pointer to the data itself,
+        /// which handles read without calling any function.
         class RA_ENGINE_API ComponentMessenger
         {
         RA_SINGLETON_INTERFACE(ComponentMessenger);
@@ -88,11 +96,17 @@ namespace Ra
             /// Class hierarchy for polymorphic storage of callback functions.
             struct CallbackBase
             {
+                virtual ~CallbackBase() { }
+                Component* m_component = nullptr; /// Component which registered the callback.
+                /// False once the component is unregistered. Atomic since handles may be checked
+                /// by the tasks of a frame while a component is destroyed on another thread.
+                std::atomic<bool> m_registered { true };
             };
             template<typename T>
             struct GetterCallback : public CallbackBase
             {
                 typename CallbackTypes<T>::Getter m_cb;
+                const T* m_data = nullptr; /// Data registered directly, if any.
             };
             template<typename T>
             struct SetterCallback : public CallbackBase
@@ -103,13 +117,70 @@ namespace Ra
             struct RwCallback : public CallbackBase
             {
                 typename CallbackTypes<T>::ReadWrite m_cb;
+                T* m_data = nullptr; /// Data registered directly, if any.
             };
 
             /// A dictionary of callback entries identified with the key.
-            typedef std::unordered_map<Key, std::unique_ptr<CallbackBase>, HashFunc> CallbackMap;
+            /// Entries are shared with the handles, which outlive them.
+            typedef std::unordered_map<Key, std::shared_ptr<CallbackBase>, HashFunc> CallbackMap;
 
         public:
-            ComponentMessenger() { }
+            /// Typed access to an output, resolved once with getOutputHandle().
+            template<typename T>
+            class OutputHandle
+            {
+            public:
+                /// True if the output is still registered.
+                inline bool isValid() const { return m_callback && m_callback->m_registered.load(); }
+
+                /// Read the data, without looking up or copying the entry. Asserts if the handle is not valid.
+                inline const T& get() const;
+
+            private:
+                friend class ComponentMessenger;
+                const GetterCallback<T>* m_callback = nullptr;    /// Entry read by the handle.
+                std::shared_ptr<const CallbackBase> m_entry; /// Keeps the entry alive once unregistered.
+            };
+
+            /// Typed access to read/write data, resolved once with getRwHandle().
+            template<typename T>
+            class RwHandle
+            {
+            public:
+                /// True if the data is still registered.
+                inline bool isValid() const { return m_callback && m_callback->m_registered.load(); }
+
+                /// Access the data. Asserts if the handle is not valid.
+                inline T* rw() const;
+
+            private:
+                friend class ComponentMessenger;
+                const RwCallback<T>* m_callback = nullptr;    /// Entry read by the handle.
+                std::shared_ptr<const CallbackBase> m_entry; /// Keeps the entry alive once unregistered.
+            };
+
+            /// Typed access to an input, resolved once with getInputHandle().
+            template<typename T>
+            class InputHandle
+            {
+            public:
+                /// True if the input is still registered.
+                inline bool isValid() const { return m_callback && m_callback->m_registered.load(); }
+
+                /// Send data to the input. Asserts if the handle is not valid.
+                inline void set( const T* data ) const;
+
+            private:
+                friend class ComponentMessenger;
+                const SetterCallback<T>* m_callback = nullptr;    /// Entry read by the handle.
+                std::shared_ptr<const CallbackBase> m_entry; /// Keeps the entry alive once unregistered.
+            };
+
+            /// Function called when an entry of an entity is registered or unregistered, with its id.
+            typedef std::function<void( const Entity* entity, const std::string& id )> ChangeCallback;
+
+        public:
+            ComponentMessenger() : m_nextListenerId( 0 ) { }
 
             //
             // Direct access to function pointers
@@ -137,6 +208,21 @@ namespace Ra
             template<typename ReturnType>
             inline const ReturnType& get(const Entity* entity, const std::string& id);
 
+            //
+            // Handles, resolved once.
+            //
+
+            // Note : handles are invalid if the data is not available (no assert).
+
+            template<typename ReturnType>
+            inline OutputHandle<ReturnType> getOutputHandle(const Entity* entity, const std::string& id) const;
+
+            template<typename ReturnType>
+            inline RwHandle<ReturnType> getRwHandle(const Entity* entity, const std::string& id) const;
+
+            template<typename ReturnType>
+            inline InputHandle<ReturnType> getInputHandle(const Entity* entity, const std::string& id) const;
+
 
 
             //
@@ -169,11 +255,64 @@ namespace Ra
             inline void registerInput(const Entity* entity, Component* comp, const std::string& id,
                                       const typename CallbackTypes<ReturnType>::Setter& cb);
 
+            /// Register an output reading data directly. data must live until comp is unregistered.
+            template<typename ReturnType>
+            inline void registerOutput(const Entity* entity, Component* comp, const std::string& id,
+                                       const ReturnType* data);
+
+            /// Register read/write data directly. data must live until comp is unregistered.
+            template<typename ReturnType>
+            inline void registerReadWrite(const Entity* entity, Component* comp, const std::string& id,
+                                          ReturnType* data);
+
+            /// Remove all the entries registered by a component. Its handles become invalid.
+            void unregisterAll(const Entity* entity, const Component* comp);
+
+            //
+            // Change notification
+            //
+
+            /// Call cb each time an entry of entity is registered or unregistered.
+            /// Returns an id to give to removeChangeListener().
+            int addChangeListener(const Entity* entity, const ChangeCallback& cb);
+
+            void removeChangeListener(const Entity* entity, int listenerId);
+
+        private:
+            /// Returns the entry of the given type and id in lists, or nullptr.
+            template<typename ReturnType>
+            inline const std::shared_ptr<CallbackBase>* findEntry(
+                    const std::unordered_map<const Entity*, CallbackMap>& lists,
+                    const Entity* entity, const std::string& id) const;
+
+            /// Returns the callback of the given type and id in lists, or nullptr.
+            template<typename CallbackType, typename ReturnType>
+            inline CallbackType* findCallback(
+                    const std::unordered_map<const Entity*, CallbackMap>& lists,
+                    const Entity* entity, const std::string& id) const;
+
+            /// Returns a handle on the callback of the given type and id in lists.
+            template<typename HandleType, typename CallbackType, typename ReturnType>
+            inline HandleType makeHandle(
+                    const std::unordered_map<const Entity*, CallbackMap>& lists,
+                    const Entity* entity, const std::string& id) const;
+
+            /// Store a new entry and tell the listeners of the entity.
+            void addCallback(std::unordered_map<const Entity*, CallbackMap>& lists, const Entity* entity,
+                             Component* comp, const Key& key, CallbackBase* callback);
+
+            /// Call the change listeners of an entity.
+            void notifyChange(const Entity* entity, const std::string& id);
+
         private:
             std::unordered_map<const Entity*, CallbackMap> m_entityGetLists; /// Per-entity callback get list.
             std::unordered_map<const Entity*, CallbackMap> m_entitySetLists; /// Per-entity callback set list.
             std::unordered_map<const Entity*, CallbackMap> m_entityRwLists;  /// Per-entity callback read-write list.
 
+            /// Per-entity change listeners, with their id.
+            std::unordered_map<const Entity*, std::vector<std::pair<int, ChangeCallback>>> m_listeners;
+            int m_nextListenerId;
+
         };
 
     }
@@ -10,13 +10,79 @@ namespace Ra
             return Core::StdUtils::hash(k);
         }
 
+        template<typename ReturnType>
+        inline const ReturnType& ComponentMessenger::OutputHandle<ReturnType>::get() const
+        {
+            CORE_ASSERT(isValid(), "Invalid output handle");
+            return m_callback->m_data ? *m_callback->m_data
+                                      : CallbackTypes<ReturnType>::getHelper(m_callback->m_cb);
+        }
+
+        template<typename ReturnType>
+        inline ReturnType* ComponentMessenger::RwHandle<ReturnType>::rw() const
+        {
+            CORE_ASSERT(isValid(), "Invalid read-write handle");
+            return m_callback->m_data ? m_callback->m_data : m_callback->m_cb();
+        }
+
+        template<typename ReturnType>
+        inline void ComponentMessenger::InputHandle<ReturnType>::set(const ReturnType* data) const
+        {
+            CORE_ASSERT(isValid(), "Invalid input handle");
+            m_callback->m_cb(data);
+        }
+
+        template<typename ReturnType>
+        inline const std::shared_ptr<ComponentMessenger::CallbackBase>* ComponentMessenger::findEntry(
+                const std::unordered_map<const Entity*, CallbackMap>& lists,
+                const Entity* entity, const std::string& id) const
+        {
+            // Attempt to find the given entity list.
+            const auto& entityListPos = lists.find(entity);
+            if (entityListPos == lists.end())
+                return nullptr; // Entity has no registered component
+
+            Key key(id, std::type_index(typeid(ReturnType)));
+            const CallbackMap& entityList = entityListPos->second;
+
+            // Check if there are components exporting the given type,
+            // so let's try to find if there is one with the requested id.
+            const auto& callbackEntry = entityList.find(key);
+            if (callbackEntry == entityList.end())
+                return nullptr;
+            return &callbackEntry->second;
+        }
+
+        template<typename CallbackType, typename ReturnType>
+        inline CallbackType* ComponentMessenger::findCallback(
+                const std::unordered_map<const Entity*, CallbackMap>& lists,
+                const Entity* entity, const std::string& id) const
+        {
+            const std::shared_ptr<CallbackBase>* entry = findEntry<ReturnType>(lists, entity, id);
+            return entry ? static_cast<CallbackType*>(entry->get()) : nullptr;
+        }
+
+        template<typename HandleType, typename CallbackType, typename ReturnType>
+        inline HandleType ComponentMessenger::makeHandle(
+                const std::unordered_map<const Entity*, CallbackMap>& lists,
+                const Entity* entity, const std::string& id) const
+        {
+            HandleType handle;
+            const std::shared_ptr<CallbackBase>* entry = findEntry<ReturnType>(lists, entity, id);
+            if (entry)
+            {
+                handle.m_callback = static_cast<const CallbackType*>(entry->get());
+                handle.m_entry = *entry;
+            }
+            return handle;
+        }
+
         template<typename ReturnType>
         inline typename ComponentMessenger::CallbackTypes<ReturnType>::Getter ComponentMessenger::getterCallback(
                 const Entity* entity, const std::string& id)
         {
             CORE_ASSERT(canGet<ReturnType>(entity, id), "Unregistered callback");
-            return static_cast<GetterCallback <ReturnType>*>(m_entityGetLists[entity][Key(id, std::type_index(
-                    typeid(ReturnType)))].get())->m_cb;
+            return findCallback<GetterCallback<ReturnType>, ReturnType>(m_entityGetLists, entity, id)->m_cb;
         }
 
         template<typename ReturnType>
@@ -24,8 +90,7 @@ namespace Ra
                 const Entity* entity, const std::string& id)
         {
             CORE_ASSERT(canRw<ReturnType>(entity, id), "Unregistered callback");
-            return static_cast<RwCallback <ReturnType>*>(m_entityRwLists[entity][Key(id, std::type_index(
-                    typeid(ReturnType)))].get())->m_cb;
+            return findCallback<RwCallback<ReturnType>, ReturnType>(m_entityRwLists, entity, id)->m_cb;
         }
 
         template<typename ReturnType>
@@ -33,14 +98,37 @@ namespace Ra
                 const Entity* entity, const std::string& id)
         {
             CORE_ASSERT(canSet<ReturnType>(entity, id), "Unregistered callback");
-            return static_cast<SetterCallback <ReturnType>*>(m_entitySetLists[entity][Key(id, std::type_index(
-                    typeid(ReturnType)))].get())->m_cb;
+            return findCallback<SetterCallback<ReturnType>, ReturnType>(m_entitySetLists, entity, id)->m_cb;
         }
 
         template<typename ReturnType>
         inline const ReturnType& ComponentMessenger::get(const Entity* entity, const std::string& id)
         {
-            return CallbackTypes<ReturnType>::getHelper(getterCallback<ReturnType>(entity, id));
+            const GetterCallback<ReturnType>* getter =
+                findCallback<GetterCallback<ReturnType>, ReturnType>(m_entityGetLists, entity, id);
+            CORE_ASSERT(getter, "Unregistered callback");
+            return getter->m_data ? *getter->m_data : CallbackTypes<ReturnType>::getHelper(getter->m_cb);
+        }
+
+        template<typename ReturnType>
+        inline ComponentMessenger::OutputHandle<ReturnType> ComponentMessenger::getOutputHandle(
+                const Entity* entity, const std::string& id) const
+        {
+            return makeHandle<OutputHandle<ReturnType>, GetterCallback<ReturnType>, ReturnType>(m_entityGetLists, entity, id);
+        }
+
+        template<typename ReturnType>
+        inline ComponentMessenger::RwHandle<ReturnType> ComponentMessenger::getRwHandle(
+                const Entity* entity, const std::string& id) const
+        {
+            return makeHandle<RwHandle<ReturnType>, RwCallback<ReturnType>, ReturnType>(m_entityRwLists, entity, id);
+        }
+
+        template<typename ReturnType>
+        inline ComponentMessenger::InputHandle<ReturnType> ComponentMessenger::getInputHandle(
+                const Entity* entity, const std::string& id) const
+        {
+            return makeHandle<InputHandle<ReturnType>, SetterCallback<ReturnType>, ReturnType>(m_entitySetLists, entity, id);
         }
 /*
         template<typename ReturnType>
@@ -52,103 +140,68 @@ namespace Ra
         template<typename ReturnType>
         inline bool ComponentMessenger::canGet(const Entity* entity, const std::string& id)
         {
-            // Attempt to find the given entity list.
-            const auto& entityListPos = m_entityGetLists.find(entity);
-            if (entityListPos == m_entityGetLists.end())
-                return false; // Entity has no registered component
-
-            Key key(id, std::type_index(typeid(ReturnType)));
-            const CallbackMap& entityList = entityListPos->second;
-
-            // Check if there are components exporting the given type,
-            // so let's try to find if there is one with the requested id.
-            const auto& callbackEntry = entityList.find(key);
-            const bool found = (callbackEntry != entityList.end());
-            return found;
+            return findCallback<GetterCallback<ReturnType>, ReturnType>(m_entityGetLists, entity, id) != nullptr;
         }
 
         template<typename ReturnType>
         inline bool ComponentMessenger::canSet(const Entity* entity, const std::string& id)
         {
-            // Attempt to find the given entity list.
-            auto entityListPos = m_entitySetLists.find(entity);
-            if (entityListPos == m_entitySetLists.end())
-                return false; // Entity has no registered component
-
-            Key key(id, std::type_index(typeid(ReturnType)));
-            const CallbackMap& entityList = entityListPos->second;
-
-            // Check if there are components exporting the given type,
-            // so let's try to find if there is one with the requested id.
-            const auto& callbackEntry = entityList.find(key);
-            const bool found = (callbackEntry != entityList.end());
-            return found;
+            return findCallback<SetterCallback<ReturnType>, ReturnType>(m_entitySetLists, entity, id) != nullptr;
         }
 
         template<typename ReturnType>
         inline bool ComponentMessenger::canRw(const Entity* entity, const std::string& id)
         {
-            // Attempt to find the given entity list.
-            const auto& entityListPos = m_entityRwLists.find(entity);
-            if (entityListPos == m_entityRwLists.end())
-                return false; // Entity has no registered component
-
-            Key key(id, std::type_index(typeid(ReturnType)));
-            const CallbackMap& entityList = entityListPos->second;
-
-            // Check if there are components exporting the given type,
-            // so let's try to find if there is one with the requested id.
-            const auto& callbackEntry = entityList.find(key);
-            const bool found = (callbackEntry != entityList.end());
-            return found;
+            return findCallback<RwCallback<ReturnType>, ReturnType>(m_entityRwLists, entity, id) != nullptr;
         }
 
         template<typename ReturnType>
         inline void ComponentMessenger::registerOutput(const Entity* entity, Component* comp, const std::string& id,
                                                 const typename CallbackTypes<ReturnType>::Getter& cb)
         {
-            CORE_ASSERT(entity && comp->getEntity() == entity, "Component not added to entity");
-            // Will insert a new entity entry if it doesn't exist.
-            CallbackMap& entityList = m_entityGetLists[entity];
-
-            Key key(id, std::type_index(typeid(ReturnType)));
-            CORE_ASSERT(entityList.find(key) == entityList.end(), "Output function already registered");
-
             GetterCallback <ReturnType>* getter = new GetterCallback<ReturnType>();
             getter->m_cb = cb;
-            entityList[key].reset(getter);
+            addCallback(m_entityGetLists, entity, comp, Key(id, std::type_index(typeid(ReturnType))), getter);
+        }
+
+        template<typename ReturnType>
+        inline void ComponentMessenger::registerOutput(const Entity* entity, Component* comp, const std::string& id,
+                                                const ReturnType* data)
+        {
+            CORE_ASSERT(data, "Null output data");
+            GetterCallback <ReturnType>* getter = new GetterCallback<ReturnType>();
+            getter->m_data = data;
+            getter->m_cb = [data]() { return data; };
+            addCallback(m_entityGetLists, entity, comp, Key(id, std::type_index(typeid(ReturnType))), getter);
         }
 
         template<typename ReturnType>
         inline void ComponentMessenger::registerReadWrite(const Entity* entity, Component* comp, const std::string& id,
                                                    const typename CallbackTypes<ReturnType>::ReadWrite& cb)
         {
-            CORE_ASSERT(entity && comp->getEntity() == entity, "Component not added to entity");
-            // Will insert a new entity entry if it doesn't exist.
-            CallbackMap& entityList = m_entityRwLists[entity];
-
-            Key key(id, std::type_index(typeid(ReturnType)));
-            CORE_ASSERT(entityList.find(key) == entityList.end(), "Rw function already registered");
-
             RwCallback <ReturnType>* rw = new RwCallback<ReturnType>();
             rw->m_cb = cb;
-            entityList[key].reset(rw);
+            addCallback(m_entityRwLists, entity, comp, Key(id, std::type_index(typeid(ReturnType))), rw);
+        }
+
+        template<typename ReturnType>
+        inline void ComponentMessenger::registerReadWrite(const Entity* entity, Component* comp, const std::string& id,
+                                                   ReturnType* data)
+        {
+            CORE_ASSERT(data, "Null read-write data");
+            RwCallback <ReturnType>* rw = new RwCallback<ReturnType>();
+            rw->m_data = data;
+            rw->m_cb = [data]() { return data; };
+            addCallback(m_entityRwLists, entity, comp, Key(id, std::type_index(typeid(ReturnType))), rw);
         }
 
         template<typename ReturnType>
         inline void ComponentMessenger::registerInput(const Entity* entity, Component* comp, const std::string& id,
                                                const typename CallbackTypes<ReturnType>::Setter& cb)
         {
-            CORE_ASSERT(entity && comp->getEntity() == entity, "Component not added to entity");
-            // Will insert a new entity entry if it doesn't exist.
-            CallbackMap& entityList = m_entitySetLists[entity];
-
-            Key key(id, std::type_index(typeid(ReturnType)));
-            CORE_ASSERT(entityList.find(key) == entityList.end(), "Input function already registered");
-
             SetterCallback <ReturnType>* setter = new SetterCallback<ReturnType>();
             setter->m_cb = cb;
-            entityList[key].reset(setter);
+            addCallback(m_entitySetLists, entity, comp, Key(id, std::type_index(typeid(ReturnType))), setter);
         }
 
     }
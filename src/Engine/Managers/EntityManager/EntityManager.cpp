@@ -28,7 +28,8 @@ namespace Ra
         Entity* EntityManager::createEntity( const std::string& name )
         {
             Core::Index idx = m_entities.emplace( new Entity(name) );
-            auto& ent = m_entities[idx];
+            // Entities are moved in the map when other ones are added or removed : keep the pointer.
+            Entity* ent = m_entities[idx].get();
             ent->idx = idx;
 
             std::string eName = name;
@@ -55,8 +56,8 @@ namespace Ra
             m_entitiesName.insert( std::pair<std::string, Core::Index> (
                                        ent->getName(), idx ) );
 
-            RadiumEngine::getInstance()->getSignalManager()->fireEntityCreated(ItemEntry(ent.get()));
-            return ent.get();
+            RadiumEngine::getInstance()->getSignalManager()->fireEntityCreated(ItemEntry(ent));
+            return ent;
         }
 
         bool EntityManager::entityExists( const std::string& name ) const
@@ -9,7 +9,7 @@
 #include <string>
 
 #include <Core/Utils/Singleton.hpp>
-#include <Core/Index/IndexMap.hpp>
+#include <Core/Index/SlotMap.hpp>
 
 namespace Ra
 {
@@ -66,9 +66,10 @@ namespace Ra
             void removeEntity( Entity* entity );
 
             /**
-             * @brief Get an entity given its index.
+             * @brief Get an entity given its index, in constant time.
              * @param idx Index of the component to retrieve.
-             * @return The entity if found in the map, nullptr otherwise.
+             * @return The entity if found in the map, nullptr otherwise (also for the index
+             * of a removed entity).
              */
             Entity* getEntity( Core::Index idx ) const;
 
@@ -95,7 +96,7 @@ namespace Ra
             void deleteEntities();
 
         private:
-            Core::IndexMap<std::unique_ptr<Entity>> m_entities;
+            Core::SlotMap<std::unique_ptr<Entity>> m_entities;
             std::map<std::string, Core::Index> m_entitiesName;
 
         };
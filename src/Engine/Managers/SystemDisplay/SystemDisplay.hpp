@@ -146,7 +146,7 @@ namespace Ra
 
 
 #define RA_DISPLAY_LINE_ONCE(a, b, color)                           \
-    Ra::Engine::DebugRender::getInstance()->drawLine(a, b, color)
+    Ra::Engine::DebugRender::getInstance()->addLine(a, b, color)
 
 #else // if debug display is disabled
 
@@ -15,6 +15,8 @@
 #include <Core/Event/EventEnums.hpp>
 #include <Core/Event/KeyEvent.hpp>
 #include <Core/Event/MouseEvent.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Math/TransformHierarchy.hpp>
 
 
 #include <Engine/Managers/EntityManager/EntityManager.hpp>
@@ -47,6 +49,8 @@ namespace Ra
         {
             LOG(logINFO) << "*** Radium Engine ***";
             m_signalManager.reset( new SignalManager );
+            // Entities and render objects add their node in the hierarchy when created.
+            m_transformHierarchy.reset( new Core::TransformHierarchy );
             m_entityManager.reset( new EntityManager );
             m_renderObjectManager.reset( new RenderObjectManager );
             m_loadedFile.reset();
@@ -61,6 +65,10 @@ namespace Ra
                                                                  Ra::Engine::ShaderConfiguration lpconfig("BlinnPhong", "Shaders/BlinnPhong.vert.glsl", "Shaders/BlinnPhong.frag.glsl");
                                                                  rt.setConfiguration(lpconfig, Ra::Engine::RenderTechnique::LIGHTING_OPAQUE);
                                                                  
+                                                                 // Single pass lighting (Optional) : BlinnPhongClustered
+                                                                 Ra::Engine::ShaderConfiguration lcconfig("BlinnPhongClustered", "Shaders/BlinnPhong.vert.glsl", "Shaders/BlinnPhongClustered.frag.glsl");
+                                                                 rt.setConfiguration(lcconfig, Ra::Engine::RenderTechnique::LIGHTING_OPAQUE_CLUSTERED);
+                                                                 
                                                                  // Z prepass (Reccomanded) : DepthAmbiantPass
                                                                  Ra::Engine::ShaderConfiguration dpconfig("DepthAmbiantPass", "Shaders/BlinnPhong.vert.glsl", "Shaders/DepthAmbientPass.frag.glsl");
                                                                  rt.setConfiguration(dpconfig, Ra::Engine::RenderTechnique::Z_PREPASS);
@@ -70,6 +78,9 @@ namespace Ra
                                                                  {
                                                                      Ra::Engine::ShaderConfiguration tpconfig("LitOIT", "Shaders/BlinnPhong.vert.glsl", "Shaders/LitOIT.frag.glsl");
                                                                      rt.setConfiguration(tpconfig, Ra::Engine::RenderTechnique::LIGHTING_TRANSPARENT);
+                                                                     
+                                                                     Ra::Engine::ShaderConfiguration tcconfig("LitOITClustered", "Shaders/BlinnPhong.vert.glsl", "Shaders/LitOITClustered.frag.glsl");
+                                                                     rt.setConfiguration(tcconfig, Ra::Engine::RenderTechnique::LIGHTING_TRANSPARENT_CLUSTERED);
                                                                  }
                                                              }
                                                              );
@@ -82,6 +93,7 @@ namespace Ra
             m_signalManager->setOn( false );
             m_entityManager.reset();
             m_renderObjectManager.reset();
+            m_transformHierarchy.reset();
             m_loadedFile.reset();
 
             for ( auto& system : m_systems )
@@ -96,10 +108,12 @@ namespace Ra
         void RadiumEngine::endFrameSync()
         {
             m_entityManager->swapBuffers();
+            m_renderObjectManager->swapTransformBuffers();
+            m_transformHierarchy->update();
             m_signalManager->fireFrameEnded();
         }
 
-        void RadiumEngine::getTasks( Core::TaskQueue* taskQueue,  Scalar dt )
+        void RadiumEngine::getTasks( Core::TaskQueue* taskQueue,  Scalar dt, std::vector<std::string>* taskSystems )
         {
             static uint frameCounter = 0;
             FrameInfo frameInfo;
@@ -108,6 +122,11 @@ namespace Ra
             for ( auto& syst : m_systems )
             {
                 syst.second->generateTasks( taskQueue, frameInfo );
+                if ( taskSystems != nullptr )
+                {
+                    // Tasks are timed in registration order.
+                    taskSystems->resize( taskQueue->getTimerData().size(), syst.first );
+                }
             }
         }
 
@@ -239,6 +258,11 @@ namespace Ra
            return m_signalManager.get();
         }
 
+        Core::TransformHierarchy* RadiumEngine::getTransformHierarchy() const
+        {
+            return m_transformHierarchy.get();
+        }
+
         void RadiumEngine::registerFileLoader( std::shared_ptr<Asset::FileLoaderInterface> fileLoader )
         {
             m_fileLoaders.push_back( fileLoader );
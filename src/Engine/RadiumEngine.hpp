@@ -11,12 +11,14 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace Ra
 {
     namespace Core
     {
         class TaskQueue;
+        class TransformHierarchy;
         struct MouseEvent;
         struct KeyEvent;
     }
@@ -49,7 +51,10 @@ namespace Ra
             void initialize();
             void cleanup();
 
-            void getTasks( Core::TaskQueue* taskQueue, Scalar dt );
+            /// Let each system add its tasks for the next frame to taskQueue.
+            /// If taskSystems is given, the name of the system which added each task is
+            /// appended to it, in task order.
+            void getTasks( Core::TaskQueue* taskQueue, Scalar dt, std::vector<std::string>* taskSystems = nullptr );
 
             void registerSystem( const std::string& name,
                                  System* system );
@@ -71,6 +76,8 @@ namespace Ra
 
             /// Is called at the end of the frame to synchronize any data
             /// that may have been updated during the frame's multithreaded processing.
+            /// Transforms of entities and render objects are published in the transform
+            /// hierarchy, which computes the world transforms of the next frame.
             void endFrameSync();
 
             /// Manager getters
@@ -78,6 +85,9 @@ namespace Ra
             EntityManager*        getEntityManager()        const;
             SignalManager*        getSignalManager()        const;
 
+            /// World transforms of the entities and render objects.
+            Core::TransformHierarchy* getTransformHierarchy() const;
+
             void registerFileLoader( std::shared_ptr<Asset::FileLoaderInterface> fileLoader );
 
             const std::vector< std::shared_ptr<Asset::FileLoaderInterface> >& getFileLoaders() const;
@@ -90,6 +100,7 @@ namespace Ra
             std::unique_ptr<RenderObjectManager> m_renderObjectManager;
             std::unique_ptr<EntityManager>       m_entityManager;
             std::unique_ptr<SignalManager>       m_signalManager;
+            std::unique_ptr<Core::TransformHierarchy> m_transformHierarchy;
             std::unique_ptr<Asset::FileData>     m_loadedFile;
         };
 
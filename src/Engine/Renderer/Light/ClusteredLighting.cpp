@@ -0,0 +1,150 @@
+#include <Engine/Renderer/Light/ClusteredLighting.hpp>
+
+#include <Engine/Renderer/OpenGL/OpenGL.hpp>
+#include <Engine/Renderer/Light/FrameLight.hpp>
+#include <Engine/Renderer/Renderer.hpp>
+#include <Engine/Renderer/RenderStatistics.hpp>
+#include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        namespace
+        {
+            const GLenum bufferFormats[] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+            const int bufferUnits[] = { ClusteredLighting::TEXTURE_UNIT_LIGHTS,
+                                        ClusteredLighting::TEXTURE_UNIT_GRID,
+                                        ClusteredLighting::TEXTURE_UNIT_INDICES };
+        }
+
+        ClusteredLighting::ClusteredLighting()
+            : m_grid()
+            , m_projMatrix( Core::Matrix4::Zero() )
+            , m_tileSize( 1, 1 )
+        {
+            m_buffers.fill( 0 );
+            m_textures.fill( 0 );
+        }
+
+        ClusteredLighting::~ClusteredLighting()
+        {
+            if ( m_buffers[0] != 0 )
+            {
+                glDeleteTextures( BUFFER_COUNT, m_textures.data() );
+                glDeleteBuffers( BUFFER_COUNT, m_buffers.data() );
+            }
+        }
+
+        void ClusteredLighting::initializeGL()
+        {
+            if ( m_buffers[0] != 0 )
+            {
+                return;
+            }
+
+            GL_ASSERT( glGenBuffers( BUFFER_COUNT, m_buffers.data() ) );
+            GL_ASSERT( glGenTextures( BUFFER_COUNT, m_textures.data() ) );
+
+            const uint zeros[4] = { 0, 0, 0, 0 };
+            for ( uint i = 0; i < BUFFER_COUNT; ++i )
+            {
+                uploadBuffer( BufferName( i ), zeros, sizeof( zeros ) );
+                GL_ASSERT( glBindTexture( GL_TEXTURE_BUFFER, m_textures[i] ) );
+                GL_ASSERT( glTexBuffer( GL_TEXTURE_BUFFER, bufferFormats[i], m_buffers[i] ) );
+            }
+            GL_ASSERT( glBindTexture( GL_TEXTURE_BUFFER, 0 ) );
+        }
+
+        void ClusteredLighting::update( const std::vector<FrameLight>& lights,
+                                        const RenderData& renderData, uint width, uint height )
+        {
+            CORE_ASSERT( m_buffers[0] != 0, "Clustered lighting was not initialized." );
+
+            // Cluster bounds only depend on the projection.
+            if ( renderData.projMatrix != m_projMatrix )
+            {
+                m_projMatrix = renderData.projMatrix;
+                m_grid.setProjection( m_projMatrix );
+            }
+
+            m_lightBlocks.resize( lights.size() );
+            m_lightSpheres.resize( lights.size() );
+            for ( uint i = 0; i < lights.size(); ++i )
+            {
+                const FrameLight& light = lights[i];
+                m_lightBlocks[i] = light.m_block;
+
+                Core::Algorithm::LightSphere& sphere = m_lightSpheres[i];
+                if ( light.m_bounded )
+                {
+                    const Core::Vector3& center = light.m_center;
+                    const Core::Vector4 viewCenter =
+                        renderData.viewMatrix * Core::Vector4( center.x(), center.y(), center.z(), 1 );
+                    sphere.m_center = viewCenter.head<3>();
+                    sphere.m_radius = light.m_radius;
+                }
+                else
+                {
+                    sphere.m_center = Core::Vector3::Zero();
+                    sphere.m_radius = -1;
+                }
+            }
+
+            m_grid.assignLights( m_lightSpheres );
+
+            const uint clusterCount = m_grid.getClusterCount();
+            m_clusters.resize( 2 * clusterCount );
+            for ( uint c = 0; c < clusterCount; ++c )
+            {
+                m_clusters[2 * c] = m_grid.getOffsets()[c];
+                m_clusters[2 * c + 1] = m_grid.getLightCount( c );
+            }
+
+            // Texture buffers can not be empty.
+            const uint zero = 0;
+            const std::vector<uint>& indices = m_grid.getLightIndices();
+
+            if ( !m_lightBlocks.empty() )
+            {
+                uploadBuffer( BUFFER_LIGHTS, m_lightBlocks.data(), m_lightBlocks.size() * sizeof( LightBlock ) );
+            }
+            uploadBuffer( BUFFER_GRID, m_clusters.data(), m_clusters.size() * sizeof( uint ) );
+            uploadBuffer( BUFFER_INDICES,
+                          indices.empty() ? &zero : indices.data(),
+                          indices.empty() ? sizeof( uint ) : indices.size() * sizeof( uint ) );
+
+            m_tileSize = Core::Vector2( Scalar( width ) / Scalar( m_grid.getTilesX() ),
+                                        Scalar( height ) / Scalar( m_grid.getTilesY() ) );
+        }
+
+        void ClusteredLighting::bind( RenderParameters& params ) const
+        {
+            for ( uint i = 0; i < BUFFER_COUNT; ++i )
+            {
+                GL_ASSERT( glActiveTexture( GLenum( uint( GL_TEXTURE0 ) + uint( bufferUnits[i] ) ) ) );
+                GL_ASSERT( glBindTexture( GL_TEXTURE_BUFFER, m_textures[i] ) );
+                ++getCurrentRenderStatistics().m_textureBinds;
+            }
+
+            params.addParameter( "uClusterLights", bufferUnits[BUFFER_LIGHTS] );
+            params.addParameter( "uClusterGrid", bufferUnits[BUFFER_GRID] );
+            params.addParameter( "uClusterLightIndices", bufferUnits[BUFFER_INDICES] );
+
+            params.addParameter( "uClusterTilesX", int( m_grid.getTilesX() ) );
+            params.addParameter( "uClusterTilesY", int( m_grid.getTilesY() ) );
+            params.addParameter( "uClusterSlices", int( m_grid.getSlices() ) );
+            params.addParameter( "uClusterTileSize", m_tileSize );
+            params.addParameter( "uClusterNear", m_grid.getNear() );
+            params.addParameter( "uClusterSliceScale", m_grid.getSliceScale() );
+        }
+
+        void ClusteredLighting::uploadBuffer( BufferName buffer, const void* data, std::size_t size )
+        {
+            GL_ASSERT( glBindBuffer( GL_TEXTURE_BUFFER, m_buffers[buffer] ) );
+            GL_ASSERT( glBufferData( GL_TEXTURE_BUFFER, size, data, GL_STREAM_DRAW ) );
+            GL_ASSERT( glBindBuffer( GL_TEXTURE_BUFFER, 0 ) );
+        }
+
+    } // namespace Engine
+} // namespace Ra
@@ -0,0 +1,93 @@
+#ifndef RADIUMENGINE_CLUSTEREDLIGHTING_HPP
+#define RADIUMENGINE_CLUSTEREDLIGHTING_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <Core/Algorithm/LightCulling/LightClusterGrid.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBlocks.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        struct FrameLight;
+        class RenderParameters;
+        struct RenderData;
+    }
+}
+
+namespace Ra
+{
+    namespace Engine
+    {
+        /// GPU side of the clustered light culling.
+        /// Each frame, the lights are culled on the CPU against the clusters of the view frustum
+        /// (see Core::Algorithm::LightClusterGrid), then the packed lights and the per cluster
+        /// light lists are uploaded to texture buffers read by Shaders/ClusteredLighting.glsl.
+        /// This allows to shade all the lights reaching an object in a single draw call.
+        class RA_ENGINE_API ClusteredLighting
+        {
+        public:
+            RA_CORE_ALIGNED_NEW
+
+            /// Texture units used by the cluster buffers. They are above the units used by materials.
+            enum TextureUnit : int
+            {
+                TEXTURE_UNIT_LIGHTS = 13,
+                TEXTURE_UNIT_GRID,
+                TEXTURE_UNIT_INDICES
+            };
+
+            ClusteredLighting();
+            ~ClusteredLighting();
+
+            /// Create the GL buffers. Must be called with an active GL context.
+            void initializeGL();
+
+            /// Cull the lights against the clusters of the current view and upload the result.
+            void update( const std::vector<FrameLight>& lights,
+                         const RenderData& renderData, uint width, uint height );
+
+            /// Bind the cluster buffers to their texture units and add the uniforms
+            /// read by the clustered shaders to params.
+            void bind( RenderParameters& params ) const;
+
+            inline const Core::Algorithm::LightClusterGrid& getGrid() const { return m_grid; }
+
+        private:
+            enum BufferName
+            {
+                BUFFER_LIGHTS = 0,
+                BUFFER_GRID,
+                BUFFER_INDICES,
+                BUFFER_COUNT
+            };
+
+            void uploadBuffer( BufferName buffer, const void* data, std::size_t size );
+
+        private:
+            ClusteredLighting( const ClusteredLighting& ) = delete;
+            void operator=( const ClusteredLighting& ) = delete;
+
+        private:
+            Core::Algorithm::LightClusterGrid m_grid;
+            Core::Matrix4 m_projMatrix;
+
+            Core::AlignedStdVector<Core::Algorithm::LightSphere> m_lightSpheres;
+            std::vector<LightBlock> m_lightBlocks;
+            std::vector<uint> m_clusters;
+
+            Core::Vector2 m_tileSize;
+
+            std::array<uint, BUFFER_COUNT> m_buffers;
+            std::array<uint, BUFFER_COUNT> m_textures;
+        };
+
+    } // namespace Engine
+} // namespace Ra
+
+#endif // RADIUMENGINE_CLUSTEREDLIGHTING_HPP
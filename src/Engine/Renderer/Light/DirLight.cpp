@@ -1,6 +1,7 @@
 #include <Engine/Renderer/Light/DirLight.hpp>
 
 #include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBlocks.hpp>
 
 namespace Ra
 {
@@ -22,4 +23,14 @@ namespace Ra
         params.addParameter( "light.directional.direction", m_direction );
     }
 
+    void Engine::DirectionalLight::getLightBlock( LightBlock& block ) const
+    {
+        Light::getLightBlock( block );
+
+        for ( uint i = 0; i < 3; ++i )
+        {
+            block.dirDirection[i] = float( m_direction[i] );
+        }
+    }
+
 }
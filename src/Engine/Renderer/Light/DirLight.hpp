@@ -18,6 +18,7 @@ namespace Ra
             virtual ~DirectionalLight();
 
             virtual void getRenderParameters( RenderParameters& params ) override;
+            virtual void getLightBlock( LightBlock& block ) const override;
 
             virtual void setDirection( const Core::Vector3& pos ) override;
             inline const Core::Vector3& getDirection() const;
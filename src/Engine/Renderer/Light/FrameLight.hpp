@@ -0,0 +1,31 @@
+#ifndef RADIUMENGINE_FRAMELIGHT_HPP
+#define RADIUMENGINE_FRAMELIGHT_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <Core/Math/LinearAlgebra.hpp>
+
+#include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBlocks.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        /// Values of a light used to draw a frame, copied by Light::getFrameLight() when the
+        /// renderer prepares the frame (see Renderer::prepareFrame()), so that the light can be
+        /// edited by the tasks of the next frame while the frame is drawn.
+        struct FrameLight
+        {
+            RenderParameters m_params;  ///< See Light::getRenderParameters().
+            LightBlock m_block;         ///< See Light::getLightBlock().
+
+            bool m_bounded;             ///< See Light::getInfluenceSphere().
+            Core::Vector3 m_center;
+            Scalar m_radius;
+        };
+
+    } // namespace Engine
+} // namespace Ra
+
+#endif // RADIUMENGINE_FRAMELIGHT_HPP
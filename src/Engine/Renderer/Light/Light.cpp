@@ -1,6 +1,8 @@
 #include <Engine/Renderer/Light/Light.hpp>
 
+#include <Engine/Renderer/Light/FrameLight.hpp>
 #include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBlocks.hpp>
 
 namespace Ra
 {
@@ -22,4 +24,29 @@ namespace Ra
         params.addParameter( "light.type", m_type );
     }
 
+    void Engine::Light::getLightBlock( LightBlock& block ) const
+    {
+        block = LightBlock();
+        block.type = m_type;
+        for ( uint i = 0; i < 4; ++i )
+        {
+            block.color[i] = float( m_color[i] );
+        }
+    }
+
+    bool Engine::Light::getInfluenceSphere( Core::Vector3& center, Scalar& radius ) const
+    {
+        CORE_UNUSED( center );
+        CORE_UNUSED( radius );
+        return false;
+    }
+
+    void Engine::Light::getFrameLight( FrameLight& light )
+    {
+        light.m_params = RenderParameters();
+        getRenderParameters( light.m_params );
+        getLightBlock( light.m_block );
+        light.m_bounded = getInfluenceSphere( light.m_center, light.m_radius );
+    }
+
 }
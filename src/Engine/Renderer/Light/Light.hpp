@@ -9,6 +9,8 @@ namespace Ra
     namespace Engine
     {
         class RenderParameters;
+        struct LightBlock;
+        struct FrameLight;
     }
 }
 
@@ -43,6 +45,18 @@ namespace Ra
 
             virtual void getRenderParameters( RenderParameters& params );
 
+            /// Fill the std140 representation of the light used by the shared
+            /// light uniform buffer.
+            virtual void getLightBlock( LightBlock& block ) const;
+
+            /// Get the world space sphere outside of which the light contribution is
+            /// negligible, used for light culling. Returns false if the light reaches the
+            /// whole scene, which is the default.
+            virtual bool getInfluenceSphere( Core::Vector3& center, Scalar& radius ) const;
+
+            /// Copy the values used to draw a frame (see FrameLight).
+            void getFrameLight( FrameLight& light );
+
         private:
             Core::Color m_color;
 
@@ -1,6 +1,9 @@
 #include <Engine/Renderer/Light/PointLight.hpp>
 
 #include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBlocks.hpp>
+
+#include <algorithm>
 
 namespace Ra
 {
@@ -26,4 +29,46 @@ namespace Ra
         params.addParameter( "light.point.attenuation.quadratic", m_attenuation.quadratic );
     }
 
+    void Engine::PointLight::getLightBlock( LightBlock& block ) const
+    {
+        Light::getLightBlock( block );
+
+        for ( uint i = 0; i < 3; ++i )
+        {
+            block.pointPosition[i] = float( m_position[i] );
+        }
+        block.pointAttenuation[0] = float( m_attenuation.constant );
+        block.pointAttenuation[1] = float( m_attenuation.linear );
+        block.pointAttenuation[2] = float( m_attenuation.quadratic );
+    }
+
+    bool Engine::PointLight::getInfluenceSphere( Core::Vector3& center, Scalar& radius ) const
+    {
+        // Distance at which the attenuated intensity falls under 1/256 of the light color,
+        // i.e. where constant + linear * d + quadratic * d^2 reaches 256 * color.
+        const Scalar cutoff = 256 * std::max( getColor().head<3>().maxCoeff(), Scalar( 0 ) );
+        const Scalar c = m_attenuation.constant - cutoff;
+        const Scalar l = m_attenuation.linear;
+        const Scalar q = m_attenuation.quadratic;
+
+        center = m_position;
+        if ( c >= 0 )
+        {
+            radius = 0;
+        }
+        else if ( q > 0 )
+        {
+            radius = ( -l + std::sqrt( l * l - 4 * q * c ) ) / ( 2 * q );
+        }
+        else if ( l > 0 )
+        {
+            radius = -c / l;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
 }
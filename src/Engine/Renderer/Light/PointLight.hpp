@@ -28,6 +28,8 @@ namespace Ra
             virtual ~PointLight();
 
             virtual void getRenderParameters( RenderParameters& params ) override;
+            virtual void getLightBlock( LightBlock& block ) const override;
+            virtual bool getInfluenceSphere( Core::Vector3& center, Scalar& radius ) const override;
 
             virtual void setPosition( const Core::Vector3& pos ) override;
             inline const Core::Vector3& getPosition() const;
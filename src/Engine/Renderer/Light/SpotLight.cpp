@@ -1,6 +1,7 @@
 #include <Engine/Renderer/Light/SpotLight.hpp>
 
 #include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBlocks.hpp>
 
 namespace Ra
 {
@@ -29,4 +30,20 @@ namespace Ra
         params.addParameter( "light.spot.attenuation.quadratic", m_attenuation.quadratic );
     }
 
+    void Engine::SpotLight::getLightBlock( LightBlock& block ) const
+    {
+        Light::getLightBlock( block );
+
+        for ( uint i = 0; i < 3; ++i )
+        {
+            block.spotPosition[i]  = float( m_position[i] );
+            block.spotDirection[i] = float( m_direction[i] );
+        }
+        block.spotAttenuation[0] = float( m_attenuation.constant );
+        block.spotAttenuation[1] = float( m_attenuation.linear );
+        block.spotAttenuation[2] = float( m_attenuation.quadratic );
+        block.spotInnerAngle = float( m_innerAngle );
+        block.spotOuterAngle = float( m_outerAngle );
+    }
+
 }
@@ -30,6 +30,7 @@ namespace Ra
             virtual ~SpotLight();
 
             virtual void getRenderParameters( RenderParameters& params ) override;
+            virtual void getLightBlock( LightBlock& block ) const override;
 
             virtual void setPosition( const Core::Vector3& position ) override;
             inline const Core::Vector3& getPosition() const;
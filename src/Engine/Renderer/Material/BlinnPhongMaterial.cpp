@@ -8,6 +8,7 @@ namespace Ra {
     BlinnPhongMaterial::BlinnPhongMaterial(const std::string &name) : Material(name, Material::MaterialType::MAT_OPAQUE)
         , m_kd(0.9, 0.9, 0.9, 1.0), m_ks(0.0, 0.0, 0.0, 1.0), m_ns(1.0), m_alpha(1.0)
     {
+        updateFrameParameters();
     }
 
     BlinnPhongMaterial::~BlinnPhongMaterial()
@@ -35,17 +36,31 @@ namespace Ra {
         m_isDirty = false;
     }
 
+    void BlinnPhongMaterial::updateFrameParameters()
+    {
+        m_frameParameters.m_kd = m_kd;
+        m_frameParameters.m_ks = m_ks;
+        m_frameParameters.m_ns = m_ns;
+        m_frameParameters.m_alpha = m_alpha;
+        for (uint i = 0; i < m_frameParameters.m_textures.size(); ++i)
+        {
+            m_frameParameters.m_textures[i] = getTexture(TextureType(i));
+        }
+    }
+
     void BlinnPhongMaterial::bind(const ShaderProgram *shader)
     {
-        shader->setUniform("material.kd", m_kd);
-        shader->setUniform("material.ks", m_ks);
-        shader->setUniform("material.ns", m_ns);
-        shader->setUniform("material.alpha", m_alpha);
+        const FrameParameters &frame = m_frameParameters;
+
+        shader->setUniform("material.kd", frame.m_kd);
+        shader->setUniform("material.ks", frame.m_ks);
+        shader->setUniform("material.ns", frame.m_ns);
+        shader->setUniform("material.alpha", frame.m_alpha);
 
         Texture *tex = nullptr;
         uint texUnit = 0;
 
-        tex = getTexture(BlinnPhongMaterial::TextureType::TEX_DIFFUSE);
+        tex = frame.m_textures[uint(TextureType::TEX_DIFFUSE)];
         if (tex != nullptr)
         {
             tex->bind(texUnit);
@@ -58,7 +73,7 @@ namespace Ra {
             shader->setUniform("material.tex.hasKd", 0);
         }
 
-        tex = getTexture(BlinnPhongMaterial::TextureType::TEX_SPECULAR);
+        tex = frame.m_textures[uint(TextureType::TEX_SPECULAR)];
         if (tex != nullptr)
         {
             tex->bind(texUnit);
@@ -71,7 +86,7 @@ namespace Ra {
             shader->setUniform("material.tex.hasKs", 0);
         }
 
-        tex = getTexture(BlinnPhongMaterial::TextureType::TEX_NORMAL);
+        tex = frame.m_textures[uint(TextureType::TEX_NORMAL)];
         if (tex != nullptr)
         {
             tex->bind(texUnit);
@@ -84,7 +99,7 @@ namespace Ra {
             shader->setUniform("material.tex.hasNormal", 0);
         }
 
-        tex = getTexture(BlinnPhongMaterial::TextureType::TEX_SHININESS);
+        tex = frame.m_textures[uint(TextureType::TEX_SHININESS)];
         if (tex != nullptr)
         {
             tex->bind(texUnit);
@@ -97,7 +112,7 @@ namespace Ra {
             shader->setUniform("material.tex.hasNs", 0);
         }
 
-        tex = getTexture(BlinnPhongMaterial::TextureType::TEX_ALPHA);
+        tex = frame.m_textures[uint(TextureType::TEX_ALPHA)];
         if (tex != nullptr)
         {
             tex->bind(texUnit);
@@ -3,6 +3,7 @@
 
 #include <Engine/RaEngine.hpp>
 
+#include <array>
 #include <map>
 #include <string>
 
@@ -36,6 +37,8 @@ namespace Ra {
 
         void updateGL() override;
         void bind(const ShaderProgram *shader) override;
+
+        void updateFrameParameters() override;
         bool isTransparent () const override;
 
         inline void addTexture(const TextureType &type, Texture *texture);
@@ -43,6 +46,18 @@ namespace Ra {
         inline TextureData &addTexture(const TextureType &type, const TextureData &texture);
         inline Texture *getTexture(const TextureType &type) const;
 
+        /// Parameters drawn by bind(), copied by updateFrameParameters().
+        struct FrameParameters
+        {
+            Core::Color m_kd;
+            Core::Color m_ks;
+            Scalar m_ns;
+            Scalar m_alpha;
+            std::array<Texture *, 5> m_textures;    // Indexed by TextureType.
+        };
+
+        inline const FrameParameters &getFrameParameters() const;
+
     public:
         Core::Color m_kd;
         Core::Color m_ks;
@@ -53,6 +68,8 @@ namespace Ra {
         std::map<TextureType, Texture *> m_textures;
         std::map<TextureType, TextureData> m_pendingTextures;
 
+        FrameParameters m_frameParameters;
+
     };
 
 }
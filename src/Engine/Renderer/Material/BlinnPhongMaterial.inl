@@ -26,6 +26,10 @@ namespace Ra {
     inline TextureData &BlinnPhongMaterial::addTexture(const TextureType &type, const TextureData &texture)
     {
         m_pendingTextures[type] = texture;
+        if (type == TextureType::TEX_NORMAL)
+        {
+            m_pendingTextures[type].usage = TextureData::NORMAL_MAP;
+        }
         m_isDirty = true;
 
         return m_pendingTextures[type];
@@ -43,6 +47,11 @@ namespace Ra {
 
         return tex;
     }
+
+    inline const BlinnPhongMaterial::FrameParameters &BlinnPhongMaterial::getFrameParameters() const
+    {
+        return m_frameParameters;
+    }
   }
 }
 
@@ -13,6 +13,10 @@ namespace Ra {
     {
     }
 
+    void Material::updateFrameParameters()
+    {
+    }
+
     bool Material::isTransparent() const
     {
         return m_type == MaterialType::MAT_TRANSPARENT;
@@ -41,6 +41,11 @@ namespace Ra {
 
         virtual void bind(const ShaderProgram *shader) = 0;
 
+        /// Copy the parameters read by bind(), which draws the copy. Called when the renderer
+        /// prepares a frame, so that the parameters can be edited while the frame is drawn
+        /// (see Renderer::prepareFrame()). Does nothing by default.
+        virtual void updateFrameParameters();
+
         inline const std::string &getName() const;
 
         inline void setMaterialType(const MaterialType &type);
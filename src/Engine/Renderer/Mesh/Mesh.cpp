@@ -4,7 +4,12 @@
 
 #include <Core/Mesh/MeshUtils.hpp>
 #include <Core/Mesh/HalfEdge.hpp>
+#include <Core/Mesh/VertexPacking.hpp>
+#include <Core/Geometry/PointCloud/PointCloud.hpp>
 #include <Engine/Renderer/OpenGL/OpenGL.hpp>
+#include <Engine/Renderer/RenderStatistics.hpp>
+#include <Engine/Renderer/RenderTechnique/ShaderProgram.hpp>
+
 namespace Ra {
     namespace Engine {
 
@@ -16,6 +21,8 @@ namespace Ra {
             , m_renderMode(renderMode)
             , m_numElements (0)
             , m_isDirty( false )
+            , m_packed( false )
+            , m_shortIndices( false )
         {
             CORE_ASSERT( m_renderMode == RM_POINTS
                       || m_renderMode == RM_LINES
@@ -49,21 +56,86 @@ namespace Ra {
         {
             if ( m_vao != 0 )
             {
+                ++getCurrentRenderStatistics().m_drawCalls;
+                GL_ASSERT( glBindVertexArray( m_vao ) );
+                GL_ASSERT( glDrawElements( static_cast<GLenum >(m_renderMode), m_numElements,
+                                           m_shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)0 ) );
+            }
+        }
+
+        void Mesh::renderInstanced( uint instanceBuffer, std::size_t offset, uint count )
+        {
+            if ( m_vao != 0 && count > 0 )
+            {
+                RenderStatistics& stats = getCurrentRenderStatistics();
+                ++stats.m_drawCalls;
+                ++stats.m_instancedDrawCalls;
+                stats.m_instances += count;
+
                 GL_ASSERT( glBindVertexArray( m_vao ) );
-                GL_ASSERT( glDrawElements( static_cast<GLenum >(m_renderMode), m_numElements, GL_UNSIGNED_INT, (void*)0 ) );
+                GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, instanceBuffer ) );
+
+                // Two mat4 per instance, one attribute per column.
+                const GLsizei stride = 2 * sizeof( Core::Matrix4f );
+                for ( uint c = 0; c < 8; ++c )
+                {
+                    const GLuint attrib = INSTANCE_ATTRIB + c;
+                    GL_ASSERT( glEnableVertexAttribArray( attrib ) );
+                    GL_ASSERT( glVertexAttribPointer( attrib, 4, GL_FLOAT, GL_FALSE, stride,
+                                                      (GLvoid*)( offset + c * sizeof( Core::Vector4f ) ) ) );
+                    GL_ASSERT( glVertexAttribDivisor( attrib, 1 ) );
+                }
+
+                GL_ASSERT( glDrawElementsInstanced( static_cast<GLenum >(m_renderMode), m_numElements,
+                                                    m_shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                                                    (void*)0, count ) );
+
+                for ( uint c = 0; c < 8; ++c )
+                {
+                    GL_ASSERT( glDisableVertexAttribArray( INSTANCE_ATTRIB + c ) );
+                }
+            }
+        }
+
+        void Mesh::setPackedVertices( bool packed )
+        {
+            if ( packed != m_packed )
+            {
+                // All the buffers are sent again with their new format.
+                m_packed = packed;
+                for ( auto& dirty : m_dataDirty )
+                {
+                    dirty = true;
+                }
+                m_isDirty = true;
+            }
+        }
+
+        void Mesh::bindVertexFormat( const ShaderProgram* shader ) const
+        {
+            shader->setUniform( ShaderProgram::DRAW_PACKED_VERTICES, int( m_packed ) );
+            if ( m_packed )
+            {
+                shader->setUniform( ShaderProgram::DRAW_PACKED_POSITION_MIN, Core::Vector3( m_positionBox.min() ) );
+                shader->setUniform( ShaderProgram::DRAW_PACKED_POSITION_EXTENT, Core::Vector3( m_positionBox.sizes() ) );
             }
         }
 
         void Mesh::loadGeometry(const Core::TriangleMesh& mesh)
         {
-            m_mesh = mesh;
+            loadGeometry( Core::TriangleMesh( mesh ) );
+        }
+
+        void Mesh::loadGeometry(Core::TriangleMesh&& mesh)
+        {
+            m_mesh = std::move( mesh );
 
             if (m_mesh.m_triangles.empty()) {
-                m_numElements = mesh.m_vertices.size();
+                m_numElements = m_mesh.m_vertices.size();
                 m_renderMode = RM_POINTS;
             }
             else
-                m_numElements = mesh.m_triangles.size() * 3;
+                m_numElements = m_mesh.m_triangles.size() * 3;
 
             for (uint i = 0; i < MAX_MESH; ++i)
             {
@@ -107,6 +179,7 @@ namespace Ra {
                 // (L00, L01, L10), (L11, L20, L21) etc. We fill the missing by wrapping around indices.
                 m_mesh.m_triangles.push_back( { indices[i], indices[(i + 1)%nIdx], indices[(i + 2)%nIdx] } );
             }
+            m_mesh.invalidateTopology();
 
             // Mark mesh as dirty.
             for (uint i = 0; i < MAX_MESH; ++i)
@@ -119,14 +192,24 @@ namespace Ra {
 
         void Mesh::addData( const Vec3Data& type, const Core::Vector3Array& data )
         {
-            m_v3Data[static_cast<uint>(type)] = data;
+            addData( type, Core::Vector3Array( data ) );
+        }
+
+        void Mesh::addData( const Vec4Data& type, const Core::Vector4Array& data )
+        {
+            addData( type, Core::Vector4Array( data ) );
+        }
+
+        void Mesh::addData( const Vec3Data& type, Core::Vector3Array&& data )
+        {
+            m_v3Data[static_cast<uint>(type)] = std::move( data );
             m_dataDirty[MAX_MESH + static_cast<uint>(type)] = true;
             m_isDirty = true;
         }
 
-        void Mesh::addData( const Vec4Data& type, const Core::Vector4Array& data )
+        void Mesh::addData( const Vec4Data& type, Core::Vector4Array&& data )
         {
-            m_v4Data[static_cast<uint>(type)] = data;
+            m_v4Data[static_cast<uint>(type)] = std::move( data );
             m_dataDirty[MAX_MESH + MAX_VEC3 + static_cast<uint>(type)] = true;
             m_isDirty = true;
         }
@@ -141,34 +224,91 @@ namespace Ra {
 #else
             GLenum type = GL_FLOAT;
 #endif
-            constexpr GLuint size = VecArray::Vector::RowsAtCompileTime;
-            const GLboolean normalized  = GL_FALSE;
+            sendGLData( arr.data(), arr.size(), sizeof( typename VecArray::Vector ), vboIdx,
+                        VecArray::Vector::RowsAtCompileTime, static_cast<uint>( type ), false );
+        }
+
+        void Mesh::sendGLData( const void* data, std::size_t count, std::size_t elementSize, const uint vboIdx,
+                               int components, uint glType, bool normalized )
+        {
             constexpr GLint64 ptr = 0;
 
             // This vbo has not been created yet
-            if ( m_vbos[vboIdx] == 0 && arr.size() > 0 )
+            if ( m_vbos[vboIdx] == 0 && count > 0 )
             {
                 GL_ASSERT( glGenBuffers( 1, &m_vbos[vboIdx] ) );
-                GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[vboIdx] ) );
-
-                // Use (vboIdx - 1) as attribute index because vbo 0 is actually ibo.
-                GL_ASSERT( glVertexAttribPointer( vboIdx - 1, size, type, normalized,
-                                                  sizeof( typename VecArray::Vector ), (GLvoid*)ptr ) );
-
-                GL_ASSERT( glEnableVertexAttribArray( vboIdx - 1 ) );
                 // Set dirty as true to send data, see below
                 m_dataDirty[vboIdx] = true;
             }
 
-            if ( m_dataDirty[vboIdx] == true && m_vbos[vboIdx] != 0 && arr.size() > 0 )
+            if ( m_dataDirty[vboIdx] == true && m_vbos[vboIdx] != 0 && count > 0 )
             {
                 GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[vboIdx] ) );
-                GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, arr.size() * sizeof( typename VecArray::Vector ),
-                arr.data(), GL_DYNAMIC_DRAW ) );
+
+                // The format is set with the data, as it changes with setPackedVertices().
+                // Use (vboIdx - 1) as attribute index because vbo 0 is actually ibo.
+                GL_ASSERT( glVertexAttribPointer( vboIdx - 1, components, static_cast<GLenum>( glType ),
+                                                  normalized ? GL_TRUE : GL_FALSE, elementSize, (GLvoid*)ptr ) );
+                GL_ASSERT( glEnableVertexAttribArray( vboIdx - 1 ) );
+
+                GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, count * elementSize, data, GL_DYNAMIC_DRAW ) );
                 m_dataDirty[vboIdx] = false;
             }
         }
 
+        void Mesh::sendPackedGLData()
+        {
+            using namespace Core::VertexPacking;
+            const uint unsignedShort = static_cast<uint>( GL_UNSIGNED_SHORT );
+            const uint signedShort = static_cast<uint>( GL_SHORT );
+
+            if ( m_dataDirty[VERTEX_POSITION] )
+            {
+                m_positionBox = Core::PointCloud::aabb( m_mesh.m_vertices );
+                std::vector<Position16> positions;
+                packPositions( m_mesh.m_vertices, m_positionBox, positions );
+                sendGLData( positions.data(), positions.size(), sizeof( Position16 ), VERTEX_POSITION,
+                            3, unsignedShort, true );
+            }
+
+            std::vector<Direction16> directions;
+            if ( m_dataDirty[VERTEX_NORMAL] )
+            {
+                packDirections( m_mesh.m_normals, directions );
+                sendGLData( directions.data(), directions.size(), sizeof( Direction16 ), VERTEX_NORMAL,
+                            2, signedShort, true );
+            }
+            for ( uint type : { VERTEX_TANGENT, VERTEX_BITANGENT } )
+            {
+                if ( m_dataDirty[MAX_MESH + type] )
+                {
+                    packDirections( m_v3Data[type], directions );
+                    sendGLData( directions.data(), directions.size(), sizeof( Direction16 ), MAX_MESH + type,
+                                2, signedShort, true );
+                }
+            }
+
+            if ( m_dataDirty[MAX_MESH + VERTEX_TEXCOORD] )
+            {
+                std::vector<TexCoord16> texCoords;
+                packTexCoords( m_v3Data[VERTEX_TEXCOORD], texCoords );
+                sendGLData( texCoords.data(), texCoords.size(), sizeof( TexCoord16 ), MAX_MESH + VERTEX_TEXCOORD,
+                            2, static_cast<uint>( GL_HALF_FLOAT ), false );
+            }
+
+            if ( m_dataDirty[MAX_MESH + MAX_VEC3 + VERTEX_COLOR] )
+            {
+                std::vector<Color8> colors;
+                packColors( m_v4Data[VERTEX_COLOR], colors );
+                sendGLData( colors.data(), colors.size(), sizeof( Color8 ), MAX_MESH + MAX_VEC3 + VERTEX_COLOR,
+                            4, static_cast<uint>( GL_UNSIGNED_BYTE ), true );
+            }
+
+            // Skinning weights keep their full precision.
+            sendGLData(m_v4Data[VERTEX_WEIGHTS],    MAX_MESH + MAX_VEC3 + VERTEX_WEIGHTS);
+            sendGLData(m_v4Data[VERTEX_WEIGHT_IDX], MAX_MESH + MAX_VEC3 + VERTEX_WEIGHT_IDX);
+        }
+
         void Mesh::updateGL()
         {
             if ( m_isDirty )
@@ -195,11 +335,29 @@ namespace Ra {
                 }
                 if (m_dataDirty[INDEX])
                 {
+                    m_shortIndices = m_packed && Core::VertexPacking::fitsShortIndices( m_mesh.m_vertices.size() );
                     if (m_renderMode == RM_POINTS)
                     {
-                        std::vector<int> indices(m_numElements);
-                        std::iota(indices.begin(), indices.end(), 0);
-                        GL_ASSERT( glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_numElements * sizeof( int ),
+                        if ( m_shortIndices )
+                        {
+                            std::vector<uint16_t> indices(m_numElements);
+                            std::iota(indices.begin(), indices.end(), 0);
+                            GL_ASSERT( glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_numElements * sizeof( uint16_t ),
+                                                     indices.data(), GL_DYNAMIC_DRAW ) );
+                        }
+                        else
+                        {
+                            std::vector<int> indices(m_numElements);
+                            std::iota(indices.begin(), indices.end(), 0);
+                            GL_ASSERT( glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_numElements * sizeof( int ),
+                                                     indices.data(), GL_DYNAMIC_DRAW ) );
+                        }
+                    }
+                    else if ( m_shortIndices )
+                    {
+                        std::vector<uint16_t> indices;
+                        Core::VertexPacking::packIndices( m_mesh.m_triangles, indices );
+                        GL_ASSERT( glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( uint16_t ),
                                                  indices.data(), GL_DYNAMIC_DRAW ) );
                     }
                     else
@@ -210,19 +368,26 @@ namespace Ra {
                     m_dataDirty[INDEX] = false;
                 }
 
-                // Geometry data
-                sendGLData(m_mesh.m_vertices, VERTEX_POSITION);
-                sendGLData(m_mesh.m_normals,  VERTEX_NORMAL);
-
-                // Vec3 data
-                sendGLData(m_v3Data[VERTEX_TANGENT],   MAX_MESH + VERTEX_TANGENT);
-                sendGLData(m_v3Data[VERTEX_BITANGENT], MAX_MESH + VERTEX_BITANGENT);
-                sendGLData(m_v3Data[VERTEX_TEXCOORD],  MAX_MESH + VERTEX_TEXCOORD);
-
-                // Vec4 data
-                sendGLData(m_v4Data[VERTEX_COLOR],      MAX_MESH + MAX_VEC3 + VERTEX_COLOR );
-                sendGLData(m_v4Data[VERTEX_WEIGHTS],    MAX_MESH + MAX_VEC3 + VERTEX_WEIGHTS);
-                sendGLData(m_v4Data[VERTEX_WEIGHT_IDX], MAX_MESH + MAX_VEC3 + VERTEX_WEIGHT_IDX);
+                if ( m_packed )
+                {
+                    sendPackedGLData();
+                }
+                else
+                {
+                    // Geometry data
+                    sendGLData(m_mesh.m_vertices, VERTEX_POSITION);
+                    sendGLData(m_mesh.m_normals,  VERTEX_NORMAL);
+
+                    // Vec3 data
+                    sendGLData(m_v3Data[VERTEX_TANGENT],   MAX_MESH + VERTEX_TANGENT);
+                    sendGLData(m_v3Data[VERTEX_BITANGENT], MAX_MESH + VERTEX_BITANGENT);
+                    sendGLData(m_v3Data[VERTEX_TEXCOORD],  MAX_MESH + VERTEX_TEXCOORD);
+
+                    // Vec4 data
+                    sendGLData(m_v4Data[VERTEX_COLOR],      MAX_MESH + MAX_VEC3 + VERTEX_COLOR );
+                    sendGLData(m_v4Data[VERTEX_WEIGHTS],    MAX_MESH + MAX_VEC3 + VERTEX_WEIGHTS);
+                    sendGLData(m_v4Data[VERTEX_WEIGHT_IDX], MAX_MESH + MAX_VEC3 + VERTEX_WEIGHT_IDX);
+                }
 
                 GL_ASSERT( glBindVertexArray( 0 ) );
                 GL_CHECK_ERROR;
@@ -16,6 +16,7 @@ namespace Ra
 {
     namespace Engine
     {
+        class ShaderProgram;
 
         // FIXME(Charly): If I want to draw a mesh as lines, points, etc,
         //                should I send lines, ... to the GPU, or handle the way
@@ -92,6 +93,10 @@ namespace Ra
             /// Total number of vertex attributes.
             constexpr static uint MAX_DATA = MAX_MESH + MAX_VEC3 + MAX_VEC4;
 
+            /// First of the 8 attributes holding the model and normal matrices of instanced draws
+            /// (after the attributes of the vertex data, which start at 0).
+            constexpr static uint INSTANCE_ATTRIB = MAX_DATA - 1;
+
         public:
             Mesh( const std::string& name, MeshRenderMode renderMode = RM_TRIANGLES );
             ~Mesh();
@@ -110,6 +115,9 @@ namespace Ra
             /// Use the given geometry as base for a display mesh. Normals are optionnal.
             void loadGeometry( const Core::TriangleMesh& mesh);
 
+            /// Same as above, but the arrays of mesh are moved instead of copied.
+            void loadGeometry( Core::TriangleMesh&& mesh);
+
             void updateMeshGeometry(MeshData type, const Core::Vector3Array& data);
 
             // TODO (val) : remove this function (it is used mostly in the display primitives)
@@ -119,6 +127,10 @@ namespace Ra
             void addData( const Vec3Data& type, const Core::Vector3Array& data);
             void addData( const Vec4Data& type, const Core::Vector4Array& data);
 
+            /// Same as above, but data is moved instead of copied.
+            void addData( const Vec3Data& type, Core::Vector3Array&& data);
+            void addData( const Vec4Data& type, Core::Vector4Array&& data);
+
             /// Access the additionnal data arrays by type.
             inline const Core::Vector3Array& getData( const Vec3Data& type ) const;
             inline const Core::Vector4Array& getData( const Vec4Data& type ) const;
@@ -137,6 +149,22 @@ namespace Ra
             /// Draw the mesh.
             void render();
 
+            /// Draw count instances of the mesh. Each instance reads its model matrix then its
+            /// normal matrix (column major float 4x4 matrices) in instanceBuffer, starting at
+            /// the given byte offset.
+            void renderInstanced( uint instanceBuffer, std::size_t offset, uint count );
+
+            /// Upload the attributes with the compact formats of Core::VertexPacking (except
+            /// the skinning weights), and the indices as 16 bit integers when the vertex count
+            /// allows it. The CPU data is unchanged. Shaders decode the attributes with the
+            /// functions of VertexPacking.glsl. Disabled by default.
+            void setPackedVertices( bool packed );
+            inline bool hasPackedVertices() const;
+
+            /// Set the uniforms decoding the attributes of this mesh in shader.
+            /// Must be called before render() by the shaders including VertexPacking.glsl.
+            void bindVertexFormat( const ShaderProgram* shader ) const;
+
         private:
             Mesh(const Mesh& rhs) = delete;
             void operator=(const Mesh& rhs) = delete;
@@ -145,6 +173,13 @@ namespace Ra
             template < typename VecArray >
             void sendGLData( const VecArray& arr, const uint vboIdx );
 
+            /// Send count elements of the given size and openGL format to a buffer.
+            void sendGLData( const void* data, std::size_t count, std::size_t elementSize, const uint vboIdx,
+                             int components, uint glType, bool normalized );
+
+            /// Pack and send the dirty attributes when m_packed is set.
+            void sendPackedGLData();
+
         private:
             std::string m_name;  /// Name of the mesh.
 
@@ -171,6 +206,10 @@ namespace Ra
 
             bool m_isDirty; /// General dirty bit of the mesh.
             // TODO (Val) this flag could just be replaced by an efficient "or" of the other flags.
+
+            bool m_packed;             /// Attributes are uploaded with packed formats.
+            bool m_shortIndices;       /// The index buffer holds 16 bit indices.
+            Core::Aabb m_positionBox;  /// Box in which the packed positions are quantized.
         };
 
     } // namespace Engine
@@ -14,6 +14,11 @@ namespace Engine {
         m_renderMode = mode;
     }
 
+    bool Mesh::hasPackedVertices() const
+    {
+        return m_packed;
+    }
+
     const Core::TriangleMesh &Mesh::getGeometry() const { return m_mesh; }
           Core::TriangleMesh &Mesh::getGeometry()       { return m_mesh; }
 
@@ -37,7 +42,16 @@ namespace Engine {
         return m_v4Data[static_cast<uint>(type)];
     }
 
-    void Mesh::setDirty(const Mesh::MeshData &type) { m_dataDirty[type] = true; m_isDirty = true;}
+    void Mesh::setDirty(const Mesh::MeshData &type)
+    {
+        m_dataDirty[type] = true;
+        m_isDirty = true;
+        // The indices may have been written in place.
+        if ( type == INDEX )
+        {
+            m_mesh.invalidateTopology();
+        }
+    }
     void Mesh::setDirty(const Mesh::Vec3Data &type) { m_dataDirty[MAX_MESH + type] = true; m_isDirty = true;}
     void Mesh::setDirty(const Mesh::Vec4Data &type) { m_dataDirty[MAX_MESH + MAX_VEC3 + type ] = true ; m_isDirty = true;}
 
@@ -515,19 +515,19 @@ namespace Ra {
             
             MeshPtr Spline(const Core::Spline<3, 3> &spline, uint pointCount, const Core::Color &color, Scalar scale)
             {
-                Core::Vector3Array vertices;
-                vertices.reserve(pointCount);
-                
-                std::vector<uint> indices;
-                indices.reserve(pointCount * 2 - 2);
-                
+                std::vector<Scalar> us(pointCount);
                 Scalar dt = Scalar(1) / Scalar(pointCount - 1);
                 for (uint i = 0; i < pointCount; ++i)
                 {
-                    Scalar t = dt * i;
-                    vertices.push_back(spline.f(t));
+                    us[i] = dt * i;
                 }
                 
+                Core::Vector3Array vertices;
+                spline.evaluate(us, vertices);
+                
+                std::vector<uint> indices;
+                indices.reserve(pointCount * 2 - 2);
+                
                 for (uint i = 0; i < pointCount - 1; ++i)
                 {
                     indices.push_back(i);
@@ -4,6 +4,7 @@
 #include <Core/File/GeometryData.hpp>
 #include <Core/Geometry/Normal/Normal.hpp>
 #include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Math/TransformHierarchy.hpp>
 
 #include <Engine/Component/Component.hpp>
 #include <Engine/Entity/Entity.hpp>
@@ -19,12 +20,16 @@
 #include <Engine/Renderer/RenderObject/RenderObjectManager.hpp>
 #include <Engine/Renderer/Material/Material.hpp>
 #include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
+#include <Engine/Renderer/RenderQueue/RenderQueue.hpp>
 
 namespace Ra {
     namespace Engine {
         RenderObject::RenderObject(const std::string &name, Component *comp,
                                    const RenderObjectType &type, int lifetime)
-        : IndexedObject(), m_localTransform(Core::Transform::Identity()), m_component(comp), m_name(name), m_type(type),
+        : IndexedObject(), m_localTransform(Core::Transform::Identity()),
+        m_transformNode(), m_localTransformChanged(false), m_transformPublished(false),
+        m_frameModelMatrix(Core::Matrix4::Identity()), m_frameNormalMatrix(Core::Matrix4::Identity()),
+        m_component(comp), m_name(name), m_type(type),
         m_renderTechnique(nullptr), m_mesh(nullptr), m_lifetime(lifetime), m_visible(true), m_pickable(true),
         m_xray(false), m_transparent(false), m_dirty(true), m_hasLifetime(lifetime > 0)
         {
@@ -123,11 +128,13 @@ namespace Ra {
         void RenderObject::setXRay(bool xray)
         {
             m_xray = xray;
+            invalidateRenderQueues();
         }
         
         void RenderObject::toggleXRay()
         {
             m_xray = !m_xray;
+            invalidateRenderQueues();
         }
         
         bool RenderObject::isXRay() const
@@ -138,11 +145,13 @@ namespace Ra {
         void RenderObject::setTransparent(bool transparent)
         {
             m_transparent = transparent;
+            invalidateRenderQueues();
         }
         
         void RenderObject::toggleTransparent()
         {
             m_transparent = !m_transparent;
+            invalidateRenderQueues();
         }
         
         bool RenderObject::isTransparent() const
@@ -169,6 +178,7 @@ namespace Ra {
         {
             CORE_ASSERT(technique, "Passing a nullptr as render technique");
             m_renderTechnique = technique;
+            invalidateRenderQueues();
         }
         
         std::shared_ptr<const RenderTechnique> RenderObject::getRenderTechnique() const
@@ -184,6 +194,7 @@ namespace Ra {
         void RenderObject::setMesh(const std::shared_ptr<Mesh> &mesh)
         {
             m_mesh = mesh;
+            invalidateRenderQueues();
         }
         
         std::shared_ptr<const Mesh> RenderObject::getMesh() const
@@ -198,6 +209,11 @@ namespace Ra {
         
         Core::Transform RenderObject::getTransform() const
         {
+            if (m_transformPublished)
+            {
+                return RadiumEngine::getInstance()->getTransformHierarchy()->getWorld(m_transformNode);
+            }
+            // Not in the hierarchy yet.
             return m_component->getEntity()->getTransform() * m_localTransform;
         }
         
@@ -206,6 +222,22 @@ namespace Ra {
             return getTransform().matrix();
         }
         
+        void RenderObject::updateFrameTransforms()
+        {
+            m_frameModelMatrix = getTransformAsMatrix();
+            m_frameNormalMatrix = m_frameModelMatrix.inverse().transpose();
+        }
+        
+        const Core::Matrix4& RenderObject::getFrameModelMatrix() const
+        {
+            return m_frameModelMatrix;
+        }
+        
+        const Core::Matrix4& RenderObject::getFrameNormalMatrix() const
+        {
+            return m_frameNormalMatrix;
+        }
+        
         Core::Aabb RenderObject::getAabb() const
         {
             Core::Aabb aabb = Core::MeshUtils::getAabb(m_mesh->getGeometry());
@@ -227,11 +259,12 @@ namespace Ra {
         void RenderObject::setLocalTransform(const Core::Transform &transform)
         {
             m_localTransform = transform;
+            m_localTransformChanged = true;
         }
         
         void RenderObject::setLocalTransform(const Core::Matrix4 &transform)
         {
-            m_localTransform = Core::Transform(transform);
+            setLocalTransform(Core::Transform(transform));
         }
         
         const Core::Transform &RenderObject::getLocalTransform() const
@@ -244,6 +277,11 @@ namespace Ra {
             return m_localTransform.matrix();
         }
         
+        Core::Index RenderObject::getTransformNode() const
+        {
+            return m_transformNode;
+        }
+        
         void RenderObject::hasBeenRenderedOnce()
         {
             if (m_hasLifetime)
@@ -265,32 +303,107 @@ namespace Ra {
                                   const RenderData &rdata,
                                   RenderTechnique::PassName passname)
         {
+            RenderState state;
+            render(lightParams, rdata, passname, state);
+        }
+        
+        void RenderObject::render(const RenderParameters &lightParams,
+                                  const RenderData &rdata,
+                                  RenderTechnique::PassName passname,
+                                  RenderState &state)
+        {
             
             if (m_visible)
             {
-                const ShaderProgram *shader = getRenderTechnique()->getShader(passname);
+                const ShaderProgram *shader = bind(lightParams, rdata, passname, state);
                 
                 if (!shader)
                 {
                     return;
                 }
                 
-                Core::Matrix4 M = getTransformAsMatrix();
-                Core::Matrix4 N = M.inverse().transpose();
+                shader->setUniform(ShaderProgram::TRANSFORM_MODEL, m_frameModelMatrix);
+                shader->setUniform(ShaderProgram::TRANSFORM_WORLDNORMAL, m_frameNormalMatrix);
                 
-                // bind data
+                // render
+                getMesh()->bindVertexFormat(shader);
+                getMesh()->render();
+            }
+        }
+        
+        void RenderObject::renderInstances(const RenderParameters &lightParams,
+                                           const RenderData &rdata,
+                                           RenderTechnique::PassName passname,
+                                           RenderState &state,
+                                           uint instanceBuffer, std::size_t offset, uint count)
+        {
+            const ShaderProgram *shader = bind(lightParams, rdata, passname, state);
+            
+            if (!shader)
+            {
+                return;
+            }
+            
+            // The transform uniforms are replaced by the instance attributes.
+            shader->setUniform(ShaderProgram::DRAW_INSTANCED, 1);
+            getMesh()->bindVertexFormat(shader);
+            getMesh()->renderInstanced(instanceBuffer, offset, count);
+            shader->setUniform(ShaderProgram::DRAW_INSTANCED, 0);
+        }
+        
+        const ShaderProgram* RenderObject::bind(const RenderParameters &lightParams,
+                                                const RenderData &rdata,
+                                                RenderTechnique::PassName passname,
+                                                RenderState &state)
+        {
+            const ShaderProgram *shader = getRenderTechnique()->getShader(passname);
+            
+            if (!shader)
+            {
+                return nullptr;
+            }
+            
+            RenderStatistics &stats = getCurrentRenderStatistics();
+            
+            // bind data
+            if (shader != state.m_shader)
+            {
                 shader->bind();
-                shader->setUniform("transform.proj", rdata.projMatrix);
-                shader->setUniform("transform.view", rdata.viewMatrix);
-                shader->setUniform("transform.model", M);
-                shader->setUniform("transform.worldNormal", N);
-                lightParams.bind(shader);
                 
-                getRenderTechnique()->getMaterial()->bind(shader);
+                // Camera and light data come from the shared uniform buffers
+                // when the shader declares the corresponding blocks.
+                if (!shader->hasUniformBlock(UNIFORM_BLOCK_CAMERA))
+                {
+                    shader->setUniform(ShaderProgram::TRANSFORM_PROJ, rdata.projMatrix);
+                    shader->setUniform(ShaderProgram::TRANSFORM_VIEW, rdata.viewMatrix);
+                }
                 
-                // render
-                getMesh()->render();
+                state.m_shader = shader;
+                state.m_material = nullptr;
+                state.m_params = nullptr;
+            }
+            else
+            {
+                ++stats.m_programBindsSkipped;
+            }
+            
+            if (!shader->hasUniformBlock(UNIFORM_BLOCK_LIGHT) && state.m_params != &lightParams)
+            {
+                lightParams.bind(shader);
+                state.m_params = &lightParams;
+            }
+            
+            const Material *material = getRenderTechnique()->getMaterial().get();
+            if (material != state.m_material)
+            {
+                getRenderTechnique()->getMaterial()->bind(shader);
+                state.m_material = material;
+            }
+            else
+            {
+                ++stats.m_materialBindsSkipped;
             }
+            return shader;
         }
         
     } // namespace Engine
@@ -3,6 +3,7 @@
 
 #include <Engine/RaEngine.hpp>
 
+#include <atomic>
 #include <string>
 #include <mutex>
 #include <memory>
@@ -34,6 +35,16 @@ namespace Ra
         
         struct RenderData;
         
+        /// GL state bound by the previous draw. It is shared by consecutive calls to
+        /// RenderObject::render() so that objects using the same shader, material or
+        /// render parameters do not bind them again (see RenderQueue).
+        struct RenderState
+        {
+            const ShaderProgram* m_shader = nullptr;
+            const Material* m_material = nullptr;
+            const RenderParameters* m_params = nullptr;
+        };
+        
         // FIXME(Charly): Does this need a bit of cleanup ?
         class RA_ENGINE_API RenderObject : public Core::IndexedObject
         {
@@ -113,17 +124,30 @@ namespace Ra
             std::shared_ptr<const Mesh> getMesh() const;
             const std::shared_ptr<Mesh>& getMesh();
 
+            /// World transform published by the transform hierarchy at the end of the last frame.
             Core::Transform getTransform() const;
             Core::Matrix4 getTransformAsMatrix() const;
 
+            /// Compute the model and normal matrices used to draw the object.
+            /// This is called once per frame by the renderer before any draw call,
+            /// so that the passes and lights do not recompute them for each draw.
+            void updateFrameTransforms();
+            const Core::Matrix4& getFrameModelMatrix() const;
+            const Core::Matrix4& getFrameNormalMatrix() const;
+
             Core::Aabb getAabb() const;
             Core::Aabb getMeshAabb() const;
 
+            /// The local transform is set in the transform hierarchy at the end of the frame.
             void setLocalTransform( const Core::Transform& transform );
             void setLocalTransform( const Core::Matrix4& transform );
             const Core::Transform& getLocalTransform() const;
             const Core::Matrix4& getLocalTransformAsMatrix() const;
 
+            /// Node of the render object in the transform hierarchy, child of the node
+            /// of its entity. Invalid if the object is not in the render object manager.
+            Core::Index getTransformNode() const;
+
             /// Basically just decreases lifetime counter.
             /// If it goes to zero, then render object notifies the manager that it needs to be deleted.
             /// Does nothing if lifetime is set to -1
@@ -133,8 +157,35 @@ namespace Ra
             //            virtual void render( const RenderParameters& lightParams, const RenderData& rdata, const ShaderProgram* altShader = nullptr );
             virtual void render( const RenderParameters& lightParams, const RenderData& rdata, RenderTechnique::PassName passname = RenderTechnique::LIGHTING_OPAQUE );
             
+            /// Same as above, skipping the bindings already done according to state, which is updated.
+            void render( const RenderParameters& lightParams, const RenderData& rdata, RenderTechnique::PassName passname,
+                         RenderState& state );
+
+            /// Draw count objects sharing the mesh, shader and material of this one with a single
+            /// instanced draw call. Their model and normal matrices are read in instanceBuffer,
+            /// from the given byte offset, with the layout of Mesh::renderInstanced().
+            /// Only shaders declaring the "instanced" uniform of Instancing.glsl can be used.
+            void renderInstances( const RenderParameters& lightParams, const RenderData& rdata,
+                                  RenderTechnique::PassName passname, RenderState& state,
+                                  uint instanceBuffer, std::size_t offset, uint count );
+            
+        private:
+            /// Bind the shader for passname, the render parameters and the material, unless
+            /// they are already bound according to state. Returns nullptr if there is no shader.
+            const ShaderProgram* bind( const RenderParameters& lightParams, const RenderData& rdata,
+                                       RenderTechnique::PassName passname, RenderState& state );
+
         private:
+            friend class RenderObjectManager;
+
             Core::Transform m_localTransform;
+            Core::Index m_transformNode;
+            bool m_localTransformChanged;
+            /// True once the node was updated by the hierarchy. Set at the end of the frame, read by tasks.
+            std::atomic<bool> m_transformPublished;
+
+            Core::Matrix4 m_frameModelMatrix;
+            Core::Matrix4 m_frameNormalMatrix;
 
             Component* m_component;
             std::string m_name;
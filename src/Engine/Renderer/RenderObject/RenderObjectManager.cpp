@@ -1,6 +1,8 @@
 #include <Engine/Renderer/RenderObject/RenderObjectManager.hpp>
 
 
+#include <Core/Math/TransformHierarchy.hpp>
+
 #include <Engine/RadiumEngine.hpp>
 
 #include <Engine/Entity/Entity.hpp>
@@ -8,6 +10,7 @@
 
 #include <Engine/Renderer/RenderObject/RenderObject.hpp>
 #include <Engine/Renderer/Mesh/Mesh.hpp>
+#include <Engine/Renderer/RenderQueue/RenderQueue.hpp>
 #include <Engine/Managers/SystemDisplay/SystemDisplay.hpp>
 
 #include <Engine/Managers/SignalManager/SignalManager.hpp>
@@ -39,9 +42,18 @@ namespace Ra
 
             newRenderObject->idx = index;
 
+            const Entity* entity = renderObject->getComponent()->getEntity();
+            if ( entity )
+            {
+                renderObject->m_transformNode = RadiumEngine::getInstance()->getTransformHierarchy()->addNode(
+                        entity->getTransformNode(), renderObject->getLocalTransform() );
+                renderObject->m_localTransformChanged = false;
+            }
+
             auto type = renderObject->getType();
 
             m_renderObjectByType[(int)type].insert( index );
+            invalidateRenderQueues();
 
             Engine::RadiumEngine::getInstance()->getSignalManager()->fireRenderObjectAdded(
                     ItemEntry( renderObject->getComponent()->getEntity(),
@@ -65,9 +77,11 @@ namespace Ra
             // Lock after signal has been fired (as this signal can cause another RO to be deleted)
             std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
             m_renderObjects.remove( index );
+            detachTransformNode( *renderObject );
 
             auto type = renderObject->getType();
             m_renderObjectByType[(int)type].erase( index );
+            invalidateRenderQueues();
             renderObject.reset();
         }
 
@@ -111,16 +125,28 @@ namespace Ra
 
             auto ro = m_renderObjects.at( idx );
             m_renderObjects.remove( idx );
+            detachTransformNode( *ro );
 
             auto type = ro->getType();
 
             m_renderObjectByType[(int)type].erase( idx );
+            invalidateRenderQueues();
 
             ro->hasExpired();
 
             ro.reset();
         }
 
+        void RenderObjectManager::detachTransformNode( RenderObject& renderObject )
+        {
+            if ( renderObject.m_transformNode.isValid() )
+            {
+                RadiumEngine::getInstance()->getTransformHierarchy()->removeNode( renderObject.m_transformNode );
+                renderObject.m_transformNode = Core::Index::Invalid();
+                renderObject.m_transformPublished = false;
+            }
+        }
+
         uint RenderObjectManager::getNumFaces() const
         {
             uint result = 0;
@@ -147,6 +173,26 @@ namespace Ra
             return result;
         }
 
+        void RenderObjectManager::swapTransformBuffers()
+        {
+            std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
+            Core::TransformHierarchy* hierarchy = RadiumEngine::getInstance()->getTransformHierarchy();
+            for ( const auto& ro : m_renderObjects )
+            {
+                if ( ro->m_transformNode.isInvalid() )
+                {
+                    continue;
+                }
+                if ( ro->m_localTransformChanged )
+                {
+                    hierarchy->setLocal( ro->m_transformNode, ro->m_localTransform );
+                    ro->m_localTransformChanged = false;
+                }
+                // The node is published by the update following this call.
+                ro->m_transformPublished = true;
+            }
+        }
+
         Core::Aabb RenderObjectManager::getSceneAabb() const
         {
             Core::Aabb aabb;
@@ -157,13 +203,13 @@ namespace Ra
             {
                 if (ro->isVisible() && (!skipUi || ro->getComponent() != ui))
                 {
-                    Core::Transform t = ro->getComponent()->getEntity()->getTransform();
+                    const Core::Transform t = ro->getTransform();
                     auto mesh = ro->getMesh();
                     auto pos = mesh->getGeometry().m_vertices;
 
                     for (auto& p : pos)
                     {
-                        p = t * ro->getLocalTransform() * p;
+                        p = t * p;
                     }
 
                     const Ra::Core::Vector3 bmin = pos.getMap().rowwise().minCoeff().head<3>();
@@ -12,7 +12,7 @@
 #include <thread>
 
 #include <Core/Index/Index.hpp>
-#include <Core/Index/IndexMap.hpp>
+#include <Core/Index/SlotMap.hpp>
 #include <Core/TreeStructures/BVH.hpp>
 #include <Core/Math/Frustum.hpp>
 
@@ -36,7 +36,7 @@ namespace Ra
 
             uint getRenderObjectsCount();
 
-            /// Returns the render object corresponding to the given index. Will assert
+            /// Returns the render object corresponding to the given index, in constant time. Will assert
             /// if the index does not match to an existing render object. See exists()
             std::shared_ptr<RenderObject> getRenderObject( const Core::Index& index );
 
@@ -50,6 +50,7 @@ namespace Ra
                                          const RenderObjectType& type ) const;
 
             /// Returns true if the index points to a valid render object.
+            /// Indices of removed render objects are never valid again.
             bool exists( const Core::Index& index) const;
 
             void renderObjectExpired( const Ra::Core::Index& idx );
@@ -63,8 +64,16 @@ namespace Ra
             /// Return the AABB of all visible render objects
             Core::Aabb getSceneAabb() const;
 
+            /// Set the changed local transforms in the transform hierarchy, before its update.
+            void swapTransformBuffers();
+
+        private:
+            /// Remove the node of a removed or expired render object from the transform hierarchy.
+            /// Called with m_doubleBufferMutex held.
+            void detachTransformNode( RenderObject& renderObject );
+
         private:
-            Core::IndexMap<std::shared_ptr<RenderObject>> m_renderObjects;
+            Core::SlotMap<std::shared_ptr<RenderObject>> m_renderObjects;
 
             std::array<std::set<Core::Index>, (int)RenderObjectType::Count> m_renderObjectByType;
 
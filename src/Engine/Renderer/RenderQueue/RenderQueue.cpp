@@ -0,0 +1,77 @@
+#include <Engine/Renderer/RenderQueue/RenderQueue.hpp>
+
+#include <atomic>
+
+#include <Engine/Renderer/OpenGL/OpenGL.hpp>
+#include <Engine/Renderer/RenderObject/RenderObject.hpp>
+#include <Engine/Renderer/RenderTechnique/ShaderProgram.hpp>
+#include <Engine/Renderer/Material/Material.hpp>
+#include <Engine/Renderer/Mesh/Mesh.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        namespace
+        {
+            // Starts at 1 so that queues which were never updated are out of date.
+            std::atomic<uint> g_renderQueuesVersion( 1 );
+        }
+
+        void invalidateRenderQueues()
+        {
+            ++g_renderQueuesVersion;
+        }
+
+        uint getRenderQueuesVersion()
+        {
+            return g_renderQueuesVersion;
+        }
+
+        RenderQueue::RenderQueue()
+            : m_instanceBuffer( 0 )
+        {
+        }
+
+        RenderQueue::~RenderQueue()
+        {
+            if ( m_instanceBuffer != 0 )
+            {
+                glDeleteBuffers( 1, &m_instanceBuffer );
+            }
+        }
+
+        void RenderQueue::update( const std::vector<RenderObjectPtr>& objects, RenderTechnique::PassName pass,
+                                  const Core::Matrix4& viewMatrix, RenderTechnique::PassName excludedPass )
+        {
+            RenderQueueBase<RenderObject>::update( objects, pass, viewMatrix, excludedPass );
+
+            const std::vector<float>& instanceData = getInstanceData();
+            if ( !instanceData.empty() )
+            {
+                if ( m_instanceBuffer == 0 )
+                {
+                    GL_ASSERT( glGenBuffers( 1, &m_instanceBuffer ) );
+                }
+                GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_instanceBuffer ) );
+                GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, instanceData.size() * sizeof( float ),
+                                         instanceData.data(), GL_STREAM_DRAW ) );
+            }
+        }
+
+        void RenderQueue::render( const RenderParameters& params, const RenderData& renderData ) const
+        {
+            RenderState state;
+            forEachDraw( [&]( RenderObject* ro )
+                         {
+                             ro->render( params, renderData, m_pass, state );
+                         },
+                         [&]( RenderObject* ro, uint first, uint count )
+                         {
+                             ro->renderInstances( params, renderData, m_pass, state, m_instanceBuffer,
+                                                  first * INSTANCE_FLOATS * sizeof( float ), count );
+                         } );
+        }
+
+    } // namespace Engine
+} // namespace Ra
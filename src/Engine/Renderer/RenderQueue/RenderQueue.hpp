@@ -0,0 +1,194 @@
+#ifndef RADIUMENGINE_RENDERQUEUE_HPP
+#define RADIUMENGINE_RENDERQUEUE_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Containers/DrawKey.hpp>
+#include <Core/Containers/KeyGroups.hpp>
+
+#include <Engine/Renderer/RenderTechnique/RenderTechnique.hpp>
+#include <Engine/Renderer/RenderTechnique/ShaderProgram.hpp>
+#include <Engine/Renderer/RenderStatistics.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        class RenderObject;
+        class RenderParameters;
+        struct RenderData;
+    }
+}
+
+namespace Ra
+{
+    namespace Engine
+    {
+        /// Signal that render objects were added, removed, or changed in a way that
+        /// affects the render queues (technique, material, mesh, x-ray or transparency).
+        RA_ENGINE_API void invalidateRenderQueues();
+
+        /// Version of the render objects state, incremented by invalidateRenderQueues().
+        RA_ENGINE_API uint getRenderQueuesVersion();
+
+        /// List of render objects drawn with a given pass, sorted to minimize state changes.
+        /// Each draw gets a 64 bits sort key (see Core::DrawKey) made of, from the most significant bits :
+        ///     pass (4 bits) | shader (12 bits) | material (16 bits) | depth bucket (16 bits) | mesh (16 bits)
+        /// Shaders, materials and meshes are numbered in order of appearance. The keys are
+        /// kept until the render queues are invalidated, only the depth buckets are updated
+        /// each frame, and the queue is sorted again only when a key changed.
+        /// Drawing the queue skips the shader and material bindings shared by consecutive draws.
+        ///
+        /// Objects whose keys only differ by their depth bucket usually share their shader, material
+        /// and mesh : the groups of such objects are split where their ids were truncated to the
+        /// same key bits but the objects differ. When instancing is enabled, the visible objects
+        /// of a group are drawn by a single
+        /// instanced draw call, at the place of the first object of the group, if there are at least
+        /// MIN_INSTANCES of them and their shader supports it (see Instancing.glsl).
+        ///
+        /// RenderQueueBase does the sorting, grouping and instance selection, which need no OpenGL
+        /// context, for objects of type Object providing the accessors of RenderObject used below
+        /// (getRenderTechnique(), getMesh(), isVisible(), getFrameModelMatrix() and getFrameNormalMatrix()).
+        /// RenderQueue uploads the instances and draws the render objects.
+        template <typename Object>
+        class RenderQueueBase
+        {
+        public:
+            typedef std::shared_ptr<Object> ObjectPtr;
+
+            /// Smallest number of objects drawn with an instanced draw call.
+            constexpr static uint MIN_INSTANCES = 2;
+
+            /// Floats per instance : model and normal matrices.
+            constexpr static uint INSTANCE_FLOATS = 32;
+
+            RenderQueueBase();
+
+            RenderQueueBase( const RenderQueueBase& ) = delete;
+            RenderQueueBase& operator=( const RenderQueueBase& ) = delete;
+
+            /// Enable the instanced draws (enabled by default).
+            inline void setInstancing( bool on ) { m_instancing = on; }
+            inline bool isInstancing() const { return m_instancing; }
+
+            /// Set the objects drawn by the queue with the given pass. Objects without a shader
+            /// for pass, or with a shader for excludedPass, are not drawn.
+            /// Must be called every frame, after the objects frame transforms are updated.
+            void update( const std::vector<ObjectPtr>& objects, RenderTechnique::PassName pass,
+                         const Core::Matrix4& viewMatrix,
+                         RenderTechnique::PassName excludedPass = RenderTechnique::NO_PASS );
+
+            /// Visit the draws of the queue in order : draw( object ) for the objects drawn alone,
+            /// drawInstances( object, firstInstance, instanceCount ) for the instanced groups.
+            template <typename Draw, typename DrawInstances>
+            void forEachDraw( Draw draw, DrawInstances drawInstances ) const;
+
+            inline std::size_t size() const { return m_objects.size(); }
+            inline bool empty() const { return m_objects.empty(); }
+
+            /// Sorted objects and their keys.
+            inline const std::vector<Object*>& getRenderObjects() const { return m_objects; }
+            inline const std::vector<uint64_t>& getKeys() const { return m_keys; }
+
+            /// Groups of the objects which can be instanced, as indices in getRenderObjects().
+            inline const Core::KeyGroups& getInstanceGroups() const { return m_groups; }
+
+            /// Model and normal matrices of the instances selected by the last update().
+            inline const std::vector<float>& getInstanceData() const { return m_instanceData; }
+
+        private:
+            /// Filter the objects and compute their keys, depth excepted.
+            void buildKeys( const std::vector<ObjectPtr>& objects );
+
+            /// Update the depth buckets of the keys. Returns true if a key changed.
+            bool updateDepths( const Core::Matrix4& viewMatrix );
+
+            /// Split the groups of objects with equal keys whose shader, material or mesh differ.
+            void splitGroups();
+
+            /// Select the groups drawn with instanced draw calls and gather their transforms.
+            void updateInstances();
+
+            /// Number the distinct pointers in order of appearance.
+            class IdMap
+            {
+            public:
+                inline uint get( const void* ptr );
+
+            private:
+                std::unordered_map<const void*, uint> m_ids;
+            };
+
+            /// What an instanced draw shares, which the keys only hold as truncated ids.
+            struct DrawState
+            {
+                const void* m_shader;
+                const void* m_material;
+                const void* m_mesh;
+
+                inline bool operator==( const DrawState& other ) const
+                {
+                    return m_shader == other.m_shader && m_material == other.m_material && m_mesh == other.m_mesh;
+                }
+            };
+
+            /// Instances of a group, in the instance data.
+            struct InstanceRange
+            {
+                uint m_first;
+                uint m_count;
+            };
+
+        protected:
+            RenderTechnique::PassName m_pass;
+
+        private:
+            RenderTechnique::PassName m_excludedPass;
+
+            uint m_version;
+            const ObjectPtr* m_source;
+            std::size_t m_sourceSize;
+
+            std::vector<Object*> m_objects;
+            std::vector<uint64_t> m_keys;
+
+            bool m_instancing;
+            Core::KeyGroups m_groups;
+            std::vector<uint> m_objectGroups;       /// Group of each object.
+            std::vector<InstanceRange> m_instances; /// Instances of each group, none if it is not instanced.
+            std::vector<float> m_instanceData;      /// Model and normal matrices of the instances.
+        };
+
+        /// Render queue of the renderers, see RenderQueueBase.
+        class RA_ENGINE_API RenderQueue : public RenderQueueBase<RenderObject>
+        {
+        public:
+            typedef std::shared_ptr<RenderObject> RenderObjectPtr;
+
+            RenderQueue();
+            ~RenderQueue();
+
+            /// See RenderQueueBase::update(). Also uploads the transforms of the instances.
+            void update( const std::vector<RenderObjectPtr>& objects, RenderTechnique::PassName pass,
+                         const Core::Matrix4& viewMatrix,
+                         RenderTechnique::PassName excludedPass = RenderTechnique::NO_PASS );
+
+            /// Draw the objects of the queue in order.
+            void render( const RenderParameters& params, const RenderData& renderData ) const;
+
+        private:
+            uint m_instanceBuffer;
+        };
+
+    } // namespace Engine
+} // namespace Ra
+
+#include <Engine/Renderer/RenderQueue/RenderQueue.inl>
+
+#endif // RADIUMENGINE_RENDERQUEUE_HPP
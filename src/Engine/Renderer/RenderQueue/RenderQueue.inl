@@ -0,0 +1,241 @@
+#include <Engine/Renderer/RenderQueue/RenderQueue.hpp>
+
+#include <Core/Containers/RadixSort.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        template <typename Object>
+        constexpr uint RenderQueueBase<Object>::MIN_INSTANCES;
+
+        template <typename Object>
+        constexpr uint RenderQueueBase<Object>::INSTANCE_FLOATS;
+
+        template <typename Object>
+        inline uint RenderQueueBase<Object>::IdMap::get( const void* ptr )
+        {
+            auto it = m_ids.find( ptr );
+            if ( it == m_ids.end() )
+            {
+                it = m_ids.insert( std::make_pair( ptr, uint( m_ids.size() ) ) ).first;
+            }
+            return it->second;
+        }
+
+        template <typename Object>
+        RenderQueueBase<Object>::RenderQueueBase()
+            : m_pass( RenderTechnique::NO_PASS )
+            , m_excludedPass( RenderTechnique::NO_PASS )
+            , m_version( 0 )
+            , m_source( nullptr )
+            , m_sourceSize( 0 )
+            , m_instancing( true )
+        {
+        }
+
+        template <typename Object>
+        void RenderQueueBase<Object>::update( const std::vector<ObjectPtr>& objects, RenderTechnique::PassName pass,
+                                              const Core::Matrix4& viewMatrix, RenderTechnique::PassName excludedPass )
+        {
+            const uint version = getRenderQueuesVersion();
+            bool changed = false;
+
+            if ( version != m_version || pass != m_pass || excludedPass != m_excludedPass ||
+                 objects.data() != m_source || objects.size() != m_sourceSize )
+            {
+                m_version = version;
+                m_pass = pass;
+                m_excludedPass = excludedPass;
+                m_source = objects.data();
+                m_sourceSize = objects.size();
+
+                buildKeys( objects );
+                changed = true;
+            }
+
+            changed = updateDepths( viewMatrix ) || changed;
+
+            if ( changed )
+            {
+                Core::radixSort( m_keys, m_objects );
+                Core::groupKeys( m_keys, ~Core::DrawKey::DEPTH_MASK, m_groups );
+                splitGroups();
+                m_groups.getIndexGroups( m_objectGroups );
+            }
+
+            m_instances.assign( m_groups.getGroupCount(), InstanceRange{ 0, 0 } );
+            m_instanceData.clear();
+            if ( m_instancing )
+            {
+                updateInstances();
+            }
+
+            RenderStatistics& stats = getCurrentRenderStatistics();
+            stats.m_queueGroups += m_groups.getGroupCount();
+            stats.m_queueInstances += uint( m_instanceData.size() ) / INSTANCE_FLOATS;
+        }
+
+        template <typename Object>
+        template <typename Draw, typename DrawInstances>
+        void RenderQueueBase<Object>::forEachDraw( Draw draw, DrawInstances drawInstances ) const
+        {
+            for ( uint i = 0; i < m_objects.size(); ++i )
+            {
+                Object* ro = m_objects[i];
+                const uint g = m_objectGroups[i];
+                const InstanceRange& range = m_instances[g];
+                if ( range.m_count > 0 )
+                {
+                    // The whole group is drawn at the place of its first object.
+                    if ( m_groups.m_indices[m_groups.m_offsets[g]] == i )
+                    {
+                        drawInstances( ro, range.m_first, range.m_count );
+                    }
+                    continue;
+                }
+                draw( ro );
+            }
+        }
+
+        template <typename Object>
+        void RenderQueueBase<Object>::buildKeys( const std::vector<ObjectPtr>& objects )
+        {
+            m_objects.clear();
+            m_keys.clear();
+
+            // Index of the pass bit.
+            uint passIndex = 0;
+            while ( passIndex < 32 && !( uint( m_pass ) & ( 1u << passIndex ) ) )
+            {
+                ++passIndex;
+            }
+
+            IdMap shaders;
+            IdMap materials;
+            IdMap meshes;
+
+            for ( const auto& ro : objects )
+            {
+                const auto& technique = ro->getRenderTechnique();
+                const auto* shader = technique->getShader( m_pass );
+                if ( !shader || ( m_excludedPass != RenderTechnique::NO_PASS && technique->getShader( m_excludedPass ) ) )
+                {
+                    continue;
+                }
+
+                m_objects.push_back( ro.get() );
+                m_keys.push_back( Core::DrawKey::makeKey( passIndex,
+                                                          shaders.get( shader ),
+                                                          materials.get( technique->getMaterial().get() ),
+                                                          0,
+                                                          meshes.get( ro->getMesh().get() ) ) );
+            }
+        }
+
+        template <typename Object>
+        void RenderQueueBase<Object>::splitGroups()
+        {
+            std::vector<DrawState> states( m_objects.size() );
+            for ( uint i = 0; i < m_objects.size(); ++i )
+            {
+                Object* ro = m_objects[i];
+                const auto& technique = ro->getRenderTechnique();
+                states[i] = DrawState{ technique->getShader( m_pass ), technique->getMaterial().get(),
+                                       ro->getMesh().get() };
+            }
+
+            Core::KeyGroups split;
+            split.m_indices.reserve( m_groups.m_indices.size() );
+            split.m_offsets.reserve( m_groups.m_offsets.size() );
+            std::vector<uint> rest;
+            std::vector<uint> next;
+            for ( uint g = 0; g < m_groups.getGroupCount(); ++g )
+            {
+                // Each pass takes the objects like the first remaining one, keeping their order.
+                rest.assign( m_groups.m_indices.begin() + m_groups.m_offsets[g],
+                             m_groups.m_indices.begin() + m_groups.m_offsets[g + 1] );
+                while ( !rest.empty() )
+                {
+                    const DrawState& first = states[rest.front()];
+                    split.m_offsets.push_back( uint( split.m_indices.size() ) );
+                    next.clear();
+                    for ( uint i : rest )
+                    {
+                        if ( states[i] == first )
+                        {
+                            split.m_indices.push_back( i );
+                        }
+                        else
+                        {
+                            next.push_back( i );
+                        }
+                    }
+                    rest.swap( next );
+                }
+            }
+            split.m_offsets.push_back( uint( split.m_indices.size() ) );
+            std::swap( m_groups, split );
+        }
+
+        template <typename Object>
+        void RenderQueueBase<Object>::updateInstances()
+        {
+            for ( uint g = 0; g < m_groups.getGroupCount(); ++g )
+            {
+                if ( m_groups.getGroupSize( g ) < MIN_INSTANCES )
+                {
+                    continue;
+                }
+
+                const auto& technique = m_objects[m_groups.m_indices[m_groups.m_offsets[g]]]->getRenderTechnique();
+                if ( !technique->getShader( m_pass )->hasUniform( ShaderProgram::DRAW_INSTANCED ) )
+                {
+                    continue;
+                }
+
+                const uint first = uint( m_instanceData.size() ) / INSTANCE_FLOATS;
+                for ( uint k = m_groups.m_offsets[g]; k < m_groups.m_offsets[g + 1]; ++k )
+                {
+                    const Object* ro = m_objects[m_groups.m_indices[k]];
+                    if ( ro->isVisible() )
+                    {
+                        const std::size_t offset = m_instanceData.size();
+                        m_instanceData.resize( offset + INSTANCE_FLOATS );
+                        Eigen::Map<Core::Matrix4f>( m_instanceData.data() + offset ) =
+                            ro->getFrameModelMatrix().template cast<float>();
+                        Eigen::Map<Core::Matrix4f>( m_instanceData.data() + offset + 16 ) =
+                            ro->getFrameNormalMatrix().template cast<float>();
+                    }
+                }
+
+                const uint count = uint( m_instanceData.size() ) / INSTANCE_FLOATS - first;
+                if ( count < MIN_INSTANCES )
+                {
+                    m_instanceData.resize( first * INSTANCE_FLOATS );
+                    continue;
+                }
+                m_instances[g] = InstanceRange{ first, count };
+            }
+        }
+
+        template <typename Object>
+        bool RenderQueueBase<Object>::updateDepths( const Core::Matrix4& viewMatrix )
+        {
+            bool changed = false;
+            for ( std::size_t i = 0; i < m_objects.size(); ++i )
+            {
+                const Core::Vector4 origin = m_objects[i]->getFrameModelMatrix().col( 3 );
+                const Scalar depth = -viewMatrix.row( 2 ).dot( origin );
+                const uint64_t key = Core::DrawKey::setDepth( m_keys[i], Core::DrawKey::getDepthBucket( depth ) );
+                if ( key != m_keys[i] )
+                {
+                    m_keys[i] = key;
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+    } // namespace Engine
+} // namespace Ra
@@ -0,0 +1,13 @@
+#include <Engine/Renderer/RenderStatistics.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        RenderStatistics& getCurrentRenderStatistics()
+        {
+            static RenderStatistics s_statistics;
+            return s_statistics;
+        }
+    } // namespace Engine
+} // namespace Ra
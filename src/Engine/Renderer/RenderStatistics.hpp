@@ -0,0 +1,54 @@
+#ifndef RADIUMENGINE_RENDERSTATISTICS_HPP
+#define RADIUMENGINE_RENDERSTATISTICS_HPP
+
+#include <Engine/RaEngine.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        /// CPU side counters of the GL calls issued by the renderer during a frame.
+        /// They are incremented by ShaderProgram, Texture, Mesh, UniformBuffer, RenderObject and RenderQueue
+        /// and reset by the Renderer at the beginning of each frame, so that
+        /// regressions in the number of state changes can be detected without
+        /// a GPU profiler.
+        struct RA_ENGINE_API RenderStatistics
+        {
+            RenderStatistics() { reset(); }
+
+            void reset()
+            {
+                m_uniformCalls        = 0;
+                m_uniformBlockUpdates = 0;
+                m_programBinds        = 0;
+                m_textureBinds        = 0;
+                m_drawCalls           = 0;
+                m_programBindsSkipped  = 0;
+                m_materialBindsSkipped = 0;
+                m_instancedDrawCalls   = 0;
+                m_instances            = 0;
+                m_queueGroups          = 0;
+                m_queueInstances       = 0;
+            }
+
+            uint m_uniformCalls;        ///< Number of individual uniform setters called.
+            uint m_uniformBlockUpdates; ///< Number of uniform buffer uploads.
+            uint m_programBinds;        ///< Number of shader program binds.
+            uint m_textureBinds;        ///< Number of texture binds.
+            uint m_drawCalls;           ///< Number of draw calls.
+            uint m_programBindsSkipped; ///< Shader program binds saved by render queue sorting.
+            uint m_materialBindsSkipped;///< Material binds saved by render queue sorting.
+            uint m_instancedDrawCalls;  ///< Number of instanced draw calls (included in m_drawCalls).
+            uint m_instances;           ///< Number of objects drawn by instanced draw calls.
+            uint m_queueGroups;         ///< Groups of queued objects sharing shader, material and mesh.
+            uint m_queueInstances;      ///< Queued objects selected for instanced draw calls.
+        };
+
+        /// Access the counters of the frame being rendered.
+        /// Rendering happens on the GL thread only, so no synchronization is done.
+        RA_ENGINE_API RenderStatistics& getCurrentRenderStatistics();
+
+    } // namespace Engine
+} // namespace Ra
+
+#endif // RADIUMENGINE_RENDERSTATISTICS_HPP
@@ -7,14 +7,16 @@
 
 #include <Engine/Renderer/Material/Material.hpp>
 #include <Engine/Renderer/Material/BlinnPhongMaterial.hpp>
+#include <Engine/Renderer/RenderQueue/RenderQueue.hpp>
 
 
 namespace Ra {
     namespace Engine {
         
         // For iterating on the enum easily
-        const std::array<RenderTechnique::PassName, 3> allPasses =
-        {RenderTechnique::Z_PREPASS, RenderTechnique::LIGHTING_OPAQUE, RenderTechnique::LIGHTING_TRANSPARENT};
+        const std::array<RenderTechnique::PassName, 5> allPasses =
+        {RenderTechnique::Z_PREPASS, RenderTechnique::LIGHTING_OPAQUE, RenderTechnique::LIGHTING_TRANSPARENT,
+         RenderTechnique::LIGHTING_OPAQUE_CLUSTERED, RenderTechnique::LIGHTING_TRANSPARENT_CLUSTERED};
         
         std::shared_ptr<Ra::Engine::RenderTechnique> RadiumDefaultRenderTechnique(nullptr);
         
@@ -52,6 +54,7 @@ namespace Ra {
             shaderConfig[pass] = newConfig;
             dirtyBits |= pass;
             setPasses |= pass;
+            invalidateRenderQueues();
         }
         
         const ShaderProgram *RenderTechnique::getShader(PassName pass) const
@@ -69,7 +72,12 @@ namespace Ra {
             {
                 if ((setPasses & p) && ((nullptr == shaders[p]) || (dirtyBits & p)))
                 {
-                    shaders[p] = ShaderProgramManager::getInstance()->getShaderProgram(shaderConfig[p]);
+                    const ShaderProgram* shader = ShaderProgramManager::getInstance()->getShaderProgram(shaderConfig[p]);
+                    if (shader != shaders[p])
+                    {
+                        shaders[p] = shader;
+                        invalidateRenderQueues();
+                    }
                     dirtyBits |= p;
                 }
             }
@@ -77,6 +85,7 @@ namespace Ra {
             if (material)
             {
                 material->updateGL();
+                material->updateFrameParameters();
             }
         }
         
@@ -88,11 +97,13 @@ namespace Ra {
         void RenderTechnique::resetMaterial(Material *mat)
         {
             material.reset(mat);
+            invalidateRenderQueues();
         }
         
         void RenderTechnique::setMaterial(const std::shared_ptr<Material> &material)
         {
             RenderTechnique::material = material;
+            invalidateRenderQueues();
         }
         
         ShaderConfiguration RenderTechnique::getConfiguration(PassName pass) const
@@ -83,6 +83,10 @@ namespace Ra {
                 Z_PREPASS = 1 << 0,
                 LIGHTING_OPAQUE = 1 << 1,
                 LIGHTING_TRANSPARENT = 1 << 2,
+                // Single pass variants of the lighting passes, shading all the lights
+                // of the clusters of the fragment (see ClusteredLighting)
+                LIGHTING_OPAQUE_CLUSTERED = 1 << 3,
+                LIGHTING_TRANSPARENT_CLUSTERED = 1 << 4,
                 NO_PASS = 0
             };
             
@@ -109,6 +113,8 @@ namespace Ra {
             //      Z_PREPASS = DepthDepthAmbientPass
             //      LIGHTING_OPAQUE = BlinnPhong
             //      LIGHTING_TRANSPARENT = LitOIT
+            //      LIGHTING_OPAQUE_CLUSTERED = BlinnPhongClustered
+            //      LIGHTING_TRANSPARENT_CLUSTERED = LitOITClustered
             static Ra::Engine::RenderTechnique createDefaultRenderTechnique();
         private:
             using ConfigurationSet = std::map<PassName, ShaderConfiguration>;
@@ -119,7 +125,8 @@ namespace Ra {
             std::shared_ptr<Material> material = nullptr;
             
             // Change this if there is more than 8 configurations
-            unsigned char dirtyBits = (Z_PREPASS | LIGHTING_OPAQUE | LIGHTING_TRANSPARENT);
+            unsigned char dirtyBits = (Z_PREPASS | LIGHTING_OPAQUE | LIGHTING_TRANSPARENT |
+                                       LIGHTING_OPAQUE_CLUSTERED | LIGHTING_TRANSPARENT_CLUSTERED);
             unsigned char setPasses = NO_PASS;
             
         };
@@ -8,8 +8,11 @@
 #include <globjects/base/File.h>
 #include <globjects/base/StaticStringSource.h>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <regex>
+#include <vector>
 
 #ifdef OS_WINDOWS
 #include <direct.h>
@@ -19,14 +22,41 @@
 #define getCurrentDir getcwd
 #endif
 
-#include <Core/Math/GlmAdapters.hpp>
-
 #include <Engine/Renderer/Texture/Texture.hpp>
+#include <Engine/Renderer/RenderStatistics.hpp>
 
 namespace Ra
 {
     namespace Engine
     {
+        namespace
+        {
+            // Names of the ShaderProgram::TransformUniform uniforms, in enum order.
+            const char* transformUniformNames[] =
+            {
+                "transform.model",
+                "transform.view",
+                "transform.proj",
+                "transform.worldNormal"
+            };
+
+            // Names of the ShaderProgram::DrawUniform uniforms, in enum order.
+            const char* drawUniformNames[] =
+            {
+                "packedVertices",
+                "packedPositionMin",
+                "packedPositionExtent",
+                "instanced",
+                "objectId"
+            };
+
+            // Names of the uniform blocks, in UniformBlockBinding order.
+            const char* uniformBlockNames[] =
+            {
+                "CameraBlock",
+                "LightBlock"
+            };
+        }
 
         ShaderProgram::ShaderProgram()
             : m_program( nullptr )
@@ -35,6 +65,9 @@ namespace Ra
             {
                 m_shaderObjects[i] = nullptr;
             }
+            m_transformLocations.fill( -1 );
+            m_drawLocations.fill( -1 );
+            m_uniformBlocks.fill( false );
         }
 
         ShaderProgram::ShaderProgram( const ShaderConfiguration& config )
@@ -178,10 +211,78 @@ namespace Ra
 
             m_program->link();
             GL_CHECK_ERROR;
+
+            resolveUniforms();
+        }
+
+        void ShaderProgram::resolveUniforms()
+        {
+            const GLuint id = m_program->id();
+
+            m_uniformLocations.clear();
+
+            GLint count = 0;
+            GLint maxLength = 0;
+            GL_ASSERT( glGetProgramiv( id, GL_ACTIVE_UNIFORMS, &count ) );
+            GL_ASSERT( glGetProgramiv( id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength ) );
+
+            std::vector<char> buffer( std::max( maxLength, 1 ) );
+            for ( GLint i = 0; i < count; ++i )
+            {
+                GLsizei length = 0;
+                GL_ASSERT( glGetActiveUniformName( id, GLuint( i ), GLsizei( buffer.size() ), &length, buffer.data() ) );
+                std::string name( buffer.data(), length );
+
+                // Uniforms stored in a block have no location.
+                GLint location = glGetUniformLocation( id, name.c_str() );
+                if ( location < 0 )
+                {
+                    continue;
+                }
+
+                // Arrays are reported as "name[0]", also register them as "name".
+                if ( name.size() > 3 && name.compare( name.size() - 3, 3, "[0]" ) == 0 )
+                {
+                    m_uniformLocations.emplace_back( name.substr( 0, name.size() - 3 ), location );
+                }
+                m_uniformLocations.emplace_back( std::move( name ), location );
+            }
+            std::sort( m_uniformLocations.begin(), m_uniformLocations.end() );
+
+            for ( uint i = 0; i < TRANSFORM_UNIFORM_COUNT; ++i )
+            {
+                m_transformLocations[i] = getUniformLocation( transformUniformNames[i] );
+            }
+
+            for ( uint i = 0; i < DRAW_UNIFORM_COUNT; ++i )
+            {
+                m_drawLocations[i] = getUniformLocation( drawUniformNames[i] );
+            }
+
+            for ( uint i = 0; i < UNIFORM_BLOCK_COUNT; ++i )
+            {
+                GLuint blockIdx = glGetUniformBlockIndex( id, uniformBlockNames[i] );
+                m_uniformBlocks[i] = ( blockIdx != GL_INVALID_INDEX );
+                if ( m_uniformBlocks[i] )
+                {
+                    GL_ASSERT( glUniformBlockBinding( id, blockIdx, i ) );
+                }
+            }
+        }
+
+        int ShaderProgram::getUniformLocation( const char* name ) const
+        {
+            auto it = std::lower_bound( m_uniformLocations.begin(), m_uniformLocations.end(), name,
+                                        []( const std::pair<std::string, int>& u, const char* n )
+                                        {
+                                            return std::strcmp( u.first.c_str(), n ) < 0;
+                                        } );
+            return ( it != m_uniformLocations.end() && it->first == name ) ? it->second : -1;
         }
 
         void ShaderProgram::bind() const
         {
+            ++getCurrentRenderStatistics().m_programBinds;
             m_program->use();
         }
 
@@ -226,103 +327,149 @@ namespace Ra
 
         void ShaderProgram::setUniform( const char* name, int value ) const
         {
-            m_program->setUniform( name, value );
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniform1i( m_program->id(), getUniformLocation( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, unsigned int value ) const
         {
-            m_program->setUniform(name, value);
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniform1ui( m_program->id(), getUniformLocation( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, float value ) const
         {
-            m_program->setUniform( name, value );
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniform1f( m_program->id(), getUniformLocation( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, double value ) const
         {
             float v = static_cast<float>(value);
 
-            m_program->setUniform( name, v );
+            setUniform( name, v );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector2f& value ) const
         {
-            m_program->setUniform( name, Core::toGlm( value ) );
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniform2fv( m_program->id(), getUniformLocation( name ), 1, value.data() );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector2d& value ) const
         {
             Core::Vector2f v = value.cast<float>();
 
-            m_program->setUniform( name, Core::toGlm( v ) );
+            setUniform( name, v );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector3f& value ) const
         {
-            m_program->setUniform( name, Core::toGlm( value ) );
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniform3fv( m_program->id(), getUniformLocation( name ), 1, value.data() );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector3d& value ) const
         {
             Core::Vector3f v = value.cast<float>();
 
-            m_program->setUniform( name, Core::toGlm( v ) );
+            setUniform( name, v );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector4f& value ) const
         {
-            m_program->setUniform( name, Core::toGlm( value ) );
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniform4fv( m_program->id(), getUniformLocation( name ), 1, value.data() );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector4d& value ) const
         {
             Core::Vector4f v = value.cast<float>();
 
-            m_program->setUniform( name, Core::toGlm( v ) );
+            setUniform( name, v );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix2f& value ) const
         {
-            m_program->setUniform( name, Core::toGlm( value ) );
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniformMatrix2fv( m_program->id(), getUniformLocation( name ), 1, GL_FALSE, value.data() );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix2d& value ) const
         {
             Core::Matrix2f v = value.cast<float>();
 
-            m_program->setUniform( name, Core::toGlm( v ) );
+            setUniform( name, v );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix3f& value ) const
         {
-            m_program->setUniform( name, Core::toGlm( value ) );
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniformMatrix3fv( m_program->id(), getUniformLocation( name ), 1, GL_FALSE, value.data() );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix3d& value ) const
         {
             Core::Matrix3f v = value.cast<float>();
 
-            m_program->setUniform( name, Core::toGlm( v ) );
+            setUniform( name, v );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix4f& value ) const
         {
-            m_program->setUniform( name, Core::toGlm( value ) );
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniformMatrix4fv( m_program->id(), getUniformLocation( name ), 1, GL_FALSE, value.data() );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix4d& value ) const
         {
             Core::Matrix4f v = value.cast<float>();
 
-            m_program->setUniform( name, Core::toGlm( v ) );
+            setUniform( name, v );
         }
-        
+
         void ShaderProgram::setUniform( const char* name, Texture* tex, int texUnit ) const
         {
             tex->bind( texUnit );
 
-            m_program->setUniform( name, texUnit );
+            setUniform( name, texUnit );
+        }
+
+        void ShaderProgram::setUniform( TransformUniform uniform, const Core::Matrix4f& value ) const
+        {
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniformMatrix4fv( m_program->id(), m_transformLocations[uniform], 1, GL_FALSE, value.data() );
+        }
+
+        void ShaderProgram::setUniform( TransformUniform uniform, const Core::Matrix4d& value ) const
+        {
+            Core::Matrix4f v = value.cast<float>();
+
+            setUniform( uniform, v );
+        }
+
+        void ShaderProgram::setUniform( DrawUniform uniform, int value ) const
+        {
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniform1i( m_program->id(), m_drawLocations[uniform], value );
+        }
+
+        void ShaderProgram::setUniform( DrawUniform uniform, const Core::Vector3f& value ) const
+        {
+            ++getCurrentRenderStatistics().m_uniformCalls;
+            glProgramUniform3fv( m_program->id(), m_drawLocations[uniform], 1, value.data() );
+        }
+
+        void ShaderProgram::setUniform( DrawUniform uniform, const Core::Vector3d& value ) const
+        {
+            Core::Vector3f v = value.cast<float>();
+
+            setUniform( uniform, v );
+        }
+
+        bool ShaderProgram::hasUniform( DrawUniform uniform ) const
+        {
+            return m_drawLocations[uniform] >= 0;
         }
 
         globjects::Program * ShaderProgram::getProgramObject() const
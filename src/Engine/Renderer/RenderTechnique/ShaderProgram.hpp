@@ -8,12 +8,15 @@
 #include <array>
 #include <list>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <Core/CoreMacros.hpp>
 #include <Core/Math/LinearAlgebra.hpp>
 
 #include <Engine/Renderer/OpenGL/OpenGL.hpp>
 #include <Engine/Renderer/RenderTechnique/ShaderConfiguration.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBlocks.hpp>
 
 namespace globjects
 {
@@ -31,6 +34,31 @@ namespace Ra
 
         class RA_ENGINE_API ShaderProgram
         {
+        public:
+            /// Uniforms set for every draw call, whose locations are resolved
+            /// once at link time so that they can be set without any name lookup.
+            enum TransformUniform : uint
+            {
+                TRANSFORM_MODEL = 0,
+                TRANSFORM_VIEW,
+                TRANSFORM_PROJ,
+                TRANSFORM_WORLDNORMAL,
+
+                TRANSFORM_UNIFORM_COUNT
+            };
+
+            /// Other uniforms which may be set for every draw call, also resolved at link time.
+            enum DrawUniform : uint
+            {
+                DRAW_PACKED_VERTICES = 0,
+                DRAW_PACKED_POSITION_MIN,
+                DRAW_PACKED_POSITION_EXTENT,
+                DRAW_INSTANCED,
+                DRAW_OBJECT_ID,
+
+                DRAW_UNIFORM_COUNT
+            };
+
         public:
             ShaderProgram();
             explicit ShaderProgram( const ShaderConfiguration& shaderConfig );
@@ -67,6 +95,30 @@ namespace Ra
 
             void setUniform( const char* name, Texture* tex, int texUnit ) const;
 
+            /// Set one of the per-draw transform uniforms through its cached location.
+            void setUniform( TransformUniform uniform, const Core::Matrix4f& value ) const;
+            void setUniform( TransformUniform uniform, const Core::Matrix4d& value ) const;
+
+            /// Set one of the per-draw uniforms through its cached location.
+            void setUniform( DrawUniform uniform, int value ) const;
+            void setUniform( DrawUniform uniform, const Core::Vector3f& value ) const;
+            void setUniform( DrawUniform uniform, const Core::Vector3d& value ) const;
+
+            /// Returns true if the program uses the given per-draw uniform.
+            bool hasUniform( DrawUniform uniform ) const;
+
+            /// Returns the location of the given uniform, or -1 if the program
+            /// has no such active uniform.
+            int getUniformLocation( const char* name ) const;
+
+            /// Returns true if the program declares the given uniform block.
+            /// Such programs read the corresponding data from the shared uniform
+            /// buffers instead of individual uniforms.
+            inline bool hasUniformBlock( UniformBlockBinding block ) const
+            {
+                return m_uniformBlocks[block];
+            }
+
             globjects::Program * getProgramObject() const;
 
         private:
@@ -77,6 +129,9 @@ namespace Ra
 
             void link();
 
+            /// Query the active uniforms and uniform blocks of the linked program.
+            void resolveUniforms();
+
             std::string preprocessIncludes(const std::string &name, const std::string& shader, int level, int line=0);
 
         private:
@@ -85,6 +140,14 @@ namespace Ra
             std::array< std::unique_ptr<globjects::Shader>, ShaderType_COUNT > m_shaderObjects;
 
             std::unique_ptr<globjects::Program> m_program;
+
+            /// Locations of all the active uniforms, resolved at link time and sorted by name,
+            /// so that they are found without building a std::string for each lookup.
+            std::vector<std::pair<std::string, int>> m_uniformLocations;
+
+            std::array<int, TRANSFORM_UNIFORM_COUNT> m_transformLocations;
+            std::array<int, DRAW_UNIFORM_COUNT> m_drawLocations;
+            std::array<bool, UNIFORM_BLOCK_COUNT> m_uniformBlocks;
         };
 
     } // namespace Engine
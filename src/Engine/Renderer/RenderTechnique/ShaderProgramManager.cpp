@@ -35,11 +35,17 @@ namespace Ra {
             m_files.push_back(globjects::File::create("Shaders/Structs.glsl"));
             m_files.push_back(globjects::File::create("Shaders/Tonemap.glsl"));
             m_files.push_back(globjects::File::create("Shaders/LightingFunctions.glsl"));
+            m_files.push_back(globjects::File::create("Shaders/CameraBlock.glsl"));
+            m_files.push_back(globjects::File::create("Shaders/LightBlock.glsl"));
+            m_files.push_back(globjects::File::create("Shaders/ClusteredLighting.glsl"));
             
             m_namedStrings.push_back(globjects::NamedString::create("/Helpers.glsl", m_files[0].get()));
             m_namedStrings.push_back(globjects::NamedString::create("/Structs.glsl", m_files[1].get()));
             m_namedStrings.push_back(globjects::NamedString::create("/Tonemap.glsl", m_files[2].get()));
             m_namedStrings.push_back(globjects::NamedString::create("/LightingFunctions.glsl", m_files[3].get()));
+            m_namedStrings.push_back(globjects::NamedString::create("/CameraBlock.glsl", m_files[4].get()));
+            m_namedStrings.push_back(globjects::NamedString::create("/LightBlock.glsl", m_files[5].get()));
+            m_namedStrings.push_back(globjects::NamedString::create("/ClusteredLighting.glsl", m_files[6].get()));
             
             m_defaultShaderProgram = addShaderProgram("Default Program", m_defaultVsName, m_defaultFsName);
             
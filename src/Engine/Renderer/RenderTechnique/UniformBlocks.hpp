@@ -0,0 +1,66 @@
+#ifndef RADIUMENGINE_UNIFORMBLOCKS_HPP
+#define RADIUMENGINE_UNIFORMBLOCKS_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <Core/Math/LinearAlgebra.hpp>
+
+/// CPU mirrors of the std140 uniform blocks declared in Shaders/CameraBlock.glsl
+/// and Shaders/LightBlock.glsl.
+/// Any change here must be reflected in the shader file (and vice versa).
+
+namespace Ra
+{
+    namespace Engine
+    {
+        /// Binding points of the uniform blocks shared by all shader programs.
+        enum UniformBlockBinding : uint
+        {
+            UNIFORM_BLOCK_CAMERA = 0,
+            UNIFORM_BLOCK_LIGHT,
+
+            UNIFORM_BLOCK_COUNT
+        };
+
+        /// Per-frame camera data, uploaded once per frame.
+        struct CameraBlock
+        {
+            RA_CORE_ALIGNED_NEW
+            Core::Matrix4f view;
+            Core::Matrix4f proj;
+        };
+
+        /// Per-light data, uploaded once per light and per pass.
+        /// Padding follows the std140 layout of the `Light` glsl struct.
+        struct LightBlock
+        {
+            int   type;
+            float pad0[3];
+            float color[4];
+
+            float dirDirection[3];
+            float pad1;
+
+            float pointPosition[3];
+            float pad2;
+            float pointAttenuation[3];
+            float pad3;
+
+            float spotPosition[3];
+            float pad4;
+            float spotDirection[3];
+            float pad5;
+            float spotAttenuation[3];
+            float pad6;
+            float spotInnerAngle;
+            float spotOuterAngle;
+            float pad7[2];
+        };
+
+        static_assert( sizeof( CameraBlock ) == 128, "CameraBlock does not match std140 layout" );
+        static_assert( sizeof( LightBlock ) == 144, "LightBlock does not match std140 layout" );
+
+    } // namespace Engine
+} // namespace Ra
+
+#endif // RADIUMENGINE_UNIFORMBLOCKS_HPP
@@ -0,0 +1,48 @@
+#include <Engine/Renderer/RenderTechnique/UniformBuffer.hpp>
+
+#include <Engine/Renderer/OpenGL/OpenGL.hpp>
+#include <Engine/Renderer/RenderStatistics.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        UniformBuffer::UniformBuffer( uint bindingPoint, std::size_t size )
+            : m_size( size )
+            , m_ubo( 0 )
+            , m_bindingPoint( bindingPoint )
+        {
+        }
+
+        UniformBuffer::~UniformBuffer()
+        {
+            if ( m_ubo != 0 )
+            {
+                glDeleteBuffers( 1, &m_ubo );
+            }
+        }
+
+        void UniformBuffer::initializeGL()
+        {
+            if ( m_ubo == 0 )
+            {
+                GL_ASSERT( glGenBuffers( 1, &m_ubo ) );
+                GL_ASSERT( glBindBuffer( GL_UNIFORM_BUFFER, m_ubo ) );
+                GL_ASSERT( glBufferData( GL_UNIFORM_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW ) );
+                GL_ASSERT( glBindBuffer( GL_UNIFORM_BUFFER, 0 ) );
+            }
+        }
+
+        void UniformBuffer::update( const void* data )
+        {
+            CORE_ASSERT( m_ubo != 0, "Uniform buffer was not initialized." );
+
+            GL_ASSERT( glBindBuffer( GL_UNIFORM_BUFFER, m_ubo ) );
+            GL_ASSERT( glBufferSubData( GL_UNIFORM_BUFFER, 0, m_size, data ) );
+            GL_ASSERT( glBindBufferBase( GL_UNIFORM_BUFFER, m_bindingPoint, m_ubo ) );
+
+            ++getCurrentRenderStatistics().m_uniformBlockUpdates;
+        }
+
+    } // namespace Engine
+} // namespace Ra
@@ -0,0 +1,44 @@
+#ifndef RADIUMENGINE_UNIFORMBUFFER_HPP
+#define RADIUMENGINE_UNIFORMBUFFER_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <cstddef>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        /// A GPU uniform buffer object bound to a fixed binding point.
+        /// Shader programs declaring a matching uniform block (see UniformBlocks.hpp)
+        /// get their block bound to the same point at link time, so updating the
+        /// buffer once makes the data visible to every program.
+        class RA_ENGINE_API UniformBuffer
+        {
+        public:
+            UniformBuffer( uint bindingPoint, std::size_t size );
+            ~UniformBuffer();
+
+            /// Create the GL buffer. Must be called with an active GL context.
+            void initializeGL();
+
+            /// Upload the data (of the size given at construction) and bind
+            /// the buffer to its binding point.
+            void update( const void* data );
+
+            inline uint getBindingPoint() const { return m_bindingPoint; }
+
+        private:
+            UniformBuffer( const UniformBuffer& ) = delete;
+            void operator=( const UniformBuffer& ) = delete;
+
+        private:
+            std::size_t m_size;
+            uint m_ubo;
+            uint m_bindingPoint;
+        };
+
+    } // namespace Engine
+} // namespace Ra
+
+#endif // RADIUMENGINE_UNIFORMBUFFER_HPP
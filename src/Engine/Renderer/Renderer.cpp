@@ -2,7 +2,9 @@
 
 #include <globjects/Framebuffer.h>
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 #include <Core/Log/Log.hpp>
 #include <Core/Math/ColorPresets.hpp>
@@ -16,6 +18,8 @@
 #include <Engine/Renderer/RenderTechnique/ShaderProgram.hpp>
 #include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
 #include <Engine/Renderer/RenderTechnique/RenderTechnique.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBlocks.hpp>
+#include <Engine/Renderer/RenderTechnique/UniformBuffer.hpp>
 #include <Engine/Renderer/Material/Material.hpp>
 #include <Engine/Renderer/Light/Light.hpp>
 #include <Engine/Renderer/Light/DirLight.hpp>
@@ -26,6 +30,8 @@
 #include <Engine/Renderer/Texture/Texture.hpp>
 #include <Engine/Renderer/RenderObject/RenderObjectManager.hpp>
 #include <Engine/Renderer/RenderObject/RenderObject.hpp>
+#include <Engine/Renderer/RenderQueue/RenderQueue.hpp>
+#include <Engine/Renderer/Renderers/DebugRender.hpp>
 
 namespace Ra {
     namespace Engine {
@@ -49,10 +55,12 @@ namespace Ra {
             , m_shaderMgr( nullptr )
             , m_displayedTexture( nullptr )
             , m_renderQueuesUpToDate( false )
+            , m_renderQueuesVersion( 0 )
             , m_quadMesh( nullptr )
             , m_drawDebug( true )
             , m_wireframe( false )
             , m_postProcessEnabled( true )
+            , m_framePrepared( false )
             , m_brushRadius( 0 )
         {
             GL_CHECK_ERROR;
@@ -125,6 +133,12 @@ namespace Ra {
             m_displayedTexture = m_fancyTexture.get();
             m_secondaryTextures["Picking Texture"] = m_pickingTexture.get();
 
+            // Shared uniform buffers
+            m_cameraBuffer.reset( new UniformBuffer( UNIFORM_BLOCK_CAMERA, sizeof( CameraBlock ) ) );
+            m_cameraBuffer->initializeGL();
+            m_lightBuffer.reset( new UniformBuffer( UNIFORM_BLOCK_LIGHT, sizeof( LightBlock ) ) );
+            m_lightBuffer->initializeGL();
+
             // Quad mesh
             Core::TriangleMesh mesh = Core::MeshUtils::makeZNormalQuad(Core::Vector2( -1.f, 1.f));
 
@@ -144,20 +158,18 @@ namespace Ra {
             std::lock_guard<std::mutex> renderLock( m_renderMutex );
             CORE_UNUSED( renderLock );
 
-            m_timerData.renderStart = Core::Timer::Clock::now();
+            // 1. and 2.0 Take the snapshot of the frame if prepareFrame() did not.
+            if ( !m_framePrepared )
+            {
+                prepareFrameInternal( data );
+            }
+            m_framePrepared = false;
 
             // 0. Save eventual already bound FBO (e.g. QtOpenGLWidget) and viewport
             saveExternalFBOInternal();
 
-            // 1. Gather render objects if needed
-            feedRenderQueuesInternal( data );
-
-            m_timerData.feedRenderQueuesEnd = Core::Timer::Clock::now();
-
-            // 2. Update them (from an opengl point of view)
-            // FIXME(Charly): Maybe we could just update objects if they need it
-            // before drawing them, that would be cleaner (performance problem ?)
-            updateRenderObjectsInternal( data );
+            // 2.1 Update the camera
+            updateCameraBlockInternal( data );
             m_timerData.updateEnd = Core::Timer::Clock::now();
 
             // 3. Do picking if needed
@@ -191,6 +203,47 @@ namespace Ra {
 
             // 9. Tell renderobjects they have been drawn (to decreaase the counter)
             notifyRenderObjectsRenderingInternal();
+
+            m_renderStatistics = getCurrentRenderStatistics();
+        }
+
+        void Renderer::prepareFrame( const RenderData& data )
+        {
+            CORE_ASSERT( RadiumEngine::getInstance() != nullptr, "Engine is not initialized." );
+
+            std::lock_guard<std::mutex> renderLock( m_renderMutex );
+            CORE_UNUSED( renderLock );
+
+            prepareFrameInternal( data );
+            m_framePrepared = true;
+        }
+
+        void Renderer::prepareFrameInternal( const RenderData& data )
+        {
+            m_timerData.renderStart = Core::Timer::Clock::now();
+            getCurrentRenderStatistics().reset();
+
+            // 1. Gather render objects if needed
+            feedRenderQueuesInternal( data );
+
+            m_timerData.feedRenderQueuesEnd = Core::Timer::Clock::now();
+
+            // 2. Update them (from an opengl point of view)
+            // FIXME(Charly): Maybe we could just update objects if they need it
+            // before drawing them, that would be cleaner (performance problem ?)
+            updateRenderObjectsInternal( data );
+
+            // Copy what the tasks of the next frame may edit while the frame is drawn.
+            m_frameLights.resize( m_lights.size() );
+            for ( uint i = 0; i < m_lights.size(); ++i )
+            {
+                m_lights[i]->getFrameLight( m_frameLights[i] );
+            }
+
+            if ( DebugRender::getInstance() )
+            {
+                DebugRender::getInstance()->prepareFrame();
+            }
         }
 
         void Renderer::saveExternalFBOInternal()
@@ -205,26 +258,55 @@ namespace Ra {
 
         void Renderer::updateRenderObjectsInternal( const RenderData& renderData )
         {
+            // Upload the textures decoded since the last frame.
+            TextureManager::getInstance()->uploadLoadedTextures();
+
             for (auto &ro : m_fancyRenderObjects)
             {
                 ro->updateGL();
+                ro->updateFrameTransforms();
             }
             for (auto &ro : m_xrayRenderObjects)
             {
                 ro->updateGL();
+                ro->updateFrameTransforms();
             }
             for (auto &ro : m_debugRenderObjects)
             {
                 ro->updateGL();
+                ro->updateFrameTransforms();
             }
             for (auto &ro : m_uiRenderObjects)
             {
                 ro->updateGL();
+                ro->updateFrameTransforms();
             }
         }
 
+        void Renderer::updateCameraBlockInternal( const RenderData& renderData )
+        {
+            CameraBlock block;
+            block.view = renderData.viewMatrix.cast<float>();
+            block.proj = renderData.projMatrix.cast<float>();
+            m_cameraBuffer->update( &block );
+        }
+
+        void Renderer::updateLightBlock( const FrameLight& light )
+        {
+            m_lightBuffer->update( &light.m_block );
+        }
+
         void Renderer::feedRenderQueuesInternal( const RenderData& renderData )
         {
+            // The lists only change when render objects are added, removed or change their state.
+            const uint version = getRenderQueuesVersion();
+            m_renderQueuesUpToDate = ( version == m_renderQueuesVersion );
+            if ( m_renderQueuesUpToDate )
+            {
+                return;
+            }
+            m_renderQueuesVersion = version;
+
             m_fancyRenderObjects.clear();
             m_debugRenderObjects.clear();
             m_uiRenderObjects.clear();
@@ -234,44 +316,18 @@ namespace Ra {
             m_roMgr->getRenderObjectsByType( renderData, m_debugRenderObjects, RenderObjectType::Debug );
             m_roMgr->getRenderObjectsByType( renderData, m_uiRenderObjects,    RenderObjectType::UI );
 
-            for ( auto it = m_fancyRenderObjects.begin(); it != m_fancyRenderObjects.end(); )
-            {
-                if ( (*it)->isXRay() )
-                {
-                    m_xrayRenderObjects.push_back( *it );
-                    it = m_fancyRenderObjects.erase( it );
-                }
-                else
-                {
-                    ++it;
-                }
-            }
-
-            for ( auto it = m_debugRenderObjects.begin(); it != m_debugRenderObjects.end(); )
+            // Move the xray objects at the end of each list in a single pass, then splice them out.
+            const auto splitXRay = [this]( std::vector<RenderObjectPtr>& objects )
             {
-                if ( (*it)->isXRay() )
-                {
-                    m_xrayRenderObjects.push_back( *it );
-                    it = m_debugRenderObjects.erase( it );
-                }
-                else
-                {
-                    ++it;
-                }
-            }
+                auto xray = std::stable_partition( objects.begin(), objects.end(),
+                                                   []( const RenderObjectPtr& ro ) { return !ro->isXRay(); } );
+                std::move( xray, objects.end(), std::back_inserter( m_xrayRenderObjects ) );
+                objects.erase( xray, objects.end() );
+            };
 
-            for ( auto it = m_uiRenderObjects.begin(); it != m_uiRenderObjects.end(); )
-            {
-                if ( (*it)->isXRay() )
-                {
-                    m_xrayRenderObjects.push_back( *it );
-                    it = m_uiRenderObjects.erase( it );
-                }
-                else
-                {
-                    ++it;
-                }
-            }
+            splitXRay( m_fancyRenderObjects );
+            splitXRay( m_debugRenderObjects );
+            splitXRay( m_uiRenderObjects );
         }
 
         // subroutine to Renderer::splitRenderQueuesForPicking()
@@ -342,18 +398,17 @@ namespace Ra {
                     if ( ro->isVisible() && ro->isPickable() )
                     {
                         int id = ro->idx.getValue();
-                        pickingShaders[i]->setUniform( "objectId", id );
+                        pickingShaders[i]->setUniform( ShaderProgram::DRAW_OBJECT_ID, id );
 
-                        Core::Matrix4 M = ro->getTransformAsMatrix();
-                        Core::Matrix4 N = M.inverse().transpose();
-                        pickingShaders[i]->setUniform( "transform.proj", renderData.projMatrix );
-                        pickingShaders[i]->setUniform( "transform.view", renderData.viewMatrix );
-                        pickingShaders[i]->setUniform( "transform.model", M );
-                        pickingShaders[i]->setUniform( "transform.worldNormal", N );
+                        pickingShaders[i]->setUniform( ShaderProgram::TRANSFORM_PROJ, renderData.projMatrix );
+                        pickingShaders[i]->setUniform( ShaderProgram::TRANSFORM_VIEW, renderData.viewMatrix );
+                        pickingShaders[i]->setUniform( ShaderProgram::TRANSFORM_MODEL, ro->getFrameModelMatrix() );
+                        pickingShaders[i]->setUniform( ShaderProgram::TRANSFORM_WORLDNORMAL, ro->getFrameNormalMatrix() );
 
                         ro->getRenderTechnique()->getMaterial()->bind( pickingShaders[i] );
 
                         // render
+                        ro->getMesh()->bindVertexFormat( pickingShaders[i] );
                         ro->getMesh()->render();
                     }
                 }
@@ -411,9 +466,9 @@ namespace Ra {
                     if ( ro->isVisible() && ro->isPickable() )
                     {
                         int id = ro->idx.getValue();
-                        m_pickingShaders[i]->setUniform( "objectId", id );
+                        m_pickingShaders[i]->setUniform( ShaderProgram::DRAW_OBJECT_ID, id );
 
-                        Core::Matrix4 M = ro->getTransformAsMatrix();
+                        Core::Matrix4 M = ro->getFrameModelMatrix();
                         Core::Matrix4 MV = renderData.viewMatrix * M;
                         Scalar d = MV.block<3, 1>( 0, 3 ).norm();
 
@@ -423,14 +478,15 @@ namespace Ra {
                         M = M * S;
                         Core::Matrix4 N = M.inverse().transpose();
 
-                        m_pickingShaders[i]->setUniform( "transform.proj", renderData.projMatrix );
-                        m_pickingShaders[i]->setUniform( "transform.view", renderData.viewMatrix );
-                        m_pickingShaders[i]->setUniform( "transform.model", M );
-                        m_pickingShaders[i]->setUniform( "transform.worldNormal", N );
+                        m_pickingShaders[i]->setUniform( ShaderProgram::TRANSFORM_PROJ, renderData.projMatrix );
+                        m_pickingShaders[i]->setUniform( ShaderProgram::TRANSFORM_VIEW, renderData.viewMatrix );
+                        m_pickingShaders[i]->setUniform( ShaderProgram::TRANSFORM_MODEL, M );
+                        m_pickingShaders[i]->setUniform( ShaderProgram::TRANSFORM_WORLDNORMAL, N );
 
                         ro->getRenderTechnique()->getMaterial()->bind( m_pickingShaders[i] );
 
                         // render
+                        ro->getMesh()->bindVertexFormat( m_pickingShaders[i] );
                         ro->getMesh()->render();
                     }
                 }
@@ -14,6 +14,9 @@
 #include <Core/Event/EventEnums.hpp>
 #include <Core/File/FileData.hpp>
 
+#include <Engine/Renderer/RenderStatistics.hpp>
+#include <Engine/Renderer/Light/FrameLight.hpp>
+
 namespace Ra
 {
     namespace Core
@@ -36,6 +39,7 @@ namespace Ra
         class Texture;
         class TextureManager;
         class RenderObjectManager;
+        class UniformBuffer;
     }
 }
 
@@ -110,6 +114,12 @@ namespace Ra
                 return m_timerData;
             }
 
+            /// Counters of the GL calls issued during the last rendered frame.
+            inline const RenderStatistics& getRenderStatistics() const
+            {
+                return m_renderStatistics;
+            }
+
             inline Texture* getDisplayTexture() const
             {
                 return m_displayedTexture;
@@ -163,6 +173,17 @@ namespace Ra
              */
             void render( const RenderData& renderData );
 
+            /**
+             * @brief Take the snapshot of the scene drawn by the next call to render().
+             * Gathers the render objects, uploads their dirty meshes and techniques,
+             * freezes their model matrices and material parameters, copies the lights
+             * and gathers the debug geometry added by the tasks. Once this returns,
+             * render() does not read any data written by the engine systems, so the
+             * tasks of the next frame can run while it draws. If this is not called,
+             * render() takes the snapshot itself.
+             */
+            void prepareFrame( const RenderData& renderData );
+
             // -=-=-=-=-=-=-=-=- VIRTUAL -=-=-=-=-=-=-=-=- //
             /**
              * @brief Initialize renderer
@@ -295,17 +316,29 @@ namespace Ra
              */
             virtual void uiInternal( const RenderData& renderData ) = 0; // idem ?
 
+            /**
+             * @brief Upload the given light of the frame to the shared light uniform buffer.
+             * Must be called before drawing objects lit by this light.
+             */
+            void updateLightBlock( const FrameLight& light );
+
         private:
 
             // 0.
             void saveExternalFBOInternal();
 
+            // 1. and 2.0, unless prepareFrame() was called.
+            void prepareFrameInternal( const RenderData& renderData );
+
             // 1.
             void feedRenderQueuesInternal(const RenderData &renderData);
 
             // 2.0
             void updateRenderObjectsInternal( const RenderData& renderData);
 
+            // 2.1
+            void updateCameraBlockInternal( const RenderData& renderData );
+
             // 3.
             void splitRenderQueuesForPicking( const RenderData &renderData );
             void splitRQ( const std::vector<RenderObjectPtr>& renderQueue,
@@ -345,7 +378,12 @@ namespace Ra
             // FIXME(Charly): Scene class
             std::vector<std::shared_ptr<Light>> m_lights;
 
+            // Lights drawn by render(), copied from m_lights when the frame is prepared.
+            std::vector<FrameLight> m_frameLights;
+
+            // False when the render object lists were rebuilt this frame.
             bool m_renderQueuesUpToDate;
+            uint m_renderQueuesVersion;
 
             std::vector<RenderObjectPtr> m_fancyRenderObjects;
             std::vector<RenderObjectPtr> m_debugRenderObjects;
@@ -369,6 +407,16 @@ namespace Ra
             // Renderer timings data
             TimerData m_timerData;
 
+            // True when prepareFrame() took the snapshot of the next frame.
+            bool m_framePrepared;
+
+            // GL calls counters of the last frame
+            RenderStatistics m_renderStatistics;
+
+            // Uniform buffers shared by all the shader programs
+            std::unique_ptr<UniformBuffer> m_cameraBuffer;
+            std::unique_ptr<UniformBuffer> m_lightBuffer;
+
             std::mutex m_renderMutex;
 
             // PICKING STUFF
@@ -6,23 +6,68 @@
 
 #include <Engine/Renderer/RenderTechnique/ShaderProgramManager.hpp>
 
-#include <Engine/Renderer/RenderObject/Primitives/DrawPrimitives.hpp>
-
 #include <Core/Log/Log.hpp>
 #include <Core/Containers/MakeShared.hpp>
+#include <Core/Math/ColorPresets.hpp>
 #include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
 
 namespace Ra
 {
     namespace Engine
     {
+        namespace
+        {
+            // Edges of the geodesic sphere of radius 1 used by addSphere(), as pairs of points.
+            const Core::Vector3Array& getUnitSphereEdges()
+            {
+                static const Core::Vector3Array edges = []()
+                {
+                    const Core::TriangleMesh sphere = Core::MeshUtils::makeGeodesicSphere(1.0, 2);
+                    Core::Vector3Array result;
+                    for (const auto& t : sphere.m_triangles)
+                    {
+                        for (uint k = 0; k < 3; ++k)
+                        {
+                            // Each edge is shared by two triangles, in opposite directions.
+                            const uint a = t[k];
+                            const uint b = t[(k + 1) % 3];
+                            if (a < b)
+                            {
+                                result.push_back(sphere.m_vertices[a]);
+                                result.push_back(sphere.m_vertices[b]);
+                            }
+                        }
+                    }
+                    return result;
+                }();
+                return edges;
+            }
+            
+            const uint s_circleSegments = 64;
+        }
+        
         DebugRender::DebugRender()
+            : m_lineVertexCount(0)
+            , m_pointVertexCount(0)
+            , m_triangleVertexCount(0)
+            , m_vao(0)
+            , m_vbo(0)
+            , m_vboSize(0)
         {
+            static_assert(sizeof(Vertex) == 16, "Debug vertices are not packed");
         }
         
         DebugRender::~DebugRender()
         {
+            if (m_vao != 0)
+            {
+                glDeleteVertexArrays(1, &m_vao);
+                glDeleteBuffers(1, &m_vbo);
+            }
         }
         
         void DebugRender::initialize()
@@ -131,7 +176,7 @@ namespace Ra
 #version 330
             
             layout (location = 0) in vec3 in_pos;
-            layout (location = 1) in vec3 in_col;
+            layout (location = 5) in vec3 in_col;
             
             uniform mat4 view;
             uniform mat4 proj;
@@ -200,36 +245,84 @@ namespace Ra
             m_viewMeshLoc  = glGetUniformLocation(m_meshProg, "view");
             m_projMeshLoc  = glGetUniformLocation(m_meshProg, "proj");
             
+            // Streams vertex format, matching the in_pos and in_col attributes of the programs.
+            glGenVertexArrays(1, &m_vao);
+            glBindVertexArray(m_vao);
+            glGenBuffers(1, &m_vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, pos));
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, col));
+            glEnableVertexAttribArray(5);
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            
             GL_CHECK_ERROR;
         }
         
         void DebugRender::render(const Core::Matrix4& viewMatrix,
                                  const Core::Matrix4& projMatrix)
         {
-            renderLines(viewMatrix.cast<float>(), projMatrix.cast<float>());
-            renderPoints(viewMatrix.cast<float>(), projMatrix.cast<float>());
+            renderStreams(viewMatrix.cast<float>(), projMatrix.cast<float>());
             renderMeshes(viewMatrix.cast<float>(), projMatrix.cast<float>());
         }
         
-        void DebugRender::renderLines(const Core::Matrix4f& viewMatrix, const Core::Matrix4f& projMatrix)
+        void DebugRender::prepareFrame()
         {
-            Core::Vector3Array vertices;
-            Core::Vector4Array colors;
-            std::vector<GLuint>  indices;
-            unsigned int indexI = 0;
-            for (const auto& l : m_lines)
+            uint lines = 0, points = 0, triangles = 0;
+            m_streams.forEach([&lines, &points, &triangles](const Streams& s)
             {
-                vertices.push_back(l.a);
-                vertices.push_back(l.b);
-                
-                colors.push_back(l.col);
-                colors.push_back(l.col);
+                lines += uint(s.lines.size());
+                points += uint(s.points.size());
+                triangles += uint(s.triangles.size());
+            });
+            
+            m_vertices.resize(lines + points + triangles);
+            m_meshes.clear();
+            auto lineIt = m_vertices.begin();
+            auto pointIt = lineIt + lines;
+            auto triangleIt = pointIt + points;
+            
+            // The streams are cleared but keep their memory for the next frame.
+            m_streams.forEach([&](Streams& s)
+            {
+                lineIt = std::copy(s.lines.begin(), s.lines.end(), lineIt);
+                pointIt = std::copy(s.points.begin(), s.points.end(), pointIt);
+                triangleIt = std::copy(s.triangles.begin(), s.triangles.end(), triangleIt);
+                m_meshes.insert(m_meshes.end(), s.meshes.begin(), s.meshes.end());
                 
-                indices.push_back(indexI++);
-                indices.push_back(indexI++);
+                s.lines.clear();
+                s.points.clear();
+                s.triangles.clear();
+                s.meshes.clear();
+            });
+            
+            m_lineVertexCount = lines;
+            m_pointVertexCount = points;
+            m_triangleVertexCount = triangles;
+        }
+        
+        void DebugRender::renderStreams(const Core::Matrix4f& viewMatrix, const Core::Matrix4f& projMatrix)
+        {
+            if (m_vertices.empty())
+            {
+                return;
+            }
+            
+            // Orphan the storage of the previous frame, which may still be in use, and grow it geometrically.
+            const std::size_t size = m_vertices.size() * sizeof(Vertex);
+            if (size > m_vboSize)
+            {
+                m_vboSize = std::max(size, 2 * m_vboSize);
             }
+            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+            glBufferData(GL_ARRAY_BUFFER, m_vboSize, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, size, m_vertices.data());
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
             
-            if (vertices.size() > 0)
+            glBindVertexArray(m_vao);
+            
+            if (m_lineVertexCount + m_triangleVertexCount > 0)
             {
                 const Core::Matrix4f id = Core::Matrix4f::Identity();
                 
@@ -238,57 +331,29 @@ namespace Ra
                 glUniformMatrix4fv(m_viewLineLoc, 1, GL_FALSE, viewMatrix.data());
                 glUniformMatrix4fv(m_projLineLoc, 1, GL_FALSE, projMatrix.data());
                 
-                Mesh mesh("temp", Mesh::RM_LINES);
-                mesh.loadGeometry(vertices, indices);
-                mesh.addData(Mesh::VERTEX_COLOR, colors);
-                mesh.updateGL();
-                mesh.render();
+                if (m_lineVertexCount > 0)
+                {
+                    glDrawArrays(GL_LINES, 0, m_lineVertexCount);
+                }
+                if (m_triangleVertexCount > 0)
+                {
+                    glDrawArrays(GL_TRIANGLES, m_lineVertexCount + m_pointVertexCount, m_triangleVertexCount);
+                }
             }
             
-            m_lines.clear();
-        }
-        
-        void DebugRender::renderPoints(const Core::Matrix4f& viewMatrix, const Core::Matrix4f& projMatrix)
-        {
-            uint size = m_points.size();
-            if (0 == size)
+            if (m_pointVertexCount > 0)
             {
-                return;
+                glEnable(GL_PROGRAM_POINT_SIZE);
+                glUseProgram(m_pointProg);
+                glUniformMatrix4fv(m_viewPointLoc, 1, GL_FALSE, viewMatrix.data());
+                glUniformMatrix4fv(m_projPointLoc, 1, GL_FALSE, projMatrix.data());
+                
+                glDrawArrays(GL_POINTS, m_lineVertexCount, m_pointVertexCount);
+                glDisable(GL_PROGRAM_POINT_SIZE);
             }
             
-            GLuint vao, vbo;
-            glGenVertexArrays(1, &vao);
-            
-            glBindVertexArray(vao);
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            glBufferData(GL_ARRAY_BUFFER, size * 2 * sizeof(Core::Vector3), m_points.data(), GL_DYNAMIC_DRAW);
-            
-#ifdef CORE_USE_DOUBLE
-            GLenum type = GL_DOUBLE;
-#else
-            GLenum type = GL_FLOAT;
-#endif
-            GLint64 ptr = 0;
-            glVertexAttribPointer(0, 3, type, GL_FALSE, 6 * sizeof(Scalar), (GLvoid*)ptr);
-            glEnableVertexAttribArray(0);
-            ptr += 3 * sizeof(Scalar);
-            glVertexAttribPointer(1, 3, type, GL_FALSE, 6 * sizeof(Scalar), (GLvoid*)ptr);
-            glEnableVertexAttribArray(1);
-            
-            glEnable(GL_PROGRAM_POINT_SIZE);
-            glUseProgram(m_pointProg);
-            glUniformMatrix4fv(m_viewPointLoc, 1, GL_FALSE, viewMatrix.data());
-            glUniformMatrix4fv(m_projPointLoc, 1, GL_FALSE, projMatrix.data());
-            
-            glDrawArrays(GL_POINTS, 0, size);
-            glDisable(GL_PROGRAM_POINT_SIZE);
-            
             glBindVertexArray(0);
-            glDeleteVertexArrays(1, &vao);
-            glDeleteBuffers(1, &vbo);
-            
-            m_points.clear();
+            m_vertices.clear();
         }
         
         void DebugRender::renderMeshes(const Core::Matrix4f &view, const Core::Matrix4f &proj)
@@ -335,39 +400,51 @@ namespace Ra
             m_meshes.clear();
         }
         
+        DebugRender::Vertex DebugRender::makeVertex(const Core::Vector3& p, const Core::VertexPacking::Color8& c)
+        {
+            return {{float(p.x()), float(p.y()), float(p.z())}, c};
+        }
+        
         void DebugRender::addLine(const Core::Vector3& from,
                                   const Core::Vector3& to,
                                   const Core::Color& color)
         {
-            Line l(from, to, color);
-            m_lines.push_back(l);
+            const Core::VertexPacking::Color8 c = Core::VertexPacking::packColor(color);
+            std::vector<Vertex>& lines = m_streams.local().lines;
+            lines.push_back(makeVertex(from, c));
+            lines.push_back(makeVertex(to, c));
         }
         
         void DebugRender::addPoint(const Core::Vector3 &p, const Core::Color &c)
         {
-            m_points.push_back({p,c.head<3>()});
+            m_streams.local().points.push_back(makeVertex(p, Core::VertexPacking::packColor(c)));
         }
         
         void DebugRender::addPoints(const Core::Vector3Array& p, const Core::Color& c)
         {
+            const Core::VertexPacking::Color8 color = Core::VertexPacking::packColor(c);
+            std::vector<Vertex>& points = m_streams.local().points;
+            points.reserve(points.size() + p.size());
             for (uint i = 0; i < p.size(); ++i)
             {
-                m_points.push_back({p[i], c.head<3>()});
+                points.push_back(makeVertex(p[i], color));
             }
         }
         
         void DebugRender::addPoints(const Core::Vector3Array &p, const Core::Vector4Array &c)
         {
             CORE_ASSERT(p.size() == c.size(), "Data sizes mismatch.");
+            std::vector<Vertex>& points = m_streams.local().points;
+            points.reserve(points.size() + p.size());
             for (uint i = 0; i < p.size(); ++i)
             {
-                m_points.push_back({p[i], c[i].head<3>()});
+                points.push_back(makeVertex(p[i], Core::VertexPacking::packColor(c[i])));
             }
         }
         
         void DebugRender::addMesh(const std::shared_ptr<Mesh> &mesh, const Core::Transform& transform)
         {
-            m_meshes.push_back({mesh, transform});
+            m_streams.local().meshes.push_back({mesh, transform});
         }
         
         void DebugRender::addCross(const Core::Vector3& position,
@@ -391,7 +468,14 @@ namespace Ra
                                     Scalar radius,
                                     const Core::Color& color)
         {
-            addMesh(DrawPrimitives::Sphere(center, radius, color));
+            const Core::Vector3Array& edges = getUnitSphereEdges();
+            const Core::VertexPacking::Color8 c = Core::VertexPacking::packColor(color);
+            std::vector<Vertex>& lines = m_streams.local().lines;
+            lines.reserve(lines.size() + edges.size());
+            for (const auto& p : edges)
+            {
+                lines.push_back(makeVertex(center + radius * p, c));
+            }
         }
         
         void DebugRender::addCircle(const Core::Vector3& center,
@@ -399,31 +483,88 @@ namespace Ra
                                     Scalar radius,
                                     const Core::Color& color)
         {
-            addMesh(DrawPrimitives::Circle(center, normal, radius, 64, color));
+            Core::Vector3 xPlane, yPlane;
+            Core::Vector::getOrthogonalVectors(normal, xPlane, yPlane);
+            xPlane.normalize();
+            yPlane.normalize();
+            
+            const Core::VertexPacking::Color8 c = Core::VertexPacking::packColor(color);
+            std::vector<Vertex>& lines = m_streams.local().lines;
+            const Scalar thetaInc(Core::Math::PiMul2 / Scalar(s_circleSegments));
+            Core::Vector3 prev = center + radius * xPlane;
+            for (uint i = 1; i <= s_circleSegments; ++i)
+            {
+                const Scalar theta = i * thetaInc;
+                const Core::Vector3 p = center + radius * (std::cos(theta) * xPlane + std::sin(theta) * yPlane);
+                lines.push_back(makeVertex(prev, c));
+                lines.push_back(makeVertex(p, c));
+                prev = p;
+            }
         }
         
         void DebugRender::addFrame(const Core::Transform& transform,
                                    Scalar size)
         {
-            addMesh(DrawPrimitives::Frame(transform, size));
+            const Core::Vector3 pos = transform.translation();
+            addLine(pos, pos + size * (transform.linear() * Core::Vector3::UnitX()), Core::Colors::Red());
+            addLine(pos, pos + size * (transform.linear() * Core::Vector3::UnitY()), Core::Colors::Green());
+            addLine(pos, pos + size * (transform.linear() * Core::Vector3::UnitZ()), Core::Colors::Blue());
         }
         
         void DebugRender::addTriangle(const Core::Vector3& p0,
                                       const Core::Vector3& p1,
                                       const Core::Vector3& p2,
-                                      const Core::Color& color)
+                                      const Core::Color& color,
+                                      bool fill)
         {
-            addMesh(DrawPrimitives::Triangle(p0, p1, p2, color));
+            if (fill)
+            {
+                const Core::VertexPacking::Color8 c = Core::VertexPacking::packColor(color);
+                std::vector<Vertex>& triangles = m_streams.local().triangles;
+                triangles.push_back(makeVertex(p0, c));
+                triangles.push_back(makeVertex(p1, c));
+                triangles.push_back(makeVertex(p2, c));
+            }
+            else
+            {
+                addLine(p0, p1, color);
+                addLine(p1, p2, color);
+                addLine(p2, p0, color);
+            }
         }
         
         void DebugRender::addAABB(const Core::Aabb& box, const Core::Color& color)
         {
-            addMesh(DrawPrimitives::AABB(box, color));
+            addBox(box, Core::Transform::Identity(), color);
         }
         
         void DebugRender::addOBB(const Core::Aabb& box, const Core::Transform& transform, const Core::Color& color)
         {
-            addMesh(DrawPrimitives::AABB(box, color), transform);
+            addBox(box, transform, color);
+        }
+        
+        void DebugRender::addBox(const Core::Aabb& box, const Core::Transform& transform, const Core::Color& color)
+        {
+            // Corner i is at the max of the box on the axes of its bits : edges join corners differing by one bit.
+            Core::Vector3 corners[8];
+            for (uint i = 0; i < 8; ++i)
+            {
+                corners[i] = transform * box.corner(Core::Aabb::CornerType(i));
+            }
+            
+            const Core::VertexPacking::Color8 c = Core::VertexPacking::packColor(color);
+            std::vector<Vertex>& lines = m_streams.local().lines;
+            for (uint i = 0; i < 8; ++i)
+            {
+                for (uint axis = 1; axis < 8; axis <<= 1)
+                {
+                    if ((i & axis) == 0)
+                    {
+                        lines.push_back(makeVertex(corners[i], c));
+                        lines.push_back(makeVertex(corners[i | axis], c));
+                    }
+                }
+            }
         }
         
         RA_SINGLETON_IMPLEMENTATION(DebugRender);
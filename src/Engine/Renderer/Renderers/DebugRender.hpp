@@ -5,6 +5,8 @@
 
 #include <Core/Utils/Singleton.hpp>
 #include <Core/Containers/VectorArray.hpp>
+#include <Core/Containers/ThreadBuffers.hpp>
+#include <Core/Mesh/VertexPacking.hpp>
 
 #include <Engine/Renderer/Mesh/Mesh.hpp>
 
@@ -13,6 +15,13 @@ namespace Ra
 {
     namespace Engine
     {
+        /// Immediate mode drawing of debug geometry.
+        /// Lines, points and triangles are appended to per-frame vertex streams, which can be
+        /// filled from any thread : each thread writes to its own streams, which are merged
+        /// by prepareFrame() once the tasks of the frame are done, then uploaded to one persistent
+        /// vertex buffer and drawn with a single call per primitive type by render(). Geometry
+        /// added while render() runs (e.g. by the tasks of the next frame in pipelined mode) is
+        /// drawn with the next frame.
         class RA_ENGINE_API DebugRender
         {
             RA_SINGLETON_INTERFACE(DebugRender);
@@ -22,8 +31,18 @@ namespace Ra
             virtual ~DebugRender();
             
             void initialize();
+            
+            /// Gather the geometry added since the last call, which is drawn by render().
+            /// Nothing must be added meanwhile (see Renderer::prepareFrame()).
+            void prepareFrame();
+            
             void render(const Core::Matrix4& view, const Core::Matrix4& proj);
             
+            /// Number of vertices of the lines, points and triangles gathered by prepareFrame().
+            inline uint getFrameLineVertexCount() const { return m_lineVertexCount; }
+            inline uint getFramePointVertexCount() const { return m_pointVertexCount; }
+            inline uint getFrameTriangleVertexCount() const { return m_triangleVertexCount; }
+            
             void addLine(const Core::Vector3& from, const Core::Vector3& to, const Core::Color& color);
             void addPoint(const Core::Vector3& p, const Core::Color& color);
             void addPoints(const Core::Vector3Array& p, const Core::Color& color);
@@ -47,10 +66,12 @@ namespace Ra
             void addFrame(const Core::Transform& transform,
                           Scalar size);
             
+            /// Draws the edges of the triangle, or the filled triangle if fill is true.
             void addTriangle(const Core::Vector3& p0,
                              const Core::Vector3& p1,
                              const Core::Vector3& p2,
-                             const Core::Color& color);
+                             const Core::Color& color,
+                             bool fill = false);
             
             void addAABB(const Core::Aabb& box,
                          const Core::Color& color);
@@ -60,18 +81,11 @@ namespace Ra
                         const Core::Color& color);
             
         private:
-            struct Line
+            /// Vertex of the streams : float position and 8 bit color, 16 bytes.
+            struct Vertex
             {
-                Line(const Core::Vector3& la, const Core::Vector3& lb, const Core::Color& lcol) : a(la), b(lb), col(lcol) {}
-                
-                Core::Vector3 a, b;
-                Core::Color col;
-            };
-            
-            struct Point
-            {
-                Core::Vector3 p;
-                Core::Vector3 c;
+                float pos[3];
+                Core::VertexPacking::Color8 col;
             };
             
             struct DbgMesh
@@ -80,8 +94,21 @@ namespace Ra
                 Core::Transform transform;
             };
             
-            void renderLines(const Core::Matrix4f& view, const Core::Matrix4f& proj);
-            void renderPoints(const Core::Matrix4f& view, const Core::Matrix4f& proj);
+            /// Geometry added by one thread during the frame.
+            struct Streams
+            {
+                std::vector<Vertex> lines;      // Pairs of vertices.
+                std::vector<Vertex> points;
+                std::vector<Vertex> triangles;  // Triplets of vertices.
+                std::vector<DbgMesh> meshes;
+            };
+            
+            static Vertex makeVertex(const Core::Vector3& p, const Core::VertexPacking::Color8& c);
+            
+            /// Lines of the box edges, transformed.
+            void addBox(const Core::Aabb& box, const Core::Transform& transform, const Core::Color& color);
+            
+            void renderStreams(const Core::Matrix4f& view, const Core::Matrix4f& proj);
             void renderMeshes(const Core::Matrix4f& view, const Core::Matrix4f& proj);
             
         private:
@@ -100,10 +127,20 @@ namespace Ra
             uint m_viewPointLoc;
             uint m_projPointLoc;
             
-            std::vector<Line> m_lines;
+            Core::ThreadBuffers<Streams> m_streams;
+            
+            /// Vertices of the frame : lines, then points, then triangles.
+            std::vector<Vertex> m_vertices;
+            uint m_lineVertexCount;
+            uint m_pointVertexCount;
+            uint m_triangleVertexCount;
+            
             std::vector<DbgMesh> m_meshes;
             
-            std::vector<Point> m_points;
+            /// Persistent vertex buffer of the streams, reallocated only when it grows.
+            uint m_vao;
+            uint m_vbo;
+            std::size_t m_vboSize;
         };
     }
 }
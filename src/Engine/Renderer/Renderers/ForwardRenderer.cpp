@@ -1,6 +1,8 @@
 #include <Engine/Renderer/Renderers/ForwardRenderer.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 #include <Core/Log/Log.hpp>
 #include <Core/Math/ColorPresets.hpp>
@@ -13,7 +15,7 @@
 #include <Engine/Renderer/RenderTechnique/RenderTechnique.hpp>
 #include <Engine/Renderer/Material/Material.hpp>
 #include <Engine/Renderer/RenderTechnique/ShaderProgramManager.hpp>
-//#include <Engine/Renderer/RenderTechnique/ShaderProgram.hpp>
+#include <Engine/Renderer/RenderTechnique/ShaderProgram.hpp>
 #include <Engine/Renderer/RenderTechnique/ShaderConfigFactory.hpp>
 
 #include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
@@ -22,6 +24,7 @@
 #include <Engine/Renderer/Light/DirLight.hpp>
 #include <Engine/Renderer/Light/PointLight.hpp>
 #include <Engine/Renderer/Light/SpotLight.hpp>
+#include <Engine/Renderer/Light/ClusteredLighting.hpp>
 #include <Engine/Renderer/Mesh/Mesh.hpp>
 #include <Engine/Renderer/Texture/TextureManager.hpp>
 #include <Engine/Renderer/Texture/Texture.hpp>
@@ -51,6 +54,7 @@ namespace Ra {
         
         ForwardRenderer::ForwardRenderer()
         : Renderer()
+        , m_clusteredLightingEnabled( true )
         {
             
         }
@@ -65,6 +69,14 @@ namespace Ra {
             initShaders();
             initBuffers();
             
+            m_clusteredLighting.reset( new ClusteredLighting );
+            m_clusteredLighting->initializeGL();
+            
+            DirectionalLight defaultLight;
+            defaultLight.setDirection(Core::Vector3(0.3f, -1.0f, 0.0f));
+            m_defaultLights.resize(1);
+            defaultLight.getFrameLight(m_defaultLights[0]);
+            
             if (!DebugRender::getInstance())
             {
                 DebugRender::createInstance();
@@ -134,29 +146,55 @@ namespace Ra {
         void ForwardRenderer::updateStepInternal(const RenderData &renderData)
         {
 #ifndef NO_TRANSPARENCY
-            m_transparentRenderObjects.clear();
-            
-            for (auto it = m_fancyRenderObjects.begin(); it != m_fancyRenderObjects.end();)
+            // The fancy objects list is only refilled when the render queues were invalidated.
+            if (!m_renderQueuesUpToDate)
             {
-                std::shared_ptr<RenderObject> ro = *it;
-                if (ro->isTransparent())
-                {
-                    m_transparentRenderObjects.push_back(ro);
-                    it = m_fancyRenderObjects.erase(it);
-                }
-                else
-                {
-                    ++it;
-                }
+                m_transparentRenderObjects.clear();
+                
+                auto transparent = std::stable_partition(m_fancyRenderObjects.begin(), m_fancyRenderObjects.end(),
+                                                         [](const RenderObjectPtr &ro) { return !ro->isTransparent(); });
+                std::move(transparent, m_fancyRenderObjects.end(), std::back_inserter(m_transparentRenderObjects));
+                m_fancyRenderObjects.erase(transparent, m_fancyRenderObjects.end());
+                
+                m_fancyTransparentCount = m_transparentRenderObjects.size();
             }
             
-            m_fancyTransparentCount = m_transparentRenderObjects.size();
-            
             //Ra::Core::remove_copy_if(m_debugRenderObjects, m_transparentRenderObjects,
             //                         [](auto ro) { return ro->isTransparent(); });
             
             // FIXME(charly) Do we want ui too  ?
 #endif
+            
+            const Core::Matrix4 &view = renderData.viewMatrix;
+            
+            m_zPrepassQueue.update(m_fancyRenderObjects, RenderTechnique::Z_PREPASS, view);
+            
+            if (m_clusteredLightingEnabled)
+            {
+                m_opaqueClusteredQueue.update(m_fancyRenderObjects, RenderTechnique::LIGHTING_OPAQUE_CLUSTERED, view);
+                m_opaqueQueue.update(m_fancyRenderObjects, RenderTechnique::LIGHTING_OPAQUE, view,
+                                     RenderTechnique::LIGHTING_OPAQUE_CLUSTERED);
+            }
+            else
+            {
+                m_opaqueClusteredQueue.update({}, RenderTechnique::LIGHTING_OPAQUE_CLUSTERED, view);
+                m_opaqueQueue.update(m_fancyRenderObjects, RenderTechnique::LIGHTING_OPAQUE, view);
+            }
+            
+#ifndef NO_TRANSPARENCY
+            if (m_clusteredLightingEnabled)
+            {
+                m_transparentClusteredQueue.update(m_transparentRenderObjects,
+                                                   RenderTechnique::LIGHTING_TRANSPARENT_CLUSTERED, view);
+                m_transparentQueue.update(m_transparentRenderObjects, RenderTechnique::LIGHTING_TRANSPARENT, view,
+                                          RenderTechnique::LIGHTING_TRANSPARENT_CLUSTERED);
+            }
+            else
+            {
+                m_transparentClusteredQueue.update({}, RenderTechnique::LIGHTING_TRANSPARENT_CLUSTERED, view);
+                m_transparentQueue.update(m_transparentRenderObjects, RenderTechnique::LIGHTING_TRANSPARENT, view);
+            }
+#endif
         }
         
         void ForwardRenderer::renderInternal(const RenderData &renderData)
@@ -191,10 +229,7 @@ namespace Ra {
             
             // Set in RenderParam the configuration about ambiant lighting (instead of hard constant direclty in shaders)
             RenderParameters params;
-            for (const auto &ro : m_fancyRenderObjects)
-            {
-                ro->render(params, renderData, RenderTechnique::Z_PREPASS);
-            }
+            m_zPrepassQueue.render(params, renderData);
             
             // Light pass
             GL_ASSERT(glDepthFunc(GL_LEQUAL));
@@ -205,33 +240,14 @@ namespace Ra {
             
             GL_ASSERT(glDrawBuffers(1, buffers));   // Draw color texture
             
-            if (m_lights.size() > 0)
+            if (m_clusteredLightingEnabled)
             {
-                for (const auto &l : m_lights)
-                {
-                    RenderParameters params;
-                    l->getRenderParameters(params);
-                    
-                    for (const auto &ro : m_fancyRenderObjects)
-                    {
-                        ro->render(params, renderData, RenderTechnique::LIGHTING_OPAQUE);
-                    }
-                }
-            }
-            else
-            {
-                DirectionalLight l;
-                l.setDirection(Core::Vector3(0.3f, -1.0f, 0.0f));
-                
-                RenderParameters params;
-                l.getRenderParameters(params);
-                
-                for (const auto &ro : m_fancyRenderObjects)
-                {
-                    ro->render(params, renderData, RenderTechnique::LIGHTING_OPAQUE);
-                }
+                const auto &lights = m_frameLights.empty() ? m_defaultLights : m_frameLights;
+                m_clusteredLighting->update(lights, renderData, m_width, m_height);
             }
             
+            renderLighting(m_opaqueQueue, m_opaqueClusteredQueue, renderData);
+            
 #ifndef NO_TRANSPARENCY
             m_fbo->unbind();
             m_oitFbo->bind();
@@ -247,32 +263,7 @@ namespace Ra {
             GL_ASSERT(glBlendFunci(0, GL_ONE, GL_ONE));
             GL_ASSERT(glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA));
             
-            if (m_lights.size() > 0)
-            {
-                for (const auto &l : m_lights)
-                {
-                    RenderParameters params;
-                    l->getRenderParameters(params);
-                    
-                    for (const auto &ro : m_transparentRenderObjects)
-                    {
-                        ro->render(params, renderData, RenderTechnique::LIGHTING_TRANSPARENT);
-                    }
-                }
-            }
-            else
-            {
-                DirectionalLight l;
-                l.setDirection(Core::Vector3(0.3f, -1.0f, 0.0f));
-                
-                RenderParameters params;
-                l.getRenderParameters(params);
-                
-                for (const auto &ro : m_transparentRenderObjects)
-                {
-                    ro->render(params, renderData, RenderTechnique::LIGHTING_TRANSPARENT);
-                }
-            }
+            renderLighting(m_transparentQueue, m_transparentClusteredQueue, renderData);
             
             m_oitFbo->unbind();
             
@@ -309,32 +300,11 @@ namespace Ra {
                 
                 GL_ASSERT(glDrawBuffers(1, buffers));   // Draw color texture
                 
-                if (m_lights.size() > 0)
+                const auto &lights = m_frameLights.empty() ? m_defaultLights : m_frameLights;
+                for (const auto &l : lights)
                 {
-                    for (const auto &l : m_lights)
-                    {
-                        RenderParameters params;
-                        l->getRenderParameters(params);
-                        
-                        for (const auto &ro : m_fancyRenderObjects)
-                        {
-                            ro->render(params, renderData, RenderTechnique::LIGHTING_OPAQUE);
-                        }
-                        
-                        for (size_t i = 0; i < m_fancyTransparentCount; ++i)
-                        {
-                            auto &ro = m_transparentRenderObjects[i];
-                            ro->render(params, renderData, RenderTechnique::LIGHTING_OPAQUE);
-                        }
-                    }
-                }
-                else
-                {
-                    DirectionalLight l;
-                    l.setDirection(Core::Vector3(0.3f, -1.0f, 0.0f));
-                    
-                    RenderParameters params;
-                    l.getRenderParameters(params);
+                    const RenderParameters &params = l.m_params;
+                    updateLightBlock(l);
                     
                     for (const auto &ro : m_fancyRenderObjects)
                     {
@@ -361,6 +331,32 @@ namespace Ra {
             m_fbo->unbind();
         }
         
+        void ForwardRenderer::renderLighting(const RenderQueue &multiPassQueue, const RenderQueue &clusteredQueue,
+                                             const RenderData &renderData)
+        {
+            if (!clusteredQueue.empty())
+            {
+                RenderParameters params;
+                m_clusteredLighting->bind(params);
+                clusteredQueue.render(params, renderData);
+            }
+            
+            // Objects that can not be shaded in a single pass are drawn once per light
+            if (multiPassQueue.empty())
+            {
+                return;
+            }
+            
+            const auto &lights = m_frameLights.empty() ? m_defaultLights : m_frameLights;
+            for (const auto &l : lights)
+            {
+                const RenderParameters &params = l.m_params;
+                updateLightBlock(l);
+                
+                multiPassQueue.render(params, renderData);
+            }
+        }
+        
         // Draw debug stuff, do not overwrite depth map but do depth testing
         void ForwardRenderer::debugInternal(const RenderData &renderData)
         {
@@ -445,14 +441,14 @@ namespace Ra {
                         // bind data
                         shader->bind();
                         
-                        Core::Matrix4 M = ro->getTransformAsMatrix();
-                        shader->setUniform("transform.proj", renderData.projMatrix);
-                        shader->setUniform("transform.view", renderData.viewMatrix);
-                        shader->setUniform("transform.model", M);
+                        shader->setUniform(ShaderProgram::TRANSFORM_PROJ, renderData.projMatrix);
+                        shader->setUniform(ShaderProgram::TRANSFORM_VIEW, renderData.viewMatrix);
+                        shader->setUniform(ShaderProgram::TRANSFORM_MODEL, ro->getFrameModelMatrix());
                         
                         ro->getRenderTechnique()->getMaterial()->bind(shader);
                         
                         // render
+                        ro->getMesh()->bindVertexFormat(shader);
                         ro->getMesh()->render();
                     }
                 }
@@ -485,7 +481,7 @@ namespace Ra {
                     // bind data
                     shader->bind();
                     
-                    Core::Matrix4 M = ro->getTransformAsMatrix();
+                    Core::Matrix4 M = ro->getFrameModelMatrix();
                     Core::Matrix4 MV = renderData.viewMatrix * M;
                     Core::Vector3 V = MV.block<3, 1>(0, 3);
                     Scalar d = V.norm();
@@ -495,13 +491,14 @@ namespace Ra {
                     
                     M = M * S;
                     
-                    shader->setUniform("transform.proj", renderData.projMatrix);
-                    shader->setUniform("transform.view", renderData.viewMatrix);
-                    shader->setUniform("transform.model", M);
+                    shader->setUniform(ShaderProgram::TRANSFORM_PROJ, renderData.projMatrix);
+                    shader->setUniform(ShaderProgram::TRANSFORM_VIEW, renderData.viewMatrix);
+                    shader->setUniform(ShaderProgram::TRANSFORM_MODEL, M);
                     
                     ro->getRenderTechnique()->getMaterial()->bind(shader);
                     
                     // render
+                    ro->getMesh()->bindVertexFormat(shader);
                     ro->getMesh()->render();
                 }
             }
@@ -5,12 +5,15 @@
 
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Renderer/Renderer.hpp>
+#include <Engine/Renderer/RenderTechnique/RenderTechnique.hpp>
+#include <Engine/Renderer/RenderQueue/RenderQueue.hpp>
 
 namespace Ra
 {
     namespace Engine
     {
         class Texture;
+        class ClusteredLighting;
     }
 }
 
@@ -26,6 +29,11 @@ namespace Ra
             
             virtual std::string getRendererName() const override { return "Forward Renderer"; }
             
+            /// When enabled (the default), objects whose render technique has a clustered lighting
+            /// pass are shaded with all the lights in a single draw. Others are drawn once per light.
+            inline void enableClusteredLighting( bool enabled ) { m_clusteredLightingEnabled = enabled; }
+            inline bool isClusteredLightingEnabled() const { return m_clusteredLightingEnabled; }
+            
         protected:
             
             virtual void initializeInternal() override;
@@ -44,6 +52,11 @@ namespace Ra
             
             void updateShadowMaps();
             
+            /// Shade the objects of clusteredQueue with all the lights in a single draw,
+            /// and the objects of multiPassQueue with one draw per light.
+            void renderLighting( const RenderQueue& multiPassQueue, const RenderQueue& clusteredQueue,
+                                 const RenderData& renderData );
+            
         protected:
             enum RendererTextures
             {
@@ -65,6 +78,13 @@ namespace Ra
             std::vector<RenderObjectPtr> m_transparentRenderObjects;
             uint m_fancyTransparentCount;
             
+            // Sorted draw lists of each pass.
+            RenderQueue m_zPrepassQueue;
+            RenderQueue m_opaqueQueue;
+            RenderQueue m_opaqueClusteredQueue;
+            RenderQueue m_transparentQueue;
+            RenderQueue m_transparentClusteredQueue;
+            
             uint m_pingPongSize;
             
             std::array<std::unique_ptr<Texture>, RendererTexture_Count> m_textures;
@@ -72,6 +92,12 @@ namespace Ra
             static const int ShadowMapSize = 1024;
             std::vector<std::shared_ptr<Texture>> m_shadowMaps;
             std::vector<Core::Matrix4> m_lightMatrices;
+            
+            bool m_clusteredLightingEnabled;
+            std::unique_ptr<ClusteredLighting> m_clusteredLighting;
+            
+            /// Light used by the lighting passes when the scene has none.
+            std::vector<FrameLight> m_defaultLights;
         };
         
     } // namespace Engine
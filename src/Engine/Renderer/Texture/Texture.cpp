@@ -1,7 +1,11 @@
 #include <Engine/Renderer/Texture/Texture.hpp>
 
+#include <algorithm>
+
 #include <globjects/Texture.h>
 
+#include <Engine/Renderer/RenderStatistics.hpp>
+
 namespace Ra
 {
     Engine::Texture::Texture(std::string name)
@@ -56,6 +60,35 @@ namespace Ra
         m_height = h;
     }
     
+    void Engine::Texture::Generate(uint w, uint h, GLenum format, const std::vector<const void*>& levels)
+    {
+        CORE_ASSERT( !levels.empty(), "No texture data." );
+        if( m_texture == nullptr )
+        {
+            m_texture = globjects::Texture::create( GL_TEXTURE_2D );
+        }
+
+        GLint alignment;
+        GL_ASSERT( glGetIntegerv( GL_UNPACK_ALIGNMENT, &alignment ) );
+        GL_ASSERT( glPixelStorei( GL_UNPACK_ALIGNMENT, 1 ) );
+        for ( uint l = 0; l < levels.size(); ++l )
+        {
+            m_texture->image2D( l, internalFormat, std::max( w >> l, 1u ), std::max( h >> l, 1u ), 0,
+                                format, dataType, levels[l] );
+        }
+        GL_ASSERT( glPixelStorei( GL_UNPACK_ALIGNMENT, alignment ) );
+
+        m_texture->setParameter( GL_TEXTURE_WRAP_S, wrapS );
+        m_texture->setParameter( GL_TEXTURE_WRAP_T, wrapT );
+        m_texture->setParameter( GL_TEXTURE_MIN_FILTER, minFilter );
+        m_texture->setParameter( GL_TEXTURE_MAG_FILTER, magFilter );
+        m_texture->setParameter( GL_TEXTURE_MAX_LEVEL, GLint( levels.size() - 1 ) );
+
+        m_format = format;
+        m_width  = w;
+        m_height = h;
+    }
+
     void Engine::Texture::Generate(uint w, uint h, uint d, GLenum format, void* data)
     {
         if( m_texture == nullptr )
@@ -103,6 +136,7 @@ namespace Ra
     
     void Engine::Texture::bind( int unit )
     {
+        ++getCurrentRenderStatistics().m_textureBinds;
         if( unit >= 0 )
         {
             m_texture->bindActive( unit );
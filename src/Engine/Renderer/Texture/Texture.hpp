@@ -5,6 +5,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Engine/Renderer/OpenGL/OpenGL.hpp>
@@ -102,6 +103,15 @@ namespace Ra
              * If \b data is not null, the texture will take the ownership of it.
              */
             void Generate(uint width, uint height, GLenum format, void* data = nullptr);
+
+            /**
+             * @brief Init the texture 2D with precomputed mipmaps.
+             *
+             * Same as above, except that no mipmaps are generated : \b levels gives the data of
+             * each level, starting from the full size image, each level having half the size of
+             * the previous one. Rows of the levels are tightly packed.
+             */
+            void Generate(uint width, uint height, GLenum format, const std::vector<const void*>& levels);
             
             /**
              * @brief Init the texture 3D from OpenGL point of view.
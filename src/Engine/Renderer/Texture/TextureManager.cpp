@@ -2,7 +2,6 @@
 
 #include <cstdio>
 
-#include <Core/Image/stb_image.h>
 #include <Core/Log/Log.hpp>
 #include <Engine/Renderer/Texture/Texture.hpp>
 
@@ -11,12 +10,15 @@ namespace Ra
     namespace Engine
     {
         TextureManager::TextureManager()
-        : m_verbose( false )
+        : m_uploadBudget( 32 << 20 )
+        , m_asyncLoading( true )
+        , m_verbose( false )
         {
         }
         
         TextureManager::~TextureManager()
         {
+            m_loader.stop();
             for ( auto& tex : m_textures )
             {
                 delete tex.second;
@@ -39,26 +41,54 @@ namespace Ra
         
         Texture* TextureManager::addTexture(const std::string& filename)
         {
-            Texture* ret = nullptr;
-            
-            int w, h, n;
-            stbi_set_flip_vertically_on_load(true);
-            
-            unsigned char* data = stbi_load(filename.c_str(), &w, &h, &n, 0);
-            
-            if (!data)
+            Core::TextureLoader::ImagePtr image = Core::TextureLoader::loadImage( filename, m_loaderParams );
+            if ( !image )
             {
                 LOG(logERROR) << "Something went wrong when loading image \"" << filename << "\".";
                 return nullptr;
             }
-            
+
+            Texture* ret = new Texture(filename);
+            uploadImage( ret, *image );
+            m_textures.insert(TexturePair(filename, ret));
+
+            return ret;
+        }
+
+        Texture* TextureManager::loadTexture( const std::string& filename, TextureData::Usage usage )
+        {
+            if ( !m_asyncLoading )
+            {
+                return addTexture( filename );
+            }
+
+            if ( !m_loader.isRunning() )
+            {
+                m_loader.start( m_loaderParams );
+            }
+
+            // Placeholder until the image is uploaded : white does not change colors and masks,
+            // and a normal map must not tilt the shading normals.
+            uint8_t white[4] = { 0xff, 0xff, 0xff, 0xff };
+            uint8_t flatNormal[4] = { 0x80, 0x80, 0xff, 0xff };
+            Texture* ret = new Texture(filename);
+            ret->internalFormat = GL_RGBA8;
+            ret->dataType = GL_UNSIGNED_BYTE;
+            ret->Generate(1, 1, GL_RGBA, usage == TextureData::NORMAL_MAP ? flatNormal : white);
+            m_textures.insert(TexturePair(filename, ret));
+
+            m_loader.request( filename );
+            return ret;
+        }
+
+        void TextureManager::uploadImage( Texture* texture, const Core::MipmappedImage& image )
+        {
             GLenum format;
             GLenum internal_format;
-            switch(n)
+            switch(image.m_channels)
             {
                 case 1:
                 {
-                    LOG(logINFO) << filename << " GL_R";
                     format = GL_RED;
                     internal_format = GL_R8;
                 } break;
@@ -75,38 +105,50 @@ namespace Ra
                     internal_format = GL_RGB8;
                 } break;
                     
-                case 4:
-                {
-                    format = GL_RGBA;
-                    internal_format = GL_RGBA8;
-                } break;
                 default :
                 {
                     format = GL_RGBA;
                     internal_format = GL_RGBA8;
                 } break;
             }
-            
+
             if ( m_verbose )
             {
-                LOG( logINFO ) << "Image stats (" << filename << ") :\n"
-                << "\tPixels : " << n << std::endl
+                LOG( logINFO ) << "Image stats (" << texture->getName() << ") :\n"
+                << "\tPixels : " << image.m_channels << std::endl
                 << "\tFormat : 0x" << std::hex << format << std::dec << std::endl
-                << "\tSize   : " << w << ", " << h;
+                << "\tSize   : " << image.m_width << ", " << image.m_height << std::endl
+                << "\tLevels : " << image.m_levels.size();
+            }
+
+            std::vector<const void*> levels;
+            for ( const auto& level : image.m_levels )
+            {
+                levels.push_back( level.data() );
+            }
+            texture->internalFormat = internal_format;
+            texture->dataType = GL_UNSIGNED_BYTE;
+            texture->Generate(image.m_width, image.m_height, format, levels);
+        }
+
+        void TextureManager::uploadLoadedTextures()
+        {
+            if ( !m_loader.isRunning() )
+            {
+                return;
+            }
+
+            std::vector<Core::TextureLoader::LoadedImage> loaded;
+            m_loader.takeLoaded( m_uploadBudget, loaded );
+            for ( const auto& l : loaded )
+            {
+                auto it = m_textures.find( l.m_filename );
+                // Failed images keep their placeholder, textures deleted while loading are ignored.
+                if ( l.m_image && it != m_textures.end() )
+                {
+                    uploadImage( it->second, *l.m_image );
+                }
             }
-            
-            CORE_ASSERT( data, "Data is null" );
-            
-            ret = new Texture(filename);
-            ret->internalFormat = internal_format;
-            ret->dataType = GL_UNSIGNED_BYTE;
-            ret->Generate(w, h, format, data);
-            
-            m_textures.insert(TexturePair(filename, ret));
-            
-            stbi_image_free(data);
-            
-            return ret;
         }
         
         Texture* TextureManager::getOrLoadTexture(const TextureData &data)
@@ -143,7 +185,7 @@ namespace Ra
                     }
                     else
                     {
-                        ret = addTexture(data.name);
+                        ret = loadTexture(data.name, data.usage);
                     }
                     
                     m_pendingTextures.erase(filename);
@@ -151,7 +193,7 @@ namespace Ra
                 }
                 else
                 {
-                    ret = addTexture(filename);
+                    ret = loadTexture(filename, TextureData::COLOR);
                 }
             }
             
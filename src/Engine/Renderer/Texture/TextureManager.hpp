@@ -5,6 +5,7 @@
 #include <map>
 #include <string>
 
+#include <Core/Image/TextureLoader.hpp>
 #include <Core/Utils/Singleton.hpp>
 
 #include <Engine/Renderer/OpenGL/OpenGL.hpp>
@@ -23,6 +24,13 @@ namespace Ra
     {
         struct TextureData
         {
+            /// What the texels are, which selects the neutral placeholder shown until the image is loaded.
+            enum Usage
+            {
+                COLOR,      ///< Colors and masks : white.
+                NORMAL_MAP, ///< Tangent space normals : (0, 0, 1), i.e. (128, 128, 255).
+            };
+
             std::string name;
             int width;
             int height;
@@ -38,6 +46,8 @@ namespace Ra
             GLenum magFilter = GL_LINEAR;
             
             void* data = nullptr;
+
+            Usage usage = COLOR;
         };
         
         class RA_ENGINE_API TextureManager
@@ -60,16 +70,46 @@ namespace Ra
             
             // Called by materials
             void updateTextures();
-            
+
+            /// When true (the default), getOrLoadTexture() returns a 1x1 placeholder texture at once,
+            /// and the image file is decoded on worker threads then uploaded by uploadLoadedTextures().
+            /// The placeholder is neutral for the usage of the texture (see TextureData::Usage), and is
+            /// kept if the image can not be decoded.
+            void setAsyncLoading( bool async ) { m_asyncLoading = async; }
+
+            /// Folder of the decoded images cache. No cache if empty (the default).
+            /// Must be set before the first texture is loaded.
+            void setCacheDirectory( const std::string& directory ) { m_loaderParams.m_cacheDirectory = directory; }
+
+            /// Maximum size of the images uploaded by each call to uploadLoadedTextures().
+            void setUploadBudget( std::size_t bytes ) { m_uploadBudget = bytes; }
+
+            /// Called once per frame by the renderer : upload the images loaded since the last
+            /// call, within the upload budget.
+            void uploadLoadedTextures();
+
+            Core::TextureLoader::Statistics getLoaderStatistics() const { return m_loader.getStatistics(); }
+
         private:
             TextureManager();
             ~TextureManager();
-            
+
+            /// Load the file synchronously or asynchronously.
+            Texture* loadTexture( const std::string& filename, TextureData::Usage usage );
+
+            /// Set the format of texture from the image, and upload all its levels.
+            void uploadImage( Texture* texture, const Core::MipmappedImage& image );
+
         private:
             std::map<std::string, Texture*> m_textures;
             std::map<std::string, TextureData> m_pendingTextures;
             std::map<std::string, void*> m_pendingData;
-            
+
+            Core::TextureLoader m_loader;
+            Core::TextureLoader::Parameters m_loaderParams;
+            std::size_t m_uploadBudget;
+            bool m_asyncLoading;
+
             bool m_verbose;
         };
         
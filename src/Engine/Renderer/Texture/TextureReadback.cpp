@@ -0,0 +1,113 @@
+#include <Engine/Renderer/Texture/TextureReadback.hpp>
+
+#include <Engine/Renderer/OpenGL/OpenGL.hpp>
+#include <Engine/Renderer/Texture/Texture.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        TextureReadback::TextureReadback()
+            : m_next( 0 )
+        {
+        }
+
+        TextureReadback::~TextureReadback()
+        {
+            CORE_ASSERT( m_buffers[0].m_pbo == 0 && m_buffers[1].m_pbo == 0,
+                         "releaseGL() was not called." );
+        }
+
+        void TextureReadback::start( Texture* texture, uint frameIndex, const Callback& callback )
+        {
+            PixelBuffer& buffer = m_buffers[m_next];
+            if ( buffer.m_fence != nullptr )
+            {
+                process( callback, true );
+            }
+
+            const std::size_t size = std::size_t( texture->width() ) * texture->height() * 4;
+            if ( buffer.m_pbo == 0 )
+            {
+                GL_ASSERT( glGenBuffers( 1, &buffer.m_pbo ) );
+            }
+            GL_ASSERT( glBindBuffer( GL_PIXEL_PACK_BUFFER, buffer.m_pbo ) );
+            if ( buffer.m_size != size )
+            {
+                GL_ASSERT( glBufferData( GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ ) );
+                buffer.m_size = size;
+            }
+
+            // With a pack buffer bound, the copy is queued and the pointer is an offset in the buffer.
+            // The GL converts the texture to RGBA8, clamping the values to [0, 1].
+            texture->bind();
+            GL_ASSERT( glPixelStorei( GL_PACK_ALIGNMENT, 1 ) );
+            GL_ASSERT( glGetTexImage( GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr ) );
+            GL_ASSERT( glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 ) );
+
+            // No flags.
+            buffer.m_fence = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, {} );
+            buffer.m_width = texture->width();
+            buffer.m_height = texture->height();
+            buffer.m_frameIndex = frameIndex;
+
+            m_next = 1 - m_next;
+        }
+
+        bool TextureReadback::process( const Callback& callback, bool wait )
+        {
+            // When both readbacks are pending, the oldest one is in the next buffer.
+            PixelBuffer& buffer = ( m_buffers[m_next].m_fence != nullptr ) ? m_buffers[m_next] : m_buffers[1 - m_next];
+            if ( buffer.m_fence == nullptr )
+            {
+                return false;
+            }
+
+            const GLuint64 timeout = wait ? GLuint64( -1 ) : 0;
+            const GLenum status = glClientWaitSync( static_cast<GLsync>( buffer.m_fence ), GL_SYNC_FLUSH_COMMANDS_BIT, timeout );
+            if ( status == GL_TIMEOUT_EXPIRED )
+            {
+                return false;
+            }
+            glDeleteSync( static_cast<GLsync>( buffer.m_fence ) );
+            buffer.m_fence = nullptr;
+
+            GL_ASSERT( glBindBuffer( GL_PIXEL_PACK_BUFFER, buffer.m_pbo ) );
+            const void* pixels = glMapBufferRange( GL_PIXEL_PACK_BUFFER, 0, buffer.m_size, GL_MAP_READ_BIT );
+            if ( pixels != nullptr )
+            {
+                callback( static_cast<const uint8_t*>( pixels ), buffer.m_width, buffer.m_height, buffer.m_frameIndex );
+                glUnmapBuffer( GL_PIXEL_PACK_BUFFER );
+            }
+            GL_ASSERT( glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 ) );
+            return pixels != nullptr;
+        }
+
+        void TextureReadback::finish( const Callback& callback )
+        {
+            while ( m_buffers[0].m_fence != nullptr || m_buffers[1].m_fence != nullptr )
+            {
+                process( callback, true );
+            }
+        }
+
+        void TextureReadback::releaseGL()
+        {
+            for ( auto& buffer : m_buffers )
+            {
+                if ( buffer.m_fence != nullptr )
+                {
+                    glDeleteSync( static_cast<GLsync>( buffer.m_fence ) );
+                    buffer.m_fence = nullptr;
+                }
+                if ( buffer.m_pbo != 0 )
+                {
+                    glDeleteBuffers( 1, &buffer.m_pbo );
+                    buffer.m_pbo = 0;
+                    buffer.m_size = 0;
+                }
+            }
+        }
+
+    } // namespace Engine
+} // namespace Ra
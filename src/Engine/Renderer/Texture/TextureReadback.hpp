@@ -0,0 +1,69 @@
+#ifndef RADIUMENGINE_TEXTUREREADBACK_HPP
+#define RADIUMENGINE_TEXTUREREADBACK_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        class Texture;
+
+        /// Asynchronous readback of 2D textures as RGBA8 pixels (bottom row first), through
+        /// two pixel pack buffers used in turn. start() queues the copy of a texture in a
+        /// buffer and returns without waiting for the GPU. The pixels are mapped one call
+        /// later, when the GPU is done with them, so reading a texture every frame does not
+        /// stall the pipeline.
+        /// All the methods need the GL context the readback was started with.
+        class RA_ENGINE_API TextureReadback
+        {
+        public:
+            /// Receives the pixels of a readback, valid only during the call.
+            typedef std::function<void( const uint8_t* pixels, uint width, uint height, uint frameIndex )> Callback;
+
+            TextureReadback();
+            ~TextureReadback();
+
+            /// Queue the readback of texture, tagged with frameIndex. If both buffers are busy,
+            /// the oldest readback is passed to callback first.
+            void start( Texture* texture, uint frameIndex, const Callback& callback );
+
+            /// Pass the oldest pending readback to callback, waiting for the GPU if wait is true.
+            /// Returns false if there was no readback, or it is not finished and wait is false.
+            bool process( const Callback& callback, bool wait );
+
+            /// Pass all the pending readbacks to callback.
+            void finish( const Callback& callback );
+
+            /// Delete the GL buffers. Must be called with the GL context before it is destroyed.
+            void releaseGL();
+
+        private:
+            struct PixelBuffer
+            {
+                uint m_pbo = 0;
+                void* m_fence = nullptr; ///< GLsync of the copy, set while the readback is pending.
+                std::size_t m_size = 0;
+                uint m_width = 0;
+                uint m_height = 0;
+                uint m_frameIndex = 0;
+            };
+
+            TextureReadback( const TextureReadback& ) = delete;
+            void operator=( const TextureReadback& ) = delete;
+
+        private:
+            std::array<PixelBuffer, 2> m_buffers;
+            /// Buffer of the next readback. The other one holds the oldest pending readback, if any.
+            uint m_next;
+        };
+
+    } // namespace Engine
+} // namespace Ra
+
+#endif // RADIUMENGINE_TEXTUREREADBACK_HPP
@@ -1,6 +1,9 @@
 #include <Engine/System/System.hpp>
 
+#include <algorithm>
+
 #include <Core/String/StringUtils.hpp>
+#include <Core/Tasks/Task.hpp>
 #include <Engine/Component/Component.hpp>
 #include <Engine/Entity/Entity.hpp>
 
@@ -18,20 +21,21 @@ namespace Ra
 
         void System::registerComponent( const Entity* ent,  Component* component )
         {
+            auto& entityComponents = m_entityComponents[ent];
+
             // Perform checks on debug
 #if defined(DEBUG)
             CORE_ASSERT( component->getEntity() == ent, "Component does not belong to entity" );
-            for (const auto& pair : m_components)
+            CORE_ASSERT( component->getSystem() != this, "Component already registered" );
+            for (const auto& other : entityComponents)
             {
-                CORE_ASSERT(pair.second != component, "Component already registered");
-                if (pair.first == ent)
-                {
-                    CORE_ASSERT(pair.second->getName() != component->getName(),
-                        "A component with the same name is already associated with this entity");
-                }
+                CORE_ASSERT(other->getName() != component->getName(),
+                    "A component with the same name is already associated with this entity");
             }
 #endif // DEBUG
+            component->m_systemPosition = uint( m_components.size() );
             m_components.push_back({ ent, component });
+            entityComponents.push_back( component );
             component->setSystem( this );
 
         }
@@ -39,38 +43,89 @@ namespace Ra
         void System::unregisterComponent( const Entity* ent, Component* component )
         {
             CORE_ASSERT( component->getEntity() == ent, "Component does not belong to entity" );
-            const auto& pos =
-                std::find_if(m_components.begin(), m_components.end(),
-                [component](const auto& pair) { return pair.second == component; });
+            const uint pos = component->m_systemPosition;
 
-            CORE_ASSERT( pos != m_components.end(), "Component is not registered." );
-            CORE_ASSERT( pos->first == ent, "Component belongs to a different entity" );
+            CORE_ASSERT( pos < m_components.size() && m_components[pos].second == component,
+                         "Component is not registered." );
+            CORE_ASSERT( m_components[pos].first == ent, "Component belongs to a different entity" );
             component->setSystem(nullptr);
-            m_components.erase( pos );
+
+            auto entityComponents = m_entityComponents.find( ent );
+            CORE_ASSERT( entityComponents != m_entityComponents.end(), "Entity has no component." );
+            auto& list = entityComponents->second;
+            list.erase( std::find( list.begin(), list.end(), component ) );
+            if ( list.empty() )
+            {
+                m_entityComponents.erase( entityComponents );
+            }
+
+            removeComponentAt( pos );
         }
 
 
         void System::unregisterAllComponents( const Entity* entity )
         {
-            std::vector<std::pair<const Entity*, Component*>>::iterator pos;
-            while ( (pos = std::find_if( m_components.begin(), m_components.end(),
-                [entity]( const auto& pair ) {return pair.first == entity; } )) != m_components.end())
+            auto entityComponents = m_entityComponents.find( entity );
+            if ( entityComponents == m_entityComponents.end() )
             {
-                m_components.erase( pos );
+                return;
             }
+            for ( Component* component : entityComponents->second )
+            {
+                component->setSystem( nullptr );
+                removeComponentAt( component->m_systemPosition );
+            }
+            m_entityComponents.erase( entityComponents );
         }
 
-        std::vector< Component* > System::getEntityComponents( const Entity* entity )
+        std::vector< Component* > System::getEntityComponents( const Entity* entity ) const
         {
-            std::vector< Component* > comps;
-            for (const auto& ec : m_components)
+            auto entityComponents = m_entityComponents.find( entity );
+            if ( entityComponents == m_entityComponents.end() )
             {
-                if (ec.first == entity)
+                return std::vector< Component* >();
+            }
+            return entityComponents->second;
+        }
+
+        std::vector<Core::TaskQueue::TaskId> System::registerChunkedTasks( Core::TaskQueue* taskQueue,
+                                                                           const std::string& name,
+                                                                           const std::function<void( Component* )>& func,
+                                                                           uint chunkSize )
+        {
+            CORE_ASSERT( chunkSize > 0, "Chunks cannot be empty." );
+            std::vector<Core::TaskQueue::TaskId> tasks;
+            for ( uint begin = 0; begin < m_components.size(); begin += chunkSize )
+            {
+                const uint end = std::min( begin + chunkSize, uint( m_components.size() ) );
+
+                // Tasks get their own list, components may be registered while they run.
+                std::vector<Component*> chunk( end - begin );
+                for ( uint i = begin; i < end; ++i )
                 {
-                    comps.push_back( ec.second );
+                    chunk[i - begin] = m_components[i].second;
                 }
+                tasks.push_back( taskQueue->registerTask( new Core::FunctionTask(
+                    [chunk, func]()
+                    {
+                        for ( Component* component : chunk )
+                        {
+                            func( component );
+                        }
+                    }, name ) ) );
+            }
+            return tasks;
+        }
+
+        void System::removeComponentAt( uint position )
+        {
+            const uint last = uint( m_components.size() ) - 1;
+            if ( position != last )
+            {
+                m_components[position] = m_components[last];
+                m_components[position].second->m_systemPosition = position;
             }
-            return comps;
+            m_components.pop_back();
         }
     }
 } // namespace Ra
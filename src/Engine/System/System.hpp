@@ -3,21 +3,18 @@
 
 #include <Engine/RaEngine.hpp>
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include <Core/Event/KeyEvent.hpp>
 #include <Core/Event/MouseEvent.hpp>
 
-#include <Engine/Component/Component.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
 
-namespace Ra
-{
-    namespace Core
-    {
-        class TaskQueue;
-    }
-}
+#include <Engine/Component/Component.hpp>
 
 namespace Ra
 {
@@ -44,6 +41,14 @@ namespace Ra
         /// list of "active" components associated to an entity.
         /// At each frame, each system loaded into the engine will be queried for tasks.
         /// The goal of the tasks is to update the active components during the frame.
+        /// Registration and removal of components take constant time : each component knows its
+        /// position in m_components, and removal moves the last component in its place.
+        /// Hence the order of m_components is only stable while no component is removed, and
+        /// systems must not rely on it across frames : the chunks of registerChunkedTasks() match
+        /// between calls of the same generateTasks(), and getEntityComponents() keeps the
+        /// registration order for the systems needing the first component of an entity
+        /// (e.g. AnimationSystem::getTime()). No system of the engine or of the plugins
+        /// depends on the order of m_components otherwise.
         class RA_ENGINE_API System
         {
         public:
@@ -70,8 +75,11 @@ namespace Ra
             /// Removes all components belonging to a given entity.
             void unregisterAllComponents( const Entity* entity );
 
-            /// Returns the components stored for the given entity.
-            std::vector< Component* > getEntityComponents( const Entity* entity );
+            /// Returns the components stored for the given entity, in registration order.
+            std::vector< Component* > getEntityComponents( const Entity* entity ) const;
+
+            /// Returns the number of registered components.
+            inline uint getComponentCount() const { return uint( m_components.size() ); }
 
             /**
              * Factory method for component creation from file data.
@@ -80,9 +88,29 @@ namespace Ra
              */
             virtual void handleAssetLoading( Entity* entity, const Asset::FileData* data) {}
 
+        protected:
+            /// Registers tasks calling func on each active component, one task per chunk of
+            /// chunkSize consecutive components rather than one per component, so that cheap
+            /// updates of many components are not dominated by the scheduling of the tasks.
+            /// Tasks are named name, and their ids are returned in the order of the chunks : the
+            /// same chunkSize gives the same chunks, so that tasks of two calls can depend
+            /// on each other chunk by chunk.
+            std::vector<Core::TaskQueue::TaskId> registerChunkedTasks( Core::TaskQueue* taskQueue,
+                                                                       const std::string& name,
+                                                                       const std::function<void( Component* )>& func,
+                                                                       uint chunkSize );
+
+        private:
+            /// Remove the component at a position of m_components.
+            void removeComponentAt( uint position );
+
         protected:
             /// List of active components.
             std::vector< std::pair<const Entity*, Component*> > m_components;
+
+        private:
+            /// Active components of each entity.
+            std::unordered_map< const Entity*, std::vector<Component*> > m_entityComponents;
         };
 
     } // namespace Engine
@@ -4,6 +4,8 @@
 
 #include <Core/CoreMacros.hpp>
 #include <Core/Log/Log.hpp>
+#include <Core/Log/AsyncLog.hpp>
+#include <Core/Image/FrameRecorder.hpp>
 #include <Core/String/StringUtils.hpp>
 #include <Core/Mesh/MeshUtils.hpp>
 #include <Core/Math/LinearAlgebra.hpp>
@@ -23,6 +25,7 @@
 #include <Engine/Renderer/RenderObject/RenderObject.hpp>
 #include <Engine/Renderer/Mesh/Mesh.hpp>
 #include <Engine/Renderer/RenderTechnique/ShaderConfigFactory.hpp>
+#include <Engine/Renderer/Texture/TextureManager.hpp>
 #include <PluginBase/RadiumPluginInterface.hpp>
 #include <GuiBase/Utils/KeyMappingManager.hpp>
 
@@ -35,11 +38,13 @@
 
 #include <QTimer>
 #include <QDir>
+#include <QStandardPaths>
 #include <QPluginLoader>
 #include <QCommandLineParser>
 #include <QOpenGLContext>
 
 #include <algorithm>
+#include <thread>
 
 
 // Const parameters : TODO : make config / command line options
@@ -61,8 +66,12 @@ namespace GuiBase
         , m_maxThreads( RA_MAX_THREAD )
         , m_realFrameRate( false )
         , m_recordFrames( false )
+        , m_rawRecordCapacity( 0 )
+        , m_recordingCounter( 0 )
+        , m_frameRecorder( new Core::FrameRecorder )
         , m_recordTimings( false )
         , m_recordGraph( false )
+        , m_pipelinedFrames( false )
         , m_isAboutToQuit( false )
     {
         // Set application and organization names in order to ensure uniform
@@ -86,14 +95,21 @@ namespace GuiBase
         QCommandLineOption pluginLoadOpt(QStringList{"l", "load", "loadPlugin"}, "Only load plugin with the given name (filename without the extension). If this option is not used, all plugins in the plugins folder will be loaded. ", "name");
         QCommandLineOption pluginIgnoreOpt(QStringList{"i", "ignore", "ignorePlugin"}, "Ignore plugins with the given name. If the name appears within both load and ignore options, it will be ignored.", "name");
         QCommandLineOption fileOpt(QStringList{"f", "file", "scene"}, "Open a scene file at startup.", "file name", "foo.bar");
+        QCommandLineOption pipelinedOpt(QStringList{"pipelined"}, "Render each frame while the tasks of the next frame are running.");
+        QCommandLineOption asyncLogOpt(QStringList{"asynclog", "async-log"}, "Write log messages from a background thread, so that the tasks do not wait for the console. Messages pending when the program crashes are lost.");
+        QCommandLineOption recordRawOpt(QStringList{"recordraw", "record-raw"}, "Record frames in a single raw file preallocated for the given number of frames, instead of PNG files.", "number", "0");
 
-        parser.addOptions({fpsOpt, pluginOpt, pluginLoadOpt, pluginIgnoreOpt, fileOpt, maxThreadsOpt, numFramesOpt });
+        parser.addOptions({fpsOpt, pluginOpt, pluginLoadOpt, pluginIgnoreOpt, fileOpt, maxThreadsOpt, numFramesOpt, pipelinedOpt, asyncLogOpt, recordRawOpt });
         parser.process(*this);
 
         if (parser.isSet(fpsOpt))       m_targetFPS = parser.value(fpsOpt).toUInt();
         if (parser.isSet(pluginOpt))    pluginsPath = parser.value(pluginOpt).toStdString();
         if (parser.isSet(numFramesOpt)) m_numFrames = parser.value(numFramesOpt).toUInt();
         if (parser.isSet(maxThreadsOpt)) m_maxThreads = parser.value(maxThreadsOpt).toUInt();
+        if (parser.isSet(pipelinedOpt)) m_pipelinedFrames = true;
+        if (parser.isSet(recordRawOpt)) m_rawRecordCapacity = std::max(parser.value(recordRawOpt).toUInt(), 1u);
+
+        if (parser.isSet(asyncLogOpt)) Core::AsyncLog::start();
 
 
         std::time_t startTime = std::time(nullptr);
@@ -192,6 +208,13 @@ namespace GuiBase
         createConnections();
         processEvents();
 
+        // Decoded textures are cached between runs.
+        const QString textureCache = QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + "/textures";
+        if ( QDir().mkpath( textureCache ) )
+        {
+            Engine::TextureManager::getInstance()->setCacheDirectory( textureCache.toStdString() );
+        }
+
         Ra::Engine::RadiumEngine::getInstance()->getEntityManager()->createEntity("Test");
         // Load plugins
         if ( !loadPlugins( pluginsPath, parser.values(pluginLoadOpt), parser.values(pluginIgnoreOpt) ) )
@@ -347,7 +370,20 @@ namespace GuiBase
 
         // ----------
         // 2. Kickoff rendering
-        m_viewer->startRendering( dt );
+        // In pipelined mode, the renderer first takes a snapshot of the frame simulated by the
+        // last tasks (render objects, mesh uploads, model matrices, material parameters, lights
+        // and debug geometry), then draws it while the tasks simulate the next frame. Entities
+        // transforms written by the tasks are double buffered until endFrameSync(), so the
+        // snapshot stays consistent.
+        timerData.pipelined = m_pipelinedFrames;
+        if ( m_pipelinedFrames )
+        {
+            m_viewer->prepareRendering( dt );
+        }
+        else
+        {
+            m_viewer->startRendering( dt );
+        }
 
         timerData.tasksStart = Core::Timer::Clock::now();
 
@@ -359,6 +395,10 @@ namespace GuiBase
 
         // Run one frame of tasks
         m_taskQueue->startTasks();
+        if ( m_pipelinedFrames )
+        {
+            m_viewer->startRendering( dt );
+        }
         m_taskQueue->waitForTasks();
         timerData.taskData = m_taskQueue->getTimerData();
         m_taskQueue->flushTaskQueue();
@@ -432,20 +472,65 @@ namespace GuiBase
        m_realFrameRate = on;
     }
 
+    void BaseApplication::setPipelinedFrames(bool on)
+    {
+        m_pipelinedFrames = on;
+    }
+
     void BaseApplication::setRecordFrames(bool on)
     {
         m_recordFrames = on;
+        if (!on)
+        {
+            stopRecording();
+        }
     }
 
     void BaseApplication::recordFrame()
     {
-        std::string filename;
-        Ra::Core::StringUtils::stringPrintf(filename, "%s/radiumframe_%06u.png", m_exportFoldername.c_str(), m_frameCounter);
-        m_viewer->grabFrame(filename);
+        if (!m_frameRecorder->isRunning())
+        {
+            Core::FrameRecorder::Parameters params;
+            params.m_path = m_exportFoldername;
+            params.m_workerCount = std::max(std::thread::hardware_concurrency() / 2, 1u);
+            if (m_rawRecordCapacity > 0)
+            {
+                params.m_format = Core::FrameRecorder::RAW;
+                Ra::Core::StringUtils::stringPrintf(params.m_path, "%s/radiumframes_%03u.raw",
+                                                    m_exportFoldername.c_str(), m_recordingCounter++);
+                params.m_rawFrameCapacity = m_rawRecordCapacity;
+            }
+            if (!m_frameRecorder->start(params))
+            {
+                m_recordFrames = false;
+                return;
+            }
+        }
+
+        // Frames are read back asynchronously, then flipped and encoded by the recorder threads.
+        m_viewer->captureFrame(*m_frameRecorder, m_frameCounter);
+    }
+
+    void BaseApplication::stopRecording()
+    {
+        if (!m_frameRecorder->isRunning())
+        {
+            return;
+        }
+
+        m_viewer->finishCapture(*m_frameRecorder);
+        m_frameRecorder->stop();
+
+        const auto stats = m_frameRecorder->getStatistics();
+        LOG( logINFO ) << "Recorded " << stats.m_written << " frames (" << stats.m_dropped << " dropped) at "
+                       << stats.getThroughput() << " frames/s, "
+                       << 1000 * stats.m_submitSeconds / std::max(stats.m_submitted, 1u) << " ms per frame on the main thread, "
+                       << 1000 * stats.m_encodeSeconds / std::max(stats.m_written, 1u) << " ms per frame on the encoding threads.";
     }
 
     BaseApplication::~BaseApplication()
     {
+        stopRecording();
         emit stopping();
         m_mainWindow->cleanup();
         m_engine->cleanup();
@@ -453,6 +538,8 @@ namespace GuiBase
         // This will remove the directory if empty.
         QDir().rmdir( m_exportFoldername.c_str());
 
+        // Write the pending messages of the asynchronous log, the remaining ones are written synchronously.
+        Core::AsyncLog::stop();
     }
 
     bool BaseApplication::loadPlugins( const std::string& pluginsPath, const QStringList& loadList, const QStringList& ignoreList )
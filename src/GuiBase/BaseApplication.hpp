@@ -16,6 +16,7 @@ namespace Ra
     namespace Core
     {
         class TaskQueue;
+        class FrameRecorder;
     }
 }
 
@@ -106,9 +107,13 @@ namespace GuiBase{
         void setRecordFrames( bool on );
         void setRecordTimings( bool on );
         void setRecordGraph( bool on );
+        void setPipelinedFrames( bool on );
 
         void recordFrame();
 
+        /// Write the frames being recorded and report the capture throughput.
+        void stopRecording();
+
         void onSelectedItem(const Ra::Engine::ItemEntry& entry) { emit selectedItem(entry); }
 
     protected:
@@ -166,11 +171,20 @@ namespace GuiBase{
 
         /// If true, dump each frame to a PNG file.
         bool m_recordFrames;
+        /// If not 0, dump the frames to a single raw file sized for this number of frames instead.
+        uint m_rawRecordCapacity;
+        /// Number of recordings started, each one goes to its own raw file.
+        uint m_recordingCounter;
+        /// Encodes the recorded frames in the background.
+        std::unique_ptr<Core::FrameRecorder> m_frameRecorder;
         /// If true, print the detailed timings of each frame
         bool m_recordTimings;
         /// If true, print the task graph;
         bool m_recordGraph;
 
+        /// If true, render the snapshot of the last frame while the tasks of the next frame run.
+        bool m_pipelinedFrames;
+
         bool m_isAboutToQuit;
     };
 }
@@ -1,7 +1,16 @@
 #include <GuiBase/TimerData/FrameTimerData.hpp>
 
+#include <algorithm>
+
 namespace Ra
 {
+    long FrameTimerData::getOverlapMicro() const
+    {
+        const Core::Timer::TimePoint& start = std::max(tasksStart, renderData.renderStart);
+        const Core::Timer::TimePoint& end = std::min(tasksEnd, renderData.renderEnd);
+        return start < end ? Ra::Core::Timer::getIntervalMicro(start, end) : 0;
+    }
+
     void FrameTimerData::print(std::ostream& ostream) const
     {
 
@@ -30,6 +39,7 @@ namespace Ra
             }
             ostream << "\t}" << "\n";
             ostream << "\trender: " << reStart << " " << reEnd << " " << reEnd - reStart << "\n";
+            ostream << "\toverlap" << (pipelined ? " (pipelined): " : ": ") << getOverlapMicro() << "\n";
         }
         ostream<<"}"<<"\n";
         ostream<<std::endl;
@@ -26,6 +26,11 @@ namespace Ra
         Core::Timer::TimePoint frameEnd;
         Engine::Renderer::TimerData renderData;
         std::vector<Core::TaskQueue::TimerData> taskData;
+        /// True if the frame was rendered while the tasks of the next frame were running.
+        bool pipelined = false;
+
+        /// Time during which the renderer and the tasks were running simultaneously.
+        long getOverlapMicro() const;
 
         void print(std::ostream& ostream) const;
     };
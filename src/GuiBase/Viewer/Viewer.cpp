@@ -24,11 +24,13 @@
 #include <Core/Math/Math.hpp>
 #include <Core/Containers/MakeShared.hpp>
 #include <Core/Image/stb_image_write.h>
+#include <Core/Image/FrameRecorder.hpp>
 
 #include <Engine/Component/Component.hpp>
 #include <Engine/Renderer/Renderer.hpp>
 #include <Engine/Renderer/Light/DirLight.hpp>
 #include <Engine/Renderer/Camera/Camera.hpp>
+#include <Engine/Renderer/Texture/TextureReadback.hpp>
 
 #include <Engine/Managers/SystemDisplay/SystemDisplay.hpp>
 #include <Engine/Managers/EntityManager/EntityManager.hpp>
@@ -53,6 +55,7 @@ namespace Ra
         , m_brushRadius( 10 )
         , m_camera( nullptr )
         , m_gizmoManager( nullptr )
+        , m_frameReadback( nullptr )
         , m_renderThread( nullptr )
         , m_glInitStatus( false )
     {
@@ -69,6 +72,11 @@ namespace Ra
             m_context->makeCurrent( this );
             m_renderers.clear();
 
+            if (m_frameReadback != nullptr)
+            {
+                m_frameReadback->releaseGL();
+            }
+
             if (m_gizmoManager != nullptr)
             {
                 delete m_gizmoManager;
@@ -513,6 +521,24 @@ namespace Ra
 
     // Asynchronous rendering implementation
 
+    void Gui::Viewer::prepareRendering( const Scalar dt )
+    {
+        CORE_ASSERT(m_glInitStatus.load(),
+                    "OpenGL needs to be initialized before rendering.");
+
+        CORE_ASSERT(m_currentRenderer != nullptr,
+                    "No renderer found.");
+
+        m_context->makeCurrent(this);
+
+        Engine::RenderData data;
+        data.dt = dt;
+        data.projMatrix = m_camera->getProjMatrix();
+        data.viewMatrix = m_camera->getViewMatrix();
+
+        m_currentRenderer->prepareFrame( data );
+    }
+
     void Gui::Viewer::startRendering( const Scalar dt )
     {
         CORE_ASSERT(m_glInitStatus.load(),
@@ -650,6 +676,43 @@ namespace Ra
 
     }
 
+    void Gui::Viewer::captureFrame( Core::FrameRecorder& recorder, uint frameIndex )
+    {
+        m_context->makeCurrent(this);
+
+        if (m_frameReadback == nullptr)
+        {
+            m_frameReadback.reset(new Engine::TextureReadback);
+        }
+
+        auto submit = [&recorder](const uint8_t* pixels, uint w, uint h, uint index)
+        {
+            recorder.submit(pixels, w, h, index);
+        };
+
+        // The readback of the previous frame is usually done by now : hand it to the recorder
+        // without waiting, then queue the copy of this frame.
+        m_frameReadback->process(submit, false);
+        m_frameReadback->start(m_currentRenderer->getDisplayTexture(), frameIndex, submit);
+
+        m_context->doneCurrent();
+    }
+
+    void Gui::Viewer::finishCapture( Core::FrameRecorder& recorder )
+    {
+        if (m_frameReadback == nullptr)
+        {
+            return;
+        }
+
+        m_context->makeCurrent(this);
+        m_frameReadback->finish([&recorder](const uint8_t* pixels, uint w, uint h, uint index)
+        {
+            recorder.submit(pixels, w, h, index);
+        });
+        m_context->doneCurrent();
+    }
+
     void Gui::Viewer::enablePostProcess(int enabled)
     {
         m_currentRenderer->enablePostProcess(enabled);
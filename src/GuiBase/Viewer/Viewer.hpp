@@ -26,6 +26,12 @@ namespace Ra
     {
         struct KeyEvent;
         struct MouseEvent;
+        class FrameRecorder;
+    }
+
+    namespace Engine
+    {
+        class TextureReadback;
     }
 }
 
@@ -108,6 +114,10 @@ namespace Ra
             // Rendering management
             //
 
+            /// Snapshot the scene for the next startRendering() call (see Renderer::prepareFrame()).
+            /// Afterwards, the engine tasks can update the scene while the snapshot is rendered.
+            void prepareRendering( const Scalar dt );
+
             /// Start rendering (potentially asynchronously in a separate thread)
             void startRendering( const Scalar dt );
 
@@ -136,6 +146,13 @@ namespace Ra
             /// Write the current frame as an image. Supports either BMP or PNG file names.
             void grabFrame( const std::string& filename );
 
+            /// Start the asynchronous readback of the current frame, and give the frames whose
+            /// readback is finished to recorder, which encodes them on its own threads.
+            void captureFrame( Core::FrameRecorder& recorder, uint frameIndex );
+
+            /// Give all the pending readbacks to recorder.
+            void finishCapture( Core::FrameRecorder& recorder );
+
             void enableDebug();
 
         signals:
@@ -245,6 +262,9 @@ namespace Ra
             /// Owning (QObject child) pointer to gizmo manager.
             GizmoManager* m_gizmoManager;
 
+            /// Asynchronous readback of the captured frames.
+            std::unique_ptr<Engine::TextureReadback> m_frameReadback;
+
             /// Thread in which rendering is done.
             QThread* m_renderThread; // We have to use a QThread for MT rendering
 
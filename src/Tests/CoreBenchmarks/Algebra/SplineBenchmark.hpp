@@ -0,0 +1,63 @@
+#ifndef RADIUM_SPLINE_BENCHMARK_HPP_
+#define RADIUM_SPLINE_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Math/Spline.hpp>
+
+#include <random>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    class SplineBenchmark : public Benchmark
+    {
+        typedef Ra::Core::Spline<3, 4> Spline;
+        typedef Spline::Vector Vector;
+
+        void run() override
+        {
+            std::mt19937 gen( 1 );
+            std::uniform_real_distribution<Scalar> dist( -1, 1 );
+            Ra::Core::VectorArray<Vector> ctrlPoints( 100 );
+            for ( auto& p : ctrlPoints )
+            {
+                p = Vector( dist( gen ), dist( gen ), dist( gen ) );
+            }
+            Spline spline;
+            spline.setCtrlPoints( ctrlPoints );
+
+            const uint n = 1 << 20;
+            std::vector<Scalar> us( n );
+            for ( uint i = 0; i < n; ++i )
+            {
+                us[i] = Scalar( i ) / Scalar( n - 1 );
+            }
+
+            Ra::Core::VectorArray<Vector> points( n ), speeds( n );
+            double time = timeIt( "Cubic spline f + df, blossom recursion, 1M samples", 3, [&]() {
+                for ( uint i = 0; i < n; ++i )
+                {
+                    points[i] = spline.fRecursive( us[i] );
+                    speeds[i] = spline.dfRecursive( us[i] );
+                }
+            } );
+            report( "  throughput", n / time, "Msamples/s" );
+            time = timeIt( "Cubic spline f + df, de Boor, 1M samples", 3, [&]() {
+                for ( uint i = 0; i < n; ++i )
+                {
+                    points[i] = spline.f( us[i] );
+                    speeds[i] = spline.df( us[i] );
+                }
+            } );
+            report( "  throughput", n / time, "Msamples/s" );
+            time = timeIt( "Cubic spline f + df, batched evaluate, 1M samples", 3, [&]() {
+                spline.evaluate( us, points, &speeds );
+            } );
+            report( "  throughput", n / time, "Msamples/s" );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( SplineBenchmark );
+}
+
+#endif // RADIUM_SPLINE_BENCHMARK_HPP_
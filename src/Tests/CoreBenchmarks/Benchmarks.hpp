@@ -0,0 +1,56 @@
+#ifndef RADIUM_BENCHMARKS_HPP_
+#define RADIUM_BENCHMARKS_HPP_
+#include <Core/CoreMacros.hpp>
+#include <Core/Time/Timer.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace RaBenchmarks {
+/// Base class for all benchmarks.
+/// Benchmarks register themselves when instantiated and are run in order by main().
+class Benchmark
+{
+public:
+    Benchmark()
+    {
+        getBenchmarks().push_back(this);
+    }
+    virtual void run() = 0;
+
+    virtual ~Benchmark() {};
+
+    static std::vector<Benchmark*>& getBenchmarks()
+    {
+        static std::vector<Benchmark*> benchmarks;
+        return benchmarks;
+    }
+};
+
+// Poor man's singleton to automatically instantiate a benchmark.
+#define RA_BENCHMARK_CLASS( TYPE ) namespace TYPE##NS { TYPE benchmark_instance;}
+
+/// Call func() iterations times and print the average time of a call.
+/// Returns the average time in microseconds.
+template <typename Func>
+inline double timeIt( const char* name, uint iterations, Func func )
+{
+    auto start = Ra::Core::Timer::Clock::now();
+    for (uint i = 0; i < iterations; ++i)
+    {
+        func();
+    }
+    auto end = Ra::Core::Timer::Clock::now();
+    double average = double(Ra::Core::Timer::getIntervalMicro(start, end)) / double(iterations);
+    fprintf(stdout, "[BENCHMARK] %-60s : %12.2f us\n", name, average);
+    return average;
+}
+
+/// Print a named value measured by a benchmark (counts, ratios, throughputs...).
+inline void report( const char* name, double value, const char* unit )
+{
+    fprintf(stdout, "[BENCHMARK] %-60s : %12.2f %s\n", name, value, unit);
+}
+
+}
+#endif // RADIUM_BENCHMARKS_HPP_
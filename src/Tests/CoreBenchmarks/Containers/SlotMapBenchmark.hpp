@@ -0,0 +1,75 @@
+#ifndef RADIUM_SLOTMAP_BENCHMARK_HPP_
+#define RADIUM_SLOTMAP_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Index/IndexMap.hpp>
+#include <Core/Index/SlotMap.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    class SlotMapBenchmark : public Benchmark
+    {
+        typedef Ra::Core::Index Index;
+        typedef std::shared_ptr<int> Object; // Like the render objects.
+
+        // Fill a map with count objects, then time lookups of random indices and the
+        // removal of a part of the objects.
+        template <typename Map>
+        void measure( const std::string& name, uint count, uint lookups, uint removals )
+        {
+            Map map;
+            std::vector<Index> indices( count );
+            timeIt( ( name + ", insert " + std::to_string( count ) ).c_str(), 1, [&]() {
+                for ( uint i = 0; i < count; ++i )
+                {
+                    indices[i] = map.insert( std::make_shared<int>( int( i ) ) );
+                }
+            } );
+
+            std::mt19937 gen( 5 );
+            std::vector<Index> queries( lookups );
+            for ( auto& q : queries )
+            {
+                q = indices[gen() % count];
+            }
+            long sum = 0;
+            const double lookupTime = timeIt( ( name + ", contains + at" ).c_str(), 1, [&]() {
+                for ( const Index& q : queries )
+                {
+                    if ( map.contains( q ) )
+                    {
+                        sum += *map.at( q );
+                    }
+                }
+            } );
+            report( "  per lookup", 1000 * lookupTime / lookups, "ns" );
+
+            std::shuffle( indices.begin(), indices.end(), gen );
+            const double removeTime = timeIt( ( name + ", remove" ).c_str(), 1, [&]() {
+                for ( uint i = 0; i < removals; ++i )
+                {
+                    map.remove( indices[i] );
+                }
+            } );
+            report( "  per removal", 1000 * removeTime / removals, "ns" );
+            report( "  checksum", double( sum % 1000 ), "" );
+        }
+
+        void run() override
+        {
+            const uint count = 100000;
+            measure<Ra::Core::IndexMap<Object>>( "IndexMap (previous)", count, 10000, 1000 );
+            measure<Ra::Core::SlotMap<Object>>( "SlotMap", count, count, count / 2 );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( SlotMapBenchmark );
+}
+
+#endif // RADIUM_SLOTMAP_BENCHMARK_HPP_
@@ -0,0 +1,92 @@
+#ifndef RADIUM_DISTANCE_BENCHMARK_HPP_
+#define RADIUM_DISTANCE_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Geometry/Distance/DistanceQueries.hpp>
+#include <Core/Geometry/Distance/VertexDistance.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <random>
+
+namespace RaBenchmarks
+{
+    class DistanceBenchmark : public Benchmark
+    {
+        typedef Ra::Core::Vector3 Vector3;
+        typedef Ra::Core::Vector3Array Vector3Array;
+
+        void run() override
+        {
+            const uint n = 1 << 22;
+            std::mt19937 gen( 1 );
+            std::uniform_real_distribution<Scalar> dist( -2, 2 );
+            Vector3Array q( n ), q2( n );
+            for ( uint i = 0; i < n; ++i )
+            {
+                q[i] = Vector3( dist( gen ), dist( gen ), dist( gen ) );
+                q2[i] = Vector3( dist( gen ), dist( gen ), dist( gen ) );
+            }
+            const Vector3 a( 0, 0, 0 );
+            const Vector3 b( 1, 0.2, 0 );
+            const Vector3 c( 0.3, 1, 0.5 );
+
+            std::vector<Scalar> distanceSquared( n );
+            Vector3Array meshPoints( n );
+            double us = timeIt( "pointToTriSq, scalar loop, 4M points", 3, [&]() {
+                for ( uint i = 0; i < n; ++i )
+                {
+                    const auto out = Ra::Core::DistanceQueries::pointToTriSq( q[i], a, b, c );
+                    distanceSquared[i] = out.distanceSquared;
+                    meshPoints[i] = out.meshPoint;
+                }
+            } );
+            report( "  throughput", n / us, "Mpoints/s" );
+            us = timeIt( "pointsToTriSq, batched, 4M points", 3, [&]() {
+                Ra::Core::DistanceQueries::pointsToTriSq( q, a, b, c, distanceSquared, &meshPoints );
+            } );
+            report( "  throughput", n / us, "Mpoints/s" );
+
+            // Point-triangle pairs on a mesh, as when projecting points on their closest triangle.
+            const Ra::Core::TriangleMesh mesh = Ra::Core::MeshUtils::makeGeodesicSphere( 1, 5 );
+            std::vector<Ra::Core::TriangleIdx> triangles( n );
+            for ( uint i = 0; i < n; ++i )
+            {
+                triangles[i] = gen() % mesh.m_triangles.size();
+            }
+            us = timeIt( "pointToTriSq, scalar loop, 4M point-triangle pairs", 3, [&]() {
+                for ( uint i = 0; i < n; ++i )
+                {
+                    const Ra::Core::Triangle& t = mesh.m_triangles[triangles[i]];
+                    distanceSquared[i] = Ra::Core::DistanceQueries::pointToTriSq(
+                        q[i], mesh.m_vertices[t[0]], mesh.m_vertices[t[1]], mesh.m_vertices[t[2]] ).distanceSquared;
+                }
+            } );
+            report( "  throughput", n / us, "Mpoints/s" );
+            us = timeIt( "pointsToTriSq, batched, 4M point-triangle pairs", 3, [&]() {
+                Ra::Core::DistanceQueries::pointsToTriSq( q, mesh, triangles, distanceSquared );
+            } );
+            report( "  throughput", n / us, "Mpoints/s" );
+
+            Scalar sqrMin, sqrMax, sqrAvg;
+            us = timeIt( "vertexDistance, scalar loop (previous), 4M vertices", 3, [&]() {
+                sqrMin = std::numeric_limits<Scalar>::max();
+                sqrMax = 0;
+                for ( uint i = 0; i < n; ++i )
+                {
+                    distanceSquared[i] = ( q[i] - q2[i] ).squaredNorm();
+                    sqrMax = ( distanceSquared[i] > sqrMax ) ? distanceSquared[i] : sqrMax;
+                    sqrMin = ( distanceSquared[i] < sqrMin ) ? distanceSquared[i] : sqrMin;
+                }
+            } );
+            report( "  throughput", n / us, "Mpoints/s" );
+            us = timeIt( "vertexDistance, batched, 4M vertices", 3, [&]() {
+                Ra::Core::Geometry::vertexDistance( q, q2, distanceSquared, sqrMin, sqrMax, sqrAvg );
+            } );
+            report( "  throughput", n / us, "Mpoints/s" );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( DistanceBenchmark );
+}
+
+#endif // RADIUM_DISTANCE_BENCHMARK_HPP_
@@ -0,0 +1,86 @@
+#ifndef RADIUM_PARTITION_BENCHMARK_HPP_
+#define RADIUM_PARTITION_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Geometry/Partition/Partition.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    class PartitionBenchmark : public Benchmark
+    {
+        typedef Ra::Core::TriangleMesh TriangleMesh;
+        typedef Ra::Core::Animation::WeightMatrix WeightMatrix;
+
+        // Previous implementation : one pass over the weight column and the triangles per handle.
+        static Ra::Core::Geometry::MeshPartition partitionPerHandle( const TriangleMesh& mesh,
+                                                                     const WeightMatrix& weight )
+        {
+            using namespace Ra::Core::Geometry;
+            const uint size = weight.cols();
+            const uint v_size = mesh.m_vertices.size();
+            MeshPartition part( size );
+            #pragma omp parallel for
+            for ( int n = 0; n < int( size ); ++n )
+            {
+                const VertexSegment v = extractVertexSegment( weight, n, false );
+                const BitSet b = extractBitSet( v, v_size );
+                const TriangleSegment t = extractTriangleSegment( b, mesh.m_triangles );
+                part[n].m_vertices.resize( v.size() );
+                part[n].m_normals.resize( v.size() );
+                part[n].m_triangles.resize( t.size() );
+                std::map<uint, uint> id;
+                for ( uint i = 0; i < v.size(); ++i )
+                {
+                    id[v[i]] = i;
+                    part[n].m_vertices[i] = mesh.m_vertices[v[i]];
+                    part[n].m_normals[i] = mesh.m_normals[v[i]];
+                }
+                for ( uint i = 0; i < t.size(); ++i )
+                {
+                    const Ra::Core::Triangle& T = mesh.m_triangles[t[i]];
+                    part[n].m_triangles[i] = Ra::Core::Triangle( id[T[0]], id[T[1]], id[T[2]] );
+                }
+            }
+            return part;
+        }
+
+        void run() override
+        {
+            // 500k faces skinned on a 20 x 15 grid of bones, 4 bones per vertex.
+            const uint rows = 500;
+            const TriangleMesh mesh = Ra::Core::MeshUtils::makePlaneGrid( rows, rows );
+            const uint bx = 20;
+            const uint by = 15;
+            std::vector<Eigen::Triplet<Scalar>> triplets;
+            for ( uint i = 0; i < mesh.m_vertices.size(); ++i )
+            {
+                const uint x = std::min( uint( ( mesh.m_vertices[i].x() + 1 ) / 2 * ( bx - 1 ) ), bx - 2 );
+                const uint y = std::min( uint( ( mesh.m_vertices[i].y() + 1 ) / 2 * ( by - 1 ) ), by - 2 );
+                for ( uint k = 0; k < 4; ++k )
+                {
+                    const uint bone = ( y + k / 2 ) * bx + x + k % 2;
+                    triplets.push_back( Eigen::Triplet<Scalar>( i, bone, Scalar( 0.1 ) * ( k + 1 ) ) );
+                }
+            }
+            WeightMatrix weight( mesh.m_vertices.size(), bx * by );
+            weight.setFromTriplets( triplets.begin(), triplets.end() );
+
+            Ra::Core::Geometry::MeshPartition part;
+            timeIt( "partition, per handle (previous), 300 bones, 500k faces", 3,
+                    [&]() { part = partitionPerHandle( mesh, weight ); } );
+            timeIt( "partition, single pass, 300 bones, 500k faces", 3,
+                    [&]() { part = Ra::Core::Geometry::partition( mesh, weight, false ); } );
+            timeIt( "partition, single pass, most influent bone, 300 bones, 500k faces", 3,
+                    [&]() { part = Ra::Core::Geometry::partition( mesh, weight, true ); } );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( PartitionBenchmark );
+}
+
+#endif // RADIUM_PARTITION_BENCHMARK_HPP_
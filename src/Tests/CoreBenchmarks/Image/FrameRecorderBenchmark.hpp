@@ -0,0 +1,108 @@
+#ifndef RADIUM_FRAMERECORDER_BENCHMARK_HPP_
+#define RADIUM_FRAMERECORDER_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Image/FrameRecorder.hpp>
+#include <Core/Image/stb_image_write.h>
+#include <Core/String/StringUtils.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    class FrameRecorderBenchmark : public Benchmark
+    {
+        typedef Ra::Core::FrameRecorder FrameRecorder;
+
+        static const uint s_width = 1920;
+        static const uint s_height = 1080;
+        static const uint s_frameCount = 12;
+
+        static std::string frameName( uint f )
+        {
+            std::string name;
+            Ra::Core::StringUtils::stringPrintf( name, "./FrameRecorderBenchmark_%06u.png", f );
+            return name;
+        }
+
+        // Submit the frames as fast as possible, and report the throughput until they are written.
+        static void record( const char* name, const FrameRecorder::Parameters& params, const std::vector<uint8_t>& pixels )
+        {
+            FrameRecorder recorder;
+            if ( !recorder.start( params ) )
+            {
+                return;
+            }
+            for ( uint f = 0; f < s_frameCount; ++f )
+            {
+                recorder.submit( pixels.data(), s_width, s_height, f );
+            }
+            recorder.stop();
+
+            const FrameRecorder::Statistics stats = recorder.getStatistics();
+            report( name, stats.getThroughput(), "frames/s" );
+            report( "  submit per frame", 1e3 * stats.m_submitSeconds / stats.m_submitted, "ms" );
+            report( "  encode per frame", 1e3 * stats.m_encodeSeconds / std::max( stats.m_written, 1u ), "ms" );
+            report( "  bandwidth", double( stats.m_bytes ) / ( 1e6 * stats.m_elapsedSeconds ), "MB/s" );
+        }
+
+        void run() override
+        {
+            // A smooth image with some noise, compressing like a rendered frame.
+            std::vector<uint8_t> pixels( s_width * s_height * 4 );
+            uint32_t seed = 42;
+            for ( uint j = 0; j < s_height; ++j )
+            {
+                for ( uint i = 0; i < s_width; ++i )
+                {
+                    seed = seed * 1664525u + 1013904223u;
+                    uint8_t* p = &pixels[4 * ( j * s_width + i )];
+                    p[0] = uint8_t( i * 255 / s_width );
+                    p[1] = uint8_t( j * 255 / s_height );
+                    p[2] = uint8_t( ( seed >> 24 ) & 0x0f );
+                    p[3] = 0xff;
+                }
+            }
+
+            // Former behaviour : flip and encode on the rendering thread.
+            std::vector<uint8_t> flipped( pixels.size() );
+            const double sync = timeIt( "Frame capture 1080p PNG, synchronous", s_frameCount, [&]()
+            {
+                static uint f = 0;
+                const size_t row = s_width * 4;
+                for ( uint j = 0; j < s_height; ++j )
+                {
+                    std::memcpy( &flipped[( s_height - 1 - j ) * row], &pixels[j * row], row );
+                }
+                stbi_write_png( frameName( f++ ).c_str(), s_width, s_height, 4, flipped.data(), s_width * 4 );
+            } );
+            report( "  throughput", 1e6 / sync, "frames/s" );
+
+            FrameRecorder::Parameters params;
+            params.m_prefix = "FrameRecorderBenchmark_";
+            params.m_format = FrameRecorder::PNG;
+            params.m_workerCount = std::max( std::thread::hardware_concurrency(), 1u );
+            record( "Frame capture 1080p PNG, asynchronous", params, pixels );
+
+            params.m_format = FrameRecorder::RAW;
+            params.m_path = "FrameRecorderBenchmark.raw";
+            params.m_workerCount = 2;
+            params.m_rawFrameCapacity = s_frameCount;
+            record( "Frame capture 1080p raw, asynchronous", params, pixels );
+
+            for ( uint f = 0; f < s_frameCount; ++f )
+            {
+                std::remove( frameName( f ).c_str() );
+            }
+            std::remove( params.m_path.c_str() );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( FrameRecorderBenchmark );
+}
+
+#endif // RADIUM_FRAMERECORDER_BENCHMARK_HPP_
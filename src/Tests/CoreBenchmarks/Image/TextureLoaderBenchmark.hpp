@@ -0,0 +1,113 @@
+#ifndef RADIUM_TEXTURELOADER_BENCHMARK_HPP_
+#define RADIUM_TEXTURELOADER_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Image/TextureLoader.hpp>
+#include <Core/Image/stb_image.h>
+#include <Core/Image/stb_image_write.h>
+#include <Core/String/StringUtils.hpp>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    class TextureLoaderBenchmark : public Benchmark
+    {
+        typedef Ra::Core::TextureLoader TextureLoader;
+
+        static const uint s_size = 1024;
+        static const uint s_fileCount = 8;
+
+        static std::string fileName( uint f )
+        {
+            std::string name;
+            Ra::Core::StringUtils::stringPrintf( name, "./TextureLoaderBenchmark_%u.png", f );
+            return name;
+        }
+
+        static void load( const char* name, const TextureLoader::Parameters& params )
+        {
+            TextureLoader loader;
+            const double t = timeIt( name, 1, [&]()
+            {
+                loader.start( params );
+                for ( uint f = 0; f < s_fileCount; ++f )
+                {
+                    loader.request( fileName( f ) );
+                }
+                loader.waitLoaded();
+                std::vector<TextureLoader::LoadedImage> loaded;
+                loader.takeLoaded( ~std::size_t( 0 ), loaded );
+                loader.stop();
+            } );
+            const TextureLoader::Statistics stats = loader.getStatistics();
+            report( "  per texture", 1e-3 * t / s_fileCount, "ms" );
+            report( "  decoded", stats.m_decoded, "textures" );
+            report( "  cache hits", stats.m_cacheHits, "textures" );
+            report( "  decode + mipmaps per texture", 1e3 * ( stats.m_decodeSeconds + stats.m_mipmapSeconds ) / s_fileCount, "ms" );
+        }
+
+        void run() override
+        {
+            // Distinct files, so that nothing is deduplicated.
+            std::vector<uint8_t> pixels( s_size * s_size * 4 );
+            uint32_t seed = 42;
+            for ( uint f = 0; f < s_fileCount; ++f )
+            {
+                for ( uint j = 0; j < s_size; ++j )
+                {
+                    for ( uint i = 0; i < s_size; ++i )
+                    {
+                        seed = seed * 1664525u + 1013904223u;
+                        uint8_t* p = &pixels[4 * ( j * s_size + i )];
+                        p[0] = uint8_t( i + f );
+                        p[1] = uint8_t( j );
+                        p[2] = uint8_t( ( seed >> 24 ) & 0x0f );
+                        p[3] = 0xff;
+                    }
+                }
+                stbi_write_png( fileName( f ).c_str(), s_size, s_size, 4, pixels.data(), s_size * 4 );
+            }
+
+            // Former behaviour : decode on the rendering thread, mipmaps built by the driver.
+            const double sync = timeIt( "Texture loading 1024^2, synchronous decode", s_fileCount, [&]()
+            {
+                static uint f = 0;
+                int w, h, n;
+                uint8_t* data = stbi_load( fileName( f++ % s_fileCount ).c_str(), &w, &h, &n, 0 );
+                stbi_image_free( data );
+            } );
+            report( "  per texture", 1e-3 * sync, "ms" );
+
+            TextureLoader::Parameters params;
+            params.m_workerCount = std::max( std::thread::hardware_concurrency(), 1u );
+            load( "Texture loading 1024^2, asynchronous decode and mipmaps", params );
+
+            params.m_cacheDirectory = ".";
+            load( "Texture loading 1024^2, filling the cache", params );
+            load( "Texture loading 1024^2, from the cache", params );
+
+            for ( uint f = 0; f < s_fileCount; ++f )
+            {
+                std::vector<uint8_t> content;
+                FILE* file = fopen( fileName( f ).c_str(), "rb" );
+                int c;
+                while ( ( c = fgetc( file ) ) != EOF )
+                {
+                    content.push_back( uint8_t( c ) );
+                }
+                fclose( file );
+                const uint64_t hash = TextureLoader::hashContent( content.data(), content.size() );
+                std::remove( TextureLoader::getCacheFilename( params.m_cacheDirectory, hash ).c_str() );
+                std::remove( fileName( f ).c_str() );
+            }
+        }
+    };
+
+    RA_BENCHMARK_CLASS( TextureLoaderBenchmark );
+}
+
+#endif // RADIUM_TEXTURELOADER_BENCHMARK_HPP_
@@ -0,0 +1,58 @@
+#ifndef RADIUM_LIGHTCLUSTERGRID_BENCHMARK_HPP_
+#define RADIUM_LIGHTCLUSTERGRID_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Algorithm/LightCulling/LightClusterGrid.hpp>
+
+#include <random>
+#include <string>
+
+namespace RaBenchmarks
+{
+    class LightClusterGridBenchmark : public Benchmark
+    {
+        void run() override
+        {
+            typedef Ra::Core::Algorithm::LightSphere LightSphere;
+
+            const Scalar fovy = Ra::Core::Math::PiDiv2;
+            const Scalar aspect = 16.0 / 9.0;
+            const Scalar zNear = 0.1;
+            const Scalar zFar = 1000.0;
+            const Scalar tanHalfFov = std::tan( fovy / 2 );
+            const Ra::Core::Matrix4 proj = Ra::Core::MatrixUtils::perspective( fovy, aspect, zNear, zFar );
+
+            Ra::Core::Algorithm::LightClusterGrid grid( 16, 9, 24 );
+            timeIt( "LightClusterGrid setProjection 16x9x24", 100, [&]() {
+                grid.setProjection( proj );
+            } );
+
+            std::mt19937 gen( 42 );
+            std::uniform_real_distribution<Scalar> unit( -1, 1 );
+            std::uniform_real_distribution<Scalar> depth( zNear, zFar / 10 );
+            std::uniform_real_distribution<Scalar> radius( 1, 20 );
+
+            for ( uint count : { 16u, 256u, 1024u, 4096u } )
+            {
+                Ra::Core::AlignedStdVector<LightSphere> lights( count );
+                for ( auto& l : lights )
+                {
+                    const Scalar d = depth( gen );
+                    l.m_center = Ra::Core::Vector3( unit( gen ) * d * tanHalfFov * aspect,
+                                                    unit( gen ) * d * tanHalfFov, -d );
+                    l.m_radius = radius( gen );
+                }
+
+                const std::string name = "LightClusterGrid assignLights " + std::to_string( count ) + " lights";
+                timeIt( name.c_str(), 20, [&]() { grid.assignLights( lights ); } );
+                report( "  average lights per cluster",
+                        double( grid.getLightIndices().size() ) / double( grid.getClusterCount() ), "" );
+                report( "  max lights per cluster", grid.getMaxLightCount(), "" );
+            }
+        }
+    };
+
+    RA_BENCHMARK_CLASS( LightClusterGridBenchmark );
+}
+
+#endif // RADIUM_LIGHTCLUSTERGRID_BENCHMARK_HPP_
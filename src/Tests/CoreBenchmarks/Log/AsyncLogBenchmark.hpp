@@ -0,0 +1,91 @@
+#ifndef RADIUM_ASYNCLOG_BENCHMARK_HPP_
+#define RADIUM_ASYNCLOG_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Log/Log.hpp>
+#include <Core/Log/AsyncLog.hpp>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    class AsyncLogBenchmark : public Benchmark
+    {
+        // Log messageCount messages from each thread, and return the average cost of a LOG
+        // statement in microseconds. Waits until the messages are written.
+        static double logFromThreads( uint threadCount, uint messageCount )
+        {
+            auto start = Ra::Core::Timer::Clock::now();
+            std::vector<std::thread> threads;
+            for ( uint t = 0; t < threadCount; ++t )
+            {
+                threads.emplace_back( [t, messageCount]()
+                {
+                    for ( uint i = 0; i < messageCount; ++i )
+                    {
+                        LOG( logINFO ) << "Thread " << t << " computed " << i * 0.5f << " in task " << i;
+                    }
+                } );
+            }
+            for ( auto& t : threads )
+            {
+                t.join();
+            }
+            auto end = Ra::Core::Timer::Clock::now();
+            Ra::Core::AsyncLog::flush();
+            return double( Ra::Core::Timer::getIntervalMicro( start, end ) ) / double( threadCount * messageCount );
+        }
+
+        void run() override
+        {
+            FILE* previous = Output2FILE::Stream();
+            FILE* file = tmpfile();
+            if ( file == nullptr )
+            {
+                return;
+            }
+            Output2FILE::Stream() = file;
+
+            const uint messageCount = 100000;
+            for ( uint threadCount : { 1u, 4u } )
+            {
+                const std::string suffix = " (" + std::to_string( threadCount ) + " threads)";
+
+                double sync = logFromThreads( threadCount, messageCount );
+                report( ( "LOG synchronous, per message" + suffix ).c_str(), sync, "us" );
+                report( "  throughput", threadCount / sync, "M messages/s" );
+
+                Ra::Core::AsyncLog::Parameters params;
+                params.m_policy = Ra::Core::AsyncLog::BLOCK_PRODUCER;
+                Ra::Core::AsyncLog::start( params );
+                auto start = Ra::Core::Timer::Clock::now();
+                double block = logFromThreads( threadCount, messageCount );
+                auto end = Ra::Core::Timer::Clock::now();
+                Ra::Core::AsyncLog::Statistics stats = Ra::Core::AsyncLog::getStatistics();
+                Ra::Core::AsyncLog::stop();
+                report( ( "LOG asynchronous blocking, per message" + suffix ).c_str(), block, "us" );
+                report( "  throughput until written",
+                        double( stats.m_written ) / double( Ra::Core::Timer::getIntervalMicro( start, end ) ), "M messages/s" );
+                report( "  messages per write", double( stats.m_written ) / double( stats.m_batches ), "" );
+
+                params.m_policy = Ra::Core::AsyncLog::DROP_MESSAGES;
+                Ra::Core::AsyncLog::start( params );
+                double drop = logFromThreads( threadCount, messageCount );
+                stats = Ra::Core::AsyncLog::getStatistics();
+                Ra::Core::AsyncLog::stop();
+                report( ( "LOG asynchronous dropping, per message" + suffix ).c_str(), drop, "us" );
+                report( "  dropped", 100.0 * double( stats.m_dropped ) / double( threadCount * messageCount ), "%" );
+            }
+
+            Output2FILE::Stream() = previous;
+            fclose( file );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( AsyncLogBenchmark );
+}
+
+#endif // RADIUM_ASYNCLOG_BENCHMARK_HPP_
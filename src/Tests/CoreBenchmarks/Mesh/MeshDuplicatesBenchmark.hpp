@@ -0,0 +1,86 @@
+#ifndef RADIUM_MESHDUPLICATES_BENCHMARK_HPP_
+#define RADIUM_MESHDUPLICATES_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+namespace RaBenchmarks
+{
+    class MeshDuplicatesBenchmark : public Benchmark
+    {
+        typedef Ra::Core::TriangleMesh TriangleMesh;
+        typedef Ra::Core::Vector3 Vector3;
+        typedef Ra::Core::VertexIdx VertexIdx;
+
+        // Each triangle with its own three vertices, as loaded from files storing per corner attributes.
+        static TriangleMesh makeSoup( const TriangleMesh& mesh )
+        {
+            TriangleMesh soup;
+            soup.m_vertices.reserve( 3 * mesh.m_triangles.size() );
+            for ( const auto& t : mesh.m_triangles )
+            {
+                const uint first = soup.m_vertices.size();
+                for ( uint i = 0; i < 3; ++i )
+                {
+                    soup.m_vertices.push_back( mesh.m_vertices[t[i]] );
+                }
+                soup.m_triangles.push_back( Ra::Core::Triangle( first, first + 1, first + 2 ) );
+            }
+            return soup;
+        }
+
+        // Previous implementation : lexicographic sort of (position, index) pairs.
+        static void findDuplicatesSort( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap )
+        {
+            std::vector<std::pair<Vector3, int>> vertices;
+            for ( uint i = 0; i < mesh.m_vertices.size(); ++i )
+            {
+                vertices.push_back( std::make_pair( mesh.m_vertices[i], int( i ) ) );
+            }
+            std::sort( vertices.begin(), vertices.end(), []( std::pair<Vector3, int> a, std::pair<Vector3, int> b ) {
+                return std::make_tuple( a.first.x(), a.first.y(), a.first.z(), a.second ) <
+                       std::make_tuple( b.first.x(), b.first.y(), b.first.z(), b.second );
+            } );
+            duplicatesMap.resize( mesh.m_vertices.size() );
+            duplicatesMap[vertices[0].second] = vertices[0].second;
+            for ( uint i = 1; i < vertices.size(); ++i )
+            {
+                duplicatesMap[vertices[i].second] = vertices[i].first == vertices[i - 1].first
+                                                        ? duplicatesMap[vertices[i - 1].second]
+                                                        : VertexIdx( vertices[i].second );
+            }
+        }
+
+        void run() override
+        {
+            // 2 * 708 * 708 > 1M faces, 3M vertices.
+            const TriangleMesh soup = makeSoup( Ra::Core::MeshUtils::makePlaneGrid( 708, 708 ) );
+            std::vector<VertexIdx> duplicates;
+
+            timeIt( "findDuplicates, comparison sort (previous), 1M faces soup", 3,
+                    [&]() { findDuplicatesSort( soup, duplicates ); } );
+            timeIt( "findDuplicates, hash and radix sort, 1M faces soup", 3,
+                    [&]() { Ra::Core::MeshUtils::findDuplicates( soup, duplicates ); } );
+            timeIt( "findDuplicates, tolerance 1e-4, 1M faces soup", 3,
+                    [&]() { Ra::Core::MeshUtils::findDuplicates( soup, duplicates, 1e-4 ); } );
+
+            TriangleMesh merged;
+            std::vector<VertexIdx> vertexMap;
+            timeIt( "removeDuplicates, 1M faces soup", 3, [&]() {
+                merged = soup;
+                Ra::Core::MeshUtils::removeDuplicates( merged, vertexMap );
+            } );
+            report( "  input vertices", soup.m_vertices.size(), "" );
+            report( "  merged vertices", merged.m_vertices.size(), "" );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( MeshDuplicatesBenchmark );
+}
+
+#endif // RADIUM_MESHDUPLICATES_BENCHMARK_HPP_
@@ -0,0 +1,64 @@
+#ifndef RADIUM_MESHCONVERTER_BENCHMARK_HPP_
+#define RADIUM_MESHCONVERTER_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/Wrapper/TopologicalMeshConvert.hpp>
+
+#include <string>
+
+namespace RaBenchmarks
+{
+    class MeshConverterBenchmark : public Benchmark
+    {
+        typedef Ra::Core::TriangleMesh TriangleMesh;
+        typedef Ra::Core::TopologicalMesh TopologicalMesh;
+
+        // Same mesh with each triangle having its own three vertices, as loaded from
+        // files storing per corner attributes.
+        static TriangleMesh makeSoup( const TriangleMesh& mesh )
+        {
+            TriangleMesh soup;
+            soup.m_vertices.reserve( 3 * mesh.m_triangles.size() );
+            soup.m_normals.reserve( 3 * mesh.m_triangles.size() );
+            for ( const auto& t : mesh.m_triangles )
+            {
+                const uint first = soup.m_vertices.size();
+                for ( uint i = 0; i < 3; ++i )
+                {
+                    soup.m_vertices.push_back( mesh.m_vertices[t[i]] );
+                    soup.m_normals.push_back( mesh.m_normals[t[i]] );
+                }
+                soup.m_triangles.push_back( Ra::Core::Triangle( first, first + 1, first + 2 ) );
+            }
+            return soup;
+        }
+
+        void roundTrip( const std::string& name, const TriangleMesh& mesh )
+        {
+            TopologicalMesh topo;
+            TriangleMesh back;
+
+            timeIt( ( "MeshConverter TriangleMesh -> TopologicalMesh, " + name ).c_str(), 3,
+                    [&]() { Ra::Core::MeshConverter::convert( mesh, topo ); } );
+            timeIt( ( "MeshConverter TopologicalMesh -> TriangleMesh, " + name ).c_str(), 3,
+                    [&]() { Ra::Core::MeshConverter::convert( topo, back ); } );
+
+            report( "  faces", mesh.m_triangles.size(), "" );
+            report( "  input vertices", mesh.m_vertices.size(), "" );
+            report( "  merged vertices", topo.n_vertices(), "" );
+        }
+
+        void run() override
+        {
+            // 2 * 708 * 708 > 1M faces.
+            const TriangleMesh grid = Ra::Core::MeshUtils::makePlaneGrid( 708, 708 );
+            roundTrip( "1M faces grid", grid );
+            roundTrip( "1M faces triangle soup", makeSoup( grid ) );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( MeshConverterBenchmark );
+}
+
+#endif // RADIUM_MESHCONVERTER_BENCHMARK_HPP_
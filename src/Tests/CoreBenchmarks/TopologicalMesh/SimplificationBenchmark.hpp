@@ -0,0 +1,54 @@
+#ifndef RADIUM_SIMPLIFICATION_BENCHMARK_HPP_
+#define RADIUM_SIMPLIFICATION_BENCHMARK_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Mesh/TopologicalTriMesh/Operations/Simplification.hpp>
+
+#include <string>
+
+namespace RaBenchmarks
+{
+    class SimplificationBenchmark : public Benchmark
+    {
+        void run() override
+        {
+            using namespace Ra::Core::TMOperations;
+
+            // 20 * 4^8 = 1.3M faces, with shared vertices.
+            Ra::Core::TriangleMesh sphere = Ra::Core::MeshUtils::makeGeodesicSphere( 1, 8 );
+            std::vector<Ra::Core::VertexIdx> vertexMap;
+            Ra::Core::MeshUtils::removeDuplicates( sphere, vertexMap );
+            const uint numFaces = sphere.m_triangles.size();
+
+            Ra::Core::ProgressiveMesh pm;
+            for ( uint partitions : { 1u, 0u } )
+            {
+                SimplificationParameters params;
+                params.m_targetFaceCount = numFaces / 100;
+                params.m_partitionCount = partitions;
+
+                const std::string name = std::string( "QEM simplify 1.3M -> 13k faces, " ) +
+                                         ( partitions == 1 ? "sequential" : "partitioned" );
+                timeIt( name.c_str(), 1, [&]() { simplify( sphere, pm, params ); } );
+                report( "  collapses", pm.getCollapseCount(), "" );
+            }
+
+            timeIt( "ProgressiveMesh refine to full resolution", 1, [&]() { pm.setLevel( 0 ); } );
+            timeIt( "ProgressiveMesh coarsen to 13k faces", 1, [&]() { pm.setFaceCount( numFaces / 100 ); } );
+
+            Ra::Core::TriangleMesh lod;
+            timeIt( "ProgressiveMesh extract 13k faces mesh", 10, [&]() { pm.getMesh( lod ); } );
+
+            std::vector<Ra::Core::TriangleMesh> lods;
+            timeIt( "QEM LOD chain 1.3M -> 130k, 13k, 1.3k faces", 1, [&]() {
+                makeLods( sphere, { numFaces / 10, numFaces / 100, numFaces / 1000 }, lods );
+            } );
+        }
+    };
+
+    RA_BENCHMARK_CLASS( SimplificationBenchmark );
+}
+
+#endif // RADIUM_SIMPLIFICATION_BENCHMARK_HPP_
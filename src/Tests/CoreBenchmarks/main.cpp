@@ -0,0 +1,22 @@
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+
+#include <Tests/CoreBenchmarks/Algebra/SplineBenchmark.hpp>
+#include <Tests/CoreBenchmarks/Containers/SlotMapBenchmark.hpp>
+#include <Tests/CoreBenchmarks/Geometry/DistanceBenchmark.hpp>
+#include <Tests/CoreBenchmarks/Geometry/PartitionBenchmark.hpp>
+#include <Tests/CoreBenchmarks/LightCulling/LightClusterGridBenchmark.hpp>
+#include <Tests/CoreBenchmarks/Log/AsyncLogBenchmark.hpp>
+#include <Tests/CoreBenchmarks/Image/FrameRecorderBenchmark.hpp>
+#include <Tests/CoreBenchmarks/Image/TextureLoaderBenchmark.hpp>
+#include <Tests/CoreBenchmarks/Mesh/MeshDuplicatesBenchmark.hpp>
+#include <Tests/CoreBenchmarks/TopologicalMesh/MeshConverterBenchmark.hpp>
+#include <Tests/CoreBenchmarks/TopologicalMesh/SimplificationBenchmark.hpp>
+
+int main()
+{
+    for (auto benchmark : RaBenchmarks::Benchmark::getBenchmarks())
+    {
+        benchmark->run();
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef RADIUM_SPLINE_TEST_HPP_
+#define RADIUM_SPLINE_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Math/Spline.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace RaTests
+{
+    class SplineTest : public Test
+    {
+        /// Whether speed is the slope of a linear spline at u : the knots of a linear spline
+        /// with n control points are uniform in [0,1] and the slope of segment i is
+        /// (P[i+1] - P[i]) / (t[i+1] - t[i]). At a knot, either segment is accepted.
+        template <typename Vector>
+        bool isLinearSlope( const Ra::Core::VectorArray<Vector>& points, Scalar u, const Vector& speed, Scalar eps )
+        {
+            const int segments = int( points.size() ) - 1;
+            const Scalar s = std::min( std::max( u, Scalar( 0 ) ), Scalar( 1 ) ) * Scalar( segments );
+            const int first = std::max( int( std::ceil( s - eps ) ) - 1, 0 );
+            const int last = std::min( int( std::floor( s + eps ) ), segments - 1 );
+            for ( int i = first; i <= last; ++i )
+            {
+                const Vector slope = ( points[i + 1] - points[i] ) * Scalar( segments );
+                if ( ( speed - slope ).norm() <= eps * std::max( Scalar( 1 ), slope.norm() ) )
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Compare the de Boor evaluations of a random spline with the blossom recursion.
+        /// The derivative of a linear spline, which the recursion does not handle (its
+        /// derivative would be of order 1), is compared with the slope of its segments.
+        template <uint D, uint K>
+        bool checkSpline( typename Ra::Core::Spline<D, K>::Type type, uint pointCount, std::mt19937& gen )
+        {
+            typedef typename Ra::Core::Spline<D, K>::Vector Vector;
+            std::uniform_real_distribution<Scalar> dist( -1, 1 );
+
+            Ra::Core::VectorArray<Vector> points( pointCount );
+            for ( auto& p : points )
+            {
+                for ( uint i = 0; i < D; ++i )
+                {
+                    p[i] = dist( gen );
+                }
+            }
+            Ra::Core::Spline<D, K> spline( type );
+            spline.setCtrlPoints( points );
+
+            // Knots, bounds, and parameters outside of [0,1] which are clamped.
+            std::vector<Scalar> us = { 0, 1, -0.5, 2, 0.5 };
+            for ( uint i = 0; i <= pointCount; ++i )
+            {
+                us.push_back( Scalar( i ) / Scalar( pointCount + 1 - K ) );
+            }
+            for ( uint i = 0; i < 2000; ++i )
+            {
+                us.push_back( ( dist( gen ) + 1 ) / 2 );
+            }
+
+            Ra::Core::VectorArray<Vector> f, df, fOnly;
+            spline.evaluate( us, f, &df );
+            spline.evaluate( us, fOnly );
+
+            // Same operations as the recursion : only the order of the float operations may change.
+            const Scalar eps = 1e-4;
+            bool ok = f.size() == us.size() && df.size() == us.size() && fOnly.size() == us.size();
+            for ( uint i = 0; ok && i < us.size(); ++i )
+            {
+                const Vector ref = spline.fRecursive( us[i] );
+                Vector speed;
+                const Vector p = spline.fdf( us[i], speed );
+                ok = ( spline.f( us[i] ) - ref ).norm() <= eps && ( p - ref ).norm() <= eps &&
+                     ( f[i] - ref ).norm() <= eps && fOnly[i] == f[i];
+                if ( K == 2 )
+                {
+                    ok = ok && isLinearSlope( points, us[i], spline.df( us[i] ), eps ) &&
+                         isLinearSlope( points, us[i], speed, eps ) && isLinearSlope( points, us[i], df[i], eps );
+                }
+                else
+                {
+                    const Vector dref = spline.dfRecursive( us[i] );
+                    ok = ok && ( spline.df( us[i] ) - dref ).norm() <= eps && ( speed - dref ).norm() <= eps &&
+                         ( df[i] - dref ).norm() <= eps;
+                }
+            }
+            return ok;
+        }
+
+        void testRecursion()
+        {
+            typedef Ra::Core::Spline<2, 2> Spline2;
+            typedef Ra::Core::Spline<3, 3> Spline3;
+            typedef Ra::Core::Spline<3, 4> Spline4;
+            std::mt19937 gen( 13 );
+
+            RA_UNIT_TEST( ( checkSpline<2, 2>( Spline2::OPEN_UNIFORM, 2, gen ) ) &&
+                          ( checkSpline<2, 2>( Spline2::OPEN_UNIFORM, 9, gen ) ) &&
+                          ( checkSpline<2, 2>( Spline2::UNIFORM, 7, gen ) ), "Linear splines." );
+            RA_UNIT_TEST( ( checkSpline<3, 3>( Spline3::OPEN_UNIFORM, 3, gen ) ) &&
+                          ( checkSpline<3, 3>( Spline3::OPEN_UNIFORM, 20, gen ) ) &&
+                          ( checkSpline<3, 3>( Spline3::UNIFORM, 11, gen ) ), "Quadratic splines." );
+            RA_UNIT_TEST( ( checkSpline<3, 4>( Spline4::OPEN_UNIFORM, 4, gen ) ) &&
+                          ( checkSpline<3, 4>( Spline4::OPEN_UNIFORM, 50, gen ) ) &&
+                          ( checkSpline<3, 4>( Spline4::UNIFORM, 12, gen ) ), "Cubic splines." );
+        }
+
+        void testInterpolation()
+        {
+            // An open uniform spline goes through its first and last control points, tangent to the polygon.
+            typedef Ra::Core::Spline<3, 4>::Vector Vector;
+            Ra::Core::VectorArray<Vector> points = { Vector( 0, 0, 0 ), Vector( 1, 0, 0 ), Vector( 1, 1, 0 ),
+                                                     Vector( 2, 1, 1 ), Vector( 3, 0, 1 ) };
+            Ra::Core::Spline<3, 4> spline;
+            spline.setCtrlPoints( points );
+
+            RA_UNIT_TEST( spline.f( 0 ).isApprox( points.front() ) &&
+                          ( spline.f( 1 ) - points.back() ).norm() < 1e-5, "End points are interpolated." );
+            RA_UNIT_TEST( spline.df( 0 ).normalized().isApprox( Vector::UnitX() ) &&
+                          spline.df( 1 ).normalized().isApprox( ( points[4] - points[3] ).normalized() ),
+                          "End tangents." );
+        }
+
+        void run() override
+        {
+            testRecursion();
+            testInterpolation();
+        }
+    };
+
+    RA_TEST_CLASS( SplineTest );
+}
+
+#endif // RADIUM_SPLINE_TEST_HPP_
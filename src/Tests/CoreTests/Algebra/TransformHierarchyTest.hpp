@@ -0,0 +1,239 @@
+#ifndef RADIUM_TRANSFORM_HIERARCHY_TEST_HPP_
+#define RADIUM_TRANSFORM_HIERARCHY_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Math/TransformHierarchy.hpp>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace RaTests
+{
+    class TransformHierarchyTest : public Test
+    {
+        typedef Ra::Core::Index Index;
+        typedef Ra::Core::Transform Transform;
+        typedef Ra::Core::TransformHierarchy TransformHierarchy;
+
+        static Transform translation( Scalar x, Scalar y, Scalar z )
+        {
+            Transform t = Transform::Identity();
+            t.translate( Ra::Core::Vector3( x, y, z ) );
+            return t;
+        }
+
+        static bool isApprox( const Transform& a, const Transform& b )
+        {
+            return a.matrix().isApprox( b.matrix() );
+        }
+
+        void testBasics()
+        {
+            TransformHierarchy hierarchy;
+            const Transform t1 = translation( 1, 0, 0 );
+            const Transform t2 = Transform( Ra::Core::AngleAxis( 0.5, Ra::Core::Vector3::UnitZ() ) );
+            const Transform t3 = translation( 0, 2, 0 );
+
+            const Index root = hierarchy.addNode( Index::Invalid(), t1 );
+            const Index child = hierarchy.addNode( root, t2 );
+            const Index leaf = hierarchy.addNode( child, t3 );
+            RA_UNIT_TEST( hierarchy.size() == 3 && hierarchy.getParent( leaf ) == child, "Add nodes." );
+            RA_UNIT_TEST( hierarchy.getEpoch() == 0 && isApprox( hierarchy.getWorld( leaf ), Transform::Identity() ),
+                          "Nothing is published before the first update." );
+
+            RA_UNIT_TEST( hierarchy.update() == 3 && hierarchy.getEpoch() == 1, "First update." );
+            RA_UNIT_TEST( isApprox( hierarchy.getWorld( root ), t1 ) &&
+                          isApprox( hierarchy.getWorld( child ), t1 * t2 ) &&
+                          isApprox( hierarchy.getWorld( leaf ), t1 * t2 * t3 ), "World transforms." );
+            RA_UNIT_TEST( hierarchy.update() == 0 && hierarchy.getEpoch() == 1, "Nothing is dirty." );
+
+            // Only the subtree of an edited node is updated.
+            const Index other = hierarchy.addNode( Index::Invalid(), t3 );
+            hierarchy.update();
+            hierarchy.setLocal( child, t3 );
+            RA_UNIT_TEST( hierarchy.update() == 2, "Dirty subtree." );
+            RA_UNIT_TEST( isApprox( hierarchy.getWorld( leaf ), t1 * t3 * t3 ) &&
+                          isApprox( hierarchy.getWorld( other ), t3 ), "Updated world transforms." );
+
+            // Reparenting, including to a node created later.
+            const Index late = hierarchy.addNode( Index::Invalid(), t2 );
+            hierarchy.setParent( root, late );
+            hierarchy.update();
+            RA_UNIT_TEST( isApprox( hierarchy.getWorld( leaf ), t2 * t1 * t3 * t3 ), "Set parent." );
+
+            // Children of a removed node are attached to its parent.
+            hierarchy.removeNode( child );
+            RA_UNIT_TEST( !hierarchy.contains( child ) && hierarchy.getParent( leaf ) == root, "Remove node." );
+            hierarchy.update();
+            RA_UNIT_TEST( isApprox( hierarchy.getWorld( leaf ), t2 * t1 * t3 ), "World after remove." );
+
+            const Index reused = hierarchy.addNode( leaf, t1 );
+            RA_UNIT_TEST( reused == child && hierarchy.size() == 5, "Removed nodes are reused." );
+            hierarchy.update();
+            RA_UNIT_TEST( isApprox( hierarchy.getWorld( reused ), t2 * t1 * t3 * t1 ), "Reused node." );
+        }
+
+        void testSnapshot()
+        {
+            TransformHierarchy hierarchy;
+            const Index node = hierarchy.addNode( Index::Invalid(), translation( 1, 0, 0 ) );
+            hierarchy.update();
+
+            TransformHierarchy::Snapshot* snapshot = new TransformHierarchy::Snapshot( hierarchy );
+            hierarchy.setLocal( node, translation( 2, 0, 0 ) );
+            hierarchy.update();
+            RA_UNIT_TEST( snapshot->getEpoch() == 1 && isApprox( snapshot->getWorld( node ), translation( 1, 0, 0 ) ),
+                          "A snapshot is not changed by updates." );
+            RA_UNIT_TEST( isApprox( hierarchy.getWorld( node ), translation( 2, 0, 0 ) ), "New snapshot." );
+            const Index added = hierarchy.addNode();
+            RA_UNIT_TEST( isApprox( snapshot->getWorld( added ), Transform::Identity() ), "Node added after snapshot." );
+            delete snapshot;
+
+            hierarchy.setLocal( node, translation( 3, 0, 0 ) );
+            hierarchy.update();
+            RA_UNIT_TEST( hierarchy.getEpoch() == 3 && isApprox( hierarchy.getWorld( node ), translation( 3, 0, 0 ) ),
+                          "Update after the snapshot is released." );
+        }
+
+        void testRandom()
+        {
+            // Random forest, checked against the product of local transforms along the parents.
+            TransformHierarchy hierarchy;
+            std::mt19937 gen( 7 );
+            std::uniform_real_distribution<Scalar> dist( -1, 1 );
+            const uint n = 5000;
+            std::vector<Index> nodes;
+            std::vector<int> parents;
+            for ( uint i = 0; i < n; ++i )
+            {
+                const int parent = ( i == 0 || gen() % 8 == 0 ) ? -1 : int( gen() % i );
+                const Transform local = Transform( Ra::Core::AngleAxis( dist( gen ), Ra::Core::Vector3::UnitY() ) ) *
+                                        translation( dist( gen ), dist( gen ), dist( gen ) );
+                nodes.push_back( hierarchy.addNode( parent < 0 ? Index::Invalid() : nodes[parent], local ) );
+                parents.push_back( parent );
+            }
+            hierarchy.update();
+
+            for ( uint i = 0; i < 100; ++i )
+            {
+                hierarchy.setLocal( nodes[gen() % n], translation( dist( gen ), 0, 0 ) );
+            }
+            hierarchy.update();
+            RA_UNIT_TEST( isConsistent( hierarchy, nodes, parents ), "Random hierarchy." );
+
+            // Reparent and remove random nodes, the children of removed nodes go to their parent.
+            std::vector<uchar> removed( n, false );
+            for ( uint k = 0; k < n / 2; ++k )
+            {
+                const uint i = gen() % n;
+                if ( removed[i] )
+                {
+                    continue;
+                }
+                if ( k % 4 == 0 )
+                {
+                    // Move to a root, which can not create a cycle.
+                    hierarchy.setParent( nodes[i], Index::Invalid() );
+                    parents[i] = -1;
+                    continue;
+                }
+                for ( uint j = 0; j < n; ++j )
+                {
+                    if ( !removed[j] && parents[j] == int( i ) )
+                    {
+                        parents[j] = parents[i];
+                    }
+                }
+                hierarchy.removeNode( nodes[i] );
+                removed[i] = true;
+            }
+            hierarchy.update();
+
+            bool parentsOk = true;
+            for ( uint i = 0; i < n; ++i )
+            {
+                parentsOk = parentsOk && ( removed[i] ||
+                    hierarchy.getParent( nodes[i] ) == ( parents[i] < 0 ? Index::Invalid() : nodes[parents[i]] ) );
+            }
+            RA_UNIT_TEST( parentsOk, "Parents after removals." );
+            RA_UNIT_TEST( isConsistent( hierarchy, nodes, parents, removed ), "Random hierarchy after removals." );
+        }
+
+        /// World transforms are the product of the local transforms along the parents.
+        static bool isConsistent( const TransformHierarchy& hierarchy, const std::vector<Index>& nodes,
+                                  const std::vector<int>& parents,
+                                  const std::vector<uchar>& removed = std::vector<uchar>() )
+        {
+            bool ok = true;
+            TransformHierarchy::Snapshot snapshot( hierarchy );
+            for ( uint i = 0; i < nodes.size(); ++i )
+            {
+                if ( !removed.empty() && removed[i] )
+                {
+                    continue;
+                }
+                Transform expected = hierarchy.getLocal( nodes[i] );
+                for ( int p = parents[i]; p >= 0; p = parents[p] )
+                {
+                    expected = hierarchy.getLocal( nodes[p] ) * expected;
+                }
+                ok = ok && isApprox( snapshot.getWorld( nodes[i] ), expected );
+            }
+            return ok;
+        }
+
+        void testConcurrentEdits()
+        {
+            // Nodes are added and removed by several threads while another one updates.
+            TransformHierarchy hierarchy;
+            const Index root = hierarchy.addNode( Index::Invalid(), translation( 1, 0, 0 ) );
+            std::vector<std::thread> threads;
+            for ( uint t = 0; t < 4; ++t )
+            {
+                threads.emplace_back( [&hierarchy, root]()
+                {
+                    std::vector<Index> nodes;
+                    for ( uint i = 0; i < 2000; ++i )
+                    {
+                        const Index parent = ( i % 3 == 0 || nodes.empty() ) ? root : nodes.back();
+                        nodes.push_back( hierarchy.addNode( parent, translation( 0, 1, 0 ) ) );
+                        if ( i % 2 == 1 )
+                        {
+                            hierarchy.removeNode( nodes[nodes.size() - 2] );
+                            nodes.erase( nodes.end() - 2 );
+                        }
+                    }
+                    for ( const Index& node : nodes )
+                    {
+                        hierarchy.removeNode( node );
+                    }
+                } );
+            }
+            for ( uint i = 0; i < 200; ++i )
+            {
+                hierarchy.update();
+            }
+            for ( auto& thread : threads )
+            {
+                thread.join();
+            }
+            hierarchy.setLocal( root, translation( 2, 0, 0 ) );
+            hierarchy.update();
+            RA_UNIT_TEST( hierarchy.size() == 1 && isApprox( hierarchy.getWorld( root ), translation( 2, 0, 0 ) ),
+                          "Concurrent edits." );
+        }
+
+        void run() override
+        {
+            testBasics();
+            testSnapshot();
+            testRandom();
+            testConcurrentEdits();
+        }
+    };
+
+    RA_TEST_CLASS( TransformHierarchyTest );
+}
+
+#endif // RADIUM_TRANSFORM_HIERARCHY_TEST_HPP_
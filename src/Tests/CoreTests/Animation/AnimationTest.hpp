@@ -4,6 +4,9 @@
 #include <Tests.hpp>
 #include <Core/Animation/Handle/HandleWeightOperation.hpp>
 
+#include <cmath>
+#include <random>
+
 using Ra::Core::Animation::WeightMatrix;
 
 namespace RaTests
@@ -14,9 +17,11 @@ namespace RaTests
         //  - normalizeWeights
         //  - partitionOfUnity
         //  - check_NAN
+        //  - conversions between MeshWeight, triplets and WeightMatrix
+        //  - normalizeAndPruneWeights
         //
         // \todo Add other functions
-        void run() override
+        void testNormalization()
         {
             static const constexpr int w = 50;
             static const constexpr int h = w;
@@ -56,6 +61,140 @@ namespace RaTests
                           "Should find NaN in this matrix" );
 
         }
+
+        void testConversions()
+        {
+            using Ra::Core::Animation::MeshWeight;
+            std::mt19937 gen( 17 );
+            std::uniform_real_distribution<Scalar> dist( 0.01, 1 );
+            const uint vertexCount = 2000;
+            const uint handleCount = 40;
+
+            // Random weights, sorted by handle, and the same matrix built coefficient by coefficient.
+            MeshWeight weights( vertexCount );
+            WeightMatrix expected( vertexCount, handleCount );
+            for ( uint i = 0; i < vertexCount; ++i )
+            {
+                for ( uint j = gen() % 5; j < handleCount; j += 1 + gen() % 12 )
+                {
+                    weights[i].push_back( Ra::Core::Animation::SingleWeight( j, dist( gen ) ) );
+                    expected.coeffRef( i, j ) = weights[i].back().second;
+                }
+            }
+
+            const WeightMatrix matrix = Ra::Core::Animation::extractWeightMatrix( weights, handleCount );
+            const WeightMatrix matrixMT = Ra::Core::Animation::extractWeightMatrix( weights, handleCount, true );
+            RA_UNIT_TEST( matrix.rows() == vertexCount && matrix.cols() == handleCount &&
+                          matrix.nonZeros() == expected.nonZeros() && ( matrix - expected ).norm() == 0 &&
+                          ( matrixMT - expected ).norm() == 0, "MeshWeight to WeightMatrix." );
+
+            RA_UNIT_TEST( Ra::Core::Animation::extractMeshWeight( matrix ) == weights &&
+                          Ra::Core::Animation::extractMeshWeight( matrix, true ) == weights,
+                          "WeightMatrix to MeshWeight." );
+
+            std::vector<uint> maxIndex;
+            Ra::Core::Animation::getMaxWeightIndex( matrix, maxIndex );
+            bool ok = maxIndex.size() == vertexCount;
+            for ( uint i = 0; ok && i < vertexCount; ++i )
+            {
+                Ra::Core::VectorN row = Ra::Core::VectorN( matrix.row( i ).transpose() );
+                Eigen::Index expectedMax;
+                row.maxCoeff( &expectedMax );
+                ok = maxIndex[i] == uint( expectedMax ) &&
+                     Ra::Core::Animation::getMaxWeightIndex( matrix, i ) == uint( expectedMax );
+            }
+            RA_UNIT_TEST( ok, "Max weight index." );
+
+            WeightMatrix edited = matrix;
+            edited.coeffRef( 1, handleCount - 1 ) = 10;
+            RA_UNIT_TEST( Ra::Core::Animation::getMaxWeightIndex( edited, 1 ) == handleCount - 1 &&
+                          Ra::Core::Animation::getMaxWeightIndex( edited, 2 ) == maxIndex[2],
+                          "Max weight index of an edited matrix." );
+
+            // Repeated pairs keep their last weight.
+            const std::vector<Ra::Core::Animation::WeightTriplet> triplets = {
+                { 0, 1, 0.5 }, { 2, 0, 0.25 }, { 0, 1, 0.75 }, { 1, 1, 1 } };
+            const WeightMatrix fromTriplets = Ra::Core::Animation::createWeightMatrix( triplets, 3, 2 );
+            RA_UNIT_TEST( fromTriplets.nonZeros() == 3 && fromTriplets.coeff( 0, 1 ) == Scalar( 0.75 ) &&
+                          fromTriplets.coeff( 2, 0 ) == Scalar( 0.25 ) && fromTriplets.coeff( 1, 1 ) == 1,
+                          "WeightMatrix from triplets." );
+        }
+
+        void testPruning()
+        {
+            WeightMatrix matrix( 3, 4 );
+            matrix.coeffRef( 0, 0 ) = 0.1;
+            matrix.coeffRef( 0, 1 ) = 0.5;
+            matrix.coeffRef( 0, 2 ) = 0.3;
+            matrix.coeffRef( 0, 3 ) = 0.2;
+            matrix.coeffRef( 1, 0 ) = std::nan( "" );
+            matrix.coeffRef( 1, 1 ) = -1;
+            matrix.coeffRef( 1, 3 ) = 2;
+
+            Ra::Core::Animation::WeightStatistics stats;
+            const WeightMatrix pruned = Ra::Core::Animation::normalizeAndPruneWeights( matrix, 2, &stats );
+            RA_UNIT_TEST( pruned.nonZeros() == 3 && std::abs( pruned.coeff( 0, 1 ) - Scalar( 0.625 ) ) < 1e-6 &&
+                          std::abs( pruned.coeff( 0, 2 ) - Scalar( 0.375 ) ) < 1e-6 && pruned.coeff( 1, 3 ) == 1,
+                          "Largest weights are kept and normalized." );
+            RA_UNIT_TEST( stats.m_vertexCount == 3 && stats.m_weightCount == 5 && stats.m_maxInfluences == 4 &&
+                          stats.m_emptyVertexCount == 1 && stats.m_invalidWeightCount == 2 &&
+                          stats.m_prunedWeightCount == 2 && stats.m_normalizedVertexCount == 2 &&
+                          std::abs( stats.m_maxPrunedWeight - Scalar( 0.2 / 1.1 ) ) < 1e-6, "Weight statistics." );
+
+            // Random weights : each vertex keeps its heaviest weights, which sum to 1.
+            std::mt19937 gen( 23 );
+            std::uniform_real_distribution<Scalar> dist( 0.01, 1 );
+            const uint vertexCount = 3000;
+            const uint maxInfluences = 4;
+            WeightMatrix random( vertexCount, 30 );
+            for ( uint i = 0; i < vertexCount; ++i )
+            {
+                for ( uint j = gen() % 3; j < 30; j += 1 + gen() % 6 )
+                {
+                    random.coeffRef( i, j ) = dist( gen );
+                }
+            }
+            const WeightMatrix prunedMT =
+                Ra::Core::Animation::normalizeAndPruneWeights( random, maxInfluences, &stats, true );
+            bool ok = stats.m_vertexCount == vertexCount && stats.m_weightCount == random.nonZeros() &&
+                      stats.m_emptyVertexCount == 0 && stats.m_normalizedVertexCount == vertexCount;
+            uint prunedCount = 0;
+            for ( uint i = 0; ok && i < vertexCount; ++i )
+            {
+                Ra::Core::VectorN row = Ra::Core::VectorN( random.row( i ).transpose() );
+                Ra::Core::VectorN kept = Ra::Core::VectorN( prunedMT.row( i ).transpose() );
+                const uint count = uint( ( row.array() > 0 ).count() );
+                const uint keptCount = uint( ( kept.array() > 0 ).count() );
+                ok = keptCount == std::min( count, maxInfluences ) && std::abs( kept.sum() - 1 ) < 1e-5;
+
+                // Kept weights are proportional to the input, and heavier than the dropped ones.
+                const Scalar keptSum = ( row.array() * ( kept.array() > 0 ).cast<Scalar>() ).sum();
+                Scalar minKept = 1e10;
+                Scalar maxDropped = 0;
+                for ( uint j = 0; ok && j < row.size(); ++j )
+                {
+                    if ( kept[j] > 0 )
+                    {
+                        minKept = std::min( minKept, row[j] );
+                        ok = std::abs( kept[j] - row[j] / keptSum ) < 1e-5;
+                    }
+                    else
+                    {
+                        maxDropped = std::max( maxDropped, row[j] );
+                    }
+                }
+                ok = ok && maxDropped <= minKept;
+                prunedCount += count - keptCount;
+            }
+            RA_UNIT_TEST( ok && stats.m_prunedWeightCount == prunedCount, "Random weights are pruned." );
+        }
+
+        void run() override
+        {
+            testNormalization();
+            testConversions();
+            testPruning();
+        }
     };
 
     RA_TEST_CLASS(HandleWeightTests)
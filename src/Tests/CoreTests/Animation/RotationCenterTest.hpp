@@ -0,0 +1,172 @@
+#ifndef RADIUM_ROTATION_CENTER_TEST_HPP_
+#define RADIUM_ROTATION_CENTER_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Animation/Skinning/RotationCenterSkinning.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+
+namespace RaTests
+{
+    class RotationCenterTest : public Test
+    {
+        typedef Ra::Core::Vector3 Vector3;
+        typedef Ra::Core::Animation::WeightMatrix WeightMatrix;
+
+        /// Plane along x, with weights of 4 bones falling off along x.
+        static Ra::Core::Skinning::RefData makeData()
+        {
+            Ra::Core::Skinning::RefData data;
+            data.m_referenceMesh = Ra::Core::MeshUtils::makePlaneGrid( 4, 16, Ra::Core::Vector2( 2, 0.5 ) );
+            const auto& vertices = data.m_referenceMesh.m_vertices;
+            data.m_weights = WeightMatrix( vertices.size(), 4 );
+            for ( uint i = 0; i < vertices.size(); ++i )
+            {
+                Scalar w[4];
+                Scalar sum = 0;
+                for ( uint b = 0; b < 4; ++b )
+                {
+                    w[b] = std::max( Scalar( 0 ), Scalar( 1.2 ) - std::abs( vertices[i].x() - ( Scalar( b ) - 1.5f ) ) );
+                    sum += w[b];
+                }
+                for ( uint b = 0; b < 4; ++b )
+                {
+                    if ( w[b] > 0 )
+                    {
+                        data.m_weights.insert( i, b ) = w[b] / sum;
+                    }
+                }
+            }
+            data.m_weights.makeCompressed();
+            return data;
+        }
+
+        void testIntegral()
+        {
+            // Without subdivision, the CoRs are the integrals over all the triangles of the mesh.
+            Ra::Core::Skinning::RefData data = makeData();
+            const Scalar sigma = 0.1f;
+            Ra::Core::Animation::computeCoR( data, sigma, 10 );
+
+            const Ra::Core::TriangleMesh& mesh = data.m_referenceMesh;
+            const Eigen::SparseMatrix<Scalar, Eigen::RowMajor> weights = data.m_weights;
+            bool ok = data.m_CoR.size() == mesh.m_vertices.size();
+            uint nonZero = 0;
+            for ( uint i = 0; ok && i < mesh.m_vertices.size(); ++i )
+            {
+                const Eigen::SparseVector<Scalar> Wi = weights.row( i );
+                Vector3 cor = Vector3::Zero();
+                Scalar sumweight = 0;
+                for ( const auto& tri : mesh.m_triangles )
+                {
+                    const Eigen::SparseVector<Scalar> triWeight =
+                        ( 1 / 3.f ) * ( weights.row( tri[0] ) + weights.row( tri[1] ) + weights.row( tri[2] ) );
+                    const Vector3& p0 = mesh.m_vertices[tri[0]];
+                    const Vector3& p1 = mesh.m_vertices[tri[1]];
+                    const Vector3& p2 = mesh.m_vertices[tri[2]];
+                    const Scalar area = 0.5f * ( p1 - p0 ).cross( p2 - p0 ).norm();
+                    const Scalar s = Ra::Core::Animation::weightSimilarity( Wi, triWeight, sigma );
+                    cor += s * area * ( p0 + p1 + p2 ) / 3.f;
+                    sumweight += s * area;
+                }
+                const Vector3 expected = sumweight > 0 ? Vector3( cor / sumweight ) : Vector3::Zero();
+                ok = ( data.m_CoR[i] - expected ).norm() < 1e-4f;
+                nonZero += sumweight > 0 ? 1 : 0;
+            }
+            RA_UNIT_TEST( ok, "CoRs match the integrals over all the triangles." );
+            RA_UNIT_TEST( nonZero > 0 && nonZero < mesh.m_vertices.size(),
+                          "Only vertices with several bones have a CoR." );
+        }
+
+        void testSubdivision()
+        {
+            Ra::Core::Skinning::RefData data = makeData();
+            Ra::Core::Animation::computeCoR( data, 0.1f, 0.05f );
+
+            // CoRs are averages of centroids of the (planar) mesh.
+            bool ok = data.m_CoR.size() == data.m_referenceMesh.m_vertices.size();
+            for ( const auto& cor : data.m_CoR )
+            {
+                ok = ok && cor.allFinite() && std::abs( cor.x() ) <= 2 && std::abs( cor.y() ) <= 0.5f &&
+                     std::abs( cor.z() ) < 1e-6f;
+            }
+            RA_UNIT_TEST( ok, "CoRs on a subdivided mesh." );
+        }
+
+        /// Directory of the temporary files, so that the tests do not write in the working directory.
+        static std::string getTempDirectory()
+        {
+            for ( const char* var : {"TMPDIR", "TMP", "TEMP"} )
+            {
+                const char* dir = std::getenv( var );
+                if ( dir != nullptr && dir[0] != '\0' )
+                {
+                    return dir;
+                }
+            }
+#if defined( OS_WINDOWS )
+            return ".";
+#else
+            return "/tmp";
+#endif
+        }
+
+        void testCache()
+        {
+            const std::string dir = getTempDirectory();
+            Ra::Core::Skinning::RefData data = makeData();
+            const uint64_t hash = Ra::Core::Animation::hashCoRInput( data.m_referenceMesh, data.m_weights, 0.1f, 0.1f );
+            const std::string cacheFile = Ra::Core::Animation::getCoRCacheFilename( dir, hash );
+            std::remove( cacheFile.c_str() );
+
+            RA_UNIT_TEST( !Ra::Core::Animation::loadOrComputeCoR( data, dir ), "Computed without a cache file." );
+            Ra::Core::Skinning::RefData cached = makeData();
+            RA_UNIT_TEST( Ra::Core::Animation::loadOrComputeCoR( cached, dir ), "Read from the cache file." );
+            RA_UNIT_TEST( cached.m_CoR == data.m_CoR, "Cached CoRs." );
+
+            cached.m_weights.coeffRef( 0, 0 ) *= 0.5f;
+            const uint64_t otherHash =
+                Ra::Core::Animation::hashCoRInput( cached.m_referenceMesh, cached.m_weights, 0.1f, 0.1f );
+            RA_UNIT_TEST( otherHash != hash &&
+                          Ra::Core::Animation::hashCoRInput( data.m_referenceMesh, data.m_weights, 0.2f, 0.1f ) != hash &&
+                          Ra::Core::Animation::hashCoRInput( data.m_referenceMesh, data.m_weights, 0.1f, 0.1f, 1 ) != hash,
+                          "Other weights, parameters or seeds have another hash." );
+
+            // The file of another input with the same name is not read, and is replaced.
+            const std::string otherFile = Ra::Core::Animation::getCoRCacheFilename( dir, otherHash );
+            if ( otherFile != cacheFile )
+            {
+                std::remove( otherFile.c_str() );
+                std::rename( cacheFile.c_str(), otherFile.c_str() );
+            }
+            RA_UNIT_TEST( !Ra::Core::Animation::loadOrComputeCoR( cached, dir ), "The file of another input is not read." );
+            Ra::Core::Skinning::RefData other = makeData();
+            other.m_weights.coeffRef( 0, 0 ) *= 0.5f;
+            RA_UNIT_TEST( Ra::Core::Animation::loadOrComputeCoR( other, dir ) && other.m_CoR == cached.m_CoR,
+                          "The file of another input is replaced." );
+            std::remove( cacheFile.c_str() );
+            std::remove( otherFile.c_str() );
+
+            std::set<std::string> files;
+            for ( uint64_t h = 0; h < 1000; ++h )
+            {
+                files.insert( Ra::Core::Animation::getCoRCacheFilename( dir, h * 0x9e3779b97f4a7c15ull ) );
+            }
+            RA_UNIT_TEST( files.size() == Ra::Core::Animation::CoRCacheFileCount, "The number of cache files is bounded." );
+        }
+
+        void run() override
+        {
+            testIntegral();
+            testSubdivision();
+            testCache();
+        }
+    };
+
+    RA_TEST_CLASS( RotationCenterTest );
+}
+
+#endif // RADIUM_ROTATION_CENTER_TEST_HPP_
@@ -0,0 +1,128 @@
+#ifndef RADIUM_DRAWKEY_TEST_HPP_
+#define RADIUM_DRAWKEY_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Containers/DrawKey.hpp>
+#include <Core/Containers/KeyGroups.hpp>
+#include <Core/Containers/RadixSort.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace RaTests
+{
+    class DrawKeyTest : public Test
+    {
+        void testPacking()
+        {
+            using namespace Ra::Core::DrawKey;
+
+            const uint64_t key = makeKey( 3, 0x123, 0x4567, 0x89ab, 0xcdef );
+            RA_UNIT_TEST( key == 0x3123456789abcdefull, "Fields are packed from pass to mesh." );
+            RA_UNIT_TEST( getField( key, PASS_BITS, PASS_SHIFT ) == 3 &&
+                          getField( key, SHADER_BITS, SHADER_SHIFT ) == 0x123 &&
+                          getField( key, MATERIAL_BITS, MATERIAL_SHIFT ) == 0x4567 &&
+                          getField( key, DEPTH_BITS, DEPTH_SHIFT ) == 0x89ab &&
+                          getField( key, MESH_BITS, MESH_SHIFT ) == 0xcdef, "Fields are read back." );
+
+            RA_UNIT_TEST( makeKey( 0x13, 0x1123, 0x14567, 0x189ab, 0x1cdef ) == key,
+                          "Fields are truncated to their number of bits." );
+
+            const uint64_t moved = setDepth( key, 0x10042 );
+            RA_UNIT_TEST( getField( moved, DEPTH_BITS, DEPTH_SHIFT ) == 0x42 &&
+                          ( moved & ~DEPTH_MASK ) == ( key & ~DEPTH_MASK ), "Only the depth is replaced." );
+        }
+
+        void testOrdering()
+        {
+            using namespace Ra::Core::DrawKey;
+
+            // Each field dominates all the less significant ones.
+            RA_UNIT_TEST( makeKey( 1, 0, 0, 0, 0 ) > makeKey( 0, 0xfff, 0xffff, 0xffff, 0xffff ), "Pass first." );
+            RA_UNIT_TEST( makeKey( 0, 1, 0, 0, 0 ) > makeKey( 0, 0, 0xffff, 0xffff, 0xffff ), "Then shader." );
+            RA_UNIT_TEST( makeKey( 0, 0, 1, 0, 0 ) > makeKey( 0, 0, 0, 0xffff, 0xffff ), "Then material." );
+            RA_UNIT_TEST( makeKey( 0, 0, 0, 1, 0 ) > makeKey( 0, 0, 0, 0, 0xffff ), "Then depth." );
+
+            // Sorting random draws orders them lexicographically, and the draws differing
+            // only by their depth end up in the same group.
+            std::mt19937 gen( 3 );
+            std::vector<uint64_t> keys( 5000 );
+            std::vector<uint> order( keys.size() );
+            std::vector<std::array<uint, 5>> fields( keys.size() );
+            for ( uint i = 0; i < keys.size(); ++i )
+            {
+                fields[i] = { { uint( gen() % 3 ), uint( gen() % 5 ), uint( gen() % 7 ), uint( gen() % 1000 ), uint( gen() % 4 ) } };
+                keys[i] = makeKey( fields[i][0], fields[i][1], fields[i][2], fields[i][3], fields[i][4] );
+                order[i] = i;
+            }
+            Ra::Core::radixSort( keys, order );
+
+            bool sorted = true;
+            for ( uint k = 1; k < order.size(); ++k )
+            {
+                sorted = sorted && fields[order[k - 1]] <= fields[order[k]];
+            }
+            RA_UNIT_TEST( sorted, "Draws are sorted by pass, shader, material, depth and mesh." );
+
+            Ra::Core::KeyGroups groups;
+            Ra::Core::groupKeys( keys, ~DEPTH_MASK, groups );
+            bool grouped = groups.getGroupCount() <= 3 * 5 * 7 * 4;
+            for ( uint g = 0; grouped && g < groups.getGroupCount(); ++g )
+            {
+                const auto& first = fields[order[groups.m_indices[groups.m_offsets[g]]]];
+                for ( uint k = groups.m_offsets[g]; k < groups.m_offsets[g + 1]; ++k )
+                {
+                    const auto& f = fields[order[groups.m_indices[k]]];
+                    grouped = grouped && f[0] == first[0] && f[1] == first[1] && f[2] == first[2] && f[4] == first[4];
+                }
+            }
+            RA_UNIT_TEST( grouped, "Groups ignore the depth." );
+        }
+
+        void testDepthBuckets()
+        {
+            using Ra::Core::DrawKey::getDepthBucket;
+
+            RA_UNIT_TEST( getDepthBucket( 0 ) == 0 && getDepthBucket( -1 ) == 0 &&
+                          getDepthBucket( std::numeric_limits<Scalar>::quiet_NaN() ) == 0,
+                          "Objects behind the camera get bucket 0." );
+            RA_UNIT_TEST( getDepthBucket( std::numeric_limits<Scalar>::infinity() ) <
+                          ( 1u << Ra::Core::DrawKey::DEPTH_BITS ), "Buckets fit in the key." );
+
+            // Buckets never decrease with the depth, and close depths at different scales are told apart.
+            std::mt19937 gen( 7 );
+            std::uniform_real_distribution<Scalar> exponent( -6, 6 );
+            std::vector<Scalar> depths( 10000 );
+            for ( auto& d : depths )
+            {
+                d = std::pow( Scalar( 10 ), exponent( gen ) );
+            }
+            std::sort( depths.begin(), depths.end() );
+
+            bool monotonic = true;
+            for ( uint i = 1; i < depths.size(); ++i )
+            {
+                monotonic = monotonic && getDepthBucket( depths[i - 1] ) <= getDepthBucket( depths[i] );
+            }
+            RA_UNIT_TEST( monotonic, "Depth buckets are monotonic." );
+
+            RA_UNIT_TEST( getDepthBucket( 0.001 ) < getDepthBucket( 0.0011 ) &&
+                          getDepthBucket( 1 ) < getDepthBucket( 1.1 ) &&
+                          getDepthBucket( 1000 ) < getDepthBucket( 1100 ), "Buckets are logarithmic." );
+        }
+
+        void run() override
+        {
+            testPacking();
+            testOrdering();
+            testDepthBuckets();
+        }
+    };
+    RA_TEST_CLASS( DrawKeyTest );
+}
+
+#endif // RADIUM_DRAWKEY_TEST_HPP_
@@ -0,0 +1,75 @@
+#ifndef RADIUM_KEYGROUPS_TEST_HPP_
+#define RADIUM_KEYGROUPS_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Containers/KeyGroups.hpp>
+
+#include <cstdint>
+#include <map>
+#include <random>
+
+namespace RaTests
+{
+    class KeyGroupsTest : public Test
+    {
+        void testSmall()
+        {
+            // Draw keys : material (high bits) | depth | mesh (low bits), grouped by material and mesh.
+            const std::vector<uint32_t> keys = { 0x10305, 0x10105, 0x20105, 0x10305, 0x10207, 0x10705 };
+            Ra::Core::KeyGroups groups;
+            Ra::Core::groupKeys( keys, uint32_t( 0xff00ff ), groups );
+
+            RA_UNIT_TEST( groups.getGroupCount() == 3, "Group count." );
+            RA_UNIT_TEST( groups.m_indices == std::vector<uint>( { 0, 1, 3, 5, 4, 2 } ) &&
+                          groups.m_offsets == std::vector<uint>( { 0, 4, 5, 6 } ), "Groups." );
+            RA_UNIT_TEST( groups.getMaxGroupSize() == 4 && groups.getGroupCount( 2 ) == 1 &&
+                          groups.getGroupedIndexCount( 2 ) == 4 && groups.getGroupedIndexCount( 1 ) == 6,
+                          "Statistics." );
+
+            std::vector<uint> indexGroups;
+            groups.getIndexGroups( indexGroups );
+            RA_UNIT_TEST( indexGroups == std::vector<uint>( { 0, 0, 2, 0, 1, 0 } ), "Group of each index." );
+
+            Ra::Core::groupKeys( std::vector<uint32_t>(), uint32_t( 0xff ), groups );
+            RA_UNIT_TEST( groups.getGroupCount() == 0 && groups.getMaxGroupSize() == 0, "No keys." );
+        }
+
+        void testRandom()
+        {
+            std::mt19937_64 gen( 5 );
+            const uint64_t mask = 0xffff0000ffffffffull;
+            std::vector<uint64_t> keys( 20000 );
+            std::map<uint64_t, std::vector<uint>> expected;
+            for ( uint i = 0; i < keys.size(); ++i )
+            {
+                keys[i] = ( ( gen() % 7 ) << 48 ) | ( gen() & 0xffffffff0000ull ) | ( gen() % 300 );
+                expected[keys[i] & mask].push_back( i );
+            }
+
+            Ra::Core::KeyGroups groups;
+            Ra::Core::groupKeys( keys, mask, groups );
+            bool ok = groups.getGroupCount() == expected.size();
+            uint g = 0;
+            uint maxSize = 0;
+            for ( auto it = expected.begin(); ok && it != expected.end(); ++it, ++g )
+            {
+                ok = std::vector<uint>( groups.m_indices.begin() + groups.m_offsets[g],
+                                        groups.m_indices.begin() + groups.m_offsets[g + 1] ) == it->second;
+                maxSize = std::max( maxSize, uint( it->second.size() ) );
+            }
+            RA_UNIT_TEST( ok, "Random keys are grouped in order." );
+            RA_UNIT_TEST( groups.getMaxGroupSize() == maxSize && groups.getGroupedIndexCount( 1 ) == keys.size(),
+                          "Random keys statistics." );
+        }
+
+        void run() override
+        {
+            testSmall();
+            testRandom();
+        }
+    };
+
+    RA_TEST_CLASS( KeyGroupsTest );
+}
+
+#endif // RADIUM_KEYGROUPS_TEST_HPP_
@@ -0,0 +1,94 @@
+#ifndef RADIUM_RADIXSORT_TEST_HPP_
+#define RADIUM_RADIXSORT_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Containers/RadixSort.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+namespace RaTests
+{
+    class RadixSortTest : public Test
+    {
+        void run() override
+        {
+            std::mt19937_64 gen( 42 );
+
+            // Random 64 bits keys, values are the original positions.
+            std::vector<uint64_t> keys( 10000 );
+            std::vector<uint> values( keys.size() );
+            for ( uint i = 0; i < keys.size(); ++i )
+            {
+                keys[i] = gen();
+                values[i] = i;
+            }
+            const std::vector<uint64_t> original = keys;
+
+            Ra::Core::radixSort( keys, values );
+
+            std::vector<uint64_t> expected = original;
+            std::sort( expected.begin(), expected.end() );
+            RA_UNIT_TEST( keys == expected, "Keys are not sorted." );
+
+            bool valuesOk = true;
+            for ( uint i = 0; i < keys.size(); ++i )
+            {
+                valuesOk = valuesOk && original[values[i]] == keys[i];
+            }
+            RA_UNIT_TEST( valuesOk, "Values do not follow their keys." );
+
+            // Few distinct keys with constant high bits : checks stability and skipped passes.
+            std::vector<uint64_t> smallKeys( 1000 );
+            std::vector<uint> smallValues( smallKeys.size() );
+            for ( uint i = 0; i < smallKeys.size(); ++i )
+            {
+                smallKeys[i] = ( uint64_t( 7 ) << 56 ) | ( gen() % 5 );
+                smallValues[i] = i;
+            }
+            Ra::Core::radixSort( smallKeys, smallValues );
+
+            bool stableOk = std::is_sorted( smallKeys.begin(), smallKeys.end() );
+            for ( uint i = 1; i < smallKeys.size(); ++i )
+            {
+                if ( smallKeys[i] == smallKeys[i - 1] )
+                {
+                    stableOk = stableOk && smallValues[i - 1] < smallValues[i];
+                }
+            }
+            RA_UNIT_TEST( stableOk, "Radix sort is not stable." );
+
+            // Large enough to be sorted by several blocks.
+            std::vector<uint32_t> largeKeys( 300000 );
+            std::vector<uint> largeValues( largeKeys.size() );
+            for ( uint i = 0; i < largeKeys.size(); ++i )
+            {
+                largeKeys[i] = uint32_t( gen() % 100000 );
+                largeValues[i] = i;
+            }
+            const std::vector<uint32_t> largeOriginal = largeKeys;
+            Ra::Core::radixSort( largeKeys, largeValues );
+
+            bool largeOk = std::is_sorted( largeKeys.begin(), largeKeys.end() );
+            for ( uint i = 0; i < largeKeys.size(); ++i )
+            {
+                largeOk = largeOk && largeOriginal[largeValues[i]] == largeKeys[i];
+                if ( i > 0 && largeKeys[i] == largeKeys[i - 1] )
+                {
+                    largeOk = largeOk && largeValues[i - 1] < largeValues[i];
+                }
+            }
+            RA_UNIT_TEST( largeOk, "Blocked radix sort." );
+
+            std::vector<uint32_t> empty;
+            std::vector<uint> emptyValues;
+            Ra::Core::radixSort( empty, emptyValues );
+            RA_UNIT_TEST( empty.empty(), "Sorting an empty vector failed." );
+        }
+    };
+
+    RA_TEST_CLASS( RadixSortTest );
+}
+
+#endif // RADIUM_RADIXSORT_TEST_HPP_
@@ -0,0 +1,117 @@
+#ifndef RADIUM_SLOTMAP_TEST_HPP_
+#define RADIUM_SLOTMAP_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Index/SlotMap.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace RaTests
+{
+    class SlotMapTest : public Test
+    {
+        typedef Ra::Core::Index Index;
+
+        void testBasics()
+        {
+            Ra::Core::SlotMap<int> map;
+            RA_UNIT_TEST( map.empty() && map.size() == 0 && !map.full(), "New map should be empty." );
+            RA_UNIT_TEST( !map.contains( Index( 0 ) ) && !map.contains( Index::Invalid() ), "Empty map contains nothing." );
+
+            const Index i1 = map.insert( 12 );
+            const Index i2 = map.insert( 42 );
+            const Index i3 = map.emplace( 7 );
+            RA_UNIT_TEST( i1.isValid() && i2.isValid() && i3.isValid(), "Insert." );
+            RA_UNIT_TEST( i1.getValue() == 0 && i2.getValue() == 1, "First indices are the slots." );
+            RA_UNIT_TEST( map.size() == 3 && map.at( i1 ) == 12 && map[i2] == 42 && map[i3] == 7, "Read." );
+
+            map.access( i1 ) = 24;
+            map[i2] = 84;
+            RA_UNIT_TEST( map.at( i1 ) == 24 && map.at( i2 ) == 84, "Write." );
+
+            // Removing the first object moves the last one in its place.
+            RA_UNIT_TEST( map.remove( i1 ), "Remove." );
+            RA_UNIT_TEST( !map.remove( i1 ), "Remove twice." );
+            RA_UNIT_TEST( !map.contains( i1 ) && map.contains( i2 ) && map.contains( i3 ), "Contains after remove." );
+            RA_UNIT_TEST( map.size() == 2 && map[i2] == 84 && map[i3] == 7, "Objects after remove." );
+            RA_UNIT_TEST( map.index( 0 ).getValue() == i3.getValue() && map.index( 1 ).getValue() == i2.getValue() &&
+                          map.index( 2 ).isInvalid(), "Storage order." );
+
+            // The slot is reused with a new generation : the old index stays invalid.
+            const Index i4 = map.insert( 5 );
+            RA_UNIT_TEST( i4.getValue() != i1.getValue() && ( i4.getValue() & 0xfffff ) == ( i1.getValue() & 0xfffff ),
+                          "Slot reuse." );
+            RA_UNIT_TEST( !map.contains( i1 ) && map.contains( i4 ) && map[i4] == 5, "Stale index." );
+            RA_UNIT_TEST( !map.remove( i1 ) && map.size() == 3, "Removing a stale index." );
+
+            int sum = 0;
+            for ( int v : map )
+            {
+                sum += v;
+            }
+            uint count = 0;
+            for ( auto it = map.cbegin_index(); it != map.cend_index(); ++it )
+            {
+                count += map.contains( *it ) ? 1 : 0;
+            }
+            RA_UNIT_TEST( sum == 84 + 7 + 5 && count == 3, "Iteration." );
+
+            map.clear();
+            RA_UNIT_TEST( map.empty() && !map.contains( i2 ) && !map.contains( i4 ), "Clear." );
+            const Index i5 = map.insert( 1 );
+            RA_UNIT_TEST( !map.contains( i2 ) && !map.contains( i3 ) && map.contains( i5 ), "Indices after clear." );
+        }
+
+        void testRandom()
+        {
+            // Random insertions and removals against a reference of the live objects.
+            Ra::Core::SlotMap<std::unique_ptr<int>> map;
+            std::vector<Index> live;
+            std::vector<int> values;
+            std::vector<Index> dead;
+            std::mt19937 gen( 3 );
+            bool ok = true;
+            for ( int k = 0; k < 20000; ++k )
+            {
+                if ( live.empty() || gen() % 3 != 0 )
+                {
+                    const Index idx = map.emplace( new int( k ) );
+                    live.push_back( idx );
+                    values.push_back( k );
+                }
+                else
+                {
+                    const uint i = gen() % live.size();
+                    ok = ok && map.remove( live[i] );
+                    dead.push_back( live[i] );
+                    live[i] = live.back();
+                    values[i] = values.back();
+                    live.pop_back();
+                    values.pop_back();
+                }
+            }
+            ok = ok && map.size() == live.size();
+            for ( uint i = 0; i < live.size(); ++i )
+            {
+                ok = ok && map.contains( live[i] ) && *map[live[i]] == values[i];
+            }
+            for ( const Index& idx : dead )
+            {
+                ok = ok && !map.contains( idx );
+            }
+            RA_UNIT_TEST( ok, "Random insertions and removals." );
+        }
+
+        void run() override
+        {
+            testBasics();
+            testRandom();
+        }
+    };
+
+    RA_TEST_CLASS( SlotMapTest );
+}
+
+#endif // RADIUM_SLOTMAP_TEST_HPP_
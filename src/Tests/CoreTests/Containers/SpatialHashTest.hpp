@@ -0,0 +1,87 @@
+#ifndef RADIUM_SPATIALHASH_TEST_HPP_
+#define RADIUM_SPATIALHASH_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Containers/SpatialHash.hpp>
+
+#include <random>
+
+namespace RaTests
+{
+    class SpatialHashTest : public Test
+    {
+        typedef Ra::Core::SpatialHash::Key<3> Key;
+        typedef Ra::Core::Vector3 Vector3;
+
+        void run() override
+        {
+            using namespace Ra::Core::SpatialHash;
+
+            RA_UNIT_TEST( makeKey( Vector3( 0, 1, 2 ), 0 ) == makeKey( Vector3( -0.0, 1, 2 ), 0 ),
+                          "Signed zeros have different keys." );
+            RA_UNIT_TEST( makeKey( Vector3( 0, 1, 2 ), 0 ) != makeKey( Vector3( 0, 2, 1 ), 0 ),
+                          "Swapped coordinates have the same key." );
+            RA_UNIT_TEST( makeKey( Vector3( 0, 1, 2 ), 0 ).hash() != makeKey( Vector3( 0, 2, 1 ), 0 ).hash(),
+                          "Swapped coordinates have the same hash." );
+            RA_UNIT_TEST( makeKey( Vector3( 0.101, 1.002, -2.05 ), 0.1 ) == makeKey( Vector3( 0.15, 1.05, -2.01 ), 0.1 ),
+                          "Points in the same cell have different keys." );
+            RA_UNIT_TEST( makeKey( Vector3( 0.09, 1, 2 ), 0.1 ) != makeKey( Vector3( 0.11, 1, 2 ), 0.1 ),
+                          "Points in different cells have the same key." );
+
+            // Random points on a coarse lattice, so that many of them are equal.
+            std::mt19937 gen( 42 );
+            std::uniform_int_distribution<int> coord( -8, 8 );
+            std::vector<Vector3> points( 20000 );
+            for ( auto& p : points )
+            {
+                p = Vector3( coord( gen ), coord( gen ), coord( gen ) ) * 0.25;
+            }
+
+            std::vector<Key> keys( points.size() );
+            for ( uint i = 0; i < points.size(); ++i )
+            {
+                keys[i] = makeKey( points[i], 0 );
+            }
+
+            std::vector<uint> reps;
+            const uint distinct = findRepresentatives( keys, reps );
+
+            // Reference : first occurrence of each point.
+            bool firstOk = true;
+            uint expectedDistinct = 0;
+            for ( uint i = 0; i < points.size(); ++i )
+            {
+                uint first = i;
+                for ( uint j = 0; j < i; ++j )
+                {
+                    if ( points[j] == points[i] )
+                    {
+                        first = j;
+                        break;
+                    }
+                }
+                firstOk = firstOk && reps[i] == first;
+                expectedDistinct += ( first == i ) ? 1 : 0;
+            }
+            RA_UNIT_TEST( firstOk, "Representatives are not the first occurrences." );
+            RA_UNIT_TEST( distinct == expectedDistinct, "Wrong number of distinct keys." );
+
+            // Small perturbations are merged with a tolerance.
+            std::uniform_real_distribution<Scalar> noise( 0.01, 0.02 );
+            for ( uint i = 0; i < points.size(); ++i )
+            {
+                keys[i] = makeKey( Vector3( points[i] + Vector3( noise( gen ), noise( gen ), noise( gen ) ) ), 0.1 );
+            }
+            std::vector<uint> tolReps;
+            RA_UNIT_TEST( findRepresentatives( keys, tolReps ) == distinct && tolReps == reps,
+                          "Tolerance does not merge close points." );
+
+            std::vector<Key> empty;
+            RA_UNIT_TEST( findRepresentatives( empty, reps ) == 0 && reps.empty(), "Empty input." );
+        }
+    };
+
+    RA_TEST_CLASS( SpatialHashTest );
+}
+
+#endif // RADIUM_SPATIALHASH_TEST_HPP_
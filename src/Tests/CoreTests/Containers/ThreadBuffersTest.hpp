@@ -0,0 +1,81 @@
+#ifndef RADIUM_THREADBUFFERS_TEST_HPP_
+#define RADIUM_THREADBUFFERS_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Containers/ThreadBuffers.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace RaTests
+{
+    class ThreadBuffersTest : public Test
+    {
+        void testLocal()
+        {
+            Ra::Core::ThreadBuffers<std::vector<int>> a;
+            Ra::Core::ThreadBuffers<std::vector<int>> b;
+            a.local().push_back( 1 );
+            b.local().push_back( 2 );
+            a.local().push_back( 3 );
+
+            RA_UNIT_TEST( &a.local() != &b.local(), "Instances have their own buffers." );
+            RA_UNIT_TEST( a.getBufferCount() == 1 && a.local() == std::vector<int>( { 1, 3 } ) &&
+                          b.local() == std::vector<int>( { 2 } ), "Buffer of the thread." );
+        }
+
+        void testThreads()
+        {
+            Ra::Core::ThreadBuffers<std::vector<int>> buffers;
+            Ra::Core::ThreadBuffers<std::vector<int>> other;
+            const int threadCount = 4;
+            const int valueCount = 10000;
+
+            // Each thread appends its values, alternating between the two instances.
+            std::vector<std::thread> threads;
+            for ( int t = 0; t < threadCount; ++t )
+            {
+                threads.emplace_back( [&buffers, &other, t, valueCount]() {
+                    for ( int i = 0; i < valueCount; ++i )
+                    {
+                        buffers.local().push_back( t * valueCount + i );
+                        other.local().push_back( -1 );
+                    }
+                } );
+            }
+            for ( auto& t : threads )
+            {
+                t.join();
+            }
+
+            std::vector<int> merged;
+            buffers.forEach( [&merged]( std::vector<int>& b ) {
+                merged.insert( merged.end(), b.begin(), b.end() );
+                b.clear();
+            } );
+            std::sort( merged.begin(), merged.end() );
+            std::vector<int> expected( threadCount * valueCount );
+            std::iota( expected.begin(), expected.end(), 0 );
+
+            RA_UNIT_TEST( buffers.getBufferCount() == threadCount && other.getBufferCount() == threadCount,
+                          "One buffer per thread." );
+            RA_UNIT_TEST( merged == expected, "Merged values of all the threads." );
+
+            uint remaining = 0;
+            buffers.forEach( [&remaining]( std::vector<int>& b ) { remaining += uint( b.size() ); } );
+            RA_UNIT_TEST( remaining == 0, "Buffers are cleared." );
+        }
+
+        void run() override
+        {
+            testLocal();
+            testThreads();
+        }
+    };
+
+    RA_TEST_CLASS( ThreadBuffersTest );
+}
+
+#endif // RADIUM_THREADBUFFERS_TEST_HPP_
@@ -0,0 +1,125 @@
+#ifndef RADIUM_BATCHDISTANCE_TEST_HPP_
+#define RADIUM_BATCHDISTANCE_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Geometry/Distance/DistanceQueries.hpp>
+#include <Core/Geometry/Distance/VertexDistance.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace RaTests
+{
+    class BatchDistanceTest : public Test
+    {
+        typedef Ra::Core::Vector3 Vector3;
+        typedef Ra::Core::Vector3Array Vector3Array;
+
+        static bool near( Scalar a, Scalar b ) { return std::abs( a - b ) <= 1e-4 * std::max( Scalar( 1 ), b ); }
+
+        void testPointsToTriangle()
+        {
+            std::mt19937 gen( 11 );
+            std::uniform_real_distribution<Scalar> dist( -2, 2 );
+            const Vector3 a( 0, 0, 0 );
+            const Vector3 b( 1, 0.2, 0 );
+            const Vector3 c( 0.3, 1, 0.5 );
+
+            // Points around the triangle hit all the zones. The size is not a multiple of the block size.
+            Vector3Array q;
+            for ( uint i = 0; i < 2000; ++i )
+            {
+                q.push_back( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+            }
+            q.push_back( a );
+            q.push_back( 0.5 * ( b + c ) );
+
+            std::vector<Scalar> distanceSquared;
+            Vector3Array meshPoints;
+            Ra::Core::DistanceQueries::pointsToTriSq( q, a, b, c, distanceSquared, &meshPoints );
+            RA_UNIT_TEST( distanceSquared.size() == q.size() && meshPoints.size() == q.size(), "Output sizes." );
+
+            bool ok = true;
+            uint hits[3] = {0, 0, 0};
+            for ( uint i = 0; i < q.size(); ++i )
+            {
+                const auto ref = Ra::Core::DistanceQueries::pointToTriSq( q[i], a, b, c );
+                ok = ok && near( distanceSquared[i], ref.distanceSquared ) &&
+                     ( meshPoints[i] - ref.meshPoint ).norm() < 1e-3;
+                ++hits[ref.getHitPrimitive()];
+            }
+            RA_UNIT_TEST( hits[0] > 0 && hits[1] > 0 && hits[2] > 0, "Faces, vertices and edges are tested." );
+            RA_UNIT_TEST( ok, "Batched distances match the scalar version." );
+        }
+
+        void testPointTrianglePairs()
+        {
+            const Ra::Core::TriangleMesh mesh = Ra::Core::MeshUtils::makeGeodesicSphere( 1, 2 );
+            std::mt19937 gen( 5 );
+            std::uniform_real_distribution<Scalar> dist( -1.5, 1.5 );
+            Vector3Array q;
+            std::vector<Ra::Core::TriangleIdx> triangles;
+            for ( uint i = 0; i < 1000; ++i )
+            {
+                q.push_back( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+                triangles.push_back( gen() % mesh.m_triangles.size() );
+            }
+
+            std::vector<Scalar> distanceSquared;
+            Ra::Core::DistanceQueries::pointsToTriSq( q, mesh, triangles, distanceSquared );
+            bool ok = distanceSquared.size() == q.size();
+            for ( uint i = 0; ok && i < q.size(); ++i )
+            {
+                const Ra::Core::Triangle& t = mesh.m_triangles[triangles[i]];
+                const auto ref = Ra::Core::DistanceQueries::pointToTriSq(
+                    q[i], mesh.m_vertices[t[0]], mesh.m_vertices[t[1]], mesh.m_vertices[t[2]] );
+                ok = near( distanceSquared[i], ref.distanceSquared );
+            }
+            RA_UNIT_TEST( ok, "Point-triangle pairs match the scalar version." );
+        }
+
+        void testVertexDistance()
+        {
+            std::mt19937 gen( 2 );
+            std::uniform_real_distribution<Scalar> dist( -1, 1 );
+            Vector3Array v0, v1;
+            for ( uint i = 0; i < 5000; ++i )
+            {
+                v0.push_back( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+                v1.push_back( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+            }
+
+            Scalar refMin = std::numeric_limits<Scalar>::max();
+            Scalar refMax = 0;
+            Scalar refSum = 0;
+            std::vector<Scalar> sqrDist;
+            Scalar sqrMin, sqrMax, sqrAvg;
+            Ra::Core::Geometry::vertexDistance( v0, v1, sqrDist, sqrMin, sqrMax, sqrAvg );
+            bool ok = sqrDist.size() == v0.size();
+            for ( uint i = 0; ok && i < v0.size(); ++i )
+            {
+                const Scalar d = ( v0[i] - v1[i] ).squaredNorm();
+                ok = near( sqrDist[i], d );
+                refMin = std::min( refMin, d );
+                refMax = std::max( refMax, d );
+                refSum += d;
+            }
+            RA_UNIT_TEST( ok, "Vertex distances." );
+            RA_UNIT_TEST( near( sqrMin, refMin ) && near( sqrMax, refMax ) && near( sqrAvg, ( refMin + refMax ) / 2 ),
+                          "Vertex distance bounds." );
+            RA_UNIT_TEST( near( Ra::Core::Geometry::vertexDistance( v0, v1 ), refSum / v0.size() ), "Mean distance." );
+        }
+
+        void run() override
+        {
+            testPointsToTriangle();
+            testPointTrianglePairs();
+            testVertexDistance();
+        }
+    };
+
+    RA_TEST_CLASS( BatchDistanceTest );
+}
+
+#endif // RADIUM_BATCHDISTANCE_TEST_HPP_
@@ -0,0 +1,45 @@
+#ifndef RADIUM_GEOMETRY_DATA_TEST_HPP_
+#define RADIUM_GEOMETRY_DATA_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/File/GeometryData.hpp>
+
+namespace RaTests
+{
+    class GeometryDataTest : public Test
+    {
+        typedef Ra::Asset::GeometryData GeometryData;
+
+        void run() override
+        {
+            GeometryData data;
+            const GeometryData::Vector3Array vertices( 4, Ra::Core::Vector3( 1, 2, 3 ) );
+            data.setVertices( vertices );
+            data.setNormals( vertices );
+            RA_UNIT_TEST( !data.isTransferable() && data.hasVertices() && data.getVerticesSize() == 4,
+                          "Geometry data is not transferable by default." );
+
+            data.setTransferable( true );
+            const GeometryData::Vector3Array taken = data.takeVertices();
+            RA_UNIT_TEST( taken == vertices, "Vertices are moved out." );
+            RA_UNIT_TEST( !data.hasVertices() && data.getVerticesSize() == 4,
+                          "Taken vertices are not available, their count is kept." );
+            RA_UNIT_TEST( data.hasNormals() && data.getNormals() == vertices, "Other attributes are kept." );
+
+            const GeometryData::Vector3Array other( 2, Ra::Core::Vector3( 0, 1, 0 ) );
+            data.setVertices( other );
+            RA_UNIT_TEST( data.hasVertices() && data.getVerticesSize() == 2 && data.getVertices() == other,
+                          "Vertices set again after a take." );
+
+            data.takeNormals();
+            data.takeVertices();
+            data.setVertices( GeometryData::Vector3Array() );
+            RA_UNIT_TEST( !data.hasNormals() && !data.hasVertices() && data.getVerticesSize() == 0,
+                          "Vertices set empty after a take." );
+        }
+    };
+
+    RA_TEST_CLASS( GeometryDataTest );
+}
+
+#endif // RADIUM_GEOMETRY_DATA_TEST_HPP_
@@ -0,0 +1,132 @@
+#ifndef RADIUM_PARTITION_TEST_HPP_
+#define RADIUM_PARTITION_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Geometry/Partition/Partition.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace RaTests
+{
+    class PartitionTest : public Test
+    {
+        typedef Ra::Core::TriangleMesh TriangleMesh;
+        typedef Ra::Core::Animation::WeightMatrix WeightMatrix;
+
+        // Per handle reference : segment vertices in order, then the other vertices of its triangles.
+        static TriangleMesh partitionReference( const TriangleMesh& mesh, const WeightMatrix& weight, uint n,
+                                                bool useMax )
+        {
+            const Ra::Core::MatrixN dense = Ra::Core::MatrixN( weight );
+            std::vector<uint> vertices;
+            std::vector<bool> inSegment( mesh.m_vertices.size(), false );
+            for ( uint i = 0; i < mesh.m_vertices.size(); ++i )
+            {
+                const Scalar w = dense( i, n );
+                if ( w != 0 && ( !useMax || w == dense.row( i ).maxCoeff() ) )
+                {
+                    vertices.push_back( i );
+                    inSegment[i] = true;
+                }
+            }
+
+            std::map<uint, uint> id;
+            for ( uint i = 0; i < vertices.size(); ++i )
+            {
+                id[vertices[i]] = i;
+            }
+            TriangleMesh part;
+            for ( const auto& t : mesh.m_triangles )
+            {
+                if ( inSegment[t[0]] || inSegment[t[1]] || inSegment[t[2]] )
+                {
+                    for ( uint j = 0; j < 3; ++j )
+                    {
+                        if ( id.find( t[j] ) == id.end() )
+                        {
+                            id[t[j]] = vertices.size();
+                            vertices.push_back( t[j] );
+                        }
+                    }
+                    part.m_triangles.push_back( Ra::Core::Triangle( id[t[0]], id[t[1]], id[t[2]] ) );
+                }
+            }
+            for ( uint v : vertices )
+            {
+                part.m_vertices.push_back( mesh.m_vertices[v] );
+                part.m_normals.push_back( mesh.m_normals[v] );
+            }
+            return part;
+        }
+
+        static bool equal( const TriangleMesh& a, const TriangleMesh& b )
+        {
+            return a.m_vertices.size() == b.m_vertices.size() && a.m_triangles.size() == b.m_triangles.size() &&
+                   std::equal( a.m_vertices.begin(), a.m_vertices.end(), b.m_vertices.begin() ) &&
+                   std::equal( a.m_normals.begin(), a.m_normals.end(), b.m_normals.begin() ) &&
+                   std::equal( a.m_triangles.begin(), a.m_triangles.end(), b.m_triangles.begin() );
+        }
+
+        void run() override
+        {
+            const TriangleMesh mesh = Ra::Core::MeshUtils::makePlaneGrid( 20, 20 );
+            const uint handles = 12;
+
+            // Up to 3 handles per vertex, with some ties.
+            std::mt19937 gen( 3 );
+            std::vector<Eigen::Triplet<Scalar>> triplets;
+            for ( uint i = 0; i < mesh.m_vertices.size(); ++i )
+            {
+                const uint first = gen() % handles;
+                const uint count = 1 + gen() % 3;
+                for ( uint k = 0; k < count; ++k )
+                {
+                    const Scalar w = ( gen() % 8 == 0 ) ? Scalar( 0.5 ) : Scalar( gen() % 100 ) / 100;
+                    triplets.push_back( Eigen::Triplet<Scalar>( i, ( first + 5 * k ) % handles, w ) );
+                }
+            }
+            WeightMatrix weight( mesh.m_vertices.size(), handles );
+            weight.setFromTriplets( triplets.begin(), triplets.end() );
+
+            for ( bool useMax : { true, false } )
+            {
+                const Ra::Core::Geometry::MeshPartition part = Ra::Core::Geometry::partition( mesh, weight, useMax );
+                bool ok = part.size() == handles;
+                uint covered = 0;
+                for ( uint n = 0; ok && n < handles; ++n )
+                {
+                    ok = equal( part[n], partitionReference( mesh, weight, n, useMax ) );
+                    covered += part[n].m_triangles.size();
+                }
+                RA_UNIT_TEST( ok, "Partition matches the reference." );
+                RA_UNIT_TEST( covered >= mesh.m_triangles.size(), "Every triangle is in a partition." );
+
+                // Segments keep the vertices where the handle has the largest weight of the vertex.
+                const Ra::Core::MatrixN dense = Ra::Core::MatrixN( weight );
+                bool segmentsOk = true;
+                for ( uint n = 0; n < handles; ++n )
+                {
+                    Ra::Core::Geometry::VertexSegment expected;
+                    for ( uint i = 0; i < mesh.m_vertices.size(); ++i )
+                    {
+                        const Scalar w = dense( i, n );
+                        if ( w != 0 && ( !useMax || w == dense.row( i ).maxCoeff() ) )
+                        {
+                            expected.push_back( i );
+                        }
+                    }
+                    segmentsOk = segmentsOk && Ra::Core::Geometry::extractVertexSegment( weight, n, useMax ) == expected;
+                }
+                RA_UNIT_TEST( segmentsOk, "Vertex segments match the partition." );
+            }
+        }
+    };
+
+    RA_TEST_CLASS( PartitionTest );
+}
+
+#endif // RADIUM_PARTITION_TEST_HPP_
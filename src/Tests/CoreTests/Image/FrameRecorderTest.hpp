@@ -0,0 +1,94 @@
+#ifndef RADIUM_FRAMERECORDER_TEST_HPP_
+#define RADIUM_FRAMERECORDER_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Image/FrameRecorder.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace RaTests
+{
+    class FrameRecorderTest : public Test
+    {
+        // Pixel (i, j) of frame f, j counted from the bottom row as in OpenGL.
+        static uint8_t value( uint f, uint i, uint j, uint c ) { return uint8_t( 16 * f + 4 * i + j + 64 * c ); }
+
+        void run() override
+        {
+            typedef Ra::Core::FrameRecorder FrameRecorder;
+            const char* filename = "FrameRecorderTest.raw";
+            const uint w = 8;
+            const uint h = 5;
+            const uint frameCount = 6;
+            // Recording starts partway through the run of the application.
+            const uint firstIndex = 100;
+            std::remove( filename );
+
+            FrameRecorder::Parameters params;
+            params.m_format = FrameRecorder::RAW;
+            params.m_path = filename;
+            params.m_workerCount = 3;
+            params.m_queueSize = 2;
+            params.m_rawFrameCapacity = 4;
+
+            FrameRecorder recorder;
+            RA_UNIT_TEST( recorder.start( params ), "Raw file is created." );
+
+            std::vector<uint8_t> pixels( w * h * 4 );
+            for ( uint f = 0; f < frameCount; ++f )
+            {
+                for ( uint j = 0; j < h; ++j )
+                {
+                    for ( uint i = 0; i < w; ++i )
+                    {
+                        for ( uint c = 0; c < 4; ++c )
+                        {
+                            pixels[4 * ( j * w + i ) + c] = value( f, i, j, c );
+                        }
+                    }
+                }
+                RA_UNIT_TEST( recorder.submit( pixels.data(), w, h, firstIndex + f ), "Blocking recorder does not drop frames." );
+            }
+            recorder.flush();
+            recorder.stop();
+
+            const FrameRecorder::Statistics stats = recorder.getStatistics();
+            RA_UNIT_TEST( stats.m_submitted == frameCount && stats.m_written == frameCount, "All frames are written." );
+            RA_UNIT_TEST( stats.m_bytes == frameCount * w * h * 4, "Written size." );
+
+            bool ok = true;
+            FrameRecorder::RawHeader header;
+            std::vector<uint8_t> read;
+            for ( uint f = 0; f < frameCount; ++f )
+            {
+                ok = ok && FrameRecorder::readRawFrame( filename, f, header, read );
+                ok = ok && header.m_width == w && header.m_height == h && header.m_channels == 4;
+                for ( uint j = 0; ok && j < h; ++j )
+                {
+                    for ( uint i = 0; i < w; ++i )
+                    {
+                        // The file starts with the top row, and alpha is opaque.
+                        const uint8_t* p = &read[4 * ( ( h - 1 - j ) * w + i )];
+                        ok = ok && p[0] == value( f, i, j, 0 ) && p[1] == value( f, i, j, 1 ) &&
+                             p[2] == value( f, i, j, 2 ) && p[3] == 0xff;
+                    }
+                }
+            }
+            RA_UNIT_TEST( ok, "Raw frames are flipped and stored from the first slot." );
+            RA_UNIT_TEST( header.m_frameCount == frameCount, "Header counts the frames written past the capacity." );
+            RA_UNIT_TEST( !FrameRecorder::readRawFrame( filename, frameCount, header, read ), "No frame past the end." );
+
+            FrameRecorder again;
+            RA_UNIT_TEST( !again.start( params ), "An existing raw file is not overwritten." );
+            RA_UNIT_TEST( FrameRecorder::readRawFrame( filename, 0, header, read ) && header.m_frameCount == frameCount,
+                          "The previous recording is kept." );
+
+            std::remove( filename );
+        }
+    };
+
+    RA_TEST_CLASS( FrameRecorderTest );
+}
+
+#endif // RADIUM_FRAMERECORDER_TEST_HPP_
@@ -0,0 +1,190 @@
+#ifndef RADIUM_TEXTURELOADER_TEST_HPP_
+#define RADIUM_TEXTURELOADER_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Image/TextureLoader.hpp>
+#include <Core/Image/stb_image_write.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace RaTests
+{
+    class TextureLoaderTest : public Test
+    {
+        // Texel (i, j) of a test image, j counted from the top row as in image files.
+        static uint8_t value( uint i, uint j, uint c ) { return uint8_t( 8 * i + 3 * j + 50 * c ); }
+
+        static void writeImage( const char* filename, uint w, uint h, uint n )
+        {
+            std::vector<uint8_t> pixels( w * h * n );
+            for ( uint j = 0; j < h; ++j )
+            {
+                for ( uint i = 0; i < w; ++i )
+                {
+                    for ( uint c = 0; c < n; ++c )
+                    {
+                        pixels[n * ( j * w + i ) + c] = value( i, j, c );
+                    }
+                }
+            }
+            stbi_write_png( filename, int( w ), int( h ), int( n ), pixels.data(), int( w * n ) );
+        }
+
+        void testMipmaps()
+        {
+            Ra::Core::MipmappedImage image;
+            image.m_width = 5;
+            image.m_height = 2;
+            image.m_channels = 2;
+            image.m_levels.resize( 1 );
+            for ( uint j = 0; j < 2; ++j )
+            {
+                for ( uint i = 0; i < 5; ++i )
+                {
+                    image.m_levels[0].push_back( uint8_t( 10 * i + j ) );
+                    image.m_levels[0].push_back( 200 );
+                }
+            }
+            image.buildMipmaps();
+
+            RA_UNIT_TEST( image.m_levels.size() == 3, "5x2 image has 3 levels." );
+            RA_UNIT_TEST( image.m_levels[1].size() == 2 * 1 * 2 && image.m_levels[2].size() == 2, "Level sizes." );
+            // Texel 0 of level 1 averages texels 0 and 1 of both rows : (0 + 10 + 1 + 11) / 4.
+            RA_UNIT_TEST( image.m_levels[1][0] == 6 && image.m_levels[1][1] == 200, "Box filter." );
+            // Texel 1 of level 1 averages texels 2 and 3 : (20 + 30 + 21 + 31) / 4, rounded.
+            RA_UNIT_TEST( image.m_levels[1][2] == 26, "Box filter rounding." );
+            RA_UNIT_TEST( image.m_levels[2][0] == 16 && image.m_levels[2][1] == 200, "Last level." );
+            RA_UNIT_TEST( image.getByteSize() == 20 + 4 + 2, "Byte size." );
+        }
+
+        void testLoader()
+        {
+            typedef Ra::Core::TextureLoader TextureLoader;
+            const char* file0 = "TextureLoaderTest0.png";
+            const char* file1 = "TextureLoaderTest1.png";
+            const uint w = 16;
+            const uint h = 8;
+            writeImage( file0, w, h, 3 );
+            writeImage( file1, w, h, 3 );
+
+            TextureLoader::Parameters params;
+            params.m_workerCount = 2;
+            params.m_cacheDirectory = ".";
+
+            const uint64_t hash = TextureLoader::hashContent( nullptr, 0 );
+            std::vector<uint8_t> content;
+            {
+                FILE* f = fopen( file0, "rb" );
+                int c;
+                while ( ( c = fgetc( f ) ) != EOF )
+                {
+                    content.push_back( uint8_t( c ) );
+                }
+                fclose( f );
+            }
+            const TextureLoader::ContentKey contentKey = TextureLoader::getContentKey( content.data(), content.size() );
+            RA_UNIT_TEST( contentKey.m_hash != hash, "Content hash." );
+            RA_UNIT_TEST( contentKey.m_hash != contentKey.m_check && contentKey.m_size == content.size(), "Content key." );
+            const std::string cacheFile = TextureLoader::getCacheFilename( params.m_cacheDirectory, contentKey.m_hash );
+            std::remove( cacheFile.c_str() );
+
+            TextureLoader loader;
+            loader.start( params );
+            loader.request( file0 );
+            loader.request( file0 );
+            loader.request( file1 );
+            loader.request( "TextureLoaderTestMissing.png" );
+            loader.waitLoaded();
+            RA_UNIT_TEST( loader.getPendingCount() == 3, "Requests of the same file are merged." );
+
+            std::vector<TextureLoader::LoadedImage> loaded;
+            RA_UNIT_TEST( loader.takeLoaded( 0, loaded ) == 1, "At least one image is taken." );
+            RA_UNIT_TEST( loader.takeLoaded( 0, loaded ) == 1, "Upload budget." );
+            loader.takeLoaded( 1 << 20, loaded );
+            RA_UNIT_TEST( loaded.size() == 3 && loader.getPendingCount() == 0, "All images are taken." );
+
+            TextureLoader::ImagePtr image;
+            uint failed = 0;
+            bool shared = true;
+            for ( const auto& l : loaded )
+            {
+                if ( !l.m_image )
+                {
+                    ++failed;
+                    continue;
+                }
+                shared = shared && ( !image || image == l.m_image );
+                image = l.m_image;
+            }
+            RA_UNIT_TEST( failed == 1, "Missing file fails." );
+            RA_UNIT_TEST( shared, "Files with the same content share their image." );
+
+            const TextureLoader::Statistics stats = loader.getStatistics();
+            RA_UNIT_TEST( stats.m_requested == 3 && stats.m_failed == 1, "Request statistics." );
+            RA_UNIT_TEST( stats.m_decoded + stats.m_cacheHits == 1 && stats.m_deduplicated == 1, "Decoded once." );
+            RA_UNIT_TEST( loader.getContentCount() == 1, "One content is remembered." );
+            loader.stop();
+            loader.releaseExpiredContents();
+            RA_UNIT_TEST( loader.getContentCount() == 1, "Contents in use are kept." );
+
+            RA_UNIT_TEST( image && image->m_width == w && image->m_height == h && image->m_channels == 3, "Image size." );
+            const std::size_t imageSize = ( 16 * 8 + 8 * 4 + 4 * 2 + 2 * 1 + 1 ) * 3;
+            RA_UNIT_TEST( image->m_levels.size() == 5 && image->getByteSize() == imageSize, "Mipmaps are built." );
+            bool ok = true;
+            for ( uint j = 0; j < h; ++j )
+            {
+                for ( uint i = 0; i < w; ++i )
+                {
+                    for ( uint c = 0; c < 3; ++c )
+                    {
+                        ok = ok && image->m_levels[0][3 * ( ( h - 1 - j ) * w + i ) + c] == value( i, j, c );
+                    }
+                }
+            }
+            RA_UNIT_TEST( ok, "Rows are stored bottom first." );
+
+            // Second load comes from the disk cache.
+            Ra::Core::MipmappedImage cached;
+            RA_UNIT_TEST( TextureLoader::readCache( cacheFile, contentKey, cached ), "Cache file is written." );
+            RA_UNIT_TEST( cached.m_levels == image->m_levels, "Cache round trip." );
+            TextureLoader::ContentKey otherKey = contentKey;
+            ++otherKey.m_size;
+            RA_UNIT_TEST( !TextureLoader::readCache( cacheFile, otherKey, cached ), "Cache checks the content size." );
+            otherKey = contentKey;
+            ++otherKey.m_check;
+            RA_UNIT_TEST( !TextureLoader::readCache( cacheFile, otherKey, cached ), "Cache checks the second hash." );
+
+            TextureLoader cacheLoader;
+            cacheLoader.start( params );
+            cacheLoader.request( file1 );
+            cacheLoader.waitLoaded();
+            loaded.clear();
+            cacheLoader.takeLoaded( 1 << 20, loaded );
+            RA_UNIT_TEST( cacheLoader.getStatistics().m_cacheHits == 1 && cacheLoader.getStatistics().m_decoded == 0,
+                          "Cache hit." );
+            RA_UNIT_TEST( loaded.size() == 1 && loaded[0].m_image && loaded[0].m_image->m_levels == image->m_levels,
+                          "Cached image." );
+            cacheLoader.stop();
+
+            image.reset();
+            loaded.clear();
+            loader.releaseExpiredContents();
+            RA_UNIT_TEST( loader.getContentCount() == 0, "Contents are forgotten once their images are released." );
+
+            std::remove( cacheFile.c_str() );
+            std::remove( file0 );
+            std::remove( file1 );
+        }
+
+        void run() override
+        {
+            testMipmaps();
+            testLoader();
+        }
+    };
+
+    RA_TEST_CLASS( TextureLoaderTest );
+}
+
+#endif // RADIUM_TEXTURELOADER_TEST_HPP_
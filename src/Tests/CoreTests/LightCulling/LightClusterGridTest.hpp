@@ -0,0 +1,147 @@
+#ifndef RADIUM_LIGHTCLUSTERGRID_TEST_HPP_
+#define RADIUM_LIGHTCLUSTERGRID_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Algorithm/LightCulling/LightClusterGrid.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace RaTests
+{
+    class LightClusterGridTest : public Test
+    {
+        typedef Ra::Core::Algorithm::LightClusterGrid LightClusterGrid;
+        typedef Ra::Core::Algorithm::LightSphere LightSphere;
+        typedef Ra::Core::Vector3 Vector3;
+
+        // Random view space point inside the frustum of grid.
+        Vector3 randomPoint( const LightClusterGrid& grid, Scalar tanHalfFov, Scalar aspect, std::mt19937& gen )
+        {
+            std::uniform_real_distribution<Scalar> unit( -0.999, 0.999 );
+            std::uniform_real_distribution<Scalar> depth( grid.getNear(), grid.getFar() );
+            const Scalar d = depth( gen );
+            return Vector3( unit( gen ) * d * tanHalfFov * aspect, unit( gen ) * d * tanHalfFov, -d );
+        }
+
+        bool hasLight( const LightClusterGrid& grid, uint cluster, uint light )
+        {
+            const auto& indices = grid.getLightIndices();
+            const auto begin = indices.begin() + grid.getOffsets()[cluster];
+            const auto end = indices.begin() + grid.getOffsets()[cluster + 1];
+            return std::binary_search( begin, end, light );
+        }
+
+        void run() override
+        {
+            const Scalar fovy = Ra::Core::Math::PiDiv2;
+            const Scalar aspect = 16.0 / 9.0;
+            const Scalar zNear = 0.1;
+            const Scalar zFar = 100.0;
+            const Scalar tanHalfFov = std::tan( fovy / 2 );
+
+            LightClusterGrid grid( 16, 9, 24 );
+            grid.setProjection( Ra::Core::MatrixUtils::perspective( fovy, aspect, zNear, zFar ) );
+
+            RA_UNIT_TEST( std::abs( grid.getNear() - zNear ) < 1e-4 && std::abs( grid.getFar() - zFar ) < 1e-2,
+                          "Wrong clipping planes." );
+
+            RA_UNIT_TEST( grid.getClusterCount() == 16 * 9 * 24, "Wrong cluster count." );
+            RA_UNIT_TEST( grid.getSlice( zNear ) == 0, "Near plane is not in the first slice." );
+            RA_UNIT_TEST( grid.getSlice( zFar * 0.999 ) == 23, "Far plane is not in the last slice." );
+            RA_UNIT_TEST( std::abs( grid.getSliceDepth( 24 ) - zFar ) < 1e-3, "Last slice does not end on the far plane." );
+
+            bool sliceOk = true;
+            for ( uint s = 0; s < 24; ++s )
+            {
+                const Scalar mid = ( grid.getSliceDepth( s ) + grid.getSliceDepth( s + 1 ) ) / 2;
+                sliceOk = sliceOk && grid.getSlice( mid ) == s;
+            }
+            RA_UNIT_TEST( sliceOk, "Slice lookup does not match slice depths." );
+
+            std::mt19937 gen( 42 );
+
+            // Points of the frustum are inside the bounds of the cluster they are looked up in.
+            bool boundsOk = true;
+            for ( uint i = 0; i < 1000; ++i )
+            {
+                const Vector3 p = randomPoint( grid, tanHalfFov, aspect, gen );
+                const Ra::Core::Aabb& aabb = grid.getClusterAabb( grid.getClusterIndex( p ) );
+                boundsOk = boundsOk && aabb.squaredExteriorDistance( p ) < 1e-6;
+            }
+            RA_UNIT_TEST( boundsOk, "Cluster bounds do not contain their points." );
+
+            // Random point lights, one directional light, one light behind the camera
+            // and one light out of the frustum.
+            Ra::Core::AlignedStdVector<LightSphere> lights;
+            std::uniform_real_distribution<Scalar> radius( 0.5, 10.0 );
+            for ( uint i = 0; i < 200; ++i )
+            {
+                LightSphere l;
+                l.m_center = randomPoint( grid, tanHalfFov, aspect, gen );
+                l.m_radius = radius( gen );
+                lights.push_back( l );
+            }
+            LightSphere dir;
+            dir.m_center = Vector3::Zero();
+            dir.m_radius = -1;
+            lights.push_back( dir );
+
+            LightSphere behind;
+            behind.m_center = Vector3( 0, 0, 5 );
+            behind.m_radius = 1;
+            lights.push_back( behind );
+
+            LightSphere outside;
+            outside.m_center = Vector3( 50, 0, -10 );
+            outside.m_radius = 1;
+            lights.push_back( outside );
+
+            grid.assignLights( lights );
+
+            const auto& offsets = grid.getOffsets();
+            RA_UNIT_TEST( offsets.size() == grid.getClusterCount() + 1, "Wrong offsets size." );
+            RA_UNIT_TEST( std::is_sorted( offsets.begin(), offsets.end() ), "Offsets are not increasing." );
+            RA_UNIT_TEST( offsets.back() == grid.getLightIndices().size(), "Offsets do not match light indices." );
+
+            bool sortedOk = true;
+            bool dirOk = true;
+            bool culledOk = true;
+            for ( uint c = 0; c < grid.getClusterCount(); ++c )
+            {
+                const auto begin = grid.getLightIndices().begin() + offsets[c];
+                const auto end = grid.getLightIndices().begin() + offsets[c + 1];
+                sortedOk = sortedOk && std::is_sorted( begin, end );
+                dirOk = dirOk && hasLight( grid, c, 200 );
+                culledOk = culledOk && !hasLight( grid, c, 201 ) && !hasLight( grid, c, 202 );
+            }
+            RA_UNIT_TEST( sortedOk, "Cluster lights are not sorted." );
+            RA_UNIT_TEST( dirOk, "Directional light missing from a cluster." );
+            RA_UNIT_TEST( culledOk, "Light out of the frustum assigned to a cluster." );
+
+            // Culling is conservative : every point lit by a light lies in a cluster referencing it.
+            bool conservativeOk = true;
+            for ( uint i = 0; i < 20000; ++i )
+            {
+                const Vector3 p = randomPoint( grid, tanHalfFov, aspect, gen );
+                const uint c = grid.getClusterIndex( p );
+                for ( uint l = 0; l < 200; ++l )
+                {
+                    if ( ( p - lights[l].m_center ).norm() < lights[l].m_radius && !hasLight( grid, c, l ) )
+                    {
+                        conservativeOk = false;
+                    }
+                }
+            }
+            RA_UNIT_TEST( conservativeOk, "Light missing from a cluster it reaches." );
+
+            // Culling is effective : small lights do not end up everywhere.
+            RA_UNIT_TEST( grid.getLightIndices().size() < ( lights.size() * grid.getClusterCount() ) / 4,
+                          "Lights are not culled." );
+        }
+    };
+
+    RA_TEST_CLASS( LightClusterGridTest );
+}
+
+#endif // RADIUM_LIGHTCLUSTERGRID_TEST_HPP_
@@ -0,0 +1,174 @@
+#ifndef RADIUM_ASYNCLOG_TEST_HPP_
+#define RADIUM_ASYNCLOG_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Log/Log.hpp>
+#include <Core/Log/AsyncLog.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RaTests
+{
+    /// Logs while it is written in another message.
+    struct NestedLog {};
+    inline std::ostream& operator<<( std::ostream& os, const NestedLog& )
+    {
+        LOG( logINFO ) << "inner message";
+        return os << "nested";
+    }
+
+    class AsyncLogTest : public Test
+    {
+        void run() override
+        {
+            FILE* previous = Output2FILE::Stream();
+            FILE* file = tmpfile();
+            if ( file == nullptr )
+            {
+                return;
+            }
+            Output2FILE::Stream() = file;
+
+            // Small rings, so that producers have to wait for the writer.
+            Ra::Core::AsyncLog::Parameters params;
+            params.m_ringSize = 16;
+            params.m_policy = Ra::Core::AsyncLog::BLOCK_PRODUCER;
+            Ra::Core::AsyncLog::start( params );
+
+            const uint threadCount = 4;
+            const uint messageCount = 1000;
+            std::vector<std::thread> threads;
+            for ( uint t = 0; t < threadCount; ++t )
+            {
+                threads.emplace_back( [t]()
+                {
+                    for ( uint i = 0; i < messageCount; ++i )
+                    {
+                        LOG( logINFO ) << "thread " << t << " message " << i;
+                    }
+                } );
+            }
+            for ( auto& t : threads )
+            {
+                t.join();
+            }
+
+            // Longer than a record.
+            const std::string longMessage( 1000, 'x' );
+            LOG( logINFO ) << longMessage;
+
+            // Written synchronously, as the records of the outer message are not published yet.
+            LOG( logINFO ) << "outer " << NestedLog() << " message";
+
+            Ra::Core::AsyncLog::flush();
+            const auto stats = Ra::Core::AsyncLog::getStatistics();
+            RA_UNIT_TEST( stats.m_written == threadCount * messageCount + 2, "All messages are written after flush." );
+            RA_UNIT_TEST( stats.m_dropped == 0, "Blocking producers do not drop messages." );
+            RA_UNIT_TEST( stats.m_rings == 1, "Rings of the exited threads are released." );
+            Ra::Core::AsyncLog::stop();
+            RA_UNIT_TEST( !Ra::Core::AsyncLog::isRunning(), "Log is stopped." );
+
+            // Each line is complete, and the messages of a thread are in order.
+            rewind( file );
+            std::vector<int> next( threadCount, 0 );
+            bool ordered = true;
+            bool longFound = false;
+            bool outerFound = false;
+            bool innerFound = false;
+            uint lines = 0;
+            std::string line;
+            for ( int c = fgetc( file ); c != EOF; c = fgetc( file ) )
+            {
+                if ( c != '\n' )
+                {
+                    line += char( c );
+                    continue;
+                }
+                ++lines;
+                uint t, i;
+                const size_t pos = line.find( "INFO: " );
+                if ( pos != std::string::npos && sscanf( line.c_str() + pos, "INFO: thread %u message %u", &t, &i ) == 2 )
+                {
+                    ordered = ordered && t < threadCount && int( i ) == next[t];
+                    if ( t < threadCount )
+                    {
+                        next[t] = int( i ) + 1;
+                    }
+                }
+                longFound = longFound || line.find( longMessage ) != std::string::npos;
+                outerFound = outerFound || line.find( "INFO: outer nested message" ) != std::string::npos;
+                innerFound = innerFound || line.find( "INFO: inner message" ) != std::string::npos;
+                line.clear();
+            }
+            RA_UNIT_TEST( lines == threadCount * messageCount + 3, "One line per message." );
+            RA_UNIT_TEST( ordered, "Messages of each thread are in order." );
+            RA_UNIT_TEST( longFound, "Long messages span several records." );
+            RA_UNIT_TEST( outerFound && innerFound, "Messages logged while formatting another one are kept whole." );
+
+            // Dropping producers never wait.
+            params.m_ringSize = 4;
+            params.m_policy = Ra::Core::AsyncLog::DROP_MESSAGES;
+            params.m_flushIntervalMs = 1000;
+            Ra::Core::AsyncLog::start( params );
+            for ( uint i = 0; i < 100; ++i )
+            {
+                LOG( logINFO ) << "message " << i;
+            }
+            Ra::Core::AsyncLog::flush();
+            const auto dropStats = Ra::Core::AsyncLog::getStatistics();
+            RA_UNIT_TEST( dropStats.m_written + dropStats.m_dropped == 100, "Messages are either written or dropped." );
+            RA_UNIT_TEST( dropStats.m_dropped > 0, "Full rings drop messages." );
+            Ra::Core::AsyncLog::stop();
+
+            // Stopping while other threads are logging : each message is written once,
+            // asynchronously or, after the stop, synchronously.
+            FILE* stopFile = tmpfile();
+            if ( stopFile != nullptr )
+            {
+                Output2FILE::Stream() = stopFile;
+                params.m_ringSize = 16;
+                params.m_policy = Ra::Core::AsyncLog::BLOCK_PRODUCER;
+                params.m_flushIntervalMs = 1;
+                Ra::Core::AsyncLog::start( params );
+
+                threads.clear();
+                for ( uint t = 0; t < threadCount; ++t )
+                {
+                    threads.emplace_back( []()
+                    {
+                        for ( uint i = 0; i < messageCount; ++i )
+                        {
+                            LOG( logINFO ) << "message " << i;
+                        }
+                    } );
+                }
+                std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+                Ra::Core::AsyncLog::stop();
+                for ( auto& t : threads )
+                {
+                    t.join();
+                }
+
+                rewind( stopFile );
+                uint stopLines = 0;
+                for ( int c = fgetc( stopFile ); c != EOF; c = fgetc( stopFile ) )
+                {
+                    stopLines += ( c == '\n' ) ? 1 : 0;
+                }
+                RA_UNIT_TEST( stopLines == threadCount * messageCount, "No message is lost when stopping." );
+                fclose( stopFile );
+            }
+
+            Output2FILE::Stream() = previous;
+            fclose( file );
+        }
+    };
+
+    RA_TEST_CLASS( AsyncLogTest );
+}
+
+#endif // RADIUM_ASYNCLOG_TEST_HPP_
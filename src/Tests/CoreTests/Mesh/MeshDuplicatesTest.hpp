@@ -0,0 +1,124 @@
+#ifndef RADIUM_MESHDUPLICATES_TEST_HPP_
+#define RADIUM_MESHDUPLICATES_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <random>
+
+namespace RaTests
+{
+    class MeshDuplicatesTest : public Test
+    {
+        typedef Ra::Core::Vector3 Vector3;
+        typedef Ra::Core::VertexIdx VertexIdx;
+
+        void testExact()
+        {
+            // Random points on a coarse lattice, so that many of them are equal.
+            std::mt19937 gen( 7 );
+            std::uniform_int_distribution<int> coord( -4, 4 );
+            Ra::Core::TriangleMesh mesh;
+            for ( uint i = 0; i < 5000; ++i )
+            {
+                mesh.m_vertices.push_back( Vector3( coord( gen ), coord( gen ), coord( gen ) ) * 0.5 );
+                mesh.m_normals.push_back( Vector3( 0, 0, i ) );
+            }
+            mesh.m_vertices[1] = Vector3( -0.0, 0, 0 );
+            mesh.m_vertices[2] = Vector3( 0, 0, 0 );
+            for ( uint i = 0; i + 2 < 5000; i += 3 )
+            {
+                mesh.m_triangles.push_back( Ra::Core::Triangle( i, i + 1, i + 2 ) );
+            }
+
+            std::vector<VertexIdx> duplicates;
+            RA_UNIT_TEST( Ra::Core::MeshUtils::findDuplicates( mesh, duplicates ), "Duplicates are found." );
+
+            // Reference : first occurrence of each position.
+            bool ok = duplicates.size() == mesh.m_vertices.size();
+            uint distinct = 0;
+            for ( uint i = 0; ok && i < mesh.m_vertices.size(); ++i )
+            {
+                uint first = i;
+                for ( uint j = 0; j < i; ++j )
+                {
+                    if ( mesh.m_vertices[j] == mesh.m_vertices[i] )
+                    {
+                        first = j;
+                        break;
+                    }
+                }
+                ok = ok && int( duplicates[i] ) == int( first );
+                distinct += ( first == i ) ? 1 : 0;
+            }
+            RA_UNIT_TEST( ok, "Duplicates map to their first occurrence." );
+            RA_UNIT_TEST( int( duplicates[2] ) == 1, "Signed zeros are equal." );
+
+            Ra::Core::TriangleMesh merged = mesh;
+            std::vector<VertexIdx> vertexMap;
+            Ra::Core::MeshUtils::removeDuplicates( merged, vertexMap );
+            RA_UNIT_TEST( merged.m_vertices.size() == distinct && merged.m_normals.size() == distinct,
+                          "Duplicates are removed." );
+
+            bool mapOk = vertexMap.size() == mesh.m_vertices.size();
+            uint next = 0;
+            for ( uint i = 0; mapOk && i < mesh.m_vertices.size(); ++i )
+            {
+                mapOk = merged.m_vertices[vertexMap[i]] == mesh.m_vertices[i];
+                if ( int( duplicates[i] ) == int( i ) )
+                {
+                    // Kept vertices are in their original order, with their own normal.
+                    mapOk = mapOk && int( vertexMap[i] ) == int( next ) && merged.m_normals[next] == mesh.m_normals[i];
+                    ++next;
+                }
+            }
+            RA_UNIT_TEST( mapOk, "Vertex map." );
+
+            bool trianglesOk = merged.m_triangles.size() == mesh.m_triangles.size();
+            for ( uint t = 0; trianglesOk && t < mesh.m_triangles.size(); ++t )
+            {
+                for ( uint j = 0; j < 3; ++j )
+                {
+                    trianglesOk = trianglesOk && merged.m_vertices[merged.m_triangles[t]( j )] ==
+                                                     mesh.m_vertices[mesh.m_triangles[t]( j )];
+                }
+            }
+            RA_UNIT_TEST( trianglesOk, "Triangles are remapped." );
+            RA_UNIT_TEST( merged.getIncidence()->getVertexCount() == distinct, "Incidence is updated." );
+        }
+
+        void testTolerance()
+        {
+            Ra::Core::TriangleMesh mesh;
+            mesh.m_vertices.push_back( Vector3( 0.101, 1.002, -2.05 ) );
+            mesh.m_vertices.push_back( Vector3( 0.15, 1.05, -2.01 ) );
+            mesh.m_vertices.push_back( Vector3( 0.25, 1.05, -2.01 ) );
+            mesh.m_triangles.push_back( Ra::Core::Triangle( 0, 1, 2 ) );
+
+            std::vector<VertexIdx> duplicates;
+            RA_UNIT_TEST( !Ra::Core::MeshUtils::findDuplicates( mesh, duplicates ), "Close vertices are not equal." );
+            RA_UNIT_TEST( Ra::Core::MeshUtils::findDuplicates( mesh, duplicates, 0.1 ), "Close vertices are merged." );
+            RA_UNIT_TEST( int( duplicates[1] ) == 0 && int( duplicates[2] ) == 2, "Tolerance cells." );
+
+            // The faces of a sharp box share their corners.
+            Ra::Core::TriangleMesh box = Ra::Core::MeshUtils::makeSharpBox();
+            std::vector<VertexIdx> vertexMap;
+            Ra::Core::MeshUtils::removeDuplicates( box, vertexMap, 1e-3 );
+            RA_UNIT_TEST( box.m_vertices.size() == 8 && box.m_triangles.size() == 12, "Sharp box corners are merged." );
+
+            Ra::Core::TriangleMesh empty;
+            RA_UNIT_TEST( !Ra::Core::MeshUtils::findDuplicates( empty, duplicates ) && duplicates.empty(), "Empty mesh." );
+        }
+
+        void run() override
+        {
+            testExact();
+            testTolerance();
+        }
+    };
+
+    RA_TEST_CLASS( MeshDuplicatesTest );
+}
+
+#endif // RADIUM_MESHDUPLICATES_TEST_HPP_
@@ -0,0 +1,158 @@
+#ifndef RADIUM_MESHINCIDENCE_TEST_HPP_
+#define RADIUM_MESHINCIDENCE_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Geometry/Adjacency/Adjacency.hpp>
+#include <Core/Geometry/Normal/Normal.hpp>
+
+#include <set>
+#include <vector>
+
+namespace RaTests
+{
+    class MeshIncidenceTest : public Test
+    {
+        typedef Ra::Core::MeshIncidence MeshIncidence;
+
+        static std::vector<uint> toVector( const MeshIncidence::Range& range )
+        {
+            return std::vector<uint>( range.begin(), range.end() );
+        }
+
+        // Compare the incidence of a mesh to a scan of all its triangles.
+        static bool checkBruteForce( const Ra::Core::TriangleMesh& mesh, const MeshIncidence& incidence )
+        {
+            const auto& T = mesh.m_triangles;
+            for ( uint v = 0; v < mesh.m_vertices.size(); ++v )
+            {
+                std::vector<uint> triangles;
+                std::set<uint> neighbors;
+                for ( uint t = 0; t < T.size(); ++t )
+                {
+                    for ( uint k = 0; k < 3; ++k )
+                    {
+                        if ( uint( T[t]( k ) ) == v )
+                        {
+                            triangles.push_back( t );
+                            neighbors.insert( T[t]( ( k + 1 ) % 3 ) );
+                            neighbors.insert( T[t]( ( k + 2 ) % 3 ) );
+                        }
+                    }
+                }
+                if ( toVector( incidence.getVertexTriangles( v ) ) != triangles ||
+                     toVector( incidence.getVertexNeighbors( v ) ) != std::vector<uint>( neighbors.begin(), neighbors.end() ) )
+                {
+                    return false;
+                }
+            }
+            for ( uint t = 0; t < T.size(); ++t )
+            {
+                std::vector<uint> neighbors;
+                for ( uint s = 0; s < T.size(); ++s )
+                {
+                    uint shared = 0;
+                    for ( uint i = 0; i < 3; ++i )
+                    {
+                        for ( uint j = 0; j < 3; ++j )
+                        {
+                            shared += ( T[t]( i ) == T[s]( j ) ) ? 1 : 0;
+                        }
+                    }
+                    if ( s != t && shared >= 2 )
+                    {
+                        neighbors.push_back( s );
+                    }
+                }
+                if ( toVector( incidence.getTriangleNeighbors( t ) ) != neighbors )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void testSquare()
+        {
+            // A square made of four triangles around its center (vertex 4), and an isolated vertex.
+            Ra::Core::TriangleMesh mesh;
+            mesh.m_vertices.push_back( Ra::Core::Vector3( 0, 0, 0 ) );
+            mesh.m_vertices.push_back( Ra::Core::Vector3( 1, 0, 0 ) );
+            mesh.m_vertices.push_back( Ra::Core::Vector3( 1, 1, 0 ) );
+            mesh.m_vertices.push_back( Ra::Core::Vector3( 0, 1, 0 ) );
+            mesh.m_vertices.push_back( Ra::Core::Vector3( 0.5, 0.5, 0 ) );
+            mesh.m_vertices.push_back( Ra::Core::Vector3( 2, 2, 2 ) );
+            mesh.m_triangles.push_back( Ra::Core::Triangle( 0, 1, 4 ) );
+            mesh.m_triangles.push_back( Ra::Core::Triangle( 1, 2, 4 ) );
+            mesh.m_triangles.push_back( Ra::Core::Triangle( 2, 3, 4 ) );
+            mesh.m_triangles.push_back( Ra::Core::Triangle( 3, 0, 4 ) );
+
+            const auto incidencePtr = mesh.getIncidence();
+            const MeshIncidence& incidence = *incidencePtr;
+            RA_UNIT_TEST( incidence.getVertexCount() == 6 && incidence.getTriangleCount() == 4, "Incidence size." );
+            RA_UNIT_TEST( toVector( incidence.getVertexTriangles( 4 ) ) == std::vector<uint>( { 0, 1, 2, 3 } ),
+                          "Triangles around the center." );
+            RA_UNIT_TEST( toVector( incidence.getVertexTriangles( 0 ) ) == std::vector<uint>( { 0, 3 } ),
+                          "Triangles around a corner." );
+            RA_UNIT_TEST( toVector( incidence.getVertexNeighbors( 0 ) ) == std::vector<uint>( { 1, 3, 4 } ),
+                          "Neighbors of a corner." );
+            RA_UNIT_TEST( toVector( incidence.getTriangleNeighbors( 0 ) ) == std::vector<uint>( { 1, 3 } ),
+                          "Triangles around a triangle." );
+            RA_UNIT_TEST( incidence.getVertexTriangles( 5 ).empty() && incidence.getVertexNeighbors( 5 ).empty(),
+                          "Isolated vertex." );
+            RA_UNIT_TEST( mesh.getIncidence() == incidencePtr, "Incidence is cached." );
+
+            // Appending a mesh changes the topology.
+            Ra::Core::TriangleMesh other = mesh;
+            RA_UNIT_TEST( other.getIncidence() == incidencePtr, "Copies share the incidence." );
+            mesh.append( other );
+            const auto appendedPtr = mesh.getIncidence();
+            const MeshIncidence& appended = *appendedPtr;
+            RA_UNIT_TEST( appended.getVertexCount() == 12 && appended.getTriangleCount() == 8, "Incidence is rebuilt." );
+            RA_UNIT_TEST( toVector( appended.getVertexTriangles( 10 ) ) == std::vector<uint>( { 4, 5, 6, 7 } ),
+                          "Incidence of the appended triangles." );
+            RA_UNIT_TEST( checkBruteForce( mesh, appended ), "Appended mesh incidence." );
+            RA_UNIT_TEST( incidence.getVertexCount() == 6, "Previous incidence stays alive while it is used." );
+
+            // Triangles written in place need an explicit invalidation.
+            mesh.m_triangles[0] = Ra::Core::Triangle( 0, 1, 5 );
+            mesh.invalidateTopology();
+            RA_UNIT_TEST( checkBruteForce( mesh, *mesh.getIncidence() ), "Incidence is rebuilt after invalidation." );
+
+            mesh.clear();
+            RA_UNIT_TEST( mesh.getIncidence()->getVertexCount() == 0 && mesh.getIncidence()->getTriangleCount() == 0,
+                          "Incidence of an empty mesh." );
+        }
+
+        void testBox()
+        {
+            Ra::Core::TriangleMesh mesh = Ra::Core::MeshUtils::makeBox( Ra::Core::Vector3( 1, 2, 3 ) );
+            // Move one corner so that the normals are not all axis aligned.
+            mesh.m_vertices[0] += Ra::Core::Vector3( 0.3, -0.2, 0.1 );
+            const auto incidencePtr = mesh.getIncidence();
+            const MeshIncidence& incidence = *incidencePtr;
+            RA_UNIT_TEST( checkBruteForce( mesh, incidence ), "Box incidence." );
+
+            const Ra::Core::Geometry::TVAdj adj = Ra::Core::Geometry::triangleUniformAdjacency( mesh.m_vertices, mesh.m_triangles );
+            bool ok = true;
+            for ( uint i = 0; i < mesh.m_vertices.size(); ++i )
+            {
+                const Ra::Core::Vector3 n0 = Ra::Core::Geometry::localUniformNormal( i, mesh.m_vertices, mesh.m_triangles, adj );
+                const Ra::Core::Vector3 n1 = Ra::Core::Geometry::localUniformNormal( i, mesh.m_vertices, mesh.m_triangles, incidence );
+                ok = ok && n0.isApprox( n1 );
+            }
+            RA_UNIT_TEST( ok, "Normals from the incidence." );
+        }
+
+        void run() override
+        {
+            testSquare();
+            testBox();
+        }
+    };
+
+    RA_TEST_CLASS( MeshIncidenceTest );
+}
+
+#endif // RADIUM_MESHINCIDENCE_TEST_HPP_
@@ -0,0 +1,78 @@
+#ifndef RADIUM_PROGRESSIVEMESH_TEST_HPP_
+#define RADIUM_PROGRESSIVEMESH_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Mesh/ProgressiveMesh.hpp>
+
+namespace RaTests
+{
+    class ProgressiveMeshTest : public Test
+    {
+        typedef Ra::Core::Vector3 Vector3;
+        typedef Ra::Core::Triangle Triangle;
+
+        void run() override
+        {
+            // A square made of four triangles around its center (vertex 4).
+            Ra::Core::TriangleMesh mesh;
+            mesh.m_vertices.push_back( Vector3( 0, 0, 0 ) );
+            mesh.m_vertices.push_back( Vector3( 1, 0, 0 ) );
+            mesh.m_vertices.push_back( Vector3( 1, 1, 0 ) );
+            mesh.m_vertices.push_back( Vector3( 0, 1, 0 ) );
+            mesh.m_vertices.push_back( Vector3( 0.5, 0.5, 0 ) );
+            mesh.m_triangles.push_back( Triangle( 0, 1, 4 ) );
+            mesh.m_triangles.push_back( Triangle( 1, 2, 4 ) );
+            mesh.m_triangles.push_back( Triangle( 2, 3, 4 ) );
+            mesh.m_triangles.push_back( Triangle( 3, 0, 4 ) );
+
+            Ra::Core::ProgressiveMesh pm( mesh );
+            RA_UNIT_TEST( pm.getFaceCount() == 4 && pm.getCollapseCount() == 0, "Wrong initial state." );
+
+            // Collapse the center into vertex 0, then vertex 2 into vertex 1.
+            pm.addCollapse( 4, 0, Vector3( 0.1, 0.1, 0 ), 0, { 0, 3 }, { 1, 2 } );
+            RA_UNIT_TEST( pm.getFaceCount() == 2 && pm.getLevel() == 1, "Wrong state after a collapse." );
+            RA_UNIT_TEST( pm.getTriangles()[1] == Triangle( 1, 2, 0 ) && pm.getTriangles()[2] == Triangle( 2, 3, 0 ),
+                          "Corners were not moved." );
+
+            pm.addCollapse( 2, 1, Vector3( 1, 0.5, 0 ), 1, { 1 }, { 2 } );
+            RA_UNIT_TEST( pm.getFaceCount() == 1 && pm.getVertexCount() == 3, "Wrong state after two collapses." );
+
+            Ra::Core::TriangleMesh coarse;
+            std::vector<uint> vertexMap;
+            pm.getMesh( coarse, &vertexMap );
+            RA_UNIT_TEST( coarse.m_triangles.size() == 1 && coarse.m_vertices.size() == 3, "Wrong coarse mesh." );
+            RA_UNIT_TEST( vertexMap == std::vector<uint>( { 0, 1, 3 } ), "Wrong vertex map." );
+            RA_UNIT_TEST( coarse.m_triangles[0] == Triangle( 1, 2, 0 ), "Wrong coarse triangle." );
+            RA_UNIT_TEST( coarse.m_vertices[0].isApprox( Vector3( 0.1, 0.1, 0 ) ) &&
+                          coarse.m_vertices[1].isApprox( Vector3( 1, 0.5, 0 ) ),
+                          "Wrong coarse positions." );
+            RA_UNIT_TEST( coarse.m_normals.size() == 3, "Missing normals." );
+
+            // Refining goes back to the original mesh.
+            pm.refine( 1 );
+            RA_UNIT_TEST( pm.getFaceCount() == 2 && pm.getTriangles()[2] == Triangle( 2, 3, 0 ), "Wrong vertex split." );
+            pm.setLevel( 0 );
+            bool sameOk = pm.getFaceCount() == 4;
+            for ( uint i = 0; i < 4; ++i )
+            {
+                sameOk = sameOk && pm.getTriangles()[i] == mesh.m_triangles[i] && pm.isFaceActive( i );
+            }
+            for ( uint i = 0; i < 5; ++i )
+            {
+                sameOk = sameOk && pm.getPositions()[i] == mesh.m_vertices[i];
+            }
+            RA_UNIT_TEST( sameOk, "Refined mesh differs from the original one." );
+
+            pm.setFaceCount( 3 );
+            RA_UNIT_TEST( pm.getLevel() == 1, "Wrong level for a face count." );
+            pm.setFaceCount( 0 );
+            RA_UNIT_TEST( pm.getLevel() == 2, "Face count below the coarsest level." );
+            pm.setFaceCount( 100 );
+            RA_UNIT_TEST( pm.getLevel() == 0, "Face count above the full resolution." );
+        }
+    };
+
+    RA_TEST_CLASS( ProgressiveMeshTest );
+}
+
+#endif // RADIUM_PROGRESSIVEMESH_TEST_HPP_
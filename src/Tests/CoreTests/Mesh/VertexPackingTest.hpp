@@ -0,0 +1,183 @@
+#ifndef RADIUM_VERTEXPACKING_TEST_HPP_
+#define RADIUM_VERTEXPACKING_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Mesh/VertexPacking.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace RaTests
+{
+    class VertexPackingTest : public Test
+    {
+        typedef Ra::Core::Vector3 Vector3;
+        typedef Ra::Core::Aabb Aabb;
+
+        void testPositions()
+        {
+            std::mt19937 gen( 7 );
+            std::uniform_real_distribution<Scalar> dist( -1, 1 );
+            const Aabb box( Vector3( -3, 0.5, 100 ), Vector3( 5, 0.75, 100 ) );
+            const Scalar error = Ra::Core::VertexPacking::getPositionError( box );
+
+            Ra::Core::Vector3Array points;
+            points.push_back( box.min() );
+            points.push_back( box.max() );
+            for ( uint i = 0; i < 10000; ++i )
+            {
+                const Vector3 t( dist( gen ), dist( gen ), dist( gen ) );
+                points.push_back( box.center() + 0.5 * t.cwiseProduct( box.sizes() ) );
+            }
+
+            std::vector<Ra::Core::VertexPacking::Position16> packed;
+            Ra::Core::VertexPacking::packPositions( points, box, packed );
+            bool ok = packed.size() == points.size();
+            Scalar maxError = 0;
+            for ( uint i = 0; ok && i < points.size(); ++i )
+            {
+                const Vector3 p = Ra::Core::VertexPacking::unpackPosition( packed[i], box );
+                maxError = std::max( maxError, ( p - points[i] ).norm() );
+            }
+            // Slack for the float rounding of the decoding.
+            ok = ok && maxError <= error * 1.01f + 1e-5f;
+            RA_UNIT_TEST( ok, "Quantized positions are within the error bound." );
+            RA_UNIT_TEST( Ra::Core::VertexPacking::unpackPosition( packed[1], box ).isApprox( box.max() ) &&
+                          packed[0].x == 0 && packed[1].x == 65535, "Box corners are exact." );
+
+            const Vector3 outside = Ra::Core::VertexPacking::unpackPosition(
+                Ra::Core::VertexPacking::packPosition( Vector3( 10, 0, 100 ), box ), box );
+            RA_UNIT_TEST( outside.isApprox( Vector3( 5, 0.5, 100 ) ), "Points outside the box are clamped." );
+        }
+
+        void testDirections()
+        {
+            std::mt19937 gen( 11 );
+            std::normal_distribution<Scalar> dist;
+            Ra::Core::Vector3Array directions;
+            for ( int i = 0; i < 27; ++i )
+            {
+                // Axes, diagonals and the edges of the octahedron, where the encoding folds.
+                const Vector3 d( i % 3 - 1, ( i / 3 ) % 3 - 1, i / 9 - 1 );
+                if ( !d.isZero() )
+                {
+                    directions.push_back( d.normalized() );
+                }
+            }
+            for ( uint i = 0; i < 100000; ++i )
+            {
+                directions.push_back( Vector3( dist( gen ), dist( gen ), dist( gen ) ).normalized() );
+            }
+
+            std::vector<Ra::Core::VertexPacking::Direction16> packed;
+            Ra::Core::VertexPacking::packDirections( directions, packed );
+            Scalar maxError = 0;
+            for ( uint i = 0; i < directions.size(); ++i )
+            {
+                const Vector3 d = Ra::Core::VertexPacking::unpackDirection( packed[i] );
+                maxError = std::max( maxError, ( d - directions[i] ).norm() );
+            }
+            RA_UNIT_TEST( maxError <= Ra::Core::VertexPacking::getDirectionError(),
+                          "Octahedral directions are within the error bound." );
+
+            const Vector3 scaled = Ra::Core::VertexPacking::unpackDirection(
+                Ra::Core::VertexPacking::packDirection( Vector3( 0, -3, -4 ) ) );
+            RA_UNIT_TEST( ( scaled - Vector3( 0, -0.6, -0.8 ) ).norm() <= Ra::Core::VertexPacking::getDirectionError(),
+                          "Directions are normalized." );
+        }
+
+        void testHalf()
+        {
+            using Ra::Core::VertexPacking::floatToHalf;
+            using Ra::Core::VertexPacking::halfToFloat;
+
+            // All the finite halves convert back and forth exactly.
+            bool ok = true;
+            for ( uint h = 0; h < 0x10000; ++h )
+            {
+                if ( ( h & 0x7c00 ) != 0x7c00 )
+                {
+                    ok = ok && floatToHalf( halfToFloat( uint16_t( h ) ) ) == h;
+                }
+            }
+            RA_UNIT_TEST( ok, "Round trip of halves." );
+
+            RA_UNIT_TEST( halfToFloat( floatToHalf( 1.f ) ) == 1.f && halfToFloat( floatToHalf( -2.5f ) ) == -2.5f &&
+                          halfToFloat( floatToHalf( 65504.f ) ) == 65504.f, "Exact halves." );
+            RA_UNIT_TEST( floatToHalf( 1e6f ) == 0x7c00 && floatToHalf( -std::numeric_limits<float>::infinity() ) == 0xfc00,
+                          "Infinite halves." );
+            const float nan = halfToFloat( floatToHalf( std::numeric_limits<float>::quiet_NaN() ) );
+            RA_UNIT_TEST( nan != nan, "NaN halves." );
+            // 1 + 2^-11 is halfway between 1 and the next half : ties round to even.
+            RA_UNIT_TEST( floatToHalf( 1.f + 1.f / 2048 ) == floatToHalf( 1.f ) &&
+                          floatToHalf( 1.f + 3.f / 2048 ) == floatToHalf( 1.f + 4.f / 2048 ), "Round to nearest even." );
+
+            std::mt19937 gen( 3 );
+            std::uniform_real_distribution<float> exponent( -24, 16 );
+            std::uniform_real_distribution<float> sign( -1, 1 );
+            ok = true;
+            for ( uint i = 0; i < 100000; ++i )
+            {
+                const float x = std::copysign( std::exp2( exponent( gen ) ), sign( gen ) );
+                if ( std::abs( x ) < 65504 )
+                {
+                    const Scalar error = std::abs( halfToFloat( floatToHalf( x ) ) - x );
+                    ok = ok && error <= std::abs( x ) * Ra::Core::VertexPacking::getHalfRelativeError() +
+                                           Ra::Core::VertexPacking::getHalfAbsoluteError();
+                }
+            }
+            RA_UNIT_TEST( ok, "Halves are within the error bound." );
+
+            const Vector3 uv = Ra::Core::VertexPacking::unpackTexCoord(
+                Ra::Core::VertexPacking::packTexCoord( Vector3( 0.25, 0.3, 1 ) ) );
+            RA_UNIT_TEST( uv.x() == Scalar( 0.25 ) && std::abs( uv.y() - Scalar( 0.3 ) ) <= Scalar( 0.3 / 2048 ) &&
+                          uv.z() == 0, "Texture coordinates." );
+        }
+
+        void testColors()
+        {
+            bool ok = true;
+            for ( uint i = 0; i <= 1000; ++i )
+            {
+                const Scalar x = Scalar( i ) / 1000;
+                const Ra::Core::Color c( x, 1 - x, x * x, 1 );
+                const Ra::Core::Color d =
+                    Ra::Core::VertexPacking::unpackColor( Ra::Core::VertexPacking::packColor( c ) );
+                ok = ok && ( d - c ).cwiseAbs().maxCoeff() <= Ra::Core::VertexPacking::getColorError() + 1e-6f;
+            }
+            RA_UNIT_TEST( ok, "Colors are within the error bound." );
+
+            const Ra::Core::VertexPacking::Color8 clamped =
+                Ra::Core::VertexPacking::packColor( Ra::Core::Color( -1, 2, 0, 1 ) );
+            RA_UNIT_TEST( clamped.r == 0 && clamped.g == 255 && clamped.b == 0 && clamped.a == 255,
+                          "Colors are clamped." );
+        }
+
+        void testIndices()
+        {
+            RA_UNIT_TEST( Ra::Core::VertexPacking::fitsShortIndices( 65536 ) &&
+                          !Ra::Core::VertexPacking::fitsShortIndices( 65537 ), "Short index limit." );
+
+            Ra::Core::VectorArray<Ra::Core::Triangle> triangles;
+            triangles.push_back( Ra::Core::Triangle( 0, 1, 2 ) );
+            triangles.push_back( Ra::Core::Triangle( 65535, 3, 1 ) );
+            std::vector<uint16_t> indices;
+            Ra::Core::VertexPacking::packIndices( triangles, indices );
+            RA_UNIT_TEST( indices == std::vector<uint16_t>( { 0, 1, 2, 65535, 3, 1 } ), "Short indices." );
+        }
+
+        void run() override
+        {
+            testPositions();
+            testDirections();
+            testHalf();
+            testColors();
+            testIndices();
+        }
+    };
+
+    RA_TEST_CLASS( VertexPackingTest );
+}
+
+#endif // RADIUM_VERTEXPACKING_TEST_HPP_
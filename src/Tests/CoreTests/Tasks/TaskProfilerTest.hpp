@@ -0,0 +1,71 @@
+#ifndef RADIUM_TASKPROFILER_TEST_HPP_
+#define RADIUM_TASKPROFILER_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Tasks/TaskProfiler.hpp>
+
+#include <sstream>
+
+namespace RaTests
+{
+    class TaskProfilerTest : public Test
+    {
+        static Ra::Core::TaskQueue::TimerData task( const std::string& name, int startMs, int endMs )
+        {
+            const Ra::Core::Timer::TimePoint origin;
+            Ra::Core::TaskQueue::TimerData t;
+            t.taskName = name;
+            t.start = origin + std::chrono::milliseconds( startMs );
+            t.end = origin + std::chrono::milliseconds( endMs );
+            t.threadId = 0;
+            return t;
+        }
+
+        void run() override
+        {
+            Ra::Core::TaskProfiler profiler;
+            for ( int f = 1; f <= 4; ++f )
+            {
+                std::vector<Ra::Core::TaskQueue::TimerData> timerData;
+                timerData.push_back( task( "skin \"a\"", 0, 2 * f ) );
+                timerData.push_back( task( "skin b", 0, 1 ) );
+                timerData.push_back( task( "physics", 1, 4 ) );
+                profiler.addFrame( timerData, { "Animation", "Animation", "Physics" }, 0.010 * f );
+            }
+
+            RA_UNIT_TEST( profiler.getFrameCount() == 4, "Frame count." );
+            RA_UNIT_TEST( std::abs( profiler.getFrames().getMean() - 0.025 ) < 1e-9, "Mean frame time." );
+            RA_UNIT_TEST( std::abs( profiler.getFrames().m_max - 0.040 ) < 1e-9, "Max frame time." );
+            RA_UNIT_TEST( std::abs( profiler.getFramePercentile( 0 ) - 0.010 ) < 1e-9 &&
+                          std::abs( profiler.getFramePercentile( 1 ) - 0.040 ) < 1e-9, "Frame percentiles." );
+
+            const auto& tasks = profiler.getTasks();
+            RA_UNIT_TEST( tasks.size() == 3, "Tasks are aggregated by name." );
+            const auto& skin = tasks.at( "skin \"a\"" );
+            RA_UNIT_TEST( skin.m_count == 4 && std::abs( skin.m_min - 0.002 ) < 1e-9 &&
+                          std::abs( skin.m_max - 0.008 ) < 1e-9 && std::abs( skin.m_total - 0.020 ) < 1e-9, "Task statistics." );
+
+            const auto& groups = profiler.getGroups();
+            RA_UNIT_TEST( groups.size() == 2, "Tasks are aggregated by group." );
+            // Animation takes 2f + 1 ms on frame f.
+            const auto& animation = groups.at( "Animation" );
+            RA_UNIT_TEST( animation.m_count == 4 && std::abs( animation.m_min - 0.003 ) < 1e-9 &&
+                          std::abs( animation.getMean() - 0.006 ) < 1e-9, "Group statistics." );
+
+            std::ostringstream json;
+            profiler.writeJson( json, { { "peak_memory_bytes", 1024 } }, "systems" );
+            const std::string str = json.str();
+            RA_UNIT_TEST( str.find( "\"peak_memory_bytes\": 1024" ) != std::string::npos, "Metrics are written." );
+            RA_UNIT_TEST( str.find( "\"systems\": {" ) != std::string::npos, "Groups are written." );
+            RA_UNIT_TEST( str.find( "\"skin \\\"a\\\"\"" ) != std::string::npos, "Names are escaped." );
+            RA_UNIT_TEST( str.find( "\"mean_ms\": 25" ) != std::string::npos, "Durations in milliseconds." );
+
+            profiler.clear();
+            RA_UNIT_TEST( profiler.getFrameCount() == 0 && profiler.getTasks().empty(), "Clear." );
+        }
+    };
+
+    RA_TEST_CLASS( TaskProfilerTest );
+}
+
+#endif // RADIUM_TASKPROFILER_TEST_HPP_
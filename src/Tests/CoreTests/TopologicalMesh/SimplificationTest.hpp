@@ -0,0 +1,99 @@
+#ifndef RADIUM_SIMPLIFICATION_TEST_HPP_
+#define RADIUM_SIMPLIFICATION_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Mesh/TopologicalTriMesh/Operations/Simplification.hpp>
+
+namespace RaTests
+{
+    class SimplificationTest : public Test
+    {
+        typedef Ra::Core::TriangleMesh TriangleMesh;
+
+        // Subdivided icosahedron with shared vertices. Its vertices lie between the inscribed
+        // and circumscribed spheres of the icosahedron.
+        TriangleMesh makeIcosahedron( uint numSubdiv )
+        {
+            TriangleMesh mesh = Ra::Core::MeshUtils::makeGeodesicSphere( 1, numSubdiv );
+            std::vector<Ra::Core::VertexIdx> vertexMap;
+            Ra::Core::MeshUtils::removeDuplicates( mesh, vertexMap );
+            mesh.m_normals.clear();
+            return mesh;
+        }
+
+        bool isOnIcosahedron( const TriangleMesh& mesh )
+        {
+            for ( const auto& v : mesh.m_vertices )
+            {
+                if ( v.norm() < 0.79 || v.norm() > 1.001 )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void run() override
+        {
+            using namespace Ra::Core::TMOperations;
+
+            const TriangleMesh sphere = makeIcosahedron( 3 );
+            const uint numFaces = sphere.m_triangles.size();
+
+            SimplificationParameters params;
+            params.m_targetFaceCount = 200;
+            params.m_partitionCount = 1;
+
+            Ra::Core::ProgressiveMesh pm;
+            simplify( sphere, pm, params );
+            RA_UNIT_TEST( pm.getFaceCount() <= 200 && pm.getFaceCount() > 100, "Target face count not reached." );
+
+            TriangleMesh coarse;
+            pm.getMesh( coarse );
+            RA_UNIT_TEST( coarse.m_triangles.size() == pm.getFaceCount(), "Wrong extracted face count." );
+            RA_UNIT_TEST( isOnIcosahedron( coarse ), "Simplified mesh moved away from the surface." );
+
+            bool errorOk = true;
+            for ( uint i = 0; i < pm.getCollapseCount(); ++i )
+            {
+                errorOk = errorOk && pm.getCollapses()[i].m_error >= 0;
+            }
+            RA_UNIT_TEST( errorOk, "Negative quadric error." );
+
+            // The stream refines back to the original mesh.
+            pm.setLevel( 0 );
+            TriangleMesh fine;
+            pm.getMesh( fine );
+            bool sameOk = fine.m_triangles.size() == numFaces && fine.m_vertices.size() == sphere.m_vertices.size();
+            for ( uint i = 0; sameOk && i < numFaces; ++i )
+            {
+                sameOk = fine.m_triangles[i] == sphere.m_triangles[i];
+            }
+            for ( uint i = 0; sameOk && i < sphere.m_vertices.size(); ++i )
+            {
+                sameOk = fine.m_vertices[i] == sphere.m_vertices[i];
+            }
+            RA_UNIT_TEST( sameOk, "Fully refined mesh differs from the original one." );
+
+            // Levels of details from partitions simplified in parallel.
+            const TriangleMesh bigSphere = makeIcosahedron( 5 );
+            params.m_partitionCount = 2;
+            std::vector<TriangleMesh> lods;
+            makeLods( bigSphere, { 8000, 2000, 500 }, lods, &pm, params );
+            RA_UNIT_TEST( lods.size() == 3, "Wrong number of levels of details." );
+            RA_UNIT_TEST( lods[0].m_triangles.size() <= 8000 && lods[1].m_triangles.size() <= 2000 &&
+                          lods[2].m_triangles.size() <= 500,
+                          "Levels of details above their face count." );
+            RA_UNIT_TEST( lods[0].m_triangles.size() > lods[1].m_triangles.size() &&
+                          lods[1].m_triangles.size() > lods[2].m_triangles.size(),
+                          "Levels of details are not decreasing." );
+            RA_UNIT_TEST( isOnIcosahedron( lods[2] ), "Coarsest level of details moved away from the surface." );
+        }
+    };
+
+    RA_TEST_CLASS( SimplificationTest );
+}
+
+#endif // RADIUM_SIMPLIFICATION_TEST_HPP_
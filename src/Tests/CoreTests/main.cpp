@@ -2,13 +2,35 @@
 
 #include <Tests/CoreTests/Containers/ContainersTest.hpp>
 #include <Tests/CoreTests/Animation/AnimationTest.hpp>
+#include <Tests/CoreTests/Animation/RotationCenterTest.hpp>
 #include <Tests/CoreTests/Algebra/AlgebraTests.hpp>
+#include <Tests/CoreTests/Algebra/TransformHierarchyTest.hpp>
+#include <Tests/CoreTests/Algebra/SplineTest.hpp>
 #include <Tests/CoreTests/Geometry/GeometryTests.hpp>
+#include <Tests/CoreTests/Geometry/PartitionTest.hpp>
+#include <Tests/CoreTests/File/GeometryDataTest.hpp>
 #include <Tests/CoreTests/RayCasts/RayCastTest.hpp>
 #include <Tests/CoreTests/String/StringTest.hpp>
 #include <Tests/CoreTests/Distance/DistanceTests.hpp>
+#include <Tests/CoreTests/Distance/BatchDistanceTest.hpp>
 #include <Tests/CoreTests/Containers/IndexMapTest.hpp>
+#include <Tests/CoreTests/Containers/SlotMapTest.hpp>
+#include <Tests/CoreTests/Containers/RadixSortTest.hpp>
+#include <Tests/CoreTests/Containers/KeyGroupsTest.hpp>
+#include <Tests/CoreTests/Containers/DrawKeyTest.hpp>
+#include <Tests/CoreTests/Containers/ThreadBuffersTest.hpp>
+#include <Tests/CoreTests/Containers/SpatialHashTest.hpp>
 #include <Tests/CoreTests/TopologicalMesh/ConvertTest.hpp>
+#include <Tests/CoreTests/TopologicalMesh/SimplificationTest.hpp>
+#include <Tests/CoreTests/Mesh/ProgressiveMeshTest.hpp>
+#include <Tests/CoreTests/Mesh/MeshIncidenceTest.hpp>
+#include <Tests/CoreTests/Mesh/MeshDuplicatesTest.hpp>
+#include <Tests/CoreTests/Mesh/VertexPackingTest.hpp>
+#include <Tests/CoreTests/LightCulling/LightClusterGridTest.hpp>
+#include <Tests/CoreTests/Log/AsyncLogTest.hpp>
+#include <Tests/CoreTests/Image/FrameRecorderTest.hpp>
+#include <Tests/CoreTests/Image/TextureLoaderTest.hpp>
+#include <Tests/CoreTests/Tasks/TaskProfilerTest.hpp>
 
 int main()
 {
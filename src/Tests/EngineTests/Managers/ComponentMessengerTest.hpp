@@ -0,0 +1,129 @@
+#ifndef RADIUM_COMPONENTMESSENGER_TEST_HPP_
+#define RADIUM_COMPONENTMESSENGER_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+
+#include <Engine/Component/Component.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Managers/ComponentMessenger/ComponentMessenger.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RaTests
+{
+    class ComponentMessengerTest : public Test
+    {
+        /// Component exporting an int, through a pointer and through callbacks.
+        class TestComponent : public Ra::Engine::Component
+        {
+        public:
+            explicit TestComponent( const std::string& name ) : Ra::Engine::Component( name ), m_value( 0 ), m_input( 0 ) {}
+            void initialize() override {}
+
+            void setupIO( const std::string& id )
+            {
+                auto compMsg = Ra::Engine::ComponentMessenger::getInstance();
+                compMsg->registerOutput<int>( getEntity(), this, id, &m_value );
+                compMsg->registerOutput<float>( getEntity(), this, id, [this]() { return &m_float; } );
+                compMsg->registerReadWrite<int>( getEntity(), this, id, [this]() { return &m_value; } );
+                compMsg->registerInput<int>( getEntity(), this, id, [this]( const int* v ) { m_input = *v; } );
+            }
+
+            int m_value;
+            int m_input;
+            float m_float = 0.5f;
+        };
+
+        typedef Ra::Engine::ComponentMessenger CM;
+
+        void testHandles( Ra::Engine::Entity& e, TestComponent* c )
+        {
+            auto compMsg = CM::getInstance();
+            c->setupIO( "data" );
+
+            CM::OutputHandle<int> out = compMsg->getOutputHandle<int>( &e, "data" );
+            CM::OutputHandle<float> outCb = compMsg->getOutputHandle<float>( &e, "data" );
+            CM::RwHandle<int> rw = compMsg->getRwHandle<int>( &e, "data" );
+            CM::InputHandle<int> in = compMsg->getInputHandle<int>( &e, "data" );
+            RA_UNIT_TEST( out.isValid() && outCb.isValid() && rw.isValid() && in.isValid(), "Handles are resolved." );
+            RA_UNIT_TEST( !compMsg->getOutputHandle<int>( &e, "other" ).isValid() &&
+                          !compMsg->getOutputHandle<double>( &e, "data" ).isValid(),
+                          "Unknown ids and types give invalid handles." );
+
+            c->m_value = 3;
+            RA_UNIT_TEST( out.get() == 3 && outCb.get() == 0.5f && compMsg->get<int>( &e, "data" ) == 3,
+                          "Read through handles and by id." );
+            *rw.rw() = 5;
+            const int input = 7;
+            in.set( &input );
+            RA_UNIT_TEST( c->m_value == 5 && out.get() == 5 && c->m_input == 7, "Write through handles." );
+
+            // Copies share the entry, and all see it unregistered.
+            CM::OutputHandle<int> copy = out;
+            compMsg->unregisterAll( &e, c );
+            RA_UNIT_TEST( !out.isValid() && !copy.isValid() && !outCb.isValid() && !rw.isValid() && !in.isValid(),
+                          "Handles are invalid once unregistered." );
+            RA_UNIT_TEST( !compMsg->canGet<int>( &e, "data" ) && !compMsg->canRw<int>( &e, "data" ) &&
+                          !compMsg->canSet<int>( &e, "data" ), "Entries are removed." );
+
+            // Registering again does not revive the old handles.
+            c->setupIO( "data" );
+            RA_UNIT_TEST( !out.isValid() && compMsg->getOutputHandle<int>( &e, "data" ).get() == 5,
+                          "Old handles stay invalid, new handles read the new entry." );
+            compMsg->unregisterAll( &e, c );
+        }
+
+        void testListeners( Ra::Engine::Entity& e, TestComponent* c0, TestComponent* c1 )
+        {
+            auto compMsg = CM::getInstance();
+
+            // The listener resolves the handle again, as the skinning component does.
+            std::vector<std::string> changes;
+            CM::OutputHandle<int> out;
+            const int listenerId = compMsg->addChangeListener( &e,
+                [&]( const Ra::Engine::Entity*, const std::string& id )
+                {
+                    changes.push_back( id );
+                    out = compMsg->getOutputHandle<int>( &e, "data" );
+                } );
+
+            c0->setupIO( "data" );
+            RA_UNIT_TEST( changes.size() == 4 && out.isValid(), "Listeners are told of each registration." );
+
+            c0->m_value = 1;
+            c1->m_value = 2;
+            compMsg->unregisterAll( &e, c0 );
+            RA_UNIT_TEST( changes.size() == 8 && !out.isValid(), "Listeners are told of each removal." );
+            c1->setupIO( "data" );
+            RA_UNIT_TEST( out.isValid() && out.get() == 2, "The handle follows the new provider." );
+
+            // Destroying the provider unregisters its entries.
+            e.removeComponent( c1->getName() );
+            RA_UNIT_TEST( !out.isValid(), "Handles are invalid once the provider is destroyed." );
+
+            compMsg->removeChangeListener( &e, listenerId );
+            changes.clear();
+            c0->setupIO( "data" );
+            RA_UNIT_TEST( changes.empty(), "Removed listeners are not called." );
+            compMsg->unregisterAll( &e, c0 );
+        }
+
+        void run() override
+        {
+            std::unique_ptr<Ra::Engine::Entity> e( new Ra::Engine::Entity( "ComponentMessengerTest" ) );
+            TestComponent* c0 = new TestComponent( "TestComponent0" );
+            TestComponent* c1 = new TestComponent( "TestComponent1" );
+            e->addComponent( c0 );
+            e->addComponent( c1 );
+
+            testHandles( *e, c0 );
+            testListeners( *e, c0, c1 );
+        }
+    };
+
+    RA_TEST_CLASS( ComponentMessengerTest );
+}
+
+#endif // RADIUM_COMPONENTMESSENGER_TEST_HPP_
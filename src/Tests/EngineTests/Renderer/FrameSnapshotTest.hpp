@@ -0,0 +1,97 @@
+#ifndef RADIUM_FRAMESNAPSHOT_TEST_HPP_
+#define RADIUM_FRAMESNAPSHOT_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+
+#include <Engine/Renderer/Light/DirLight.hpp>
+#include <Engine/Renderer/Light/FrameLight.hpp>
+#include <Engine/Renderer/Material/BlinnPhongMaterial.hpp>
+#include <Engine/Renderer/Renderers/DebugRender.hpp>
+
+#include <thread>
+
+namespace RaTests
+{
+    /// Checks that what Renderer::prepareFrame() copies is what the frame draws : the tasks
+    /// of the next frame edit lights, materials and debug geometry while the frame is drawn
+    /// in pipelined mode.
+    class FrameSnapshotTest : public Test
+    {
+        void testLight()
+        {
+            Ra::Engine::DirectionalLight light;
+            light.setDirection( Ra::Core::Vector3( 0, -1, 0 ) );
+
+            Ra::Engine::FrameLight frame;
+            light.getFrameLight( frame );
+            light.setDirection( Ra::Core::Vector3( 1, 0, 0 ) );
+            light.setColor( Ra::Core::Color( 1, 0, 0, 1 ) );
+
+            RA_UNIT_TEST( frame.m_block.dirDirection[1] == -1.f && frame.m_block.dirDirection[0] == 0.f &&
+                          frame.m_block.color[1] == 1.f,
+                          "Light edits after the snapshot are not drawn." );
+            RA_UNIT_TEST( !frame.m_bounded, "Directional lights are not culled." );
+
+            light.getFrameLight( frame );
+            RA_UNIT_TEST( frame.m_block.dirDirection[0] == 1.f && frame.m_block.color[1] == 0.f,
+                          "The next snapshot has the edits." );
+        }
+
+        void testMaterial()
+        {
+            Ra::Engine::BlinnPhongMaterial material( "FrameSnapshotTest" );
+            const Ra::Core::Color red( 1, 0, 0, 1 );
+            const Ra::Core::Color blue( 0, 0, 1, 1 );
+
+            material.m_kd = red;
+            material.m_alpha = 0.5;
+            material.updateFrameParameters();
+            material.m_kd = blue;
+            material.m_alpha = 1;
+
+            const auto& frame = material.getFrameParameters();
+            RA_UNIT_TEST( frame.m_kd == red && frame.m_alpha == Scalar( 0.5 ),
+                          "Material edits after the snapshot are not drawn." );
+
+            material.updateFrameParameters();
+            RA_UNIT_TEST( frame.m_kd == blue && frame.m_alpha == 1, "The next snapshot has the edits." );
+        }
+
+        void testDebugRender()
+        {
+            Ra::Engine::DebugRender debug;
+            const Ra::Core::Vector3 a( 0, 0, 0 );
+            const Ra::Core::Vector3 b( 1, 0, 0 );
+            const Ra::Core::Color color( 1, 1, 1, 1 );
+
+            // The tasks of a frame add geometry from their threads.
+            debug.addLine( a, b, color );
+            std::thread task( [&]() { debug.addPoint( a, color ); } );
+            task.join();
+            debug.prepareFrame();
+            RA_UNIT_TEST( debug.getFrameLineVertexCount() == 2 && debug.getFramePointVertexCount() == 1,
+                          "The geometry of all the threads is gathered." );
+
+            // The tasks of the next frame add geometry while the frame is drawn.
+            debug.addLine( a, b, color );
+            debug.addLine( b, a, color );
+            RA_UNIT_TEST( debug.getFrameLineVertexCount() == 2 && debug.getFramePointVertexCount() == 1,
+                          "Geometry added after the snapshot is not drawn." );
+
+            debug.prepareFrame();
+            RA_UNIT_TEST( debug.getFrameLineVertexCount() == 4 && debug.getFramePointVertexCount() == 0,
+                          "It is drawn with the next frame." );
+        }
+
+        void run() override
+        {
+            testLight();
+            testMaterial();
+            testDebugRender();
+        }
+    };
+
+    RA_TEST_CLASS( FrameSnapshotTest );
+}
+
+#endif // RADIUM_FRAMESNAPSHOT_TEST_HPP_
@@ -0,0 +1,62 @@
+#ifndef RADIUM_RENDEROBJECTMANAGER_TEST_HPP_
+#define RADIUM_RENDEROBJECTMANAGER_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+
+#include <Core/Math/TransformHierarchy.hpp>
+#include <Engine/Component/Component.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/RadiumEngine.hpp>
+#include <Engine/Renderer/RenderObject/RenderObject.hpp>
+#include <Engine/Renderer/RenderObject/RenderObjectManager.hpp>
+
+#include <memory>
+
+namespace RaTests
+{
+    /// Checks that removed and expired render objects release their transform hierarchy node.
+    class RenderObjectManagerTest : public Test
+    {
+        class TestComponent : public Ra::Engine::Component
+        {
+        public:
+            explicit TestComponent( const std::string& name ) : Ra::Engine::Component( name ) {}
+            void initialize() override {}
+        };
+
+        void run() override
+        {
+            auto engine = Ra::Engine::RadiumEngine::getInstance();
+            const Ra::Core::TransformHierarchy* hierarchy = engine->getTransformHierarchy();
+            Ra::Engine::RenderObjectManager* roMgr = engine->getRenderObjectManager();
+
+            std::unique_ptr<Ra::Engine::Entity> e( new Ra::Engine::Entity( "RenderObjectManagerTest" ) );
+            TestComponent* c = new TestComponent( "TestComponent" );
+            e->addComponent( c );
+            const uint nodeCount = hierarchy->size();
+
+            // Removed render object.
+            Ra::Core::Index removed = c->addRenderObject(
+                new Ra::Engine::RenderObject( "Removed", c, Ra::Engine::RenderObjectType::Debug ) );
+            RA_UNIT_TEST( hierarchy->size() == nodeCount + 1, "A render object adds a node." );
+            c->removeRenderObject( removed );
+            RA_UNIT_TEST( hierarchy->size() == nodeCount, "A removed render object removes its node." );
+
+            // Render object with a lifetime of one frame.
+            Ra::Engine::RenderObject* ro =
+                new Ra::Engine::RenderObject( "Expired", c, Ra::Engine::RenderObjectType::Debug, 1 );
+            Ra::Core::Index expired = c->addRenderObject( ro );
+            const Ra::Core::Index node = ro->getTransformNode();
+            RA_UNIT_TEST( hierarchy->size() == nodeCount + 1 && hierarchy->contains( node ),
+                          "A render object with a lifetime adds a node." );
+            ro->hasBeenRenderedOnce();
+            RA_UNIT_TEST( !roMgr->exists( expired ), "The render object expired." );
+            RA_UNIT_TEST( hierarchy->size() == nodeCount && !hierarchy->contains( node ),
+                          "An expired render object removes its node." );
+        }
+    };
+
+    RA_TEST_CLASS( RenderObjectManagerTest );
+}
+
+#endif // RADIUM_RENDEROBJECTMANAGER_TEST_HPP_
@@ -0,0 +1,307 @@
+#ifndef RADIUM_RENDERQUEUE_TEST_HPP_
+#define RADIUM_RENDERQUEUE_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+
+#include <Engine/Renderer/RenderQueue/RenderQueue.hpp>
+#include <Engine/Renderer/RenderStatistics.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace RaTests
+{
+    /// Tests the sorting, grouping and instance selection of the render queues with stub
+    /// render objects, which need no OpenGL context.
+    class RenderQueueTest : public Test
+    {
+        using PassName = Ra::Engine::RenderTechnique::PassName;
+
+        struct StubShader
+        {
+            explicit StubShader( bool instanced ) : m_instanced( instanced ) {}
+
+            bool hasUniform( Ra::Engine::ShaderProgram::DrawUniform uniform ) const
+            {
+                return uniform == Ra::Engine::ShaderProgram::DRAW_INSTANCED && m_instanced;
+            }
+
+            bool m_instanced;
+        };
+
+        struct StubMaterial {};
+        struct StubMesh {};
+
+        /// Like RenderTechnique, its setters invalidate the render queues.
+        class StubTechnique
+        {
+        public:
+            StubTechnique( const StubShader* shader, const std::shared_ptr<StubMaterial>& material )
+                : m_material( material ), m_shaderQueries( 0 )
+            {
+                m_shaders[Ra::Engine::RenderTechnique::LIGHTING_OPAQUE] = shader;
+            }
+
+            const StubShader* getShader( PassName pass ) const
+            {
+                ++m_shaderQueries;
+                auto it = m_shaders.find( pass );
+                return it != m_shaders.end() ? it->second : nullptr;
+            }
+
+            const std::shared_ptr<StubMaterial>& getMaterial() const { return m_material; }
+
+            void setMaterial( const std::shared_ptr<StubMaterial>& material )
+            {
+                m_material = material;
+                Ra::Engine::invalidateRenderQueues();
+            }
+
+            std::map<PassName, const StubShader*> m_shaders;
+            std::shared_ptr<StubMaterial> m_material;
+            mutable uint m_shaderQueries;
+        };
+
+        /// Like RenderObject, changing the technique or the mesh invalidates the render queues,
+        /// changing the visibility does not.
+        class StubObject
+        {
+        public:
+            StubObject( const std::shared_ptr<StubTechnique>& technique, const std::shared_ptr<StubMesh>& mesh,
+                        Scalar z )
+                : m_technique( technique ), m_mesh( mesh ), m_visible( true )
+                , m_model( Ra::Core::Matrix4::Identity() ), m_normal( Ra::Core::Matrix4::Identity() )
+            {
+                m_model( 2, 3 ) = z;
+            }
+
+            const std::shared_ptr<StubTechnique>& getRenderTechnique() const { return m_technique; }
+            const std::shared_ptr<StubMesh>& getMesh() const { return m_mesh; }
+            bool isVisible() const { return m_visible; }
+            const Ra::Core::Matrix4& getFrameModelMatrix() const { return m_model; }
+            const Ra::Core::Matrix4& getFrameNormalMatrix() const { return m_normal; }
+
+            void setRenderTechnique( const std::shared_ptr<StubTechnique>& technique )
+            {
+                m_technique = technique;
+                Ra::Engine::invalidateRenderQueues();
+            }
+
+            void setVisible( bool visible ) { m_visible = visible; }
+
+        private:
+            std::shared_ptr<StubTechnique> m_technique;
+            std::shared_ptr<StubMesh> m_mesh;
+            bool m_visible;
+            Ra::Core::Matrix4 m_model;
+            Ra::Core::Matrix4 m_normal;
+        };
+
+        typedef Ra::Engine::RenderQueueBase<StubObject> Queue;
+        typedef std::vector<std::shared_ptr<StubObject>> Objects;
+
+        struct Draws
+        {
+            uint m_draws = 0;
+            uint m_instancedDraws = 0;
+            uint m_instances = 0;
+            std::vector<StubObject*> m_order;
+        };
+
+        static Draws getDraws( const Queue& queue )
+        {
+            Draws draws;
+            queue.forEachDraw( [&]( StubObject* o )
+                               {
+                                   ++draws.m_draws;
+                                   draws.m_order.push_back( o );
+                               },
+                               [&]( StubObject* o, uint, uint count )
+                               {
+                                   ++draws.m_instancedDraws;
+                                   draws.m_instances += count;
+                                   draws.m_order.push_back( o );
+                               } );
+            return draws;
+        }
+
+        static uint getShaderQueries( const Objects& objects )
+        {
+            uint queries = 0;
+            for ( const auto& o : objects )
+            {
+                queries += o->getRenderTechnique()->m_shaderQueries;
+                o->getRenderTechnique()->m_shaderQueries = 0;
+            }
+            return queries;
+        }
+
+        static void update( Queue& queue, const Objects& objects )
+        {
+            Ra::Engine::getCurrentRenderStatistics().reset();
+            queue.update( objects, Ra::Engine::RenderTechnique::LIGHTING_OPAQUE, Ra::Core::Matrix4::Identity() );
+        }
+
+        static bool isSorted( const Queue& queue )
+        {
+            const auto& keys = queue.getKeys();
+            return std::is_sorted( keys.begin(), keys.end() );
+        }
+
+        void testGroups()
+        {
+            StubShader instanced( true );
+            StubShader plain( false );
+            auto matA = std::make_shared<StubMaterial>();
+            auto matB = std::make_shared<StubMaterial>();
+            auto meshA = std::make_shared<StubMesh>();
+            auto meshB = std::make_shared<StubMesh>();
+            auto make = [&]( const StubShader* s, const std::shared_ptr<StubMaterial>& m,
+                             const std::shared_ptr<StubMesh>& mesh, Scalar z )
+            {
+                return std::make_shared<StubObject>( std::make_shared<StubTechnique>( s, m ), mesh, z );
+            };
+
+            // Three instanceable objects, the others differ by their material, shader or mesh.
+            Objects objects = { make( &instanced, matA, meshA, -3 ), make( &plain, matA, meshA, -1 ),
+                                make( &instanced, matA, meshA, -1 ), make( &instanced, matB, meshA, -1 ),
+                                make( &plain, matA, meshA, -2 ), make( &instanced, matA, meshB, -1 ),
+                                make( &instanced, matA, meshA, -2 ) };
+
+            Queue queue;
+            update( queue, objects );
+            const Ra::Engine::RenderStatistics& stats = Ra::Engine::getCurrentRenderStatistics();
+            RA_UNIT_TEST( queue.size() == objects.size() && isSorted( queue ), "Sorted queue." );
+            RA_UNIT_TEST( stats.m_queueGroups == 4 && queue.getInstanceGroups().getGroupCount() == 4,
+                          "Objects are grouped by shader, material and mesh." );
+            RA_UNIT_TEST( stats.m_queueInstances == 3, "Only the group with an instanced shader is instanced." );
+
+            Draws draws = getDraws( queue );
+            RA_UNIT_TEST( draws.m_instancedDraws == 1 && draws.m_instances == 3 && draws.m_draws == 4,
+                          "One instanced draw, the other objects are drawn alone." );
+            RA_UNIT_TEST( draws.m_order.front() == objects[2].get() &&
+                          queue.getInstanceData()[14] == objects[2]->getFrameModelMatrix()( 2, 3 ),
+                          "Instances are drawn front to back, at the place of the first one." );
+
+            // Visibility is read every frame, without rebuilding the keys.
+            objects[6]->setVisible( false );
+            update( queue, objects );
+            RA_UNIT_TEST( stats.m_queueInstances == 2, "Hidden objects are not instanced." );
+            objects[0]->setVisible( false );
+            update( queue, objects );
+            draws = getDraws( queue );
+            RA_UNIT_TEST( stats.m_queueInstances == 0 && draws.m_instancedDraws == 0 &&
+                          draws.m_draws == objects.size(),
+                          "Groups with less than two visible objects are drawn one by one." );
+            objects[0]->setVisible( true );
+            objects[6]->setVisible( true );
+
+            // A new material moves the object to the group of the same material.
+            objects[3]->getRenderTechnique()->setMaterial( matA );
+            update( queue, objects );
+            RA_UNIT_TEST( stats.m_queueGroups == 3 && stats.m_queueInstances == 4, "Material change regroups." );
+
+            // A new technique too.
+            objects[1]->setRenderTechnique( std::make_shared<StubTechnique>( &instanced, matA ) );
+            update( queue, objects );
+            RA_UNIT_TEST( stats.m_queueGroups == 3 && stats.m_queueInstances == 5, "Technique change regroups." );
+
+            queue.setInstancing( false );
+            update( queue, objects );
+            RA_UNIT_TEST( stats.m_queueInstances == 0 && getDraws( queue ).m_draws == objects.size(),
+                          "No instanced draws when instancing is disabled." );
+        }
+
+        void testKeyCache()
+        {
+            StubShader shader( false );
+            auto material = std::make_shared<StubMaterial>();
+            auto otherMaterial = std::make_shared<StubMaterial>();
+            auto mesh = std::make_shared<StubMesh>();
+            Objects objects;
+            for ( uint i = 0; i < 4; ++i )
+            {
+                objects.push_back( std::make_shared<StubObject>( std::make_shared<StubTechnique>( &shader, material ),
+                                                                 mesh, -Scalar( i ) ) );
+            }
+            objects.reserve( 8 );
+
+            Queue queue;
+            queue.setInstancing( false );
+            update( queue, objects );
+            RA_UNIT_TEST( getShaderQueries( objects ) > 0 && queue.size() == 4, "Keys are built." );
+            update( queue, objects );
+            RA_UNIT_TEST( getShaderQueries( objects ) == 0, "Keys are kept." );
+
+            objects[0]->setVisible( false );
+            update( queue, objects );
+            RA_UNIT_TEST( getShaderQueries( objects ) == 0, "Visibility does not change the keys." );
+
+            objects[1]->getRenderTechnique()->setMaterial( otherMaterial );
+            update( queue, objects );
+            RA_UNIT_TEST( getShaderQueries( objects ) > 0 && queue.getInstanceGroups().getGroupCount() == 2,
+                          "A material change rebuilds the keys." );
+
+            objects[2]->setRenderTechnique( std::make_shared<StubTechnique>( nullptr, material ) );
+            update( queue, objects );
+            RA_UNIT_TEST( getShaderQueries( objects ) > 0 && queue.size() == 3,
+                          "A technique change rebuilds the keys." );
+
+            Ra::Engine::invalidateRenderQueues();
+            update( queue, objects );
+            RA_UNIT_TEST( getShaderQueries( objects ) > 0, "Invalidation rebuilds the keys." );
+
+            // The lists of the renderer are only rebuilt on invalidation, but a different list
+            // must not be drawn with the keys of the previous one.
+            objects.push_back( std::make_shared<StubObject>( std::make_shared<StubTechnique>( &shader, material ),
+                                                             mesh, -1 ) );
+            update( queue, objects );
+            RA_UNIT_TEST( getShaderQueries( objects ) > 0 && queue.size() == 4, "A new size rebuilds the keys." );
+
+            const Objects copy = objects;
+            update( queue, copy );
+            RA_UNIT_TEST( getShaderQueries( objects ) > 0, "A new list rebuilds the keys." );
+            update( queue, copy );
+            RA_UNIT_TEST( getShaderQueries( objects ) == 0 && isSorted( queue ), "Keys of the new list are kept." );
+        }
+
+        void testSplitGroups()
+        {
+            // Shader ids are truncated to SHADER_BITS in the keys : the first and the last
+            // object get the same key but do not share their shader.
+            const uint shaderCount = ( 1u << Ra::Core::DrawKey::SHADER_BITS ) + 1;
+            std::vector<std::unique_ptr<StubShader>> shaders;
+            auto material = std::make_shared<StubMaterial>();
+            auto mesh = std::make_shared<StubMesh>();
+            Objects objects;
+            for ( uint i = 0; i < shaderCount; ++i )
+            {
+                shaders.emplace_back( new StubShader( true ) );
+                objects.push_back( std::make_shared<StubObject>(
+                    std::make_shared<StubTechnique>( shaders.back().get(), material ), mesh, -1 ) );
+            }
+
+            Queue queue;
+            update( queue, objects );
+            const Ra::Engine::RenderStatistics& stats = Ra::Engine::getCurrentRenderStatistics();
+            RA_UNIT_TEST( queue.getKeys().front() == queue.getKeys()[1], "Truncated shader ids collide." );
+            RA_UNIT_TEST( stats.m_queueGroups == shaderCount && queue.getInstanceGroups().getMaxGroupSize() == 1,
+                          "Groups are split where the shaders differ." );
+            RA_UNIT_TEST( stats.m_queueInstances == 0 && getDraws( queue ).m_draws == shaderCount,
+                          "Objects with different shaders are not instanced together." );
+        }
+
+        void run() override
+        {
+            testGroups();
+            testKeyCache();
+            testSplitGroups();
+        }
+    };
+
+    RA_TEST_CLASS( RenderQueueTest );
+}
+
+#endif // RADIUM_RENDERQUEUE_TEST_HPP_
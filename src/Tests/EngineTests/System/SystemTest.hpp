@@ -0,0 +1,209 @@
+#ifndef RADIUM_SYSTEM_TEST_HPP_
+#define RADIUM_SYSTEM_TEST_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Engine/Component/Component.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/System/System.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace RaTests
+{
+    class SystemTest : public Test
+    {
+        class TestComponent : public Ra::Engine::Component
+        {
+        public:
+            explicit TestComponent( const std::string& name ) : Ra::Engine::Component( name ), m_updates( 0 ) {}
+            void initialize() override {}
+
+            std::atomic<int> m_updates;
+        };
+
+        class TestSystem : public Ra::Engine::System
+        {
+        public:
+            void generateTasks( Ra::Core::TaskQueue*, const Ra::Engine::FrameInfo& ) override {}
+
+            using Ra::Engine::System::m_components;
+            using Ra::Engine::System::registerChunkedTasks;
+
+            /// Each registered component is listed once, at its position.
+            bool isConsistent() const
+            {
+                for ( uint i = 0; i < m_components.size(); ++i )
+                {
+                    if ( m_components[i].second->getSystem() != this ||
+                         m_components[i].second->getEntity() != m_components[i].first )
+                    {
+                        return false;
+                    }
+                    for ( uint j = 0; j < i; ++j )
+                    {
+                        if ( m_components[j].second == m_components[i].second )
+                        {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+        };
+
+        typedef std::vector<Ra::Engine::Component*> Components;
+
+        void testRegistration( TestSystem& system, Ra::Engine::Entity& e0, Ra::Engine::Entity& e1,
+                               const std::vector<TestComponent*>& c )
+        {
+            system.registerComponent( &e0, c[0] );
+            system.registerComponent( &e0, c[1] );
+            system.registerComponent( &e0, c[2] );
+            system.registerComponent( &e1, c[3] );
+            system.registerComponent( &e1, c[4] );
+            RA_UNIT_TEST( system.getComponentCount() == 5 && system.isConsistent(), "Registration." );
+            RA_UNIT_TEST( system.getEntityComponents( &e0 ) == Components( { c[0], c[1], c[2] } ) &&
+                          system.getEntityComponents( &e1 ) == Components( { c[3], c[4] } ),
+                          "Components of each entity, in registration order." );
+
+            // Removal moves the last component, the positions are kept up to date.
+            system.unregisterComponent( &e0, c[0] );
+            RA_UNIT_TEST( system.getComponentCount() == 4 && system.isConsistent() && c[0]->getSystem() == nullptr,
+                          "Removal." );
+            RA_UNIT_TEST( system.getEntityComponents( &e0 ) == Components( { c[1], c[2] } ), "Entity list after removal." );
+
+            system.unregisterComponent( &e1, c[4] );
+            system.registerComponent( &e0, c[0] );
+            system.registerComponent( &e1, c[4] );
+            RA_UNIT_TEST( system.getComponentCount() == 5 && system.isConsistent(), "Registration after removal." );
+            RA_UNIT_TEST( system.getEntityComponents( &e0 ) == Components( { c[1], c[2], c[0] } ) &&
+                          system.getEntityComponents( &e1 ) == Components( { c[3], c[4] } ),
+                          "Registered again at the end of the entity list." );
+
+            system.unregisterAllComponents( &e0 );
+            RA_UNIT_TEST( system.getComponentCount() == 2 && system.isConsistent() &&
+                          system.getEntityComponents( &e0 ).empty() &&
+                          c[0]->getSystem() == nullptr && c[1]->getSystem() == nullptr && c[2]->getSystem() == nullptr,
+                          "All components of an entity are removed." );
+            RA_UNIT_TEST( system.getEntityComponents( &e1 ) == Components( { c[3], c[4] } ), "Other entities are kept." );
+
+            // The last component of the entity list is removed.
+            system.unregisterComponent( &e1, c[4] );
+            system.unregisterComponent( &e1, c[3] );
+            RA_UNIT_TEST( system.getComponentCount() == 0 && system.getEntityComponents( &e1 ).empty(), "Empty system." );
+        }
+
+        void testChunkedTasks( TestSystem& system, Ra::Engine::Entity& e0, Ra::Engine::Entity& e1,
+                               const std::vector<TestComponent*>& c )
+        {
+            for ( TestComponent* component : c )
+            {
+                system.registerComponent( component->getEntity(), component );
+            }
+            system.unregisterComponent( &e0, c[1] );
+
+            Ra::Core::TaskQueue taskQueue( 2 );
+            const auto tasks = system.registerChunkedTasks( &taskQueue, "Update",
+                []( Ra::Engine::Component* component )
+                {
+                    ++static_cast<TestComponent*>( component )->m_updates;
+                }, 2 );
+            RA_UNIT_TEST( tasks.size() == 2, "One task per chunk." );
+
+            // Components registered after the tasks are not updated by them.
+            system.registerComponent( &e0, c[1] );
+            taskQueue.startTasks();
+            taskQueue.waitForTasks();
+            taskQueue.flushTaskQueue();
+
+            bool once = true;
+            for ( uint i = 0; i < c.size(); ++i )
+            {
+                once = once && c[i]->m_updates == ( i == 1 ? 0 : 1 );
+            }
+            RA_UNIT_TEST( once, "Each component is updated once." );
+
+            system.unregisterAllComponents( &e0 );
+            system.unregisterAllComponents( &e1 );
+        }
+
+        void testChunksAfterRemoval()
+        {
+            // Removing middle components moves the last ones in their place : the chunks must
+            // still cover each remaining component exactly once, whatever their size.
+            TestSystem system;
+            std::unique_ptr<Ra::Engine::Entity> e( new Ra::Engine::Entity( "SystemChunkTest" ) );
+            std::vector<TestComponent*> c;
+            for ( uint i = 0; i < 11; ++i )
+            {
+                c.push_back( new TestComponent( "ChunkComponent" + std::to_string( i ) ) );
+                e->addComponent( c.back() );
+                system.registerComponent( e.get(), c.back() );
+            }
+            system.unregisterComponent( e.get(), c[5] );
+            system.unregisterComponent( e.get(), c[2] );
+            RA_UNIT_TEST( system.getComponentCount() == 9 && system.isConsistent(), "Middle components are removed." );
+
+            Ra::Core::TaskQueue taskQueue( 2 );
+            bool once = true;
+            bool chunks = true;
+            for ( uint chunkSize : { 1u, 2u, 4u, 5u, 9u, 20u } )
+            {
+                for ( TestComponent* component : c )
+                {
+                    component->m_updates = 0;
+                }
+
+                const auto tasks = system.registerChunkedTasks( &taskQueue, "Update",
+                    []( Ra::Engine::Component* component )
+                    {
+                        ++static_cast<TestComponent*>( component )->m_updates;
+                    }, chunkSize );
+                chunks = chunks && tasks.size() == ( 9 + chunkSize - 1 ) / chunkSize;
+
+                taskQueue.startTasks();
+                taskQueue.waitForTasks();
+                taskQueue.flushTaskQueue();
+
+                for ( uint i = 0; i < c.size(); ++i )
+                {
+                    once = once && c[i]->m_updates == ( i == 2 || i == 5 ? 0 : 1 );
+                }
+            }
+            RA_UNIT_TEST( chunks, "One task per chunk, the last one may be smaller." );
+            RA_UNIT_TEST( once, "Each remaining component is updated exactly once." );
+
+            system.unregisterAllComponents( e.get() );
+        }
+
+        void run() override
+        {
+            testChunksAfterRemoval();
+
+            TestSystem system;
+            std::unique_ptr<Ra::Engine::Entity> e0( new Ra::Engine::Entity( "SystemTest0" ) );
+            std::unique_ptr<Ra::Engine::Entity> e1( new Ra::Engine::Entity( "SystemTest1" ) );
+            std::vector<TestComponent*> c;
+            for ( uint i = 0; i < 5; ++i )
+            {
+                c.push_back( new TestComponent( "TestComponent" + std::to_string( i ) ) );
+                ( i < 3 ? e0 : e1 )->addComponent( c.back() );
+            }
+
+            testRegistration( system, *e0, *e1, c );
+            testChunkedTasks( system, *e0, *e1, c );
+
+            // Components are destroyed with their entities, before the system.
+            e0.reset();
+            e1.reset();
+        }
+    };
+
+    RA_TEST_CLASS( SystemTest );
+}
+
+#endif // RADIUM_SYSTEM_TEST_HPP_
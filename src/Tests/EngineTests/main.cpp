@@ -0,0 +1,22 @@
+#include <Tests/CoreTests/Tests.hpp>
+
+#include <Engine/RadiumEngine.hpp>
+
+#include <Tests/EngineTests/Managers/ComponentMessengerTest.hpp>
+#include <Tests/EngineTests/Renderer/FrameSnapshotTest.hpp>
+#include <Tests/EngineTests/Renderer/RenderObjectManagerTest.hpp>
+#include <Tests/EngineTests/Renderer/RenderQueueTest.hpp>
+#include <Tests/EngineTests/System/SystemTest.hpp>
+
+int main()
+{
+    if (! RaTests::TestManager::getInstance()) {RaTests::TestManager::createInstance();}
+    RaTests::TestManager::getInstance()->m_options.m_breakOnFailure = true;
+
+    // Entities and components need the engine managers, but no rendering context.
+    Ra::Engine::RadiumEngine::createInstance()->initialize();
+    const int result = RaTests::TestManager::getInstance()->run();
+    Ra::Engine::RadiumEngine::getInstance()->cleanup();
+    Ra::Engine::RadiumEngine::destroyInstance();
+    return result;
+}